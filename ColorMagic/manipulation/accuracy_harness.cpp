@@ -0,0 +1,177 @@
+#include "stdafx.h"
+#include "accuracy_harness.h"
+#include "color_converter.h"
+#include "color_distance.h"
+#include "stream_converter.h"
+#include "../spaces/lab.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+std::vector<float> color_manipulation::accuracy_harness::sample_grid(color_type type, size_t steps, color_space::rgb_color_space_definition* color_space)
+{
+	if (steps < 2) throw new std::invalid_argument("A grid needs at least 2 steps per axis.");
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+
+	std::vector<float> rgb_records;
+	rgb_records.reserve(steps * steps * steps * 4);
+	float scale = 1.f / (float)(steps - 1);
+	for (size_t red = 0; red < steps; ++red)
+	{
+		for (size_t green = 0; green < steps; ++green)
+		{
+			for (size_t blue = 0; blue < steps; ++blue)
+			{
+				rgb_records.push_back(red * scale);
+				rgb_records.push_back(green * scale);
+				rgb_records.push_back(blue * scale);
+				rgb_records.push_back(1.f);
+			}
+		}
+	}
+	return type == color_type::RGB_DEEP ? rgb_records : reference(color_type::RGB_DEEP, type, rgb_records, color_space);
+}
+
+std::vector<float> color_manipulation::accuracy_harness::reference(color_type in_type, color_type out_type, const std::vector<float>& in_records, color_space::rgb_color_space_definition* color_space)
+{
+	size_t in_size = stream_converter::get_record_size(in_type);
+	size_t out_size = stream_converter::get_record_size(out_type);
+	size_t count = in_records.size() / in_size;
+
+	std::vector<float> out_records(count * out_size);
+	for (size_t i = 0; i < count; ++i)
+	{
+		std::unique_ptr<color_space::color_base> color(stream_converter::create_color(in_type, &in_records[i * in_size], color_space));
+		std::unique_ptr<color_space::color_base> converted(color_converter::convertTo(color.get(), out_type));
+
+		auto components = converted->get_component_vector();
+		float* record = &out_records[i * out_size];
+		std::copy(components.begin(), components.end(), record);
+		record[out_size - 1] = converted->alpha();
+	}
+	return out_records;
+}
+
+color_manipulation::accuracy_report color_manipulation::accuracy_harness::compare(const std::string& name, color_type in_type, color_type out_type, const std::vector<float>& in_records, const fast_path& path, color_space::rgb_color_space_definition* color_space, bool measure_speed)
+{
+	if (!path) throw new std::invalid_argument("fast path is empty.");
+
+	size_t in_size = stream_converter::get_record_size(in_type);
+	size_t out_size = stream_converter::get_record_size(out_type);
+	size_t count = in_records.size() / in_size;
+
+	accuracy_report report;
+	report.name = name;
+	report.in_type = in_type;
+	report.out_type = out_type;
+	report.sample_count = count;
+	report.max_delta_e = 0.f;
+	report.mean_delta_e = 0.f;
+	report.max_ulp = 0;
+	report.mean_ulp = 0.;
+	report.worst_input = { 0.f, 0.f, 0.f, 0.f };
+	report.ns_per_color = 0.;
+	if (count == 0) return report;
+
+	std::vector<float> fast_records(count * out_size);
+	path(in_records.data(), fast_records.data(), count);
+	auto expected_records = reference(in_type, out_type, in_records, color_space);
+
+	double delta_e_sum = 0.;
+	double ulp_sum = 0.;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float* fast = &fast_records[i * out_size];
+		const float* expected = &expected_records[i * out_size];
+
+		// Alpha (the last value) is not compared
+		for (size_t c = 0; c + 1 < out_size; ++c)
+		{
+			uint32_t ulp = ulp_error(fast[c], expected[c]);
+			report.max_ulp = std::max(report.max_ulp, ulp);
+			ulp_sum += ulp;
+		}
+
+		std::unique_ptr<color_space::color_base> fast_color(stream_converter::create_color(out_type, fast, color_space));
+		std::unique_ptr<color_space::color_base> expected_color(stream_converter::create_color(out_type, expected, color_space));
+		std::unique_ptr<color_space::lab> fast_lab(color_converter::to_lab(fast_color.get()));
+		std::unique_ptr<color_space::lab> expected_lab(color_converter::to_lab(expected_color.get()));
+
+		// Not a number counts as infinitely wrong
+		float delta_e = color_distance::cielab_delta_e_cie00(fast_lab.get(), expected_lab.get(), EXACT);
+		if (std::isnan(delta_e)) delta_e = std::numeric_limits<float>::infinity();
+
+		delta_e_sum += delta_e;
+		if (delta_e > report.max_delta_e || i == 0)
+		{
+			report.max_delta_e = delta_e;
+			for (size_t c = 0; c < 4; ++c) report.worst_input[c] = c < in_size ? in_records[i * in_size + c] : 0.f;
+		}
+	}
+	report.mean_delta_e = (float)(delta_e_sum / count);
+	report.mean_ulp = ulp_sum / ((out_size - 1) * count);
+
+	if (measure_speed)
+	{
+		double best = std::numeric_limits<double>::max();
+		for (int run = 0; run < 3; ++run)
+		{
+			auto start = std::chrono::steady_clock::now();
+			path(in_records.data(), fast_records.data(), count);
+			auto end = std::chrono::steady_clock::now();
+			best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+		}
+		report.ns_per_color = best / count;
+	}
+	return report;
+}
+
+uint32_t color_manipulation::accuracy_harness::ulp_distance(float a, float b)
+{
+	if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<uint32_t>::max();
+
+	// Map the sign-magnitude bit patterns to a monotonic integer scale
+	auto ordered = [](float value)
+	{
+		int32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits < 0 ? (int64_t)INT32_MIN - bits : (int64_t)bits;
+	};
+	int64_t distance = ordered(a) - ordered(b);
+	if (distance < 0) distance = -distance;
+	return distance > (int64_t)std::numeric_limits<uint32_t>::max() ? std::numeric_limits<uint32_t>::max() : (uint32_t)distance;
+}
+
+uint32_t color_manipulation::accuracy_harness::ulp_error(float value, float expected)
+{
+	if (std::isnan(value) || std::isnan(expected)) return std::numeric_limits<uint32_t>::max();
+
+	// Spacing of the floats around the expected value, with a lower limit at the spacing around 1
+	int exponent;
+	std::frexp(std::max(std::abs(expected), 1.f), &exponent);
+	double spacing = std::ldexp(1., exponent - std::numeric_limits<float>::digits);
+
+	double error = std::abs((double)value - (double)expected) / spacing;
+	return error >= (double)std::numeric_limits<uint32_t>::max() ? std::numeric_limits<uint32_t>::max() : (uint32_t)std::lround(error);
+}
+
+void color_manipulation::accuracy_harness::write_table(const std::vector<accuracy_report>& reports, std::ostream& out)
+{
+	static const char* type_names[] = { "RGB_TRUE", "RGB_DEEP", "GREY_TRUE", "GREY_DEEP", "CMYK", "HSI", "HSV", "HSL", "HCY", "XYZ", "XYY", "CIELUV", "LAB", "LCH_AB", "LCH_UV", "UNDEFINED" };
+
+	char line[256];
+	snprintf(line, sizeof(line), "%-24s %-20s %9s %10s %10s %12s %12s %10s %10s\n", "fast path", "conversion", "samples", "max dE00", "mean dE00", "max ULP", "mean ULP", "ns/color", "Mcolors/s");
+	out << line;
+	for (const auto& report : reports)
+	{
+		std::string conversion = std::string(type_names[report.in_type]) + "->" + type_names[report.out_type];
+		double throughput = report.ns_per_color > 0. ? 1e3 / report.ns_per_color : 0.;
+		snprintf(line, sizeof(line), "%-24s %-20s %9zu %10.5f %10.5f %12u %12.1f %10.2f %10.2f\n", report.name.c_str(), conversion.c_str(), report.sample_count, report.max_delta_e, report.mean_delta_e, report.max_ulp, report.mean_ulp, report.ns_per_color, throughput);
+		out << line;
+	}
+}
@@ -0,0 +1,117 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../spaces/rgb_color_space_definition.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Error and speed of a fast conversion path compared to the reference conversion of the color_converter.
+	struct accuracy_report
+	{
+		std::string name; /*!< The name of the fast path */
+		color_type in_type; /*!< The color type of the input records */
+		color_type out_type; /*!< The color type of the output records */
+		size_t sample_count; /*!< The number of compared colors */
+		float max_delta_e; /*!< The largest CIEDE2000 difference between fast path and reference */
+		float mean_delta_e; /*!< The mean CIEDE2000 difference between fast path and reference */
+		uint32_t max_ulp; /*!< The largest difference of a single component in units in the last place, see ulp_error() */
+		double mean_ulp; /*!< The mean difference of the components in units in the last place, see ulp_error() */
+		std::array<float, 4> worst_input; /*!< The input record with the largest CIEDE2000 difference */
+		double ns_per_color; /*!< The time the fast path needs per color, 0 if not measured */
+	};
+
+	//! Error bounds a fast conversion path has to stay in.
+	struct accuracy_bounds
+	{
+		float max_delta_e; /*!< Upper bound of the largest CIEDE2000 difference */
+		float mean_delta_e; /*!< Upper bound of the mean CIEDE2000 difference */
+		uint32_t max_ulp; /*!< Upper bound of the largest ULP difference, 0 to skip the check (e.g. for hue components) */
+
+		//! Returns whether the report stays in these bounds.
+		bool is_met_by(const accuracy_report& report) const
+		{
+			return report.max_delta_e <= max_delta_e && report.mean_delta_e <= mean_delta_e && (max_ulp == 0 || report.max_ulp <= max_ulp);
+		}
+	};
+
+	//! Static class that compares fast conversion paths with the reference conversion.
+	/*!
+	* Lookup tables, conversion plans, reduced precision records and other fast paths trade accuracy for speed.
+	* The harness feeds a dense grid of input colors through a fast path and through color_converter::convertTo()
+	* and reports the differences as CIEDE2000 color difference (color_distance::cielab_delta_e_cie00() with the
+	* EXACT policy) and as ULP distance of the components. Fast paths
+	* are functions on records in the format of the stream_converter (components followed by alpha). Alpha is not
+	* part of the comparison, because fast paths may store it in another range than the color classes.
+	*/
+	class accuracy_harness
+	{
+	public:
+		//! A fast conversion of count input records to count output records.
+		typedef std::function<void(const float* in_records, float* out_records, size_t count)> fast_path;
+
+		//! Creates a dense grid of input records of the given color type.
+		/*!
+		* The grid consists of steps^3 equidistant rgb deep colors that are converted to the given type by the
+		* reference converter, so it covers all colors of the type that the rgb color space can represent.
+		* \param type The color type of the records.
+		* \param steps The number of grid points per rgb axis (at least 2).
+		* \param color_space The rgb color space definition of the colors.
+		* \return The records.
+		*/
+		static std::vector<float> sample_grid(color_type type, size_t steps, color_space::rgb_color_space_definition* color_space);
+
+		//! Converts records with color_converter::convertTo().
+		/*!
+		* \param in_type The color type of the input records.
+		* \param out_type The color type of the output records.
+		* \param in_records The input records.
+		* \param color_space The rgb color space definition of the colors.
+		* \return The converted records.
+		*/
+		static std::vector<float> reference(color_type in_type, color_type out_type, const std::vector<float>& in_records, color_space::rgb_color_space_definition* color_space);
+
+		//! Compares a fast path with the reference conversion.
+		/*!
+		* \param name The name of the fast path used in the report.
+		* \param in_type The color type of the input records.
+		* \param out_type The color type of the output records.
+		* \param in_records The input records, e.g. created by sample_grid().
+		* \param path The fast path.
+		* \param color_space The rgb color space definition of the colors.
+		* \param measure_speed Whether to measure the time per color of the fast path (best of three runs).
+		* \return The report.
+		*/
+		static accuracy_report compare(const std::string& name, color_type in_type, color_type out_type, const std::vector<float>& in_records, const fast_path& path, color_space::rgb_color_space_definition* color_space, bool measure_speed = false);
+
+		//! Returns the number of representable floats between two values.
+		/*!
+		* Values with different signs are measured through zero. Returns UINT32_MAX if one value is not a number.
+		*/
+		static uint32_t ulp_distance(float a, float b);
+
+		//! Returns the error of a value in units in the last place of the expected value.
+		/*!
+		* Unlike ulp_distance() values with a magnitude below 1 are measured in ULPs of 1 (2^-23), so that a result of
+		* 1e-9 instead of 0 counts as a small error instead of hundreds of millions of ULPs. Above 1 the error is relative.
+		* \param value The value to check.
+		* \param expected The correct value.
+		* \return The error in ULPs, UINT32_MAX if one value is not a number.
+		*/
+		static uint32_t ulp_error(float value, float expected);
+
+		//! Writes a table with one line per report: error, time per color and throughput.
+		static void write_table(const std::vector<accuracy_report>& reports, std::ostream& out);
+	};
+}
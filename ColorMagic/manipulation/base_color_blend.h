@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "..\spaces\color_base.h"
+#include "../spaces/color_base.h"
 #include "color_converter.h"
 
 namespace color_manipulation
@@ -32,9 +32,12 @@ namespace color_manipulation
 		* \param use_b Whether the both area of the resulting pixel is blank or not.
 		* \param both_function The function used to calculate the factor of the both region. It take a source (1st param)
 		* and a destination (2nd param) value to calculate the result.
+		* \param linear_blending Whether the components should be blended in linear light. If true, source and destination
+		* components are decoded with the compiled inverse gamma table of their rgb color space definition, blended and
+		* encoded again in the same pass. Neither source nor destination will be modified.
 		* \return the combination of source and destination calculated based on the given s, d, b parameters.
 		*/
-		virtual color_space::color_base* general_porter_duff(color_space::rgb_deepcolor* source, color_space::rgb_deepcolor* destination, bool use_s, bool use_d, bool use_b, std::function<float(float, float)> both_function)
+		virtual color_space::color_base* general_porter_duff(color_space::rgb_deepcolor* source, color_space::rgb_deepcolor* destination, bool use_s, bool use_d, bool use_b, std::function<float(float, float)> both_function, bool linear_blending = false)
 		{
 			// Check input params
 			if (source == nullptr) throw new std::invalid_argument("source color is null.");
@@ -52,6 +55,32 @@ namespace color_manipulation
 			// Create a new rgb object for the resulting color
 			color_space::rgb_deepcolor* resulting_color = new color_space::rgb_deepcolor(0.f, resulting_alpha, source->get_rgb_color_space());
 
+			if (linear_blending)
+			{
+				// Make sure the gamma curve can be evaluated by table lookups
+				color_space::gamma* gamma_curve = source->get_rgb_color_space()->get_gamma_curve();
+				gamma_curve->compile_once();
+
+				// Decode, blend and encode each component in one pass
+				for (size_t i = 0; i < resulting_color->get_component_vector().size(); ++i)
+				{
+					float s_linear = gamma_curve->table_inverse_gamma_correction(source->get_component(i));
+					float d_linear = gamma_curve->table_inverse_gamma_correction(destination->get_component(i));
+
+					float s_product = src_area * (use_s ? s_linear : 0.f);
+					float d_product = dest_area * (use_d ? d_linear : 0.f);
+					float b_product = both_area * both_function(s_linear, d_linear);
+
+					// Undo the alpha multiplication before encoding, since gamma is not linear
+					float sum = s_product + d_product + b_product;
+					if (resulting_alpha != 0.f) sum /= resulting_alpha;
+
+					resulting_color->set_component(gamma_curve->table_gamma_correction(sum), i);
+				}
+
+				return resulting_color;
+			}
+
 			// Calculate the resulting color component wise
 			for (size_t i = 0; i < resulting_color->get_component_vector().size(); ++i)
 			{
@@ -366,11 +366,46 @@ color_space::color_base * color_manipulation::chromatic_adaptation::do_adaption(
 	// Convert to XYZ space
 	auto tmp_color = color_manipulation::color_converter::to_xyz(color);
 
+	// Transform the input color and create a new xyz space object
+	auto transformed_components = calculate_adaptation_matrix(color->get_rgb_color_space()->get_white_point(), target_white_point, mat, inverted_mat) * tmp_color->get_component_vector();
+	auto rgb_def = new color_space::rgb_color_space_definition(*color->get_rgb_color_space());
+	rgb_def->set_white_point(target_white_point);
+	auto tmp_trans_color = new color_space::xyz(transformed_components[0], transformed_components[1], transformed_components[2], tmp_color->alpha(), rgb_def);
+
+	// Convert transformed color back to input color space
+	return color_manipulation::color_converter::convertTo(tmp_trans_color, color->get_color_type());
+}
+
+matrix<float> color_manipulation::chromatic_adaptation::get_adaptation_matrix(color_space::white_point* source_white_point, color_space::white_point* target_white_point, adaptation_method method)
+{
+	switch (method)
+	{
+	case adaptation_method::BRADFORD:
+		return calculate_adaptation_matrix(source_white_point, target_white_point, m_bradford, m_inverted_bradford);
+	case adaptation_method::VON_KRIES:
+		return calculate_adaptation_matrix(source_white_point, target_white_point, m_von_kries, m_inverted_von_kries);
+	case adaptation_method::XYZ_SCALING:
+		return calculate_adaptation_matrix(source_white_point, target_white_point, m_xyz_scale, m_inverted_xyz_scale);
+	case adaptation_method::SHARP:
+		return calculate_adaptation_matrix(source_white_point, target_white_point, m_sharp, m_inverted_sharp);
+	case adaptation_method::CMCCAT97:
+		return calculate_adaptation_matrix(source_white_point, target_white_point, m_cmccat97, m_inverted_cmccat97);
+	case adaptation_method::CMCCAT2000:
+		return calculate_adaptation_matrix(source_white_point, target_white_point, m_cmccat2000, m_inverted_cmccat2000);
+	case adaptation_method::CAT02:
+		return calculate_adaptation_matrix(source_white_point, target_white_point, m_cat02, m_inverted_cat02);
+	default:
+		return matrix<float>::create_idendity(3);
+	}
+}
+
+matrix<float> color_manipulation::chromatic_adaptation::calculate_adaptation_matrix(color_space::white_point* source_white_point, color_space::white_point* target_white_point, matrix<float> mat, matrix<float> inverted_mat)
+{
 	// Create scaled white point vectors
 	std::vector<float> source_wp = std::vector<float>();
-	source_wp.push_back(color->get_rgb_color_space()->get_white_point()->get_tristimulus()[0]);
-	source_wp.push_back(color->get_rgb_color_space()->get_white_point()->get_tristimulus()[1]);
-	source_wp.push_back(color->get_rgb_color_space()->get_white_point()->get_tristimulus()[2]);
+	source_wp.push_back(source_white_point->get_tristimulus()[0]);
+	source_wp.push_back(source_white_point->get_tristimulus()[1]);
+	source_wp.push_back(source_white_point->get_tristimulus()[2]);
 
 	std::vector<float> dest_wp = std::vector<float>();
 	dest_wp.push_back(target_white_point->get_tristimulus()[0]);
@@ -388,12 +423,5 @@ color_space::color_base * color_manipulation::chromatic_adaptation::do_adaption(
 		0.f, 0.f, scaled_dest_wp[2] / scaled_source_wp[2]
 	});
 
-	// Transform the input color and create a new xyz space object
-	auto transformed_components = (inverted_mat * wp_matrix * mat) * tmp_color->get_component_vector();
-	auto rgb_def = new color_space::rgb_color_space_definition(*color->get_rgb_color_space());
-	rgb_def->set_white_point(target_white_point);
-	auto tmp_trans_color = new color_space::xyz(transformed_components[0], transformed_components[1], transformed_components[2], tmp_color->alpha(), rgb_def);
-
-	// Convert transformed color back to input color space
-	return color_manipulation::color_converter::convertTo(tmp_trans_color, color->get_color_type());
+	return inverted_mat * wp_matrix * mat;
 }
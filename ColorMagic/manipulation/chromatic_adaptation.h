@@ -6,13 +6,26 @@
 #pragma once
 
 #include "color_converter.h"
-#include "..\spaces\color_base.h"
-#include "..\utils\matrix.h"
+#include "../spaces/color_base.h"
+#include "../utils/matrix.h"
 
 #include <math.h>
 
 namespace color_manipulation
 {
+	//! Enum that defines the linear (von Kries type) chromatic adaptation methods.
+	enum adaptation_method
+	{
+		BRADFORD = 0, /*!< BRADFORD - linearized Bradford transform */
+		VON_KRIES, /*!< VON_KRIES - von Kries transform */
+		XYZ_SCALING, /*!< XYZ_SCALING - scaling of the XYZ components */
+		SHARP, /*!< SHARP - Sharp transform */
+		CMCCAT97, /*!< CMCCAT97 - simplified CMCCAT97 transform */
+		CMCCAT2000, /*!< CMCCAT2000 - simplified CMCCAT2000 transform */
+		CAT02, /*!< CAT02 - simplified CAT02 transform */
+		NO_ADAPTATION /*!< NO_ADAPTATION - keeps the XYZ values unchanged */
+	};
+
 	//! Static class for chromatic adaptation.
 	/*!
 	* This static class implements von Kries, Bradford, XYZ Scaling and CMCCAT2000 as chromatic adaptation methods.
@@ -148,6 +161,18 @@ namespace color_manipulation
 		*/
 		static color_space::color_base* cat02_adaptation(color_space::color_base* color, color_space::white_point* target_white_point, float f, float adapting_field_luminance = 100.f);
 
+		//! Returns the 3x3 matrix that adapts xyz values from one white point to another.
+		/*!
+		* The matrix equals the transformation done by the simplified adaptation functions (M^-1 * D * M with the
+		* cone response matrix M of the chosen method and the diagonal white point ratio matrix D). It can be
+		* multiplied with other linear transformations, e.g. the rgb to xyz matrices of two rgb color spaces.
+		* \param source_white_point The white point of the input xyz values.
+		* \param target_white_point The white point of the output xyz values.
+		* \param method The adaptation method.
+		* \return The adaptation matrix.
+		*/
+		static matrix<float> get_adaptation_matrix(color_space::white_point* source_white_point, color_space::white_point* target_white_point, adaptation_method method = BRADFORD);
+
 		//! Helper method to calculate the adapting luminance needed in the non-simplified versions of CMCCAT97 and CMCCAT2000.
 		/*!
 		* Helper method to calculate the adapting luminance needed in the non-simplified versions of CMCCAT97 and CMCCAT2000.
@@ -174,6 +199,16 @@ namespace color_manipulation
 		*/
 		static color_space::color_base* do_adaption(color_space::color_base* color, color_space::white_point* target_white_point, matrix<float> mat, matrix<float> inverted_mat);
 
+		//! Helper method that calculates inverted_mat * D * mat with the white point ratio matrix D.
+		/*!
+		* \param source_white_point The white point of the input xyz values.
+		* \param target_white_point The white point of the output xyz values.
+		* \param mat The adaptation matrix of the chosen method.
+		* \param inverted_mat The inverted adaptation matrix of the chosen method.
+		* \return The combined transformation matrix.
+		*/
+		static matrix<float> calculate_adaptation_matrix(color_space::white_point* source_white_point, color_space::white_point* target_white_point, matrix<float> mat, matrix<float> inverted_mat);
+
 		//! Adaptation matrix of the von Kries method.
 		/*!
 		* Adaptation matrix of the von Kries method.
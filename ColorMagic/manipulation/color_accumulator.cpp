@@ -0,0 +1,168 @@
+#include "stdafx.h"
+#include "color_accumulator.h"
+#include "stream_converter.h"
+
+#include <cmath>
+
+// Adds a value to a sum with Kahan summation. sum - compensation is the exact sum up to rounding of the last step.
+static void kahan_add(double& sum, double& compensation, double value)
+{
+	double corrected = value - compensation;
+	double new_sum = sum + corrected;
+	compensation = (new_sum - sum) - corrected;
+	sum = new_sum;
+}
+
+color_manipulation::color_accumulator::color_accumulator(color_type type, bool include_alpha, color_space::rgb_color_space_definition* color_space)
+	: m_type(type), m_include_alpha(include_alpha), m_color_space(color_space), m_hue_channel(-1)
+{
+	m_channel_count = stream_converter::get_record_size(type);
+	switch (type)
+	{
+	case color_type::HSI:
+	case color_type::HSV:
+	case color_type::HSL:
+	case color_type::HCY:
+		m_hue_channel = 0;
+		break;
+	case color_type::LCH_AB:
+	case color_type::LCH_UV:
+		m_hue_channel = 2;
+		break;
+	default:
+		break;
+	}
+	reset();
+}
+
+void color_manipulation::color_accumulator::push(const color_space::color_base* color)
+{
+	if (color == nullptr) throw new std::invalid_argument("color is null.");
+	if (color->get_color_type() != m_type) throw new std::invalid_argument("The color does not have the color type of the accumulator.");
+	if (m_color_space == nullptr) m_color_space = color->get_rgb_color_space();
+
+	float record[max_channels];
+	for (size_t i = 0; i + 1 < m_channel_count; ++i) record[i] = color->get_component((int)i);
+	record[m_channel_count - 1] = color->alpha();
+	push_record(record);
+}
+
+void color_manipulation::color_accumulator::push(const float* records, size_t count)
+{
+	if (count == 0) return;
+	if (records == nullptr) throw new std::invalid_argument("records is null.");
+
+	for (size_t i = 0; i < count; ++i) push_record(records + i * m_channel_count);
+}
+
+void color_manipulation::color_accumulator::merge(const color_accumulator& other)
+{
+	if (other.m_type != m_type || other.m_include_alpha != m_include_alpha) throw new std::invalid_argument("Only accumulators of the same color type and alpha handling can be merged.");
+	if (other.m_count == 0) return;
+	if (m_count == 0)
+	{
+		auto color_space = m_color_space;
+		*this = other;
+		if (color_space != nullptr) m_color_space = color_space;
+		return;
+	}
+	if (m_color_space == nullptr) m_color_space = other.m_color_space;
+
+	// Combines the means and squared deviations of both parts (Chan et al.)
+	double count = (double)m_count + (double)other.m_count;
+	for (size_t i = 0; i < m_channel_count; ++i)
+	{
+		double delta = other.m_mean[i] - m_mean[i];
+		m_mean[i] += delta * (double)other.m_count / count;
+		m_squared_deviations[i] += other.m_squared_deviations[i] + delta * delta * (double)m_count * (double)other.m_count / count;
+	}
+	for (size_t i = 0; i < 2; ++i)
+	{
+		kahan_add(m_hue_sum[i], m_hue_compensation[i], other.m_hue_sum[i]);
+		kahan_add(m_hue_sum[i], m_hue_compensation[i], -other.m_hue_compensation[i]);
+	}
+	m_count += other.m_count;
+}
+
+void color_manipulation::color_accumulator::reset()
+{
+	m_count = 0;
+	m_mean.fill(0.0);
+	m_squared_deviations.fill(0.0);
+	m_hue_sum.fill(0.0);
+	m_hue_compensation.fill(0.0);
+	m_first_alpha = 0.f;
+}
+
+float color_manipulation::color_accumulator::mean(size_t channel) const
+{
+	check_channel(channel);
+	if (channel == m_channel_count - 1 && !m_include_alpha) return m_first_alpha;
+	if (!is_hue_channel(channel)) return (float)m_mean[channel];
+
+	double cosine = m_hue_sum[0] - m_hue_compensation[0];
+	double sine = m_hue_sum[1] - m_hue_compensation[1];
+	if (std::sqrt(cosine * cosine + sine * sine) <= 1e-9 * (double)m_count) return 0.f;
+
+	// atan2 lies in [-180, 180], a result that rounds to 360 wraps to 0
+	float hue = (float)(std::atan2(sine, cosine) * 180.0 / M_PI);
+	if (hue < 0.f) hue += 360.f;
+	return hue >= 360.f ? 0.f : hue;
+}
+
+float color_manipulation::color_accumulator::variance(size_t channel) const
+{
+	check_channel(channel);
+	if (m_count == 0 || (channel == m_channel_count - 1 && !m_include_alpha)) return 0.f;
+	if (!is_hue_channel(channel)) return (float)(m_squared_deviations[channel] / (double)m_count);
+
+	double cosine = m_hue_sum[0] - m_hue_compensation[0];
+	double sine = m_hue_sum[1] - m_hue_compensation[1];
+	return (float)(1.0 - std::sqrt(cosine * cosine + sine * sine) / (double)m_count);
+}
+
+void color_manipulation::color_accumulator::mean_record(float* record) const
+{
+	if (record == nullptr) throw new std::invalid_argument("record is null.");
+	if (m_count == 0) throw new std::invalid_argument("The accumulator is empty.");
+
+	for (size_t i = 0; i < m_channel_count; ++i) record[i] = mean(i);
+}
+
+color_space::color_base* color_manipulation::color_accumulator::mean_color() const
+{
+	if (m_color_space == nullptr) throw new std::invalid_argument("The accumulator has no rgb color space definition.");
+
+	float record[max_channels];
+	mean_record(record);
+	return stream_converter::create_color(m_type, record, m_color_space);
+}
+
+void color_manipulation::color_accumulator::push_record(const float* record)
+{
+	if (m_count == 0) m_first_alpha = record[m_channel_count - 1];
+	++m_count;
+
+	// Welford: the mean moves by a fraction of the deviation, the squared deviations grow by the product of the
+	// deviations from the old and the new mean
+	double weight = 1.0 / (double)m_count;
+	for (size_t i = 0; i < m_channel_count; ++i)
+	{
+		if (is_hue_channel(i))
+		{
+			double radians = record[i] * M_PI / 180.0;
+			kahan_add(m_hue_sum[0], m_hue_compensation[0], std::cos(radians));
+			kahan_add(m_hue_sum[1], m_hue_compensation[1], std::sin(radians));
+			continue;
+		}
+
+		double delta = record[i] - m_mean[i];
+		m_mean[i] += delta * weight;
+		m_squared_deviations[i] += delta * (record[i] - m_mean[i]);
+	}
+}
+
+void color_manipulation::color_accumulator::check_channel(size_t channel) const
+{
+	if (channel >= m_channel_count) throw new std::out_of_range("Index out of range by accessing an accumulator channel.");
+}
@@ -0,0 +1,139 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../spaces/color_base.h"
+#include "../spaces/rgb_color_space_definition.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Online mean of colors of one color type.
+	/*!
+	* Colors are pushed one by one, as vectors or as records (the components in the order of the constructor of the
+	* color space followed by alpha, see stream_converter). The accumulator only keeps running statistics per channel,
+	* so it has a fixed size and never allocates, no matter how many colors it sees.
+	*
+	* Linear channels use Welford's update of the mean and the sum of squared deviations in double precision, which
+	* does not lose precision when millions of similar values are added up. Hue channels (hsi, hsv, hsl, hcy and both
+	* lch types) are averaged on the circle: the unit vectors of the hues are summed with Kahan summation and the mean
+	* hue is the direction of the sum, so the mean of 350 and 10 degrees is 0 and not 180.
+	*
+	* Accumulators of the same color type can be merged, e.g. the ones of several threads or image tiles. The merged
+	* accumulator gives the same statistics like one that saw all colors, up to rounding. If alpha is not included,
+	* the mean alpha is the alpha of the first color, like the average functions of color_calculation do it.
+	*/
+	class color_accumulator
+	{
+	public:
+		//! Maximum number of channels (the four cmyk components and alpha).
+		static const size_t max_channels = 5;
+
+		//! Default constructor.
+		/*!
+		* Creates an empty accumulator.
+		* \param type The color type of the colors.
+		* \param include_alpha Whether alpha is averaged or the alpha of the first color is kept.
+		* \param color_space The rgb color space definition of mean_color(). If null the one of the first pushed color is used.
+		*/
+		explicit color_accumulator(color_type type, bool include_alpha = false, color_space::rgb_color_space_definition* color_space = nullptr);
+
+		//! Adds a color. Throws if the color is null or has a different color type.
+		void push(const color_space::color_base* color);
+
+		//! Adds all colors of a vector.
+		template <typename Color> void push(const std::vector<Color*>& colors)
+		{
+			for (auto color : colors) push(color);
+		}
+
+		//! Adds consecutive records of the color type of the accumulator.
+		/*!
+		* \param records The first value of the first record.
+		* \param count The number of records.
+		*/
+		void push(const float* records, size_t count);
+
+		//! Adds the colors of another accumulator. Throws if the color types or the alpha handling differ.
+		void merge(const color_accumulator& other);
+
+		//! Removes all colors.
+		void reset();
+
+		//! Returns the color type of the accumulator.
+		color_type get_color_type() const { return m_type; }
+
+		//! Returns the number of channels, i.e. the number of components plus one for alpha.
+		size_t get_channel_count() const { return m_channel_count; }
+
+		//! Whether the channel holds a hue in degrees.
+		bool is_hue_channel(size_t channel) const { return (int)channel == m_hue_channel; }
+
+		//! Returns the number of pushed colors.
+		uint64_t count() const { return m_count; }
+
+		//! Returns the mean of a channel. Hues are in [0, 360), the mean of hues that cancel each other out is 0.
+		float mean(size_t channel) const;
+
+		//! Returns the spread of a channel.
+		/*!
+		* \param channel The index of the channel.
+		* \return The population variance of linear channels. For hue channels the circular variance 1 - R, where R
+		* is the length of the mean unit vector: 0 if all hues are the same and 1 if they cancel each other out.
+		*/
+		float variance(size_t channel) const;
+
+		//! Writes the mean of all channels as a record. Throws if the accumulator is empty.
+		void mean_record(float* record) const;
+
+		//! Returns the mean color. Throws if the accumulator is empty or has no rgb color space definition. The caller owns the color.
+		color_space::color_base* mean_color() const;
+
+	protected:
+		//! Adds one record.
+		void push_record(const float* record);
+
+		//! Throws if the channel does not exist.
+		void check_channel(size_t channel) const;
+
+		//! The color type of the colors.
+		color_type m_type;
+
+		//! Whether alpha is averaged.
+		bool m_include_alpha;
+
+		//! The rgb color space definition of mean_color().
+		color_space::rgb_color_space_definition* m_color_space;
+
+		//! The number of channels including alpha.
+		size_t m_channel_count;
+
+		//! The index of the hue channel or -1.
+		int m_hue_channel;
+
+		//! The number of pushed colors.
+		uint64_t m_count;
+
+		//! Running mean of each linear channel.
+		std::array<double, max_channels> m_mean;
+
+		//! Running sum of squared deviations from the mean of each linear channel.
+		std::array<double, max_channels> m_squared_deviations;
+
+		//! Sums of the cosines and sines of the hues.
+		std::array<double, 2> m_hue_sum;
+
+		//! Kahan compensations of the hue sums.
+		std::array<double, 2> m_hue_compensation;
+
+		//! The alpha of the first color, used if alpha is not included.
+		float m_first_alpha;
+	};
+}
@@ -1,5 +1,8 @@
 #include "stdafx.h"
 #include "color_adjustments.h"
+#include "../utils/thread_pool.h"
+
+#include <memory>
 
 void color_manipulation::color_adjustments::saturate_in_rgb_space(color_space::color_base &color, float percentage)
 {
@@ -68,3 +71,49 @@ color_space::color_base * color_manipulation::color_adjustments::luminate_in_hsl
 
 	return color_manipulation::color_converter::convertTo(color_hsl, color->get_color_type());
 }
+
+std::vector<color_space::color_base*> color_manipulation::color_adjustments::batch_adjust(const std::vector<color_space::color_base*>& colors, std::function<color_space::color_base*(color_space::color_base*)> adjustment_function, executor* exec)
+{
+	if (!adjustment_function) throw new std::invalid_argument("adjustment function is null.");
+	for (auto color : colors)
+	{
+		if (color == nullptr) throw new std::invalid_argument("Input colors must not contain null.");
+	}
+
+	std::vector<color_space::color_base*> adjusted_colors(colors.size(), nullptr);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, colors.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			adjusted_colors[i] = adjustment_function(colors[i]);
+		}
+	});
+	return adjusted_colors;
+}
+
+void color_manipulation::color_adjustments::batch_adjust(const pixel_view& pixels, const mutable_pixel_view& out_pixels, color_space::rgb_color_space_definition* color_space, std::function<color_space::color_base*(color_space::color_base*)> adjustment_function, executor* exec)
+{
+	if (pixels.size() != out_pixels.size()) throw new std::invalid_argument("input and output views must have the same size.");
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+	if (!adjustment_function) throw new std::invalid_argument("adjustment function is null.");
+
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, pixels.size(), [&](size_t begin, size_t end)
+	{
+		float record[4];
+		for (size_t i = begin; i < end; ++i)
+		{
+			pixels.unpack(i, 1, record);
+			color_space::rgb_truecolor color(record[0], record[1], record[2], record[3], color_space);
+
+			const std::unique_ptr<color_space::color_base> adjusted(adjustment_function(&color));
+			if (adjusted == nullptr) continue; // keep the pixel like the list version keeps the null result
+
+			const std::unique_ptr<color_space::rgb_truecolor> rgb(color_manipulation::color_converter::to_rgb_true(adjusted.get()));
+			const float out_record[4] = { rgb->red(), rgb->green(), rgb->blue(), rgb->alpha() };
+			out_pixels.pack(i, 1, out_record);
+		}
+	});
+}
+
@@ -5,8 +5,13 @@
 
 #pragma once
 
-#include "..\spaces\color_base.h"
+#include "../spaces/color_base.h"
 #include "color_converter.h"
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+
+#include <functional>
+#include <vector>
 
 namespace color_manipulation
 {
@@ -116,5 +121,28 @@ namespace color_manipulation
 		* \return The modified color in the same color space like the input color.
 		*/
 		static color_space::color_base* luminate_in_hsl_space(color_space::color_base* color, float percentage);
+
+		//! Static function that applies an adjustment to a list of colors.
+		/*!
+		* The adjustment function is called for each input color. The calls are distributed over the threads of the given executor.
+		* \param colors The colors to manipulate. Must not contain null pointers.
+		* \param adjustment_function The function that adjusts a single color, e.g. a lambda that calls saturate_in_hsl_space().
+		* \param exec The executor that runs the adjustments. If null the default thread pool is used.
+		* \return The modified colors in the order of the input colors.
+		*/
+		static std::vector<color_space::color_base*> batch_adjust(const std::vector<color_space::color_base*>& colors, std::function<color_space::color_base*(color_space::color_base*)> adjustment_function, executor* exec = nullptr);
+
+		//! Static function that applies an adjustment to the pixels of a view and writes the results to another view.
+		/*!
+		* Like batch_adjust(colors, adjustment_function, exec), but each pixel is read as rgb true color directly from the viewed
+		* memory and each adjusted color is converted back to rgb true color and written to out_pixels. No colors are returned.
+		* out_pixels may be the same view like pixels.
+		* \param pixels The pixels to manipulate.
+		* \param out_pixels The view that receives the adjusted pixels. Must have the same size like pixels.
+		* \param color_space The rgb color space definition of the pixels.
+		* \param adjustment_function The function that adjusts a single color, e.g. a lambda that calls saturate_in_hsl_space().
+		* \param exec The executor that runs the adjustments. If null the default thread pool is used.
+		*/
+		static void batch_adjust(const pixel_view& pixels, const mutable_pixel_view& out_pixels, color_space::rgb_color_space_definition* color_space, std::function<color_space::color_base*(color_space::color_base*)> adjustment_function, executor* exec = nullptr);
 	};
 }
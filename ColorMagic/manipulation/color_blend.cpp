@@ -1,8 +1,14 @@
 #include "stdafx.h"
 #include "color_blend.h"
+#include "../utils/instrumentation.h"
+#include "../utils/thread_pool.h"
 
-color_space::color_base * color_manipulation::color_blend::normal(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+#include <memory>
+
+color_space::color_base * color_manipulation::color_blend::normal(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "normal");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -15,12 +21,15 @@ color_space::color_base * color_manipulation::color_blend::normal(color_space::c
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return s_component; }),
+			[](float s_component, float d_component) { return s_component; },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::dissolve(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::dissolve(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "dissolve");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -34,12 +43,15 @@ color_space::color_base * color_manipulation::color_blend::dissolve(color_space:
 			use_source_region,
 			use_destination_region,
 			true,
-			[source_dest_alpha_diff](float s_component, float d_component) { return dissolve_func(s_component, d_component, source_dest_alpha_diff); }),
+			[source_dest_alpha_diff](float s_component, float d_component) { return dissolve_func(s_component, d_component, source_dest_alpha_diff); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::multiply(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::multiply(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "multiply");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -52,12 +64,15 @@ color_space::color_base * color_manipulation::color_blend::multiply(color_space:
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return multiply_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return multiply_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::screen(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::screen(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "screen");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -73,12 +88,15 @@ color_space::color_base * color_manipulation::color_blend::screen(color_space::c
 			[](float s_component, float d_component)
 	{
 		return screen_func(s_component, d_component);
-	}),
+	},
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::overlay(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::overlay(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "overlay");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -94,12 +112,15 @@ color_space::color_base * color_manipulation::color_blend::overlay(color_space::
 			[](float s_component, float d_component)
 	{
 		return overlay_func(s_component, d_component);
-	}),
+	},
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::darken(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::darken(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "darken");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -112,12 +133,15 @@ color_space::color_base * color_manipulation::color_blend::darken(color_space::c
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return darken_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return darken_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::lighten(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::lighten(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "lighten");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -130,12 +154,15 @@ color_space::color_base * color_manipulation::color_blend::lighten(color_space::
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) {return lighten_func(s_component, d_component); }),
+			[](float s_component, float d_component) {return lighten_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::color_dodge(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::color_dodge(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "color_dodge");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -148,12 +175,15 @@ color_space::color_base * color_manipulation::color_blend::color_dodge(color_spa
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return color_dodge_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return color_dodge_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::linear_dodge(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::linear_dodge(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "linear_dodge");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -166,12 +196,15 @@ color_space::color_base * color_manipulation::color_blend::linear_dodge(color_sp
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return linear_dodge_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return linear_dodge_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::color_burn(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::color_burn(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "color_burn");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -184,12 +217,15 @@ color_space::color_base * color_manipulation::color_blend::color_burn(color_spac
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return color_burn_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return color_burn_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::linear_burn(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::linear_burn(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "linear_burn");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -202,12 +238,15 @@ color_space::color_base * color_manipulation::color_blend::linear_burn(color_spa
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return linear_burn_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return linear_burn_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::hard_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::hard_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "hard_light");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -220,12 +259,15 @@ color_space::color_base * color_manipulation::color_blend::hard_light(color_spac
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) {return hard_light_func(s_component, d_component); }),
+			[](float s_component, float d_component) {return hard_light_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::soft_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::soft_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "soft_light");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -238,12 +280,15 @@ color_space::color_base * color_manipulation::color_blend::soft_light(color_spac
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) {return soft_light_func(s_component, d_component); }),
+			[](float s_component, float d_component) {return soft_light_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::vivid_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::vivid_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "vivid_light");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -256,12 +301,15 @@ color_space::color_base * color_manipulation::color_blend::vivid_light(color_spa
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return vivid_light_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return vivid_light_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::linear_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::linear_light(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "linear_light");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -274,12 +322,15 @@ color_space::color_base * color_manipulation::color_blend::linear_light(color_sp
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return linear_light_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return linear_light_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base* color_manipulation::color_blend::pin_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region, bool use_destination_region)
+color_space::color_base* color_manipulation::color_blend::pin_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "pin_light");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -292,12 +343,15 @@ color_space::color_base* color_manipulation::color_blend::pin_light(color_space:
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return pin_light_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return pin_light_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base* color_manipulation::color_blend::hard_mix(color_space::color_base* source, color_space::color_base* destination, bool use_source_region, bool use_destination_region)
+color_space::color_base* color_manipulation::color_blend::hard_mix(color_space::color_base* source, color_space::color_base* destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "hard_mix");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -310,12 +364,15 @@ color_space::color_base* color_manipulation::color_blend::hard_mix(color_space::
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return hard_mix_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return hard_mix_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::difference(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::difference(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "difference");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -328,12 +385,15 @@ color_space::color_base * color_manipulation::color_blend::difference(color_spac
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) {return difference_func(s_component, d_component); }),
+			[](float s_component, float d_component) {return difference_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::subtract(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::subtract(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "subtract");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -346,12 +406,15 @@ color_space::color_base * color_manipulation::color_blend::subtract(color_space:
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return subtract_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return subtract_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::divide(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::divide(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "divide");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -364,12 +427,15 @@ color_space::color_base * color_manipulation::color_blend::divide(color_space::c
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return divide_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return divide_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::plus_lighter(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::plus_lighter(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "plus_lighter");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -382,12 +448,15 @@ color_space::color_base * color_manipulation::color_blend::plus_lighter(color_sp
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return plus_lighter_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return plus_lighter_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::plus_darker(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::plus_darker(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "plus_darker");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -400,12 +469,15 @@ color_space::color_base * color_manipulation::color_blend::plus_darker(color_spa
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) { return plus_darker_func(s_component, d_component); }),
+			[](float s_component, float d_component) { return plus_darker_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::exclusion(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
+color_space::color_base * color_manipulation::color_blend::exclusion(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "exclusion");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -418,12 +490,15 @@ color_space::color_base * color_manipulation::color_blend::exclusion(color_space
 			use_source_region,
 			use_destination_region,
 			true,
-			[](float s_component, float d_component) {return exclusion_func(s_component, d_component); }),
+			[](float s_component, float d_component) {return exclusion_func(s_component, d_component); },
+			linear_blending),
 		source->get_color_type());
 }
 
-color_space::color_base * color_manipulation::color_blend::custom_componentwise_blend(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, std::function<float(float, float)> blend_function)
+color_space::color_base * color_manipulation::color_blend::custom_componentwise_blend(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region, std::function<float(float, float)> blend_function, bool linear_blending)
 {
+	COLOR_MAGIC_COUNT("color_blend", "custom");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -436,12 +511,15 @@ color_space::color_base * color_manipulation::color_blend::custom_componentwise_
 			use_source_region,
 			use_destination_region,
 			true,
-			blend_function),
+			blend_function,
+			linear_blending),
 		source->get_color_type());
 }
 
 color_space::color_base * color_manipulation::color_blend::hue(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
 {
+	COLOR_MAGIC_COUNT("color_blend", "hue");
+
 	color_space::hcy* s_hcy = color_manipulation::color_converter::to_hcy(source);
 	color_space::hcy* d_hcy = color_manipulation::color_converter::to_hcy(destination);
 	color_space::hcy* result = new color_space::hcy(s_hcy->hue(), d_hcy->chroma(), d_hcy->luma(), s_hcy->alpha(), s_hcy->get_rgb_color_space());
@@ -450,6 +528,8 @@ color_space::color_base * color_manipulation::color_blend::hue(color_space::colo
 
 color_space::color_base * color_manipulation::color_blend::saturation(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
 {
+	COLOR_MAGIC_COUNT("color_blend", "saturation");
+
 	color_space::hcy* s_hcy = color_manipulation::color_converter::to_hcy(source);
 	color_space::hcy* d_hcy = color_manipulation::color_converter::to_hcy(destination);
 	color_space::hcy* result = new color_space::hcy(d_hcy->hue(), s_hcy->chroma(), d_hcy->luma(), s_hcy->alpha(), s_hcy->get_rgb_color_space());
@@ -458,6 +538,8 @@ color_space::color_base * color_manipulation::color_blend::saturation(color_spac
 
 color_space::color_base * color_manipulation::color_blend::color(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
 {
+	COLOR_MAGIC_COUNT("color_blend", "color");
+
 	color_space::hcy* s_hcy = color_manipulation::color_converter::to_hcy(source);
 	color_space::hcy* d_hcy = color_manipulation::color_converter::to_hcy(destination);
 	color_space::hcy* result = new color_space::hcy(s_hcy->hue(), s_hcy->chroma(), d_hcy->luma(), s_hcy->alpha(), s_hcy->get_rgb_color_space());
@@ -466,8 +548,63 @@ color_space::color_base * color_manipulation::color_blend::color(color_space::co
 
 color_space::color_base * color_manipulation::color_blend::luminosity(color_space::color_base * source, color_space::color_base * destination, bool use_source_region, bool use_destination_region)
 {
+	COLOR_MAGIC_COUNT("color_blend", "luminosity");
+
 	color_space::hcy* s_hcy = color_manipulation::color_converter::to_hcy(source);
 	color_space::hcy* d_hcy = color_manipulation::color_converter::to_hcy(destination);
 	color_space::hcy* result = new color_space::hcy(d_hcy->hue(), d_hcy->chroma(), s_hcy->luma(), s_hcy->alpha(), s_hcy->get_rgb_color_space());
 	return color_manipulation::color_converter::convertTo(result, source->get_color_type());
+}
+
+std::vector<color_space::color_base*> color_manipulation::color_blend::batch_blend(const std::vector<color_space::color_base*>& sources, const std::vector<color_space::color_base*>& destinations, std::function<color_space::color_base*(color_space::color_base*, color_space::color_base*)> blend_function, executor* exec)
+{
+	// Check input params
+	if (sources.size() != destinations.size()) throw new std::invalid_argument("source and destination lists must have the same size.");
+	if (!blend_function) throw new std::invalid_argument("blend function is null.");
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		if (sources[i] == nullptr) throw new std::invalid_argument("source color is null.");
+		if (destinations[i] == nullptr) throw new std::invalid_argument("destination color is null.");
+	}
+
+	COLOR_MAGIC_SCOPED_TIMER("color_blend::batch_blend");
+	std::vector<color_space::color_base*> blended_colors(sources.size(), nullptr);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, sources.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			blended_colors[i] = blend_function(sources[i], destinations[i]);
+		}
+	});
+	return blended_colors;
+}
+
+void color_manipulation::color_blend::batch_blend(const pixel_view& sources, const pixel_view& destinations, const mutable_pixel_view& out_pixels, color_space::rgb_color_space_definition* color_space, std::function<color_space::color_base*(color_space::color_base*, color_space::color_base*)> blend_function, executor* exec)
+{
+	// Check input params
+	if (sources.size() != destinations.size() || sources.size() != out_pixels.size()) throw new std::invalid_argument("source, destination and output views must have the same size.");
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+	if (!blend_function) throw new std::invalid_argument("blend function is null.");
+
+	COLOR_MAGIC_SCOPED_TIMER("color_blend::batch_blend(pixels)");
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, sources.size(), [&](size_t begin, size_t end)
+	{
+		float record[4];
+		for (size_t i = begin; i < end; ++i)
+		{
+			sources.unpack(i, 1, record);
+			color_space::rgb_truecolor source(record[0], record[1], record[2], record[3], color_space);
+			destinations.unpack(i, 1, record);
+			color_space::rgb_truecolor destination(record[0], record[1], record[2], record[3], color_space);
+
+			const std::unique_ptr<color_space::color_base> blended(blend_function(&source, &destination));
+			if (blended == nullptr) continue; // keep the pixel like the list version keeps the null result
+
+			const std::unique_ptr<color_space::rgb_truecolor> rgb(color_manipulation::color_converter::to_rgb_true(blended.get()));
+			const float out_record[4] = { rgb->red(), rgb->green(), rgb->blue(), rgb->alpha() };
+			out_pixels.pack(i, 1, out_record);
+		}
+	});
 }
\ No newline at end of file
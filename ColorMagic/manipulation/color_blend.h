@@ -6,14 +6,23 @@
 #pragma once
 
 #include "base_color_blend.h"
-#include "..\spaces\color_base.h"
+#include "../spaces/color_base.h"
 #include "color_converter.h"
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+
+#include <functional>
+#include <vector>
 
 namespace color_manipulation
 {
 	//! Static class for color blending operations
 	/*!
 	* This static class implements 25 different color blending operations.
+	*
+	* All separable blend operations take a linear_blending flag. If it is set, source and destination are decoded
+	* to linear light with the compiled gamma tables of their rgb color space definition, blended and encoded again
+	* in the same pass. Otherwise the gamma encoded values are blended, like in most image editors.
 	*/
 	class color_blend : protected base_color_blend
 	{
@@ -35,9 +44,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with normal blending.
 		*/
-		static color_space::color_base* normal(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* normal(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does dissolve blending.
 		/*!
@@ -57,9 +67,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with dissolve blending.
 		*/
-		static color_space::color_base* dissolve(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* dissolve(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does multiply blending.
 		/*!
@@ -79,9 +90,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with multiply blending.
 		*/
-		static color_space::color_base* multiply(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* multiply(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does screen blending.
 		/*!
@@ -101,9 +113,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with screen blending.
 		*/
-		static color_space::color_base* screen(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* screen(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does overlay blending.
 		/*!
@@ -123,9 +136,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with overlay blending.
 		*/
-		static color_space::color_base* overlay(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* overlay(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does darken blending.
 		/*!
@@ -145,9 +159,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with darken blending.
 		*/
-		static color_space::color_base* darken(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* darken(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does lighten blending.
 		/*!
@@ -167,9 +182,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with lighten blending.
 		*/
-		static color_space::color_base* lighten(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* lighten(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does color-dodge blending.
 		/*!
@@ -189,9 +205,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with color-dodge blending.
 		*/
-		static color_space::color_base* color_dodge(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* color_dodge(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does linear-dodge blending.
 		/*!
@@ -211,9 +228,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with linear-dodge blending.
 		*/
-		static color_space::color_base* linear_dodge(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* linear_dodge(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does color-burn blending.
 		/*!
@@ -233,9 +251,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with color-burn blending.
 		*/
-		static color_space::color_base* color_burn(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* color_burn(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does linear-burn blending.
 		/*!
@@ -255,9 +274,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with linear-burn blending.
 		*/
-		static color_space::color_base* linear_burn(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* linear_burn(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does hard-light blending.
 		/*!
@@ -277,9 +297,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with hard-light blending.
 		*/
-		static color_space::color_base* hard_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* hard_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does soft-light blending.
 		/*!
@@ -299,9 +320,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with soft-light blending.
 		*/
-		static color_space::color_base* soft_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* soft_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does vivid light blending.
 		/*!
@@ -321,9 +343,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with lighten blending.
 		*/
-		static color_space::color_base* vivid_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* vivid_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does linear-light blending.
 		/*!
@@ -343,9 +366,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with linear-light blending.
 		*/
-		static color_space::color_base* linear_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* linear_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does pin-light blending.
 		/*!
@@ -365,9 +389,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with pin-light blending.
 		*/
-		static color_space::color_base* pin_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* pin_light(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does hard-mix blending.
 		/*!
@@ -387,9 +412,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with hard-mix blending.
 		*/
-		static color_space::color_base* hard_mix(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* hard_mix(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does difference blending.
 		/*!
@@ -409,9 +435,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with difference blending.
 		*/
-		static color_space::color_base* difference(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* difference(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does subtract blending.
 		/*!
@@ -431,9 +458,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with subtract blending.
 		*/
-		static color_space::color_base* subtract(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* subtract(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does divide blending.
 		/*!
@@ -453,9 +481,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with divide blending.
 		*/
-		static color_space::color_base* divide(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* divide(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does plus-lighter blending.
 		/*!
@@ -475,9 +504,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with plus-lighter blending.
 		*/
-		static color_space::color_base* plus_lighter(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* plus_lighter(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does plus-darker blending.
 		/*!
@@ -497,9 +527,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with plus-darker blending.
 		*/
-		static color_space::color_base* plus_darker(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* plus_darker(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does exclusion blending.
 		/*!
@@ -519,9 +550,10 @@ namespace color_manipulation
 		* or not.
 		* \param use_destination_region Whether the destination region of the resulting pixel will
 		* be blank or not.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with exclusion blending.
 		*/
-		static color_space::color_base* exclusion(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
+		static color_space::color_base* exclusion(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true, bool linear_blending = false);
 
 		//! Static function that does custom componentwise blending.
 		/*!
@@ -543,9 +575,10 @@ namespace color_manipulation
 		* be blank or not.
 		* \param blend_function The function that does the blending. It awaits source and destination
 		* components as input (in this order) and returns a blended float component.
+		* \param linear_blending Whether to blend in linear light instead of the gamma encoded values, see the class description.
 		* \return the combination of source and destination calculated with custom blending.
 		*/
-		static color_space::color_base* custom_componentwise_blend(color_space::color_base* source, color_space::color_base* destination, bool use_source_region, bool use_destination_region, std::function<float(float, float)> blend_function);
+		static color_space::color_base* custom_componentwise_blend(color_space::color_base* source, color_space::color_base* destination, bool use_source_region, bool use_destination_region, std::function<float(float, float)> blend_function, bool linear_blending = false);
 
 		//! Static function that does hue blending.
 		/*!
@@ -643,6 +676,32 @@ namespace color_manipulation
 		*/
 		static color_space::color_base* luminosity(color_space::color_base* source, color_space::color_base* destination, bool use_source_region = true, bool use_destination_region = true);
 
+		//! Static function that blends two lists of colors pairwise.
+		/*!
+		* The blend function is called for each pair sources[i], destinations[i]. The calls are distributed over the threads of the
+		* given executor.
+		* \param sources The source colors of the operations. Must not contain null pointers.
+		* \param destinations The destination colors of the operations. Must have the same size like sources and must not contain null pointers.
+		* \param blend_function The function that blends a single pair, e.g. a lambda that calls multiply().
+		* \param exec The executor that runs the blend operations. If null the default thread pool is used.
+		* \return The blended colors in the order of the input pairs.
+		*/
+		static std::vector<color_space::color_base*> batch_blend(const std::vector<color_space::color_base*>& sources, const std::vector<color_space::color_base*>& destinations, std::function<color_space::color_base*(color_space::color_base*, color_space::color_base*)> blend_function, executor* exec = nullptr);
+
+		//! Static function that blends the pixels of two views pairwise and writes the results to a third view.
+		/*!
+		* Like batch_blend(sources, destinations, blend_function, exec), but each pixel is read as rgb true color directly from
+		* the viewed memory and each blended color is converted back to rgb true color and written to out_pixels. No colors are
+		* returned. out_pixels may be the same view like sources or destinations.
+		* \param sources The source pixels of the operations.
+		* \param destinations The destination pixels of the operations. Must have the same size like sources.
+		* \param out_pixels The view that receives the blended pixels. Must have the same size like sources.
+		* \param color_space The rgb color space definition of the pixels.
+		* \param blend_function The function that blends a single pair, e.g. a lambda that calls multiply().
+		* \param exec The executor that runs the blend operations. If null the default thread pool is used.
+		*/
+		static void batch_blend(const pixel_view& sources, const pixel_view& destinations, const mutable_pixel_view& out_pixels, color_space::rgb_color_space_definition* color_space, std::function<color_space::color_base*(color_space::color_base*, color_space::color_base*)> blend_function, executor* exec = nullptr);
+
 	protected:
 		static float dissolve_func(float s, float d, float alpha_diff)
 		{
@@ -523,7 +523,7 @@ color_space::rgb_truecolor * color_manipulation::color_calculation::average_rgb_
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ (unsigned int)0, (unsigned int)0, (unsigned int)0, (unsigned int)0 };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->red();
@@ -538,7 +538,7 @@ color_space::rgb_deepcolor * color_manipulation::color_calculation::average_rgb_
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->red();
@@ -553,7 +553,7 @@ color_space::grey_truecolor * color_manipulation::color_calculation::average_gre
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[2]{ (unsigned int)0, (unsigned int)0 };
+	float sum[2] = { 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->grey();
@@ -566,7 +566,7 @@ color_space::grey_deepcolor * color_manipulation::color_calculation::average_gre
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[2]{ 0.f, 0.f };
+	float sum[2] = { 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->grey();
@@ -579,14 +579,14 @@ color_space::cmyk * color_manipulation::color_calculation::average_cmyk(std::vec
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[5]{ 0.f, 0.f, 0.f, 0.f, 0.f};
+	float sum[5] = { 0.f, 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->cyan();
 		sum[1] += colors[i]->magenta();
 		sum[2] += colors[i]->yellow();
 		sum[3] += colors[i]->black();
-		sum[4] = include_alpha ? sum[3] + colors[i]->alpha() : colors[0]->alpha();
+		sum[4] = include_alpha ? sum[4] + colors[i]->alpha() : colors[0]->alpha();
 	}
 	return new color_space::cmyk(sum[0] / colors.size(), sum[1] / colors.size(), sum[2] / colors.size(), sum[3] / colors.size(), include_alpha ? sum[4] / colors.size() : sum[4], colors[0]->get_rgb_color_space());
 }
@@ -595,7 +595,7 @@ color_space::hsi * color_manipulation::color_calculation::average_hsi(std::vecto
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->hue();
@@ -610,7 +610,7 @@ color_space::hsv * color_manipulation::color_calculation::average_hsv(std::vecto
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->hue();
@@ -625,7 +625,7 @@ color_space::hsl * color_manipulation::color_calculation::average_hsl(std::vecto
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->hue();
@@ -640,7 +640,7 @@ color_space::hcy * color_manipulation::color_calculation::average_hcy(std::vecto
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->hue();
@@ -655,7 +655,7 @@ color_space::xyz * color_manipulation::color_calculation::average_xyz(std::vecto
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->x();
@@ -670,7 +670,7 @@ color_space::xyy * color_manipulation::color_calculation::average_xyy(std::vecto
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->x();
@@ -685,7 +685,7 @@ color_space::cieluv * color_manipulation::color_calculation::average_cieluv(std:
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->L();
@@ -700,7 +700,7 @@ color_space::lab * color_manipulation::color_calculation::average_lab(std::vecto
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->luminance();
@@ -715,7 +715,7 @@ color_space::lch_ab * color_manipulation::color_calculation::average_lch_ab(std:
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->luminance();
@@ -730,7 +730,7 @@ color_space::lch_uv * color_manipulation::color_calculation::average_lch_uv(std:
 {
 	if (colors.empty()) throw new std::invalid_argument("Parameter colors cannot be empty.");
 
-	auto sum = new float[4]{ 0.f, 0.f, 0.f, 0.f };
+	float sum[4] = { 0.f, 0.f, 0.f, 0.f };
 	for (unsigned int i = 0; i < colors.size(); ++i)
 	{
 		sum[0] += colors[i]->luminance();
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "..\spaces\color_base.h"
+#include "../spaces/color_base.h"
 #include "color_converter.h"
 
 namespace color_manipulation
@@ -630,6 +630,7 @@ namespace color_manipulation
 		//! Static function that averages a vector of hsi colors.
 		/*!
 		* Averages each hsi component of the colors seperately.
+		* The hues are averaged linearly, so 350 and 10 degrees give 180. color_accumulator averages them on the circle.
 		* \param colors The vector of colors to average.
 		* \param include_alpha Whether alpha should be included in the calculation or not.
 		* \return a new color object with the resulting color of this calculation.
@@ -639,6 +640,7 @@ namespace color_manipulation
 		//! Static function that averages a vector of hsv colors.
 		/*!
 		* Averages each hsv component of the colors seperately.
+		* The hues are averaged linearly, so 350 and 10 degrees give 180. color_accumulator averages them on the circle.
 		* \param colors The vector of colors to average.
 		* \param include_alpha Whether alpha should be included in the calculation or not.
 		* \return a new color object with the resulting color of this calculation.
@@ -648,6 +650,7 @@ namespace color_manipulation
 		//! Static function that averages a vector of hsl colors.
 		/*!
 		* Averages each hsl component of the colors seperately.
+		* The hues are averaged linearly, so 350 and 10 degrees give 180. color_accumulator averages them on the circle.
 		* \param colors The vector of colors to average.
 		* \param include_alpha Whether alpha should be included in the calculation or not.
 		* \return a new color object with the resulting color of this calculation.
@@ -657,6 +660,7 @@ namespace color_manipulation
 		//! Static function that averages a vector of hcy colors.
 		/*!
 		* Averages each hcy component of the colors seperately.
+		* The hues are averaged linearly, so 350 and 10 degrees give 180. color_accumulator averages them on the circle.
 		* \param colors The vector of colors to average.
 		* \param include_alpha Whether alpha should be included in the calculation or not.
 		* \return a new color object with the resulting color of this calculation.
@@ -702,6 +706,7 @@ namespace color_manipulation
 		//! Static function that averages a vector of lch_ab colors.
 		/*!
 		* Averages each lch_ab component of the colors seperately.
+		* The hues are averaged linearly, so 350 and 10 degrees give 180. color_accumulator averages them on the circle.
 		* \param colors The vector of colors to average.
 		* \param include_alpha Whether alpha should be included in the calculation or not.
 		* \return a new color object with the resulting color of this calculation.
@@ -711,6 +716,7 @@ namespace color_manipulation
 		//! Static function that averages a vector of lch_uv colors.
 		/*!
 		* Averages each lch_uv component of the colors seperately.
+		* The hues are averaged linearly, so 350 and 10 degrees give 180. color_accumulator averages them on the circle.
 		* \param colors The vector of colors to average.
 		* \param include_alpha Whether alpha should be included in the calculation or not.
 		* \return a new color object with the resulting color of this calculation.
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "..\spaces\color_base.h"
+#include "../spaces/color_base.h"
 #include "color_converter.h"
 #include "color_adjustments.h"
 #include <vector>
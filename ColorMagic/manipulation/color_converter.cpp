@@ -1,132 +1,556 @@
 #include "stdafx.h"
 #include "color_converter.h"
+#include "lab_table.h"
+#include "../utils/instrumentation.h"
+#include "../utils/precision.h"
+#include "../utils/thread_pool.h"
 
 #define N_ROOT(x, n) std::powf(x, 1.f / n)
 
-color_space::color_base* color_manipulation::color_converter::convertTo(color_space::color_base* in_color, color_type out_color)
+// Policy of the conversion that runs on the calling thread or -1 for precision::get_default(). The overloads that
+// take a policy set it for the duration of the call, so the nested conversion steps see it without passing it through
+// every function, and conversions on other threads are not affected.
+static thread_local int thread_policy = -1;
+
+// Sets the policy of the calling thread until the end of the scope and restores the previous one afterwards
+class policy_scope
+{
+public:
+	explicit policy_scope(precision_policy policy) : m_previous(thread_policy) { thread_policy = (int)policy; }
+	~policy_scope() { thread_policy = m_previous; }
+
+	policy_scope(const policy_scope&) = delete;
+	policy_scope& operator=(const policy_scope&) = delete;
+
+private:
+	int m_previous;
+};
+
+static precision_policy active_policy()
+{
+	return thread_policy < 0 ? precision::get_default() : (precision_policy)thread_policy;
+}
+
+// Math of the active precision policy. EXACT keeps the original expressions, so its results do not change.
+static float policy_cbrt(float x)
+{
+	switch (active_policy())
+	{
+	case FAST: return precision_math<FAST>::cbrt(x);
+	case FASTEST: return precision_math<FASTEST>::cbrt(x);
+	default: return N_ROOT(x, 3.f);
+	}
+}
+
+static float policy_cube(float x)
+{
+	return active_policy() == EXACT ? std::powf(x, 3.f) : x * x * x;
+}
+
+static float policy_atan2(float y, float x)
+{
+	switch (active_policy())
+	{
+	case FAST: return precision_math<FAST>::atan2(y, x);
+	case FASTEST: return precision_math<FASTEST>::atan2(y, x);
+	default: return atan2f(y, x);
+	}
+}
+
+static float policy_sin(float x)
+{
+	switch (active_policy())
+	{
+	case FAST: return precision_math<FAST>::sin(x);
+	case FASTEST: return precision_math<FASTEST>::sin(x);
+	default: return sinf(x);
+	}
+}
+
+static float policy_cos(float x)
+{
+	switch (active_policy())
+	{
+	case FAST: return precision_math<FAST>::cos(x);
+	case FASTEST: return precision_math<FASTEST>::cos(x);
+	default: return cosf(x);
+	}
+}
+
+// Creates a table entry that casts the input color to the source class and calls the given converter function
+#define CONVERSION(from, to, function) &color_manipulation::color_converter::kernel<color_space::from, color_space::to, &color_manipulation::color_converter::function>
+
+// Rows are the input color types, columns the output color types, both in the order of the color_type enum
+const color_manipulation::color_converter::conversion_function color_manipulation::color_converter::s_conversion_table[color_type_count][color_type_count] =
+{
+	// RGB_TRUE
+	{
+		&color_manipulation::color_converter::copy<color_space::rgb_truecolor>,
+		CONVERSION(rgb_truecolor, rgb_deepcolor, rgb_true_to_rgb_deep),
+		CONVERSION(rgb_truecolor, grey_truecolor, rgb_true_to_grey_true),
+		CONVERSION(rgb_truecolor, grey_deepcolor, rgb_true_to_grey_deep),
+		CONVERSION(rgb_truecolor, cmyk, rgb_true_to_cmyk),
+		CONVERSION(rgb_truecolor, hsi, rgb_true_to_hsi),
+		CONVERSION(rgb_truecolor, hsv, rgb_true_to_hsv),
+		CONVERSION(rgb_truecolor, hsl, rgb_true_to_hsl),
+		CONVERSION(rgb_truecolor, hcy, rgb_true_to_hcy),
+		CONVERSION(rgb_truecolor, xyz, rgb_true_to_xyz),
+		CONVERSION(rgb_truecolor, xyy, rgb_true_to_xyy),
+		CONVERSION(rgb_truecolor, cieluv, rgb_true_to_cieluv),
+		CONVERSION(rgb_truecolor, lab, rgb_true_to_lab),
+		CONVERSION(rgb_truecolor, lch_ab, rgb_true_to_lch_ab),
+		CONVERSION(rgb_truecolor, lch_uv, rgb_true_to_lch_uv)
+	},
+	// RGB_DEEP
+	{
+		CONVERSION(rgb_deepcolor, rgb_truecolor, rgb_deep_to_rgb_true),
+		&color_manipulation::color_converter::copy<color_space::rgb_deepcolor>,
+		CONVERSION(rgb_deepcolor, grey_truecolor, rgb_deep_to_grey_true),
+		CONVERSION(rgb_deepcolor, grey_deepcolor, rgb_deep_to_grey_deep),
+		CONVERSION(rgb_deepcolor, cmyk, rgb_deep_to_cmyk),
+		CONVERSION(rgb_deepcolor, hsi, rgb_deep_to_hsi),
+		CONVERSION(rgb_deepcolor, hsv, rgb_deep_to_hsv),
+		CONVERSION(rgb_deepcolor, hsl, rgb_deep_to_hsl),
+		CONVERSION(rgb_deepcolor, hcy, rgb_deep_to_hcy),
+		CONVERSION(rgb_deepcolor, xyz, rgb_deep_to_xyz),
+		CONVERSION(rgb_deepcolor, xyy, rgb_deep_to_xyy),
+		CONVERSION(rgb_deepcolor, cieluv, rgb_deep_to_cieluv),
+		CONVERSION(rgb_deepcolor, lab, rgb_deep_to_lab),
+		CONVERSION(rgb_deepcolor, lch_ab, rgb_deep_to_lch_ab),
+		CONVERSION(rgb_deepcolor, lch_uv, rgb_deep_to_lch_uv)
+	},
+	// GREY_TRUE
+	{
+		CONVERSION(grey_truecolor, rgb_truecolor, grey_true_to_rgb_true),
+		CONVERSION(grey_truecolor, rgb_deepcolor, grey_true_to_rgb_deep),
+		&color_manipulation::color_converter::copy<color_space::grey_truecolor>,
+		CONVERSION(grey_truecolor, grey_deepcolor, grey_true_to_grey_deep),
+		CONVERSION(grey_truecolor, cmyk, grey_true_to_cmyk),
+		CONVERSION(grey_truecolor, hsi, grey_true_to_hsi),
+		CONVERSION(grey_truecolor, hsv, grey_true_to_hsv),
+		CONVERSION(grey_truecolor, hsl, grey_true_to_hsl),
+		CONVERSION(grey_truecolor, hcy, grey_true_to_hcy),
+		CONVERSION(grey_truecolor, xyz, grey_true_to_xyz),
+		CONVERSION(grey_truecolor, xyy, grey_true_to_xyy),
+		CONVERSION(grey_truecolor, cieluv, grey_true_to_cieluv),
+		CONVERSION(grey_truecolor, lab, grey_true_to_lab),
+		CONVERSION(grey_truecolor, lch_ab, grey_true_to_lch_ab),
+		CONVERSION(grey_truecolor, lch_uv, grey_true_to_lch_uv)
+	},
+	// GREY_DEEP
+	{
+		CONVERSION(grey_deepcolor, rgb_truecolor, grey_deep_to_rgb_true),
+		CONVERSION(grey_deepcolor, rgb_deepcolor, grey_deep_to_rgb_deep),
+		CONVERSION(grey_deepcolor, grey_truecolor, grey_deep_to_grey_true),
+		&color_manipulation::color_converter::copy<color_space::grey_deepcolor>,
+		CONVERSION(grey_deepcolor, cmyk, grey_deep_to_cmyk),
+		CONVERSION(grey_deepcolor, hsi, grey_deep_to_hsi),
+		CONVERSION(grey_deepcolor, hsv, grey_deep_to_hsv),
+		CONVERSION(grey_deepcolor, hsl, grey_deep_to_hsl),
+		CONVERSION(grey_deepcolor, hcy, grey_deep_to_hcy),
+		CONVERSION(grey_deepcolor, xyz, grey_deep_to_xyz),
+		CONVERSION(grey_deepcolor, xyy, grey_deep_to_xyy),
+		CONVERSION(grey_deepcolor, cieluv, grey_deep_to_cieluv),
+		CONVERSION(grey_deepcolor, lab, grey_deep_to_lab),
+		CONVERSION(grey_deepcolor, lch_ab, grey_deep_to_lch_ab),
+		CONVERSION(grey_deepcolor, lch_uv, grey_deep_to_lch_uv)
+	},
+	// CMYK
+	{
+		CONVERSION(cmyk, rgb_truecolor, cmyk_to_rgb_true),
+		CONVERSION(cmyk, rgb_deepcolor, cmyk_to_rgb_deep),
+		CONVERSION(cmyk, grey_truecolor, cmyk_to_grey_true),
+		CONVERSION(cmyk, grey_deepcolor, cmyk_to_grey_deep),
+		&color_manipulation::color_converter::copy<color_space::cmyk>,
+		CONVERSION(cmyk, hsi, cmyk_to_hsi),
+		CONVERSION(cmyk, hsv, cmyk_to_hsv),
+		CONVERSION(cmyk, hsl, cmyk_to_hsl),
+		CONVERSION(cmyk, hcy, cmyk_to_hcy),
+		CONVERSION(cmyk, xyz, cmyk_to_xyz),
+		CONVERSION(cmyk, xyy, cmyk_to_xyy),
+		CONVERSION(cmyk, cieluv, cmyk_to_cieluv),
+		CONVERSION(cmyk, lab, cmyk_to_lab),
+		CONVERSION(cmyk, lch_ab, cmyk_to_lch_ab),
+		CONVERSION(cmyk, lch_uv, cmyk_to_lch_uv)
+	},
+	// HSI
+	{
+		CONVERSION(hsi, rgb_truecolor, hsi_to_rgb_true),
+		CONVERSION(hsi, rgb_deepcolor, hsi_to_rgb_deep),
+		CONVERSION(hsi, grey_truecolor, hsi_to_grey_true),
+		CONVERSION(hsi, grey_deepcolor, hsi_to_grey_deep),
+		CONVERSION(hsi, cmyk, hsi_to_cmyk),
+		&color_manipulation::color_converter::copy<color_space::hsi>,
+		CONVERSION(hsi, hsv, hsi_to_hsv),
+		CONVERSION(hsi, hsl, hsi_to_hsl),
+		CONVERSION(hsi, hcy, hsi_to_hcy),
+		CONVERSION(hsi, xyz, hsi_to_xyz),
+		CONVERSION(hsi, xyy, hsi_to_xyy),
+		CONVERSION(hsi, cieluv, hsi_to_cieluv),
+		CONVERSION(hsi, lab, hsi_to_lab),
+		CONVERSION(hsi, lch_ab, hsi_to_lch_ab),
+		CONVERSION(hsi, lch_uv, hsi_to_lch_uv)
+	},
+	// HSV
+	{
+		CONVERSION(hsv, rgb_truecolor, hsv_to_rgb_true),
+		CONVERSION(hsv, rgb_deepcolor, hsv_to_rgb_deep),
+		CONVERSION(hsv, grey_truecolor, hsv_to_grey_true),
+		CONVERSION(hsv, grey_deepcolor, hsv_to_grey_deep),
+		CONVERSION(hsv, cmyk, hsv_to_cmyk),
+		CONVERSION(hsv, hsi, hsv_to_hsi),
+		&color_manipulation::color_converter::copy<color_space::hsv>,
+		CONVERSION(hsv, hsl, hsv_to_hsl),
+		CONVERSION(hsv, hcy, hsv_to_hcy),
+		CONVERSION(hsv, xyz, hsv_to_xyz),
+		CONVERSION(hsv, xyy, hsv_to_xyy),
+		CONVERSION(hsv, cieluv, hsv_to_cieluv),
+		CONVERSION(hsv, lab, hsv_to_lab),
+		CONVERSION(hsv, lch_ab, hsv_to_lch_ab),
+		CONVERSION(hsv, lch_uv, hsv_to_lch_uv)
+	},
+	// HSL
+	{
+		CONVERSION(hsl, rgb_truecolor, hsl_to_rgb_true),
+		CONVERSION(hsl, rgb_deepcolor, hsl_to_rgb_deep),
+		CONVERSION(hsl, grey_truecolor, hsl_to_grey_true),
+		CONVERSION(hsl, grey_deepcolor, hsl_to_grey_deep),
+		CONVERSION(hsl, cmyk, hsl_to_cmyk),
+		CONVERSION(hsl, hsi, hsl_to_hsi),
+		CONVERSION(hsl, hsv, hsl_to_hsv),
+		&color_manipulation::color_converter::copy<color_space::hsl>,
+		CONVERSION(hsl, hcy, hsl_to_hcy),
+		CONVERSION(hsl, xyz, hsl_to_xyz),
+		CONVERSION(hsl, xyy, hsl_to_xyy),
+		CONVERSION(hsl, cieluv, hsl_to_cieluv),
+		CONVERSION(hsl, lab, hsl_to_lab),
+		CONVERSION(hsl, lch_ab, hsl_to_lch_ab),
+		CONVERSION(hsl, lch_uv, hsl_to_lch_uv)
+	},
+	// HCY
+	{
+		CONVERSION(hcy, rgb_truecolor, hcy_to_rgb_true),
+		CONVERSION(hcy, rgb_deepcolor, hcy_to_rgb_deep),
+		CONVERSION(hcy, grey_truecolor, hcy_to_grey_true),
+		CONVERSION(hcy, grey_deepcolor, hcy_to_grey_deep),
+		CONVERSION(hcy, cmyk, hcy_to_cmyk),
+		CONVERSION(hcy, hsi, hcy_to_hsi),
+		CONVERSION(hcy, hsv, hcy_to_hsv),
+		CONVERSION(hcy, hsl, hcy_to_hsl),
+		&color_manipulation::color_converter::copy<color_space::hcy>,
+		CONVERSION(hcy, xyz, hcy_to_xyz),
+		CONVERSION(hcy, xyy, hcy_to_xyy),
+		CONVERSION(hcy, cieluv, hcy_to_cieluv),
+		CONVERSION(hcy, lab, hcy_to_lab),
+		CONVERSION(hcy, lch_ab, hcy_to_lch_ab),
+		CONVERSION(hcy, lch_uv, hcy_to_lch_uv)
+	},
+	// XYZ
+	{
+		CONVERSION(xyz, rgb_truecolor, xyz_to_rgb_true),
+		CONVERSION(xyz, rgb_deepcolor, xyz_to_rgb_deep),
+		CONVERSION(xyz, grey_truecolor, xyz_to_grey_true),
+		CONVERSION(xyz, grey_deepcolor, xyz_to_grey_deep),
+		CONVERSION(xyz, cmyk, xyz_to_cmyk),
+		CONVERSION(xyz, hsi, xyz_to_hsi),
+		CONVERSION(xyz, hsv, xyz_to_hsv),
+		CONVERSION(xyz, hsl, xyz_to_hsl),
+		CONVERSION(xyz, hcy, xyz_to_hcy),
+		&color_manipulation::color_converter::copy<color_space::xyz>,
+		CONVERSION(xyz, xyy, xyz_to_xyy),
+		CONVERSION(xyz, cieluv, xyz_to_cieluv),
+		CONVERSION(xyz, lab, xyz_to_lab),
+		CONVERSION(xyz, lch_ab, xyz_to_lch_ab),
+		CONVERSION(xyz, lch_uv, xyz_to_lch_uv)
+	},
+	// XYY
+	{
+		CONVERSION(xyy, rgb_truecolor, xyy_to_rgb_true),
+		CONVERSION(xyy, rgb_deepcolor, xyy_to_rgb_deep),
+		CONVERSION(xyy, grey_truecolor, xyy_to_grey_true),
+		CONVERSION(xyy, grey_deepcolor, xyy_to_grey_deep),
+		CONVERSION(xyy, cmyk, xyy_to_cmyk),
+		CONVERSION(xyy, hsi, xyy_to_hsi),
+		CONVERSION(xyy, hsv, xyy_to_hsv),
+		CONVERSION(xyy, hsl, xyy_to_hsl),
+		CONVERSION(xyy, hcy, xyy_to_hcy),
+		CONVERSION(xyy, xyz, xyy_to_xyz),
+		&color_manipulation::color_converter::copy<color_space::xyy>,
+		CONVERSION(xyy, cieluv, xyy_to_cieluv),
+		CONVERSION(xyy, lab, xyy_to_lab),
+		CONVERSION(xyy, lch_ab, xyy_to_lch_ab),
+		CONVERSION(xyy, lch_uv, xyy_to_lch_uv)
+	},
+	// CIELUV
+	{
+		CONVERSION(cieluv, rgb_truecolor, cieluv_to_rgb_true),
+		CONVERSION(cieluv, rgb_deepcolor, cieluv_to_rgb_deep),
+		CONVERSION(cieluv, grey_truecolor, cieluv_to_grey_true),
+		CONVERSION(cieluv, grey_deepcolor, cieluv_to_grey_deep),
+		CONVERSION(cieluv, cmyk, cieluv_to_cmyk),
+		CONVERSION(cieluv, hsi, cieluv_to_hsi),
+		CONVERSION(cieluv, hsv, cieluv_to_hsv),
+		CONVERSION(cieluv, hsl, cieluv_to_hsl),
+		CONVERSION(cieluv, hcy, cieluv_to_hcy),
+		CONVERSION(cieluv, xyz, cieluv_to_xyz),
+		CONVERSION(cieluv, xyy, cieluv_to_xyy),
+		&color_manipulation::color_converter::copy<color_space::cieluv>,
+		CONVERSION(cieluv, lab, cieluv_to_lab),
+		CONVERSION(cieluv, lch_ab, cieluv_to_lch_ab),
+		CONVERSION(cieluv, lch_uv, cieluv_to_lch_uv)
+	},
+	// LAB
+	{
+		CONVERSION(lab, rgb_truecolor, lab_to_rgb_true),
+		CONVERSION(lab, rgb_deepcolor, lab_to_rgb_deep),
+		CONVERSION(lab, grey_truecolor, lab_to_grey_true),
+		CONVERSION(lab, grey_deepcolor, lab_to_grey_deep),
+		CONVERSION(lab, cmyk, lab_to_cmyk),
+		CONVERSION(lab, hsi, lab_to_hsi),
+		CONVERSION(lab, hsv, lab_to_hsv),
+		CONVERSION(lab, hsl, lab_to_hsl),
+		CONVERSION(lab, hcy, lab_to_hcy),
+		CONVERSION(lab, xyz, lab_to_xyz),
+		CONVERSION(lab, xyy, lab_to_xyy),
+		CONVERSION(lab, cieluv, lab_to_cieluv),
+		&color_manipulation::color_converter::copy<color_space::lab>,
+		CONVERSION(lab, lch_ab, lab_to_lch_ab),
+		CONVERSION(lab, lch_uv, lab_to_lch_uv)
+	},
+	// LCH_AB
+	{
+		CONVERSION(lch_ab, rgb_truecolor, lch_ab_to_rgb_true),
+		CONVERSION(lch_ab, rgb_deepcolor, lch_ab_to_rgb_deep),
+		CONVERSION(lch_ab, grey_truecolor, lch_ab_to_grey_true),
+		CONVERSION(lch_ab, grey_deepcolor, lch_ab_to_grey_deep),
+		CONVERSION(lch_ab, cmyk, lch_ab_to_cmyk),
+		CONVERSION(lch_ab, hsi, lch_ab_to_hsi),
+		CONVERSION(lch_ab, hsv, lch_ab_to_hsv),
+		CONVERSION(lch_ab, hsl, lch_ab_to_hsl),
+		CONVERSION(lch_ab, hcy, lch_ab_to_hcy),
+		CONVERSION(lch_ab, xyz, lch_ab_to_xyz),
+		CONVERSION(lch_ab, xyy, lch_ab_to_xyy),
+		CONVERSION(lch_ab, cieluv, lch_ab_to_cieluv),
+		CONVERSION(lch_ab, lab, lch_ab_to_lab),
+		&color_manipulation::color_converter::copy<color_space::lch_ab>,
+		CONVERSION(lch_ab, lch_uv, lch_ab_to_lch_uv)
+	},
+	// LCH_UV
+	{
+		CONVERSION(lch_uv, rgb_truecolor, lch_uv_to_rgb_true),
+		CONVERSION(lch_uv, rgb_deepcolor, lch_uv_to_rgb_deep),
+		CONVERSION(lch_uv, grey_truecolor, lch_uv_to_grey_true),
+		CONVERSION(lch_uv, grey_deepcolor, lch_uv_to_grey_deep),
+		CONVERSION(lch_uv, cmyk, lch_uv_to_cmyk),
+		CONVERSION(lch_uv, hsi, lch_uv_to_hsi),
+		CONVERSION(lch_uv, hsv, lch_uv_to_hsv),
+		CONVERSION(lch_uv, hsl, lch_uv_to_hsl),
+		CONVERSION(lch_uv, hcy, lch_uv_to_hcy),
+		CONVERSION(lch_uv, xyz, lch_uv_to_xyz),
+		CONVERSION(lch_uv, xyy, lch_uv_to_xyy),
+		CONVERSION(lch_uv, cieluv, lch_uv_to_cieluv),
+		CONVERSION(lch_uv, lab, lch_uv_to_lab),
+		CONVERSION(lch_uv, lch_ab, lch_uv_to_lch_ab),
+		&color_manipulation::color_converter::copy<color_space::lch_uv>
+	}
+};
+
+#undef CONVERSION
+
+color_space::color_base* color_manipulation::color_converter::dispatch(const color_space::color_base* in_color, color_type out_color)
+{
+	auto function = get_conversion_function(in_color->get_color_type(), out_color);
+	if (function == nullptr) return nullptr;
+	COLOR_MAGIC_COUNT_CONVERSIONS(in_color->get_color_type(), out_color, 1);
+	return function(in_color);
+}
+
+color_space::color_base* color_manipulation::color_converter::convertTo(const color_space::color_base* in_color, color_type out_color)
+{
+	return color_manipulation::color_converter::dispatch(in_color, out_color);
+}
+
+color_space::color_base* color_manipulation::color_converter::convertTo(const color_space::color_base* in_color, color_type out_color, precision_policy policy)
+{
+	policy_scope scope(policy);
+	return color_manipulation::color_converter::dispatch(in_color, out_color);
+}
+
+std::vector<color_space::color_base*> color_manipulation::color_converter::convertTo(const std::vector<color_space::color_base*>& in_colors, color_type out_color, executor* exec)
+{
+	return color_manipulation::color_converter::convertTo(in_colors, out_color, active_policy(), exec);
+}
+
+std::vector<color_space::color_base*> color_manipulation::color_converter::convertTo(const std::vector<color_space::color_base*>& in_colors, color_type out_color, precision_policy policy, executor* exec)
 {
-	switch (out_color)
+	for (auto color : in_colors)
 	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::to_rgb_true(in_color);
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::to_rgb_deep(in_color);
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::to_grey_true(in_color);
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::to_grey_deep(in_color);
-	case color_type::CMYK:
-		return color_manipulation::color_converter::to_cmyk(in_color);
-	case color_type::HSI:
-		return color_manipulation::color_converter::to_hsi(in_color);
-	case color_type::HSV:
-		return color_manipulation::color_converter::to_hsv(in_color);
-	case color_type::HSL:
-		return color_manipulation::color_converter::to_hsl(in_color);
-	case color_type::HCY:
-		return color_manipulation::color_converter::to_hcy(in_color);
-	case color_type::XYZ:
-		return color_manipulation::color_converter::to_xyz(in_color);
-	case color_type::XYY:
-		return color_manipulation::color_converter::to_xyy(in_color);
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::to_cieluv(in_color);
-	case color_type::LAB:
-		return color_manipulation::color_converter::to_lab(in_color);
-	default:
-		return nullptr;
+		if (color == nullptr) throw new std::invalid_argument("Input colors must not contain null.");
 	}
+
+	// Resolve the converter functions once instead of dispatching for every color
+	std::array<conversion_function, color_type_count> kernels;
+	for (size_t type = 0; type < color_type_count; ++type)
+	{
+		kernels[type] = color_manipulation::color_converter::get_conversion_function((color_type)type, out_color);
+	}
+
+	COLOR_MAGIC_SCOPED_TIMER("color_converter::convertTo(batch)");
+	std::vector<color_space::color_base*> out_colors(in_colors.size(), nullptr);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, in_colors.size(), [&](size_t begin, size_t end)
+	{
+		// The chunks may run on other threads, so each one sets the policy of the call
+		policy_scope scope(policy);
+#ifdef COLOR_MAGIC_INSTRUMENTATION
+		// Counted per chunk, so the threads do not compete for the shared counters
+		std::array<uint64_t, color_type_count> counts = {};
+#endif
+		for (size_t i = begin; i < end; ++i)
+		{
+			size_t type = (size_t)in_colors[i]->get_color_type();
+			out_colors[i] = type < color_type_count && kernels[type] != nullptr ? kernels[type](in_colors[i]) : nullptr;
+#ifdef COLOR_MAGIC_INSTRUMENTATION
+			if (out_colors[i] != nullptr) ++counts[type];
+#endif
+		}
+#ifdef COLOR_MAGIC_INSTRUMENTATION
+		for (size_t type = 0; type < color_type_count; ++type)
+		{
+			if (counts[type] > 0) COLOR_MAGIC_COUNT_CONVERSIONS((color_type)type, out_color, counts[type]);
+		}
+#endif
+	});
+	return out_colors;
+}
+
+std::vector<color_space::color_base*> color_manipulation::color_converter::convertTo(const pixel_view& in_pixels, color_space::rgb_color_space_definition* color_space, color_type out_color, executor* exec)
+{
+	return color_manipulation::color_converter::convertTo(in_pixels, color_space, out_color, active_policy(), exec);
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::rgb_true_to_rgb_deep(color_space::rgb_truecolor* color)
+std::vector<color_space::color_base*> color_manipulation::color_converter::convertTo(const pixel_view& in_pixels, color_space::rgb_color_space_definition* color_space, color_type out_color, precision_policy policy, executor* exec)
+{
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+
+	auto kernel = color_manipulation::color_converter::get_conversion_function(color_type::RGB_TRUE, out_color);
+	std::vector<color_space::color_base*> out_colors(in_pixels.size(), nullptr);
+	if (kernel == nullptr) return out_colors;
+
+	COLOR_MAGIC_SCOPED_TIMER("color_converter::convertTo(pixels)");
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, in_pixels.size(), [&](size_t begin, size_t end)
+	{
+		policy_scope scope(policy);
+		COLOR_MAGIC_COUNT_CONVERSIONS(color_type::RGB_TRUE, out_color, end - begin);
+		float record[4];
+		for (size_t i = begin; i < end; ++i)
+		{
+			in_pixels.unpack(i, 1, record);
+			color_space::rgb_truecolor color(record[0], record[1], record[2], record[3], color_space);
+			out_colors[i] = kernel(&color);
+		}
+	});
+	return out_colors;
+}
+
+color_space::rgb_deepcolor* color_manipulation::color_converter::rgb_true_to_rgb_deep(const color_space::rgb_truecolor* color)
 {
 	return new color_space::rgb_deepcolor(color->red() / 255.f, color->green() / 255.f, color->blue() / 255.f, color->alpha() / 255.f, color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::rgb_true_to_grey_true(color_space::rgb_truecolor* color)
+color_space::grey_truecolor* color_manipulation::color_converter::rgb_true_to_grey_true(const color_space::rgb_truecolor* color)
 {
 	auto avg = (color->red() + color->green() + color->blue()) / 3;
 	return new color_space::grey_truecolor(avg, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::rgb_true_to_grey_deep(color_space::rgb_truecolor* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::rgb_true_to_grey_deep(const color_space::rgb_truecolor* color)
 {
-	auto grey_true = *color_manipulation::color_converter::rgb_true_to_grey_true(color);
-	return new color_space::grey_deepcolor(grey_true.grey() / 255.f, grey_true.alpha() / 255.f, color->get_rgb_color_space());
+	auto grey_true = temporary(color_manipulation::color_converter::rgb_true_to_grey_true(color));
+	return new color_space::grey_deepcolor(grey_true->grey() / 255.f, grey_true->alpha() / 255.f, color->get_rgb_color_space());
 }
 
-color_space::cmyk* color_manipulation::color_converter::rgb_true_to_cmyk(color_space::rgb_truecolor* color)
+color_space::cmyk* color_manipulation::color_converter::rgb_true_to_cmyk(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::rgb_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::rgb_true_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::rgb_true_to_hsi(color_space::rgb_truecolor* color)
+color_space::hsi* color_manipulation::color_converter::rgb_true_to_hsi(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::rgb_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::rgb_true_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::rgb_true_to_hsv(color_space::rgb_truecolor* color)
+color_space::hsv* color_manipulation::color_converter::rgb_true_to_hsv(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsv(color_manipulation::color_converter::rgb_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsv(temporary(color_manipulation::color_converter::rgb_true_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::rgb_true_to_hsl(color_space::rgb_truecolor* color)
+color_space::hsl* color_manipulation::color_converter::rgb_true_to_hsl(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsl(color_manipulation::color_converter::rgb_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsl(temporary(color_manipulation::color_converter::rgb_true_to_rgb_deep(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::rgb_true_to_hcy(color_space::rgb_truecolor* color)
+color_space::hcy* color_manipulation::color_converter::rgb_true_to_hcy(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::rgb_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::rgb_true_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::rgb_true_to_xyz(color_space::rgb_truecolor* color)
+color_space::xyz* color_manipulation::color_converter::rgb_true_to_xyz(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::rgb_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::rgb_true_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::rgb_true_to_xyy(color_space::rgb_truecolor* color)
+color_space::xyy* color_manipulation::color_converter::rgb_true_to_xyy(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::rgb_true_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::rgb_true_to_xyz(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::rgb_true_to_cieluv(color_space::rgb_truecolor* color)
+color_space::cieluv* color_manipulation::color_converter::rgb_true_to_cieluv(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::rgb_true_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::rgb_true_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::rgb_true_to_lab(color_space::rgb_truecolor* color)
+color_space::lab* color_manipulation::color_converter::rgb_true_to_lab(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::rgb_true_to_rgb_deep(color));
+	// Use the precomputed table if one is active for this color space
+	auto table = color_manipulation::lab_table::get_active();
+	if (table != nullptr && table->matches(color->get_rgb_color_space()))
+	{
+		auto lab = table->lookup(color);
+		if (lab != nullptr) return lab;
+	}
+
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::rgb_true_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::rgb_true_to_lch_ab(color_space::rgb_truecolor* color)
+color_space::lch_ab* color_manipulation::color_converter::rgb_true_to_lch_ab(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::rgb_true_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::rgb_true_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::rgb_true_to_lch_uv(color_space::rgb_truecolor* color)
+color_space::lch_uv* color_manipulation::color_converter::rgb_true_to_lch_uv(const color_space::rgb_truecolor* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::rgb_true_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::rgb_true_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::rgb_deep_to_rgb_true(color_space::rgb_deepcolor* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::rgb_deep_to_rgb_true(const color_space::rgb_deepcolor* color)
 {
 	return new color_space::rgb_truecolor(roundf(color->red()* 255.f), roundf(color->green()* 255.f), roundf(color->blue()* 255.f), roundf(color->alpha()* 255.f), color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::rgb_deep_to_grey_true(color_space::rgb_deepcolor* color)
+color_space::grey_truecolor* color_manipulation::color_converter::rgb_deep_to_grey_true(const color_space::rgb_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_true_to_grey_true(color_manipulation::color_converter::rgb_deep_to_rgb_true(color));
+	return color_manipulation::color_converter::rgb_true_to_grey_true(temporary(color_manipulation::color_converter::rgb_deep_to_rgb_true(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::rgb_deep_to_grey_deep(color_space::rgb_deepcolor* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::rgb_deep_to_grey_deep(const color_space::rgb_deepcolor* color)
 {
 	auto avg = ((color->red() + color->green() + color->blue()) / 3.f);
 	return new color_space::grey_deepcolor(avg, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::cmyk* color_manipulation::color_converter::rgb_deep_to_cmyk(color_space::rgb_deepcolor* color)
+color_space::cmyk* color_manipulation::color_converter::rgb_deep_to_cmyk(const color_space::rgb_deepcolor* color)
 {
 	auto k = 1 - std::fmaxf(std::fmaxf(color->red(), color->green()), color->blue());
 	auto c = (1 - color->red() - k) / (1.f - k);
@@ -135,7 +559,7 @@ color_space::cmyk* color_manipulation::color_converter::rgb_deep_to_cmyk(color_s
 	return new color_space::cmyk(c, m, y, k, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::hsi* color_manipulation::color_converter::rgb_deep_to_hsi(color_space::rgb_deepcolor* color)
+color_space::hsi* color_manipulation::color_converter::rgb_deep_to_hsi(const color_space::rgb_deepcolor* color)
 {
 	float min = std::fmin(std::fmin(color->red(), color->green()), color->blue());
 	float max = std::fmax(std::fmax(color->red(), color->green()), color->blue());
@@ -153,7 +577,7 @@ color_space::hsi* color_manipulation::color_converter::rgb_deep_to_hsi(color_spa
 	}
 }
 
-color_space::hsv* color_manipulation::color_converter::rgb_deep_to_hsv(color_space::rgb_deepcolor* color)
+color_space::hsv* color_manipulation::color_converter::rgb_deep_to_hsv(const color_space::rgb_deepcolor* color)
 {
 	float min = std::fmin(std::fmin(color->red(), color->green()), color->blue());
 	float max = std::fmax(std::fmax(color->red(), color->green()), color->blue());
@@ -171,7 +595,7 @@ color_space::hsv* color_manipulation::color_converter::rgb_deep_to_hsv(color_spa
 	}
 }
 
-color_space::hsl* color_manipulation::color_converter::rgb_deep_to_hsl(color_space::rgb_deepcolor* color)
+color_space::hsl* color_manipulation::color_converter::rgb_deep_to_hsl(const color_space::rgb_deepcolor* color)
 {
 	float min = std::fmin(std::fmin(color->red(), color->green()), color->blue());
 	float max = std::fmax(std::fmax(color->red(), color->green()), color->blue());
@@ -189,7 +613,7 @@ color_space::hsl* color_manipulation::color_converter::rgb_deep_to_hsl(color_spa
 	}
 }
 
-color_space::hcy* color_manipulation::color_converter::rgb_deep_to_hcy(color_space::rgb_deepcolor* color)
+color_space::hcy* color_manipulation::color_converter::rgb_deep_to_hcy(const color_space::rgb_deepcolor* color)
 {
 	float min = std::fmin(std::fmin(color->red(), color->green()), color->blue());
 	float max = std::fmax(std::fmax(color->red(), color->green()), color->blue());
@@ -211,185 +635,191 @@ color_space::hcy* color_manipulation::color_converter::rgb_deep_to_hcy(color_spa
 	}
 }
 
-color_space::xyz* color_manipulation::color_converter::rgb_deep_to_xyz(color_space::rgb_deepcolor* color)
+color_space::xyz* color_manipulation::color_converter::rgb_deep_to_xyz(const color_space::rgb_deepcolor* color)
 {
-	color->do_inverse_gamma_correction();
+	// Linearize a local copy of the components so that the input color stays untouched
+	auto gamma_curve = color->get_rgb_color_space()->get_gamma_curve();
+	auto linear_components = color->get_component_vector();
+	for (size_t i = 0; i < linear_components.size(); ++i)
+	{
+		linear_components[i] = clamp_float(gamma_curve->inverse_gamma_correction(linear_components[i], active_policy()), color->get_component_min(), color->get_component_max());
+	}
 
-	auto xyz_components = color->get_rgb_color_space()->get_transform_matrix()* color->get_component_vector();
+	auto xyz_components = color->get_rgb_color_space()->get_transform_matrix()* linear_components;
 	return new color_space::xyz(xyz_components[0], xyz_components[1], xyz_components[2], color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::xyy* color_manipulation::color_converter::rgb_deep_to_xyy(color_space::rgb_deepcolor* color)
+color_space::xyy* color_manipulation::color_converter::rgb_deep_to_xyy(const color_space::rgb_deepcolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::rgb_deep_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::rgb_deep_to_xyz(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::rgb_deep_to_cieluv(color_space::rgb_deepcolor* color)
+color_space::cieluv* color_manipulation::color_converter::rgb_deep_to_cieluv(const color_space::rgb_deepcolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::rgb_deep_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::rgb_deep_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::rgb_deep_to_lab(color_space::rgb_deepcolor* color)
+color_space::lab* color_manipulation::color_converter::rgb_deep_to_lab(const color_space::rgb_deepcolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_lab(color_manipulation::color_converter::rgb_deep_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_lab(temporary(color_manipulation::color_converter::rgb_deep_to_xyz(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::rgb_deep_to_lch_ab(color_space::rgb_deepcolor* color)
+color_space::lch_ab* color_manipulation::color_converter::rgb_deep_to_lch_ab(const color_space::rgb_deepcolor* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::rgb_deep_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::rgb_deep_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::rgb_deep_to_lch_uv(color_space::rgb_deepcolor* color)
+color_space::lch_uv* color_manipulation::color_converter::rgb_deep_to_lch_uv(const color_space::rgb_deepcolor* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::rgb_deep_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::rgb_deep_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::grey_true_to_rgb_true(color_space::grey_truecolor* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::grey_true_to_rgb_true(const color_space::grey_truecolor* color)
 {
 	return new color_space::rgb_truecolor(color->grey(), color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::grey_true_to_rgb_deep(color_space::grey_truecolor* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::grey_true_to_rgb_deep(const color_space::grey_truecolor* color)
 {
 	return new color_space::rgb_deepcolor(color->grey() / 255.f, color->alpha() / 255.f, color->get_rgb_color_space());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::grey_true_to_grey_deep(color_space::grey_truecolor* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::grey_true_to_grey_deep(const color_space::grey_truecolor* color)
 {
 	return new color_space::grey_deepcolor(color->grey() / 255.f, color->alpha() / 255.f, color->get_rgb_color_space());
 }
 
-color_space::cmyk* color_manipulation::color_converter::grey_true_to_cmyk(color_space::grey_truecolor* color)
+color_space::cmyk* color_manipulation::color_converter::grey_true_to_cmyk(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::grey_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::grey_true_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::grey_true_to_hsi(color_space::grey_truecolor* color)
+color_space::hsi* color_manipulation::color_converter::grey_true_to_hsi(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::grey_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::grey_true_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::grey_true_to_hsv(color_space::grey_truecolor* color)
+color_space::hsv* color_manipulation::color_converter::grey_true_to_hsv(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsv(color_manipulation::color_converter::grey_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsv(temporary(color_manipulation::color_converter::grey_true_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::grey_true_to_hsl(color_space::grey_truecolor* color)
+color_space::hsl* color_manipulation::color_converter::grey_true_to_hsl(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsl(color_manipulation::color_converter::grey_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsl(temporary(color_manipulation::color_converter::grey_true_to_rgb_deep(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::grey_true_to_hcy(color_space::grey_truecolor* color)
+color_space::hcy* color_manipulation::color_converter::grey_true_to_hcy(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::grey_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::grey_true_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::grey_true_to_xyz(color_space::grey_truecolor* color)
+color_space::xyz* color_manipulation::color_converter::grey_true_to_xyz(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::grey_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::grey_true_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::grey_true_to_xyy(color_space::grey_truecolor* color)
+color_space::xyy* color_manipulation::color_converter::grey_true_to_xyy(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::grey_true_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::grey_true_to_xyz(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::grey_true_to_cieluv(color_space::grey_truecolor* color)
+color_space::cieluv* color_manipulation::color_converter::grey_true_to_cieluv(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::grey_true_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::grey_true_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::grey_true_to_lab(color_space::grey_truecolor* color)
+color_space::lab* color_manipulation::color_converter::grey_true_to_lab(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::grey_true_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::grey_true_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::grey_true_to_lch_ab(color_space::grey_truecolor* color)
+color_space::lch_ab* color_manipulation::color_converter::grey_true_to_lch_ab(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::grey_true_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::grey_true_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::grey_true_to_lch_uv(color_space::grey_truecolor* color)
+color_space::lch_uv* color_manipulation::color_converter::grey_true_to_lch_uv(const color_space::grey_truecolor* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::grey_true_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::grey_true_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::grey_deep_to_rgb_true(color_space::grey_deepcolor* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::grey_deep_to_rgb_true(const color_space::grey_deepcolor* color)
 {
 	return new color_space::rgb_truecolor(roundf(color->grey()* 255.f), roundf(color->alpha()* 255.f), color->get_rgb_color_space());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::grey_deep_to_rgb_deep(color_space::grey_deepcolor* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::grey_deep_to_rgb_deep(const color_space::grey_deepcolor* color)
 {
 	return new color_space::rgb_deepcolor(color->grey(), color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::grey_deep_to_grey_true(color_space::grey_deepcolor* color)
+color_space::grey_truecolor* color_manipulation::color_converter::grey_deep_to_grey_true(const color_space::grey_deepcolor* color)
 {
 	return new color_space::grey_truecolor(roundf(color->grey()* 255.f), roundf(color->alpha()* 255.f), color->get_rgb_color_space());
 }
 
-color_space::cmyk* color_manipulation::color_converter::grey_deep_to_cmyk(color_space::grey_deepcolor* color)
+color_space::cmyk* color_manipulation::color_converter::grey_deep_to_cmyk(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::grey_deep_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::grey_deep_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::grey_deep_to_hsi(color_space::grey_deepcolor* color)
+color_space::hsi* color_manipulation::color_converter::grey_deep_to_hsi(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::grey_deep_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::grey_deep_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::grey_deep_to_hsv(color_space::grey_deepcolor* color)
+color_space::hsv* color_manipulation::color_converter::grey_deep_to_hsv(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsv(color_manipulation::color_converter::grey_deep_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsv(temporary(color_manipulation::color_converter::grey_deep_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::grey_deep_to_hsl(color_space::grey_deepcolor* color)
+color_space::hsl* color_manipulation::color_converter::grey_deep_to_hsl(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsl(color_manipulation::color_converter::grey_deep_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsl(temporary(color_manipulation::color_converter::grey_deep_to_rgb_deep(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::grey_deep_to_hcy(color_space::grey_deepcolor* color)
+color_space::hcy* color_manipulation::color_converter::grey_deep_to_hcy(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::grey_deep_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::grey_deep_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::grey_deep_to_xyz(color_space::grey_deepcolor* color)
+color_space::xyz* color_manipulation::color_converter::grey_deep_to_xyz(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::grey_deep_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::grey_deep_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::grey_deep_to_xyy(color_space::grey_deepcolor* color)
+color_space::xyy* color_manipulation::color_converter::grey_deep_to_xyy(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::grey_deep_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::grey_deep_to_xyz(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::grey_deep_to_cieluv(color_space::grey_deepcolor* color)
+color_space::cieluv* color_manipulation::color_converter::grey_deep_to_cieluv(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::grey_deep_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::grey_deep_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::grey_deep_to_lab(color_space::grey_deepcolor* color)
+color_space::lab* color_manipulation::color_converter::grey_deep_to_lab(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::grey_deep_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::grey_deep_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::grey_deep_to_lch_ab(color_space::grey_deepcolor* color)
+color_space::lch_ab* color_manipulation::color_converter::grey_deep_to_lch_ab(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::grey_deep_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::grey_deep_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::grey_deep_to_lch_uv(color_space::grey_deepcolor* color)
+color_space::lch_uv* color_manipulation::color_converter::grey_deep_to_lch_uv(const color_space::grey_deepcolor* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::grey_deep_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::grey_deep_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::cmyk_to_rgb_true(color_space::cmyk* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::cmyk_to_rgb_true(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_rgb_true(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_rgb_true(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::cmyk_to_rgb_deep(color_space::cmyk* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::cmyk_to_rgb_deep(const color_space::cmyk* color)
 {
 	auto r = (1 - color->cyan())* (1 - color->black());
 	auto g = (1 - color->magenta())* (1 - color->black());
@@ -397,72 +827,72 @@ color_space::rgb_deepcolor* color_manipulation::color_converter::cmyk_to_rgb_dee
 	return new color_space::rgb_deepcolor(r, g, b, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::cmyk_to_grey_true(color_space::cmyk* color)
+color_space::grey_truecolor* color_manipulation::color_converter::cmyk_to_grey_true(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_true(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_true(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::cmyk_to_grey_deep(color_space::cmyk* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::cmyk_to_grey_deep(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_deep(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_deep(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::cmyk_to_hsi(color_space::cmyk* color)
+color_space::hsi* color_manipulation::color_converter::cmyk_to_hsi(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::cmyk_to_hsv(color_space::cmyk* color)
+color_space::hsv* color_manipulation::color_converter::cmyk_to_hsv(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsv(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsv(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::cmyk_to_hsl(color_space::cmyk* color)
+color_space::hsl* color_manipulation::color_converter::cmyk_to_hsl(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsl(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsl(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::cmyk_to_hcy(color_space::cmyk* color)
+color_space::hcy* color_manipulation::color_converter::cmyk_to_hcy(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::cmyk_to_xyz(color_space::cmyk* color)
+color_space::xyz* color_manipulation::color_converter::cmyk_to_xyz(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::cmyk_to_xyy(color_space::cmyk* color)
+color_space::xyy* color_manipulation::color_converter::cmyk_to_xyy(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::cmyk_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::cmyk_to_xyz(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::cmyk_to_cieluv(color_space::cmyk* color)
+color_space::cieluv* color_manipulation::color_converter::cmyk_to_cieluv(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::cmyk_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::cmyk_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::cmyk_to_lab(color_space::cmyk* color)
+color_space::lab* color_manipulation::color_converter::cmyk_to_lab(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::cmyk_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::cmyk_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::cmyk_to_lch_ab(color_space::cmyk* color)
+color_space::lch_ab* color_manipulation::color_converter::cmyk_to_lch_ab(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::cmyk_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::cmyk_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::cmyk_to_lch_uv(color_space::cmyk* color)
+color_space::lch_uv* color_manipulation::color_converter::cmyk_to_lch_uv(const color_space::cmyk* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::cmyk_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::cmyk_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::hsi_to_rgb_true(color_space::hsi* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::hsi_to_rgb_true(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_rgb_true(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_rgb_true(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::hsi_to_rgb_deep(color_space::hsi* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::hsi_to_rgb_deep(const color_space::hsi* color)
 {
 	if (color->saturation() == 0.f)
 	{
@@ -486,72 +916,72 @@ color_space::rgb_deepcolor* color_manipulation::color_converter::hsi_to_rgb_deep
 	return new color_space::rgb_deepcolor(r_temp, g_temp, b_temp, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::hsi_to_grey_true(color_space::hsi* color)
+color_space::grey_truecolor* color_manipulation::color_converter::hsi_to_grey_true(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_true(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_true(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::hsi_to_grey_deep(color_space::hsi* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::hsi_to_grey_deep(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_deep(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_deep(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::hsi_to_cmyk(color_space::hsi* color)
+color_space::cmyk* color_manipulation::color_converter::hsi_to_cmyk(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::hsi_to_hsv(color_space::hsi* color)
+color_space::hsv* color_manipulation::color_converter::hsi_to_hsv(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsv(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsv(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::hsi_to_hsl(color_space::hsi* color)
+color_space::hsl* color_manipulation::color_converter::hsi_to_hsl(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsl(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsl(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::hsi_to_hcy(color_space::hsi* color)
+color_space::hcy* color_manipulation::color_converter::hsi_to_hcy(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::hsi_to_xyz(color_space::hsi* color)
+color_space::xyz* color_manipulation::color_converter::hsi_to_xyz(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::hsi_to_xyy(color_space::hsi* color)
+color_space::xyy* color_manipulation::color_converter::hsi_to_xyy(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyy(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyy(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::hsi_to_cieluv(color_space::hsi* color)
+color_space::cieluv* color_manipulation::color_converter::hsi_to_cieluv(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cieluv(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cieluv(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::hsi_to_lab(color_space::hsi* color)
+color_space::lab* color_manipulation::color_converter::hsi_to_lab(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::hsi_to_lch_ab(color_space::hsi* color)
+color_space::lch_ab* color_manipulation::color_converter::hsi_to_lch_ab(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lch_ab(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lch_ab(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::hsi_to_lch_uv(color_space::hsi* color)
+color_space::lch_uv* color_manipulation::color_converter::hsi_to_lch_uv(const color_space::hsi* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lch_uv(color_manipulation::color_converter::hsi_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lch_uv(temporary(color_manipulation::color_converter::hsi_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::hsv_to_rgb_true(color_space::hsv* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::hsv_to_rgb_true(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_rgb_true(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_rgb_true(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::hsv_to_rgb_deep(color_space::hsv* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::hsv_to_rgb_deep(const color_space::hsv* color)
 {
 	/*
 	auto chroma = color->value()* color->saturation();
@@ -577,28 +1007,28 @@ color_space::rgb_deepcolor* color_manipulation::color_converter::hsv_to_rgb_deep
 	return new color_space::rgb_deepcolor(r_temp, g_temp, b_temp, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::hsv_to_grey_true(color_space::hsv* color)
+color_space::grey_truecolor* color_manipulation::color_converter::hsv_to_grey_true(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_true(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_true(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::hsv_to_grey_deep(color_space::hsv* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::hsv_to_grey_deep(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_deep(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_deep(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::hsv_to_cmyk(color_space::hsv* color)
+color_space::cmyk* color_manipulation::color_converter::hsv_to_cmyk(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::hsv_to_hsi(color_space::hsv* color)
+color_space::hsi* color_manipulation::color_converter::hsv_to_hsi(const color_space::hsv* color)
 {
 	// Since intensity is defined as (R + G + B) / 3 a conversion to rgb is necessarry.
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::hsv_to_hsl(color_space::hsv* color)
+color_space::hsl* color_manipulation::color_converter::hsv_to_hsl(const color_space::hsv* color)
 {
 	auto l = (2.f - color->saturation())* color->value();
 	auto s = color->saturation()* color->value();
@@ -607,47 +1037,47 @@ color_space::hsl* color_manipulation::color_converter::hsv_to_hsl(color_space::h
 	return new color_space::hsl(color->hue(), s, l, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::hcy* color_manipulation::color_converter::hsv_to_hcy(color_space::hsv* color)
+color_space::hcy* color_manipulation::color_converter::hsv_to_hcy(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::hsv_to_xyz(color_space::hsv* color)
+color_space::xyz* color_manipulation::color_converter::hsv_to_xyz(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::hsv_to_xyy(color_space::hsv* color)
+color_space::xyy* color_manipulation::color_converter::hsv_to_xyy(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::hsv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::hsv_to_xyz(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::hsv_to_cieluv(color_space::hsv* color)
+color_space::cieluv* color_manipulation::color_converter::hsv_to_cieluv(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::hsv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::hsv_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::hsv_to_lab(color_space::hsv* color)
+color_space::lab* color_manipulation::color_converter::hsv_to_lab(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::hsv_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::hsv_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::hsv_to_lch_ab(color_space::hsv* color)
+color_space::lch_ab* color_manipulation::color_converter::hsv_to_lch_ab(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::hsv_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::hsv_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::hsv_to_lch_uv(color_space::hsv* color)
+color_space::lch_uv* color_manipulation::color_converter::hsv_to_lch_uv(const color_space::hsv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::hsv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::hsv_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::hsl_to_rgb_true(color_space::hsl* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::hsl_to_rgb_true(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_rgb_true(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_rgb_true(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::hsl_to_rgb_deep(color_space::hsl* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::hsl_to_rgb_deep(const color_space::hsl* color)
 {
 	if (color->lightness() == 0.f) return new color_space::rgb_deepcolor(0.f, 0.f, color->get_rgb_color_space());
 
@@ -679,27 +1109,27 @@ color_space::rgb_deepcolor* color_manipulation::color_converter::hsl_to_rgb_deep
 	return new color_space::rgb_deepcolor(r, g, b, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::hsl_to_grey_true(color_space::hsl* color)
+color_space::grey_truecolor* color_manipulation::color_converter::hsl_to_grey_true(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_true(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_true(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::hsl_to_grey_deep(color_space::hsl* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::hsl_to_grey_deep(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_deep(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_deep(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::hsl_to_cmyk(color_space::hsl* color)
+color_space::cmyk* color_manipulation::color_converter::hsl_to_cmyk(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::hsl_to_hsi(color_space::hsl* color)
+color_space::hsi* color_manipulation::color_converter::hsl_to_hsi(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::hsl_to_hsv(color_space::hsl* color)
+color_space::hsv* color_manipulation::color_converter::hsl_to_hsv(const color_space::hsl* color)
 {
 	auto l_temp = color->lightness()* 2.f;
 	auto m_sat = color->saturation()* (l_temp <= 1.f) ? l_temp : (2.f - l_temp);
@@ -708,47 +1138,47 @@ color_space::hsv* color_manipulation::color_converter::hsl_to_hsv(color_space::h
 	return new color_space::hsv(color->hue(), s, v, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::hcy* color_manipulation::color_converter::hsl_to_hcy(color_space::hsl* color)
+color_space::hcy* color_manipulation::color_converter::hsl_to_hcy(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::hsl_to_xyz(color_space::hsl* color)
+color_space::xyz* color_manipulation::color_converter::hsl_to_xyz(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::hsl_to_xyy(color_space::hsl* color)
+color_space::xyy* color_manipulation::color_converter::hsl_to_xyy(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::hsl_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::hsl_to_xyz(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::hsl_to_cieluv(color_space::hsl* color)
+color_space::cieluv* color_manipulation::color_converter::hsl_to_cieluv(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::hsl_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::hsl_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::hsl_to_lab(color_space::hsl* color)
+color_space::lab* color_manipulation::color_converter::hsl_to_lab(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::hsl_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::hsl_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::hsl_to_lch_ab(color_space::hsl* color)
+color_space::lch_ab* color_manipulation::color_converter::hsl_to_lch_ab(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::hsl_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::hsl_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::hsl_to_lch_uv(color_space::hsl* color)
+color_space::lch_uv* color_manipulation::color_converter::hsl_to_lch_uv(const color_space::hsl* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::hsl_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::hsl_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::hcy_to_rgb_true(color_space::hcy* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::hcy_to_rgb_true(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_rgb_true(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_rgb_true(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::hcy_to_rgb_deep(color_space::hcy* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::hcy_to_rgb_deep(const color_space::hcy* color)
 {
 	float unit_hue = color->hue() / 360.f;
 	float r = clamp_float(fabsf(unit_hue* 6.f - 3.f) - 1.f, 0.f, 1.f);
@@ -770,72 +1200,72 @@ color_space::rgb_deepcolor* color_manipulation::color_converter::hcy_to_rgb_deep
 	return new color_space::rgb_deepcolor(r, g, b, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::hcy_to_grey_true(color_space::hcy* color)
+color_space::grey_truecolor* color_manipulation::color_converter::hcy_to_grey_true(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_true(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_true(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::hcy_to_grey_deep(color_space::hcy* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::hcy_to_grey_deep(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_deep(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_deep(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::hcy_to_cmyk(color_space::hcy* color)
+color_space::cmyk* color_manipulation::color_converter::hcy_to_cmyk(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::hcy_to_hsi(color_space::hcy* color)
+color_space::hsi* color_manipulation::color_converter::hcy_to_hsi(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::hcy_to_hsv(color_space::hcy* color)
+color_space::hsv* color_manipulation::color_converter::hcy_to_hsv(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsv(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsv(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::hcy_to_hsl(color_space::hcy* color)
+color_space::hsl* color_manipulation::color_converter::hcy_to_hsl(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsl(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsl(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::hcy_to_xyz(color_space::hcy* color)
+color_space::xyz* color_manipulation::color_converter::hcy_to_xyz(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyz(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyz(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::hcy_to_xyy(color_space::hcy* color)
+color_space::xyy* color_manipulation::color_converter::hcy_to_xyy(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_xyy(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_xyy(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::hcy_to_cieluv(color_space::hcy* color)
+color_space::cieluv* color_manipulation::color_converter::hcy_to_cieluv(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cieluv(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cieluv(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::hcy_to_lab(color_space::hcy* color)
+color_space::lab* color_manipulation::color_converter::hcy_to_lab(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lab(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lab(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::hcy_to_lch_ab(color_space::hcy* color)
+color_space::lch_ab* color_manipulation::color_converter::hcy_to_lch_ab(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lch_ab(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lch_ab(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::hcy_to_lch_uv(color_space::hcy* color)
+color_space::lch_uv* color_manipulation::color_converter::hcy_to_lch_uv(const color_space::hcy* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_lch_uv(color_manipulation::color_converter::hcy_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_lch_uv(temporary(color_manipulation::color_converter::hcy_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::xyz_to_rgb_true(color_space::xyz* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::xyz_to_rgb_true(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_rgb_true(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_rgb_true(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::xyz_to_rgb_deep(color_space::xyz* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::xyz_to_rgb_deep(const color_space::xyz* color)
 {
 	auto rgb_components = color->get_rgb_color_space()->get_inverse_transform_matrix()* color->get_component_vector();
 	auto rgb_deep = new color_space::rgb_deepcolor(rgb_components[0], rgb_components[1], rgb_components[2], color->alpha(), color->get_rgb_color_space());
@@ -843,46 +1273,46 @@ color_space::rgb_deepcolor* color_manipulation::color_converter::xyz_to_rgb_deep
 	rgb_deep->green(clamp_float(rgb_deep->green(), 0.f, 1.f));
 	rgb_deep->blue(clamp_float(rgb_deep->blue(), 0.f, 1.f));
 
-	rgb_deep->do_gamma_correction();
+	rgb_deep->do_gamma_correction(active_policy());
 	return rgb_deep;
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::xyz_to_grey_true(color_space::xyz* color)
+color_space::grey_truecolor* color_manipulation::color_converter::xyz_to_grey_true(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_true(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_true(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::xyz_to_grey_deep(color_space::xyz* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::xyz_to_grey_deep(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_grey_deep(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_grey_deep(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::xyz_to_cmyk(color_space::xyz* color)
+color_space::cmyk* color_manipulation::color_converter::xyz_to_cmyk(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_cmyk(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_cmyk(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::xyz_to_hsi(color_space::xyz* color)
+color_space::hsi* color_manipulation::color_converter::xyz_to_hsi(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsi(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsi(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::xyz_to_hsv(color_space::xyz* color)
+color_space::hsv* color_manipulation::color_converter::xyz_to_hsv(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsv(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsv(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::xyz_to_hsl(color_space::xyz* color)
+color_space::hsl* color_manipulation::color_converter::xyz_to_hsl(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hsl(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hsl(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::xyz_to_hcy(color_space::xyz* color)
+color_space::hcy* color_manipulation::color_converter::xyz_to_hcy(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::rgb_deep_to_hcy(color_manipulation::color_converter::xyz_to_rgb_deep(color));
+	return color_manipulation::color_converter::rgb_deep_to_hcy(temporary(color_manipulation::color_converter::xyz_to_rgb_deep(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::xyz_to_xyy(color_space::xyz* color)
+color_space::xyy* color_manipulation::color_converter::xyz_to_xyy(const color_space::xyz* color)
 {
 	if (color->x() == 0 && color->y() == 0 && color->z() == 0)
 	{
@@ -896,7 +1326,7 @@ color_space::xyy* color_manipulation::color_converter::xyz_to_xyy(color_space::x
 	return new color_space::xyy(x, y, color->y(), color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::cieluv* color_manipulation::color_converter::xyz_to_cieluv(color_space::xyz* color)
+color_space::cieluv* color_manipulation::color_converter::xyz_to_cieluv(const color_space::xyz* color)
 {
 	auto y_temp = color->x() / color->get_rgb_color_space()->get_white_point()->get_tristimulus_y();
 	auto u_temp = 4.f* color->x() / (color->x() + 15.f* color->y() + 3.f* color->z());
@@ -912,14 +1342,14 @@ color_space::cieluv* color_manipulation::color_converter::xyz_to_cieluv(color_sp
 			15.f* color->get_rgb_color_space()->get_white_point()->get_tristimulus_y() +
 			3.f* color->get_rgb_color_space()->get_white_point()->get_tristimulus_z());
 
-	auto L = y_temp > 0.008856f ? 116.f* N_ROOT(y_temp, 3) - 16.f : 903.3f* y_temp;
+	auto L = y_temp > 0.008856f ? 116.f* policy_cbrt(y_temp) - 16.f : 903.3f* y_temp;
 	auto u = 13.f* L* (u_temp - u_w_temp);
 	auto v = 13.f* L* (v_temp - v_w_temp);
 
 	return new color_space::cieluv(L, u, v, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::lab* color_manipulation::color_converter::xyz_to_lab(color_space::xyz* color)
+color_space::lab* color_manipulation::color_converter::xyz_to_lab(const color_space::xyz* color)
 {
 	auto func_x = xyz_to_lab_helper(color->x() / color->get_rgb_color_space()->get_white_point()->get_tristimulus_x());
 	auto func_y = xyz_to_lab_helper(color->y() / color->get_rgb_color_space()->get_white_point()->get_tristimulus_y());
@@ -934,62 +1364,62 @@ color_space::lab* color_manipulation::color_converter::xyz_to_lab(color_space::x
 	return lab;
 }
 
-color_space::lch_ab* color_manipulation::color_converter::xyz_to_lch_ab(color_space::xyz* color)
+color_space::lch_ab* color_manipulation::color_converter::xyz_to_lch_ab(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::xyz_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::xyz_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::xyz_to_lch_uv(color_space::xyz* color)
+color_space::lch_uv* color_manipulation::color_converter::xyz_to_lch_uv(const color_space::xyz* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::xyz_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::xyz_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::xyy_to_rgb_true(color_space::xyy* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::xyy_to_rgb_true(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_rgb_true(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_rgb_true(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::xyy_to_rgb_deep(color_space::xyy* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::xyy_to_rgb_deep(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_rgb_deep(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_rgb_deep(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::xyy_to_grey_true(color_space::xyy* color)
+color_space::grey_truecolor* color_manipulation::color_converter::xyy_to_grey_true(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_grey_true(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_grey_true(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::xyy_to_grey_deep(color_space::xyy* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::xyy_to_grey_deep(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_grey_deep(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_grey_deep(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::xyy_to_cmyk(color_space::xyy* color)
+color_space::cmyk* color_manipulation::color_converter::xyy_to_cmyk(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_cmyk(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cmyk(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::xyy_to_hsi(color_space::xyy* color)
+color_space::hsi* color_manipulation::color_converter::xyy_to_hsi(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsi(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsi(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::xyy_to_hsv(color_space::xyy* color)
+color_space::hsv* color_manipulation::color_converter::xyy_to_hsv(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsv(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsv(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::xyy_to_hsl(color_space::xyy* color)
+color_space::hsl* color_manipulation::color_converter::xyy_to_hsl(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsl(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsl(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::xyy_to_hcy(color_space::xyy* color)
+color_space::hcy* color_manipulation::color_converter::xyy_to_hcy(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_hcy(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hcy(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::xyy_to_xyz(color_space::xyy* color)
+color_space::xyz* color_manipulation::color_converter::xyy_to_xyz(const color_space::xyy* color)
 {
 	if (color->y() == 0)
 	{
@@ -1002,72 +1432,72 @@ color_space::xyz* color_manipulation::color_converter::xyy_to_xyz(color_space::x
 	return new color_space::xyz(x, color->Y(), z, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::cieluv* color_manipulation::color_converter::xyy_to_cieluv(color_space::xyy* color)
+color_space::cieluv* color_manipulation::color_converter::xyy_to_cieluv(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::xyy_to_lab(color_space::xyy* color)
+color_space::lab* color_manipulation::color_converter::xyy_to_lab(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::xyz_to_lab(color_manipulation::color_converter::xyy_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_lab(temporary(color_manipulation::color_converter::xyy_to_xyz(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::xyy_to_lch_ab(color_space::xyy* color)
+color_space::lch_ab* color_manipulation::color_converter::xyy_to_lch_ab(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::xyy_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::xyy_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::xyy_to_lch_uv(color_space::xyy* color)
+color_space::lch_uv* color_manipulation::color_converter::xyy_to_lch_uv(const color_space::xyy* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::xyy_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::xyy_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::cieluv_to_rgb_true(color_space::cieluv* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::cieluv_to_rgb_true(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_rgb_true(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_rgb_true(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::cieluv_to_rgb_deep(color_space::cieluv* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::cieluv_to_rgb_deep(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_rgb_deep(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_rgb_deep(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::cieluv_to_grey_true(color_space::cieluv* color)
+color_space::grey_truecolor* color_manipulation::color_converter::cieluv_to_grey_true(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_grey_true(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_grey_true(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::cieluv_to_grey_deep(color_space::cieluv* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::cieluv_to_grey_deep(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_grey_deep(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_grey_deep(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::cieluv_to_cmyk(color_space::cieluv* color)
+color_space::cmyk* color_manipulation::color_converter::cieluv_to_cmyk(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_cmyk(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cmyk(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::cieluv_to_hsi(color_space::cieluv* color)
+color_space::hsi* color_manipulation::color_converter::cieluv_to_hsi(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsi(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsi(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::cieluv_to_hsv(color_space::cieluv* color)
+color_space::hsv* color_manipulation::color_converter::cieluv_to_hsv(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsv(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsv(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::cieluv_to_hsl(color_space::cieluv* color)
+color_space::hsl* color_manipulation::color_converter::cieluv_to_hsl(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsl(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsl(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::cieluv_to_hcy(color_space::cieluv* color)
+color_space::hcy* color_manipulation::color_converter::cieluv_to_hcy(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_hcy(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hcy(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::cieluv_to_xyz(color_space::cieluv* color)
+color_space::xyz* color_manipulation::color_converter::cieluv_to_xyz(const color_space::cieluv* color)
 {
 	auto u_temp = 4.f* color->get_rgb_color_space()->get_white_point()->get_tristimulus_x() /
 		(color->get_rgb_color_space()->get_white_point()->get_tristimulus_x() +
@@ -1079,7 +1509,7 @@ color_space::xyz* color_manipulation::color_converter::cieluv_to_xyz(color_space
 			15.f* color->get_rgb_color_space()->get_white_point()->get_tristimulus_y() +
 			3.f* color->get_rgb_color_space()->get_white_point()->get_tristimulus_z());
 
-	auto Y = color->L() > 903.3f* 0.008856f ? powf((color->L() + 16.f) / 116.f, 3.f) : color->L() / 903.3f;
+	auto Y = color->L() > 903.3f* 0.008856f ? policy_cube((color->L() + 16.f) / 116.f) : color->L() / 903.3f;
 	auto a = 1.f / 3.f* ((52.f* color->L() / (color->u() + 13.f* color->L()* u_temp)) - 1.f);
 	auto b = -5.f* Y;
 	auto c = -1.f / 3.f;
@@ -1090,26 +1520,26 @@ color_space::xyz* color_manipulation::color_converter::cieluv_to_xyz(color_space
 	return new color_space::xyz(X, Y, Z, color->alpha(), color->get_rgb_color_space());
 }
 
-color_space::xyy* color_manipulation::color_converter::cieluv_to_xyy(color_space::cieluv* color)
+color_space::xyy* color_manipulation::color_converter::cieluv_to_xyy(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::cieluv_to_lab(color_space::cieluv* color)
+color_space::lab* color_manipulation::color_converter::cieluv_to_lab(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::xyz_to_lab(color_manipulation::color_converter::cieluv_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_lab(temporary(color_manipulation::color_converter::cieluv_to_xyz(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::cieluv_to_lch_ab(color_space::cieluv* color)
+color_space::lch_ab* color_manipulation::color_converter::cieluv_to_lch_ab(const color_space::cieluv* color)
 {
-	return color_manipulation::color_converter::lab_to_lch_ab(color_manipulation::color_converter::cieluv_to_lab(color));
+	return color_manipulation::color_converter::lab_to_lch_ab(temporary(color_manipulation::color_converter::cieluv_to_lab(color)).get());
 }
 
-color_space::lch_uv* color_manipulation::color_converter::cieluv_to_lch_uv(color_space::cieluv* color)
+color_space::lch_uv* color_manipulation::color_converter::cieluv_to_lch_uv(const color_space::cieluv* color)
 {
 	auto chroma = sqrtf(powf(color->u(), 2.f) + powf(color->v(), 2.f));
 	chroma = transform_range(chroma, color->get_component_min(), color->get_component_max(), 0.f, 100.f);
-	auto hue = atan2f(color->v(), color->u());
+	auto hue = policy_atan2(color->v(), color->u());
 	if (hue < 0.f) hue += 360.f;
 
 	auto lch = new color_space::lch_uv(color->L(), chroma, hue, 0.f, color->get_rgb_color_space());
@@ -1117,52 +1547,52 @@ color_space::lch_uv* color_manipulation::color_converter::cieluv_to_lch_uv(color
 	return lch;
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::lab_to_rgb_true(color_space::lab* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::lab_to_rgb_true(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_rgb_true(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_rgb_true(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::lab_to_rgb_deep(color_space::lab* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::lab_to_rgb_deep(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_rgb_deep(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_rgb_deep(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::lab_to_grey_true(color_space::lab* color)
+color_space::grey_truecolor* color_manipulation::color_converter::lab_to_grey_true(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_grey_true(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_grey_true(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::lab_to_grey_deep(color_space::lab* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::lab_to_grey_deep(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_grey_deep(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_grey_deep(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::lab_to_cmyk(color_space::lab* color)
+color_space::cmyk* color_manipulation::color_converter::lab_to_cmyk(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_cmyk(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cmyk(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::lab_to_hsi(color_space::lab* color)
+color_space::hsi* color_manipulation::color_converter::lab_to_hsi(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsi(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsi(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::lab_to_hsv(color_space::lab* color)
+color_space::hsv* color_manipulation::color_converter::lab_to_hsv(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsv(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsv(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::lab_to_hsl(color_space::lab* color)
+color_space::hsl* color_manipulation::color_converter::lab_to_hsl(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_hsl(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hsl(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::lab_to_hcy(color_space::lab* color)
+color_space::hcy* color_manipulation::color_converter::lab_to_hcy(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_hcy(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_hcy(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::lab_to_xyz(color_space::lab* color)
+color_space::xyz* color_manipulation::color_converter::lab_to_xyz(const color_space::lab* color)
 {
 	auto f_y = (color->luminance() + 16.f) / 116.f;
 	auto y_temp = lab_to_xyz_helper(color->luminance(), true);
@@ -1174,21 +1604,21 @@ color_space::xyz* color_manipulation::color_converter::lab_to_xyz(color_space::l
 	return xyz;
 }
 
-color_space::cieluv* color_manipulation::color_converter::lab_to_cieluv(color_space::lab* color)
+color_space::cieluv* color_manipulation::color_converter::lab_to_cieluv(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_cieluv(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_cieluv(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::lab_to_xyy(color_space::lab* color)
+color_space::xyy* color_manipulation::color_converter::lab_to_xyy(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::xyz_to_xyy(color_manipulation::color_converter::lab_to_xyz(color));
+	return color_manipulation::color_converter::xyz_to_xyy(temporary(color_manipulation::color_converter::lab_to_xyz(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::lab_to_lch_ab(color_space::lab* color)
+color_space::lch_ab* color_manipulation::color_converter::lab_to_lch_ab(const color_space::lab* color)
 {
 	auto chroma = sqrtf(powf(color->a(), 2.f) + powf(color->b(), 2.f));
 	chroma = transform_range(chroma, color->get_component_min(), color->get_component_max(), 0.f, 100.f);
-	auto hue = atan2f(color->b(), color->a());
+	auto hue = policy_atan2(color->b(), color->a());
 	if (hue < 0.f) hue += 360.f;
 
 	auto lch = new color_space::lch_ab(color->luminance(), chroma, hue, 0.f, color->get_rgb_color_space());
@@ -1196,161 +1626,161 @@ color_space::lch_ab* color_manipulation::color_converter::lab_to_lch_ab(color_sp
 	return lch;
 }
 
-color_space::lch_uv* color_manipulation::color_converter::lab_to_lch_uv(color_space::lab* color)
+color_space::lch_uv* color_manipulation::color_converter::lab_to_lch_uv(const color_space::lab* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::lab_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::lab_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::lch_ab_to_rgb_true(color_space::lch_ab* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::lch_ab_to_rgb_true(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_rgb_true(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_rgb_true(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::lch_ab_to_rgb_deep(color_space::lch_ab* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::lch_ab_to_rgb_deep(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_rgb_deep(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_rgb_deep(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::lch_ab_to_grey_true(color_space::lch_ab* color)
+color_space::grey_truecolor* color_manipulation::color_converter::lch_ab_to_grey_true(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_grey_true(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_grey_true(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::lch_ab_to_grey_deep(color_space::lch_ab* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::lch_ab_to_grey_deep(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_grey_deep(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_grey_deep(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::lch_ab_to_cmyk(color_space::lch_ab* color)
+color_space::cmyk* color_manipulation::color_converter::lch_ab_to_cmyk(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_cmyk(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_cmyk(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::lch_ab_to_hsi(color_space::lch_ab* color)
+color_space::hsi* color_manipulation::color_converter::lch_ab_to_hsi(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_hsi(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_hsi(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::lch_ab_to_hsv(color_space::lch_ab* color)
+color_space::hsv* color_manipulation::color_converter::lch_ab_to_hsv(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_hsv(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_hsv(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::lch_ab_to_hsl(color_space::lch_ab* color)
+color_space::hsl* color_manipulation::color_converter::lch_ab_to_hsl(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_hsl(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_hsl(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::lch_ab_to_hcy(color_space::lch_ab* color)
+color_space::hcy* color_manipulation::color_converter::lch_ab_to_hcy(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_hcy(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_hcy(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::lch_ab_to_xyz(color_space::lch_ab* color)
+color_space::xyz* color_manipulation::color_converter::lch_ab_to_xyz(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_xyz(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_xyz(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::lch_ab_to_xyy(color_space::lch_ab* color)
+color_space::xyy* color_manipulation::color_converter::lch_ab_to_xyy(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_xyy(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_xyy(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::lch_ab_to_cieluv(color_space::lch_ab* color)
+color_space::cieluv* color_manipulation::color_converter::lch_ab_to_cieluv(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::lab_to_cieluv(color_manipulation::color_converter::lch_ab_to_lab(color));
+	return color_manipulation::color_converter::lab_to_cieluv(temporary(color_manipulation::color_converter::lch_ab_to_lab(color)).get());
 }
 
-color_space::lab* color_manipulation::color_converter::lch_ab_to_lab(color_space::lch_ab* color)
+color_space::lab* color_manipulation::color_converter::lch_ab_to_lab(const color_space::lch_ab* color)
 {
 	auto h_rad = (float)(color->hue()* M_PI / 180.f);
-	auto a = color->chroma()* cosf(h_rad);
-	auto b = color->chroma()* sinf(h_rad);
+	auto a = color->chroma()* policy_cos(h_rad);
+	auto b = color->chroma()* policy_sin(h_rad);
 
 	auto lab = new color_space::lab(color->luminance(), a, b, 0.f, color->get_rgb_color_space());
 	lab->alpha(color->alpha()); // Clamp alpha
 	return lab;
 }
 
-color_space::lch_uv* color_manipulation::color_converter::lch_ab_to_lch_uv(color_space::lch_ab* color)
+color_space::lch_uv* color_manipulation::color_converter::lch_ab_to_lch_uv(const color_space::lch_ab* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_uv(color_manipulation::color_converter::lch_ab_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_uv(temporary(color_manipulation::color_converter::lch_ab_to_cieluv(color)).get());
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::lch_uv_to_rgb_true(color_space::lch_uv* color)
+color_space::rgb_truecolor* color_manipulation::color_converter::lch_uv_to_rgb_true(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_rgb_true(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_rgb_true(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::lch_uv_to_rgb_deep(color_space::lch_uv* color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::lch_uv_to_rgb_deep(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_rgb_deep(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_rgb_deep(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::lch_uv_to_grey_true(color_space::lch_uv* color)
+color_space::grey_truecolor* color_manipulation::color_converter::lch_uv_to_grey_true(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_grey_true(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_grey_true(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::lch_uv_to_grey_deep(color_space::lch_uv* color)
+color_space::grey_deepcolor* color_manipulation::color_converter::lch_uv_to_grey_deep(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_grey_deep(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_grey_deep(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::cmyk* color_manipulation::color_converter::lch_uv_to_cmyk(color_space::lch_uv* color)
+color_space::cmyk* color_manipulation::color_converter::lch_uv_to_cmyk(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_cmyk(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_cmyk(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::hsi* color_manipulation::color_converter::lch_uv_to_hsi(color_space::lch_uv* color)
+color_space::hsi* color_manipulation::color_converter::lch_uv_to_hsi(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_hsi(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_hsi(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::hsv* color_manipulation::color_converter::lch_uv_to_hsv(color_space::lch_uv* color)
+color_space::hsv* color_manipulation::color_converter::lch_uv_to_hsv(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_hsv(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_hsv(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::hsl* color_manipulation::color_converter::lch_uv_to_hsl(color_space::lch_uv* color)
+color_space::hsl* color_manipulation::color_converter::lch_uv_to_hsl(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_hsl(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_hsl(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::hcy* color_manipulation::color_converter::lch_uv_to_hcy(color_space::lch_uv* color)
+color_space::hcy* color_manipulation::color_converter::lch_uv_to_hcy(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_hcy(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_hcy(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::xyz* color_manipulation::color_converter::lch_uv_to_xyz(color_space::lch_uv* color)
+color_space::xyz* color_manipulation::color_converter::lch_uv_to_xyz(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_xyz(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_xyz(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::xyy* color_manipulation::color_converter::lch_uv_to_xyy(color_space::lch_uv* color)
+color_space::xyy* color_manipulation::color_converter::lch_uv_to_xyy(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_xyy(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_xyy(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::cieluv* color_manipulation::color_converter::lch_uv_to_cieluv(color_space::lch_uv* color)
+color_space::cieluv* color_manipulation::color_converter::lch_uv_to_cieluv(const color_space::lch_uv* color)
 {
 	auto h_rad = (float)(color->hue()* M_PI / 180.f);
-	auto u = color->chroma()* cosf(h_rad);
-	auto v = color->chroma()* sinf(h_rad);
+	auto u = color->chroma()* policy_cos(h_rad);
+	auto v = color->chroma()* policy_sin(h_rad);
 
 	auto luv = new color_space::cieluv(color->luminance(), u, v, 0.f, color->get_rgb_color_space());
 	luv->alpha(color->alpha()); // Clamp alpha
 	return luv;
 }
 
-color_space::lab* color_manipulation::color_converter::lch_uv_to_lab(color_space::lch_uv* color)
+color_space::lab* color_manipulation::color_converter::lch_uv_to_lab(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lab(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lab(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
-color_space::lch_ab* color_manipulation::color_converter::lch_uv_to_lch_ab(color_space::lch_uv* color)
+color_space::lch_ab* color_manipulation::color_converter::lch_uv_to_lch_ab(const color_space::lch_uv* color)
 {
-	return color_manipulation::color_converter::cieluv_to_lch_ab(color_manipulation::color_converter::lch_uv_to_cieluv(color));
+	return color_manipulation::color_converter::cieluv_to_lch_ab(temporary(color_manipulation::color_converter::lch_uv_to_cieluv(color)).get());
 }
 
 float color_manipulation::color_converter::hue_from_rgb_helper(float red, float green, float blue, float max, float min, float delta)
@@ -1369,7 +1799,7 @@ float color_manipulation::color_converter::hue_from_rgb_helper(float red, float
 	}
 }
 
-float color_manipulation::color_converter::hsv_to_rgb_helper(color_space::hsv * color, float n)
+float color_manipulation::color_converter::hsv_to_rgb_helper(const color_space::hsv * color, float n)
 {
 	float k = fmodf(n + color->hue() / 60.f, 6.f);
 	return color->value() - color->value() * color->saturation() * fmaxf(fminf(k, fminf(4.f - k, 1.f)), 0.f);
@@ -1398,7 +1828,7 @@ float color_manipulation::color_converter::hsl_to_rgb_helper(float var1, float v
 	return var2;
 }
 
-float color_manipulation::color_converter::hsl_to_rgb_helper(color_space::hsl * color, float n)
+float color_manipulation::color_converter::hsl_to_rgb_helper(const color_space::hsl * color, float n)
 {
 	float k = fmodf(n + color->hue() / 30.f, 12.f);
 	float a = color->saturation() * fminf(color->lightness(), 1.f - color->lightness());
@@ -1408,7 +1838,7 @@ float color_manipulation::color_converter::hsl_to_rgb_helper(color_space::hsl *
 
 float color_manipulation::color_converter::xyz_to_lab_helper(float color_component)
 {
-	return color_component > (216.f / 24389.f) ? N_ROOT(color_component, 3.f) : ((24389.f / 27.f)* color_component + 16.f) / 116.f;
+	return color_component > (216.f / 24389.f) ? policy_cbrt(color_component) : ((24389.f / 27.f)* color_component + 16.f) / 116.f;
 }
 
 float color_manipulation::color_converter::lab_to_xyz_helper(float color_component, bool out_y_component)
@@ -1420,7 +1850,7 @@ float color_manipulation::color_converter::lab_to_xyz_helper(float color_compone
 	{
 		if (color_component > epsilon* k)
 		{
-			return std::powf(((color_component + 16.f) / 116.f), 3.f);
+			return policy_cube((color_component + 16.f) / 116.f);
 		}
 		else
 		{
@@ -1429,7 +1859,7 @@ float color_manipulation::color_converter::lab_to_xyz_helper(float color_compone
 	}
 	else
 	{
-		auto component = std::powf(color_component, 3.f);
+		auto component = policy_cube(color_component);
 		if (component > epsilon)
 		{
 			return component;
@@ -1459,588 +1889,78 @@ float color_manipulation::color_converter::transform_range(float value, float ol
 	return (((value - old_min)* new_range) / old_range) + new_min;
 }
 
-color_space::rgb_truecolor* color_manipulation::color_converter::to_rgb_true(color_space::color_base* in_color)
+color_space::rgb_truecolor* color_manipulation::color_converter::to_rgb_true(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return static_cast<color_space::rgb_truecolor*>(in_color);
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_rgb_true(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_rgb_true(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_rgb_true(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_rgb_true(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_rgb_true(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_rgb_true(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_rgb_true(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_rgb_true(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_rgb_true(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_rgb_true(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_rgb_true(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_rgb_true(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_rgb_true(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_rgb_true(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::rgb_truecolor*>(color_manipulation::color_converter::dispatch(in_color, color_type::RGB_TRUE));
 }
 
-color_space::rgb_deepcolor* color_manipulation::color_converter::to_rgb_deep(color_space::color_base* in_color)
+color_space::rgb_deepcolor* color_manipulation::color_converter::to_rgb_deep(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_rgb_deep(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return static_cast<color_space::rgb_deepcolor*>(in_color);
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_rgb_deep(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_rgb_deep(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_rgb_deep(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_rgb_deep(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_rgb_deep(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_rgb_deep(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_rgb_deep(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_rgb_deep(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_rgb_deep(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_rgb_deep(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_rgb_deep(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_rgb_deep(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_rgb_deep(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::rgb_deepcolor*>(color_manipulation::color_converter::dispatch(in_color, color_type::RGB_DEEP));
 }
 
-color_space::grey_truecolor* color_manipulation::color_converter::to_grey_true(color_space::color_base* in_color)
+color_space::grey_truecolor* color_manipulation::color_converter::to_grey_true(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_grey_true(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_grey_true(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return static_cast<color_space::grey_truecolor*>(in_color);
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_grey_true(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_grey_true(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_grey_true(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_grey_true(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_grey_true(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_grey_true(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_grey_true(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_grey_true(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_grey_true(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_grey_true(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_grey_true(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_grey_true(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::grey_truecolor*>(color_manipulation::color_converter::dispatch(in_color, color_type::GREY_TRUE));
 }
 
-color_space::grey_deepcolor* color_manipulation::color_converter::to_grey_deep(color_space::color_base* in_color)
+color_space::grey_deepcolor* color_manipulation::color_converter::to_grey_deep(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_grey_deep(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_grey_deep(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_grey_deep(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return static_cast<color_space::grey_deepcolor*>(in_color);
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_grey_deep(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_grey_deep(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_grey_deep(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_grey_deep(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_grey_deep(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_grey_deep(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_grey_deep(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_grey_deep(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_grey_deep(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_grey_deep(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_grey_deep(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::grey_deepcolor*>(color_manipulation::color_converter::dispatch(in_color, color_type::GREY_DEEP));
 }
 
-color_space::cmyk* color_manipulation::color_converter::to_cmyk(color_space::color_base* in_color)
+color_space::cmyk* color_manipulation::color_converter::to_cmyk(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_cmyk(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_cmyk(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_cmyk(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_cmyk(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return static_cast<color_space::cmyk*>(in_color);
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_cmyk(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_cmyk(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_cmyk(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_cmyk(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_cmyk(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_cmyk(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_cmyk(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_cmyk(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_cmyk(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_cmyk(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::cmyk*>(color_manipulation::color_converter::dispatch(in_color, color_type::CMYK));
 }
 
-color_space::hsi* color_manipulation::color_converter::to_hsi(color_space::color_base* in_color)
+color_space::hsi* color_manipulation::color_converter::to_hsi(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_hsi(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_hsi(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_hsi(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_hsi(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_hsi(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return static_cast<color_space::hsi*>(in_color);
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_hsi(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_hsi(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_hsi(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_hsi(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_hsi(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_hsi(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_hsi(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_hsi(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_hsi(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::hsi*>(color_manipulation::color_converter::dispatch(in_color, color_type::HSI));
 }
 
-color_space::hsv* color_manipulation::color_converter::to_hsv(color_space::color_base* in_color)
+color_space::hsv* color_manipulation::color_converter::to_hsv(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_hsv(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_hsv(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_hsv(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_hsv(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_hsv(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_hsv(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return static_cast<color_space::hsv*>(in_color);
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_hsv(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_hsv(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_hsv(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_hsv(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_hsv(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_hsv(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_hsv(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_hsv(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::hsv*>(color_manipulation::color_converter::dispatch(in_color, color_type::HSV));
 }
 
-color_space::hsl* color_manipulation::color_converter::to_hsl(color_space::color_base* in_color)
+color_space::hsl* color_manipulation::color_converter::to_hsl(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_hsl(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_hsl(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_hsl(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_hsl(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_hsl(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_hsl(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_hsl(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return static_cast<color_space::hsl*>(in_color);
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_hsl(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_hsl(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_hsl(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_hsl(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_hsl(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_hsl(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_hsl(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::hsl*>(color_manipulation::color_converter::dispatch(in_color, color_type::HSL));
 }
 
-color_space::hcy* color_manipulation::color_converter::to_hcy(color_space::color_base* in_color)
+color_space::hcy* color_manipulation::color_converter::to_hcy(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_hcy(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_hcy(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_hcy(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_hcy(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_hcy(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_hcy(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_hcy(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_hcy(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return static_cast<color_space::hcy*>(in_color);
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_hcy(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_hcy(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_hcy(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_hcy(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_hcy(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_hcy(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::hcy*>(color_manipulation::color_converter::dispatch(in_color, color_type::HCY));
 }
 
-color_space::xyz* color_manipulation::color_converter::to_xyz(color_space::color_base* in_color)
+color_space::xyz* color_manipulation::color_converter::to_xyz(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_xyz(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_xyz(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_xyz(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_xyz(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_xyz(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_xyz(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_xyz(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_xyz(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_xyz(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return static_cast<color_space::xyz*>(in_color);
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_xyz(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_xyz(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_xyz(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_xyz(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_xyz(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::xyz*>(color_manipulation::color_converter::dispatch(in_color, color_type::XYZ));
 }
 
-color_space::xyy* color_manipulation::color_converter::to_xyy(color_space::color_base* in_color)
+color_space::xyy* color_manipulation::color_converter::to_xyy(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_xyy(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_xyy(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_xyy(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_xyy(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_xyy(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_xyy(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_xyy(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_xyy(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_xyy(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_xyy(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return static_cast<color_space::xyy*>(in_color);
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_xyy(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_xyy(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_xyy(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_xyy(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::xyy*>(color_manipulation::color_converter::dispatch(in_color, color_type::XYY));
 }
 
-color_space::cieluv* color_manipulation::color_converter::to_cieluv(color_space::color_base* in_color)
+color_space::cieluv* color_manipulation::color_converter::to_cieluv(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_cieluv(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_cieluv(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_cieluv(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_cieluv(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_cieluv(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_cieluv(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_cieluv(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_cieluv(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_cieluv(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_cieluv(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_cieluv(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return static_cast<color_space::cieluv*>(in_color);
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_cieluv(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_cieluv(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_cieluv(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::cieluv*>(color_manipulation::color_converter::dispatch(in_color, color_type::CIELUV));
 }
 
-color_space::lab* color_manipulation::color_converter::to_lab(color_space::color_base* in_color)
+color_space::lab* color_manipulation::color_converter::to_lab(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_lab(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_lab(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_lab(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_lab(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_lab(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_lab(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_lab(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_lab(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_lab(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_lab(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_lab(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_lab(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return static_cast<color_space::lab*>(in_color);
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_lab(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_lab(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::lab*>(color_manipulation::color_converter::dispatch(in_color, color_type::LAB));
 }
 
-color_space::lch_ab* color_manipulation::color_converter::to_lch_ab(color_space::color_base* in_color)
+color_space::lch_ab* color_manipulation::color_converter::to_lch_ab(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_lch_ab(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_lch_ab(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_lch_ab(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_lch_ab(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_lch_ab(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_lch_ab(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_lch_ab(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_lch_ab(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_lch_ab(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_lch_ab(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_lch_ab(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_lch_ab(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_lch_ab(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return static_cast<color_space::lch_ab*>(in_color);
-	case color_type::LCH_UV:
-		return color_manipulation::color_converter::lch_uv_to_lch_ab(static_cast<color_space::lch_uv*>(in_color));
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::lch_ab*>(color_manipulation::color_converter::dispatch(in_color, color_type::LCH_AB));
 }
 
-color_space::lch_uv* color_manipulation::color_converter::to_lch_uv(color_space::color_base* in_color)
+color_space::lch_uv* color_manipulation::color_converter::to_lch_uv(const color_space::color_base* in_color)
 {
-	switch (in_color->get_color_type())
-	{
-	case color_type::RGB_TRUE:
-		return color_manipulation::color_converter::rgb_true_to_lch_uv(static_cast<color_space::rgb_truecolor*>(in_color));
-	case color_type::RGB_DEEP:
-		return color_manipulation::color_converter::rgb_deep_to_lch_uv(static_cast<color_space::rgb_deepcolor*>(in_color));
-	case color_type::GREY_TRUE:
-		return color_manipulation::color_converter::grey_true_to_lch_uv(static_cast<color_space::grey_truecolor*>(in_color));
-	case color_type::GREY_DEEP:
-		return color_manipulation::color_converter::grey_deep_to_lch_uv(static_cast<color_space::grey_deepcolor*>(in_color));
-	case color_type::CMYK:
-		return color_manipulation::color_converter::cmyk_to_lch_uv(static_cast<color_space::cmyk*>(in_color));
-	case color_type::HSI:
-		return color_manipulation::color_converter::hsi_to_lch_uv(static_cast<color_space::hsi*>(in_color));
-	case color_type::HSV:
-		return color_manipulation::color_converter::hsv_to_lch_uv(static_cast<color_space::hsv*>(in_color));
-	case color_type::HSL:
-		return color_manipulation::color_converter::hsl_to_lch_uv(static_cast<color_space::hsl*>(in_color));
-	case color_type::HCY:
-		return color_manipulation::color_converter::hcy_to_lch_uv(static_cast<color_space::hcy*>(in_color));
-	case color_type::XYZ:
-		return color_manipulation::color_converter::xyz_to_lch_uv(static_cast<color_space::xyz*>(in_color));
-	case color_type::XYY:
-		return color_manipulation::color_converter::xyy_to_lch_uv(static_cast<color_space::xyy*>(in_color));
-	case color_type::CIELUV:
-		return color_manipulation::color_converter::cieluv_to_lch_uv(static_cast<color_space::cieluv*>(in_color));
-	case color_type::LAB:
-		return color_manipulation::color_converter::lab_to_lch_uv(static_cast<color_space::lab*>(in_color));
-	case color_type::LCH_AB:
-		return color_manipulation::color_converter::lch_ab_to_lch_uv(static_cast<color_space::lch_ab*>(in_color));
-	case color_type::LCH_UV:
-		return static_cast<color_space::lch_uv*>(in_color);
-	default:
-		return nullptr;
-	}
+	return static_cast<color_space::lch_uv*>(color_manipulation::color_converter::dispatch(in_color, color_type::LCH_UV));
 }
 
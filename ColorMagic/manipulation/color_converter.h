@@ -5,37 +5,67 @@
 
 #pragma once
 
-#include "..\utils\color_type.h"
-#include "..\spaces\color_base.h"
-#include "..\spaces\cmyk.h"
-#include "..\spaces\grey_deepcolor.h"
-#include "..\spaces\grey_truecolor.h"
-#include "..\spaces\hsi.h"
-#include "..\spaces\hsv.h"
-#include "..\spaces\hsl.h"
-#include "..\spaces\hcy.h"
-#include "..\spaces\lab.h"
-#include "..\spaces\lch_ab.h"
-#include "..\spaces\lch_uv.h"
-#include "..\spaces\rgb_deepcolor.h"
-#include "..\spaces\rgb_truecolor.h"
-#include "..\spaces\xyz.h"
-#include "..\spaces\xyy.h"
-#include "..\spaces\cieluv.h"
-#include "..\spaces\rgb_color_space_definition.h"
+#include "../utils/color_type.h"
+#include "../spaces/color_base.h"
+#include "../spaces/cmyk.h"
+#include "../spaces/grey_deepcolor.h"
+#include "../spaces/grey_truecolor.h"
+#include "../spaces/hsi.h"
+#include "../spaces/hsv.h"
+#include "../spaces/hsl.h"
+#include "../spaces/hcy.h"
+#include "../spaces/lab.h"
+#include "../spaces/lch_ab.h"
+#include "../spaces/lch_uv.h"
+#include "../spaces/rgb_deepcolor.h"
+#include "../spaces/rgb_truecolor.h"
+#include "../spaces/xyz.h"
+#include "../spaces/xyy.h"
+#include "../spaces/cieluv.h"
+#include "../spaces/rgb_color_space_definition.h"
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+#include "../utils/precision.h"
 
 #include <string>
 #include <algorithm>
+#include <array>
+#include <memory>
 
 namespace color_manipulation
 {
 	//! Static class for color conversions.
 	/*!
 	* This static class implements various functions to convert from one color space to another.
+	* None of the conversion functions modify their input color. Each call returns a newly allocated color,
+	* even if the input color is already located in the desired color space. The converter itself holds no
+	* mutable state, so it is safe to convert the same (read-only) colors from several threads at once as long
+	* as their rgb color space definitions are not modified at the same time. The overloads that take a
+	* precision_policy use it only for that call, the others fall back to precision::get_default().
 	*/
 	class color_converter
 	{
 	public:
+		//! Function that converts a color of one fixed color type to another fixed color type.
+		typedef color_space::color_base* (*conversion_function)(const color_space::color_base* in_color);
+
+		//! Number of color types that can be converted (all color_type values except UNDEFINED).
+		static const size_t color_type_count = (size_t)color_type::UNDEFINED;
+
+		//! Static function that returns the converter function for a pair of color types.
+		/*!
+		* The functions are stored in a table that is created at compile time, so the lookup is a single array access.
+		* The returned function expects an input color of type in_color and returns a color of type out_color.
+		* \param in_color The color type of the input colors.
+		* \param out_color The desired color space of the output colors.
+		* \return The converter function or null if one of the types is UNDEFINED.
+		*/
+		static conversion_function get_conversion_function(color_type in_color, color_type out_color)
+		{
+			if ((size_t)in_color >= color_type_count || (size_t)out_color >= color_type_count) return nullptr;
+			return s_conversion_table[in_color][out_color];
+		}
+
 		//! Static function that converts an arbitrary color to another arbitrary color space.
 		/*!
 		* Wrapper function that calls the correct converter function depending on the input colors type.
@@ -43,7 +73,18 @@ namespace color_manipulation
 		* \param out_color The desired color space of the output color.
 		* \return The converted input color.
 		*/
-		static color_space::color_base* convertTo(color_space::color_base* in_color, color_type out_color);
+		static color_space::color_base* convertTo(const color_space::color_base* in_color, color_type out_color);
+
+		//! Static function that converts an arbitrary color to another arbitrary color space with the given precision policy.
+		/*!
+		* Like convertTo(in_color, out_color), but the conversion uses the given policy instead of precision::get_default().
+		* Other conversions, also those running at the same time on other threads, are not affected.
+		* \param in_color The color to convert.
+		* \param out_color The desired color space of the output color.
+		* \param policy The precision policy of the conversion.
+		* \return The converted input color.
+		*/
+		static color_space::color_base* convertTo(const color_space::color_base* in_color, color_type out_color, precision_policy policy);
 
 		//! Static function that converts an arbitrary color to rgb true color space.
 		/*!
@@ -51,7 +92,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* to_rgb_true(color_space::color_base* in_color);
+		static color_space::rgb_truecolor* to_rgb_true(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to rgb deep color space.
 		/*!
@@ -59,7 +100,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* to_rgb_deep(color_space::color_base* in_color);
+		static color_space::rgb_deepcolor* to_rgb_deep(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to grey true color space.
 		/*!
@@ -67,7 +108,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* to_grey_true(color_space::color_base* in_color);
+		static color_space::grey_truecolor* to_grey_true(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to grey deep color space.
 		/*!
@@ -75,7 +116,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* to_grey_deep(color_space::color_base* in_color);
+		static color_space::grey_deepcolor* to_grey_deep(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to cmyk color space.
 		/*!
@@ -83,7 +124,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* to_cmyk(color_space::color_base* in_color);
+		static color_space::cmyk* to_cmyk(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to hsi color space.
 		/*!
@@ -91,7 +132,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* to_hsi(color_space::color_base* in_color);
+		static color_space::hsi* to_hsi(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to hsv color space.
 		/*!
@@ -99,7 +140,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* to_hsv(color_space::color_base* in_color);
+		static color_space::hsv* to_hsv(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to hsl color space.
 		/*!
@@ -107,7 +148,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* to_hsl(color_space::color_base* in_color);
+		static color_space::hsl* to_hsl(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to hcy color space.
 		/*!
@@ -115,7 +156,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* to_hcy(color_space::color_base* in_color);
+		static color_space::hcy* to_hcy(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to xyz color space.
 		/*!
@@ -123,7 +164,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* to_xyz(color_space::color_base* in_color);
+		static color_space::xyz* to_xyz(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to xyY color space.
 		/*!
@@ -131,7 +172,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* to_xyy(color_space::color_base* in_color);
+		static color_space::xyy* to_xyy(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to cieluv color space.
 		/*!
@@ -139,7 +180,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* to_cieluv(color_space::color_base* in_color);
+		static color_space::cieluv* to_cieluv(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to lab color space.
 		/*!
@@ -147,7 +188,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* to_lab(color_space::color_base* in_color);
+		static color_space::lab* to_lab(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to lch(ab) color space.
 		/*!
@@ -155,7 +196,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* to_lch_ab(color_space::color_base* in_color);
+		static color_space::lch_ab* to_lch_ab(const color_space::color_base* in_color);
 
 		//! Static function that converts an arbitrary color to lch(uv) color space.
 		/*!
@@ -163,7 +204,52 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* to_lch_uv(color_space::color_base* in_color);
+		static color_space::lch_uv* to_lch_uv(const color_space::color_base* in_color);
+
+		//! Static function that converts a list of arbitrary colors to another arbitrary color space.
+		/*!
+		* Resolves the converter functions for out_color once and calls them for each input color. The conversions are distributed
+		* over the threads of the given executor.
+		* \param in_colors The colors to convert. Must not contain null pointers.
+		* \param out_color The desired color space of the output colors.
+		* \param exec The executor that runs the conversions. If null the default thread pool is used.
+		* \return The converted input colors in the same order like the input colors.
+		*/
+		static std::vector<color_space::color_base*> convertTo(const std::vector<color_space::color_base*>& in_colors, color_type out_color, executor* exec = nullptr);
+
+		//! Static function that converts a list of arbitrary colors to another arbitrary color space with the given precision policy.
+		/*!
+		* Like convertTo(in_colors, out_color, exec), but the conversions use the given policy instead of precision::get_default().
+		* \param in_colors The colors to convert. Must not contain null pointers.
+		* \param out_color The desired color space of the output colors.
+		* \param policy The precision policy of the conversions.
+		* \param exec The executor that runs the conversions. If null the default thread pool is used.
+		* \return The converted input colors in the same order like the input colors.
+		*/
+		static std::vector<color_space::color_base*> convertTo(const std::vector<color_space::color_base*>& in_colors, color_type out_color, precision_policy policy, executor* exec = nullptr);
+
+		//! Static function that converts the pixels of a view to another arbitrary color space.
+		/*!
+		* Each pixel is read as rgb true color directly from the viewed memory, so the caller does not have to create the input colors.
+		* \param in_pixels The pixels to convert.
+		* \param color_space The rgb color space definition of the pixels.
+		* \param out_color The desired color space of the output colors.
+		* \param exec The executor that runs the conversions. If null the default thread pool is used.
+		* \return The converted pixels in the order of the pixels.
+		*/
+		static std::vector<color_space::color_base*> convertTo(const pixel_view& in_pixels, color_space::rgb_color_space_definition* color_space, color_type out_color, executor* exec = nullptr);
+
+		//! Static function that converts the pixels of a view to another arbitrary color space with the given precision policy.
+		/*!
+		* Like convertTo(in_pixels, color_space, out_color, exec), but the conversions use the given policy instead of precision::get_default().
+		* \param in_pixels The pixels to convert.
+		* \param color_space The rgb color space definition of the pixels.
+		* \param out_color The desired color space of the output colors.
+		* \param policy The precision policy of the conversions.
+		* \param exec The executor that runs the conversions. If null the default thread pool is used.
+		* \return The converted pixels in the order of the pixels.
+		*/
+		static std::vector<color_space::color_base*> convertTo(const pixel_view& in_pixels, color_space::rgb_color_space_definition* color_space, color_type out_color, precision_policy policy, executor* exec = nullptr);
 
 	protected:
 
@@ -175,7 +261,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* rgb_true_to_rgb_deep(color_space::rgb_truecolor* color);
+		static color_space::rgb_deepcolor* rgb_true_to_rgb_deep(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to grey true color space.
 		/*!
@@ -183,7 +269,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* rgb_true_to_grey_true(color_space::rgb_truecolor* color);
+		static color_space::grey_truecolor* rgb_true_to_grey_true(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to grey deep color space.
 		/*!
@@ -192,7 +278,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* rgb_true_to_grey_deep(color_space::rgb_truecolor* color);
+		static color_space::grey_deepcolor* rgb_true_to_grey_deep(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to cmyk color space.
 		/*!
@@ -201,7 +287,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* rgb_true_to_cmyk(color_space::rgb_truecolor* color);
+		static color_space::cmyk* rgb_true_to_cmyk(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to hsi color space.
 		/*!
@@ -210,7 +296,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* rgb_true_to_hsi(color_space::rgb_truecolor* color);
+		static color_space::hsi* rgb_true_to_hsi(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to hsv color space.
 		/*!
@@ -219,7 +305,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* rgb_true_to_hsv(color_space::rgb_truecolor* color);
+		static color_space::hsv* rgb_true_to_hsv(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to hsl color space.
 		/*!
@@ -228,7 +314,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* rgb_true_to_hsl(color_space::rgb_truecolor* color);
+		static color_space::hsl* rgb_true_to_hsl(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to hcy color space.
 		/*!
@@ -237,7 +323,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* rgb_true_to_hcy(color_space::rgb_truecolor* color);
+		static color_space::hcy* rgb_true_to_hcy(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to xyz color space.
 		/*!
@@ -246,7 +332,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* rgb_true_to_xyz(color_space::rgb_truecolor* color);
+		static color_space::xyz* rgb_true_to_xyz(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to xyY color space.
 		/*!
@@ -255,7 +341,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* rgb_true_to_xyy(color_space::rgb_truecolor* color);
+		static color_space::xyy* rgb_true_to_xyy(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to cieluv color space.
 		/*!
@@ -264,7 +350,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* rgb_true_to_cieluv(color_space::rgb_truecolor* color);
+		static color_space::cieluv* rgb_true_to_cieluv(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to lab color space.
 		/*!
@@ -273,7 +359,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* rgb_true_to_lab(color_space::rgb_truecolor* color);
+		static color_space::lab* rgb_true_to_lab(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to lch(ab) color space.
 		/*!
@@ -282,7 +368,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* rgb_true_to_lch_ab(color_space::rgb_truecolor* color);
+		static color_space::lch_ab* rgb_true_to_lch_ab(const color_space::rgb_truecolor* color);
 
 		//! Static function that converts a rgb true color to lch(uv) color space.
 		/*!
@@ -291,7 +377,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* rgb_true_to_lch_uv(color_space::rgb_truecolor* color);
+		static color_space::lch_uv* rgb_true_to_lch_uv(const color_space::rgb_truecolor* color);
 
 #pragma endregion
 
@@ -303,7 +389,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* rgb_deep_to_rgb_true(color_space::rgb_deepcolor* color);
+		static color_space::rgb_truecolor* rgb_deep_to_rgb_true(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to grey true color space.
 		/*!
@@ -312,7 +398,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::grey_truecolor* rgb_deep_to_grey_true(color_space::rgb_deepcolor* color);
+		static color_space::grey_truecolor* rgb_deep_to_grey_true(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to rgb true color space.
 		/*!
@@ -320,7 +406,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* rgb_deep_to_grey_deep(color_space::rgb_deepcolor* color);
+		static color_space::grey_deepcolor* rgb_deep_to_grey_deep(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to cmyk color space.
 		/*!
@@ -330,7 +416,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* rgb_deep_to_cmyk(color_space::rgb_deepcolor* color);
+		static color_space::cmyk* rgb_deep_to_cmyk(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to hsi color space.
 		/*!
@@ -338,7 +424,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* rgb_deep_to_hsi(color_space::rgb_deepcolor* color);
+		static color_space::hsi* rgb_deep_to_hsi(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to hsv color space.
 		/*!
@@ -346,7 +432,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* rgb_deep_to_hsv(color_space::rgb_deepcolor* color);
+		static color_space::hsv* rgb_deep_to_hsv(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to hsl color space.
 		/*!
@@ -354,7 +440,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* rgb_deep_to_hsl(color_space::rgb_deepcolor* color);
+		static color_space::hsl* rgb_deep_to_hsl(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to hcy color space.
 		/*!
@@ -365,7 +451,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* rgb_deep_to_hcy(color_space::rgb_deepcolor* color);
+		static color_space::hcy* rgb_deep_to_hcy(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to xyz color space.
 		/*!
@@ -373,7 +459,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* rgb_deep_to_xyz(color_space::rgb_deepcolor* color);
+		static color_space::xyz* rgb_deep_to_xyz(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to xyY color space.
 		/*!
@@ -381,7 +467,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* rgb_deep_to_xyy(color_space::rgb_deepcolor* color);
+		static color_space::xyy* rgb_deep_to_xyy(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to cieluv color space.
 		/*!
@@ -389,7 +475,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* rgb_deep_to_cieluv(color_space::rgb_deepcolor* color);
+		static color_space::cieluv* rgb_deep_to_cieluv(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to lab color space.
 		/*!
@@ -398,7 +484,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* rgb_deep_to_lab(color_space::rgb_deepcolor* color);
+		static color_space::lab* rgb_deep_to_lab(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to lch(ab) color space.
 		/*!
@@ -407,7 +493,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* rgb_deep_to_lch_ab(color_space::rgb_deepcolor* color);
+		static color_space::lch_ab* rgb_deep_to_lch_ab(const color_space::rgb_deepcolor* color);
 
 		//! Static function that converts a rgb deep color to lch(uv) color space.
 		/*!
@@ -416,7 +502,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* rgb_deep_to_lch_uv(color_space::rgb_deepcolor* color);
+		static color_space::lch_uv* rgb_deep_to_lch_uv(const color_space::rgb_deepcolor* color);
 
 #pragma endregion
 
@@ -428,7 +514,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* grey_true_to_rgb_true(color_space::grey_truecolor* color);
+		static color_space::rgb_truecolor* grey_true_to_rgb_true(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to rgb deep color space.
 		/*!
@@ -437,7 +523,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* grey_true_to_rgb_deep(color_space::grey_truecolor* color);
+		static color_space::rgb_deepcolor* grey_true_to_rgb_deep(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to grey deep color space.
 		/*!
@@ -445,7 +531,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::grey_deepcolor* grey_true_to_grey_deep(color_space::grey_truecolor* color);
+		static color_space::grey_deepcolor* grey_true_to_grey_deep(const color_space::grey_truecolor* color);
 		
 		//! Static function that converts a grey true color to cmyk color space.
 		/*!
@@ -454,7 +540,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* grey_true_to_cmyk(color_space::grey_truecolor* color);
+		static color_space::cmyk* grey_true_to_cmyk(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to hsi color space.
 		/*!
@@ -463,7 +549,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* grey_true_to_hsi(color_space::grey_truecolor* color);
+		static color_space::hsi* grey_true_to_hsi(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to hsv color space.
 		/*!
@@ -472,7 +558,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* grey_true_to_hsv(color_space::grey_truecolor* color);
+		static color_space::hsv* grey_true_to_hsv(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to hsl color space.
 		/*!
@@ -481,7 +567,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsl* grey_true_to_hsl(color_space::grey_truecolor* color);
+		static color_space::hsl* grey_true_to_hsl(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to hcy color space.
 		/*!
@@ -490,7 +576,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* grey_true_to_hcy(color_space::grey_truecolor* color);
+		static color_space::hcy* grey_true_to_hcy(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to xyz color space.
 		/*!
@@ -499,7 +585,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* grey_true_to_xyz(color_space::grey_truecolor* color);
+		static color_space::xyz* grey_true_to_xyz(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to xyY color space.
 		/*!
@@ -508,7 +594,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* grey_true_to_xyy(color_space::grey_truecolor* color);
+		static color_space::xyy* grey_true_to_xyy(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to cieluv color space.
 		/*!
@@ -517,7 +603,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* grey_true_to_cieluv(color_space::grey_truecolor* color);
+		static color_space::cieluv* grey_true_to_cieluv(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to lab color space.
 		/*!
@@ -526,7 +612,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* grey_true_to_lab(color_space::grey_truecolor* color);
+		static color_space::lab* grey_true_to_lab(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to lch(ab) color space.
 		/*!
@@ -535,7 +621,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* grey_true_to_lch_ab(color_space::grey_truecolor* color);
+		static color_space::lch_ab* grey_true_to_lch_ab(const color_space::grey_truecolor* color);
 
 		//! Static function that converts a grey true color to lch(uv) color space.
 		/*!
@@ -544,7 +630,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* grey_true_to_lch_uv(color_space::grey_truecolor* color);
+		static color_space::lch_uv* grey_true_to_lch_uv(const color_space::grey_truecolor* color);
 
 #pragma endregion
 
@@ -556,7 +642,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* grey_deep_to_rgb_true(color_space::grey_deepcolor* color);
+		static color_space::rgb_truecolor* grey_deep_to_rgb_true(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to rgb deep color space.
 		/*!
@@ -564,7 +650,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* grey_deep_to_rgb_deep(color_space::grey_deepcolor* color);
+		static color_space::rgb_deepcolor* grey_deep_to_rgb_deep(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to grey true color space.
 		/*!
@@ -572,7 +658,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* grey_deep_to_grey_true(color_space::grey_deepcolor* color);
+		static color_space::grey_truecolor* grey_deep_to_grey_true(const color_space::grey_deepcolor* color);
 		
 		//! Static function that converts a grey deep color to cmyk color space.
 		/*!
@@ -581,7 +667,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* grey_deep_to_cmyk(color_space::grey_deepcolor* color);
+		static color_space::cmyk* grey_deep_to_cmyk(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to hsi color space.
 		/*!
@@ -590,7 +676,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* grey_deep_to_hsi(color_space::grey_deepcolor* color);
+		static color_space::hsi* grey_deep_to_hsi(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to hsv color space.
 		/*!
@@ -599,7 +685,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* grey_deep_to_hsv(color_space::grey_deepcolor* color);
+		static color_space::hsv* grey_deep_to_hsv(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to hsl color space.
 		/*!
@@ -608,7 +694,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* grey_deep_to_hsl(color_space::grey_deepcolor* color);
+		static color_space::hsl* grey_deep_to_hsl(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to hcy color space.
 		/*!
@@ -617,7 +703,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* grey_deep_to_hcy(color_space::grey_deepcolor* color);
+		static color_space::hcy* grey_deep_to_hcy(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to xyz color space.
 		/*!
@@ -626,7 +712,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* grey_deep_to_xyz(color_space::grey_deepcolor* color);
+		static color_space::xyz* grey_deep_to_xyz(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to xyY color space.
 		/*!
@@ -635,7 +721,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* grey_deep_to_xyy(color_space::grey_deepcolor* color);
+		static color_space::xyy* grey_deep_to_xyy(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to cieluv color space.
 		/*!
@@ -644,7 +730,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* grey_deep_to_cieluv(color_space::grey_deepcolor* color);
+		static color_space::cieluv* grey_deep_to_cieluv(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to lab color space.
 		/*!
@@ -653,7 +739,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* grey_deep_to_lab(color_space::grey_deepcolor* color);
+		static color_space::lab* grey_deep_to_lab(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to lch(ab) color space.
 		/*!
@@ -662,7 +748,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* grey_deep_to_lch_ab(color_space::grey_deepcolor* color);
+		static color_space::lch_ab* grey_deep_to_lch_ab(const color_space::grey_deepcolor* color);
 
 		//! Static function that converts a grey deep color to lch(uv) color space.
 		/*!
@@ -671,7 +757,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* grey_deep_to_lch_uv(color_space::grey_deepcolor* color);
+		static color_space::lch_uv* grey_deep_to_lch_uv(const color_space::grey_deepcolor* color);
 
 #pragma endregion
 
@@ -684,7 +770,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* cmyk_to_rgb_true(color_space::cmyk* color);
+		static color_space::rgb_truecolor* cmyk_to_rgb_true(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to rgb deep color space.
 		/*!
@@ -695,7 +781,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* cmyk_to_rgb_deep(color_space::cmyk* color);
+		static color_space::rgb_deepcolor* cmyk_to_rgb_deep(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to rgb true color space.
 		/*!
@@ -704,7 +790,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::grey_truecolor* cmyk_to_grey_true(color_space::cmyk* color);
+		static color_space::grey_truecolor* cmyk_to_grey_true(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to grey deep color space.
 		/*!
@@ -713,7 +799,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_deepcolor* cmyk_to_grey_deep(color_space::cmyk* color);
+		static color_space::grey_deepcolor* cmyk_to_grey_deep(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to hsi color space.
 		/*!
@@ -722,7 +808,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* cmyk_to_hsi(color_space::cmyk* color);
+		static color_space::hsi* cmyk_to_hsi(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to hsv color space.
 		/*!
@@ -731,7 +817,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* cmyk_to_hsv(color_space::cmyk* color);
+		static color_space::hsv* cmyk_to_hsv(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to hsl color space.
 		/*!
@@ -740,7 +826,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* cmyk_to_hsl(color_space::cmyk* color);
+		static color_space::hsl* cmyk_to_hsl(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to hcy color space.
 		/*!
@@ -749,7 +835,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* cmyk_to_hcy(color_space::cmyk* color);
+		static color_space::hcy* cmyk_to_hcy(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to xyz color space.
 		/*!
@@ -758,7 +844,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* cmyk_to_xyz(color_space::cmyk* color);
+		static color_space::xyz* cmyk_to_xyz(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to xyY color space.
 		/*!
@@ -767,7 +853,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* cmyk_to_xyy(color_space::cmyk* color);
+		static color_space::xyy* cmyk_to_xyy(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to cieluv color space.
 		/*!
@@ -776,7 +862,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* cmyk_to_cieluv(color_space::cmyk* color);
+		static color_space::cieluv* cmyk_to_cieluv(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to lab color space.
 		/*!
@@ -785,7 +871,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* cmyk_to_lab(color_space::cmyk* color);
+		static color_space::lab* cmyk_to_lab(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to lch(ab) color space.
 		/*!
@@ -794,7 +880,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* cmyk_to_lch_ab(color_space::cmyk* color);
+		static color_space::lch_ab* cmyk_to_lch_ab(const color_space::cmyk* color);
 
 		//! Static function that converts a cmyk color to lch(uv) color space.
 		/*!
@@ -803,7 +889,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* cmyk_to_lch_uv(color_space::cmyk* color);
+		static color_space::lch_uv* cmyk_to_lch_uv(const color_space::cmyk* color);
 
 #pragma endregion
 
@@ -817,7 +903,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* hsi_to_rgb_true(color_space::hsi* color);
+		static color_space::rgb_truecolor* hsi_to_rgb_true(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to rgb deep color space.
 		/*!
@@ -826,7 +912,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* hsi_to_rgb_deep(color_space::hsi* color);
+		static color_space::rgb_deepcolor* hsi_to_rgb_deep(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to grey true color space.
 		/*!
@@ -835,7 +921,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* hsi_to_grey_true(color_space::hsi* color);
+		static color_space::grey_truecolor* hsi_to_grey_true(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to grey deep color space.
 		/*!
@@ -844,7 +930,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* hsi_to_grey_deep(color_space::hsi* color);
+		static color_space::grey_deepcolor* hsi_to_grey_deep(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to cmyk color space.
 		/*!
@@ -853,7 +939,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* hsi_to_cmyk(color_space::hsi* color);
+		static color_space::cmyk* hsi_to_cmyk(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to hsv color space.
 		/*!
@@ -861,7 +947,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* hsi_to_hsv(color_space::hsi* color);
+		static color_space::hsv* hsi_to_hsv(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to hsl color space.
 		/*!
@@ -869,7 +955,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* hsi_to_hsl(color_space::hsi* color);
+		static color_space::hsl* hsi_to_hsl(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to hcy color space.
 		/*!
@@ -877,7 +963,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* hsi_to_hcy(color_space::hsi* color);
+		static color_space::hcy* hsi_to_hcy(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to xyz color space.
 		/*!
@@ -886,7 +972,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* hsi_to_xyz(color_space::hsi* color);
+		static color_space::xyz* hsi_to_xyz(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to xyY color space.
 		/*!
@@ -895,7 +981,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* hsi_to_xyy(color_space::hsi* color);
+		static color_space::xyy* hsi_to_xyy(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to cieluv color space.
 		/*!
@@ -904,7 +990,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* hsi_to_cieluv(color_space::hsi* color);
+		static color_space::cieluv* hsi_to_cieluv(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to lab color space.
 		/*!
@@ -913,7 +999,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* hsi_to_lab(color_space::hsi* color);
+		static color_space::lab* hsi_to_lab(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to lch(ab) color space.
 		/*!
@@ -922,7 +1008,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* hsi_to_lch_ab(color_space::hsi* color);
+		static color_space::lch_ab* hsi_to_lch_ab(const color_space::hsi* color);
 
 		//! Static function that converts a hsi color to lch(uv) color space.
 		/*!
@@ -931,7 +1017,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* hsi_to_lch_uv(color_space::hsi* color);
+		static color_space::lch_uv* hsi_to_lch_uv(const color_space::hsi* color);
 
 #pragma endregion
 
@@ -944,7 +1030,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* hsv_to_rgb_true(color_space::hsv* color);
+		static color_space::rgb_truecolor* hsv_to_rgb_true(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to rgb deep color space.
 		/*!
@@ -953,7 +1039,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* hsv_to_rgb_deep(color_space::hsv* color);
+		static color_space::rgb_deepcolor* hsv_to_rgb_deep(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to grey true color space.
 		/*!
@@ -962,7 +1048,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* hsv_to_grey_true(color_space::hsv* color);
+		static color_space::grey_truecolor* hsv_to_grey_true(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to grey deep color space.
 		/*!
@@ -971,7 +1057,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* hsv_to_grey_deep(color_space::hsv* color);
+		static color_space::grey_deepcolor* hsv_to_grey_deep(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to cmyk color space.
 		/*!
@@ -980,7 +1066,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* hsv_to_cmyk(color_space::hsv* color);
+		static color_space::cmyk* hsv_to_cmyk(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to hsi color space.
 		/*!
@@ -989,7 +1075,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* hsv_to_hsi(color_space::hsv* color);
+		static color_space::hsi* hsv_to_hsi(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to hsl color space.
 		/*!
@@ -998,7 +1084,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* hsv_to_hsl(color_space::hsv* color);
+		static color_space::hsl* hsv_to_hsl(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to hcy color space.
 		/*!
@@ -1007,7 +1093,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* hsv_to_hcy(color_space::hsv* color);
+		static color_space::hcy* hsv_to_hcy(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to xyz color space.
 		/*!
@@ -1016,7 +1102,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* hsv_to_xyz(color_space::hsv* color);
+		static color_space::xyz* hsv_to_xyz(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to xyY color space.
 		/*!
@@ -1025,7 +1111,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* hsv_to_xyy(color_space::hsv* color);
+		static color_space::xyy* hsv_to_xyy(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to cieluv color space.
 		/*!
@@ -1034,7 +1120,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* hsv_to_cieluv(color_space::hsv* color);
+		static color_space::cieluv* hsv_to_cieluv(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to lab color space.
 		/*!
@@ -1043,7 +1129,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* hsv_to_lab(color_space::hsv* color);
+		static color_space::lab* hsv_to_lab(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to lch(ab) color space.
 		/*!
@@ -1052,7 +1138,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* hsv_to_lch_ab(color_space::hsv* color);
+		static color_space::lch_ab* hsv_to_lch_ab(const color_space::hsv* color);
 
 		//! Static function that converts a hsv color to lch(uv) color space.
 		/*!
@@ -1061,7 +1147,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* hsv_to_lch_uv(color_space::hsv* color);
+		static color_space::lch_uv* hsv_to_lch_uv(const color_space::hsv* color);
 
 #pragma endregion
 
@@ -1074,7 +1160,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* hsl_to_rgb_true(color_space::hsl* color);
+		static color_space::rgb_truecolor* hsl_to_rgb_true(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to rgb deep color space.
 		/*!
@@ -1082,7 +1168,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_deepcolor* hsl_to_rgb_deep(color_space::hsl* color);
+		static color_space::rgb_deepcolor* hsl_to_rgb_deep(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to grey true color space.
 		/*!
@@ -1091,7 +1177,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* hsl_to_grey_true(color_space::hsl* color);
+		static color_space::grey_truecolor* hsl_to_grey_true(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to grey deep color space.
 		/*!
@@ -1100,7 +1186,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* hsl_to_grey_deep(color_space::hsl* color);
+		static color_space::grey_deepcolor* hsl_to_grey_deep(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to cmyk color space.
 		/*!
@@ -1109,7 +1195,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* hsl_to_cmyk(color_space::hsl* color);
+		static color_space::cmyk* hsl_to_cmyk(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to hsi color space.
 		/*!
@@ -1117,7 +1203,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* hsl_to_hsi(color_space::hsl* color);
+		static color_space::hsi* hsl_to_hsi(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to hsv color space.
 		/*!
@@ -1125,7 +1211,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* hsl_to_hsv(color_space::hsl* color);
+		static color_space::hsv* hsl_to_hsv(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to hcy color space.
 		/*!
@@ -1133,7 +1219,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* hsl_to_hcy(color_space::hsl* color);
+		static color_space::hcy* hsl_to_hcy(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to xyz color space.
 		/*!
@@ -1142,7 +1228,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* hsl_to_xyz(color_space::hsl* color);
+		static color_space::xyz* hsl_to_xyz(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to xyY color space.
 		/*!
@@ -1151,7 +1237,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* hsl_to_xyy(color_space::hsl* color);
+		static color_space::xyy* hsl_to_xyy(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to cieluv color space.
 		/*!
@@ -1160,7 +1246,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* hsl_to_cieluv(color_space::hsl* color);
+		static color_space::cieluv* hsl_to_cieluv(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to lab color space.
 		/*!
@@ -1169,7 +1255,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* hsl_to_lab(color_space::hsl* color);
+		static color_space::lab* hsl_to_lab(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to lch(ab) color space.
 		/*!
@@ -1178,7 +1264,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* hsl_to_lch_ab(color_space::hsl* color);
+		static color_space::lch_ab* hsl_to_lch_ab(const color_space::hsl* color);
 
 		//! Static function that converts a hsl color to lch(uv) color space.
 		/*!
@@ -1187,7 +1273,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* hsl_to_lch_uv(color_space::hsl* color);
+		static color_space::lch_uv* hsl_to_lch_uv(const color_space::hsl* color);
 
 #pragma endregion
 
@@ -1201,7 +1287,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* hcy_to_rgb_true(color_space::hcy* color);
+		static color_space::rgb_truecolor* hcy_to_rgb_true(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to rgb deep color space.
 		/*!
@@ -1212,7 +1298,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_deepcolor* hcy_to_rgb_deep(color_space::hcy* color);
+		static color_space::rgb_deepcolor* hcy_to_rgb_deep(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to grey true color space.
 		/*!
@@ -1221,7 +1307,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* hcy_to_grey_true(color_space::hcy* color);
+		static color_space::grey_truecolor* hcy_to_grey_true(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to grey deep color space.
 		/*!
@@ -1230,7 +1316,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* hcy_to_grey_deep(color_space::hcy* color);
+		static color_space::grey_deepcolor* hcy_to_grey_deep(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to cmyk color space.
 		/*!
@@ -1239,7 +1325,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* hcy_to_cmyk(color_space::hcy* color);
+		static color_space::cmyk* hcy_to_cmyk(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to hsi color space.
 		/*!
@@ -1247,7 +1333,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* hcy_to_hsi(color_space::hcy* color);
+		static color_space::hsi* hcy_to_hsi(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to hsv color space.
 		/*!
@@ -1255,7 +1341,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* hcy_to_hsv(color_space::hcy* color);
+		static color_space::hsv* hcy_to_hsv(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to hsl color space.
 		/*!
@@ -1263,7 +1349,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* hcy_to_hsl(color_space::hcy* color);
+		static color_space::hsl* hcy_to_hsl(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to xyz color space.
 		/*!
@@ -1272,7 +1358,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* hcy_to_xyz(color_space::hcy* color);
+		static color_space::xyz* hcy_to_xyz(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to xyY color space.
 		/*!
@@ -1281,7 +1367,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* hcy_to_xyy(color_space::hcy* color);
+		static color_space::xyy* hcy_to_xyy(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to cieluv color space.
 		/*!
@@ -1290,7 +1376,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* hcy_to_cieluv(color_space::hcy* color);
+		static color_space::cieluv* hcy_to_cieluv(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to lab color space.
 		/*!
@@ -1299,7 +1385,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* hcy_to_lab(color_space::hcy* color);
+		static color_space::lab* hcy_to_lab(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to lch(ab) color space.
 		/*!
@@ -1308,7 +1394,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* hcy_to_lch_ab(color_space::hcy* color);
+		static color_space::lch_ab* hcy_to_lch_ab(const color_space::hcy* color);
 
 		//! Static function that converts a hcy color to lch(uv) color space.
 		/*!
@@ -1317,7 +1403,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* hcy_to_lch_uv(color_space::hcy* color);
+		static color_space::lch_uv* hcy_to_lch_uv(const color_space::hcy* color);
 
 #pragma endregion
 
@@ -1330,7 +1416,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* xyz_to_rgb_true(color_space::xyz* color);
+		static color_space::rgb_truecolor* xyz_to_rgb_true(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to rgb deep color space.
 		/*!
@@ -1338,7 +1424,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* xyz_to_rgb_deep(color_space::xyz* color);
+		static color_space::rgb_deepcolor* xyz_to_rgb_deep(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to grey true color space.
 		/*!
@@ -1347,7 +1433,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* xyz_to_grey_true(color_space::xyz* color);
+		static color_space::grey_truecolor* xyz_to_grey_true(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to grey deep color space.
 		/*!
@@ -1356,7 +1442,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* xyz_to_grey_deep(color_space::xyz* color);
+		static color_space::grey_deepcolor* xyz_to_grey_deep(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to cmyk color space.
 		/*!
@@ -1365,7 +1451,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* xyz_to_cmyk(color_space::xyz* color);
+		static color_space::cmyk* xyz_to_cmyk(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to hsi color space.
 		/*!
@@ -1374,7 +1460,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* xyz_to_hsi(color_space::xyz* color);
+		static color_space::hsi* xyz_to_hsi(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to hsv color space.
 		/*!
@@ -1383,7 +1469,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* xyz_to_hsv(color_space::xyz* color);
+		static color_space::hsv* xyz_to_hsv(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to hsl color space.
 		/*!
@@ -1392,7 +1478,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* xyz_to_hsl(color_space::xyz* color);
+		static color_space::hsl* xyz_to_hsl(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to hcy color space.
 		/*!
@@ -1401,7 +1487,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* xyz_to_hcy(color_space::xyz* color);
+		static color_space::hcy* xyz_to_hcy(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to xyY color space.
 		/*!
@@ -1409,7 +1495,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyy* xyz_to_xyy(color_space::xyz* color);
+		static color_space::xyy* xyz_to_xyy(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to cieluv color space.
 		/*!
@@ -1417,7 +1503,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* xyz_to_cieluv(color_space::xyz* color);
+		static color_space::cieluv* xyz_to_cieluv(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to lab color space.
 		/*!
@@ -1425,7 +1511,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lab color space.
 		*/
-		static color_space::lab* xyz_to_lab(color_space::xyz* color);
+		static color_space::lab* xyz_to_lab(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to lch(ab) color space.
 		/*!
@@ -1434,7 +1520,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* xyz_to_lch_ab(color_space::xyz* color);
+		static color_space::lch_ab* xyz_to_lch_ab(const color_space::xyz* color);
 
 		//! Static function that converts a xyz color to lch(uv) color space.
 		/*!
@@ -1443,7 +1529,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* xyz_to_lch_uv(color_space::xyz* color);
+		static color_space::lch_uv* xyz_to_lch_uv(const color_space::xyz* color);
 
 #pragma endregion
 
@@ -1456,7 +1542,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* xyy_to_rgb_true(color_space::xyy* color);
+		static color_space::rgb_truecolor* xyy_to_rgb_true(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to rgb deep color space.
 		/*!
@@ -1465,7 +1551,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* xyy_to_rgb_deep(color_space::xyy* color);
+		static color_space::rgb_deepcolor* xyy_to_rgb_deep(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to grey true color space.
 		/*!
@@ -1474,7 +1560,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* xyy_to_grey_true(color_space::xyy* color);
+		static color_space::grey_truecolor* xyy_to_grey_true(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to grey deep color space.
 		/*!
@@ -1483,7 +1569,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* xyy_to_grey_deep(color_space::xyy* color);
+		static color_space::grey_deepcolor* xyy_to_grey_deep(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to cmyk color space.
 		/*!
@@ -1492,7 +1578,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* xyy_to_cmyk(color_space::xyy* color);
+		static color_space::cmyk* xyy_to_cmyk(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to hsi color space.
 		/*!
@@ -1501,7 +1587,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* xyy_to_hsi(color_space::xyy* color);
+		static color_space::hsi* xyy_to_hsi(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to hsv color space.
 		/*!
@@ -1510,7 +1596,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* xyy_to_hsv(color_space::xyy* color);
+		static color_space::hsv* xyy_to_hsv(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to hsl color space.
 		/*!
@@ -1519,7 +1605,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* xyy_to_hsl(color_space::xyy* color);
+		static color_space::hsl* xyy_to_hsl(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to hcy color space.
 		/*!
@@ -1528,7 +1614,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* xyy_to_hcy(color_space::xyy* color);
+		static color_space::hcy* xyy_to_hcy(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to xyz color space.
 		/*!
@@ -1536,7 +1622,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyz* xyy_to_xyz(color_space::xyy* color);
+		static color_space::xyz* xyy_to_xyz(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to cieluv color space.
 		/*!
@@ -1544,7 +1630,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* xyy_to_cieluv(color_space::xyy* color);
+		static color_space::cieluv* xyy_to_cieluv(const color_space::xyy* color);
 
 		//! Static function that converts a xyY color to lab color space.
 		/*!
@@ -1553,7 +1639,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::lab* xyy_to_lab(color_space::xyy* color);
+		static color_space::lab* xyy_to_lab(const color_space::xyy* color);
 
 		//! Static function that converts a xyy color to lch(ab) color space.
 		/*!
@@ -1562,7 +1648,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* xyy_to_lch_ab(color_space::xyy* color);
+		static color_space::lch_ab* xyy_to_lch_ab(const color_space::xyy* color);
 
 		//! Static function that converts a xyy color to lch(uv) color space.
 		/*!
@@ -1571,7 +1657,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* xyy_to_lch_uv(color_space::xyy* color);
+		static color_space::lch_uv* xyy_to_lch_uv(const color_space::xyy* color);
 
 #pragma endregion
 
@@ -1584,7 +1670,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* cieluv_to_rgb_true(color_space::cieluv* color);
+		static color_space::rgb_truecolor* cieluv_to_rgb_true(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to rgb deep color space.
 		/*!
@@ -1593,7 +1679,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* cieluv_to_rgb_deep(color_space::cieluv* color);
+		static color_space::rgb_deepcolor* cieluv_to_rgb_deep(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to grey true color space.
 		/*!
@@ -1602,7 +1688,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* cieluv_to_grey_true(color_space::cieluv* color);
+		static color_space::grey_truecolor* cieluv_to_grey_true(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to grey deep color space.
 		/*!
@@ -1611,7 +1697,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* cieluv_to_grey_deep(color_space::cieluv* color);
+		static color_space::grey_deepcolor* cieluv_to_grey_deep(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to cmyk color space.
 		/*!
@@ -1620,7 +1706,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* cieluv_to_cmyk(color_space::cieluv* color);
+		static color_space::cmyk* cieluv_to_cmyk(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to hsi color space.
 		/*!
@@ -1629,7 +1715,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* cieluv_to_hsi(color_space::cieluv* color);
+		static color_space::hsi* cieluv_to_hsi(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to hsv color space.
 		/*!
@@ -1638,7 +1724,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* cieluv_to_hsv(color_space::cieluv* color);
+		static color_space::hsv* cieluv_to_hsv(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to hsl color space.
 		/*!
@@ -1647,7 +1733,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* cieluv_to_hsl(color_space::cieluv* color);
+		static color_space::hsl* cieluv_to_hsl(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to hcy color space.
 		/*!
@@ -1656,7 +1742,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* cieluv_to_hcy(color_space::cieluv* color);
+		static color_space::hcy* cieluv_to_hcy(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to xyz color space.
 		/*!
@@ -1664,7 +1750,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::xyz* cieluv_to_xyz(color_space::cieluv* color);
+		static color_space::xyz* cieluv_to_xyz(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to xyy color space.
 		/*!
@@ -1673,7 +1759,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyy color space.
 		*/
-		static color_space::xyy* cieluv_to_xyy(color_space::cieluv* color);
+		static color_space::xyy* cieluv_to_xyy(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to lab color space.
 		/*!
@@ -1682,7 +1768,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::lab* cieluv_to_lab(color_space::cieluv* color);
+		static color_space::lab* cieluv_to_lab(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to lch(ab) color space.
 		/*!
@@ -1691,7 +1777,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* cieluv_to_lch_ab(color_space::cieluv* color);
+		static color_space::lch_ab* cieluv_to_lch_ab(const color_space::cieluv* color);
 
 		//! Static function that converts a cieluv color to lch(uv) color space.
 		/*!
@@ -1699,7 +1785,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* cieluv_to_lch_uv(color_space::cieluv* color);
+		static color_space::lch_uv* cieluv_to_lch_uv(const color_space::cieluv* color);
 
 #pragma endregion
 
@@ -1712,7 +1798,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* lab_to_rgb_true(color_space::lab* color);
+		static color_space::rgb_truecolor* lab_to_rgb_true(const color_space::lab* color);
 
 		//! Static function that converts a lab color to rgb deep color space.
 		/*!
@@ -1721,7 +1807,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* lab_to_rgb_deep(color_space::lab* color);
+		static color_space::rgb_deepcolor* lab_to_rgb_deep(const color_space::lab* color);
 
 		//! Static function that converts a lab color to grey true color space.
 		/*!
@@ -1730,7 +1816,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* lab_to_grey_true(color_space::lab* color);
+		static color_space::grey_truecolor* lab_to_grey_true(const color_space::lab* color);
 
 		//! Static function that converts a lab color to grey deep color space.
 		/*!
@@ -1739,7 +1825,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* lab_to_grey_deep(color_space::lab* color);
+		static color_space::grey_deepcolor* lab_to_grey_deep(const color_space::lab* color);
 
 		//! Static function that converts a lab color to cmyk color space.
 		/*!
@@ -1748,7 +1834,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* lab_to_cmyk(color_space::lab* color);
+		static color_space::cmyk* lab_to_cmyk(const color_space::lab* color);
 
 		//! Static function that converts a lab color to hsi color space.
 		/*!
@@ -1757,7 +1843,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* lab_to_hsi(color_space::lab* color);
+		static color_space::hsi* lab_to_hsi(const color_space::lab* color);
 
 		//! Static function that converts a lab color to hsv color space.
 		/*!
@@ -1766,7 +1852,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* lab_to_hsv(color_space::lab* color);
+		static color_space::hsv* lab_to_hsv(const color_space::lab* color);
 
 		//! Static function that converts a lab color to hsl color space.
 		/*!
@@ -1775,7 +1861,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* lab_to_hsl(color_space::lab* color);
+		static color_space::hsl* lab_to_hsl(const color_space::lab* color);
 
 		//! Static function that converts a lab color to hcy color space.
 		/*!
@@ -1784,7 +1870,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* lab_to_hcy(color_space::lab* color);
+		static color_space::hcy* lab_to_hcy(const color_space::lab* color);
 
 		//! Static function that converts a lab color to xyz color space.
 		/*!
@@ -1792,7 +1878,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyz* lab_to_xyz(color_space::lab* color);
+		static color_space::xyz* lab_to_xyz(const color_space::lab* color);
 
 		//! Static function that converts a lab color to cieluv color space.
 		/*!
@@ -1801,7 +1887,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* lab_to_cieluv(color_space::lab* color);
+		static color_space::cieluv* lab_to_cieluv(const color_space::lab* color);
 
 		//! Static function that converts a lab color to xyY color space.
 		/*!
@@ -1810,7 +1896,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyz color space.
 		*/
-		static color_space::xyy* lab_to_xyy(color_space::lab* color);
+		static color_space::xyy* lab_to_xyy(const color_space::lab* color);
 
 		//! Static function that converts a lab color to lch(ab) color space.
 		/*!
@@ -1818,7 +1904,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(ab) color space.
 		*/
-		static color_space::lch_ab* lab_to_lch_ab(color_space::lab* color);
+		static color_space::lch_ab* lab_to_lch_ab(const color_space::lab* color);
 
 		//! Static function that converts a lab color to lch(uv) color space.
 		/*!
@@ -1827,7 +1913,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* lab_to_lch_uv(color_space::lab* color);
+		static color_space::lch_uv* lab_to_lch_uv(const color_space::lab* color);
 
 #pragma endregion
 
@@ -1840,7 +1926,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* lch_ab_to_rgb_true(color_space::lch_ab* color);
+		static color_space::rgb_truecolor* lch_ab_to_rgb_true(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to rgb deep color space.
 		/*!
@@ -1849,7 +1935,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* lch_ab_to_rgb_deep(color_space::lch_ab* color);
+		static color_space::rgb_deepcolor* lch_ab_to_rgb_deep(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to grey true color space.
 		/*!
@@ -1858,7 +1944,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* lch_ab_to_grey_true(color_space::lch_ab* color);
+		static color_space::grey_truecolor* lch_ab_to_grey_true(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to grey deep color space.
 		/*!
@@ -1867,7 +1953,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* lch_ab_to_grey_deep(color_space::lch_ab* color);
+		static color_space::grey_deepcolor* lch_ab_to_grey_deep(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to cmyk color space.
 		/*!
@@ -1876,7 +1962,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* lch_ab_to_cmyk(color_space::lch_ab* color);
+		static color_space::cmyk* lch_ab_to_cmyk(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to hsi color space.
 		/*!
@@ -1885,7 +1971,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* lch_ab_to_hsi(color_space::lch_ab* color);
+		static color_space::hsi* lch_ab_to_hsi(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to hsv color space.
 		/*!
@@ -1894,7 +1980,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* lch_ab_to_hsv(color_space::lch_ab* color);
+		static color_space::hsv* lch_ab_to_hsv(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to hsl color space.
 		/*!
@@ -1903,7 +1989,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* lch_ab_to_hsl(color_space::lch_ab* color);
+		static color_space::hsl* lch_ab_to_hsl(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to hcy color space.
 		/*!
@@ -1912,7 +1998,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* lch_ab_to_hcy(color_space::lch_ab* color);
+		static color_space::hcy* lch_ab_to_hcy(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to xyz color space.
 		/*!
@@ -1921,7 +2007,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyz* lch_ab_to_xyz(color_space::lch_ab* color);
+		static color_space::xyz* lch_ab_to_xyz(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to xyy color space.
 		/*!
@@ -1930,7 +2016,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyy color space.
 		*/
-		static color_space::xyy* lch_ab_to_xyy(color_space::lch_ab* color);
+		static color_space::xyy* lch_ab_to_xyy(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to cieluv color space.
 		/*!
@@ -1939,7 +2025,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* lch_ab_to_cieluv(color_space::lch_ab* color);
+		static color_space::cieluv* lch_ab_to_cieluv(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to lab color space.
 		/*!
@@ -1948,7 +2034,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::lab* lch_ab_to_lab(color_space::lch_ab* color);
+		static color_space::lab* lch_ab_to_lab(const color_space::lch_ab* color);
 
 		//! Static function that converts a lch(ab) color to lch(uv) color space.
 		/*!
@@ -1957,7 +2043,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_uv* lch_ab_to_lch_uv(color_space::lch_ab* color);
+		static color_space::lch_uv* lch_ab_to_lch_uv(const color_space::lch_ab* color);
 
 #pragma endregion
 
@@ -1970,7 +2056,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb true color space.
 		*/
-		static color_space::rgb_truecolor* lch_uv_to_rgb_true(color_space::lch_uv* color);
+		static color_space::rgb_truecolor* lch_uv_to_rgb_true(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to rgb deep color space.
 		/*!
@@ -1979,7 +2065,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to rgb deep color space.
 		*/
-		static color_space::rgb_deepcolor* lch_uv_to_rgb_deep(color_space::lch_uv* color);
+		static color_space::rgb_deepcolor* lch_uv_to_rgb_deep(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to grey true color space.
 		/*!
@@ -1988,7 +2074,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey true color space.
 		*/
-		static color_space::grey_truecolor* lch_uv_to_grey_true(color_space::lch_uv* color);
+		static color_space::grey_truecolor* lch_uv_to_grey_true(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to grey deep color space.
 		/*!
@@ -1997,7 +2083,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to grey deep color space.
 		*/
-		static color_space::grey_deepcolor* lch_uv_to_grey_deep(color_space::lch_uv* color);
+		static color_space::grey_deepcolor* lch_uv_to_grey_deep(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to cmyk color space.
 		/*!
@@ -2006,7 +2092,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cmyk color space.
 		*/
-		static color_space::cmyk* lch_uv_to_cmyk(color_space::lch_uv* color);
+		static color_space::cmyk* lch_uv_to_cmyk(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to hsi color space.
 		/*!
@@ -2015,7 +2101,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsi color space.
 		*/
-		static color_space::hsi* lch_uv_to_hsi(color_space::lch_uv* color);
+		static color_space::hsi* lch_uv_to_hsi(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to hsv color space.
 		/*!
@@ -2024,7 +2110,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsv color space.
 		*/
-		static color_space::hsv* lch_uv_to_hsv(color_space::lch_uv* color);
+		static color_space::hsv* lch_uv_to_hsv(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to hsl color space.
 		/*!
@@ -2033,7 +2119,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::hsl* lch_uv_to_hsl(color_space::lch_uv* color);
+		static color_space::hsl* lch_uv_to_hsl(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to hcy color space.
 		/*!
@@ -2042,7 +2128,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hcy color space.
 		*/
-		static color_space::hcy* lch_uv_to_hcy(color_space::lch_uv* color);
+		static color_space::hcy* lch_uv_to_hcy(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to xyz color space.
 		/*!
@@ -2051,7 +2137,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyY color space.
 		*/
-		static color_space::xyz* lch_uv_to_xyz(color_space::lch_uv* color);
+		static color_space::xyz* lch_uv_to_xyz(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to xyy color space.
 		/*!
@@ -2060,7 +2146,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to xyy color space.
 		*/
-		static color_space::xyy* lch_uv_to_xyy(color_space::lch_uv* color);
+		static color_space::xyy* lch_uv_to_xyy(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to cieluv color space.
 		/*!
@@ -2068,7 +2154,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to cieluv color space.
 		*/
-		static color_space::cieluv* lch_uv_to_cieluv(color_space::lch_uv* color);
+		static color_space::cieluv* lch_uv_to_cieluv(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to lab color space.
 		/*!
@@ -2077,7 +2163,7 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to hsl color space.
 		*/
-		static color_space::lab* lch_uv_to_lab(color_space::lch_uv* color);
+		static color_space::lab* lch_uv_to_lab(const color_space::lch_uv* color);
 
 		//! Static function that converts a lch(uv) color to lch(ab) color space.
 		/*!
@@ -2086,11 +2172,34 @@ namespace color_manipulation
 		* \param in_color The color to convert.
 		* \return The input color converted to lch(uv) color space.
 		*/
-		static color_space::lch_ab* lch_uv_to_lch_ab(color_space::lch_uv* color);
+		static color_space::lch_ab* lch_uv_to_lch_ab(const color_space::lch_uv* color);
 
 #pragma endregion
 
 	private:
+		//! Converter functions for all pairs of color types, indexed by [input type][output type].
+		static const conversion_function s_conversion_table[color_type_count][color_type_count];
+
+		//! Table entry that casts the input color to its class and calls the typed converter function.
+		template <typename From, typename To, To* (*Function)(const From*)>
+		static color_space::color_base* kernel(const color_space::color_base* in_color) { return Function(static_cast<const From*>(in_color)); }
+
+		//! Table entry for conversions to the same color type. Returns a copy of the input color.
+		template <typename T>
+		static color_space::color_base* copy(const color_space::color_base* in_color) { return new T(*static_cast<const T*>(in_color)); }
+
+		//! Looks up the converter function for the type of the given color and calls it. Returns null for unsupported types.
+		static color_space::color_base* dispatch(const color_space::color_base* in_color, color_type out_color);
+
+		//! Takes ownership of an intermediate color of a chained conversion.
+		/*!
+		* Wrap the inner call of a chained conversion with this function to delete the intermediate
+		* color as soon as the outer conversion is done.
+		* \param color The intermediate color.
+		* \return A pointer that deletes the intermediate color when it goes out of scope.
+		*/
+		template <typename T> static std::unique_ptr<T> temporary(T* color) { return std::unique_ptr<T>(color); }
+
 		//! Static function that calculates hue for hsi, hsv, hsl and hcy color spaces.
 		/*!
 		* \param red The value of the rgb deep red component.
@@ -2111,7 +2220,7 @@ namespace color_manipulation
 		* \param n Input factor for conversion (R: n=0, G: n=8, B: n=4).
 		* \return The value of one of the resulting colors components.
 		*/
-		static float hsv_to_rgb_helper(color_space::hsv* color, float n);
+		static float hsv_to_rgb_helper(const color_space::hsv* color, float n);
 
 		//! Static function that helps to convert from hsl to rgb
 		/*!
@@ -2132,7 +2241,7 @@ namespace color_manipulation
 		* \param n Input factor for conversion (R: n=0, G: n=8, B: n=4).
 		* \return The value of one of the resulting colors components.
 		*/
-		static float hsl_to_rgb_helper(color_space::hsl* color, float n);
+		static float hsl_to_rgb_helper(const color_space::hsl* color, float n);
 
 		//! Static function that helps to convert from xyz to lab
 		/*!
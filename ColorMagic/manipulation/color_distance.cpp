@@ -1,6 +1,10 @@
 #include "stdafx.h"
 #include "color_distance.h"
 #include "color_converter.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <memory>
 
 float color_manipulation::color_distance::euclidean_distance_squared(color_space::color_base * color1, color_space::color_base * color2, color_type calculation_space)
 {
@@ -9,10 +13,8 @@ float color_manipulation::color_distance::euclidean_distance_squared(color_space
 	float squared_distance = 0.f;
 	if (calculation_space == color_type::CIELUV)
 	{
-		auto color1_cieluv = color_manipulation::color_converter::to_cieluv(color1);
-		auto color2_cieluv = color_manipulation::color_converter::to_cieluv(color2);
-
-		if (color1_cieluv == color2_cieluv) return 0.f; // after conversion to same color space both colors are equal
+		const std::unique_ptr<color_space::cieluv> color1_cieluv(color_manipulation::color_converter::to_cieluv(color1));
+		const std::unique_ptr<color_space::cieluv> color2_cieluv(color_manipulation::color_converter::to_cieluv(color2));
 
 		for (std::vector<float>::size_type i = 0; i < color1_cieluv->get_component_vector().size(); ++i)
 		{
@@ -21,10 +23,8 @@ float color_manipulation::color_distance::euclidean_distance_squared(color_space
 	}
 	else
 	{
-		auto color1_rgb_d = color_manipulation::color_converter::to_rgb_deep(color1);
-		auto color2_rgb_d = color_manipulation::color_converter::to_rgb_deep(color2);
-
-		if (color1_rgb_d == color2_rgb_d) return 0.f; // after conversion to same color space both colors are equal
+		const std::unique_ptr<color_space::rgb_deepcolor> color1_rgb_d(color_manipulation::color_converter::to_rgb_deep(color1));
+		const std::unique_ptr<color_space::rgb_deepcolor> color2_rgb_d(color_manipulation::color_converter::to_rgb_deep(color2));
 
 		for (std::vector<float>::size_type i = 0; i < color1_rgb_d->get_component_vector().size(); ++i)
 		{
@@ -46,10 +46,8 @@ float color_manipulation::color_distance::euclidean_distance_weighted(color_spac
 {
 	if (color1 == color2) return 0.f; // both colors have same type and are equal
 
-	auto color1_rgb_d = color_manipulation::color_converter::to_rgb_deep(color1);
-	auto color2_rgb_d = color_manipulation::color_converter::to_rgb_deep(color2);
-
-	if (color1_rgb_d == color2_rgb_d) return 0.f; // after conversion to same color space both colors are equal
+	const std::unique_ptr<color_space::rgb_deepcolor> color1_rgb_d(color_manipulation::color_converter::to_rgb_deep(color1));
+	const std::unique_ptr<color_space::rgb_deepcolor> color2_rgb_d(color_manipulation::color_converter::to_rgb_deep(color2));
 
 	// Equation source: https://www.compuphase.com/cmetric.htm
 	auto avg_r = ((color1_rgb_d->red() + color2_rgb_d->red()) / 2.f) * 255.f;
@@ -65,10 +63,8 @@ float color_manipulation::color_distance::cielab_delta_e_cie76(color_space::colo
 	// Equation source: https://en.wikipedia.org/wiki/Color_difference
 	if (color1 == color2) return 0.f; // both colors have same type and are equal
 
-	auto color1_lab = color_manipulation::color_converter::to_lab(color1);
-	auto color2_lab = color_manipulation::color_converter::to_lab(color2);
-
-	if (color1_lab == color2_lab) return 0.f; // after conversion to same color space both colors are equal
+	const std::unique_ptr<color_space::lab> color1_lab(color_manipulation::color_converter::to_lab(color1));
+	const std::unique_ptr<color_space::lab> color2_lab(color_manipulation::color_converter::to_lab(color2));
 
 	float squared_distance = 0.f;
 	for (std::vector<float>::size_type i = 0; i < color1_lab->get_component_vector().size(); ++i)
@@ -84,10 +80,8 @@ float color_manipulation::color_distance::cielab_delta_e_cie94(color_space::colo
 	// Equation source: https://en.wikipedia.org/wiki/Color_difference
 	if (color1 == color2) return 0.f; // both colors have same type and are equal
 
-	auto color1_lab = color_manipulation::color_converter::to_lab(color1);
-	auto color2_lab = color_manipulation::color_converter::to_lab(color2);
-
-	if (color1_lab == color2_lab) return 0.f; // after conversion to same color space both colors are equal
+	const std::unique_ptr<color_space::lab> color1_lab(color_manipulation::color_converter::to_lab(color1));
+	const std::unique_ptr<color_space::lab> color2_lab(color_manipulation::color_converter::to_lab(color2));
 
 	auto delta_l = color1_lab->luminance() - color2_lab->luminance();
 	auto c1 = sqrtf(powf(color1_lab->a(), 2.f) + powf(color1_lab->b(), 2.f));
@@ -102,97 +96,131 @@ float color_manipulation::color_distance::cielab_delta_e_cie94(color_space::colo
 
 float color_manipulation::color_distance::cielab_delta_e_cie00(color_space::color_base * color1, color_space::color_base * color2, float kL, float k1, float k2, float kC, float kH)
 {
-	// Equation source: https://en.wikipedia.org/wiki/Color_difference
+	return cielab_delta_e_cie00(color1, color2, precision::get_default(), kL, k1, k2, kC, kH);
+}
+
+float color_manipulation::color_distance::cielab_delta_e_cie00(color_space::color_base * color1, color_space::color_base * color2, precision_policy policy, float kL, float k1, float k2, float kC, float kH)
+{
+	return precision::dispatch(policy, [&](auto p) { return cielab_delta_e_cie00<decltype(p)::value>(color1, color2, kL, k1, k2, kC, kH); });
+}
+
+template <precision_policy Policy> float color_manipulation::color_distance::cielab_delta_e_cie00(color_space::color_base * color1, color_space::color_base * color2, float kL, float k1, float k2, float kC, float kH)
+{
 	if (color1 == color2) return 0.f; // both colors have same type and are equal
 
-	auto color1_lab = color_manipulation::color_converter::to_lab(color1);
-	auto color2_lab = color_manipulation::color_converter::to_lab(color2);
+	const std::unique_ptr<color_space::lab> color1_lab(static_cast<color_space::lab*>(color_manipulation::color_converter::convertTo(color1, color_type::LAB, Policy)));
+	const std::unique_ptr<color_space::lab> color2_lab(static_cast<color_space::lab*>(color_manipulation::color_converter::convertTo(color2, color_type::LAB, Policy)));
 
-	if (color1_lab == color2_lab) return 0.f; // after conversion to same color space both colors are equal
+	const float lab1[3] = { color1_lab->luminance(), color1_lab->a(), color1_lab->b() };
+	const float lab2[3] = { color2_lab->luminance(), color2_lab->a(), color2_lab->b() };
+	return delta_e_cie00<float, Policy>(lab1, lab2, kL, k1, k2, kC, kH);
+}
 
-	auto avg_l = (color1_lab->luminance() + color2_lab->luminance()) / 2.f;
-	auto C1 = sqrtf(powf(color1_lab->a(), 2.f) + powf(color1_lab->b(), 2.f));
-	auto C2 = sqrtf(powf(color2_lab->a(), 2.f) + powf(color2_lab->b(), 2.f));
-	auto avg_c = (C1 + C2) / 2.f;
-	auto sqrt_c_pow = sqrtf(powf(avg_c, 7.f) / (powf(avg_c, 7.f) + powf(25.f, 7.f)));
-
-	auto temp_a1 = color1_lab->a() + color1_lab->a() / 2.f * (1.f - sqrt_c_pow);
-	auto temp_a2 = color2_lab->a() + color2_lab->a() / 2.f * (1.f - sqrt_c_pow);
-	auto temp_c1 = sqrtf(powf(temp_a1, 2.f) + powf(color1_lab->b(), 2.f));
-	auto temp_c2 = sqrtf(powf(temp_a2, 2.f) + powf(color2_lab->b(), 2.f));
-	auto temp_avg_c = (temp_c1 + temp_c2) / 2.f;
-
-	auto h1 = (int)(to_deg(atan2f(color1_lab->b(), temp_a1))) % 360;
-	if (h1 < 0.f) h1 += 360;
-	auto h2 = (int)(to_deg(atan2f(color2_lab->b(), temp_a2))) % 360;
-	if (h2 < 0.f) h2 += 360;
-
-	float H;
-	if (abs(h1 - h2) > 180.f)
-	{
-		H = (h1 + h2 + 360.f) / 2.f;
-	}
-	else
-	{
-		H = (h1 + h2) / 2.f;
-	}
+double color_manipulation::color_distance::cielab_delta_e_cie00(const double lab1[3], const double lab2[3], double kL, double k1, double k2, double kC, double kH)
+{
+	return delta_e_cie00<double, EXACT>(lab1, lab2, kL, k1, k2, kC, kH);
+}
+
+template <typename Scalar, precision_policy Policy> Scalar color_manipulation::color_distance::delta_e_cie00(const Scalar lab1[3], const Scalar lab2[3], Scalar kL, Scalar k1, Scalar k2, Scalar kC, Scalar kH)
+{
+	typedef precision_math<Policy> math;
 
-	int delta_h;
-	if (abs(h2 - h1) <= 180.f)
+	// Equation source: https://en.wikipedia.org/wiki/Color_difference
+	const Scalar zero = 0, one = 1, two = 2, seven = 7, pow_25_7 = std::pow(Scalar(25), seven);
+
+	auto avg_l = (lab1[0] + lab2[0]) / two;
+	auto C1 = std::sqrt(std::pow(lab1[1], two) + std::pow(lab1[2], two));
+	auto C2 = std::sqrt(std::pow(lab2[1], two) + std::pow(lab2[2], two));
+	auto avg_c = (C1 + C2) / two;
+	auto sqrt_c_pow = std::sqrt(math::pow(avg_c, seven) / (math::pow(avg_c, seven) + pow_25_7));
+
+	auto temp_a1 = lab1[1] + lab1[1] / two * (one - sqrt_c_pow);
+	auto temp_a2 = lab2[1] + lab2[1] / two * (one - sqrt_c_pow);
+	auto temp_c1 = std::sqrt(std::pow(temp_a1, two) + std::pow(lab1[2], two));
+	auto temp_c2 = std::sqrt(std::pow(temp_a2, two) + std::pow(lab2[2], two));
+	auto temp_avg_c = (temp_c1 + temp_c2) / two;
+
+	// Hue angles in [0, 360), achromatic colors have a hue of 0 (Sharma, Wu and Dalal 2005)
+	Scalar h1 = temp_a1 == zero && lab1[2] == zero ? zero : to_deg(math::atan2(lab1[2], temp_a1));
+	if (h1 < zero) h1 += Scalar(360);
+	Scalar h2 = temp_a2 == zero && lab2[2] == zero ? zero : to_deg(math::atan2(lab2[2], temp_a2));
+	if (h2 < zero) h2 += Scalar(360);
+
+	// If one of the colors is achromatic, its hue is meaningless: the hue difference is 0 and the mean is the sum
+	Scalar H = h1 + h2;
+	Scalar delta_h = zero;
+	if (temp_c1 * temp_c2 != zero)
 	{
+		if (std::fabs(h1 - h2) <= Scalar(180))
+		{
+			H = (h1 + h2) / two;
+		}
+		else
+		{
+			H = h1 + h2 < Scalar(360) ? (h1 + h2 + Scalar(360)) / two : (h1 + h2 - Scalar(360)) / two;
+		}
+
 		delta_h = h2 - h1;
-	}
-	else if (abs(h2 - h1) > 180.f && h2 <= h1)
-	{
-		delta_h = h2 - h1 + 360;
-	}
-	else
-	{
-		delta_h = h2 - h1 - 360;
+		if (delta_h > Scalar(180)) delta_h -= Scalar(360);
+		else if (delta_h < Scalar(-180)) delta_h += Scalar(360);
 	}
 
-	auto delta_L = color2_lab->luminance() - color1_lab->luminance();
-	auto delta_C = C2 - C1;
-	auto delta_H = 2.f * sqrtf(C1 * C2) * sinf(to_rad(delta_h / 2.f));
+	auto delta_L = lab2[0] - lab1[0];
+	auto delta_C = temp_c2 - temp_c1;
+	auto delta_H = two * std::sqrt(temp_c1 * temp_c2) * math::sin(to_rad(delta_h / two));
 
-	auto sC = 1.f + k1 * avg_c;
-	auto sH = 1.f + k2 * avg_c * (1.f - 0.17f * cosf(to_rad(H - 30.f)) + 0.24f * cosf(to_rad(2.f * H)) + 0.32f * cosf(to_rad(3.f * H + 6.f)) - 0.2f * cosf(to_rad(4.f * H - 63.f)));
-	auto sL = 1.f + ((k2 * powf(avg_l - 50.f, 2.f)) / sqrtf(20.f + powf(avg_l - 50.f, 2.f)));
-	auto rt = -2.f * sqrt_c_pow * sinf(to_rad(60.f * expf(powf(-(H - 275.f) / 25.f, 2.f))));
+	auto sC = one + k1 * temp_avg_c;
+	auto sH = one + k2 * temp_avg_c * (one - Scalar(0.17) * math::cos(to_rad(H - Scalar(30))) + Scalar(0.24) * math::cos(to_rad(two * H)) + Scalar(0.32) * math::cos(to_rad(Scalar(3) * H + Scalar(6))) - Scalar(0.2) * math::cos(to_rad(Scalar(4) * H - Scalar(63))));
+	auto sL = one + ((k2 * std::pow(avg_l - Scalar(50), two)) / std::sqrt(Scalar(20) + std::pow(avg_l - Scalar(50), two)));
+	auto rc = two * std::sqrt(math::pow(temp_avg_c, seven) / (math::pow(temp_avg_c, seven) + pow_25_7));
+	auto rt = -rc * math::sin(to_rad(Scalar(60) * math::exp(-std::pow((H - Scalar(275)) / Scalar(25), two))));
 
-	return sqrtf(powf(delta_L / (kL * sL), 2.f) + powf(delta_C / (kC * sC), 2.f) + powf(delta_H / (kH * sH), 2.f) + rt * (delta_C / (kC * sC)) * (delta_H / (kH * sH)));
+	// The rotation term may push the sum of nearly equal colors a little below 0
+	auto sum = std::pow(delta_L / (kL * sL), two) + std::pow(delta_C / (kC * sC), two) + std::pow(delta_H / (kH * sH), two) + rt * (delta_C / (kC * sC)) * (delta_H / (kH * sH));
+	return std::sqrt(std::max(zero, sum));
 }
 
 float color_manipulation::color_distance::cmc_delta_e_lc84(color_space::color_base * color1, color_space::color_base * color2, float lightness, float chroma)
 {
+	return cmc_delta_e_lc84(color1, color2, precision::get_default(), lightness, chroma);
+}
+
+float color_manipulation::color_distance::cmc_delta_e_lc84(color_space::color_base * color1, color_space::color_base * color2, precision_policy policy, float lightness, float chroma)
+{
+	return precision::dispatch(policy, [&](auto p) { return cmc_delta_e_lc84<decltype(p)::value>(color1, color2, lightness, chroma); });
+}
+
+template <precision_policy Policy> float color_manipulation::color_distance::cmc_delta_e_lc84(color_space::color_base * color1, color_space::color_base * color2, float lightness, float chroma)
+{
+	typedef precision_math<Policy> math;
+
 	// Equation source: https://en.wikipedia.org/wiki/Color_difference
 	if (color1 == color2) return 0.f; // both colors have same type and are equal
 
-	auto color1_lab = color_manipulation::color_converter::to_lab(color1);
-	auto color2_lab = color_manipulation::color_converter::to_lab(color2);
-
-	if (color1_lab == color2_lab) return 0.f; // after conversion to same color space both colors are equal
+	const std::unique_ptr<color_space::lab> color1_lab(static_cast<color_space::lab*>(color_manipulation::color_converter::convertTo(color1, color_type::LAB, Policy)));
+	const std::unique_ptr<color_space::lab> color2_lab(static_cast<color_space::lab*>(color_manipulation::color_converter::convertTo(color2, color_type::LAB, Policy)));
 
 	auto C1 = sqrtf(powf(color1_lab->a(), 2.f) + powf(color1_lab->b(), 2.f));
 	auto C2 = sqrtf(powf(color2_lab->a(), 2.f) + powf(color2_lab->b(), 2.f));
 	auto delta_C = C1 - C2;
 	auto delta_a = color1_lab->a() - color2_lab->a();
 	auto delta_b = color1_lab->b() - color2_lab->b();
-	auto delta_H = sqrtf(powf(delta_a, 2.f) + powf(delta_b, 2.f) - powf(delta_C, 2.f));
+	// Rounding may make the squared hue difference of colors with nearly equal hue a little negative
+	auto delta_H = sqrtf(std::max(0.f, powf(delta_a, 2.f) + powf(delta_b, 2.f) - powf(delta_C, 2.f)));
 	auto delta_L = color1_lab->luminance() - color2_lab->luminance();
 
-	auto H = to_deg(atan2(color1_lab->b(), color1_lab->a()));
+	auto H = to_deg(math::atan2(color1_lab->b(), color1_lab->a()));
 	if (H < 0) H += 360.f;
 
 	auto F = sqrtf(powf(C1, 4.f) / (powf(C1, 4.f) + 1900.f));
 	float T;
 	if (H > 164.f && H <= 345.f)
 	{
-		T = 0.56f + abs(0.2f * cosf(to_rad(H + 168.f)));
+		T = 0.56f + abs(0.2f * math::cos(to_rad(H + 168.f)));
 	}
 	else
 	{
-		T = 0.36f + abs(0.4f * cosf(to_rad(H + 35.f)));
+		T = 0.36f + abs(0.4f * math::cos(to_rad(H + 35.f)));
 	}
 
 	float sL;
@@ -211,6 +239,13 @@ float color_manipulation::color_distance::cmc_delta_e_lc84(color_space::color_ba
 	return sqrtf(powf(delta_L / (lightness * sL), 2.f) + powf(delta_C / (chroma * sC), 2.f) + powf(delta_H / sH, 2.f));
 }
 
+template float color_manipulation::color_distance::cielab_delta_e_cie00<EXACT>(color_space::color_base*, color_space::color_base*, float, float, float, float, float);
+template float color_manipulation::color_distance::cielab_delta_e_cie00<FAST>(color_space::color_base*, color_space::color_base*, float, float, float, float, float);
+template float color_manipulation::color_distance::cielab_delta_e_cie00<FASTEST>(color_space::color_base*, color_space::color_base*, float, float, float, float, float);
+template float color_manipulation::color_distance::cmc_delta_e_lc84<EXACT>(color_space::color_base*, color_space::color_base*, float, float);
+template float color_manipulation::color_distance::cmc_delta_e_lc84<FAST>(color_space::color_base*, color_space::color_base*, float, float);
+template float color_manipulation::color_distance::cmc_delta_e_lc84<FASTEST>(color_space::color_base*, color_space::color_base*, float, float);
+
 float color_manipulation::color_distance::to_rad(float degree)
 {
 	return degree * ((float)M_PI / 180.f);
@@ -220,3 +255,91 @@ float color_manipulation::color_distance::to_deg(float radians)
 {
 	return radians * (180.f / (float)M_PI);
 }
+
+double color_manipulation::color_distance::to_rad(double degree)
+{
+	return degree * (M_PI / 180.);
+}
+
+double color_manipulation::color_distance::to_deg(double radians)
+{
+	return radians * (180. / M_PI);
+}
+
+std::vector<float> color_manipulation::color_distance::batch_distance(const std::vector<color_space::color_base*>& colors1, const std::vector<color_space::color_base*>& colors2, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec)
+{
+	if (colors1.size() != colors2.size()) throw new std::invalid_argument("Both color lists must have the same size.");
+	if (!distance_function) throw new std::invalid_argument("distance function is null.");
+
+	std::vector<float> distances(colors1.size(), 0.f);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, colors1.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			distances[i] = distance_function(colors1[i], colors2[i]);
+		}
+	});
+	return distances;
+}
+
+std::vector<float> color_manipulation::color_distance::batch_distance(const std::vector<color_space::color_base*>& colors, color_space::color_base* reference, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec)
+{
+	if (reference == nullptr) throw new std::invalid_argument("reference color is null.");
+	if (!distance_function) throw new std::invalid_argument("distance function is null.");
+
+	std::vector<float> distances(colors.size(), 0.f);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, colors.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			distances[i] = distance_function(colors[i], reference);
+		}
+	});
+	return distances;
+}
+
+std::vector<float> color_manipulation::color_distance::batch_distance(const pixel_view& pixels1, const pixel_view& pixels2, color_space::rgb_color_space_definition* color_space, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec)
+{
+	if (pixels1.size() != pixels2.size()) throw new std::invalid_argument("pixel views must have the same size.");
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+	if (!distance_function) throw new std::invalid_argument("distance function is null.");
+
+	std::vector<float> distances(pixels1.size(), 0.f);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, pixels1.size(), [&](size_t begin, size_t end)
+	{
+		float record[4];
+		for (size_t i = begin; i < end; ++i)
+		{
+			pixels1.unpack(i, 1, record);
+			color_space::rgb_truecolor color1(record[0], record[1], record[2], record[3], color_space);
+			pixels2.unpack(i, 1, record);
+			color_space::rgb_truecolor color2(record[0], record[1], record[2], record[3], color_space);
+			distances[i] = distance_function(&color1, &color2);
+		}
+	});
+	return distances;
+}
+
+std::vector<float> color_manipulation::color_distance::batch_distance(const pixel_view& pixels, color_space::rgb_color_space_definition* color_space, color_space::color_base* reference, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec)
+{
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+	if (reference == nullptr) throw new std::invalid_argument("reference color is null.");
+	if (!distance_function) throw new std::invalid_argument("distance function is null.");
+
+	std::vector<float> distances(pixels.size(), 0.f);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, pixels.size(), [&](size_t begin, size_t end)
+	{
+		float record[4];
+		for (size_t i = begin; i < end; ++i)
+		{
+			pixels.unpack(i, 1, record);
+			color_space::rgb_truecolor color(record[0], record[1], record[2], record[3], color_space);
+			distances[i] = distance_function(&color, reference);
+		}
+	});
+	return distances;
+}
@@ -5,9 +5,15 @@
 
 #pragma once
 
-#include "..\utils\color_type.h"
-#include "..\spaces\color_base.h"
-#include "..\manipulation\color_converter.h"
+#include "../utils/color_type.h"
+#include "../spaces/color_base.h"
+#include "../manipulation/color_converter.h"
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+#include "../utils/precision.h"
+
+#include <functional>
+#include <vector>
 
 
 namespace color_manipulation
@@ -89,6 +95,7 @@ namespace color_manipulation
 		//! Static function that calculates the distance of the two given colors by using CIELABS delta E formula from 2000.
 		/*!
 		* The calculation is done in LAB color space and is the most complex distance formula. This way it is also the most accurate and slowest one.
+		* The formula follows the CIEDE2000 implementation notes of Sharma, Wu and Dalal and reproduces their test data.
 		* \sa cielab_delta_e_cie76(), cielab_delta_e_cie94(), cmc_delta_e_lc84()
 		* \param color1 the first of the two colors to compare. Color space does not matter since it will be converted to LAB before doing
 		* any calculation.
@@ -103,6 +110,28 @@ namespace color_manipulation
 		*/
 		static float cielab_delta_e_cie00(color_space::color_base* color1, color_space::color_base* color2, float kL = 1.f, float k1 = 0.045f, float k2 = 0.015f, float kC = 1.f, float kH = 1.f);
 
+		//! Same like cielab_delta_e_cie00() but uses the given precision policy instead of precision::get_default().
+		/*!
+		* The policy is used for the conversion of the colors to lab and for the math of the formula.
+		*/
+		static float cielab_delta_e_cie00(color_space::color_base* color1, color_space::color_base* color2, precision_policy policy, float kL = 1.f, float k1 = 0.045f, float k2 = 0.015f, float kC = 1.f, float kH = 1.f);
+
+		//! Same like cielab_delta_e_cie00() but uses the precision policy Policy instead of precision::get_default().
+		/*!
+		* The policy is used for the conversion of the colors to lab and for the math of the formula. Instantiated for EXACT, FAST and FASTEST.
+		*/
+		template <precision_policy Policy> static float cielab_delta_e_cie00(color_space::color_base* color1, color_space::color_base* color2, float kL = 1.f, float k1 = 0.045f, float k2 = 0.015f, float kC = 1.f, float kH = 1.f);
+
+		//! Same like cielab_delta_e_cie00() but calculates the distance of two lab values in double precision.
+		/*!
+		* For reference calculations and archival color science, where the lab values come from a double precision source, e.g.
+		* conversion_plan::apply() with double records. The formula itself runs in double with the EXACT math functions.
+		* \param lab1 luminance, a and b of the first color.
+		* \param lab2 luminance, a and b of the second color.
+		* \return The calculated delta E value.
+		*/
+		static double cielab_delta_e_cie00(const double lab1[3], const double lab2[3], double kL = 1., double k1 = 0.045, double k2 = 0.015, double kC = 1., double kH = 1.);
+
 		//! Static function that calculates the distance of the two given colors by using CMCs delta E formula from 1984.
 		/*!
 		* The calculation is done in LAB color space and has similar complexity to the CIELAB delte E formula from 2000. This way it is also rather slow.
@@ -117,6 +146,70 @@ namespace color_manipulation
 		*/
 		static float cmc_delta_e_lc84(color_space::color_base* color1, color_space::color_base* color2, float lightness = 2.f, float chroma = 1.f);
 
+		//! Same like cmc_delta_e_lc84() but uses the given precision policy instead of precision::get_default().
+		/*!
+		* The policy is used for the conversion of the colors to lab and for the math of the formula.
+		*/
+		static float cmc_delta_e_lc84(color_space::color_base* color1, color_space::color_base* color2, precision_policy policy, float lightness = 2.f, float chroma = 1.f);
+
+		//! Same like cmc_delta_e_lc84() but uses the precision policy Policy instead of precision::get_default().
+		/*!
+		* The policy is used for the conversion of the colors to lab and for the math of the formula. Instantiated for EXACT, FAST and FASTEST.
+		*/
+		template <precision_policy Policy> static float cmc_delta_e_lc84(color_space::color_base* color1, color_space::color_base* color2, float lightness = 2.f, float chroma = 1.f);
+
+		//! Static function that calculates the distances between the colors of two lists pairwise.
+		/*!
+		* The distance function is called for each pair colors1[i], colors2[i]. The calculations are distributed over the threads
+		* of the given executor.
+		* \param colors1 The first colors of the pairs.
+		* \param colors2 The second colors of the pairs. Must have the same size like colors1.
+		* \param distance_function The function that calculates the distance of a single pair, e.g. cielab_delta_e_cie00().
+		* \param exec The executor that runs the calculations. If null the default thread pool is used.
+		* \return The calculated distances in the order of the input pairs.
+		*/
+		static std::vector<float> batch_distance(const std::vector<color_space::color_base*>& colors1, const std::vector<color_space::color_base*>& colors2, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec = nullptr);
+
+		//! Static function that calculates the distances of a list of colors to a single reference color.
+		/*!
+		* The distance function is called for each pair colors[i], reference. The calculations are distributed over the threads
+		* of the given executor.
+		* \param colors The colors to compare with the reference color.
+		* \param reference The color all other colors are compared to.
+		* \param distance_function The function that calculates the distance of a single pair, e.g. cielab_delta_e_cie00().
+		* \param exec The executor that runs the calculations. If null the default thread pool is used.
+		* \return The calculated distances in the order of the input colors.
+		*/
+		static std::vector<float> batch_distance(const std::vector<color_space::color_base*>& colors, color_space::color_base* reference, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec = nullptr);
+
+		//! Static function that calculates the distances between the pixels of two views pairwise.
+		/*!
+		* Like batch_distance(colors1, colors2, distance_function, exec), but each pixel is read as rgb true color directly from
+		* the viewed memory, so the caller does not have to create the input colors.
+		* \param pixels1 The first pixels of the pairs.
+		* \param pixels2 The second pixels of the pairs. Must have the same size like pixels1.
+		* \param color_space The rgb color space definition of the pixels.
+		* \param distance_function The function that calculates the distance of a single pair, e.g. cielab_delta_e_cie00().
+		* \param exec The executor that runs the calculations. If null the default thread pool is used.
+		* 
+eturn The calculated distances in the order of the pixels.
+		*/
+		static std::vector<float> batch_distance(const pixel_view& pixels1, const pixel_view& pixels2, color_space::rgb_color_space_definition* color_space, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec = nullptr);
+
+		//! Static function that calculates the distances of the pixels of a view to a single reference color.
+		/*!
+		* Like batch_distance(colors, reference, distance_function, exec), but each pixel is read as rgb true color directly from
+		* the viewed memory.
+		* \param pixels The pixels to compare with the reference color.
+		* \param color_space The rgb color space definition of the pixels.
+		* \param reference The color all pixels are compared to.
+		* \param distance_function The function that calculates the distance of a single pair, e.g. cielab_delta_e_cie00().
+		* \param exec The executor that runs the calculations. If null the default thread pool is used.
+		* 
+eturn The calculated distances in the order of the pixels.
+		*/
+		static std::vector<float> batch_distance(const pixel_view& pixels, color_space::rgb_color_space_definition* color_space, color_space::color_base* reference, std::function<float(color_space::color_base*, color_space::color_base*)> distance_function, executor* exec = nullptr);
+
 	protected:
 		//! Static function that converts from degree to radians.
 		/*!
@@ -133,5 +226,18 @@ namespace color_manipulation
 		* \return The result of the conversion in degree.
 		*/
 		static float to_deg(float radians);
+
+		//! Double precision version of to_rad().
+		static double to_rad(double degree);
+
+		//! Double precision version of to_deg().
+		static double to_deg(double radians);
+
+		//! Static function that calculates the CIEDE2000 formula on the lab values of two colors.
+		/*!
+		* Shared by the float and the double version of cielab_delta_e_cie00(). Instantiated for float with every precision policy
+		* and for double with EXACT.
+		*/
+		template <typename Scalar, precision_policy Policy> static Scalar delta_e_cie00(const Scalar lab1[3], const Scalar lab2[3], Scalar kL, Scalar k1, Scalar k2, Scalar kC, Scalar kH);
 	};
 }
@@ -0,0 +1,337 @@
+#include "stdafx.h"
+#include "color_histogram.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+const uint32_t color_manipulation::unique_color_table::empty_key;
+
+// Splits count colors into one part per thread (but not into parts smaller than a few cache sized blocks and not into
+// more than max_parts parts), counts each part into its own copy of empty with count_range(table, begin, end) and
+// merges the parts in order
+template <typename Table, typename Function> static Table count_in_parts(size_t count, Table empty, size_t max_parts, executor* exec, Function count_range)
+{
+	const size_t min_part_size = 65536;
+	size_t part_count = 1;
+	executor* runner = nullptr;
+	if (count >= 2 * min_part_size && max_parts > 1)
+	{
+		runner = exec != nullptr ? exec : &thread_pool::get_default();
+		part_count = std::max<size_t>(1, std::min({ runner->get_thread_count(), count / min_part_size, max_parts }));
+	}
+
+	// The last part takes over empty, so a single part does not copy it
+	std::vector<Table> parts(part_count - 1, empty);
+	parts.push_back(std::move(empty));
+	auto count_parts = [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i) count_range(parts[i], i * count / part_count, (i + 1) * count / part_count);
+	};
+	if (part_count > 1) runner->parallel_for(0, part_count, count_parts, 1);
+	else count_parts(0, 1);
+
+	for (size_t i = 1; i < part_count; ++i) parts[0].merge(parts[i]);
+	return std::move(parts[0]);
+}
+
+// Returns how many parts a histogram may be counted in. Every part is a full grid (64 MiB for 256 bins), so the parts
+// together may not use more than 32 MiB. Larger grids are counted in a single part on the calling thread.
+static size_t max_histogram_parts(size_t bins)
+{
+	const size_t budget = 32 * 1024 * 1024;
+	return std::max<size_t>(1, budget / (bins * bins * bins * sizeof(uint32_t)));
+}
+
+// Calls function(red, green, blue) for the pixels [first, first + count) without unpacking them to floats
+template <typename Function> static void for_each_rgb(const pixel_view& pixels, size_t first, size_t count, Function function)
+{
+	pixels.for_each_row(first, count, [&](size_t x, size_t y, size_t length, size_t)
+	{
+		if (pixels.layout() == PLANAR)
+		{
+			size_t offset = y * pixels.stride() + x;
+			const uint8_t* red = pixels.plane(0) + offset;
+			const uint8_t* green = pixels.plane(1) + offset;
+			const uint8_t* blue = pixels.plane(2) + offset;
+			for (size_t i = 0; i < length; ++i) function(red[i], green[i], blue[i]);
+			return;
+		}
+
+		const uint8_t* pixel = pixels.plane(0) + y * pixels.stride() + x * pixels.bytes_per_pixel();
+		switch (pixels.layout())
+		{
+		case ARGB32:
+			for (size_t i = 0; i < length; ++i)
+			{
+				uint32_t word;
+				std::memcpy(&word, pixel + i * 4, sizeof(word));
+				function((uint8_t)(word >> 16), (uint8_t)(word >> 8), (uint8_t)word);
+			}
+			break;
+		case BGRA32:
+			for (size_t i = 0; i < length; ++i) function(pixel[i * 4 + 2], pixel[i * 4 + 1], pixel[i * 4]);
+			break;
+		case RGB24:
+			for (size_t i = 0; i < length; ++i) function(pixel[i * 3], pixel[i * 3 + 1], pixel[i * 3 + 2]);
+			break;
+		default:
+			for (size_t i = 0; i < length; ++i) function(pixel[i * 4], pixel[i * 4 + 1], pixel[i * 4 + 2]);
+			break;
+		}
+	});
+}
+
+color_manipulation::color_histogram::color_histogram(color_type type, size_t bins)
+	: m_type(type), m_bins(bins), m_total(0)
+{
+	if (!is_supported(type)) throw new std::invalid_argument("Unsupported color type.");
+	if (bins < 1 || bins > 256) throw new std::invalid_argument("The number of bins has to be in the range [1,256].");
+
+	std::array<float, 3> widths;
+	switch (type)
+	{
+	case color_type::RGB_TRUE:
+		m_low = { 0.f, 0.f, 0.f };
+		widths = { 256.f, 256.f, 256.f };
+		break;
+	case color_type::RGB_DEEP:
+		m_low = { 0.f, 0.f, 0.f };
+		widths = { 1.f, 1.f, 1.f };
+		break;
+	default:
+		m_low = { 0.f, -128.f, -128.f };
+		widths = { 100.f, 256.f, 256.f };
+		break;
+	}
+	for (size_t c = 0; c < 3; ++c) m_scale[c] = bins / widths[c];
+	m_counts.assign(bins * bins * bins, 0);
+}
+
+color_manipulation::color_histogram color_manipulation::color_histogram::compute(const pixel_view& pixels, size_t bins, executor* exec)
+{
+	// The bin of a byte is (value * bins) / 256, the tables hold the offsets of the bins of each axis in the grid
+	std::array<uint32_t, 256> red_offsets, green_offsets, blue_offsets;
+	for (uint32_t value = 0; value < 256; ++value)
+	{
+		uint32_t bin = (uint32_t)(value * bins / 256);
+		red_offsets[value] = bin * (uint32_t)(bins * bins);
+		green_offsets[value] = bin * (uint32_t)bins;
+		blue_offsets[value] = bin;
+	}
+
+	return count_in_parts(pixels.size(), color_histogram(color_type::RGB_TRUE, bins), max_histogram_parts(bins), exec, [&](color_histogram& histogram, size_t begin, size_t end)
+	{
+		uint32_t* counts = histogram.m_counts.data();
+		for_each_rgb(pixels, begin, end - begin, [&](uint8_t red, uint8_t green, uint8_t blue) { ++counts[red_offsets[red] + green_offsets[green] + blue_offsets[blue]]; });
+		histogram.m_total += end - begin;
+	});
+}
+
+color_manipulation::color_histogram color_manipulation::color_histogram::compute(const pixel_view& pixels, const conversion_plan& plan, size_t bins, executor* exec)
+{
+	color_type in_type = plan.get_input_type();
+	if (in_type != color_type::RGB_TRUE && in_type != color_type::RGB_DEEP) throw new std::invalid_argument("The plan has to convert from rgb colors.");
+
+	float in_max = in_type == color_type::RGB_TRUE ? 255.f : 1.f;
+	return count_in_parts(pixels.size(), color_histogram(plan.get_output_type(), bins), max_histogram_parts(bins), exec, [&](color_histogram& histogram, size_t begin, size_t end)
+	{
+		// Unpack and convert in blocks that stay in the cache
+		const size_t block_size = 256;
+		float block[block_size * 4];
+		sequential_executor sequential;
+		for (size_t first = begin; first < end; first += block_size)
+		{
+			size_t count = std::min(block_size, end - first);
+			pixels.unpack(first, count, block, in_max);
+			plan.apply(block, block, count, &sequential);
+			histogram.add(block, count);
+		}
+	});
+}
+
+color_manipulation::color_histogram color_manipulation::color_histogram::compute(const float* records, size_t count, color_type type, size_t bins, executor* exec)
+{
+	if (records == nullptr && count > 0) throw new std::invalid_argument("records is null.");
+
+	return count_in_parts(count, color_histogram(type, bins), max_histogram_parts(bins), exec, [&](color_histogram& histogram, size_t begin, size_t end)
+	{
+		histogram.add(records + begin * 4, end - begin);
+	});
+}
+
+void color_manipulation::color_histogram::add(const float* records, size_t count)
+{
+	if (records == nullptr && count > 0) throw new std::invalid_argument("records is null.");
+
+	for (size_t i = 0; i < count; ++i) ++m_counts[cell_index(records + i * 4)];
+	m_total += count;
+}
+
+void color_manipulation::color_histogram::merge(const color_histogram& other)
+{
+	if (other.m_type != m_type || other.m_bins != m_bins) throw new std::invalid_argument("Only histograms of the same color type and number of bins can be merged.");
+
+	for (size_t i = 0; i < m_counts.size(); ++i) m_counts[i] += other.m_counts[i];
+	m_total += other.m_total;
+}
+
+size_t color_manipulation::color_histogram::occupied() const
+{
+	return (size_t)std::count_if(m_counts.begin(), m_counts.end(), [](uint32_t count) { return count > 0; });
+}
+
+uint32_t color_manipulation::color_histogram::count(size_t bin1, size_t bin2, size_t bin3) const
+{
+	if (bin1 >= m_bins || bin2 >= m_bins || bin3 >= m_bins) throw new std::out_of_range("Bin index out of range.");
+	return m_counts[(bin1 * m_bins + bin2) * m_bins + bin3];
+}
+
+size_t color_manipulation::color_histogram::cell_index(const float* record) const
+{
+	size_t index = 0;
+	for (size_t c = 0; c < 3; ++c)
+	{
+		// Values below the axis and NaN go to the first bin, values above it to the last one
+		float position = (record[c] - m_low[c]) * m_scale[c];
+		size_t bin = !(position > 0.f) ? 0 : position >= (float)m_bins ? m_bins - 1 : (size_t)position;
+		index = index * m_bins + bin;
+	}
+	return index;
+}
+
+void color_manipulation::color_histogram::cell_center(size_t index, float* components) const
+{
+	if (index >= m_counts.size()) throw new std::out_of_range("Cell index out of range.");
+
+	size_t bins[3] = { index / (m_bins * m_bins), index / m_bins % m_bins, index % m_bins };
+	for (size_t c = 0; c < 3; ++c) components[c] = m_low[c] + (bins[c] + 0.5f) / m_scale[c];
+}
+
+std::vector<color_manipulation::histogram_entry> color_manipulation::color_histogram::top(size_t n) const
+{
+	std::vector<size_t> cells;
+	for (size_t i = 0; i < m_counts.size(); ++i)
+	{
+		if (m_counts[i] > 0) cells.push_back(i);
+	}
+
+	size_t result_count = std::min(n, cells.size());
+	std::partial_sort(cells.begin(), cells.begin() + result_count, cells.end(), [this](size_t a, size_t b) { return m_counts[a] != m_counts[b] ? m_counts[a] > m_counts[b] : a < b; });
+
+	std::vector<histogram_entry> result(result_count);
+	for (size_t i = 0; i < result_count; ++i)
+	{
+		cell_center(cells[i], result[i].components.data());
+		result[i].count = m_counts[cells[i]];
+	}
+	return result;
+}
+
+bool color_manipulation::color_histogram::is_supported(color_type type)
+{
+	return type == color_type::RGB_TRUE || type == color_type::RGB_DEEP || type == color_type::LAB;
+}
+
+color_manipulation::unique_color_table::unique_color_table()
+	: m_keys(1024, empty_key), m_counts(1024, 0), m_size(0), m_total(0), m_last_slot(0)
+{
+}
+
+color_manipulation::unique_color_table color_manipulation::unique_color_table::compute(const pixel_view& pixels, executor* exec)
+{
+	return count_in_parts(pixels.size(), unique_color_table(), std::numeric_limits<size_t>::max(), exec, [&](unique_color_table& table, size_t begin, size_t end)
+	{
+		for_each_rgb(pixels, begin, end - begin, [&](uint8_t red, uint8_t green, uint8_t blue) { table.add(((uint32_t)red << 16) | ((uint32_t)green << 8) | blue); });
+	});
+}
+
+void color_manipulation::unique_color_table::add(uint32_t rgb, uint32_t count)
+{
+	uint32_t key = rgb & 0xFFFFFF;
+	m_total += count;
+
+	// Neighboring pixels often have the same color
+	if (m_keys[m_last_slot] == key)
+	{
+		m_counts[m_last_slot] += count;
+		return;
+	}
+
+	size_t slot = find_slot(key);
+	if (m_keys[slot] == empty_key)
+	{
+		if ((m_size + 1) * 2 > m_keys.size())
+		{
+			grow();
+			slot = find_slot(key);
+		}
+		m_keys[slot] = key;
+		++m_size;
+	}
+	m_counts[slot] += count;
+	m_last_slot = slot;
+}
+
+void color_manipulation::unique_color_table::merge(const unique_color_table& other)
+{
+	other.for_each([this](uint32_t key, uint32_t count) { add(key, count); });
+}
+
+uint32_t color_manipulation::unique_color_table::count(uint32_t rgb) const
+{
+	size_t slot = find_slot(rgb & 0xFFFFFF);
+	return m_keys[slot] == empty_key ? 0 : m_counts[slot];
+}
+
+std::vector<color_manipulation::histogram_entry> color_manipulation::unique_color_table::top(size_t n) const
+{
+	std::vector<std::pair<uint32_t, uint32_t>> colors;
+	colors.reserve(m_size);
+	for_each([&](uint32_t key, uint32_t count) { colors.push_back(std::make_pair(count, key)); });
+
+	size_t result_count = std::min(n, colors.size());
+	std::partial_sort(colors.begin(), colors.begin() + result_count, colors.end(), [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b)
+	{
+		return a.first != b.first ? a.first > b.first : a.second < b.second;
+	});
+
+	std::vector<histogram_entry> result(result_count);
+	for (size_t i = 0; i < result_count; ++i)
+	{
+		uint32_t key = colors[i].second;
+		result[i].components = { (float)(key >> 16), (float)((key >> 8) & 0xFF), (float)(key & 0xFF) };
+		result[i].count = colors[i].first;
+	}
+	return result;
+}
+
+size_t color_manipulation::unique_color_table::find_slot(uint32_t key) const
+{
+	// Fibonacci hashing spreads neighboring colors over the table, the number of slots is a power of two
+	size_t mask = m_keys.size() - 1;
+	uint32_t hash = key * 2654435761u;
+	size_t slot = (hash ^ (hash >> 15)) & mask;
+	while (m_keys[slot] != key && m_keys[slot] != empty_key) slot = (slot + 1) & mask;
+	return slot;
+}
+
+void color_manipulation::unique_color_table::grow()
+{
+	std::vector<uint32_t> keys(m_keys.size() * 2, empty_key);
+	std::vector<uint32_t> counts(m_counts.size() * 2, 0);
+	keys.swap(m_keys);
+	counts.swap(m_counts);
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (keys[i] == empty_key) continue;
+
+		size_t slot = find_slot(keys[i]);
+		m_keys[slot] = keys[i];
+		m_counts[slot] = counts[i];
+	}
+	m_last_slot = 0;
+}
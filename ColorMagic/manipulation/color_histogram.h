@@ -0,0 +1,231 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+#include "conversion_plan.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! A color and the number of times it occurs.
+	struct histogram_entry
+	{
+		std::array<float, 3> components; /*!< The three components of the color, e.g. the center of a bin */
+		uint64_t count; /*!< The number of colors */
+	};
+
+	//! 3D histogram of colors with the same number of bins per axis.
+	/*!
+	* Each of the three components of a color is divided into equally sized bins and the colors are counted per cell
+	* of the resulting bins x bins x bins grid. Cell (i, j, k) has the index (i * bins + j) * bins + k. Components
+	* outside the range of an axis are counted in its first or last bin.
+	*
+	* Supported color types and their axes are RGB_TRUE ([0, 256) per component), RGB_DEEP ([0, 1]) and LAB
+	* (L [0, 100], a and b [-128, 128)). Alpha is ignored. 8 bit rgb pixels are binned directly with lookup tables
+	* indexed by the bytes. Other color types are reached with a conversion_plan while the pixels are read.
+	*
+	* Large images are split into one part per thread of the executor. Each part is counted into its own histogram
+	* and the histograms are added up at the end, so no counter is shared between threads. The parts of a histogram
+	* use at most 32 MiB together, so larger grids are split into fewer parts and grids with more than 161 bins per axis
+	* are counted on the calling thread.
+	*/
+	class color_histogram
+	{
+	public:
+		//! Default constructor.
+		/*!
+		* Creates an empty histogram.
+		* \param type The color type of the colors.
+		* \param bins The number of bins per axis within [1, 256], usually 32 or 64.
+		*/
+		explicit color_histogram(color_type type = color_type::RGB_TRUE, size_t bins = 32);
+
+		//! Static function that counts 8 bit rgb pixels.
+		/*!
+		* \param pixels The pixels.
+		* \param bins The number of bins per axis.
+		* \param exec The executor that counts the parts of the image. If null the default thread pool is used.
+		* \return The RGB_TRUE histogram.
+		*/
+		static color_histogram compute(const pixel_view& pixels, size_t bins = 32, executor* exec = nullptr);
+
+		//! Static function that converts 8 bit rgb pixels and counts the converted colors.
+		/*!
+		* \param pixels The pixels.
+		* \param plan The conversion from RGB_TRUE or RGB_DEEP to the color type of the histogram, e.g. LAB.
+		* \param bins The number of bins per axis.
+		* \param exec The executor that counts the parts of the image. If null the default thread pool is used.
+		* \return The histogram in the output type of the plan.
+		*/
+		static color_histogram compute(const pixel_view& pixels, const conversion_plan& plan, size_t bins = 32, executor* exec = nullptr);
+
+		//! Static function that counts color records.
+		/*!
+		* \param records The records (see stream_converter).
+		* \param count The number of records.
+		* \param type The color type of the records.
+		* \param bins The number of bins per axis.
+		* \param exec The executor that counts the parts of the buffer. If null the default thread pool is used.
+		* \return The histogram.
+		*/
+		static color_histogram compute(const float* records, size_t count, color_type type, size_t bins = 32, executor* exec = nullptr);
+
+		//! Counts consecutive records on the calling thread.
+		void add(const float* records, size_t count);
+
+		//! Adds the counts of another histogram. Throws if the color types or the numbers of bins differ.
+		void merge(const color_histogram& other);
+
+		//! Returns the color type of the colors.
+		color_type get_color_type() const { return m_type; }
+
+		//! Returns the number of bins per axis.
+		size_t get_bins() const { return m_bins; }
+
+		//! Returns the number of counted colors.
+		uint64_t total() const { return m_total; }
+
+		//! Returns the number of cells that contain at least one color.
+		size_t occupied() const;
+
+		//! Returns the counts of all cells.
+		const std::vector<uint32_t>& get_counts() const { return m_counts; }
+
+		//! Returns the count of a cell. Throws if a bin does not exist.
+		uint32_t count(size_t bin1, size_t bin2, size_t bin3) const;
+
+		//! Returns the index of the cell a color record is counted in.
+		size_t cell_index(const float* record) const;
+
+		//! Writes the components of the center of a cell.
+		void cell_center(size_t index, float* components) const;
+
+		//! Returns the most frequent cells.
+		/*!
+		* \param n The maximum number of cells.
+		* \return The centers and counts of the n fullest non-empty cells, sorted by descending count. Cells with the
+		* same count are sorted by index.
+		*/
+		std::vector<histogram_entry> top(size_t n) const;
+
+		//! Returns whether a histogram can count colors of the given color type.
+		static bool is_supported(color_type type);
+
+	protected:
+		//! The color type of the colors.
+		color_type m_type;
+
+		//! The number of bins per axis.
+		size_t m_bins;
+
+		//! The number of counted colors.
+		uint64_t m_total;
+
+		//! The lower end of each axis.
+		std::array<float, 3> m_low;
+
+		//! The number of bins per unit of each axis.
+		std::array<float, 3> m_scale;
+
+		//! The count of each cell.
+		std::vector<uint32_t> m_counts;
+	};
+
+	//! Exact counts of the distinct colors of 8 bit rgb pixels.
+	/*!
+	* Colors are keyed by their 24 bit value 0xRRGGBB (the hex code without alpha), alpha is ignored. The keys and
+	* counts are stored in an open addressing hash table with linear probing that grows before it is half full. A
+	* table only needs memory for the colors that occur, 8 bytes per slot. Runs of the same color, like flat areas
+	* of an image, are counted without a lookup.
+	*
+	* Like color_histogram, large images are counted in one table per thread and the tables are merged at the end.
+	*/
+	class unique_color_table
+	{
+	public:
+		//! Default constructor. Creates an empty table.
+		unique_color_table();
+
+		//! Static function that counts the distinct colors of 8 bit rgb pixels.
+		/*!
+		* \param pixels The pixels.
+		* \param exec The executor that counts the parts of the image. If null the default thread pool is used.
+		* \return The table.
+		*/
+		static unique_color_table compute(const pixel_view& pixels, executor* exec = nullptr);
+
+		//! Counts a color.
+		/*!
+		* \param rgb The color as 0xRRGGBB. Higher bits are ignored.
+		* \param count The number of times the color occurs.
+		*/
+		void add(uint32_t rgb, uint32_t count = 1);
+
+		//! Adds the counts of another table.
+		void merge(const unique_color_table& other);
+
+		//! Returns the number of distinct colors.
+		size_t size() const { return m_size; }
+
+		//! Returns the number of counted colors.
+		uint64_t total() const { return m_total; }
+
+		//! Returns how often a color occurs.
+		/*!
+		* \param rgb The color as 0xRRGGBB. Higher bits are ignored.
+		* \return The count or 0 if the color does not occur.
+		*/
+		uint32_t count(uint32_t rgb) const;
+
+		//! Returns the most frequent colors.
+		/*!
+		* \param n The maximum number of colors.
+		* \return The red, green and blue values [0, 255] and counts of the n most frequent colors, sorted by
+		* descending count. Colors with the same count are sorted by their value 0xRRGGBB.
+		*/
+		std::vector<histogram_entry> top(size_t n) const;
+
+		//! Calls the function with the value 0xRRGGBB and the count of each distinct color in no particular order.
+		template <typename Function> void for_each(Function function) const
+		{
+			for (size_t i = 0; i < m_keys.size(); ++i)
+			{
+				if (m_keys[i] != empty_key) function(m_keys[i], m_counts[i]);
+			}
+		}
+
+	protected:
+		//! Key of an unused slot. Colors only use the lower 24 bits.
+		static const uint32_t empty_key = 0xFFFFFFFF;
+
+		//! Returns the slot of a key or the unused slot where it would be inserted.
+		size_t find_slot(uint32_t key) const;
+
+		//! Doubles the number of slots and inserts all keys again.
+		void grow();
+
+		//! The key of each slot.
+		std::vector<uint32_t> m_keys;
+
+		//! The count of each slot.
+		std::vector<uint32_t> m_counts;
+
+		//! The number of used slots.
+		size_t m_size;
+
+		//! The number of counted colors.
+		uint64_t m_total;
+
+		//! The slot of the color that was added last.
+		size_t m_last_slot;
+	};
+}
@@ -0,0 +1,242 @@
+#include "stdafx.h"
+#include "color_statistics.h"
+#include "stream_converter.h"
+#include "../utils/simd_math.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Smallest and largest value of each channel of consecutive records
+template <size_t Channels> static void find_range(const float* records, size_t count, float* minimum, float* maximum)
+{
+	for (size_t c = 0; c < Channels; ++c) minimum[c] = maximum[c] = records[c];
+	for (size_t i = 1; i < count; ++i)
+	{
+		const float* record = records + i * Channels;
+		for (size_t c = 0; c < Channels; ++c)
+		{
+			minimum[c] = std::min(minimum[c], record[c]);
+			maximum[c] = std::max(maximum[c], record[c]);
+		}
+	}
+}
+
+// Records of four floats fill exactly one vector, so all channels are compared at once
+template <> void find_range<4>(const float* records, size_t count, float* minimum, float* maximum)
+{
+	float4 low = float4::load(records), high = low;
+	for (size_t i = 1; i < count; ++i)
+	{
+		float4 record = float4::load(records + i * 4);
+		low = min(low, record);
+		high = max(high, record);
+	}
+	low.store(minimum);
+	high.store(maximum);
+}
+
+color_manipulation::color_statistics::color_statistics(color_type type, bool include_alpha)
+	: m_type(type), m_include_alpha(include_alpha), m_count(0)
+{
+	m_channel_count = stream_converter::get_record_size(type);
+	m_mean.fill(0.0);
+	m_minimum.fill(0.f);
+	m_maximum.fill(0.f);
+	m_comoments.fill(0.0);
+}
+
+color_manipulation::color_statistics color_manipulation::color_statistics::compute(const float* records, size_t count, color_type type, bool include_alpha, executor* exec)
+{
+	if (records == nullptr && count > 0) throw new std::invalid_argument("records is null.");
+
+	size_t record_size = stream_converter::get_record_size(type);
+	return reduce(count, type, include_alpha, exec, [&](color_statistics& block, size_t begin, size_t end)
+	{
+		switch (record_size)
+		{
+		case 2:
+			block.add_block<2>(records + begin * 2, end - begin);
+			break;
+		case 4:
+			block.add_block<4>(records + begin * 4, end - begin);
+			break;
+		default:
+			block.add_block<5>(records + begin * 5, end - begin);
+			break;
+		}
+	});
+}
+
+color_manipulation::color_statistics color_manipulation::color_statistics::compute(const pixel_view& pixels, bool include_alpha, const conversion_plan* plan, executor* exec)
+{
+	color_type type = plan != nullptr ? plan->get_output_type() : color_type::RGB_TRUE;
+	color_type in_type = plan != nullptr ? plan->get_input_type() : color_type::RGB_TRUE;
+	if (in_type != color_type::RGB_TRUE && in_type != color_type::RGB_DEEP) throw new std::invalid_argument("The plan has to convert from rgb colors.");
+
+	float in_max = in_type == color_type::RGB_TRUE ? 255.f : 1.f;
+	return reduce(pixels.size(), type, include_alpha, exec, [&](color_statistics& block, size_t begin, size_t end)
+	{
+		// Unpack and convert in parts that stay in the cache. The parts of a block are merged in order as well.
+		const size_t part_size = 256;
+		float part[part_size * 4];
+		sequential_executor sequential;
+		for (size_t first = begin; first < end; first += part_size)
+		{
+			size_t count = std::min(part_size, end - first);
+			pixels.unpack(first, count, part, in_max);
+			if (plan != nullptr) plan->apply(part, part, count, &sequential);
+
+			color_statistics statistics(type, include_alpha);
+			statistics.add_block<4>(part, count);
+			block.merge(statistics);
+		}
+	});
+}
+
+void color_manipulation::color_statistics::merge(const color_statistics& other)
+{
+	if (other.m_type != m_type || other.m_include_alpha != m_include_alpha) throw new std::invalid_argument("Only statistics of the same color type and alpha handling can be merged.");
+	if (other.m_count == 0) return;
+	if (m_count == 0)
+	{
+		*this = other;
+		return;
+	}
+
+	// Combines the means and co-moments of both parts (Chan et al.). If alpha is not included, the alpha of the
+	// first color stays.
+	size_t channels = m_include_alpha ? m_channel_count : m_channel_count - 1;
+	double count = (double)m_count + (double)other.m_count;
+	double weight = (double)m_count * (double)other.m_count / count;
+	std::array<double, max_channels> delta;
+	for (size_t c = 0; c < channels; ++c) delta[c] = other.m_mean[c] - m_mean[c];
+	for (size_t i = 0; i < channels; ++i)
+	{
+		for (size_t j = 0; j < channels; ++j)
+		{
+			m_comoments[i * max_channels + j] += other.m_comoments[i * max_channels + j] + delta[i] * delta[j] * weight;
+		}
+	}
+	for (size_t c = 0; c < channels; ++c)
+	{
+		m_mean[c] += delta[c] * (double)other.m_count / count;
+		m_minimum[c] = std::min(m_minimum[c], other.m_minimum[c]);
+		m_maximum[c] = std::max(m_maximum[c], other.m_maximum[c]);
+	}
+	m_count += other.m_count;
+}
+
+float color_manipulation::color_statistics::mean(size_t channel) const
+{
+	check_channel(channel);
+	return (float)m_mean[channel];
+}
+
+float color_manipulation::color_statistics::minimum(size_t channel) const
+{
+	check_channel(channel);
+	return m_minimum[channel];
+}
+
+float color_manipulation::color_statistics::maximum(size_t channel) const
+{
+	check_channel(channel);
+	return m_maximum[channel];
+}
+
+float color_manipulation::color_statistics::variance(size_t channel) const
+{
+	return covariance(channel, channel);
+}
+
+float color_manipulation::color_statistics::covariance(size_t channel1, size_t channel2) const
+{
+	check_channel(channel1);
+	check_channel(channel2);
+	if (m_count == 0) return 0.f;
+
+	return (float)(m_comoments[channel1 * max_channels + channel2] / (double)m_count);
+}
+
+color_space::color_base* color_manipulation::color_statistics::mean_color(color_space::rgb_color_space_definition* color_space) const
+{
+	if (m_count == 0) throw new std::invalid_argument("The statistics contain no colors.");
+
+	float record[max_channels];
+	for (size_t c = 0; c < m_channel_count; ++c) record[c] = (float)m_mean[c];
+	return stream_converter::create_color(m_type, record, color_space);
+}
+
+template <typename Function> color_manipulation::color_statistics color_manipulation::color_statistics::reduce(size_t count, color_type type, bool include_alpha, executor* exec, Function reduce_block)
+{
+	size_t block_count = (count + block_size - 1) / block_size;
+	std::vector<color_statistics> blocks(block_count, color_statistics(type, include_alpha));
+	auto reduce_range = [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i) reduce_block(blocks[i], i * block_size, std::min(count, (i + 1) * block_size));
+	};
+
+	// A single block is not worth a task
+	if (block_count > 1)
+	{
+		executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+		runner->parallel_for(0, block_count, reduce_range, 1);
+	}
+	else
+	{
+		reduce_range(0, block_count);
+	}
+
+	color_statistics result(type, include_alpha);
+	for (const auto& block : blocks) result.merge(block);
+	return result;
+}
+
+template <size_t Channels> void color_manipulation::color_statistics::add_block(const float* records, size_t count)
+{
+	if (count == 0) return;
+
+	// Sums of the deviations from the first record and of their products. The shift keeps the sums small, so the
+	// co-moments do not cancel out even if the values have a large offset.
+	const float* shift = records;
+	size_t channels = m_include_alpha ? Channels : Channels - 1;
+	double sums[Channels] = {};
+	double products[Channels * Channels] = {};
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float* record = records + i * Channels;
+		double deviations[Channels];
+		for (size_t c = 0; c < Channels; ++c) deviations[c] = (double)record[c] - shift[c];
+		for (size_t c = 0; c < Channels; ++c) sums[c] += deviations[c];
+		for (size_t a = 0; a < channels; ++a)
+		{
+			for (size_t b = a; b < channels; ++b) products[a * Channels + b] += deviations[a] * deviations[b];
+		}
+	}
+	find_range<Channels>(records, count, m_minimum.data(), m_maximum.data());
+
+	m_count = count;
+	for (size_t a = 0; a < channels; ++a)
+	{
+		m_mean[a] = shift[a] + sums[a] / (double)count;
+		for (size_t b = a; b < channels; ++b)
+		{
+			double comoment = products[a * Channels + b] - sums[a] * sums[b] / (double)count;
+			m_comoments[a * max_channels + b] = comoment;
+			m_comoments[b * max_channels + a] = comoment;
+		}
+	}
+
+	// Like the average functions, the alpha of the first color is kept if alpha is not included
+	if (!m_include_alpha)
+	{
+		m_mean[Channels - 1] = m_minimum[Channels - 1] = m_maximum[Channels - 1] = shift[Channels - 1];
+	}
+}
+
+void color_manipulation::color_statistics::check_channel(size_t channel) const
+{
+	if (channel >= m_channel_count) throw new std::out_of_range("Index out of range by accessing a statistics channel.");
+}
@@ -0,0 +1,142 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+#include "../spaces/color_base.h"
+#include "../spaces/rgb_color_space_definition.h"
+#include "conversion_plan.h"
+
+#include <array>
+#include <cstdint>
+
+namespace color_manipulation
+{
+	//! Mean, minimum, maximum, variance and covariance of the channels of a buffer of colors.
+	/*!
+	* The statistics are computed in one pass over color records (see stream_converter) or 8 bit pixels, optionally
+	* converted by a conversion_plan on the fly (e.g. to lab), without creating a color object per pixel.
+	*
+	* The buffer is split into blocks of a fixed number of colors. The blocks are reduced in parallel on the given
+	* executor and the partial results are merged in the order of the blocks afterwards. Since neither the blocks nor
+	* the merge order depend on the executor, the results are bit for bit the same for any number of threads.
+	* Sums are taken in double precision relative to the first color of each block, so large offsets and millions of
+	* colors do not cost precision.
+	*
+	* Channels follow the average functions of color_calculation: all components are treated linearly (use
+	* color_accumulator for circular hue means) and if alpha is not included, the alpha channel holds the alpha of
+	* the first color with no spread.
+	*/
+	class color_statistics
+	{
+	public:
+		//! Maximum number of channels (the four cmyk components and alpha).
+		static const size_t max_channels = 5;
+
+		//! Number of colors per block. Blocks are the unit of work and of the merge order.
+		static const size_t block_size = 16384;
+
+		//! Default constructor.
+		/*!
+		* Creates empty statistics of the given color type.
+		* \param type The color type of the colors.
+		* \param include_alpha Whether alpha is part of the statistics or the alpha of the first color is kept.
+		*/
+		explicit color_statistics(color_type type = color_type::RGB_TRUE, bool include_alpha = false);
+
+		//! Static function that computes the statistics of color records.
+		/*!
+		* \param records The first value of the first record.
+		* \param count The number of records.
+		* \param type The color type of the records.
+		* \param include_alpha Whether alpha should be included in the statistics or not.
+		* \param exec The executor that reduces the blocks. If null the default thread pool is used.
+		* \return The statistics.
+		*/
+		static color_statistics compute(const float* records, size_t count, color_type type, bool include_alpha = false, executor* exec = nullptr);
+
+		//! Static function that computes the statistics of 8 bit pixels.
+		/*!
+		* \param pixels The pixels.
+		* \param include_alpha Whether alpha should be included in the statistics or not.
+		* \param plan Converts the pixels before they are reduced, e.g. to lab. Has to convert from RGB_TRUE or
+		* RGB_DEEP. If null the statistics are the ones of RGB_TRUE records.
+		* \param exec The executor that reduces the blocks. If null the default thread pool is used.
+		* \return The statistics in the output type of the plan.
+		*/
+		static color_statistics compute(const pixel_view& pixels, bool include_alpha = false, const conversion_plan* plan = nullptr, executor* exec = nullptr);
+
+		//! Adds the colors of other statistics. Throws if the color types or the alpha handling differ.
+		void merge(const color_statistics& other);
+
+		//! Returns the color type of the colors.
+		color_type get_color_type() const { return m_type; }
+
+		//! Returns the number of channels, i.e. the number of components plus one for alpha.
+		size_t get_channel_count() const { return m_channel_count; }
+
+		//! Returns the number of colors.
+		uint64_t count() const { return m_count; }
+
+		//! Returns the mean of a channel.
+		float mean(size_t channel) const;
+
+		//! Returns the smallest value of a channel.
+		float minimum(size_t channel) const;
+
+		//! Returns the largest value of a channel.
+		float maximum(size_t channel) const;
+
+		//! Returns the population variance of a channel.
+		float variance(size_t channel) const;
+
+		//! Returns the population covariance of two channels. covariance(i, i) is variance(i).
+		float covariance(size_t channel1, size_t channel2) const;
+
+		//! Returns the mean color. Throws if there are no colors. The caller owns the color.
+		/*!
+		* \param color_space The rgb color space definition of the new color.
+		* \return The mean of all channels as a color of the color type of the statistics.
+		*/
+		color_space::color_base* mean_color(color_space::rgb_color_space_definition* color_space) const;
+
+	protected:
+		//! Splits count colors into blocks, calls reduce_block(statistics, begin, end) for each block on the executor and merges the blocks in order.
+		template <typename Function> static color_statistics reduce(size_t count, color_type type, bool include_alpha, executor* exec, Function reduce_block);
+
+		//! Computes the statistics of consecutive records. The statistics have to be empty.
+		template <size_t Channels> void add_block(const float* records, size_t count);
+
+		//! Throws if the channel does not exist.
+		void check_channel(size_t channel) const;
+
+		//! The color type of the colors.
+		color_type m_type;
+
+		//! Whether alpha is part of the statistics.
+		bool m_include_alpha;
+
+		//! The number of channels including alpha.
+		size_t m_channel_count;
+
+		//! The number of colors.
+		uint64_t m_count;
+
+		//! Mean of each channel.
+		std::array<double, max_channels> m_mean;
+
+		//! Smallest value of each channel.
+		std::array<float, max_channels> m_minimum;
+
+		//! Largest value of each channel.
+		std::array<float, max_channels> m_maximum;
+
+		//! Sums of the products of the deviations from the means of each pair of channels, row major.
+		std::array<double, max_channels * max_channels> m_comoments;
+	};
+}
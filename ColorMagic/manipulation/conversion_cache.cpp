@@ -0,0 +1,183 @@
+#include "stdafx.h"
+#include "conversion_cache.h"
+#include "color_converter.h"
+#include "stream_converter.h"
+
+#include <cstring>
+
+color_manipulation::conversion_cache::conversion_cache(size_t capacity, size_t shard_count)
+	: m_enabled(true), m_hits(0), m_misses(0), m_evictions(0)
+{
+	if (capacity == 0) throw new std::invalid_argument("Parameter capacity has to be greater than 0.");
+	if (shard_count == 0) throw new std::invalid_argument("Parameter shard_count has to be greater than 0.");
+
+	size_t shard_capacity = (capacity + shard_count - 1) / shard_count;
+	for (size_t i = 0; i < shard_count; ++i)
+	{
+		m_shards.emplace_back(new shard());
+		m_shards.back()->slots.resize(shard_capacity);
+		m_shards.back()->index.reserve(shard_capacity);
+	}
+}
+
+color_space::color_base* color_manipulation::conversion_cache::convert(const color_space::color_base* in_color, color_type out_color)
+{
+	return convert(in_color, out_color, precision::get_default());
+}
+
+color_space::color_base* color_manipulation::conversion_cache::convert(const color_space::color_base* in_color, color_type out_color, precision_policy policy)
+{
+	if (in_color == nullptr) throw new std::invalid_argument("color is null.");
+
+	key id;
+	if (!m_enabled.load(std::memory_order_relaxed) || !create_key(in_color, out_color, policy, id))
+	{
+		return color_manipulation::color_converter::convertTo(in_color, out_color, policy);
+	}
+
+	size_t hash = key_hash()(id);
+	shard& target = get_shard(hash);
+	{
+		std::lock_guard<std::mutex> lock(target.mutex);
+		auto entry = target.index.find(id);
+		if (entry != target.index.end())
+		{
+			slot& cached = target.slots[entry->second];
+			cached.referenced = true;
+			m_hits.fetch_add(1, std::memory_order_relaxed);
+			return color_manipulation::stream_converter::create_color(out_color, cached.record.data(), in_color->get_rgb_color_space());
+		}
+	}
+
+	// Convert without holding the lock so that other threads are not blocked
+	m_misses.fetch_add(1, std::memory_order_relaxed);
+	auto result = color_manipulation::color_converter::convertTo(in_color, out_color, policy);
+	if (result == nullptr) return nullptr;
+
+	auto components = result->get_component_vector();
+	if (components.size() < max_record_size)
+	{
+		std::array<float, max_record_size> record = {};
+		std::copy(components.begin(), components.end(), record.begin());
+		record[components.size()] = result->alpha();
+		insert(target, id, record);
+	}
+	return result;
+}
+
+void color_manipulation::conversion_cache::clear()
+{
+	for (auto& part : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(part->mutex);
+		part->index.clear();
+		for (auto& entry : part->slots)
+		{
+			entry.used = false;
+			entry.referenced = false;
+		}
+		part->hand = 0;
+	}
+}
+
+color_manipulation::cache_statistics color_manipulation::conversion_cache::get_statistics() const
+{
+	cache_statistics statistics;
+	statistics.hits = m_hits.load();
+	statistics.misses = m_misses.load();
+	statistics.evictions = m_evictions.load();
+	statistics.size = 0;
+	statistics.capacity = 0;
+	for (auto& part : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(part->mutex);
+		statistics.size += part->index.size();
+		statistics.capacity += part->slots.size();
+	}
+	return statistics;
+}
+
+void color_manipulation::conversion_cache::reset_statistics()
+{
+	m_hits.store(0);
+	m_misses.store(0);
+	m_evictions.store(0);
+}
+
+color_manipulation::conversion_cache& color_manipulation::conversion_cache::get_default()
+{
+	// Intentionally leaked like the default thread pool, so it can be used during static destruction
+	static conversion_cache* cache = new conversion_cache();
+	return *cache;
+}
+
+size_t color_manipulation::conversion_cache::key_hash::operator()(const key& value) const
+{
+	// FNV-1a over the key fields
+	uint64_t hash = 14695981039346656037ull;
+	auto mix = [&hash](uint64_t data)
+	{
+		for (int i = 0; i < 8; ++i)
+		{
+			hash ^= (data >> (i * 8)) & 0xFF;
+			hash *= 1099511628211ull;
+		}
+	};
+
+	for (auto bits : value.bits) mix(bits);
+	mix(((uint64_t)value.policy << 16) | ((uint64_t)value.in_type << 8) | value.out_type);
+	mix(value.color_space_generation);
+	return (size_t)hash;
+}
+
+bool color_manipulation::conversion_cache::create_key(const color_space::color_base* in_color, color_type out_color, precision_policy policy, key& result)
+{
+	auto components = in_color->get_component_vector();
+	if (components.size() >= max_record_size) return false;
+
+	result.bits.fill(0);
+	for (size_t i = 0; i < components.size(); ++i)
+	{
+		// +0 and -0 convert to the same color, so they share an entry
+		float value = components[i] == 0.f ? 0.f : components[i];
+		std::memcpy(&result.bits[i], &value, sizeof(float));
+	}
+	float alpha = in_color->alpha();
+	std::memcpy(&result.bits[components.size()], &alpha, sizeof(float));
+
+	result.in_type = (uint8_t)in_color->get_color_type();
+	result.out_type = (uint8_t)out_color;
+	result.policy = (uint8_t)policy;
+	auto color_space = in_color->get_rgb_color_space();
+	result.color_space_generation = color_space != nullptr ? color_space->get_generation() : 0;
+	return true;
+}
+
+void color_manipulation::conversion_cache::insert(shard& target, const key& id, const std::array<float, max_record_size>& record)
+{
+	std::lock_guard<std::mutex> lock(target.mutex);
+
+	// Another thread may have stored the same conversion in the meantime
+	if (target.index.find(id) != target.index.end()) return;
+
+	// CLOCK: skip entries that were used since the hand passed them the last time
+	while (target.slots[target.hand].used && target.slots[target.hand].referenced)
+	{
+		target.slots[target.hand].referenced = false;
+		target.hand = (target.hand + 1) % target.slots.size();
+	}
+
+	slot& victim = target.slots[target.hand];
+	if (victim.used)
+	{
+		target.index.erase(victim.id);
+		m_evictions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	victim.id = id;
+	victim.record = record;
+	victim.used = true;
+	victim.referenced = false;
+	target.index[id] = target.hand;
+	target.hand = (target.hand + 1) % target.slots.size();
+}
@@ -0,0 +1,177 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../spaces/color_base.h"
+#include "../spaces/rgb_color_space_definition.h"
+#include "../utils/precision.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Hit and miss counters of a conversion_cache.
+	struct cache_statistics
+	{
+		size_t hits; /*!< Number of conversions answered from the cache */
+		size_t misses; /*!< Number of conversions that had to be calculated */
+		size_t evictions; /*!< Number of entries that were replaced by newer ones */
+		size_t size; /*!< Number of entries currently stored */
+		size_t capacity; /*!< Maximum number of entries */
+	};
+
+	//! Thread-safe memoizing cache in front of color_converter::convertTo().
+	/*!
+	* Palettes and UI themes convert the same few thousand colors over and over. The cache remembers the result of
+	* each conversion, keyed by the bit pattern of the input components and alpha, the input and output color type,
+	* the precision policy and the generation of the rgb color space definition. Entries are spread over independently locked shards and
+	* each shard replaces its entries with the CLOCK (second chance) strategy, so the memory usage is bounded by
+	* the capacity.
+	*
+	* The generation changes with every change of the definition and is never reused by another definition, so
+	* entries of changed or deleted definitions are never returned, they just age out. Call clear() after changing
+	* the active lab_table.
+	*/
+	class conversion_cache
+	{
+	public:
+		//! Default constructor.
+		/*!
+		* \param capacity The maximum number of cached conversions. Is rounded up to a multiple of shard_count.
+		* \param shard_count The number of independently locked parts of the cache.
+		*/
+		conversion_cache(size_t capacity = 4096, size_t shard_count = 16);
+
+		conversion_cache(const conversion_cache&) = delete;
+		conversion_cache& operator=(const conversion_cache&) = delete;
+
+		//! Converts the given color like color_converter::convertTo() and remembers the result.
+		/*!
+		* \param in_color The color to convert.
+		* \param out_color The desired color type.
+		* \return A new color object owned by the caller or null if the conversion is not supported.
+		*/
+		color_space::color_base* convert(const color_space::color_base* in_color, color_type out_color);
+
+		//! Converts the given color like color_converter::convertTo() with the given precision policy and remembers the result.
+		/*!
+		* Results of different policies are stored as different entries.
+		* \param in_color The color to convert.
+		* \param out_color The desired color type.
+		* \param policy The precision policy of the conversion.
+		* \return A new color object owned by the caller or null if the conversion is not supported.
+		*/
+		color_space::color_base* convert(const color_space::color_base* in_color, color_type out_color, precision_policy policy);
+
+		//! Converts the given color and casts the result to the desired class.
+		/*!
+		* \param in_color The color to convert.
+		* \param out_color The color type that corresponds to T.
+		* \return A new color object owned by the caller.
+		*/
+		template <typename T>
+		T* convert_as(const color_space::color_base* in_color, color_type out_color) { return static_cast<T*>(convert(in_color, out_color)); }
+
+		//! Converts the given color with the given precision policy and casts the result to the desired class.
+		/*!
+		* \param in_color The color to convert.
+		* \param out_color The color type that corresponds to T.
+		* \param policy The precision policy of the conversion.
+		* \return A new color object owned by the caller.
+		*/
+		template <typename T>
+		T* convert_as(const color_space::color_base* in_color, color_type out_color, precision_policy policy) { return static_cast<T*>(convert(in_color, out_color, policy)); }
+
+		//! Enables or disables the cache. A disabled cache forwards every call to convertTo() and counts nothing.
+		void set_enabled(bool enabled) { m_enabled.store(enabled); }
+
+		//! Returns whether the cache is enabled.
+		bool is_enabled() const { return m_enabled.load(); }
+
+		//! Removes all entries. The statistics are kept.
+		void clear();
+
+		//! Returns the current hit and miss counters.
+		cache_statistics get_statistics() const;
+
+		//! Sets the hit, miss and eviction counters to 0.
+		void reset_statistics();
+
+		//! Returns a cache shared by the whole process.
+		static conversion_cache& get_default();
+
+	protected:
+		//! Maximum number of floats of a color (4 components and alpha).
+		static const size_t max_record_size = 5;
+
+		//! Identifies a single conversion.
+		struct key
+		{
+			std::array<uint32_t, max_record_size> bits;
+			uint8_t in_type;
+			uint8_t out_type;
+			uint8_t policy;
+			uint64_t color_space_generation;
+
+			bool operator==(const key& other) const
+			{
+				return bits == other.bits && in_type == other.in_type && out_type == other.out_type && policy == other.policy
+					&& color_space_generation == other.color_space_generation;
+			}
+		};
+
+		//! Hash function for keys.
+		struct key_hash
+		{
+			size_t operator()(const key& value) const;
+		};
+
+		//! A stored conversion result.
+		struct slot
+		{
+			key id;
+			std::array<float, max_record_size> record;
+			bool used = false;
+			bool referenced = false;
+		};
+
+		//! Independently locked part of the cache.
+		struct shard
+		{
+			std::mutex mutex;
+			std::vector<slot> slots;
+			std::unordered_map<key, size_t, key_hash> index;
+			size_t hand = 0;
+		};
+
+		//! Creates the key of a conversion. Returns false if the color has too many components.
+		static bool create_key(const color_space::color_base* in_color, color_type out_color, precision_policy policy, key& result);
+
+		//! Returns the shard that is responsible for the given key.
+		shard& get_shard(size_t hash) { return *m_shards[(hash >> 7) % m_shards.size()]; }
+
+		//! Stores a conversion result. Replaces an unreferenced entry if the shard is full.
+		void insert(shard& target, const key& id, const std::array<float, max_record_size>& record);
+
+		//! Whether conversions are cached.
+		std::atomic<bool> m_enabled;
+
+		//! The shards of the cache.
+		std::vector<std::unique_ptr<shard>> m_shards;
+
+		//! Statistic counters.
+		std::atomic<size_t> m_hits;
+		std::atomic<size_t> m_misses;
+		std::atomic<size_t> m_evictions;
+	};
+}
@@ -0,0 +1,610 @@
+#include "stdafx.h"
+#include "conversion_plan.h"
+#include "stream_converter.h"
+#include "../utils/simd_math.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+// Constants of the CIE lab definition
+static const float lab_epsilon = 216.f / 24389.f;
+static const float lab_kappa = 24389.f / 27.f;
+
+// Plans created by conversion_plan::get(), keyed by types, definitions and their generations, adaptation method and policy.
+// The map is intentionally leaked so that it can be used during static destruction.
+typedef std::tuple<int, void*, uint64_t, int, void*, uint64_t, int, int> plan_key;
+static std::mutex plan_cache_mutex;
+static std::map<plan_key, std::shared_ptr<const color_manipulation::conversion_plan>>& plan_cache()
+{
+	static auto cache = new std::map<plan_key, std::shared_ptr<const color_manipulation::conversion_plan>>();
+	return *cache;
+}
+
+color_manipulation::conversion_plan::conversion_plan(color_type in_type, color_space::rgb_color_space_definition* in_space, color_type out_type, color_space::rgb_color_space_definition* out_space, adaptation_method method, precision_policy policy)
+	: m_in_type(in_type), m_out_type(out_type), m_out_space(out_space), m_precision(policy), m_alpha_scale(1.f)
+{
+	if (!is_supported(in_type) || !is_supported(out_type)) throw new std::invalid_argument("Unsupported color type.");
+	if (in_space == nullptr || out_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+	if (policy < EXACT || policy > FASTEST) throw new std::invalid_argument("Unknown precision policy.");
+
+	if (in_type == color_type::RGB_TRUE) m_alpha_scale /= 255.f;
+	if (out_type == color_type::RGB_TRUE) m_alpha_scale *= 255.f;
+
+	// Conversions within the same color type and space only copy the components
+	if (in_type == out_type && in_space == out_space) return;
+
+	add_steps_to_xyz(in_type, in_space);
+	if (in_space != out_space && !(*in_space->get_white_point() == *out_space->get_white_point()))
+	{
+		add_affine(create_affine(chromatic_adaptation::get_adaptation_matrix(in_space->get_white_point(), out_space->get_white_point(), method)));
+	}
+	add_steps_from_xyz(out_type, out_space);
+
+	// Build the gamma tables now, so the kernels can read them without checking
+	if (policy == FASTEST)
+	{
+		for (auto& current : m_steps)
+		{
+			if (current.curve != nullptr) current.curve->compile_once();
+		}
+	}
+}
+
+std::shared_ptr<const color_manipulation::conversion_plan> color_manipulation::conversion_plan::get(color_type in_type, color_space::rgb_color_space_definition* in_space, color_type out_type, color_space::rgb_color_space_definition* out_space, adaptation_method method, precision_policy policy)
+{
+	// The generations change with every change of a definition and are never reused, so plans of changed or deleted
+	// definitions (even if a new definition got the same address) are never returned
+	uint64_t in_generation = in_space != nullptr ? in_space->get_generation() : 0;
+	uint64_t out_generation = out_space != nullptr ? out_space->get_generation() : 0;
+	plan_key key(in_type, in_space, in_generation, out_type, out_space, out_generation, method, policy);
+	{
+		std::lock_guard<std::mutex> lock(plan_cache_mutex);
+		auto entry = plan_cache().find(key);
+		if (entry != plan_cache().end()) return entry->second;
+	}
+
+	// Build outside the lock, a plan that was built twice in parallel is simply discarded
+	auto plan = std::make_shared<const conversion_plan>(in_type, in_space, out_type, out_space, method, policy);
+	std::lock_guard<std::mutex> lock(plan_cache_mutex);
+
+	// Plans of older generations of the same addresses can not be returned anymore, remove them
+	auto& cache = plan_cache();
+	auto is_outdated = [](void* space, uint64_t generation, const plan_key& other)
+	{
+		return (std::get<1>(other) == space && std::get<2>(other) != generation) || (std::get<4>(other) == space && std::get<5>(other) != generation);
+	};
+	for (auto entry = cache.begin(); entry != cache.end();)
+	{
+		if (is_outdated(in_space, in_generation, entry->first) || is_outdated(out_space, out_generation, entry->first)) entry = cache.erase(entry);
+		else ++entry;
+	}
+	return cache.emplace(key, plan).first->second;
+}
+
+void color_manipulation::conversion_plan::clear_cache()
+{
+	std::lock_guard<std::mutex> lock(plan_cache_mutex);
+	plan_cache().clear();
+}
+
+bool color_manipulation::conversion_plan::is_supported(color_type type)
+{
+	switch (type)
+	{
+	case color_type::RGB_TRUE:
+	case color_type::RGB_DEEP:
+	case color_type::XYZ:
+	case color_type::XYY:
+	case color_type::LAB:
+	case color_type::LCH_AB:
+		return true;
+	default:
+		return false;
+	}
+}
+
+// Runs the steps in the precision of T with the math of the policy. Gamma curves are always evaluated in float.
+template <precision_policy Policy, typename T> static void execute_steps(const std::vector<color_manipulation::conversion_plan::step>& steps, T* components)
+{
+	typedef precision_math<Policy> math;
+
+	for (auto& current : steps)
+	{
+		const float* m = current.values.data();
+		switch (current.type)
+		{
+		case color_manipulation::plan_step_type::AFFINE:
+		{
+			T x = components[0];
+			T y = components[1];
+			T z = components[2];
+			components[0] = T(m[0]) * x + T(m[1]) * y + T(m[2]) * z + T(m[3]);
+			components[1] = T(m[4]) * x + T(m[5]) * y + T(m[6]) * z + T(m[7]);
+			components[2] = T(m[8]) * x + T(m[9]) * y + T(m[10]) * z + T(m[11]);
+			break;
+		}
+		case color_manipulation::plan_step_type::DECODE_GAMMA:
+			for (int i = 0; i < 3; ++i)
+			{
+				float value = fminf(fmaxf((float)components[i], 0.f), 1.f);
+				value = precision_math<Policy>::gamma_tables ? current.curve->table_inverse_gamma_correction(value) : current.curve->inverse_gamma_correction(value);
+				components[i] = T(fminf(fmaxf(value, 0.f), 1.f));
+			}
+			break;
+		case color_manipulation::plan_step_type::ENCODE_GAMMA:
+			for (int i = 0; i < 3; ++i)
+			{
+				float value = fminf(fmaxf((float)components[i], 0.f), 1.f);
+				components[i] = T(math::gamma_tables ? current.curve->table_gamma_correction(value) : current.curve->gamma_correction(value));
+			}
+			break;
+		case color_manipulation::plan_step_type::LAB_COMPAND:
+			for (int i = 0; i < 3; ++i)
+			{
+				components[i] = components[i] > T(lab_epsilon) ? math::cbrt(components[i]) : (T(lab_kappa) * components[i] + T(16)) / T(116);
+			}
+			break;
+		case color_manipulation::plan_step_type::LAB_EXPAND:
+			for (int i = 0; i < 3; ++i)
+			{
+				T cube = components[i] * components[i] * components[i];
+				components[i] = cube > T(lab_epsilon) ? cube : (T(116) * components[i] - T(16)) / T(lab_kappa);
+			}
+			break;
+		case color_manipulation::plan_step_type::XYZ_TO_XYY:
+		{
+			T sum = components[0] + components[1] + components[2];
+			T luminance = components[1];
+			if (components[0] == T(0) && components[1] == T(0) && components[2] == T(0))
+			{
+				// Black gets the chromaticity of the reference white
+				components[0] = T(m[0]);
+				components[1] = T(m[1]);
+			}
+			else
+			{
+				components[0] /= sum;
+				components[1] /= sum;
+			}
+			components[2] = luminance;
+			break;
+		}
+		case color_manipulation::plan_step_type::XYY_TO_XYZ:
+		{
+			T x = components[0];
+			T y = components[1];
+			T luminance = components[2];
+			if (y == T(0))
+			{
+				components[0] = components[1] = components[2] = T(0);
+			}
+			else
+			{
+				components[0] = x * luminance / y;
+				components[1] = luminance;
+				components[2] = (T(1) - x - y) * luminance / y;
+			}
+			break;
+		}
+		case color_manipulation::plan_step_type::LAB_TO_LCH:
+		{
+			// Same conventions like color_converter::lab_to_lch_ab()
+			T chroma = std::sqrt(components[1] * components[1] + components[2] * components[2]);
+			T hue = math::atan2(components[2], components[1]);
+			if (hue < T(0)) hue += T(360);
+			components[1] = (chroma + T(128)) * T(100) / T(256);
+			components[2] = hue;
+			break;
+		}
+		case color_manipulation::plan_step_type::LCH_TO_LAB:
+		{
+			T hue = T(components[2] * M_PI / 180.0);
+			T chroma = components[1];
+			components[1] = chroma * math::cos(hue);
+			components[2] = chroma * math::sin(hue);
+			break;
+		}
+		case color_manipulation::plan_step_type::ROUND:
+			for (int i = 0; i < 3; ++i) components[i] = std::round(components[i]);
+			break;
+		}
+	}
+}
+
+// Runs the steps on four colors at once with the vectorized math of the policy, x, y and z hold one component of each
+// color. Follows execute_steps() step by step, so the lanes give the results of the scalar math of the same policy.
+template <precision_policy Policy> static void execute_steps(const std::vector<color_manipulation::conversion_plan::step>& steps, float4& x, float4& y, float4& z)
+{
+	typedef simd_math<Policy> math;
+	float4* components[3] = { &x, &y, &z };
+
+	for (auto& current : steps)
+	{
+		const float* m = current.values.data();
+		switch (current.type)
+		{
+		case color_manipulation::plan_step_type::AFFINE:
+		{
+			float4 new_x = float4(m[0]) * x + float4(m[1]) * y + float4(m[2]) * z + float4(m[3]);
+			float4 new_y = float4(m[4]) * x + float4(m[5]) * y + float4(m[6]) * z + float4(m[7]);
+			z = float4(m[8]) * x + float4(m[9]) * y + float4(m[10]) * z + float4(m[11]);
+			x = new_x;
+			y = new_y;
+			break;
+		}
+		case color_manipulation::plan_step_type::DECODE_GAMMA:
+			for (auto component : components)
+			{
+				// The curves are scalar functions or tables, they are evaluated lane by lane
+				*component = map_lanes(min(max(*component, float4(0.f)), float4(1.f)), [&](float value)
+				{
+					value = precision_math<Policy>::gamma_tables ? current.curve->table_inverse_gamma_correction(value) : current.curve->inverse_gamma_correction(value);
+					return fminf(fmaxf(value, 0.f), 1.f);
+				});
+			}
+			break;
+		case color_manipulation::plan_step_type::ENCODE_GAMMA:
+			for (auto component : components)
+			{
+				*component = map_lanes(min(max(*component, float4(0.f)), float4(1.f)), [&](float value)
+				{
+					return precision_math<Policy>::gamma_tables ? current.curve->table_gamma_correction(value) : current.curve->gamma_correction(value);
+				});
+			}
+			break;
+		case color_manipulation::plan_step_type::LAB_COMPAND:
+			for (auto component : components)
+			{
+				*component = select(*component > float4(lab_epsilon), math::cbrt(*component), (float4(lab_kappa) * *component + float4(16.f)) / float4(116.f));
+			}
+			break;
+		case color_manipulation::plan_step_type::LAB_EXPAND:
+			for (auto component : components)
+			{
+				float4 cube = *component * *component * *component;
+				*component = select(cube > float4(lab_epsilon), cube, (float4(116.f) * *component - float4(16.f)) / float4(lab_kappa));
+			}
+			break;
+		case color_manipulation::plan_step_type::XYZ_TO_XYY:
+		{
+			float4 sum = x + y + z;
+			float4 black = (x == float4(0.f)) & (y == float4(0.f)) & (z == float4(0.f));
+			float4 luminance = y;
+			x = select(black, float4(m[0]), x / sum);
+			y = select(black, float4(m[1]), y / sum);
+			z = luminance;
+			break;
+		}
+		case color_manipulation::plan_step_type::XYY_TO_XYZ:
+		{
+			float4 zero = y == float4(0.f);
+			float4 luminance = z;
+			float4 new_x = x * luminance / y;
+			z = select(zero, float4(0.f), (float4(1.f) - x - y) * luminance / y);
+			x = select(zero, float4(0.f), new_x);
+			y = select(zero, float4(0.f), luminance);
+			break;
+		}
+		case color_manipulation::plan_step_type::LAB_TO_LCH:
+		{
+			float4 chroma = sqrt(y * y + z * z);
+			float4 hue = math::atan2(z, y);
+			hue = select(hue < float4(0.f), hue + float4(360.f), hue);
+			y = (chroma + float4(128.f)) * float4(100.f) / float4(256.f);
+			z = hue;
+			break;
+		}
+		case color_manipulation::plan_step_type::LCH_TO_LAB:
+		{
+			float4 sin, cos;
+			math::sincos(z * float4((float)(M_PI / 180.0)), sin, cos);
+			float4 chroma = y;
+			y = chroma * cos;
+			z = chroma * sin;
+			break;
+		}
+		case color_manipulation::plan_step_type::ROUND:
+			for (auto component : components) *component = round(*component);
+			break;
+		}
+	}
+}
+
+// Converts float records in blocks of four with the vectorized steps and returns the number of converted records.
+// EXACT plans are converted one by one with the scalar steps, so their results stay unchanged.
+template <precision_policy Policy> static size_t convert_blocks(const std::vector<color_manipulation::conversion_plan::step>& steps, const float* in_records, float* out_records, size_t color_count, float alpha_scale, bool round_alpha)
+{
+	if (Policy == EXACT) return 0;
+
+	size_t i = 0;
+	for (; i + 4 <= color_count; i += 4)
+	{
+		// Four rgba records form a 4x4 matrix, transposing it gives one vector per component
+		float4 x = float4::load(in_records + i * 4);
+		float4 y = float4::load(in_records + i * 4 + 4);
+		float4 z = float4::load(in_records + i * 4 + 8);
+		float4 alpha = float4::load(in_records + i * 4 + 12);
+		transpose(x, y, z, alpha);
+
+		execute_steps<Policy>(steps, x, y, z);
+		alpha = alpha * float4(alpha_scale);
+		if (round_alpha) alpha = round(alpha);
+
+		transpose(x, y, z, alpha);
+		x.store(out_records + i * 4);
+		y.store(out_records + i * 4 + 4);
+		z.store(out_records + i * 4 + 8);
+		alpha.store(out_records + i * 4 + 12);
+	}
+	return i;
+}
+
+void color_manipulation::conversion_plan::execute(float* components) const
+{
+	precision::dispatch(m_precision, [&](auto policy) { execute_steps<decltype(policy)::value>(m_steps, components); });
+}
+
+void color_manipulation::conversion_plan::execute(double* components) const
+{
+	precision::dispatch(m_precision, [&](auto policy) { execute_steps<decltype(policy)::value>(m_steps, components); });
+}
+
+color_space::color_base* color_manipulation::conversion_plan::apply(const color_space::color_base* color) const
+{
+	if (color == nullptr) throw new std::invalid_argument("color is null.");
+	if (color->get_color_type() != m_in_type) throw new std::invalid_argument("The color does not have the input type of the plan.");
+
+	auto components = color->get_component_vector();
+	float record[4] = { components[0], components[1], components[2], color->alpha() };
+	apply(record, record, 1);
+	return color_manipulation::stream_converter::create_color(m_out_type, record, m_out_space);
+}
+
+void color_manipulation::conversion_plan::apply(const float* in_records, float* out_records, size_t color_count, executor* exec) const
+{
+	run(color_count, in_records, out_records, exec, [&](size_t begin, size_t end)
+	{
+		convert_records(in_records + begin * 4, out_records + begin * 4, end - begin);
+	});
+}
+
+void color_manipulation::conversion_plan::apply(const double* in_records, double* out_records, size_t color_count, executor* exec) const
+{
+	run(color_count, in_records, out_records, exec, [&](size_t begin, size_t end)
+	{
+		convert_records(in_records + begin * 4, out_records + begin * 4, end - begin);
+	});
+}
+
+void color_manipulation::conversion_plan::apply(const half* in_records, half* out_records, size_t color_count, executor* exec) const
+{
+	run(color_count, in_records, out_records, exec, [&](size_t begin, size_t end)
+	{
+		// Convert in blocks that stay in the cache, only the caller's buffers are half sized
+		const size_t block_size = 256;
+		float block[block_size * 4];
+		for (size_t first = begin; first < end; first += block_size)
+		{
+			size_t count = std::min(block_size, end - first);
+			half::unpack(in_records + first * 4, block, count * 4);
+			convert_records(block, block, count);
+			half::pack(block, out_records + first * 4, count * 4);
+		}
+	});
+}
+
+void color_manipulation::conversion_plan::apply(const pixel_view& in_pixels, float* out_records, executor* exec) const
+{
+	float in_max = pixel_max(m_in_type);
+	run(in_pixels.size(), in_pixels.plane(0), out_records, exec, [&](size_t begin, size_t end)
+	{
+		in_pixels.unpack(begin, end - begin, out_records + begin * 4, in_max);
+		convert_records(out_records + begin * 4, out_records + begin * 4, end - begin);
+	});
+}
+
+void color_manipulation::conversion_plan::apply(const float* in_records, const mutable_pixel_view& out_pixels, executor* exec) const
+{
+	float out_max = pixel_max(m_out_type);
+	run(out_pixels.size(), in_records, out_pixels.plane(0), exec, [&](size_t begin, size_t end)
+	{
+		const size_t block_size = 256;
+		float block[block_size * 4];
+		for (size_t first = begin; first < end; first += block_size)
+		{
+			size_t count = std::min(block_size, end - first);
+			convert_records(in_records + first * 4, block, count);
+			out_pixels.pack(first, count, block, out_max);
+		}
+	});
+}
+
+void color_manipulation::conversion_plan::apply(const pixel_view& in_pixels, const mutable_pixel_view& out_pixels, executor* exec) const
+{
+	float in_max = pixel_max(m_in_type);
+	float out_max = pixel_max(m_out_type);
+	if (in_pixels.size() != out_pixels.size()) throw new std::invalid_argument("The views contain different numbers of pixels.");
+
+	run(in_pixels.size(), in_pixels.plane(0), out_pixels.plane(0), exec, [&](size_t begin, size_t end)
+	{
+		// Convert in blocks that stay in the cache, the pixels are read and written in place
+		const size_t block_size = 256;
+		float block[block_size * 4];
+		for (size_t first = begin; first < end; first += block_size)
+		{
+			size_t count = std::min(block_size, end - first);
+			in_pixels.unpack(first, count, block, in_max);
+			convert_records(block, block, count);
+			out_pixels.pack(first, count, block, out_max);
+		}
+	});
+}
+
+template <typename T> void color_manipulation::conversion_plan::convert_records(const T* in_records, T* out_records, size_t color_count) const
+{
+	precision::dispatch(m_precision, [&](auto policy) { convert_records_with<decltype(policy)::value>(in_records, out_records, color_count); });
+}
+
+void color_manipulation::conversion_plan::convert_records(const float* in_records, float* out_records, size_t color_count) const
+{
+	precision::dispatch(m_precision, [&](auto policy)
+	{
+		// The records that do not fill a block of four are left to the scalar steps
+		size_t i = convert_blocks<decltype(policy)::value>(m_steps, in_records, out_records, color_count, m_alpha_scale, m_out_type == color_type::RGB_TRUE);
+		convert_records_with<decltype(policy)::value>(in_records + i * 4, out_records + i * 4, color_count - i);
+	});
+}
+
+template <precision_policy Policy, typename T> void color_manipulation::conversion_plan::convert_records_with(const T* in_records, T* out_records, size_t color_count) const
+{
+	for (size_t i = 0; i < color_count; ++i)
+	{
+		T components[3] = { in_records[i * 4], in_records[i * 4 + 1], in_records[i * 4 + 2] };
+		T alpha = in_records[i * 4 + 3] * T(m_alpha_scale);
+		execute_steps<Policy>(m_steps, components);
+
+		T* out = out_records + i * 4;
+		out[0] = components[0];
+		out[1] = components[1];
+		out[2] = components[2];
+		out[3] = m_out_type == color_type::RGB_TRUE ? std::round(alpha) : alpha;
+	}
+}
+
+float color_manipulation::conversion_plan::pixel_max(color_type type)
+{
+	if (type == color_type::RGB_TRUE) return 255.f;
+	if (type == color_type::RGB_DEEP) return 1.f;
+	throw new std::invalid_argument("Pixel views can only be converted from or to rgb colors.");
+}
+
+template <typename Function> void color_manipulation::conversion_plan::run(size_t color_count, const void* in, const void* out, executor* exec, Function convert_range) const
+{
+	if (color_count == 0) return;
+	if (in == nullptr || out == nullptr) throw new std::invalid_argument("buffer is null.");
+
+	// Single colors are not worth a task
+	if (color_count == 1)
+	{
+		convert_range(0, 1);
+		return;
+	}
+
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, color_count, convert_range, 4096);
+}
+
+void color_manipulation::conversion_plan::add_steps_to_xyz(color_type type, color_space::rgb_color_space_definition* color_space)
+{
+	auto white = color_space->get_white_point();
+	switch (type)
+	{
+	case color_type::RGB_TRUE:
+		add_affine(create_scale(1.f / 255.f, 1.f / 255.f, 1.f / 255.f));
+		// fall through
+	case color_type::RGB_DEEP:
+		add_step(plan_step_type::DECODE_GAMMA, color_space->get_gamma_curve());
+		add_affine(create_affine(color_space->get_transform_matrix()));
+		break;
+	case color_type::XYY:
+		add_step(plan_step_type::XYY_TO_XYZ);
+		break;
+	case color_type::LCH_AB:
+		add_step(plan_step_type::LCH_TO_LAB);
+		// fall through
+	case color_type::LAB:
+		// L*, a*, b* -> f(x), f(y), f(z)
+		add_affine({
+			1.f / 116.f, 1.f / 500.f, 0.f, 16.f / 116.f,
+			1.f / 116.f, 0.f, 0.f, 16.f / 116.f,
+			1.f / 116.f, 0.f, -1.f / 200.f, 16.f / 116.f });
+		add_step(plan_step_type::LAB_EXPAND);
+		add_affine(create_scale(white->get_tristimulus_x(), white->get_tristimulus_y(), white->get_tristimulus_z()));
+		break;
+	default:
+		break;
+	}
+}
+
+void color_manipulation::conversion_plan::add_steps_from_xyz(color_type type, color_space::rgb_color_space_definition* color_space)
+{
+	auto white = color_space->get_white_point();
+	switch (type)
+	{
+	case color_type::RGB_TRUE:
+	case color_type::RGB_DEEP:
+		add_affine(create_affine(color_space->get_inverse_transform_matrix()));
+		add_step(plan_step_type::ENCODE_GAMMA, color_space->get_gamma_curve());
+		if (type == color_type::RGB_TRUE)
+		{
+			add_affine(create_scale(255.f, 255.f, 255.f));
+			add_step(plan_step_type::ROUND);
+		}
+		break;
+	case color_type::XYY:
+		add_step(plan_step_type::XYZ_TO_XYY);
+		m_steps.back().values[0] = white->get_chromaticity_x();
+		m_steps.back().values[1] = white->get_chromaticity_y();
+		break;
+	case color_type::LAB:
+	case color_type::LCH_AB:
+		add_affine(create_scale(1.f / white->get_tristimulus_x(), 1.f / white->get_tristimulus_y(), 1.f / white->get_tristimulus_z()));
+		add_step(plan_step_type::LAB_COMPAND);
+		// f(x), f(y), f(z) -> L*, a*, b*
+		add_affine({
+			0.f, 116.f, 0.f, -16.f,
+			500.f, -500.f, 0.f, 0.f,
+			0.f, 200.f, -200.f, 0.f });
+		if (type == color_type::LCH_AB) add_step(plan_step_type::LAB_TO_LCH);
+		break;
+	default:
+		break;
+	}
+}
+
+void color_manipulation::conversion_plan::add_affine(const std::array<float, 12>& transformation)
+{
+	if (m_steps.empty() || m_steps.back().type != plan_step_type::AFFINE)
+	{
+		m_steps.push_back({ plan_step_type::AFFINE, transformation, nullptr });
+		return;
+	}
+
+	// Combine with the previous step: new(previous(v)) = N * (P * v + p) + n
+	const std::array<float, 12> previous = m_steps.back().values;
+	std::array<float, 12>& combined = m_steps.back().values;
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int column = 0; column < 4; ++column)
+		{
+			float sum = column == 3 ? transformation[row * 4 + 3] : 0.f;
+			for (int k = 0; k < 3; ++k) sum += transformation[row * 4 + k] * previous[k * 4 + column];
+			combined[row * 4 + column] = sum;
+		}
+	}
+}
+
+void color_manipulation::conversion_plan::add_step(plan_step_type type, color_space::gamma* curve)
+{
+	m_steps.push_back({ type, std::array<float, 12>(), curve });
+}
+
+std::array<float, 12> color_manipulation::conversion_plan::create_affine(matrix<float> transformation, std::array<float, 3> offset)
+{
+	std::array<float, 12> result;
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int column = 0; column < 3; ++column) result[row * 4 + column] = transformation(row, column);
+		result[row * 4 + 3] = offset[row];
+	}
+	return result;
+}
+
+std::array<float, 12> color_manipulation::conversion_plan::create_scale(float x, float y, float z)
+{
+	return { x, 0.f, 0.f, 0.f, 0.f, y, 0.f, 0.f, 0.f, 0.f, z, 0.f };
+}
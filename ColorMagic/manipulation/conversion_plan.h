@@ -0,0 +1,235 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../utils/executor.h"
+#include "../utils/half.h"
+#include "../utils/pixel_view.h"
+#include "../utils/precision.h"
+#include "../spaces/color_base.h"
+#include "../spaces/gamma.h"
+#include "../spaces/rgb_color_space_definition.h"
+#include "chromatic_adaptation.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Enum that defines the kinds of steps a conversion_plan consists of.
+	enum plan_step_type
+	{
+		AFFINE = 0, /*!< AFFINE - multiplies with a 3x3 matrix and adds an offset, consecutive affine steps are merged into one */
+		DECODE_GAMMA, /*!< DECODE_GAMMA - clamps to [0,1], applies the inverse gamma curve and clamps again */
+		ENCODE_GAMMA, /*!< ENCODE_GAMMA - clamps to [0,1] and applies the gamma curve */
+		LAB_COMPAND, /*!< LAB_COMPAND - the cube root function of the xyz to lab conversion */
+		LAB_EXPAND, /*!< LAB_EXPAND - the inverse of LAB_COMPAND */
+		XYZ_TO_XYY, /*!< XYZ_TO_XYY - projects xyz to chromaticity coordinates */
+		XYY_TO_XYZ, /*!< XYY_TO_XYZ - the inverse of XYZ_TO_XYY */
+		LAB_TO_LCH, /*!< LAB_TO_LCH - converts a* and b* to chroma and hue */
+		LCH_TO_LAB, /*!< LCH_TO_LAB - converts chroma and hue to a* and b* */
+		ROUND /*!< ROUND - rounds all components to integers */
+	};
+
+	//! Precomputed sequence of arithmetic steps that converts colors between two color types and rgb color spaces.
+	/*!
+	* Conversions between the colorimetric color types are chains of linear maps with a few nonlinear steps in
+	* between, e.g. rgb (gamma) -> rgb (linear) -> xyz -> adapted xyz -> rgb (linear) of another color space ->
+	* rgb (gamma). A plan builds this chain once and multiplies all consecutive linear steps into a single affine
+	* matrix, so a conversion costs one matrix product per run of linear steps and no allocations.
+	*
+	* Supported color types are RGB_TRUE, RGB_DEEP, XYZ, XYY, LAB and LCH_AB. The input and output color space
+	* may differ, the white points are then adapted with the given method. Intermediate results are not clamped
+	* to the ranges of the intermediate color classes, so colors outside the gamut can differ from the chained
+	* color_converter functions. Plans are immutable and can be shared between threads. The rgb color space
+	* definitions must outlive the plan and must not be modified.
+	*
+	* The precision policy selects the math of the nonlinear steps, see precision_math. It is fixed when the plan is
+	* built, so the kernels are instantiated per policy and do not check it per color.
+	*/
+	class conversion_plan
+	{
+	public:
+		//! A single step of a plan.
+		struct step
+		{
+			plan_step_type type; /*!< The kind of the step */
+			std::array<float, 12> values; /*!< Row major 3x4 matrix for AFFINE steps, white chromaticity (x, y) for XYZ_TO_XYY */
+			color_space::gamma* curve; /*!< Gamma curve for DECODE_GAMMA and ENCODE_GAMMA steps */
+		};
+
+		//! Default constructor.
+		/*!
+		* Builds the plan.
+		* \param in_type The color type of the input colors.
+		* \param in_space The rgb color space definition of the input colors.
+		* \param out_type The color type of the output colors.
+		* \param out_space The rgb color space definition of the output colors.
+		* \param method The chromatic adaptation method that is used if the white points differ.
+		* \param policy The precision of the nonlinear steps. FASTEST compiles the gamma tables of both color spaces.
+		*/
+		conversion_plan(color_type in_type, color_space::rgb_color_space_definition* in_space, color_type out_type, color_space::rgb_color_space_definition* out_space, adaptation_method method = BRADFORD, precision_policy policy = EXACT);
+
+		//! Returns a shared plan for the given conversion. Plans are built on first use and reused afterwards.
+		/*!
+		* Plans are cached per generation of the rgb color space definitions, so a changed definition gets a new plan.
+		* Plans of older generations of a definition are removed from the cache when the new plan is built. Plans that
+		* were returned earlier keep pointing to the definitions, so they must not be used after a definition is deleted.
+		* \param in_type The color type of the input colors.
+		* \param in_space The rgb color space definition of the input colors.
+		* \param out_type The color type of the output colors.
+		* \param out_space The rgb color space definition of the output colors.
+		* \param method The chromatic adaptation method that is used if the white points differ.
+		* \param policy The precision of the nonlinear steps. Plans of different policies are cached separately.
+		* \return The plan.
+		*/
+		static std::shared_ptr<const conversion_plan> get(color_type in_type, color_space::rgb_color_space_definition* in_space, color_type out_type, color_space::rgb_color_space_definition* out_space, adaptation_method method = BRADFORD, precision_policy policy = EXACT);
+
+		//! Removes all plans that were created by get().
+		static void clear_cache();
+
+		//! Returns whether the given color type can be used as input or output type of a plan.
+		static bool is_supported(color_type type);
+
+		//! Returns the color type of the input colors.
+		color_type get_input_type() const { return m_in_type; }
+
+		//! Returns the color type of the output colors.
+		color_type get_output_type() const { return m_out_type; }
+
+		//! Returns the rgb color space definition of the output colors.
+		color_space::rgb_color_space_definition* get_output_color_space() const { return m_out_space; }
+
+		//! Returns the precision policy of the nonlinear steps.
+		precision_policy get_precision() const { return m_precision; }
+
+		//! Returns the steps of the plan.
+		const std::vector<step>& get_steps() const { return m_steps; }
+
+		//! Runs all steps on the three components of one color.
+		void execute(float* components) const;
+
+		//! Runs all steps on the three components of one color in double precision.
+		/*!
+		* The gamma curves are evaluated in float, all other steps in double.
+		*/
+		void execute(double* components) const;
+
+		//! Converts a single color.
+		/*!
+		* \param color The color to convert. Has to be of the input type of the plan.
+		* \return The converted color in the output color space.
+		*/
+		color_space::color_base* apply(const color_space::color_base* color) const;
+
+		//! Converts a buffer of color records.
+		/*!
+		* Each record consists of 4 floats: the three components and alpha, like the records of the stream_converter.
+		* \param in_records The input records.
+		* \param out_records The output records. May be the same like in_records.
+		* \param color_count The number of records.
+		* \param exec The executor that processes the records. If null the default thread pool is used.
+		*/
+		void apply(const float* in_records, float* out_records, size_t color_count, executor* exec = nullptr) const;
+
+		//! Converts a buffer of double precision color records. Same like the float version.
+		void apply(const double* in_records, double* out_records, size_t color_count, executor* exec = nullptr) const;
+
+		//! Converts a buffer of half precision color records.
+		/*!
+		* The records are unpacked to float in small blocks, converted in float and packed again. Only the buffers
+		* are half sized, which halves the memory traffic of large images.
+		* \param in_records The input records.
+		* \param out_records The output records. May be the same like in_records.
+		* \param color_count The number of records.
+		* \param exec The executor that processes the records. If null the default thread pool is used.
+		*/
+		void apply(const half* in_records, half* out_records, size_t color_count, executor* exec = nullptr) const;
+
+		//! Converts the pixels of a view to color records.
+		/*!
+		* The input type of the plan has to be RGB_TRUE or RGB_DEEP. The pixels are read directly from the caller's
+		* memory, there is no intermediate copy of the whole image.
+		* \param in_pixels The input pixels.
+		* \param out_records The output records, 4 floats per pixel.
+		* \param exec The executor that processes the pixels. If null the default thread pool is used.
+		*/
+		void apply(const pixel_view& in_pixels, float* out_records, executor* exec = nullptr) const;
+
+		//! Converts color records to the pixels of a view.
+		/*!
+		* The output type of the plan has to be RGB_TRUE or RGB_DEEP. Components are clamped and rounded to bytes.
+		* \param in_records The input records, 4 floats per pixel.
+		* \param out_pixels The output pixels.
+		* \param exec The executor that processes the pixels. If null the default thread pool is used.
+		*/
+		void apply(const float* in_records, const mutable_pixel_view& out_pixels, executor* exec = nullptr) const;
+
+		//! Converts the pixels of one view to the pixels of another one.
+		/*!
+		* Input and output type of the plan have to be RGB_TRUE or RGB_DEEP, e.g. to convert an image from one rgb
+		* color space to another. The views may have different layouts and may even view the same memory.
+		* \param in_pixels The input pixels.
+		* \param out_pixels The output pixels. Must contain as many pixels as in_pixels.
+		* \param exec The executor that processes the pixels. If null the default thread pool is used.
+		*/
+		void apply(const pixel_view& in_pixels, const mutable_pixel_view& out_pixels, executor* exec = nullptr) const;
+
+	protected:
+		//! Converts consecutive records in the precision of T.
+		template <typename T> void convert_records(const T* in_records, T* out_records, size_t color_count) const;
+
+		//! Converts consecutive float records, in blocks of four with the vectorized steps if the policy is not EXACT.
+		void convert_records(const float* in_records, float* out_records, size_t color_count) const;
+
+		//! Converts consecutive records one by one in the precision of T with the scalar steps of the given policy.
+		template <precision_policy Policy, typename T> void convert_records_with(const T* in_records, T* out_records, size_t color_count) const;
+
+		//! Checks the input and output memory and runs convert_range on the executor.
+		template <typename Function> void run(size_t color_count, const void* in, const void* out, executor* exec, Function convert_range) const;
+
+		//! Returns the value of a component of 255 in records of the given rgb type. Throws for other types.
+		static float pixel_max(color_type type);
+
+		//! Adds the steps that convert the input type to xyz of the given color space.
+		void add_steps_to_xyz(color_type type, color_space::rgb_color_space_definition* color_space);
+
+		//! Adds the steps that convert xyz of the given color space to the output type.
+		void add_steps_from_xyz(color_type type, color_space::rgb_color_space_definition* color_space);
+
+		//! Adds an affine step or multiplies it into the previous step if that is affine as well.
+		void add_affine(const std::array<float, 12>& transformation);
+
+		//! Adds a step without matrix.
+		void add_step(plan_step_type type, color_space::gamma* curve = nullptr);
+
+		//! Creates an affine transformation from a 3x3 matrix and an offset.
+		static std::array<float, 12> create_affine(matrix<float> transformation, std::array<float, 3> offset = { 0.f, 0.f, 0.f });
+
+		//! Creates an affine transformation that scales each component.
+		static std::array<float, 12> create_scale(float x, float y, float z);
+
+		//! Color type of the input colors.
+		color_type m_in_type;
+
+		//! Color type of the output colors.
+		color_type m_out_type;
+
+		//! rgb color space definition of the output colors.
+		color_space::rgb_color_space_definition* m_out_space;
+
+		//! Precision policy of the nonlinear steps.
+		precision_policy m_precision;
+
+		//! Factor that converts the alpha range of the input type to the one of the output type.
+		float m_alpha_scale;
+
+		//! The steps of the plan.
+		std::vector<step> m_steps;
+	};
+}
@@ -0,0 +1,261 @@
+#include "stdafx.h"
+#include "lab_table.h"
+#include "color_converter.h"
+#include "conversion_plan.h"
+#include "../utils/half.h"
+#include "../utils/thread_pool.h"
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Layout of a table file: magic, version, format, fingerprint and then all entries. The header is 128 bytes long
+// so that the entries are aligned.
+static const char lab_table_magic[8] = { 'C', 'M', 'L', 'A', 'B', 'T', 'B', 'L' };
+static const uint32_t lab_table_version = 1;
+static const size_t lab_table_header_size = 128;
+static const size_t lab_table_data_size = color_manipulation::lab_table::entry_count * 3 * sizeof(uint16_t);
+
+std::shared_ptr<const color_manipulation::lab_table> color_manipulation::lab_table::s_active;
+
+color_manipulation::lab_table::lab_table(lab_table_format format)
+	: m_format(format), m_fingerprint(), m_data(nullptr), m_mapped_view(nullptr), m_mapped_size(0), m_last_match(0), m_last_mismatch(0)
+{
+}
+
+color_manipulation::lab_table::~lab_table()
+{
+	if (m_mapped_view == nullptr) return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_mapped_view);
+#else
+	munmap(m_mapped_view, m_mapped_size);
+#endif
+}
+
+color_manipulation::lab_table* color_manipulation::lab_table::generate(color_space::rgb_color_space_definition* color_space, lab_table_format format, executor* exec)
+{
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+
+	std::unique_ptr<lab_table> table(new lab_table(format));
+	table->m_fingerprint = create_fingerprint(color_space);
+	table->m_owned_data.resize(entry_count * 3);
+	table->m_data = table->m_owned_data.data();
+	table->m_last_match = color_space->get_generation();
+
+	// XYZ is linear in the linearized rgb components, so the XYZ value of every color is the sum of the
+	// contributions of its three components. Only the XYZ to Lab step has to be done per entry, with a plan
+	// that does not create color objects.
+	std::array<std::array<std::array<float, 3>, 256>, 3> contributions;
+	std::array<float, 3> black;
+	{
+		color_space::rgb_deepcolor black_color(0.f, 0.f, 0.f, 1.f, color_space);
+		std::unique_ptr<color_space::xyz> black_xyz(color_manipulation::color_converter::to_xyz(&black_color));
+		black = { black_xyz->x(), black_xyz->y(), black_xyz->z() };
+
+		for (int value = 0; value < 256; ++value)
+		{
+			for (int channel = 0; channel < 3; ++channel)
+			{
+				float components[3] = { 0.f, 0.f, 0.f };
+				components[channel] = value / 255.f;
+				color_space::rgb_deepcolor color(components[0], components[1], components[2], 1.f, color_space);
+				std::unique_ptr<color_space::xyz> xyz(color_manipulation::color_converter::to_xyz(&color));
+				contributions[channel][value] = { xyz->x() - black[0], xyz->y() - black[1], xyz->z() - black[2] };
+			}
+		}
+	}
+
+	const conversion_plan to_lab(color_type::XYZ, color_space, color_type::LAB, color_space);
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	uint16_t* entries = table->m_owned_data.data();
+	runner->parallel_for(0, entry_count, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			auto& red = contributions[0][(i >> 16) & 0xFF];
+			auto& green = contributions[1][(i >> 8) & 0xFF];
+			auto& blue = contributions[2][i & 0xFF];
+
+			float lab[3] = { black[0] + red[0] + green[0] + blue[0], black[1] + red[1] + green[1] + blue[1], black[2] + red[2] + green[2] + blue[2] };
+			to_lab.execute(lab);
+
+			uint16_t* entry = entries + i * 3;
+			if (format == FLOAT16)
+			{
+				entry[0] = half::from_float(lab[0]);
+				entry[1] = half::from_float(lab[1]);
+				entry[2] = half::from_float(lab[2]);
+			}
+			else
+			{
+				entry[0] = (uint16_t)(int16_t)std::round(std::min(std::max(lab[0] * 327.67f, -32768.f), 32767.f));
+				entry[1] = (uint16_t)(int16_t)std::round(std::min(std::max(lab[1] * 256.f, -32768.f), 32767.f));
+				entry[2] = (uint16_t)(int16_t)std::round(std::min(std::max(lab[2] * 256.f, -32768.f), 32767.f));
+			}
+		}
+	}, 65536);
+
+	return table.release();
+}
+
+color_manipulation::lab_table* color_manipulation::lab_table::load(const std::string& path)
+{
+	void* view = nullptr;
+	size_t size = 0;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) throw new std::invalid_argument("The table file could not be opened.");
+
+	LARGE_INTEGER file_size;
+	if (GetFileSizeEx(file, &file_size)) size = (size_t)file_size.QuadPart;
+
+	HANDLE mapping = size > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	if (mapping != nullptr)
+	{
+		view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+	}
+	CloseHandle(file);
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) throw new std::invalid_argument("The table file could not be opened.");
+
+	struct stat file_info;
+	if (fstat(file, &file_info) == 0) size = (size_t)file_info.st_size;
+
+	if (size > 0)
+	{
+		view = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+		if (view == MAP_FAILED) view = nullptr;
+	}
+	close(file);
+#endif
+
+	if (view == nullptr) throw new std::invalid_argument("The table file could not be mapped into memory.");
+
+	std::unique_ptr<lab_table> table(new lab_table(INT16));
+	table->m_mapped_view = view;
+	table->m_mapped_size = size;
+
+	const char* bytes = static_cast<const char*>(view);
+	uint32_t version = 0;
+	uint32_t format = 0;
+	if (size >= lab_table_header_size)
+	{
+		std::memcpy(&version, bytes + 8, sizeof(uint32_t));
+		std::memcpy(&format, bytes + 12, sizeof(uint32_t));
+	}
+
+	if (size != lab_table_header_size + lab_table_data_size || std::memcmp(bytes, lab_table_magic, 8) != 0 || version != lab_table_version || format > FLOAT16)
+	{
+		throw new std::invalid_argument("The file is not a valid Lab table.");
+	}
+
+	table->m_format = (lab_table_format)format;
+	std::memcpy(table->m_fingerprint.data(), bytes + 16, fingerprint_size * sizeof(float));
+	table->m_data = reinterpret_cast<const uint16_t*>(bytes + lab_table_header_size);
+	return table.release();
+}
+
+void color_manipulation::lab_table::save(const std::string& path) const
+{
+	char header[lab_table_header_size] = {};
+	uint32_t format = (uint32_t)m_format;
+	std::memcpy(header, lab_table_magic, 8);
+	std::memcpy(header + 8, &lab_table_version, sizeof(uint32_t));
+	std::memcpy(header + 12, &format, sizeof(uint32_t));
+	std::memcpy(header + 16, m_fingerprint.data(), fingerprint_size * sizeof(float));
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(header, lab_table_header_size);
+	file.write(reinterpret_cast<const char*>(m_data), lab_table_data_size);
+	if (!file) throw new std::invalid_argument("Writing the table file failed.");
+}
+
+bool color_manipulation::lab_table::matches(color_space::rgb_color_space_definition* color_space) const
+{
+	if (color_space == nullptr) return false;
+
+	// Generations are never reused, so a changed definition or a new one at the same address is compared again
+	uint64_t generation = color_space->get_generation();
+	if (generation == m_last_match.load(std::memory_order_relaxed)) return true;
+	if (generation == m_last_mismatch.load(std::memory_order_relaxed)) return false;
+
+	auto fingerprint = create_fingerprint(color_space);
+	for (size_t i = 0; i < fingerprint_size; ++i)
+	{
+		if (fabsf(fingerprint[i] - m_fingerprint[i]) > 1e-6f)
+		{
+			m_last_mismatch.store(generation, std::memory_order_relaxed);
+			return false;
+		}
+	}
+
+	m_last_match.store(generation, std::memory_order_relaxed);
+	return true;
+}
+
+std::array<float, 3> color_manipulation::lab_table::lookup(uint8_t red, uint8_t green, uint8_t blue) const
+{
+	const uint16_t* entry = m_data + (((size_t)red << 16) | ((size_t)green << 8) | blue) * 3;
+	if (m_format == FLOAT16)
+	{
+		return { half::to_float(entry[0]), half::to_float(entry[1]), half::to_float(entry[2]) };
+	}
+	return { (int16_t)entry[0] / 327.67f, (int16_t)entry[1] / 256.f, (int16_t)entry[2] / 256.f };
+}
+
+color_space::lab* color_manipulation::lab_table::lookup(const color_space::rgb_truecolor* color) const
+{
+	float red = color->red();
+	float green = color->green();
+	float blue = color->blue();
+	if (red != (float)(int)red || green != (float)(int)green || blue != (float)(int)blue) return nullptr;
+	if (red < 0.f || red > 255.f || green < 0.f || green > 255.f || blue < 0.f || blue > 255.f) return nullptr;
+
+	auto lab = lookup((uint8_t)red, (uint8_t)green, (uint8_t)blue);
+	return new color_space::lab(lab[0], lab[1], lab[2], color->alpha() / 255.f, color->get_rgb_color_space());
+}
+
+void color_manipulation::lab_table::set_active(std::shared_ptr<const lab_table> table)
+{
+	std::atomic_store(&s_active, std::move(table));
+}
+
+std::shared_ptr<const color_manipulation::lab_table> color_manipulation::lab_table::get_active()
+{
+	return std::atomic_load(&s_active);
+}
+
+std::array<float, color_manipulation::lab_table::fingerprint_size> color_manipulation::lab_table::create_fingerprint(color_space::rgb_color_space_definition* color_space)
+{
+	std::array<float, fingerprint_size> fingerprint;
+	auto transform = color_space->get_transform_matrix();
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int column = 0; column < 3; ++column) fingerprint[row * 3 + column] = transform(row, column);
+	}
+
+	auto white = color_space->get_white_point();
+	fingerprint[9] = white->get_tristimulus_x();
+	fingerprint[10] = white->get_tristimulus_y();
+	fingerprint[11] = white->get_tristimulus_z();
+
+	auto curve = color_space->get_gamma_curve();
+	for (size_t i = 0; i < 16; ++i) fingerprint[12 + i] = curve->inverse_gamma_correction(i / 15.f);
+
+	return fingerprint;
+}
+
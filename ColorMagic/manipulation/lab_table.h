@@ -0,0 +1,146 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/executor.h"
+#include "../spaces/lab.h"
+#include "../spaces/rgb_truecolor.h"
+#include "../spaces/rgb_color_space_definition.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Enum that defines how the entries of a lab_table are stored.
+	enum lab_table_format
+	{
+		INT16 = 0, /*!< INT16 - fixed point values, L* with a step of 1/327.67 and a*, b* with a step of 1/256 */
+		FLOAT16 /*!< FLOAT16 - IEEE 754 half precision values, finer near 0 and coarser for large values */
+	};
+
+	//! Precomputed Lab values of all 2^24 rgb truecolors of one rgb color space.
+	/*!
+	* Each entry stores L*, a* and b* as three 16 bit values, so a table needs 96 MiB. Generating it takes a few
+	* seconds, so the intended use is to generate the table once, save it to a file and map that file into memory
+	* at startup. Only the pages that are actually touched are read from disk.
+	*
+	* If a table is set as the active table, the color_converter uses it for all rgb truecolor to Lab conversions
+	* (and thereby for LCh(ab) conversions and the CIE delta E distances) whose color space matches the table and
+	* whose components are integers. All other inputs fall back to the exact calculation.
+	*/
+	class lab_table
+	{
+	public:
+		//! Number of entries (one per 24 bit rgb color).
+		static const size_t entry_count = (size_t)1 << 24;
+
+		//! Releases the table data or unmaps the file.
+		~lab_table();
+
+		lab_table(const lab_table&) = delete;
+		lab_table& operator=(const lab_table&) = delete;
+
+		//! Calculates a new table for the given color space.
+		/*!
+		* \param color_space The rgb color space definition of the rgb colors.
+		* \param format The storage format of the entries.
+		* \param exec The executor that runs the calculation. If null the default thread pool is used.
+		* \return The new table.
+		*/
+		static lab_table* generate(color_space::rgb_color_space_definition* color_space, lab_table_format format = INT16, executor* exec = nullptr);
+
+		//! Maps a table file created by save() into memory.
+		/*!
+		* The file is mapped read-only and must not be changed while the table exists. The returned table is not
+		* bound to a rgb color space definition object, matches() compares the stored fingerprint instead.
+		* \param path The path of the table file.
+		* \return The mapped table.
+		*/
+		static lab_table* load(const std::string& path);
+
+		//! Writes the table to a file.
+		/*!
+		* \param path The path of the table file. An existing file is overwritten.
+		*/
+		void save(const std::string& path) const;
+
+		//! Returns the storage format of the entries.
+		lab_table_format get_format() const { return m_format; }
+
+		//! Returns whether the table was calculated for the given color space.
+		/*!
+		* Two definitions match if their transformation matrices, white points and gamma curves are equal. The
+		* generations of the last matching and the last not matching definition are remembered, so the comparison
+		* only runs again if another definition is passed or the definition changed since the last call.
+		* \param color_space The rgb color space definition to check.
+		* \return True if the table can be used for colors of the given color space.
+		*/
+		bool matches(color_space::rgb_color_space_definition* color_space) const;
+
+		//! Returns the Lab values of the given 8 bit rgb values.
+		std::array<float, 3> lookup(uint8_t red, uint8_t green, uint8_t blue) const;
+
+		//! Returns the Lab color of the given rgb truecolor.
+		/*!
+		* The color space is not checked, see matches().
+		* \param color The rgb truecolor to look up.
+		* \return The Lab color or null if one of the rgb components is not an integer in the range [0,255].
+		*/
+		color_space::lab* lookup(const color_space::rgb_truecolor* color) const;
+
+		//! Sets the table that is used by the color_converter. Null disables the lookup.
+		/*!
+		* The table can be replaced at any time: conversions that are running keep their own reference to the old
+		* table, so it is deleted (or unmapped) after the last of them is done.
+		* \param table The new active table.
+		*/
+		static void set_active(std::shared_ptr<const lab_table> table);
+
+		//! Returns the table that is used by the color_converter or null if none is set.
+		/*!
+		* The returned reference keeps the table alive even if another table is set in the meantime.
+		*/
+		static std::shared_ptr<const lab_table> get_active();
+
+	protected:
+		//! Number of floats that identify a rgb color space: transformation matrix, white point and 16 gamma samples.
+		static const size_t fingerprint_size = 28;
+
+		//! Creates an empty table. Either m_owned_data is filled or a file is mapped.
+		lab_table(lab_table_format format);
+
+		//! Calculates the fingerprint of the given color space.
+		static std::array<float, fingerprint_size> create_fingerprint(color_space::rgb_color_space_definition* color_space);
+
+		//! Storage format of the entries.
+		lab_table_format m_format;
+
+		//! Fingerprint of the color space the table was calculated for.
+		std::array<float, fingerprint_size> m_fingerprint;
+
+		//! Pointer to the first entry. Points into m_owned_data or into the mapped file.
+		const uint16_t* m_data;
+
+		//! Entries of a generated table.
+		std::vector<uint16_t> m_owned_data;
+
+		//! Start and size of the mapped file or null.
+		void* m_mapped_view;
+		size_t m_mapped_size;
+
+		//! Generations of the last rgb color space definitions that did or did not match. 0 if there is none.
+		mutable std::atomic<uint64_t> m_last_match;
+		mutable std::atomic<uint64_t> m_last_mismatch;
+
+		//! The table used by the color_converter. Only accessed with std::atomic_load() and std::atomic_store().
+		static std::shared_ptr<const lab_table> s_active;
+	};
+}
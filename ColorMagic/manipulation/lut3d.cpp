@@ -0,0 +1,252 @@
+#include "stdafx.h"
+#include "lut3d.h"
+#include "color_distance.h"
+#include "../utils/thread_pool.h"
+
+#include <memory>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define LUT3D_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+// Sums up the weighted grid points. Each grid point consists of 4 floats, only the first 3 are written to out.
+static inline void blend_nodes(const float* const* nodes, const float* weights, size_t count, float* out)
+{
+#ifdef LUT3D_USE_SSE
+	__m128 sum = _mm_mul_ps(_mm_loadu_ps(nodes[0]), _mm_set1_ps(weights[0]));
+	for (size_t i = 1; i < count; ++i)
+	{
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(nodes[i]), _mm_set1_ps(weights[i])));
+	}
+
+	float result[4];
+	_mm_storeu_ps(result, sum);
+	out[0] = result[0];
+	out[1] = result[1];
+	out[2] = result[2];
+#else
+	float sum[3] = { 0.f, 0.f, 0.f };
+	for (size_t i = 0; i < count; ++i)
+	{
+		sum[0] += nodes[i][0] * weights[i];
+		sum[1] += nodes[i][1] * weights[i];
+		sum[2] += nodes[i][2] * weights[i];
+	}
+	out[0] = sum[0];
+	out[1] = sum[1];
+	out[2] = sum[2];
+#endif
+}
+
+color_manipulation::lut3d::lut3d(size_t grid_size, color_space::rgb_color_space_definition* color_space)
+	: m_grid_size(grid_size), m_rgb_color_space(color_space), m_max_delta_e(0.f)
+{
+	if (grid_size < 2 || grid_size > 256) throw new std::invalid_argument("Parameter grid_size has to be in the range [2,256].");
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+
+	m_nodes.resize(grid_size * grid_size * grid_size * 4, 0.f);
+
+	float step = 1.f / (float)(grid_size - 1);
+	for (size_t blue = 0; blue < grid_size; ++blue)
+	{
+		for (size_t green = 0; green < grid_size; ++green)
+		{
+			for (size_t red = 0; red < grid_size; ++red)
+			{
+				set_node(red, green, blue, { red * step, green * step, blue * step });
+			}
+		}
+	}
+}
+
+color_manipulation::lut3d* color_manipulation::lut3d::bake(const std::vector<operation>& pipeline, color_space::rgb_color_space_definition* color_space, size_t grid_size, bool measure_error, executor* exec)
+{
+	for (auto& step : pipeline)
+	{
+		if (!step) throw new std::invalid_argument("pipeline contains an empty operation.");
+	}
+
+	std::unique_ptr<lut3d> table(new lut3d(grid_size, color_space));
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	float step = 1.f / (float)(grid_size - 1);
+
+	// Sample the pipeline at every grid point
+	runner->parallel_for(0, grid_size * grid_size * grid_size, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			size_t red = i % grid_size;
+			size_t green = (i / grid_size) % grid_size;
+			size_t blue = i / (grid_size * grid_size);
+			table->set_node(red, green, blue, evaluate(pipeline, red * step, green * step, blue * step, color_space));
+		}
+	});
+
+	if (!measure_error) return table.release();
+
+	// The interpolation error is largest far away from the grid points, so compare in the cell centers
+	size_t cells = grid_size - 1;
+	std::vector<float> errors(cells * cells * cells, 0.f);
+	runner->parallel_for(0, errors.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			float red = ((i % cells) + 0.5f) * step;
+			float green = (((i / cells) % cells) + 0.5f) * step;
+			float blue = ((i / (cells * cells)) + 0.5f) * step;
+
+			auto exact = evaluate(pipeline, red, green, blue, color_space);
+			auto interpolated = table->lookup(red, green, blue, TETRAHEDRAL);
+
+			color_space::rgb_deepcolor exact_color(exact[0], exact[1], exact[2], 1.f, color_space);
+			color_space::rgb_deepcolor interpolated_color(interpolated[0], interpolated[1], interpolated[2], 1.f, color_space);
+			errors[i] = color_manipulation::color_distance::cielab_delta_e_cie00(&exact_color, &interpolated_color, EXACT);
+		}
+	});
+	table->m_max_delta_e = *std::max_element(errors.begin(), errors.end());
+
+	return table.release();
+}
+
+std::array<float, 3> color_manipulation::lut3d::get_node(size_t red, size_t green, size_t blue) const
+{
+	if (red >= m_grid_size || green >= m_grid_size || blue >= m_grid_size) throw new std::out_of_range("Grid point index out of range.");
+
+	const float* node = &m_nodes[node_offset(red, green, blue)];
+	return { node[0], node[1], node[2] };
+}
+
+void color_manipulation::lut3d::set_node(size_t red, size_t green, size_t blue, std::array<float, 3> value)
+{
+	if (red >= m_grid_size || green >= m_grid_size || blue >= m_grid_size) throw new std::out_of_range("Grid point index out of range.");
+
+	float* node = &m_nodes[node_offset(red, green, blue)];
+	node[0] = value[0];
+	node[1] = value[1];
+	node[2] = value[2];
+}
+
+std::array<float, 3> color_manipulation::lut3d::lookup(float red, float green, float blue, lut_interpolation interpolation) const
+{
+	float in[3] = { red, green, blue };
+	std::array<float, 3> out;
+	lookup(in, out.data(), interpolation);
+	return out;
+}
+
+color_space::rgb_deepcolor* color_manipulation::lut3d::apply(const color_space::color_base* color, lut_interpolation interpolation) const
+{
+	if (color == nullptr) throw new std::invalid_argument("color is null.");
+
+	std::unique_ptr<color_space::rgb_deepcolor> rgb(color_manipulation::color_converter::to_rgb_deep(color));
+	auto result = lookup(rgb->red(), rgb->green(), rgb->blue(), interpolation);
+	return new color_space::rgb_deepcolor(result[0], result[1], result[2], rgb->alpha(), m_rgb_color_space);
+}
+
+void color_manipulation::lut3d::apply(const float* in_rgb, float* out_rgb, size_t pixel_count, lut_interpolation interpolation, executor* exec) const
+{
+	if (pixel_count == 0) return;
+	if (in_rgb == nullptr || out_rgb == nullptr) throw new std::invalid_argument("buffer is null.");
+
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, pixel_count, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			lookup(in_rgb + i * 3, out_rgb + i * 3, interpolation);
+		}
+	}, 4096);
+}
+
+void color_manipulation::lut3d::apply(const pixel_view& in_pixels, const mutable_pixel_view& out_pixels, lut_interpolation interpolation, executor* exec) const
+{
+	if (in_pixels.size() != out_pixels.size()) throw new std::invalid_argument("The views contain different numbers of pixels.");
+	if (in_pixels.empty()) return;
+
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, in_pixels.size(), [&](size_t begin, size_t end)
+	{
+		const size_t block_size = 256;
+		float block[block_size * 4];
+		for (size_t first = begin; first < end; first += block_size)
+		{
+			size_t count = std::min(block_size, end - first);
+			in_pixels.unpack(first, count, block, 1.f);
+			for (size_t i = 0; i < count; ++i)
+			{
+				lookup(block + i * 4, block + i * 4, interpolation);
+			}
+			out_pixels.pack(first, count, block, 1.f);
+		}
+	}, 4096);
+}
+
+std::array<float, 3> color_manipulation::lut3d::evaluate(const std::vector<operation>& pipeline, float red, float green, float blue, color_space::rgb_color_space_definition* color_space)
+{
+	// The temporary colors are freed as well if an operation or the conversion throws
+	std::unique_ptr<color_space::color_base> current(new color_space::rgb_deepcolor(red, green, blue, 1.f, color_space));
+	for (auto& step : pipeline)
+	{
+		auto next = step(current.get());
+		if (next == nullptr) throw new std::invalid_argument("A pipeline operation returned null.");
+
+		// Some operations return their input unchanged
+		if (next != current.get()) current.reset(next);
+	}
+
+	const std::unique_ptr<color_space::rgb_deepcolor> rgb(color_manipulation::color_converter::to_rgb_deep(current.get()));
+	return { rgb->red(), rgb->green(), rgb->blue() };
+}
+
+void color_manipulation::lut3d::lookup(const float* in, float* out, lut_interpolation interpolation) const
+{
+	// Find the cell and the position within the cell
+	float scale = (float)(m_grid_size - 1);
+	size_t index[3];
+	float fraction[3];
+	for (int c = 0; c < 3; ++c)
+	{
+		float position = fminf(fmaxf(in[c], 0.f), 1.f) * scale;
+		index[c] = std::min((size_t)position, m_grid_size - 2);
+		fraction[c] = position - (float)index[c];
+	}
+
+	const float* base = &m_nodes[node_offset(index[0], index[1], index[2])];
+	size_t dr = 4;
+	size_t dg = m_grid_size * 4;
+	size_t db = m_grid_size * m_grid_size * 4;
+	float fr = fraction[0];
+	float fg = fraction[1];
+	float fb = fraction[2];
+
+	if (interpolation == TRILINEAR)
+	{
+		const float* nodes[8] = { base, base + dr, base + dg, base + dr + dg, base + db, base + dr + db, base + dg + db, base + dr + dg + db };
+		float weights[8] = {
+			(1.f - fr) * (1.f - fg) * (1.f - fb), fr * (1.f - fg) * (1.f - fb), (1.f - fr) * fg * (1.f - fb), fr * fg * (1.f - fb),
+			(1.f - fr) * (1.f - fg) * fb, fr * (1.f - fg) * fb, (1.f - fr) * fg * fb, fr * fg * fb };
+		blend_nodes(nodes, weights, 8, out);
+		return;
+	}
+
+	// Tetrahedral: the cube is split into 6 tetrahedra along the main diagonal, pick the one containing the point
+	size_t first;
+	size_t second;
+	float weights[4];
+	if (fr > fg)
+	{
+		if (fg > fb) { first = dr; second = dr + dg; weights[0] = 1.f - fr; weights[1] = fr - fg; weights[2] = fg - fb; weights[3] = fb; }
+		else if (fr > fb) { first = dr; second = dr + db; weights[0] = 1.f - fr; weights[1] = fr - fb; weights[2] = fb - fg; weights[3] = fg; }
+		else { first = db; second = dr + db; weights[0] = 1.f - fb; weights[1] = fb - fr; weights[2] = fr - fg; weights[3] = fg; }
+	}
+	else
+	{
+		if (fb > fg) { first = db; second = dg + db; weights[0] = 1.f - fb; weights[1] = fb - fg; weights[2] = fg - fr; weights[3] = fr; }
+		else if (fb > fr) { first = dg; second = dg + db; weights[0] = 1.f - fg; weights[1] = fg - fb; weights[2] = fb - fr; weights[3] = fr; }
+		else { first = dg; second = dr + dg; weights[0] = 1.f - fg; weights[1] = fg - fr; weights[2] = fr - fb; weights[3] = fb; }
+	}
+
+	const float* nodes[4] = { base, base + first, base + second, base + dr + dg + db };
+	blend_nodes(nodes, weights, 4, out);
+}
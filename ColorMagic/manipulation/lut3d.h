@@ -0,0 +1,138 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+#include "../spaces/color_base.h"
+#include "../spaces/rgb_deepcolor.h"
+#include "../spaces/rgb_color_space_definition.h"
+#include "color_converter.h"
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Enum that defines how a lut3d interpolates between its grid points.
+	enum lut_interpolation
+	{
+		TRILINEAR = 0, /*!< TRILINEAR - weights the 8 corners of the surrounding cube */
+		TETRAHEDRAL /*!< TETRAHEDRAL - weights the 4 corners of the surrounding tetrahedron, more accurate along the grey axis */
+	};
+
+	//! Three dimensional lookup table for rgb to rgb transformations.
+	/*!
+	* A lut3d samples an arbitrary chain of color operations (conversions, chromatic adaptations, adjustments, ...)
+	* on a regular grid of N x N x N rgb deep colors. Applying the table afterwards costs a constant amount of time
+	* per pixel no matter how expensive the original operations were. Common grid sizes are 17, 33 and 65.
+	*/
+	class lut3d
+	{
+	public:
+		//! A single step of a pipeline. Takes a color and returns the transformed color.
+		typedef std::function<color_space::color_base*(color_space::color_base*)> operation;
+
+		//! Default constructor.
+		/*!
+		* Creates an identity table.
+		* \param grid_size The number of grid points per axis. Has to be in the range [2,256].
+		* \param color_space The rgb color space definition of the input and output colors.
+		*/
+		lut3d(size_t grid_size, color_space::rgb_color_space_definition* color_space);
+
+		//! Samples the given pipeline into a new table.
+		/*!
+		* Each grid point is fed as rgb deep color through all operations of the pipeline in the given order. The
+		* output of the last operation is converted back to rgb deep. Intermediate colors are deleted (unless an
+		* operation returns its input). If measure_error is set, the pipeline is evaluated a second time in the
+		* center of every grid cell and the largest CIEDE2000 difference to the interpolated table value is stored.
+		* \param pipeline The operations to sample.
+		* \param color_space The rgb color space definition of the input and output colors.
+		* \param grid_size The number of grid points per axis. Has to be in the range [2,256].
+		* \param measure_error Whether to calculate the maximum delta E of the baked table.
+		* \param exec The executor that runs the sampling. If null the default thread pool is used.
+		* \return The baked table.
+		*/
+		static lut3d* bake(const std::vector<operation>& pipeline, color_space::rgb_color_space_definition* color_space, size_t grid_size = 33, bool measure_error = true, executor* exec = nullptr);
+
+		//! Returns the number of grid points per axis.
+		size_t get_grid_size() const { return m_grid_size; }
+
+		//! Returns the rgb color space definition of the input and output colors.
+		color_space::rgb_color_space_definition* get_rgb_color_space() const { return m_rgb_color_space; }
+
+		//! Returns the largest CIEDE2000 difference measured by bake(). Is 0 for tables that were not measured.
+		float get_max_delta_e() const { return m_max_delta_e; }
+
+		//! Returns the output of the grid point with the given indices.
+		std::array<float, 3> get_node(size_t red, size_t green, size_t blue) const;
+
+		//! Sets the output of the grid point with the given indices.
+		void set_node(size_t red, size_t green, size_t blue, std::array<float, 3> value);
+
+		//! Interpolates the table at the given rgb deep position.
+		/*!
+		* \param red The red component in the range [0,1]. Values outside are clamped.
+		* \param green The green component in the range [0,1]. Values outside are clamped.
+		* \param blue The blue component in the range [0,1]. Values outside are clamped.
+		* \param interpolation The interpolation method.
+		* \return The interpolated red, green and blue output.
+		*/
+		std::array<float, 3> lookup(float red, float green, float blue, lut_interpolation interpolation = TETRAHEDRAL) const;
+
+		//! Applies the table to a single color.
+		/*!
+		* \param color The color to transform. It is converted to rgb deep first.
+		* \param interpolation The interpolation method.
+		* \return The transformed color in rgb deep color space. The alpha value of the input is kept.
+		*/
+		color_space::rgb_deepcolor* apply(const color_space::color_base* color, lut_interpolation interpolation = TETRAHEDRAL) const;
+
+		//! Applies the table to a buffer of interleaved rgb deep values.
+		/*!
+		* \param in_rgb The input buffer with 3 floats per pixel.
+		* \param out_rgb The output buffer with 3 floats per pixel. May be the same like in_rgb.
+		* \param pixel_count The number of pixels in both buffers.
+		* \param interpolation The interpolation method.
+		* \param exec The executor that processes the pixels. If null the default thread pool is used.
+		*/
+		void apply(const float* in_rgb, float* out_rgb, size_t pixel_count, lut_interpolation interpolation = TETRAHEDRAL, executor* exec = nullptr) const;
+
+		//! Applies the table to the pixels of a view.
+		/*!
+		* The pixels are transformed directly in the viewed memory, alpha is kept.
+		* \param in_pixels The input pixels.
+		* \param out_pixels The output pixels. Must contain as many pixels as in_pixels and may view the same memory.
+		* \param interpolation The interpolation method.
+		* \param exec The executor that processes the pixels. If null the default thread pool is used.
+		*/
+		void apply(const pixel_view& in_pixels, const mutable_pixel_view& out_pixels, lut_interpolation interpolation = TETRAHEDRAL, executor* exec = nullptr) const;
+
+	protected:
+		//! Runs all operations of the pipeline on a copy of the given color and returns the rgb deep result.
+		static std::array<float, 3> evaluate(const std::vector<operation>& pipeline, float red, float green, float blue, color_space::rgb_color_space_definition* color_space);
+
+		//! Interpolates a single pixel. Writes 3 floats to out.
+		void lookup(const float* in, float* out, lut_interpolation interpolation) const;
+
+		//! Returns the offset of a grid point within m_nodes.
+		size_t node_offset(size_t red, size_t green, size_t blue) const { return ((blue * m_grid_size + green) * m_grid_size + red) * 4; }
+
+		//! Number of grid points per axis.
+		size_t m_grid_size;
+
+		//! Grid points with 4 floats each (red, green, blue, padding) so that each point fits into one SIMD register.
+		std::vector<float> m_nodes;
+
+		//! The rgb color space definition of the input and output colors.
+		color_space::rgb_color_space_definition* m_rgb_color_space;
+
+		//! Largest delta E measured during baking.
+		float m_max_delta_e;
+	};
+}
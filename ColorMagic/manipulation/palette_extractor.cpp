@@ -0,0 +1,262 @@
+#include "stdafx.h"
+#include "palette_extractor.h"
+#include "color_histogram.h"
+#include "conversion_plan.h"
+#include "../utils/simd_math.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+// Finds the nearest center of each of the records [begin, end) and calls found(record, center, squared distance).
+// Four records are transposed into one vector per component and compared with a center at once.
+template <typename Function> static void find_nearest(const float* records, size_t begin, size_t end, const std::vector<float>& center_l, const std::vector<float>& center_a, const std::vector<float>& center_b, Function found)
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+	size_t center_count = center_l.size();
+	size_t i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		float4 l = float4::load(records + i * 4), a = float4::load(records + i * 4 + 4), b = float4::load(records + i * 4 + 8), alpha = float4::load(records + i * 4 + 12);
+		transpose(l, a, b, alpha);
+
+		float4 best(infinity), best_center(0.f);
+		for (size_t c = 0; c < center_count; ++c)
+		{
+			float4 dl = l - float4(center_l[c]), da = a - float4(center_a[c]), db = b - float4(center_b[c]);
+			float4 distance = dl * dl + da * da + db * db;
+			float4 closer = distance < best;
+			best = select(closer, distance, best);
+			best_center = select(closer, float4((float)c), best_center);
+		}
+
+		float distances[4], centers[4];
+		best.store(distances);
+		best_center.store(centers);
+		for (size_t j = 0; j < 4; ++j) found(i + j, (size_t)centers[j], distances[j]);
+	}
+
+	// The same arithmetic for the last records, so they are assigned like they were part of a vector
+	for (; i < end; ++i)
+	{
+		const float* record = records + i * 4;
+		float best = infinity;
+		size_t best_center = 0;
+		for (size_t c = 0; c < center_count; ++c)
+		{
+			float dl = record[0] - center_l[c], da = record[1] - center_a[c], db = record[2] - center_b[c];
+			float distance = dl * dl + da * da + db * db;
+			if (distance < best)
+			{
+				best = distance;
+				best_center = c;
+			}
+		}
+		found(i, best_center, best);
+	}
+}
+
+// Calls body(begin, end) for the block indices [0, block_count) on the executor
+template <typename Function> static void run_blocks(size_t block_count, executor* exec, Function body)
+{
+	if (block_count <= 1)
+	{
+		body(0, block_count);
+		return;
+	}
+
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, block_count, body, 1);
+}
+
+// Draws an index with a probability proportional to its term. Returns count if all terms are 0.
+template <typename Term> static size_t draw(std::mt19937& random, size_t count, double total, Term term)
+{
+	// The generator is defined by the standard, the distributions are not, so the scaling is done by hand
+	double target = random() / 4294967296.0 * total;
+	double sum = 0.0;
+	size_t last = count;
+	for (size_t i = 0; i < count; ++i)
+	{
+		double value = term(i);
+		if (value <= 0.0) continue;
+
+		sum += value;
+		last = i;
+		if (sum > target) return i;
+	}
+	return last;
+}
+
+std::vector<color_manipulation::palette_entry> color_manipulation::palette_extractor::extract(const pixel_view& pixels, color_space::rgb_color_space_definition* color_space, const palette_options& options, executor* exec)
+{
+	if (color_space == nullptr) throw new std::invalid_argument("color_space is null.");
+	if (options.color_count == 0) throw new std::invalid_argument("The palette needs at least one color.");
+
+	auto plan = conversion_plan::get(color_type::RGB_TRUE, color_space, color_type::LAB, color_space, BRADFORD, options.precision);
+	std::vector<float> records;
+	std::vector<float> weights;
+	if (options.use_unique_colors)
+	{
+		// The order of the colors in the table depends on the number of threads, sorting them keeps the palette stable
+		auto table = unique_color_table::compute(pixels, exec);
+		std::vector<std::pair<uint32_t, uint32_t>> colors;
+		colors.reserve(table.size());
+		table.for_each([&](uint32_t rgb, uint32_t count) { colors.push_back(std::make_pair(rgb, count)); });
+		std::sort(colors.begin(), colors.end());
+
+		records.reserve(colors.size() * 4);
+		weights.reserve(colors.size());
+		for (const auto& color : colors)
+		{
+			records.push_back((float)(color.first >> 16));
+			records.push_back((float)((color.first >> 8) & 0xFF));
+			records.push_back((float)(color.first & 0xFF));
+			records.push_back(1.f);
+			weights.push_back((float)color.second);
+		}
+		plan->apply(records.data(), records.data(), colors.size(), exec);
+	}
+	else
+	{
+		records.resize(pixels.size() * 4);
+		plan->apply(pixels, records.data(), exec);
+	}
+
+	return extract(records.data(), weights.empty() ? nullptr : weights.data(), records.size() / 4, options, exec);
+}
+
+std::vector<color_manipulation::palette_entry> color_manipulation::palette_extractor::extract(const float* records, const float* weights, size_t count, const palette_options& options, executor* exec)
+{
+	if (options.color_count == 0) throw new std::invalid_argument("The palette needs at least one color.");
+	if (records == nullptr && count > 0) throw new std::invalid_argument("records is null.");
+	if (count == 0) return std::vector<palette_entry>();
+
+	auto centers = seed_centers(records, weights, count, options, exec);
+	if (centers.empty()) return std::vector<palette_entry>();
+
+	// Lloyd iterations. The weights of the palette belong to the assignment to the final centers.
+	auto sums = assign(records, weights, count, centers, exec);
+	float tolerance = options.tolerance * options.tolerance;
+	for (size_t iteration = 0; iteration < options.max_iterations; ++iteration)
+	{
+		float shift = 0.f;
+		for (size_t c = 0; c < centers.size(); ++c)
+		{
+			// Centers without colors stay where they are
+			const double* sum = &sums[c * 4];
+			if (sum[0] <= 0.0) continue;
+
+			std::array<float, 3> center = { (float)(sum[1] / sum[0]), (float)(sum[2] / sum[0]), (float)(sum[3] / sum[0]) };
+			float dl = center[0] - centers[c][0], da = center[1] - centers[c][1], db = center[2] - centers[c][2];
+			shift = std::max(shift, dl * dl + da * da + db * db);
+			centers[c] = center;
+		}
+
+		sums = assign(records, weights, count, centers, exec);
+		if (shift <= tolerance) break;
+	}
+
+	double total = 0.0;
+	for (size_t c = 0; c < centers.size(); ++c) total += sums[c * 4];
+
+	std::vector<palette_entry> palette;
+	for (size_t c = 0; c < centers.size(); ++c)
+	{
+		if (sums[c * 4] > 0.0) palette.push_back({ centers[c], (float)(sums[c * 4] / total) });
+	}
+	std::stable_sort(palette.begin(), palette.end(), [](const palette_entry& a, const palette_entry& b) { return a.weight > b.weight; });
+	return palette;
+}
+
+std::vector<color_space::lab*> color_manipulation::palette_extractor::create_colors(const std::vector<palette_entry>& palette, color_space::rgb_color_space_definition* color_space)
+{
+	std::vector<color_space::lab*> colors;
+	colors.reserve(palette.size());
+	for (const auto& entry : palette) colors.push_back(new color_space::lab(entry.lab[0], entry.lab[1], entry.lab[2], 1.f, color_space));
+	return colors;
+}
+
+std::vector<std::array<float, 3>> color_manipulation::palette_extractor::seed_centers(const float* records, const float* weights, size_t count, const palette_options& options, executor* exec)
+{
+	auto weight = [weights](size_t i) { return weights != nullptr ? (double)weights[i] : 1.0; };
+	double total = 0.0;
+	for (size_t i = 0; i < count; ++i) total += std::max(weight(i), 0.0);
+
+	std::vector<std::array<float, 3>> centers;
+	std::mt19937 random(options.seed);
+	size_t first = draw(random, count, total, weight);
+	if (first == count) return centers;
+
+	// Squared distance of each record to its nearest center so far
+	std::vector<float> distances(count, std::numeric_limits<float>::infinity());
+	size_t block_count = (count + block_size - 1) / block_size;
+	size_t next = first;
+	while (true)
+	{
+		const float* record = records + next * 4;
+		centers.push_back({ record[0], record[1], record[2] });
+		if (centers.size() == options.color_count) break;
+
+		std::vector<float> center_l(1, record[0]), center_a(1, record[1]), center_b(1, record[2]);
+		run_blocks(block_count, exec, [&](size_t begin, size_t end)
+		{
+			find_nearest(records, begin * block_size, std::min(count, end * block_size), center_l, center_a, center_b, [&](size_t i, size_t, float distance)
+			{
+				distances[i] = std::min(distances[i], distance);
+			});
+		});
+
+		// Records that equal a center have no chance, all colors are taken if none is left
+		auto term = [&](size_t i) { return weight(i) * distances[i]; };
+		double distance_total = 0.0;
+		for (size_t i = 0; i < count; ++i) distance_total += std::max(term(i), 0.0);
+		if (distance_total <= 0.0) break;
+
+		next = draw(random, count, distance_total, term);
+		if (next == count) break;
+	}
+	return centers;
+}
+
+std::vector<double> color_manipulation::palette_extractor::assign(const float* records, const float* weights, size_t count, const std::vector<std::array<float, 3>>& centers, executor* exec)
+{
+	size_t center_count = centers.size();
+	std::vector<float> center_l(center_count), center_a(center_count), center_b(center_count);
+	for (size_t c = 0; c < center_count; ++c)
+	{
+		center_l[c] = centers[c][0];
+		center_a[c] = centers[c][1];
+		center_b[c] = centers[c][2];
+	}
+
+	// Each block sums up its own colors, the blocks are added up in order afterwards
+	size_t block_count = (count + block_size - 1) / block_size;
+	std::vector<double> partial_sums(block_count * center_count * 4, 0.0);
+	run_blocks(block_count, exec, [&](size_t begin, size_t end)
+	{
+		for (size_t block = begin; block < end; ++block)
+		{
+			double* sums = &partial_sums[block * center_count * 4];
+			find_nearest(records, block * block_size, std::min(count, (block + 1) * block_size), center_l, center_a, center_b, [&](size_t i, size_t c, float)
+			{
+				double weight = weights != nullptr ? weights[i] : 1.0;
+				const float* record = records + i * 4;
+				sums[c * 4] += weight;
+				sums[c * 4 + 1] += weight * record[0];
+				sums[c * 4 + 2] += weight * record[1];
+				sums[c * 4 + 3] += weight * record[2];
+			});
+		}
+	});
+
+	std::vector<double> sums(center_count * 4, 0.0);
+	for (size_t block = 0; block < block_count; ++block)
+	{
+		for (size_t j = 0; j < sums.size(); ++j) sums[j] += partial_sums[block * center_count * 4 + j];
+	}
+	return sums;
+}
@@ -0,0 +1,95 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/executor.h"
+#include "../utils/pixel_view.h"
+#include "../utils/precision.h"
+#include "../spaces/lab.h"
+#include "../spaces/rgb_color_space_definition.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! A dominant color of a palette.
+	struct palette_entry
+	{
+		std::array<float, 3> lab; /*!< The L, a and b components of the center of the cluster */
+		float weight; /*!< The share of the colors (or of the sample weights) that belong to the cluster, the weights of a palette sum up to 1 */
+	};
+
+	//! Settings of a palette extraction.
+	struct palette_options
+	{
+		size_t color_count = 8; /*!< The number of clusters, usually 5 to 32. Fewer colors are returned if the image has fewer distinct colors */
+		size_t max_iterations = 30; /*!< The maximum number of assignment and update steps */
+		float tolerance = 0.01f; /*!< Stop as soon as no center moves further than this CIE76 distance in one step */
+		uint32_t seed = 1; /*!< Seed of the k-means++ seeding. The same seed gives the same palette */
+		bool use_unique_colors = true; /*!< Cluster the distinct colors weighted by their counts instead of every pixel */
+		precision_policy precision = FAST; /*!< The precision of the rgb to lab conversion */
+	};
+
+	//! Static class that extracts the dominant colors of an image with k-means clustering in lab.
+	/*!
+	* The colors are converted to lab, where the euclidean distance (CIE76) follows the perceived difference much
+	* better than in rgb. The initial centers are chosen with k-means++: each next center is drawn with a probability
+	* proportional to the squared distance to the nearest center chosen so far, so the centers start spread over the
+	* colors of the image. Lloyd iterations then assign each color to its nearest center and move each center to the
+	* weighted mean of its colors.
+	*
+	* Instead of every pixel the distinct colors of the image can be clustered, each weighted by how often it occurs
+	* (see unique_color_table). This gives the same clusters in a fraction of the time for most images.
+	*
+	* The assignment compares four colors with a center at once and runs on the executor. The colors are split into
+	* blocks of a fixed size whose sums are added up in block order, so the palette does not depend on the number of
+	* threads. The palette is sorted by descending weight.
+	*/
+	class palette_extractor
+	{
+	public:
+		//! Static function that extracts the palette of 8 bit rgb pixels.
+		/*!
+		* \param pixels The pixels. Alpha is ignored.
+		* \param color_space The rgb color space definition of the pixels.
+		* \param options The settings of the extraction.
+		* \param exec The executor that runs the conversion and the assignment. If null the default thread pool is used.
+		* \return The palette, empty if there are no pixels.
+		*/
+		static std::vector<palette_entry> extract(const pixel_view& pixels, color_space::rgb_color_space_definition* color_space, const palette_options& options = palette_options(), executor* exec = nullptr);
+
+		//! Static function that extracts the palette of weighted lab colors.
+		/*!
+		* \param records Lab records of 4 floats (L, a, b and alpha), like the records of the stream_converter.
+		* \param weights The weight of each record, e.g. the number of pixels of this color. If null all weights are 1.
+		* \param count The number of records.
+		* \param options The settings of the extraction. use_unique_colors and precision are not used.
+		* \param exec The executor that runs the assignment. If null the default thread pool is used.
+		* \return The palette, empty if there are no records or all weights are 0.
+		*/
+		static std::vector<palette_entry> extract(const float* records, const float* weights, size_t count, const palette_options& options = palette_options(), executor* exec = nullptr);
+
+		//! Static function that creates lab color objects of a palette.
+		/*!
+		* \param palette The palette.
+		* \param color_space The rgb color space definition of the new colors.
+		* \return One new color per entry. The caller owns the colors.
+		*/
+		static std::vector<color_space::lab*> create_colors(const std::vector<palette_entry>& palette, color_space::rgb_color_space_definition* color_space);
+
+	protected:
+		//! Number of colors per block of the assignment.
+		static const size_t block_size = 4096;
+
+		//! Chooses the initial centers with k-means++. Returns fewer centers if there are fewer distinct colors.
+		static std::vector<std::array<float, 3>> seed_centers(const float* records, const float* weights, size_t count, const palette_options& options, executor* exec);
+
+		//! Assigns all records to their nearest center and returns the weight and the weighted sums of L, a and b per center.
+		static std::vector<double> assign(const float* records, const float* weights, size_t count, const std::vector<std::array<float, 3>>& centers, executor* exec);
+	};
+}
@@ -0,0 +1,101 @@
+#include "stdafx.h"
+#include "polar_converter.h"
+#include "../utils/simd_math.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// Converts the colors [begin, end) in blocks of four, the last block is padded
+template <precision_policy Policy> static void to_polar_range(const float* x, const float* y, float* chroma, float* hue, size_t begin, size_t end)
+{
+	typedef simd_math<Policy> math;
+	for (size_t i = begin; i < end; i += 4)
+	{
+		size_t count = end - i < 4 ? end - i : 4;
+		float4 x_values = float4::load(x + i, count);
+		float4 y_values = float4::load(y + i, count);
+
+		// atan2 lies in [-180, 180] degrees. Negative hues move up by a full turn and hues that round up to exactly
+		// 360 wrap to 0, both without a branch.
+		float4 degrees = math::atan2(y_values, x_values) * float4((float)(180.0 / M_PI));
+		degrees = select(degrees < float4(0.f), degrees + float4(360.f), degrees);
+		degrees = select(degrees >= float4(360.f), degrees - float4(360.f), degrees);
+
+		sqrt(x_values * x_values + y_values * y_values).store(chroma + i, count);
+		degrees.store(hue + i, count);
+	}
+}
+
+template <precision_policy Policy> static void from_polar_range(const float* chroma, const float* hue, float* x, float* y, size_t begin, size_t end)
+{
+	typedef simd_math<Policy> math;
+	for (size_t i = begin; i < end; i += 4)
+	{
+		size_t count = end - i < 4 ? end - i : 4;
+		float4 chroma_values = float4::load(chroma + i, count);
+		float4 degrees = float4::load(hue + i, count);
+
+		// Wrap the hue into [0, 360) first, so the angle stays small and keeps its precision
+		degrees = degrees - float4(360.f) * floor(degrees * float4(1.f / 360.f));
+		float4 sin, cos;
+		math::sincos(degrees * float4((float)(M_PI / 180.0)), sin, cos);
+
+		(chroma_values * cos).store(x + i, count);
+		(chroma_values * sin).store(y + i, count);
+	}
+}
+
+void color_manipulation::polar_converter::lab_to_lch_ab(const float* a, const float* b, float* chroma, float* hue, size_t count, precision_policy policy, executor* exec)
+{
+	to_polar(a, b, chroma, hue, count, policy, exec);
+}
+
+void color_manipulation::polar_converter::lch_ab_to_lab(const float* chroma, const float* hue, float* a, float* b, size_t count, precision_policy policy, executor* exec)
+{
+	from_polar(chroma, hue, a, b, count, policy, exec);
+}
+
+void color_manipulation::polar_converter::cieluv_to_lch_uv(const float* u, const float* v, float* chroma, float* hue, size_t count, precision_policy policy, executor* exec)
+{
+	to_polar(u, v, chroma, hue, count, policy, exec);
+}
+
+void color_manipulation::polar_converter::lch_uv_to_cieluv(const float* chroma, const float* hue, float* u, float* v, size_t count, precision_policy policy, executor* exec)
+{
+	from_polar(chroma, hue, u, v, count, policy, exec);
+}
+
+void color_manipulation::polar_converter::to_polar(const float* x, const float* y, float* chroma, float* hue, size_t count, precision_policy policy, executor* exec)
+{
+	run(count, x, y, chroma, hue, policy, exec, [&](size_t begin, size_t end)
+	{
+		precision::dispatch(policy, [&](auto math_policy) { to_polar_range<decltype(math_policy)::value>(x, y, chroma, hue, begin, end); });
+	});
+}
+
+void color_manipulation::polar_converter::from_polar(const float* chroma, const float* hue, float* x, float* y, size_t count, precision_policy policy, executor* exec)
+{
+	run(count, chroma, hue, x, y, policy, exec, [&](size_t begin, size_t end)
+	{
+		precision::dispatch(policy, [&](auto math_policy) { from_polar_range<decltype(math_policy)::value>(chroma, hue, x, y, begin, end); });
+	});
+}
+
+template <typename Function> void color_manipulation::polar_converter::run(size_t count, const float* in1, const float* in2, const float* out1, const float* out2, precision_policy policy, executor* exec, Function convert_range)
+{
+	if (policy < EXACT || policy > FASTEST) throw new std::invalid_argument("Unknown precision policy.");
+	if (count == 0) return;
+	if (in1 == nullptr || in2 == nullptr || out1 == nullptr || out2 == nullptr) throw new std::invalid_argument("buffer is null.");
+	if (out1 == out2) throw new std::invalid_argument("The output planes must be different.");
+
+	// Small batches are not worth a task. Chunks are multiples of four colors, so only the last block is padded.
+	if (count <= 4096)
+	{
+		convert_range(0, count);
+		return;
+	}
+
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, (count + 3) / 4, [&](size_t begin, size_t end) { convert_range(begin * 4, std::min(end * 4, count)); }, 1024);
+}
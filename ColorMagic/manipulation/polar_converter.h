@@ -0,0 +1,90 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/executor.h"
+#include "../utils/precision.h"
+
+#include <cstddef>
+
+namespace color_manipulation
+{
+	//! Batch conversions between the cartesian and the polar form of lab and luv colors.
+	/*!
+	* Lab <-> LCh(ab) and Luv <-> LCh(uv) only differ in the names of the planes, both turn the chromatic
+	* components (a, b) or (u, v) into chroma and hue and back. The lightness is the same in both forms, so the
+	* functions only read and write the two chromatic planes and leave the lightness plane of the caller alone.
+	*
+	* The buffers are planes of floats (structure of arrays), one value per color. The output planes may be the
+	* input planes, e.g. lab_to_lch_ab(a, b, a, b, count) turns a and b into chroma and hue in place. Four colors
+	* are converted at once with the vectorized math of simd_math.
+	*
+	* The functions use the CIE definitions: chroma = sqrt(a^2 + b^2) and hue = atan2(b, a) in degrees within
+	* [0, 360). Unlike the color classes, chroma and hue are not clamped or rescaled. Hues of any size are accepted
+	* on the way back, so hue edits do not have to wrap their results.
+	*/
+	class polar_converter
+	{
+	public:
+		//! Converts the a and b planes of lab colors into the chroma and hue planes of lch(ab) colors.
+		/*!
+		* \param a The a components.
+		* \param b The b components.
+		* \param chroma The chroma components. May be a or b.
+		* \param hue The hue components in degrees [0, 360). May be a or b.
+		* \param count The number of colors.
+		* \param policy The precision of atan2. FAST has an error below 0.0001 degrees.
+		* \param exec The executor that processes the colors. If null the default thread pool is used.
+		*/
+		static void lab_to_lch_ab(const float* a, const float* b, float* chroma, float* hue, size_t count, precision_policy policy = FAST, executor* exec = nullptr);
+
+		//! Converts the chroma and hue planes of lch(ab) colors into the a and b planes of lab colors.
+		/*!
+		* \param chroma The chroma components.
+		* \param hue The hue components in degrees. Values outside [0, 360) are wrapped.
+		* \param a The a components. May be chroma or hue.
+		* \param b The b components. May be chroma or hue.
+		* \param count The number of colors.
+		* \param policy The precision of sin and cos.
+		* \param exec The executor that processes the colors. If null the default thread pool is used.
+		*/
+		static void lch_ab_to_lab(const float* chroma, const float* hue, float* a, float* b, size_t count, precision_policy policy = FAST, executor* exec = nullptr);
+
+		//! Converts the u and v planes of luv colors into the chroma and hue planes of lch(uv) colors.
+		/*!
+		* \param u The u components.
+		* \param v The v components.
+		* \param chroma The chroma components. May be u or v.
+		* \param hue The hue components in degrees [0, 360). May be u or v.
+		* \param count The number of colors.
+		* \param policy The precision of atan2.
+		* \param exec The executor that processes the colors. If null the default thread pool is used.
+		*/
+		static void cieluv_to_lch_uv(const float* u, const float* v, float* chroma, float* hue, size_t count, precision_policy policy = FAST, executor* exec = nullptr);
+
+		//! Converts the chroma and hue planes of lch(uv) colors into the u and v planes of luv colors.
+		/*!
+		* \param chroma The chroma components.
+		* \param hue The hue components in degrees. Values outside [0, 360) are wrapped.
+		* \param u The u components. May be chroma or hue.
+		* \param v The v components. May be chroma or hue.
+		* \param count The number of colors.
+		* \param policy The precision of sin and cos.
+		* \param exec The executor that processes the colors. If null the default thread pool is used.
+		*/
+		static void lch_uv_to_cieluv(const float* chroma, const float* hue, float* u, float* v, size_t count, precision_policy policy = FAST, executor* exec = nullptr);
+
+	protected:
+		//! Converts cartesian (x, y) planes into chroma and hue planes.
+		static void to_polar(const float* x, const float* y, float* chroma, float* hue, size_t count, precision_policy policy, executor* exec);
+
+		//! Converts chroma and hue planes into cartesian (x, y) planes.
+		static void from_polar(const float* chroma, const float* hue, float* x, float* y, size_t count, precision_policy policy, executor* exec);
+
+		//! Checks the arguments and runs convert_range on the executor.
+		template <typename Function> static void run(size_t count, const float* in1, const float* in2, const float* out1, const float* out2, precision_policy policy, executor* exec, Function convert_range);
+	};
+}
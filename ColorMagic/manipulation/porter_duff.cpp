@@ -1,8 +1,11 @@
 #include "stdafx.h"
 #include "porter_duff.h"
+#include "../utils/instrumentation.h"
 
 color_space::color_base * color_manipulation::porter_duff::src(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "src");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -21,6 +24,8 @@ color_space::color_base * color_manipulation::porter_duff::src(color_space::colo
 
 color_space::color_base * color_manipulation::porter_duff::dest(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "dest");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -39,6 +44,8 @@ color_space::color_base * color_manipulation::porter_duff::dest(color_space::col
 
 color_space::color_base * color_manipulation::porter_duff::atop(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "atop");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -57,6 +64,8 @@ color_space::color_base * color_manipulation::porter_duff::atop(color_space::col
 
 color_space::color_base * color_manipulation::porter_duff::dest_atop(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "dest_atop");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -75,6 +84,8 @@ color_space::color_base * color_manipulation::porter_duff::dest_atop(color_space
 
 color_space::color_base * color_manipulation::porter_duff::over(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "over");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -93,6 +104,8 @@ color_space::color_base * color_manipulation::porter_duff::over(color_space::col
 
 color_space::color_base * color_manipulation::porter_duff::dest_over(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "dest_over");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -111,6 +124,8 @@ color_space::color_base * color_manipulation::porter_duff::dest_over(color_space
 
 color_space::color_base * color_manipulation::porter_duff::in(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "in");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -129,6 +144,8 @@ color_space::color_base * color_manipulation::porter_duff::in(color_space::color
 
 color_space::color_base * color_manipulation::porter_duff::dest_in(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "dest_in");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -147,6 +164,8 @@ color_space::color_base * color_manipulation::porter_duff::dest_in(color_space::
 
 color_space::color_base * color_manipulation::porter_duff::out(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "out");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -165,6 +184,8 @@ color_space::color_base * color_manipulation::porter_duff::out(color_space::colo
 
 color_space::color_base * color_manipulation::porter_duff::dest_out(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "dest_out");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -183,6 +204,8 @@ color_space::color_base * color_manipulation::porter_duff::dest_out(color_space:
 
 color_space::color_base * color_manipulation::porter_duff::x_or(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "x_or");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
@@ -201,6 +224,8 @@ color_space::color_base * color_manipulation::porter_duff::x_or(color_space::col
 
 color_space::color_base * color_manipulation::porter_duff::clear(color_space::color_base * source, color_space::color_base * destination)
 {
+	COLOR_MAGIC_COUNT("porter_duff", "clear");
+
 	// Check input params
 	if (source == nullptr) throw new std::invalid_argument("source color is null.");
 	if (destination == nullptr) throw new std::invalid_argument("destination color is null.");
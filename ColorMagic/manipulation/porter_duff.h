@@ -6,7 +6,7 @@
 #pragma once
 
 #include "base_color_blend.h"
-#include "..\spaces\color_base.h"
+#include "../spaces/color_base.h"
 #include "color_converter.h"
 
 namespace color_manipulation
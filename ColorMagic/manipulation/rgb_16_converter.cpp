@@ -0,0 +1,276 @@
+#include "stdafx.h"
+#include "rgb_16_converter.h"
+#include "../utils/simd_math.h"
+#include "../utils/thread_pool.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+
+// Constants of the CIE lab definition
+static const float lab_epsilon = 216.f / 24389.f;
+static const float lab_kappa = 24389.f / 27.f;
+
+// Converters created by rgb_16_converter::get() with the generation of the definition they were built for, one per
+// definition address. The map is intentionally leaked so that it can be used during static destruction.
+typedef std::pair<uint64_t, std::shared_ptr<const color_manipulation::rgb_16_converter>> cached_converter;
+static std::mutex converter_cache_mutex;
+static std::map<void*, cached_converter>& converter_cache()
+{
+	static auto cache = new std::map<void*, cached_converter>();
+	return *cache;
+}
+
+color_manipulation::rgb_16_converter::rgb_16_converter(color_space::rgb_color_space_definition* color_space)
+	: m_color_space(color_space)
+{
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+
+	auto curve = color_space->get_gamma_curve();
+	m_decode_table.resize(table_size);
+	m_encode_table.resize(table_size);
+	for (size_t i = 0; i < table_size; ++i)
+	{
+		float value = i / (float)(table_size - 1);
+		m_decode_table[i] = fminf(fmaxf(curve->inverse_gamma_correction(value), 0.f), 1.f);
+		m_encode_table[i] = fminf(fmaxf(curve->gamma_correction(value), 0.f), 1.f) * 65535.f;
+	}
+
+	auto white = color_space->get_white_point();
+	m_white = { white->get_tristimulus_x(), white->get_tristimulus_y(), white->get_tristimulus_z() };
+
+	auto transform = static_cast<const color_space::rgb_color_space_definition*>(color_space)->get_transform_matrix();
+	auto inverse = static_cast<const color_space::rgb_color_space_definition*>(color_space)->get_inverse_transform_matrix();
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int column = 0; column < 3; ++column)
+		{
+			m_to_xyz[row * 3 + column] = transform(row, column);
+			m_to_relative_xyz[row * 3 + column] = transform(row, column) / m_white[row];
+			m_from_xyz[row * 3 + column] = inverse(row, column);
+		}
+	}
+}
+
+std::shared_ptr<const color_manipulation::rgb_16_converter> color_manipulation::rgb_16_converter::get(color_space::rgb_color_space_definition* color_space)
+{
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+
+	// The generation changes with every change of the definition and is never reused, so a converter of a changed
+	// or deleted definition (even if a new definition got the same address) is never returned
+	uint64_t generation = color_space->get_generation();
+	{
+		std::lock_guard<std::mutex> lock(converter_cache_mutex);
+		auto entry = converter_cache().find(color_space);
+		if (entry != converter_cache().end() && entry->second.first == generation) return entry->second.second;
+	}
+
+	// Build outside the lock, a converter that was built twice in parallel is simply discarded
+	auto converter = std::make_shared<const rgb_16_converter>(color_space);
+	std::lock_guard<std::mutex> lock(converter_cache_mutex);
+	auto& entry = converter_cache()[color_space];
+	// Generations only grow, so a newer converter that another thread stored in the meantime stays in the cache
+	if (entry.second == nullptr || entry.first < generation) entry = cached_converter(generation, converter);
+	return entry.first == generation ? entry.second : converter;
+}
+
+uint16_t color_manipulation::rgb_16_converter::encode(float linear) const
+{
+	float position = fminf(fmaxf(linear, 0.f), 1.f) * (float)(table_size - 1);
+	size_t index = (size_t)position;
+	if (index >= table_size - 1) return (uint16_t)lroundf(m_encode_table.back());
+
+	float value;
+	if (index == 0)
+	{
+		// Pure power curves are too steep between the first two samples, calculate them exactly
+		value = fminf(fmaxf(m_color_space->get_gamma_curve()->gamma_correction(fmaxf(linear, 0.f)), 0.f), 1.f) * 65535.f;
+	}
+	else
+	{
+		value = m_encode_table[index] + (m_encode_table[index + 1] - m_encode_table[index]) * (position - (float)index);
+	}
+	return (uint16_t)lroundf(value);
+}
+
+color_space::rgb_deepcolor* color_manipulation::rgb_16_converter::to_rgb_deep(const color_space::rgb_16& pixel) const
+{
+	return new color_space::rgb_deepcolor(pixel.red / 65535.f, pixel.green / 65535.f, pixel.blue / 65535.f, pixel.alpha / 65535.f, m_color_space);
+}
+
+color_space::rgb_16 color_manipulation::rgb_16_converter::from_rgb_deep(const color_space::rgb_deepcolor* color)
+{
+	if (color == nullptr) throw new std::invalid_argument("color is null.");
+
+	color_space::rgb_16 pixel;
+	pixel.red = (uint16_t)lroundf(color->red() * 65535.f);
+	pixel.green = (uint16_t)lroundf(color->green() * 65535.f);
+	pixel.blue = (uint16_t)lroundf(color->blue() * 65535.f);
+	pixel.alpha = (uint16_t)lroundf(color->alpha() * 65535.f);
+	return pixel;
+}
+
+void color_manipulation::rgb_16_converter::to_rgb_deep(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec) const
+{
+	run(count, in, out_records, exec, [&](size_t i)
+	{
+		float* out = out_records + i * 4;
+		out[0] = in[i].red / 65535.f;
+		out[1] = in[i].green / 65535.f;
+		out[2] = in[i].blue / 65535.f;
+		out[3] = in[i].alpha / 65535.f;
+	});
+}
+
+void color_manipulation::rgb_16_converter::from_rgb_deep(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec) const
+{
+	run(count, in_records, out, exec, [&](size_t i)
+	{
+		const float* record = in_records + i * 4;
+		auto quantize = [](float value) { return (uint16_t)lroundf(fminf(fmaxf(value, 0.f), 1.f) * 65535.f); };
+		out[i].red = quantize(record[0]);
+		out[i].green = quantize(record[1]);
+		out[i].blue = quantize(record[2]);
+		out[i].alpha = quantize(record[3]);
+	});
+}
+
+void color_manipulation::rgb_16_converter::to_linear(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec) const
+{
+	run(count, in, out_records, exec, [&](size_t i)
+	{
+		float* out = out_records + i * 4;
+		decode(in[i], out);
+		out[3] = in[i].alpha / 65535.f;
+	});
+}
+
+void color_manipulation::rgb_16_converter::from_linear(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec) const
+{
+	run(count, in_records, out, exec, [&](size_t i)
+	{
+		out[i] = encode(in_records + i * 4, in_records[i * 4 + 3]);
+	});
+}
+
+void color_manipulation::rgb_16_converter::to_xyz(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec) const
+{
+	run(count, in, out_records, exec, [&](size_t i)
+	{
+		float linear[3];
+		decode(in[i], linear);
+		float* out = out_records + i * 4;
+		for (int row = 0; row < 3; ++row)
+		{
+			out[row] = m_to_xyz[row * 3] * linear[0] + m_to_xyz[row * 3 + 1] * linear[1] + m_to_xyz[row * 3 + 2] * linear[2];
+		}
+		out[3] = in[i].alpha / 65535.f;
+	});
+}
+
+void color_manipulation::rgb_16_converter::from_xyz(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec) const
+{
+	run(count, in_records, out, exec, [&](size_t i)
+	{
+		const float* record = in_records + i * 4;
+		float linear[3];
+		for (int row = 0; row < 3; ++row)
+		{
+			linear[row] = m_from_xyz[row * 3] * record[0] + m_from_xyz[row * 3 + 1] * record[1] + m_from_xyz[row * 3 + 2] * record[2];
+		}
+		out[i] = encode(linear, record[3]);
+	});
+}
+
+void color_manipulation::rgb_16_converter::to_lab(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec) const
+{
+	run(count, in, out_records, exec, [&](size_t i)
+	{
+		float linear[3];
+		decode(in[i], linear);
+
+		float relative[4] = { 0.f, 0.f, 0.f, 1.f };
+		for (int row = 0; row < 3; ++row)
+		{
+			relative[row] = m_to_relative_xyz[row * 3] * linear[0] + m_to_relative_xyz[row * 3 + 1] * linear[1] + m_to_relative_xyz[row * 3 + 2] * linear[2];
+		}
+
+		// The three cube roots share one vectorized call, the fourth lane is unused
+		float4 xyz = float4::load(relative);
+		float f[4];
+		select(xyz > float4(lab_epsilon), simd_math<FAST>::cbrt(xyz), (float4(lab_kappa) * xyz + float4(16.f)) / float4(116.f)).store(f);
+
+		float* out = out_records + i * 4;
+		out[0] = 116.f * f[1] - 16.f;
+		out[1] = 500.f * (f[0] - f[1]);
+		out[2] = 200.f * (f[1] - f[2]);
+		out[3] = in[i].alpha / 65535.f;
+	});
+}
+
+void color_manipulation::rgb_16_converter::from_lab(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec) const
+{
+	run(count, in_records, out, exec, [&](size_t i)
+	{
+		// Same like color_converter::lab_to_xyz()
+		const float* record = in_records + i * 4;
+		float f_y = (record[0] + 16.f) / 116.f;
+		float f_x = record[1] / 500.f + f_y;
+		float f_z = f_y - record[2] / 200.f;
+		auto expand = [](float value)
+		{
+			float cube = value * value * value;
+			return cube > lab_epsilon ? cube : (116.f * value - 16.f) / lab_kappa;
+		};
+
+		float xyz[3];
+		xyz[0] = expand(f_x) * m_white[0];
+		xyz[1] = (record[0] > lab_epsilon * lab_kappa ? f_y * f_y * f_y : record[0] / lab_kappa) * m_white[1];
+		xyz[2] = expand(f_z) * m_white[2];
+
+		float linear[3];
+		for (int row = 0; row < 3; ++row)
+		{
+			linear[row] = m_from_xyz[row * 3] * xyz[0] + m_from_xyz[row * 3 + 1] * xyz[1] + m_from_xyz[row * 3 + 2] * xyz[2];
+		}
+		out[i] = encode(linear, record[3]);
+	});
+}
+
+void color_manipulation::rgb_16_converter::decode(const color_space::rgb_16& pixel, float* linear) const
+{
+	linear[0] = m_decode_table[pixel.red];
+	linear[1] = m_decode_table[pixel.green];
+	linear[2] = m_decode_table[pixel.blue];
+}
+
+color_space::rgb_16 color_manipulation::rgb_16_converter::encode(const float* linear, float alpha) const
+{
+	color_space::rgb_16 pixel;
+	pixel.red = encode(linear[0]);
+	pixel.green = encode(linear[1]);
+	pixel.blue = encode(linear[2]);
+	pixel.alpha = (uint16_t)lroundf(fminf(fmaxf(alpha, 0.f), 1.f) * 65535.f);
+	return pixel;
+}
+
+template <typename Function> void color_manipulation::rgb_16_converter::run(size_t count, const void* in, const void* out, executor* exec, Function convert)
+{
+	if (count == 0) return;
+	if (in == nullptr || out == nullptr) throw new std::invalid_argument("buffer is null.");
+
+	auto convert_range = [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i) convert(i);
+	};
+
+	// Single pixels are not worth a task
+	if (count == 1)
+	{
+		convert_range(0, 1);
+		return;
+	}
+
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+	runner->parallel_for(0, count, convert_range, 4096);
+}
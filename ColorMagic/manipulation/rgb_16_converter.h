@@ -0,0 +1,132 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/executor.h"
+#include "../spaces/rgb_16.h"
+#include "../spaces/rgb_deepcolor.h"
+#include "../spaces/rgb_color_space_definition.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Converts 16 bit rgb pixels of one rgb color space to and from the float color spaces.
+	/*!
+	* The converter samples the gamma curve of the color space into two tables with 65536 entries each:
+	* the decoding table holds the linear value of every 16 bit code, so decoding is a single lookup without
+	* any float division or gamma function call. The encoding table holds the gamma corrected value of 65536
+	* equidistant linear values and is read with linear interpolation, the result is rounded to the nearest code.
+	*
+	* All buffer functions use records of 4 floats (three components and alpha in the range 0-1) on the float side,
+	* like the conversion_plan. Lab records use the ranges of the lab class. The results are the same like the ones
+	* of the color_converter for rgb deep colors with the components code / 65535, up to float rounding.
+	* Converters are immutable and can be shared between threads. The rgb color space definition must outlive the
+	* converter and must not be modified.
+	*/
+	class rgb_16_converter
+	{
+	public:
+		//! Number of entries of each gamma table (one per 16 bit code).
+		static const size_t table_size = 65536;
+
+		//! Default constructor.
+		/*!
+		* Builds the gamma tables.
+		* \param color_space The rgb color space definition of the 16 bit pixels.
+		*/
+		explicit rgb_16_converter(color_space::rgb_color_space_definition* color_space);
+
+		//! Returns a shared converter for the given color space. Converters are built on first use and reused afterwards.
+		/*!
+		* Converters are cached per generation of the definition, so a changed definition gets a new converter. A returned
+		* converter keeps pointing to the definition and must not be used after the definition is deleted.
+		*/
+		static std::shared_ptr<const rgb_16_converter> get(color_space::rgb_color_space_definition* color_space);
+
+		//! Returns the rgb color space definition of the converter.
+		color_space::rgb_color_space_definition* get_rgb_color_space() const { return m_color_space; }
+
+		//! Returns the linear value of a 16 bit code.
+		float decode(uint16_t code) const { return m_decode_table[code]; }
+
+		//! Returns the 16 bit code of a linear value. The value is clamped to [0, 1].
+		uint16_t encode(float linear) const;
+
+		//! Converts a single pixel to a rgb deep color. The caller owns the returned color.
+		color_space::rgb_deepcolor* to_rgb_deep(const color_space::rgb_16& pixel) const;
+
+		//! Converts a rgb deep color to a pixel. The components are rounded to the nearest code.
+		static color_space::rgb_16 from_rgb_deep(const color_space::rgb_deepcolor* color);
+
+		//! Converts pixels to rgb deep records.
+		/*!
+		* \param in The input pixels.
+		* \param out_records The output records, 4 floats per pixel.
+		* \param count The number of pixels.
+		* \param exec The executor that processes the pixels. If null the default thread pool is used.
+		*/
+		void to_rgb_deep(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec = nullptr) const;
+
+		//! Converts rgb deep records to pixels. Components are clamped to [0, 1] and rounded to the nearest code.
+		void from_rgb_deep(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec = nullptr) const;
+
+		//! Converts pixels to linear rgb records (gamma decoded).
+		void to_linear(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec = nullptr) const;
+
+		//! Converts linear rgb records to pixels (gamma encoded).
+		void from_linear(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec = nullptr) const;
+
+		//! Converts pixels to xyz records.
+		void to_xyz(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec = nullptr) const;
+
+		//! Converts xyz records to pixels. Colors outside the gamut are clipped.
+		void from_xyz(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec = nullptr) const;
+
+		//! Converts pixels directly to lab records.
+		/*!
+		* Decodes with the table and multiplies with the rgb to xyz matrix that is already divided by the white point,
+		* so a pixel costs three lookups, one matrix product and one vectorized cube root of simd_math<FAST>.
+		*/
+		void to_lab(const color_space::rgb_16* in, float* out_records, size_t count, executor* exec = nullptr) const;
+
+		//! Converts lab records to pixels. Colors outside the gamut are clipped.
+		void from_lab(const float* in_records, color_space::rgb_16* out, size_t count, executor* exec = nullptr) const;
+
+	protected:
+		//! Decodes a pixel into linear rgb.
+		void decode(const color_space::rgb_16& pixel, float* linear) const;
+
+		//! Encodes linear rgb and alpha (0-1) into a pixel.
+		color_space::rgb_16 encode(const float* linear, float alpha) const;
+
+		//! Runs the function for each pixel index on the executor.
+		template <typename Function> static void run(size_t count, const void* in, const void* out, executor* exec, Function convert);
+
+		//! The rgb color space definition of the pixels.
+		color_space::rgb_color_space_definition* m_color_space;
+
+		//! Linear value of each 16 bit code.
+		std::vector<float> m_decode_table;
+
+		//! Gamma corrected value (0-65535) of each of 65536 equidistant linear values.
+		std::vector<float> m_encode_table;
+
+		//! Row major rgb to xyz matrix.
+		std::array<float, 9> m_to_xyz;
+
+		//! Row major rgb to xyz matrix with each row divided by the matching white point tristimulus value.
+		std::array<float, 9> m_to_relative_xyz;
+
+		//! Row major xyz to rgb matrix.
+		std::array<float, 9> m_from_xyz;
+
+		//! Tristimulus values of the white point.
+		std::array<float, 3> m_white;
+	};
+}
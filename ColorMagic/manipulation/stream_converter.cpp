@@ -0,0 +1,153 @@
+#include "stdafx.h"
+#include "stream_converter.h"
+#include "../utils/thread_pool.h"
+
+#include <future>
+#include <memory>
+
+size_t color_manipulation::stream_converter::convert(std::istream& input, std::ostream& output, color_type in_type, color_type out_type, color_space::rgb_color_space_definition* color_space, size_t chunk_size, executor* exec)
+{
+	if (color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+	if (chunk_size == 0) throw new std::invalid_argument("Parameter chunk_size has to be greater than 0.");
+
+	size_t in_record_size = get_record_size(in_type);
+	get_record_size(out_type); // fail early on unsupported output types
+	executor* runner = exec != nullptr ? exec : &thread_pool::get_default();
+
+	size_t converted_count = 0;
+	std::future<void> pending_write;
+	std::vector<float> current_chunk = read_chunk(input, in_record_size, chunk_size);
+	while (!current_chunk.empty())
+	{
+		// Read ahead while the current chunk is converted
+		std::future<std::vector<float>> next_chunk = std::async(std::launch::async, &stream_converter::read_chunk, std::ref(input), in_record_size, chunk_size);
+
+		auto converted_chunk = std::make_shared<std::vector<float>>(convert_chunk(current_chunk, in_type, out_type, color_space, runner));
+		converted_count += current_chunk.size() / in_record_size;
+
+		// Only one chunk is written at a time to keep the output in order
+		if (pending_write.valid()) pending_write.get();
+		pending_write = std::async(std::launch::async, [&output, converted_chunk]() { write_chunk(output, *converted_chunk); });
+
+		current_chunk = next_chunk.get();
+	}
+	if (pending_write.valid()) pending_write.get();
+
+	output.flush();
+	return converted_count;
+}
+
+size_t color_manipulation::stream_converter::get_record_size(color_type type)
+{
+	switch (type)
+	{
+	case color_type::GREY_TRUE:
+	case color_type::GREY_DEEP:
+		return 2;
+	case color_type::CMYK:
+		return 5;
+	case color_type::RGB_TRUE:
+	case color_type::RGB_DEEP:
+	case color_type::HSI:
+	case color_type::HSV:
+	case color_type::HSL:
+	case color_type::HCY:
+	case color_type::XYZ:
+	case color_type::XYY:
+	case color_type::CIELUV:
+	case color_type::LAB:
+	case color_type::LCH_AB:
+	case color_type::LCH_UV:
+		return 4;
+	default:
+		throw new std::invalid_argument("Unsupported color type.");
+	}
+}
+
+color_space::color_base* color_manipulation::stream_converter::create_color(color_type type, const float* record, color_space::rgb_color_space_definition* color_space)
+{
+	switch (type)
+	{
+	case color_type::RGB_TRUE:
+		return new color_space::rgb_truecolor(record[0], record[1], record[2], record[3], color_space);
+	case color_type::RGB_DEEP:
+		return new color_space::rgb_deepcolor(record[0], record[1], record[2], record[3], color_space);
+	case color_type::GREY_TRUE:
+		return new color_space::grey_truecolor(record[0], record[1], color_space);
+	case color_type::GREY_DEEP:
+		return new color_space::grey_deepcolor(record[0], record[1], color_space);
+	case color_type::CMYK:
+		return new color_space::cmyk(record[0], record[1], record[2], record[3], record[4], color_space);
+	case color_type::HSI:
+		return new color_space::hsi(record[0], record[1], record[2], record[3], color_space);
+	case color_type::HSV:
+		return new color_space::hsv(record[0], record[1], record[2], record[3], color_space);
+	case color_type::HSL:
+		return new color_space::hsl(record[0], record[1], record[2], record[3], color_space);
+	case color_type::HCY:
+		return new color_space::hcy(record[0], record[1], record[2], record[3], color_space);
+	case color_type::XYZ:
+		return new color_space::xyz(record[0], record[1], record[2], record[3], color_space);
+	case color_type::XYY:
+		return new color_space::xyy(record[0], record[1], record[2], record[3], color_space);
+	case color_type::CIELUV:
+		return new color_space::cieluv(record[0], record[1], record[2], record[3], color_space);
+	case color_type::LAB:
+		return new color_space::lab(record[0], record[1], record[2], record[3], color_space);
+	case color_type::LCH_AB:
+		return new color_space::lch_ab(record[0], record[1], record[2], record[3], color_space);
+	case color_type::LCH_UV:
+		return new color_space::lch_uv(record[0], record[1], record[2], record[3], color_space);
+	default:
+		throw new std::invalid_argument("Unsupported color type.");
+	}
+}
+
+std::vector<float> color_manipulation::stream_converter::read_chunk(std::istream& input, size_t record_size, size_t chunk_size)
+{
+	std::vector<float> chunk(record_size * chunk_size);
+	input.read(reinterpret_cast<char*>(chunk.data()), chunk.size() * sizeof(float));
+
+	size_t read_bytes = (size_t)input.gcount();
+	if (read_bytes % (record_size * sizeof(float)) != 0) throw new std::invalid_argument("The input stream ends within a color record.");
+
+	chunk.resize(read_bytes / sizeof(float));
+	return chunk;
+}
+
+std::vector<float> color_manipulation::stream_converter::convert_chunk(const std::vector<float>& chunk, color_type in_type, color_type out_type, color_space::rgb_color_space_definition* color_space, executor* exec)
+{
+	size_t in_record_size = get_record_size(in_type);
+	size_t out_record_size = get_record_size(out_type);
+	size_t color_count = chunk.size() / in_record_size;
+
+	std::vector<color_space::color_base*> colors(color_count, nullptr);
+	exec->parallel_for(0, color_count, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i) colors[i] = create_color(in_type, &chunk[i * in_record_size], color_space);
+	});
+
+	auto converted_colors = color_manipulation::color_converter::convertTo(colors, out_type, exec);
+
+	std::vector<float> converted_chunk(color_count * out_record_size);
+	exec->parallel_for(0, color_count, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			auto components = converted_colors[i]->get_component_vector();
+			float* record = &converted_chunk[i * out_record_size];
+			std::copy(components.begin(), components.end(), record);
+			record[out_record_size - 1] = converted_colors[i]->alpha();
+
+			delete converted_colors[i];
+			delete colors[i];
+		}
+	});
+	return converted_chunk;
+}
+
+void color_manipulation::stream_converter::write_chunk(std::ostream& output, const std::vector<float>& chunk)
+{
+	output.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(float));
+	if (!output) throw new std::invalid_argument("Writing to the output stream failed.");
+}
@@ -0,0 +1,73 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../utils/executor.h"
+#include "../spaces/color_base.h"
+#include "../spaces/rgb_color_space_definition.h"
+#include "color_converter.h"
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace color_manipulation
+{
+	//! Static class for converting streams of colors that do not fit into memory.
+	/*!
+	* A color stream is a sequence of binary records. Each record consists of the components of a color in the
+	* order of the constructor of its color space, followed by the alpha value. All values are stored as 32 bit
+	* floats in native byte order and use the same ranges like the color classes (e.g. 0-255 for rgb true color).
+	* The stream is processed in chunks of a fixed number of colors. While a chunk is converted by the batch
+	* converter the next chunk is read and the previous one is written, so I/O and computation overlap. At most
+	* four chunks are held in memory at the same time.
+	*/
+	class stream_converter
+	{
+	public:
+		//! Static function that converts a color stream to another color space.
+		/*!
+		* Reads records of the input type until the input stream ends and writes records of the output type.
+		* Any combination of color types supported by color_converter::convertTo() can be used.
+		* \param input The stream to read the input records from. Should be opened in binary mode.
+		* \param output The stream to write the converted records to. Should be opened in binary mode.
+		* \param in_type The color type of the input records.
+		* \param out_type The desired color type of the output records.
+		* \param color_space The rgb color space definition of the input colors.
+		* \param chunk_size The number of colors converted at once.
+		* \param exec The executor that runs the conversions. If null the default thread pool is used.
+		* \return The number of converted colors.
+		*/
+		static size_t convert(std::istream& input, std::ostream& output, color_type in_type, color_type out_type, color_space::rgb_color_space_definition* color_space, size_t chunk_size = 65536, executor* exec = nullptr);
+
+		//! Static function that returns the number of floats of a single record of the given color type.
+		/*!
+		* \param type The color type of the record.
+		* \return The number of components plus one for the alpha value.
+		*/
+		static size_t get_record_size(color_type type);
+
+		//! Static function that creates a color object from a record.
+		/*!
+		* \param type The color type of the record.
+		* \param record Pointer to the first value of the record.
+		* \param color_space The rgb color space definition of the new color.
+		* \return The newly created color.
+		*/
+		static color_space::color_base* create_color(color_type type, const float* record, color_space::rgb_color_space_definition* color_space);
+
+	protected:
+		//! Reads up to chunk_size records from the input stream.
+		static std::vector<float> read_chunk(std::istream& input, size_t record_size, size_t chunk_size);
+
+		//! Converts all records of a chunk.
+		static std::vector<float> convert_chunk(const std::vector<float>& chunk, color_type in_type, color_type out_type, color_space::rgb_color_space_definition* color_space, executor* exec);
+
+		//! Writes all records of a chunk to the output stream.
+		static void write_chunk(std::ostream& output, const std::vector<float>& chunk);
+	};
+}
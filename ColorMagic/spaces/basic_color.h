@@ -0,0 +1,899 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../utils/color_type.h"
+#include "../utils/half.h"
+#include "rgb_color_space_definition.h"
+#include "rgb_truecolor.h"
+#include "rgb_deepcolor.h"
+#include "grey_truecolor.h"
+#include "grey_deepcolor.h"
+#include "cmyk.h"
+#include "hsi.h"
+#include "hsv.h"
+#include "hsl.h"
+#include "hcy.h"
+#include "xyz.h"
+#include "xyy.h"
+#include "cieluv.h"
+#include "lab.h"
+#include "lch_ab.h"
+#include "lch_uv.h"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace color_space
+{
+	//! Largest number of values of a color record (four cmyk components and alpha).
+	static const size_t max_basic_color_record = 5;
+
+	//! Helper functions shared by the space tags.
+	namespace basic_color_detail
+	{
+		//! The type the conversions of a scalar type are calculated in.
+		template <typename Scalar> struct compute_type { typedef Scalar type; };
+
+		//! Halves are storage only, they are calculated in float.
+		template <> struct compute_type<half> { typedef float type; };
+
+		//! Clamps a value like color_base does.
+		template <typename Scalar> inline Scalar clamp(Scalar value, Scalar min, Scalar max)
+		{
+			return std::fmax(std::fmin(value, max), min);
+		}
+
+		//! Calculates the hue in degrees of a rgb color that is not grey.
+		template <typename Scalar> inline Scalar hue_from_rgb(const Scalar* rgb, Scalar max, Scalar delta)
+		{
+			if (max == rgb[0]) return Scalar(60) * std::fmod((rgb[1] - rgb[2]) / delta, Scalar(6));
+			if (max == rgb[1]) return Scalar(60) * (((rgb[2] - rgb[0]) / delta) + Scalar(2));
+			return Scalar(60) * (((rgb[0] - rgb[1]) / delta) + Scalar(4));
+		}
+
+		//! Multiplies the first three values with a 3x3 matrix.
+		template <typename Scalar> inline void multiply(const matrix<float>& transformation, const Scalar* in, Scalar* out)
+		{
+			for (int row = 0; row < 3; ++row)
+			{
+				out[row] = Scalar(transformation(row, 0)) * in[0] + Scalar(transformation(row, 1)) * in[1] + Scalar(transformation(row, 2)) * in[2];
+			}
+		}
+
+		//! The u' and v' chromaticity of the white point, numerators like used by color_converter::xyz_to_cieluv.
+		template <typename Scalar> inline Scalar white_uv(rgb_color_space_definition* color_space, Scalar numerator, bool v)
+		{
+			auto white = color_space->get_white_point();
+			Scalar denominator = Scalar(white->get_tristimulus_x()) + Scalar(15) * Scalar(white->get_tristimulus_y()) + Scalar(3) * Scalar(white->get_tristimulus_z());
+			return numerator * Scalar(v ? white->get_tristimulus_y() : white->get_tristimulus_x()) / denominator;
+		}
+
+		//! Cartesian to polar coordinates like color_converter::lab_to_lch_ab.
+		template <typename Scalar> inline void to_polar(const Scalar* in, Scalar* out, Scalar cartesian_min, Scalar cartesian_max)
+		{
+			Scalar chroma = std::sqrt(in[1] * in[1] + in[2] * in[2]);
+			Scalar hue = std::atan2(in[2], in[1]);
+			if (hue < Scalar(0)) hue += Scalar(360);
+			out[0] = in[0];
+			out[1] = ((chroma - cartesian_min) * Scalar(100)) / (cartesian_max - cartesian_min);
+			out[2] = hue;
+			out[3] = in[3];
+		}
+
+		//! Clamps a component of the given space like the setters of the dynamic class do. Periodic hues are wrapped to [0, 360) first.
+		template <typename Space, typename Scalar> inline Scalar clamp_component(Scalar value, size_t index)
+		{
+			if ((int)index == Space::periodic_component())
+			{
+				value = std::fmod(value, Scalar(360));
+				if (value < Scalar(0)) value += Scalar(360);
+			}
+			return clamp(value, Scalar(Space::component_min(index)), Scalar(Space::component_max(index)));
+		}
+
+		//! Polar to cartesian coordinates like color_converter::lch_ab_to_lab.
+		template <typename Scalar> inline void from_polar(const Scalar* in, Scalar* out)
+		{
+			Scalar radians = in[2] * Scalar(M_PI) / Scalar(180);
+			out[0] = in[0];
+			out[1] = in[1] * std::cos(radians);
+			out[2] = in[1] * std::sin(radians);
+			out[3] = in[3];
+		}
+	}
+
+	//! Space tag of xyz colors. XYZ is the root of all conversions.
+	struct xyz_space
+	{
+		typedef xyz dynamic_type; /*!< The class of the dynamic color layer */
+		typedef xyz_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::XYZ; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t) { return 100.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "X" : index == 1 ? "Y" : "Z"; }
+		static constexpr int depth() { return 0; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new xyz(values[0], values[1], values[2], values[3], color_space); }
+	};
+
+	//! Space tag of rgb deep colors.
+	struct rgb_deep_space
+	{
+		typedef rgb_deepcolor dynamic_type; /*!< The class of the dynamic color layer */
+		typedef xyz_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::RGB_DEEP; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t) { return 1.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "R" : index == 1 ? "G" : "B"; }
+		static constexpr int depth() { return 1; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new rgb_deepcolor(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::rgb_deep_to_xyz.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+		{
+			auto curve = color_space->get_gamma_curve();
+			Scalar linear[3];
+			for (int i = 0; i < 3; ++i) linear[i] = basic_color_detail::clamp(Scalar(curve->inverse_gamma_correction((float)in[i])), Scalar(0), Scalar(1));
+			basic_color_detail::multiply(static_cast<const rgb_color_space_definition*>(color_space)->get_transform_matrix(), linear, out);
+			out[3] = in[3];
+		}
+
+		//! Same like color_converter::xyz_to_rgb_deep.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+		{
+			auto curve = color_space->get_gamma_curve();
+			basic_color_detail::multiply(static_cast<const rgb_color_space_definition*>(color_space)->get_inverse_transform_matrix(), in, out);
+			for (int i = 0; i < 3; ++i) out[i] = Scalar(curve->gamma_correction((float)basic_color_detail::clamp(out[i], Scalar(0), Scalar(1))));
+			out[3] = in[3];
+		}
+	};
+
+	//! Space tag of rgb true colors. Alpha is in the range 0-255 like for rgb_truecolor.
+	struct rgb_true_space
+	{
+		typedef rgb_truecolor dynamic_type; /*!< The class of the dynamic color layer */
+		typedef rgb_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::RGB_TRUE; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t) { return 255.f; }
+		static constexpr float alpha_max() { return 255.f; }
+		static constexpr const char* component_name(size_t index) { return rgb_deep_space::component_name(index); }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new rgb_truecolor(values[0], values[1], values[2], values[3], color_space); }
+
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			for (int i = 0; i < 4; ++i) out[i] = in[i] / Scalar(255);
+		}
+
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			for (int i = 0; i < 4; ++i) out[i] = std::round(in[i] * Scalar(255));
+		}
+	};
+
+	//! Space tag of grey deep colors.
+	struct grey_deep_space
+	{
+		typedef grey_deepcolor dynamic_type; /*!< The class of the dynamic color layer */
+		typedef rgb_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::GREY_DEEP; }
+		static constexpr size_t component_count() { return 1; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t) { return 1.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t) { return "Grey"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new grey_deepcolor(values[0], values[1], color_space); }
+
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			out[0] = out[1] = out[2] = in[0];
+			out[3] = in[1];
+		}
+
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			out[0] = (in[0] + in[1] + in[2]) / Scalar(3);
+			out[1] = in[3];
+		}
+	};
+
+	//! Space tag of grey true colors. Alpha is in the range 0-255 like for grey_truecolor.
+	struct grey_true_space
+	{
+		typedef grey_truecolor dynamic_type; /*!< The class of the dynamic color layer */
+		typedef grey_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::GREY_TRUE; }
+		static constexpr size_t component_count() { return 1; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t) { return 255.f; }
+		static constexpr float alpha_max() { return 255.f; }
+		static constexpr const char* component_name(size_t) { return "Grey"; }
+		static constexpr int depth() { return 3; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new grey_truecolor(values[0], values[1], color_space); }
+
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			for (int i = 0; i < 2; ++i) out[i] = in[i] / Scalar(255);
+		}
+
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			for (int i = 0; i < 2; ++i) out[i] = std::round(in[i] * Scalar(255));
+		}
+	};
+
+	//! Space tag of cmyk colors.
+	struct cmyk_space
+	{
+		typedef cmyk dynamic_type; /*!< The class of the dynamic color layer */
+		typedef rgb_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::CMYK; }
+		static constexpr size_t component_count() { return 4; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t) { return 1.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "C" : index == 1 ? "M" : index == 2 ? "Y" : "K"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new cmyk(values[0], values[1], values[2], values[3], values[4], color_space); }
+
+		//! Same like color_converter::cmyk_to_rgb_deep.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			for (int i = 0; i < 3; ++i) out[i] = (Scalar(1) - in[i]) * (Scalar(1) - in[3]);
+			out[3] = in[4];
+		}
+
+		//! Same like color_converter::rgb_deep_to_cmyk.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			Scalar black = Scalar(1) - std::fmax(std::fmax(in[0], in[1]), in[2]);
+			for (int i = 0; i < 3; ++i) out[i] = (Scalar(1) - in[i] - black) / (Scalar(1) - black);
+			out[3] = black;
+			out[4] = in[3];
+		}
+	};
+
+	//! Space tag of hsi colors.
+	struct hsi_space
+	{
+		typedef hsi dynamic_type; /*!< The class of the dynamic color layer */
+		typedef rgb_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::HSI; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t index) { return index == 0 ? 359.f : 1.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "H" : index == 1 ? "S" : "I"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return 0; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new hsi(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::hsi_to_rgb_deep.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			out[3] = in[3];
+			if (in[1] == Scalar(0))
+			{
+				out[0] = out[1] = out[2] = in[2];
+				return;
+			}
+
+			Scalar sector = in[0] / Scalar(60);
+			Scalar z = Scalar(1) - std::fabs(std::fmod(sector, Scalar(2)) - Scalar(1));
+			Scalar chroma = (Scalar(3) * in[2] * in[1]) / (Scalar(1) + z);
+			Scalar x = chroma * z;
+			Scalar zero = Scalar(0);
+			if (sector >= 0 && sector <= 1) { out[0] = chroma; out[1] = x; out[2] = zero; }
+			else if (sector > 1 && sector <= 2) { out[0] = x; out[1] = chroma; out[2] = zero; }
+			else if (sector > 2 && sector <= 3) { out[0] = zero; out[1] = chroma; out[2] = x; }
+			else if (sector > 3 && sector <= 4) { out[0] = zero; out[1] = x; out[2] = chroma; }
+			else if (sector > 4 && sector <= 5) { out[0] = x; out[1] = zero; out[2] = chroma; }
+			else if (sector > 5 && sector <= 6) { out[0] = chroma; out[1] = zero; out[2] = x; }
+			else { out[0] = out[1] = out[2] = zero; }
+		}
+
+		//! Same like color_converter::rgb_deep_to_hsi.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			Scalar min = std::fmin(std::fmin(in[0], in[1]), in[2]);
+			Scalar max = std::fmax(std::fmax(in[0], in[1]), in[2]);
+			out[3] = in[3];
+			if (max == min)
+			{
+				out[0] = out[1] = Scalar(0);
+				out[2] = min;
+				return;
+			}
+
+			Scalar intensity = (in[0] + in[1] + in[2]) / Scalar(3);
+			out[0] = basic_color_detail::hue_from_rgb(in, max, max - min);
+			out[1] = Scalar(1) - (min / intensity);
+			out[2] = intensity;
+		}
+	};
+
+	//! Space tag of hsv colors.
+	struct hsv_space
+	{
+		typedef hsv dynamic_type; /*!< The class of the dynamic color layer */
+		typedef rgb_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::HSV; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t index) { return index == 0 ? 359.f : 1.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "H" : index == 1 ? "S" : "V"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return 0; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new hsv(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::hsv_to_rgb_deep.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			const Scalar offsets[3] = { Scalar(5), Scalar(3), Scalar(1) };
+			for (int i = 0; i < 3; ++i)
+			{
+				Scalar k = std::fmod(offsets[i] + in[0] / Scalar(60), Scalar(6));
+				out[i] = in[2] - in[2] * in[1] * std::fmax(std::fmin(k, std::fmin(Scalar(4) - k, Scalar(1))), Scalar(0));
+			}
+			out[3] = in[3];
+		}
+
+		//! Same like color_converter::rgb_deep_to_hsv.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			Scalar min = std::fmin(std::fmin(in[0], in[1]), in[2]);
+			Scalar max = std::fmax(std::fmax(in[0], in[1]), in[2]);
+			out[3] = in[3];
+			if (max == min)
+			{
+				out[0] = out[1] = Scalar(0);
+				out[2] = min;
+				return;
+			}
+
+			out[0] = basic_color_detail::hue_from_rgb(in, max, max - min);
+			out[1] = (max - min) / max;
+			out[2] = max;
+		}
+	};
+
+	//! Space tag of hsl colors.
+	struct hsl_space
+	{
+		typedef hsl dynamic_type; /*!< The class of the dynamic color layer */
+		typedef rgb_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::HSL; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t index) { return index == 0 ? 359.f : 1.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "H" : index == 1 ? "S" : "L"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return 0; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new hsl(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::hsl_to_rgb_deep.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			const Scalar offsets[3] = { Scalar(0), Scalar(8), Scalar(4) };
+			Scalar a = in[1] * std::fmin(in[2], Scalar(1) - in[2]);
+			for (int i = 0; i < 3; ++i)
+			{
+				Scalar k = std::fmod(offsets[i] + in[0] / Scalar(30), Scalar(12));
+				out[i] = in[2] - a * std::fmax(std::fmin(k - Scalar(3), std::fmin(Scalar(9) - k, Scalar(1))), Scalar(-1));
+			}
+			out[3] = in[3];
+		}
+
+		//! Same like color_converter::rgb_deep_to_hsl.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			Scalar min = std::fmin(std::fmin(in[0], in[1]), in[2]);
+			Scalar max = std::fmax(std::fmax(in[0], in[1]), in[2]);
+			out[3] = in[3];
+			if (max == min)
+			{
+				out[0] = out[1] = Scalar(0);
+				out[2] = min;
+				return;
+			}
+
+			Scalar delta = max - min;
+			Scalar lightness = Scalar(0.5) * (max + min);
+			out[0] = basic_color_detail::hue_from_rgb(in, max, delta);
+			out[1] = (lightness == Scalar(0) || lightness == Scalar(1)) ? Scalar(0) : (delta / (Scalar(1) - std::fabs(Scalar(2) * lightness - Scalar(1))));
+			out[2] = lightness;
+		}
+	};
+
+	//! Space tag of hcy colors.
+	struct hcy_space
+	{
+		typedef hcy dynamic_type; /*!< The class of the dynamic color layer */
+		typedef rgb_deep_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::HCY; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t index) { return index == 0 ? 359.f : 1.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "H" : index == 1 ? "C" : "Y"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return 0; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new hcy(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::hcy_to_rgb_deep.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			Scalar sector = in[0] / Scalar(360) * Scalar(6);
+			out[0] = basic_color_detail::clamp(std::fabs(sector - Scalar(3)) - Scalar(1), Scalar(0), Scalar(1));
+			out[1] = basic_color_detail::clamp(Scalar(2) - std::fabs(sector - Scalar(2)), Scalar(0), Scalar(1));
+			out[2] = basic_color_detail::clamp(Scalar(2) - std::fabs(sector - Scalar(4)), Scalar(0), Scalar(1));
+			Scalar luma = out[0] * Scalar(0.2126) + out[1] * Scalar(0.7152) + out[2] * Scalar(0.0722);
+			for (int i = 0; i < 3; ++i) out[i] = (out[i] - luma) * in[1] + in[2];
+			out[3] = in[3];
+		}
+
+		//! Same like color_converter::rgb_deep_to_hcy.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			Scalar min = std::fmin(std::fmin(in[0], in[1]), in[2]);
+			Scalar max = std::fmax(std::fmax(in[0], in[1]), in[2]);
+			out[3] = in[3];
+			if (max == min)
+			{
+				out[0] = out[1] = Scalar(0);
+				out[2] = min;
+				return;
+			}
+
+			out[0] = basic_color_detail::hue_from_rgb(in, max, max - min);
+			out[1] = max - min;
+			out[2] = Scalar(0.2126) * in[0] + Scalar(0.7152) * in[1] + Scalar(0.0722) * in[2];
+		}
+	};
+
+	//! Space tag of xyY colors.
+	struct xyy_space
+	{
+		typedef xyy dynamic_type; /*!< The class of the dynamic color layer */
+		typedef xyz_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::XYY; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t) { return 100.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "x" : index == 1 ? "y" : "Y"; }
+		static constexpr int depth() { return 1; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new xyy(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::xyy_to_xyz.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			out[3] = in[3];
+			if (in[1] == Scalar(0))
+			{
+				out[0] = out[1] = out[2] = Scalar(0);
+				return;
+			}
+
+			out[0] = in[0] * in[2] / in[1];
+			out[1] = in[2];
+			out[2] = (Scalar(1) - in[0] - in[1]) * in[2] / in[1];
+		}
+
+		//! Same like color_converter::xyz_to_xyy.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+		{
+			out[2] = in[1];
+			out[3] = in[3];
+			if (in[0] == Scalar(0) && in[1] == Scalar(0) && in[2] == Scalar(0))
+			{
+				out[0] = Scalar(color_space->get_white_point()->get_chromaticity_x());
+				out[1] = Scalar(color_space->get_white_point()->get_chromaticity_y());
+				return;
+			}
+
+			Scalar sum = in[0] + in[1] + in[2];
+			out[0] = in[0] / sum;
+			out[1] = in[1] / sum;
+		}
+	};
+
+	//! Space tag of lab colors.
+	struct lab_space
+	{
+		typedef lab dynamic_type; /*!< The class of the dynamic color layer */
+		typedef xyz_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::LAB; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t index) { return index == 0 ? 0.f : -128.f; }
+		static constexpr float component_max(size_t index) { return index == 0 ? 100.f : 128.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "L" : index == 1 ? "a" : "b"; }
+		static constexpr int depth() { return 1; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new lab(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::lab_to_xyz.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+		{
+			const Scalar epsilon = Scalar(216) / Scalar(24389);
+			const Scalar kappa = Scalar(24389) / Scalar(27);
+			auto expand = [&](Scalar value)
+			{
+				Scalar cube = std::pow(value, Scalar(3));
+				return cube > epsilon ? cube : (Scalar(116) * value - Scalar(16)) / kappa;
+			};
+
+			Scalar f_y = (in[0] + Scalar(16)) / Scalar(116);
+			Scalar y = in[0] > epsilon * kappa ? std::pow(f_y, Scalar(3)) : in[0] / kappa;
+			auto white = color_space->get_white_point();
+			out[0] = expand(in[1] / Scalar(500) + f_y) * Scalar(white->get_tristimulus_x());
+			out[1] = y * Scalar(white->get_tristimulus_y());
+			out[2] = expand(f_y - in[2] / Scalar(200)) * Scalar(white->get_tristimulus_z());
+			out[3] = in[3];
+		}
+
+		//! Same like color_converter::xyz_to_lab.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+		{
+			auto compand = [](Scalar value)
+			{
+				return value > (Scalar(216) / Scalar(24389)) ? std::pow(value, Scalar(1) / Scalar(3)) : ((Scalar(24389) / Scalar(27)) * value + Scalar(16)) / Scalar(116);
+			};
+
+			auto white = color_space->get_white_point();
+			Scalar f_x = compand(in[0] / Scalar(white->get_tristimulus_x()));
+			Scalar f_y = compand(in[1] / Scalar(white->get_tristimulus_y()));
+			Scalar f_z = compand(in[2] / Scalar(white->get_tristimulus_z()));
+			out[0] = Scalar(116) * f_y - Scalar(16);
+			out[1] = Scalar(500) * (f_x - f_y);
+			out[2] = Scalar(200) * (f_y - f_z);
+			out[3] = in[3];
+		}
+	};
+
+	//! Space tag of LCh colors based on lab.
+	struct lch_ab_space
+	{
+		typedef lch_ab dynamic_type; /*!< The class of the dynamic color layer */
+		typedef lab_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::LCH_AB; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t index) { return index == 2 ? 359.f : 100.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "L" : index == 1 ? "C" : "H"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new lch_ab(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::lch_ab_to_lab.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			basic_color_detail::from_polar(in, out);
+		}
+
+		//! Same like color_converter::lab_to_lch_ab.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			basic_color_detail::to_polar(in, out, Scalar(-128), Scalar(128));
+		}
+	};
+
+	//! Space tag of cieluv colors.
+	struct cieluv_space
+	{
+		typedef cieluv dynamic_type; /*!< The class of the dynamic color layer */
+		typedef xyz_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::CIELUV; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t index) { return index == 0 ? 0.f : -100.f; }
+		static constexpr float component_max(size_t) { return 100.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "L" : index == 1 ? "u" : "v"; }
+		static constexpr int depth() { return 1; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new cieluv(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::cieluv_to_xyz.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+		{
+			Scalar u_white = basic_color_detail::white_uv(color_space, Scalar(4), false);
+			Scalar v_white = basic_color_detail::white_uv(color_space, Scalar(9), true);
+			Scalar y = in[0] > Scalar(903.3) * Scalar(0.008856) ? std::pow((in[0] + Scalar(16)) / Scalar(116), Scalar(3)) : in[0] / Scalar(903.3);
+			Scalar a = Scalar(1) / Scalar(3) * ((Scalar(52) * in[0] / (in[1] + Scalar(13) * in[0] * u_white)) - Scalar(1));
+			Scalar b = Scalar(-5) * y;
+			Scalar c = Scalar(-1) / Scalar(3);
+			Scalar d = y * ((Scalar(39) * in[0] / (in[2] + Scalar(13) * in[0] * v_white)) - Scalar(5));
+			out[0] = (d - b) / (a - c);
+			out[1] = y;
+			out[2] = out[0] * a + b;
+			out[3] = in[3];
+		}
+
+		//! Same like color_converter::xyz_to_cieluv, including the white point terms it uses.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+		{
+			Scalar y = in[0] / Scalar(color_space->get_white_point()->get_tristimulus_y());
+			Scalar denominator = in[0] + Scalar(15) * in[1] + Scalar(3) * in[2];
+			Scalar u = Scalar(4) * in[0] / denominator;
+			Scalar v = Scalar(9) * in[1] / denominator;
+			Scalar lightness = y > Scalar(0.008856) ? Scalar(116) * std::pow(y, Scalar(1) / Scalar(3)) - Scalar(16) : Scalar(903.3) * y;
+			out[0] = lightness;
+			out[1] = Scalar(13) * lightness * (u - basic_color_detail::white_uv(color_space, Scalar(4), false));
+			out[2] = Scalar(13) * lightness * (v - basic_color_detail::white_uv(color_space, Scalar(4), true));
+			out[3] = in[3];
+		}
+	};
+
+	//! Space tag of LCh colors based on cieluv.
+	struct lch_uv_space
+	{
+		typedef lch_uv dynamic_type; /*!< The class of the dynamic color layer */
+		typedef cieluv_space parent; /*!< The space the tag converts to and from */
+		static constexpr color_type type() { return color_type::LCH_UV; }
+		static constexpr size_t component_count() { return 3; }
+		static constexpr float component_min(size_t) { return 0.f; }
+		static constexpr float component_max(size_t index) { return index == 2 ? 359.f : 100.f; }
+		static constexpr float alpha_max() { return 1.f; }
+		static constexpr const char* component_name(size_t index) { return index == 0 ? "L" : index == 1 ? "C" : "H"; }
+		static constexpr int depth() { return 2; }
+		static constexpr int periodic_component() { return -1; }
+		static dynamic_type* create(const float* values, rgb_color_space_definition* color_space) { return new lch_uv(values[0], values[1], values[2], values[3], color_space); }
+
+		//! Same like color_converter::lch_uv_to_cieluv.
+		template <typename Scalar> static void to_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			basic_color_detail::from_polar(in, out);
+		}
+
+		//! Same like color_converter::cieluv_to_lch_uv.
+		template <typename Scalar> static void from_parent(const Scalar* in, Scalar* out, rgb_color_space_definition*)
+		{
+			basic_color_detail::to_polar(in, out, Scalar(-100), Scalar(100));
+		}
+	};
+
+	//! Color with a compile time color space.
+	/*!
+	* The counterpart of the color_base classes for generic code: the color space is a template parameter (one of the
+	* *_space tags), so the component count, the component ranges and the conversions are known at compile time and
+	* no virtual function is involved. Components are clamped to the ranges of the dynamic class of the same space (the
+	* hue of hsi, hsv, hsl and hcy is wrapped first) and alpha uses the same range as the dynamic class (0-255 for the
+	* true color spaces, 0-1 otherwise).
+	* \tparam Space The space tag, e.g. color_space::lab_space.
+	* \tparam Scalar The type of the components.
+	*/
+	template <typename Space, typename Scalar = float> class basic_color
+	{
+	public:
+		typedef Space space_type; /*!< The space tag */
+		typedef Scalar scalar_type; /*!< The type of the components */
+		typedef typename basic_color_detail::compute_type<Scalar>::type compute_type; /*!< The type the conversions are calculated in */
+		typedef std::array<Scalar, Space::component_count()> component_array; /*!< The component storage */
+
+		//! Returns the color type of the space.
+		static constexpr color_type type() { return Space::type(); }
+
+		//! Returns the number of components (without alpha).
+		static constexpr size_t component_count() { return Space::component_count(); }
+
+		//! Returns the minimum value of the component with the given index.
+		static constexpr compute_type component_min(size_t index) { return compute_type(Space::component_min(index)); }
+
+		//! Returns the maximum value of the component with the given index.
+		static constexpr compute_type component_max(size_t index) { return compute_type(Space::component_max(index)); }
+
+		//! Returns the maximum alpha value.
+		static constexpr compute_type alpha_max() { return compute_type(Space::alpha_max()); }
+
+		//! Returns the short name of the component with the given index, e.g. "L" for the first lab component.
+		static constexpr const char* component_name(size_t index) { return Space::component_name(index); }
+
+		//! Default constructor.
+		/*!
+		* Creates an opaque color with all components set to 0 (or the minimum) and no rgb color space definition.
+		*/
+		basic_color() : m_alpha(Scalar(alpha_max())), m_rgb_color_space(nullptr)
+		{
+			for (size_t i = 0; i < component_count(); ++i) m_components[i] = clamp_component(compute_type(0), i);
+		}
+
+		//! Constructor.
+		/*!
+		* \param components The components, clamped to the ranges of the space.
+		* \param alpha The alpha value, clamped to [0, alpha_max()].
+		* \param color_space The rgb color space definition used for conversion to or from xyz.
+		*/
+		basic_color(const component_array& components, Scalar alpha, rgb_color_space_definition* color_space) : m_rgb_color_space(color_space)
+		{
+			for (size_t i = 0; i < component_count(); ++i) m_components[i] = clamp_component(components[i], i);
+			this->alpha(alpha);
+		}
+
+		//! Creates the color from a dynamic color of the same color type.
+		/*!
+		* \param color The color to copy. Throws if it has another color type.
+		*/
+		explicit basic_color(const color_base* color)
+		{
+			if (color == nullptr) throw new std::invalid_argument("color is null.");
+			if (color->get_color_type() != type()) throw new std::invalid_argument("The color type of the color does not match the space of the basic_color.");
+			for (size_t i = 0; i < component_count(); ++i) m_components[i] = Scalar(color->get_component((int)i));
+			m_alpha = Scalar(color->alpha());
+			m_rgb_color_space = color->get_rgb_color_space();
+		}
+
+		//! Creates a dynamic color with the same values. The caller owns the returned color.
+		typename Space::dynamic_type* to_dynamic() const
+		{
+			float values[max_basic_color_record];
+			for (size_t i = 0; i < component_count(); ++i) values[i] = (float)m_components[i];
+			values[component_count()] = (float)m_alpha;
+			return Space::create(values, m_rgb_color_space);
+		}
+
+		//! Returns the component with the given index without range check.
+		constexpr Scalar operator[](size_t index) const { return m_components[index]; }
+
+		//! Returns the component with the given index.
+		Scalar get_component(size_t index) const
+		{
+			if (index >= component_count()) throw new std::out_of_range("Index out of range by accessing color component.");
+			return m_components[index];
+		}
+
+		//! Sets the component with the given index. The value is clamped to the range of the component.
+		void set_component(Scalar new_value, size_t index)
+		{
+			if (index >= component_count()) throw new std::out_of_range("Index out of range by setting color component.");
+			m_components[index] = clamp_component(new_value, index);
+		}
+
+		//! Returns all components.
+		const component_array& get_components() const { return m_components; }
+
+		//! Returns the alpha value.
+		Scalar alpha() const { return m_alpha; }
+
+		//! Sets the alpha value. It is clamped to [0, alpha_max()].
+		void alpha(Scalar new_alpha) { m_alpha = Scalar(basic_color_detail::clamp(compute_type(new_alpha), compute_type(0), alpha_max())); }
+
+		//! Returns the rgb color space definition.
+		rgb_color_space_definition* get_rgb_color_space() const { return m_rgb_color_space; }
+
+		//! Sets a new rgb color space definition. The components are not converted.
+		void set_rgb_color_space(rgb_color_space_definition* new_color_space) { m_rgb_color_space = new_color_space; }
+
+		//! Writes the components followed by alpha to the given record.
+		void get_record(compute_type* record) const
+		{
+			for (size_t i = 0; i < component_count(); ++i) record[i] = compute_type(m_components[i]);
+			record[component_count()] = compute_type(m_alpha);
+		}
+
+		//! Reads the components followed by alpha from the given record and clamps them.
+		void set_record(const compute_type* record)
+		{
+			for (size_t i = 0; i < component_count(); ++i) m_components[i] = clamp_component(record[i], i);
+			alpha(Scalar(record[component_count()]));
+		}
+
+		//! Equality operator overload.
+		friend bool operator==(const basic_color& lhs, const basic_color& rhs)
+		{
+			return lhs.m_components == rhs.m_components && lhs.m_alpha == rhs.m_alpha;
+		}
+
+		//! Not equal operator overload.
+		friend bool operator!=(const basic_color& lhs, const basic_color& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+	private:
+		//! Clamps a value to the range of the component with the given index.
+		static Scalar clamp_component(compute_type value, size_t index)
+		{
+			return Scalar(basic_color_detail::clamp_component<Space>(value, index));
+		}
+
+		//! The color components.
+		component_array m_components;
+
+		//! The alpha value.
+		Scalar m_alpha;
+
+		//! The rgb color space definition used for conversions from or to xyz.
+		rgb_color_space_definition* m_rgb_color_space;
+	};
+
+	namespace basic_color_detail
+	{
+		//! Clamps a record of the given space like the constructors of the dynamic classes do.
+		template <typename Space, typename Scalar> inline void clamp_record(Scalar* record)
+		{
+			for (size_t i = 0; i < Space::component_count(); ++i) record[i] = clamp_component<Space>(record[i], i);
+			record[Space::component_count()] = clamp(record[Space::component_count()], Scalar(0), Scalar(Space::alpha_max()));
+		}
+
+		//! Compile time route between two spaces through their closest common ancestor in the space tree.
+		/*!
+		* From climbs to its parent as long as it is not above To, afterwards To is reached from its parent. Each
+		* step is the same like the matching color_converter function, intermediate results are clamped like the
+		* temporary dynamic colors of the color_converter are.
+		*/
+		template <typename From, typename To> struct conversion_route
+		{
+			template <typename Scalar> static void apply(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space)
+			{
+				apply(in, out, color_space, std::integral_constant<int, std::is_same<From, To>::value ? 0 : (From::depth() >= To::depth() ? 1 : 2)>());
+			}
+
+		private:
+			template <typename Scalar> static void apply(const Scalar* in, Scalar* out, rgb_color_space_definition*, std::integral_constant<int, 0>)
+			{
+				for (size_t i = 0; i <= From::component_count(); ++i) out[i] = in[i];
+			}
+
+			template <typename Scalar> static void apply(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space, std::integral_constant<int, 1>)
+			{
+				Scalar temporary[max_basic_color_record];
+				From::to_parent(in, temporary, color_space);
+				clamp_record<typename From::parent>(temporary);
+				conversion_route<typename From::parent, To>::apply(temporary, out, color_space);
+			}
+
+			template <typename Scalar> static void apply(const Scalar* in, Scalar* out, rgb_color_space_definition* color_space, std::integral_constant<int, 2>)
+			{
+				Scalar temporary[max_basic_color_record];
+				conversion_route<From, typename To::parent>::apply(in, temporary, color_space);
+				To::from_parent(temporary, out, color_space);
+				clamp_record<To>(out);
+			}
+		};
+	}
+
+	//! Converts a color to another space. The conversion chain is resolved at compile time.
+	/*!
+	* Usage: auto lab_color = color_space::convert<color_space::lab_space>(rgb_color);
+	* The results are the same like the ones of color_converter::convertTo, except for the direct hsv <-> hsl
+	* conversions of the color_converter, which are routed through rgb here.
+	* \param color The color to convert.
+	* \return The converted color with the same rgb color space definition.
+	*/
+	template <typename To, typename From, typename Scalar> inline basic_color<To, Scalar> convert(const basic_color<From, Scalar>& color)
+	{
+		typedef typename basic_color<From, Scalar>::compute_type compute_type;
+		compute_type in[max_basic_color_record];
+		compute_type out[max_basic_color_record];
+		color.get_record(in);
+		basic_color_detail::conversion_route<From, To>::apply(in, out, color.get_rgb_color_space());
+
+		basic_color<To, Scalar> result;
+		result.set_rgb_color_space(color.get_rgb_color_space());
+		result.set_record(out);
+		return result;
+	}
+}
@@ -0,0 +1,39 @@
+#include "stdafx.h"
+#include "color_base.h"
+#include "../utils/instrumentation.h"
+
+// The constructors and the destructor are defined here and not inline in the header, so the objects are counted
+// according to the configuration of the library and not to the one of the code that includes the header.
+color_space::color_base::color_base(float alpha, rgb_color_space_definition* color_space, size_t component_count, float component_max, float component_min)
+{
+	m_alpha = alpha;
+	m_rgb_color_space = color_space;
+	m_max = component_max;
+	m_min = component_min;
+
+	for (size_t i = 0; i < component_count; ++i)
+	{
+		m_component_vector.push_back(-1);
+	}
+	COLOR_MAGIC_COUNT_COLOR_CREATED();
+}
+
+color_space::color_base::color_base(const color_base& other) :
+	m_component_vector(other.m_component_vector), m_rgb_color_space(other.m_rgb_color_space), m_alpha(other.m_alpha),
+	m_a_max(other.m_a_max), m_a_min(other.m_a_min), m_max(other.m_max), m_min(other.m_min), m_type(other.m_type)
+{
+	COLOR_MAGIC_COUNT_COLOR_CREATED();
+}
+
+color_space::color_base::color_base(color_base&& other) :
+	m_component_vector(std::move(other.m_component_vector)), m_rgb_color_space(other.m_rgb_color_space), m_alpha(other.m_alpha),
+	m_a_max(other.m_a_max), m_a_min(other.m_a_min), m_max(other.m_max), m_min(other.m_min), m_type(other.m_type)
+{
+	COLOR_MAGIC_COUNT_COLOR_CREATED();
+}
+
+color_space::color_base::~color_base()
+{
+	m_component_vector.clear();
+	COLOR_MAGIC_COUNT_COLOR_DESTROYED();
+}
@@ -6,7 +6,7 @@
 #pragma once
 #define _USE_MATH_DEFINES
 
-#include "..\utils\color_type.h"
+#include "../utils/color_type.h"
 #include "rgb_color_space_definition.h"
 
 #include <vector>
@@ -30,27 +30,28 @@ namespace color_space
 		* \param component_max The maximum number each component can have (inclusive).
 		* \param component_min The minimum number each component can have (inclusive).
 		*/
-		color_base(float alpha, rgb_color_space_definition* color_space, size_t component_count, float component_max = 1.f, float component_min = 0.f)
-		{
-			m_alpha = alpha;
-			m_rgb_color_space = color_space;
-			m_max = component_max;
-			m_min = component_min;
+		color_base(float alpha, rgb_color_space_definition* color_space, size_t component_count, float component_max = 1.f, float component_min = 0.f);
 
-			for (size_t i = 0; i < component_count; ++i)
-			{
-				m_component_vector.push_back(-1);
-			}
-		}
+		//! Copy constructor.
+		/*!
+		* Copies all values. Declared so that copies are counted by the instrumentation like all other colors.
+		*/
+		color_base(const color_base& other);
+
+		//! Move constructor.
+		/*!
+		* Takes over the component vector of the other color.
+		*/
+		color_base(color_base&& other);
+
+		color_base& operator=(const color_base&) = default;
+		color_base& operator=(color_base&&) = default;
 
 		//! Default destructor.
 		/*!
 		* Default destructor.
 		*/
-		virtual ~color_base()
-		{
-			m_component_vector.clear();
-		}
+		virtual ~color_base();
 
 		//! Returns the color space the color is located in.
 		/*!
@@ -217,24 +218,26 @@ namespace color_space
 		//! Does the gamma correction for each component of this color.
 		/*!
 		* linear color to "normal" color.
+		* \param policy FASTEST uses the lookup tables of the gamma curve.
 		*/
-		void do_gamma_correction()
+		void do_gamma_correction(precision_policy policy = EXACT)
 		{
 			for (size_t i = 0; i < m_component_vector.size(); ++i)
 			{
-				m_component_vector[i] = clamp(m_rgb_color_space->get_gamma_curve()->gamma_correction(m_component_vector[i]), m_max, m_min);
+				m_component_vector[i] = clamp(m_rgb_color_space->get_gamma_curve()->gamma_correction(m_component_vector[i], policy), m_max, m_min);
 			}
 		}
 
 		//! Does the inverse gamma correction for each component of this color.
 		/*!
 		* "Normal" color to linear color.
+		* \param policy FASTEST uses the lookup tables of the gamma curve.
 		*/
-		void do_inverse_gamma_correction()
+		void do_inverse_gamma_correction(precision_policy policy = EXACT)
 		{
 			for (size_t i = 0; i < m_component_vector.size(); ++i)
 			{
-				m_component_vector[i] = clamp(m_rgb_color_space->get_gamma_curve()->inverse_gamma_correction(m_component_vector[i]), m_max, m_min);
+				m_component_vector[i] = clamp(m_rgb_color_space->get_gamma_curve()->inverse_gamma_correction(m_component_vector[i], policy), m_max, m_min);
 			}
 		}
 
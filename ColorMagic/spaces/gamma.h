@@ -5,9 +5,15 @@
 
 #pragma once
 
+#include "../utils/generation.h"
+#include "../utils/precision.h"
+
 #include <algorithm>
 #include <functional>
 #include <vector>
+#include <stdexcept>
+#include <atomic>
+#include <mutex>
 
 namespace color_space
 {
@@ -140,12 +146,16 @@ namespace color_space
 		//! Set a new gamma function.
 		void set_gamma_function(std::function<float(float)> new_gamma_function) { m_gamma_function = new_gamma_function; }
 
-		//! Access the memory address of the gamma function. Used for function comparison.
+		//! Access an identifier of the gamma function. Used for function comparison.
+		/*!
+		* Functions of the same callable type (e.g. copies of the same lambda) have the same identifier. Reading the
+		* first word of the std::function only worked with the layout of the MSVC standard library.
+		*/
 		long get_gamma_function_address() const
 		{
 			if (!m_gamma_function) return 0;
 
-			return *(long *)(char *)&m_gamma_function;
+			return (long)m_gamma_function.target_type().hash_code();
 		}
 
 	protected:
@@ -182,6 +192,10 @@ namespace color_space
 		{
 			m_gamma_curve_parts = other.get_gamma_curve_parts();
 			m_inverse_gamma_curve_parts = other.get_inverse_gamma_curve_parts();
+			std::lock_guard<std::mutex> lock(other.m_compile_mutex);
+			m_gamma_table = other.m_gamma_table;
+			m_inverse_gamma_table = other.m_inverse_gamma_table;
+			m_compiled = other.m_compiled.load();
 			sort_gamma_parts();
 			sort_inverse_gamma_parts();
 		}
@@ -202,8 +216,13 @@ namespace color_space
 			{
 				m_gamma_curve_parts = other.get_gamma_curve_parts();
 				m_inverse_gamma_curve_parts = other.get_inverse_gamma_curve_parts();
+				std::lock_guard<std::mutex> lock(other.m_compile_mutex);
+				m_gamma_table = other.m_gamma_table;
+				m_inverse_gamma_table = other.m_inverse_gamma_table;
+				m_compiled = other.m_compiled.load();
 				sort_gamma_parts();
 				sort_inverse_gamma_parts();
+				m_generation.store(generation::next(), std::memory_order_release);
 			}
 			return *this;
 		}
@@ -280,12 +299,15 @@ namespace color_space
 		{
 			m_gamma_curve_parts.push_back(new_part);
 			sort_gamma_parts();
+			discard_tables();
 		}
 		
 		//! Remove the given gamma function from the list of default gamma parts
 		bool remove_gamma_curve_part(std::vector<gamma_part*>::iterator position)
 		{
 			m_gamma_curve_parts.erase(position);
+			discard_tables();
+			return true;
 		}
 
 		//! Replace the list of default gamma parts.
@@ -293,6 +315,7 @@ namespace color_space
 		{
 			m_gamma_curve_parts = new_gamma_curve_parts;
 			sort_gamma_parts();
+			discard_tables();
 		}
 
 		//! Access the inverse gamma parts
@@ -303,12 +326,15 @@ namespace color_space
 		{
 			m_inverse_gamma_curve_parts.push_back(new_part);
 			sort_inverse_gamma_parts();
+			discard_tables();
 		}
 
 		//! Remove the given gamma function from the list of inverse gamma parts
 		bool remove_inverse_gamma_curve_part(std::vector<gamma_part*>::iterator position)
 		{
 			m_inverse_gamma_curve_parts.erase(position);
+			discard_tables();
+			return true;
 		}
 
 		//! Replace the list of inverse gamma parts.
@@ -316,10 +342,11 @@ namespace color_space
 		{
 			m_inverse_gamma_curve_parts = new_gamma_curve_parts;
 			sort_inverse_gamma_parts();
+			discard_tables();
 		}
 
 		//! Takes the matching default gamma_part and calculates the gamma correction.
-		float gamma_correction(float input_value)
+		float gamma_correction(float input_value) const
 		{
 			for (gamma_part* part : m_gamma_curve_parts)
 			{
@@ -334,7 +361,7 @@ namespace color_space
 		}
 
 		//! Takes the matching inverse gamma_part and calculates the gamma correction.
-		float inverse_gamma_correction(float input_value)
+		float inverse_gamma_correction(float input_value) const
 		{
 			for (gamma_part* part : m_inverse_gamma_curve_parts)
 			{
@@ -348,7 +375,126 @@ namespace color_space
 			return input_value;
 		}
 
+		//! Samples both gamma curves into lookup tables.
+		/*!
+		* Evaluates the default and the inverse gamma parts at table_size equidistant points in the range [0, 1].
+		* Afterwards table_gamma_correction() and table_inverse_gamma_correction() can be used to replace the
+		* std::function calls of the exact versions by a table lookup with linear interpolation. Tables are
+		* discarded automatically whenever the gamma parts change.
+		* This function must not run while other threads read from the tables. Use compile_once() to create
+		* the tables lazily from several threads.
+		* \param table_size The number of samples per table (at least 2). Larger tables are more accurate close to 0,
+		* where pure power curves are steep.
+		*/
+		void compile(size_t table_size = 16384)
+		{
+			std::lock_guard<std::mutex> lock(m_compile_mutex);
+			build_tables(table_size);
+		}
+
+		//! Samples both gamma curves into lookup tables unless this already happened.
+		/*!
+		* Thread safe version of compile() that can be called concurrently with the table lookups. Only the first
+		* caller builds the tables, all other callers wait until the tables are ready.
+		* \param table_size The number of samples per table (at least 2).
+		*/
+		void compile_once(size_t table_size = 16384)
+		{
+			if (is_compiled()) return;
+
+			std::lock_guard<std::mutex> lock(m_compile_mutex);
+			if (!m_compiled.load(std::memory_order_relaxed)) build_tables(table_size);
+		}
+
+		//! Whether compile() has been called since the last change of the gamma parts.
+		bool is_compiled() const { return m_compiled.load(std::memory_order_acquire); }
+
+		//! Returns the generation of the gamma parts.
+		/*!
+		* A process wide unique number (see generation) that changes whenever parts are added, removed or replaced.
+		* Changes of a gamma_part object that is already part of this curve are not detected.
+		*/
+		uint64_t get_generation() const { return m_generation.load(std::memory_order_acquire); }
+
+		//! Calculates the gamma correction by using the compiled table.
+		/*!
+		* Input values are clamped to [0, 1]. If no table has been compiled yet gamma_correction() is used instead.
+		*/
+		float table_gamma_correction(float input_value) const
+		{
+			if (!is_compiled()) return gamma_correction(input_value);
+			return lookup(m_gamma_table, input_value);
+		}
+
+		//! Calculates the inverse gamma correction by using the compiled table.
+		/*!
+		* Input values are clamped to [0, 1]. If no table has been compiled yet inverse_gamma_correction() is used instead.
+		*/
+		float table_inverse_gamma_correction(float input_value) const
+		{
+			if (!is_compiled()) return inverse_gamma_correction(input_value);
+			return lookup(m_inverse_gamma_table, input_value);
+		}
+
+		//! Calculates the gamma correction with the given precision policy.
+		/*!
+		* FASTEST compiles the tables on first use and reads them, the other policies evaluate the exact curve.
+		*/
+		float gamma_correction(float input_value, precision_policy policy)
+		{
+			if (policy != FASTEST) return gamma_correction(input_value);
+			compile_once();
+			return table_gamma_correction(input_value);
+		}
+
+		//! Calculates the inverse gamma correction with the given precision policy. See gamma_correction(float, precision_policy).
+		float inverse_gamma_correction(float input_value, precision_policy policy)
+		{
+			if (policy != FASTEST) return inverse_gamma_correction(input_value);
+			compile_once();
+			return table_inverse_gamma_correction(input_value);
+		}
+
 	protected:
+		//! Fills both tables and publishes them. The compile mutex has to be locked by the caller.
+		void build_tables(size_t table_size)
+		{
+			if (table_size < 2) throw new std::invalid_argument("A compiled gamma table needs at least two entries.");
+
+			m_compiled.store(false, std::memory_order_release);
+			m_gamma_table.resize(table_size);
+			m_inverse_gamma_table.resize(table_size);
+
+			float step = 1.f / (float)(table_size - 1);
+			for (size_t i = 0; i < table_size; ++i)
+			{
+				m_gamma_table[i] = gamma_correction(i * step);
+				m_inverse_gamma_table[i] = inverse_gamma_correction(i * step);
+			}
+			m_compiled.store(true, std::memory_order_release);
+		}
+
+		//! Drops the compiled tables and starts a new generation after the gamma parts changed.
+		void discard_tables()
+		{
+			std::lock_guard<std::mutex> lock(m_compile_mutex);
+			m_compiled.store(false, std::memory_order_release);
+			m_gamma_table.clear();
+			m_inverse_gamma_table.clear();
+			m_generation.store(generation::next(), std::memory_order_release);
+		}
+
+		//! Reads a value from the given table by linear interpolation between the two nearest samples.
+		static float lookup(const std::vector<float>& table, float input_value)
+		{
+			float position = std::min(std::max(input_value, 0.f), 1.f) * (float)(table.size() - 1);
+			size_t index = (size_t)position;
+			if (index >= table.size() - 1) return table.back();
+
+			float fraction = position - (float)index;
+			return table[index] + (table[index + 1] - table[index]) * fraction;
+		}
+
 		//! Sort the default gamma parts in ascending order depending on the upper border.
 		void sort_gamma_parts()
 		{
@@ -366,6 +512,21 @@ namespace color_space
 
 		//! The inverse gamma parts in ascending order depending on their upper border.
 		std::vector<gamma_part*> m_inverse_gamma_curve_parts;
+
+		//! Samples of the default gamma curve created by compile(). Empty if not compiled.
+		std::vector<float> m_gamma_table;
+
+		//! Samples of the inverse gamma curve created by compile(). Empty if not compiled.
+		std::vector<float> m_inverse_gamma_table;
+
+		//! Whether both tables are filled and may be read.
+		std::atomic<bool> m_compiled{ false };
+
+		//! Serializes the creation and destruction of the tables.
+		mutable std::mutex m_compile_mutex;
+
+		//! Changes with every change of the gamma parts, see get_generation().
+		std::atomic<uint64_t> m_generation{ generation::next() };
 	};
 
 	//! Class that stores some default gamma functions.
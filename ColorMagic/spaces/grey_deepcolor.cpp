@@ -39,7 +39,7 @@ color_space::grey_deepcolor & color_space::grey_deepcolor::operator=(const color
 	return *this;
 }
 
-float color_space::grey_deepcolor::grey()
+float color_space::grey_deepcolor::grey() const
 {
 	return m_component_vector[0];
 }
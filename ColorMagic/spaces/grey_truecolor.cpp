@@ -40,7 +40,7 @@ color_space::grey_truecolor & color_space::grey_truecolor::operator=(const color
 	return *this;
 }
 
-float color_space::grey_truecolor::grey()
+float color_space::grey_truecolor::grey() const
 {
 	return (float)m_component_vector[0];
 }
@@ -41,7 +41,7 @@ color_space::hsv & color_space::hsv::operator=(const color_space::hsv & other)
 	return *this;
 }
 
-float color_space::hsv::hue()
+float color_space::hsv::hue() const
 {
 	return m_component_vector[0];
 }
@@ -57,7 +57,7 @@ void color_space::hsv::hue(float new_hue)
 	set_component(new_hue, 0, m_degrees_max, m_degrees_min);
 }
 
-float color_space::hsv::saturation()
+float color_space::hsv::saturation() const
 {
 	return m_component_vector[1];
 }
@@ -67,7 +67,7 @@ void color_space::hsv::saturation(float new_saturation)
 	set_component(new_saturation, 1);
 }
 
-float color_space::hsv::value()
+float color_space::hsv::value() const
 {
 	return m_component_vector[2];
 }
@@ -41,7 +41,7 @@ color_space::lab & color_space::lab::operator=(const color_space::lab & other)
 	return *this;
 }
 
-float color_space::lab::luminance()
+float color_space::lab::luminance() const
 {
 	return m_component_vector[0];
 }
@@ -51,7 +51,7 @@ void color_space::lab::luminance(float new_luminance)
 	set_component(new_luminance, 0, m_lightness_max, m_lightness_min);
 }
 
-float color_space::lab::a()
+float color_space::lab::a() const
 {
 	return m_component_vector[1];
 }
@@ -61,7 +61,7 @@ void color_space::lab::a(float new_a)
 	set_component(new_a, 1);
 }
 
-float color_space::lab::b()
+float color_space::lab::b() const
 {
 	return m_component_vector[2];
 }
@@ -51,7 +51,7 @@ namespace color_space
 
 		//! Getter for luminance component.
 		//! \return The luminance component of this color.
-		float luminance();
+		float luminance() const;
 
 		//! Setter for luminance component.
 		//! \param new_luminance The luminance value to set.
@@ -59,7 +59,7 @@ namespace color_space
 
 		//! Getter for a component.
 		//! \return The a component of this color.
-		float a(); // green red
+		float a() const; // green red
 
 		//! Setter for a component.
 		//! \param new_a The a value to set.
@@ -67,7 +67,7 @@ namespace color_space
 
 		//! Getter for b component.
 		//! \return The b component of this color.
-		float b(); // yellow blue
+		float b() const; // yellow blue
 
 		//! Setter for b component.
 		//! \param new_b The a value to set.
@@ -41,7 +41,7 @@ color_space::lch_ab& color_space::lch_ab::operator=(const lch_ab & other)
 	return *this;
 }
 
-float color_space::lch_ab::luminance()
+float color_space::lch_ab::luminance() const
 {
 	return m_component_vector[0];
 }
@@ -51,7 +51,7 @@ void color_space::lch_ab::luminance(float new_luminance)
 	set_component(new_luminance, 0);
 }
 
-float color_space::lch_ab::chroma()
+float color_space::lch_ab::chroma() const
 {
 	return m_component_vector[1];
 }
@@ -61,7 +61,7 @@ void color_space::lch_ab::chroma(float new_chroma)
 	set_component(new_chroma, 1);
 }
 
-float color_space::lch_ab::hue()
+float color_space::lch_ab::hue() const
 {
 	return m_component_vector[2];
 }
@@ -41,7 +41,7 @@ color_space::lch_uv& color_space::lch_uv::operator=(const lch_uv & other)
 	return *this;
 }
 
-float color_space::lch_uv::luminance()
+float color_space::lch_uv::luminance() const
 {
 	return m_component_vector[0];
 }
@@ -51,7 +51,7 @@ void color_space::lch_uv::luminance(float new_luminance)
 	set_component(new_luminance, 0);
 }
 
-float color_space::lch_uv::chroma()
+float color_space::lch_uv::chroma() const
 {
 	return m_component_vector[1];
 }
@@ -61,7 +61,7 @@ void color_space::lch_uv::chroma(float new_chroma)
 	set_component(new_chroma, 1);
 }
 
-float color_space::lch_uv::hue()
+float color_space::lch_uv::hue() const
 {
 	return m_component_vector[2];
 }
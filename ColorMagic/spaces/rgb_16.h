@@ -0,0 +1,41 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace color_space
+{
+	//! A rgb pixel with 16 bit integer components.
+	/*!
+	* Components and alpha are in the range 0-65535. Unlike the color_base classes this is a plain pixel type for
+	* image buffers of 16 bit scanner and print pipelines, it has no color space definition and no virtual functions.
+	* Use the color_manipulation::rgb_16_converter to convert it to or from the other color spaces.
+	*/
+	struct rgb_16
+	{
+		uint16_t red; /*!< Red component (0-65535) */
+		uint16_t green; /*!< Green component (0-65535) */
+		uint16_t blue; /*!< Blue component (0-65535) */
+		uint16_t alpha; /*!< Alpha (0-65535) */
+
+		//! Equality operator overload.
+		friend bool operator==(const rgb_16& lhs, const rgb_16& rhs)
+		{
+			return lhs.red == rhs.red && lhs.green == rhs.green && lhs.blue == rhs.blue && lhs.alpha == rhs.alpha;
+		}
+
+		//! Not equal operator overload.
+		friend bool operator!=(const rgb_16& lhs, const rgb_16& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+
+	//! Buffer of 16 bit rgb pixels.
+	typedef std::vector<rgb_16> rgb_16_buffer;
+}
@@ -7,8 +7,11 @@
 
 #include "gamma.h"
 #include "white_point.h"
+#include "../utils/generation.h"
 #include "../utils/matrix.h"
 #include <array>
+#include <atomic>
+#include <cstdint>
 
 namespace color_space
 {
@@ -75,6 +78,26 @@ namespace color_space
 			m_gamma = other.get_gamma_curve();
 		}
 
+		//! Assignment operator.
+		/*!
+		* The assigned definition gets a new generation.
+		*/
+		rgb_color_space_definition& operator=(const rgb_color_space_definition& other)
+		{
+			if (this != &other)
+			{
+				m_red = other.m_red;
+				m_green = other.m_green;
+				m_blue = other.m_blue;
+				m_white = other.m_white;
+				m_transform_matrix = other.m_transform_matrix;
+				m_inverse_transform_matrix = other.m_inverse_transform_matrix;
+				m_gamma = other.m_gamma;
+				m_generation.store(generation::next(), std::memory_order_release);
+			}
+			return *this;
+		}
+
 		//! Default deconstructor.
 		/*!
 		* Default deconstructor.
@@ -179,6 +202,7 @@ namespace color_space
 			m_white = new_white_point;
 			m_transform_matrix = calculate_transformation_matrix(m_red, m_green, m_blue, m_white->get_tristimulus());
 			m_inverse_transform_matrix = m_transform_matrix.invert();
+			m_generation.store(generation::next(), std::memory_order_release);
 		}
 
 		//! Access the matrix to transform from rgb space to xyz.
@@ -187,12 +211,24 @@ namespace color_space
 			return m_transform_matrix;
 		}
 
+		//! Access the matrix to transform from rgb space to xyz without copying it.
+		const matrix<float>& get_transform_matrix() const
+		{
+			return m_transform_matrix;
+		}
+
 		//! Access the matrix to transform from xyz space to rgb.
 		matrix<float> get_inverse_transform_matrix()
 		{
 			return m_inverse_transform_matrix;
 		}
 
+		//! Access the matrix to transform from xyz space to rgb without copying it.
+		const matrix<float>& get_inverse_transform_matrix() const
+		{
+			return m_inverse_transform_matrix;
+		}
+
 		//! Access the gamma curve.
 		gamma* get_gamma_curve()
 		{
@@ -203,6 +239,27 @@ namespace color_space
 		void set_gamma_curve(gamma* new_gamma)
 		{
 			m_gamma = new_gamma;
+			m_generation.store(generation::next(), std::memory_order_release);
+		}
+
+		//! Returns the generation of this definition.
+		/*!
+		* A process wide unique number (see generation) that changes whenever the white point or the gamma curve is
+		* replaced or the parts of the gamma curve change. Definitions that are created later never get the number of
+		* another definition, even if they are created at the same address. Caches use it instead of the address of
+		* the definition.
+		*/
+		uint64_t get_generation() const
+		{
+			uint64_t gamma_generation = m_gamma != nullptr ? m_gamma->get_generation() : 0;
+			if (gamma_generation != m_gamma_generation.load(std::memory_order_acquire))
+			{
+				// The gamma curve changed since the last call. The generation is published first, so callers that
+				// see the new gamma generation also see the new generation.
+				m_generation.store(generation::next(), std::memory_order_release);
+				m_gamma_generation.store(gamma_generation, std::memory_order_release);
+			}
+			return m_generation.load(std::memory_order_acquire);
 		}
 
 	private:
@@ -275,6 +332,12 @@ namespace color_space
 		* The gamma curve of this rgb color space definition.
 		*/
 		gamma* m_gamma;
+
+		//! The current generation, see get_generation().
+		mutable std::atomic<uint64_t> m_generation{ generation::next() };
+
+		//! The generation of the gamma curve when m_generation was last updated.
+		mutable std::atomic<uint64_t> m_gamma_generation{ 0 };
 	};
 
 	//! Class that stores some default reference white values.
@@ -344,6 +407,13 @@ namespace color_space
 		*/
 		rgb_color_space_definition* dci_p3() { return new rgb_color_space_definition(0.68f, 0.32f, 0.265f, 0.69f, 0.15f, 0.06f, m_white_presets.D65_2Degree(), m_gamma_presets.gamma2_6()); }
 
+		//! The Display P3 color space.
+		/*!
+		* Display P3 combines the primaries of DCI-P3 with the D65 reference white and the sRGB gamma curve.
+		* It is used by wide gamut displays and by the color(display-p3 ...) function of CSS.
+		*/
+		rgb_color_space_definition* display_p3() { return new rgb_color_space_definition(0.68f, 0.32f, 0.265f, 0.69f, 0.15f, 0.06f, m_white_presets.D65_2Degree(), m_gamma_presets.sRGB()); }
+
 		//! The UHDTV color space.
 		/*!
 		* ITU - R Recommendation BT.2020, more commonly known by the abbreviations Rec. 2020
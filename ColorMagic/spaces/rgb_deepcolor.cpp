@@ -49,7 +49,7 @@ color_space::rgb_deepcolor & color_space::rgb_deepcolor::operator=(const color_s
 	return *this;
 }
 
-float color_space::rgb_deepcolor::red()
+float color_space::rgb_deepcolor::red() const
 {
 	return m_component_vector[0];
 }
@@ -59,7 +59,7 @@ void color_space::rgb_deepcolor::red(float new_red)
 	set_component(new_red, 0);
 }
 
-float color_space::rgb_deepcolor::green()
+float color_space::rgb_deepcolor::green() const
 {
 	return m_component_vector[1];
 }
@@ -69,7 +69,7 @@ void color_space::rgb_deepcolor::green(float new_green)
 	set_component(new_green, 1);
 }
 
-float color_space::rgb_deepcolor::blue()
+float color_space::rgb_deepcolor::blue() const
 {
 	return m_component_vector[2];
 }
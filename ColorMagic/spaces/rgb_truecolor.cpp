@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "rgb_truecolor.h"
+#include "../utils/hex_color.h"
 
 color_space::rgb_truecolor::rgb_truecolor(float value, float alpha, rgb_color_space_definition* color_space) : color_base(alpha, color_space, 3, 255.f, 0.f)
 {
@@ -21,42 +22,17 @@ color_space::rgb_truecolor::rgb_truecolor(float r, float g, float b, float alpha
 
 color_space::rgb_truecolor::rgb_truecolor(std::string hex_code, rgb_color_space_definition* color_space) : color_base(0, color_space, 3, 255.f, 0.f)
 {
-	std::regex regex("^[#0-9A-Fa-f]+$");
-
-	if (!std::regex_match(hex_code, regex))
-	{
-		throw std::invalid_argument(std::string("The given hex code '" + hex_code + "' contains illegal values. Allowed are only numbers (0-9) and digits (a-f or A-F)."));
-	}
-
-	if (hex_code[0] == '#')
+	uint32_t argb;
+	if (!hex_color::try_parse(hex_code.data(), hex_code.size(), argb))
 	{
-		hex_code = hex_code.substr(1);
+		throw std::invalid_argument("Wrong hex code format. Use one of the following formats: #AARRGGBB, #RRGGBB, #RGB, AARRGGBB, RRGGBB, RGB");
 	}
 
-	if (hex_code.length() == 6)
-	{
-		int r, g, b;
-		sscanf_s(hex_code.c_str(), "%02x%02x%02x", &r, &g, &b);
-		this->m_type = color_type::RGB_TRUE;
-		this->alpha(255.f);
-		this->red((float)r);
-		this->green((float)g);
-		this->blue((float)b);
-	}
-	else if (hex_code.length() == 8)
-	{
-		int a, r, g, b;
-		sscanf_s(hex_code.c_str(), "%02x%02x%02x%02x", &a, &r, &g, &b);
-		this->m_type = color_type::RGB_TRUE;
-		this->alpha((float)a);
-		this->red((float)r);
-		this->green((float)g);
-		this->blue((float)b);
-	}
-	else
-	{
-		throw std::invalid_argument("Wrong hex code format. Use one of the following formats: #AARRGGBB, #RRGGBB, AARRGGBB, RRGGBB");
-	}
+	this->m_type = color_type::RGB_TRUE;
+	this->alpha((float)((argb >> 24) & 0xff));
+	this->red((float)((argb >> 16) & 0xff));
+	this->green((float)((argb >> 8) & 0xff));
+	this->blue((float)(argb & 0xff));
 }
 
 color_space::rgb_truecolor::rgb_truecolor(int hex_code, rgb_color_space_definition* color_space) : color_base(0, color_space, 3, 255.f, 0.f)
@@ -100,7 +76,7 @@ color_space::rgb_truecolor & color_space::rgb_truecolor::operator=(const color_s
 	return *this;
 }
 
-float color_space::rgb_truecolor::red()
+float color_space::rgb_truecolor::red() const
 {
 	return m_component_vector[0];
 }
@@ -110,7 +86,7 @@ void color_space::rgb_truecolor::red(float new_red)
 	set_component(new_red, 0);
 }
 
-float color_space::rgb_truecolor::green()
+float color_space::rgb_truecolor::green() const
 {
 	return m_component_vector[1];
 }
@@ -120,7 +96,7 @@ void color_space::rgb_truecolor::green(float new_green)
 	set_component(new_green, 1);
 }
 
-float color_space::rgb_truecolor::blue()
+float color_space::rgb_truecolor::blue() const
 {
 	return m_component_vector[2];
 }
@@ -41,7 +41,7 @@ color_space::xyy & color_space::xyy::operator=(const color_space::xyy & other)
 	return *this;
 }
 
-float color_space::xyy::x()
+float color_space::xyy::x() const
 {
 	return m_component_vector[0];
 }
@@ -51,7 +51,7 @@ void color_space::xyy::x(float new_x)
 	set_component(new_x, 0);
 }
 
-float color_space::xyy::y()
+float color_space::xyy::y() const
 {
 	return m_component_vector[1];
 }
@@ -61,7 +61,7 @@ void color_space::xyy::y(float new_y)
 	set_component(new_y, 1);
 }
 
-float color_space::xyy::Y()
+float color_space::xyy::Y() const
 {
 	return m_component_vector[2];
 }
@@ -41,7 +41,7 @@ color_space::xyz & color_space::xyz::operator=(const color_space::xyz & other)
 	return *this;
 }
 
-float color_space::xyz::x()
+float color_space::xyz::x() const
 {
 	return m_component_vector[0];
 }
@@ -51,7 +51,7 @@ void color_space::xyz::x(float new_x)
 	set_component(new_x, 0);
 }
 
-float color_space::xyz::y()
+float color_space::xyz::y() const
 {
 	return m_component_vector[1];
 }
@@ -61,7 +61,7 @@ void color_space::xyz::y(float new_y)
 	set_component(new_y, 1);
 }
 
-float color_space::xyz::z()
+float color_space::xyz::z() const
 {
 	return m_component_vector[2];
 }
@@ -51,7 +51,7 @@ namespace color_space
 
 		//! Getter for x component.
 		//! \return The x component of this color.
-		float x();
+		float x() const;
 		
 		//! Setter for x component.
 		//! \param new_x The x value to set.
@@ -59,7 +59,7 @@ namespace color_space
 
 		//! Getter for y component.
 		//! \return The y component of this color.
-		float y();
+		float y() const;
 
 		//! Setter for y component.
 		//! \param new_y The y value to set.
@@ -67,7 +67,7 @@ namespace color_space
 
 		//! Getter for z component.
 		//! \return The z component of this color.
-		float z();
+		float z() const;
 
 		//! Setter for z component.
 		//! \param new_z The z value to set.
@@ -5,11 +5,14 @@
 
 #pragma once
 
+#ifdef _WIN32
 #include "targetver.h"
 
 #define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
+#define NOMINMAX                        // Keep std::min and std::max usable
 // Windows Header Files
 #include <windows.h>
+#endif
 
 
 
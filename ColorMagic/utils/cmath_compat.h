@@ -0,0 +1,20 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+#include <cmath>
+
+//! Float functions of <cmath> that the MSVC standard library declares in namespace std but libstdc++ does not.
+/*!
+* The library uses std::powf, std::sqrtf, std::fabsf and std::fmodf. CMakeLists.txt force-includes this header if the
+* standard library lacks them, so the sources stay unchanged for Visual Studio.
+*/
+namespace std
+{
+	inline float powf(float base, float exponent) { return ::powf(base, exponent); }
+	inline float sqrtf(float value) { return ::sqrtf(value); }
+	inline float fabsf(float value) { return ::fabsf(value); }
+	inline float fmodf(float value, float divisor) { return ::fmodf(value, divisor); }
+}
@@ -6,18 +6,19 @@
 #pragma once
 
 #include "color_type.h"
-#include "..\spaces\rgb_color_space_definition.h"
-#include "..\spaces\color_base.h"
-#include "..\spaces\cmyk.h"
-#include "..\spaces\grey_deepcolor.h"
-#include "..\spaces\grey_truecolor.h"
-#include "..\spaces\hsl.h"
-#include "..\spaces\hsv.h"
-#include "..\spaces\lab.h"
-#include "..\spaces\rgb_deepcolor.h"
-#include "..\spaces\rgb_truecolor.h"
-#include "..\spaces\xyz.h"
-#include "..\manipulation\color_converter.h"
+#include "../spaces/rgb_color_space_definition.h"
+#include "../spaces/color_base.h"
+#include "../spaces/cmyk.h"
+#include "../spaces/grey_deepcolor.h"
+#include "../spaces/grey_truecolor.h"
+#include "../spaces/hsl.h"
+#include "../spaces/hsv.h"
+#include "../spaces/lab.h"
+#include "../spaces/rgb_deepcolor.h"
+#include "../spaces/rgb_truecolor.h"
+#include "../spaces/xyz.h"
+#include "../manipulation/color_converter.h"
+#include "../manipulation/conversion_cache.h"
 
 #include <string>
 
@@ -196,57 +197,66 @@ public:
 
 	//! Returns the desired color as rgb deep color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as rgb deep color.
 	*/
-	inline color_space::rgb_deepcolor* get_rgb_deep() { return color_manipulation::color_converter::to_rgb_deep(base); }
+	inline color_space::rgb_deepcolor* get_rgb_deep(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::rgb_deepcolor>(base, color_type::RGB_DEEP) : color_manipulation::color_converter::to_rgb_deep(base); }
 
 	//! Returns the desired color as grey true color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as grey true color.
 	*/
-	inline color_space::grey_truecolor* get_grey_true() { return color_manipulation::color_converter::to_grey_true(base); }
+	inline color_space::grey_truecolor* get_grey_true(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::grey_truecolor>(base, color_type::GREY_TRUE) : color_manipulation::color_converter::to_grey_true(base); }
 
 	//! Returns the desired color as grey deep color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as grey deep color.
 	*/
-	inline color_space::grey_deepcolor* get_grey_deep() { return color_manipulation::color_converter::to_grey_deep(base); }
+	inline color_space::grey_deepcolor* get_grey_deep(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::grey_deepcolor>(base, color_type::GREY_DEEP) : color_manipulation::color_converter::to_grey_deep(base); }
 
 	//! Returns the desired color as cmyk color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as cmyk color.
 	*/
-	inline color_space::cmyk* get_cmyk() { return color_manipulation::color_converter::to_cmyk(base); }
+	inline color_space::cmyk* get_cmyk(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::cmyk>(base, color_type::CMYK) : color_manipulation::color_converter::to_cmyk(base); }
 
 	//! Returns the desired color as hsv color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as hsv color.
 	*/
-	inline color_space::hsv* get_hsv() { return color_manipulation::color_converter::to_hsv(base); }
+	inline color_space::hsv* get_hsv(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::hsv>(base, color_type::HSV) : color_manipulation::color_converter::to_hsv(base); }
 
 	//! Returns the desired color as hsl color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as hsl color.
 	*/
-	inline color_space::hsl* get_hsl() { return color_manipulation::color_converter::to_hsl(base); }
+	inline color_space::hsl* get_hsl(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::hsl>(base, color_type::HSL) : color_manipulation::color_converter::to_hsl(base); }
 
 	//! Returns the desired color as xyz color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as xyz color.
 	*/
-	inline color_space::xyz* get_xyz() { return color_manipulation::color_converter::to_xyz(base); }
+	inline color_space::xyz* get_xyz(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::xyz>(base, color_type::XYZ) : color_manipulation::color_converter::to_xyz(base); }
 
 	//! Returns the desired color as xyY color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as xyY color.
 	*/
-	inline color_space::xyy* get_xyy() { return color_manipulation::color_converter::to_xyy(base); }
+	inline color_space::xyy* get_xyy(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::xyy>(base, color_type::XYY) : color_manipulation::color_converter::to_xyy(base); }
 
 	//! Returns the desired color as lab color.
 	/*!
+	* \param cache The cache that memoizes the conversion. If null the color is converted directly.
 	* \return The desired color as lab color.
 	*/
-	inline color_space::lab* get_lab() { return color_manipulation::color_converter::to_lab(base); }
+	inline color_space::lab* get_lab(color_manipulation::conversion_cache* cache = nullptr) { return cache != nullptr ? cache->convert_as<color_space::lab>(base, color_type::LAB) : color_manipulation::color_converter::to_lab(base); }
 private:
 	color_space::rgb_truecolor* base;
 };
\ No newline at end of file
@@ -0,0 +1,804 @@
+#include "stdafx.h"
+#include "css_color.h"
+#include "colors.h"
+#include "hex_color.h"
+#include "../spaces/basic_color.h"
+#include "../manipulation/conversion_plan.h"
+#include "../manipulation/stream_converter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#pragma region NAMED COLORS
+
+// The named colors of CSS. The X11 names match the HexcodeColors enum, only transparent differs (transparent black in CSS).
+struct named_color
+{
+	const char* name;
+	uint32_t argb;
+};
+
+static constexpr named_color named_colors[] = {
+	{ "aliceblue", (uint32_t)HexcodeColors::AliceBlue },
+	{ "antiquewhite", (uint32_t)HexcodeColors::AntiqueWhite },
+	{ "aqua", (uint32_t)HexcodeColors::Aqua },
+	{ "aquamarine", (uint32_t)HexcodeColors::Aquamarine },
+	{ "azure", (uint32_t)HexcodeColors::Azure },
+	{ "beige", (uint32_t)HexcodeColors::Beige },
+	{ "bisque", (uint32_t)HexcodeColors::Bisque },
+	{ "black", (uint32_t)HexcodeColors::Black },
+	{ "blanchedalmond", (uint32_t)HexcodeColors::BlanchedAlmond },
+	{ "blue", (uint32_t)HexcodeColors::Blue },
+	{ "blueviolet", (uint32_t)HexcodeColors::BlueViolet },
+	{ "brown", (uint32_t)HexcodeColors::Brown },
+	{ "burlywood", (uint32_t)HexcodeColors::BurlyWood },
+	{ "cadetblue", (uint32_t)HexcodeColors::CadetBlue },
+	{ "chartreuse", (uint32_t)HexcodeColors::Chartreuse },
+	{ "chocolate", (uint32_t)HexcodeColors::Chocolate },
+	{ "coral", (uint32_t)HexcodeColors::Coral },
+	{ "cornflowerblue", (uint32_t)HexcodeColors::CornflowerBlue },
+	{ "cornsilk", (uint32_t)HexcodeColors::Cornsilk },
+	{ "crimson", (uint32_t)HexcodeColors::Crimson },
+	{ "cyan", (uint32_t)HexcodeColors::Cyan },
+	{ "darkblue", (uint32_t)HexcodeColors::DarkBlue },
+	{ "darkcyan", (uint32_t)HexcodeColors::DarkCyan },
+	{ "darkgoldenrod", (uint32_t)HexcodeColors::DarkGoldenrod },
+	{ "darkgray", (uint32_t)HexcodeColors::DarkGray },
+	{ "darkgreen", (uint32_t)HexcodeColors::DarkGreen },
+	{ "darkgrey", (uint32_t)HexcodeColors::DarkGray },
+	{ "darkkhaki", (uint32_t)HexcodeColors::DarkKhaki },
+	{ "darkmagenta", (uint32_t)HexcodeColors::DarkMagenta },
+	{ "darkolivegreen", (uint32_t)HexcodeColors::DarkOliveGreen },
+	{ "darkorange", (uint32_t)HexcodeColors::DarkOrange },
+	{ "darkorchid", (uint32_t)HexcodeColors::DarkOrchid },
+	{ "darkred", (uint32_t)HexcodeColors::DarkRed },
+	{ "darksalmon", (uint32_t)HexcodeColors::DarkSalmon },
+	{ "darkseagreen", (uint32_t)HexcodeColors::DarkSeaGreen },
+	{ "darkslateblue", (uint32_t)HexcodeColors::DarkSlateBlue },
+	{ "darkslategray", (uint32_t)HexcodeColors::DarkSlateGray },
+	{ "darkslategrey", (uint32_t)HexcodeColors::DarkSlateGray },
+	{ "darkturquoise", (uint32_t)HexcodeColors::DarkTurquoise },
+	{ "darkviolet", (uint32_t)HexcodeColors::DarkViolet },
+	{ "deeppink", (uint32_t)HexcodeColors::DeepPink },
+	{ "deepskyblue", (uint32_t)HexcodeColors::DeepSkyBlue },
+	{ "dimgray", (uint32_t)HexcodeColors::DimGray },
+	{ "dimgrey", (uint32_t)HexcodeColors::DimGray },
+	{ "dodgerblue", (uint32_t)HexcodeColors::DodgerBlue },
+	{ "firebrick", (uint32_t)HexcodeColors::Firebrick },
+	{ "floralwhite", (uint32_t)HexcodeColors::FloralWhite },
+	{ "forestgreen", (uint32_t)HexcodeColors::ForestGreen },
+	{ "fuchsia", (uint32_t)HexcodeColors::Fuchsia },
+	{ "gainsboro", (uint32_t)HexcodeColors::Gainsboro },
+	{ "ghostwhite", (uint32_t)HexcodeColors::GhostWhite },
+	{ "gold", (uint32_t)HexcodeColors::Gold },
+	{ "goldenrod", (uint32_t)HexcodeColors::Goldenrod },
+	{ "gray", (uint32_t)HexcodeColors::Gray },
+	{ "green", (uint32_t)HexcodeColors::Green },
+	{ "greenyellow", (uint32_t)HexcodeColors::GreenYellow },
+	{ "grey", (uint32_t)HexcodeColors::Gray },
+	{ "honeydew", (uint32_t)HexcodeColors::Honeydew },
+	{ "hotpink", (uint32_t)HexcodeColors::HotPink },
+	{ "indianred", (uint32_t)HexcodeColors::IndianRed },
+	{ "indigo", (uint32_t)HexcodeColors::Indigo },
+	{ "ivory", (uint32_t)HexcodeColors::Ivory },
+	{ "khaki", (uint32_t)HexcodeColors::Khaki },
+	{ "lavender", (uint32_t)HexcodeColors::Lavender },
+	{ "lavenderblush", (uint32_t)HexcodeColors::LavenderBlush },
+	{ "lawngreen", (uint32_t)HexcodeColors::LawnGreen },
+	{ "lemonchiffon", (uint32_t)HexcodeColors::LemonChiffon },
+	{ "lightblue", (uint32_t)HexcodeColors::LightBlue },
+	{ "lightcoral", (uint32_t)HexcodeColors::LightCoral },
+	{ "lightcyan", (uint32_t)HexcodeColors::LightCyan },
+	{ "lightgoldenrodyellow", (uint32_t)HexcodeColors::LightGoldenrodYellow },
+	{ "lightgray", (uint32_t)HexcodeColors::LightGray },
+	{ "lightgreen", (uint32_t)HexcodeColors::LightGreen },
+	{ "lightgrey", (uint32_t)HexcodeColors::LightGray },
+	{ "lightpink", (uint32_t)HexcodeColors::LightPink },
+	{ "lightsalmon", (uint32_t)HexcodeColors::LightSalmon },
+	{ "lightseagreen", (uint32_t)HexcodeColors::LightSeaGreen },
+	{ "lightskyblue", (uint32_t)HexcodeColors::LightSkyBlue },
+	{ "lightslategray", (uint32_t)HexcodeColors::LightSlateGray },
+	{ "lightslategrey", (uint32_t)HexcodeColors::LightSlateGray },
+	{ "lightsteelblue", (uint32_t)HexcodeColors::LightSteelBlue },
+	{ "lightyellow", (uint32_t)HexcodeColors::LightYellow },
+	{ "lime", (uint32_t)HexcodeColors::Lime },
+	{ "limegreen", (uint32_t)HexcodeColors::LimeGreen },
+	{ "linen", (uint32_t)HexcodeColors::Linen },
+	{ "magenta", (uint32_t)HexcodeColors::Magenta },
+	{ "maroon", (uint32_t)HexcodeColors::Maroon },
+	{ "mediumaquamarine", (uint32_t)HexcodeColors::MediumAquamarine },
+	{ "mediumblue", (uint32_t)HexcodeColors::MediumBlue },
+	{ "mediumorchid", (uint32_t)HexcodeColors::MediumOrchid },
+	{ "mediumpurple", (uint32_t)HexcodeColors::MediumPurple },
+	{ "mediumseagreen", (uint32_t)HexcodeColors::MediumSeaGreen },
+	{ "mediumslateblue", (uint32_t)HexcodeColors::MediumSlateBlue },
+	{ "mediumspringgreen", (uint32_t)HexcodeColors::MediumSpringGreen },
+	{ "mediumturquoise", (uint32_t)HexcodeColors::MediumTurquoise },
+	{ "mediumvioletred", (uint32_t)HexcodeColors::MediumVioletRed },
+	{ "midnightblue", (uint32_t)HexcodeColors::MidnightBlue },
+	{ "mintcream", (uint32_t)HexcodeColors::MintCream },
+	{ "mistyrose", (uint32_t)HexcodeColors::MistyRose },
+	{ "moccasin", (uint32_t)HexcodeColors::Moccasin },
+	{ "navajowhite", (uint32_t)HexcodeColors::NavajoWhite },
+	{ "navy", (uint32_t)HexcodeColors::Navy },
+	{ "oldlace", (uint32_t)HexcodeColors::OldLace },
+	{ "olive", (uint32_t)HexcodeColors::Olive },
+	{ "olivedrab", (uint32_t)HexcodeColors::OliveDrab },
+	{ "orange", (uint32_t)HexcodeColors::Orange },
+	{ "orangered", (uint32_t)HexcodeColors::OrangeRed },
+	{ "orchid", (uint32_t)HexcodeColors::Orchid },
+	{ "palegoldenrod", (uint32_t)HexcodeColors::PaleGoldenrod },
+	{ "palegreen", (uint32_t)HexcodeColors::PaleGreen },
+	{ "paleturquoise", (uint32_t)HexcodeColors::PaleTurquoise },
+	{ "palevioletred", (uint32_t)HexcodeColors::PaleVioletRed },
+	{ "papayawhip", (uint32_t)HexcodeColors::PapayaWhip },
+	{ "peachpuff", (uint32_t)HexcodeColors::PeachPuff },
+	{ "peru", (uint32_t)HexcodeColors::Peru },
+	{ "pink", (uint32_t)HexcodeColors::Pink },
+	{ "plum", (uint32_t)HexcodeColors::Plum },
+	{ "powderblue", (uint32_t)HexcodeColors::PowderBlue },
+	{ "purple", (uint32_t)HexcodeColors::Purple },
+	{ "rebeccapurple", 0xFF663399 },
+	{ "red", (uint32_t)HexcodeColors::Red },
+	{ "rosybrown", (uint32_t)HexcodeColors::RosyBrown },
+	{ "royalblue", (uint32_t)HexcodeColors::RoyalBlue },
+	{ "saddlebrown", (uint32_t)HexcodeColors::SaddleBrown },
+	{ "salmon", (uint32_t)HexcodeColors::Salmon },
+	{ "sandybrown", (uint32_t)HexcodeColors::SandyBrown },
+	{ "seagreen", (uint32_t)HexcodeColors::SeaGreen },
+	{ "seashell", (uint32_t)HexcodeColors::SeaShell },
+	{ "sienna", (uint32_t)HexcodeColors::Sienna },
+	{ "silver", (uint32_t)HexcodeColors::Silver },
+	{ "skyblue", (uint32_t)HexcodeColors::SkyBlue },
+	{ "slateblue", (uint32_t)HexcodeColors::SlateBlue },
+	{ "slategray", (uint32_t)HexcodeColors::SlateGray },
+	{ "slategrey", (uint32_t)HexcodeColors::SlateGray },
+	{ "snow", (uint32_t)HexcodeColors::Snow },
+	{ "springgreen", (uint32_t)HexcodeColors::SpringGreen },
+	{ "steelblue", (uint32_t)HexcodeColors::SteelBlue },
+	{ "tan", (uint32_t)HexcodeColors::Tan },
+	{ "teal", (uint32_t)HexcodeColors::Teal },
+	{ "thistle", (uint32_t)HexcodeColors::Thistle },
+	{ "tomato", (uint32_t)HexcodeColors::Tomato },
+	{ "transparent", 0x00000000 },
+	{ "turquoise", (uint32_t)HexcodeColors::Turquoise },
+	{ "violet", (uint32_t)HexcodeColors::Violet },
+	{ "wheat", (uint32_t)HexcodeColors::Wheat },
+	{ "white", (uint32_t)HexcodeColors::White },
+	{ "whitesmoke", (uint32_t)HexcodeColors::WhiteSmoke },
+	{ "yellow", (uint32_t)HexcodeColors::Yellow },
+	{ "yellowgreen", (uint32_t)HexcodeColors::YellowGreen }
+};
+static constexpr size_t named_color_count = sizeof(named_colors) / sizeof(named_colors[0]);
+
+// Seed and table size of the perfect hash. The seed was searched offline so that no two names share a slot,
+// the static_assert below rejects the table at compile time if a name is added that collides.
+static const uint32_t name_hash_seed = 29959;
+static const uint32_t name_slot_bits = 10;
+
+// FNV-1a hash of the lower case name, starting with name_hash_seed instead of the FNV offset basis
+static constexpr uint32_t hash_name(const char* name, size_t length)
+{
+	uint32_t hash = name_hash_seed;
+	for (size_t i = 0; i < length; ++i)
+	{
+		uint32_t character = (uint8_t)name[i];
+		if (character >= 'A' && character <= 'Z') character += 'a' - 'A';
+		hash = (hash ^ character) * 16777619u;
+	}
+	return hash >> (32 - name_slot_bits);
+}
+
+static constexpr size_t name_length(const char* name)
+{
+	size_t length = 0;
+	while (name[length] != '\0') ++length;
+	return length;
+}
+
+// Slot table of the perfect hash. Each slot holds the index of a named color plus one, or 0 if it is empty.
+struct named_color_slots
+{
+	uint8_t slots[1 << name_slot_bits];
+	bool has_collision;
+
+	constexpr named_color_slots() : slots(), has_collision(false)
+	{
+		for (size_t i = 0; i < named_color_count; ++i)
+		{
+			uint32_t slot = hash_name(named_colors[i].name, name_length(named_colors[i].name));
+			if (slots[slot] != 0) has_collision = true;
+			slots[slot] = (uint8_t)(i + 1);
+		}
+	}
+};
+static constexpr named_color_slots name_slots;
+static_assert(!name_slots.has_collision, "Two named colors share a slot, search a new name_hash_seed.");
+
+#pragma endregion
+
+#pragma region TOKENIZER
+
+// Kinds of function arguments
+enum argument_kind
+{
+	NUMBER_ARGUMENT = 0,
+	PERCENT_ARGUMENT,
+	ANGLE_ARGUMENT,
+	NONE_ARGUMENT
+};
+
+// A function argument. Angles are stored in degrees.
+struct argument
+{
+	float value;
+	argument_kind kind;
+};
+
+// Reads the input from left to right
+struct cursor
+{
+	const char* position;
+	const char* end;
+
+	bool at_end() const { return position >= end; }
+
+	char peek() const { return at_end() ? '\0' : *position; }
+
+	void skip_space()
+	{
+		while (!at_end() && (*position == ' ' || *position == '\t' || *position == '\n' || *position == '\r' || *position == '\f')) ++position;
+	}
+
+	// Skips white space and consumes the character if it follows
+	bool consume(char character)
+	{
+		skip_space();
+		if (peek() != character) return false;
+		++position;
+		return true;
+	}
+};
+
+static bool is_digit(char character)
+{
+	return character >= '0' && character <= '9';
+}
+
+static bool is_identifier_char(char character)
+{
+	return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') || is_digit(character) || character == '-' || character == '_';
+}
+
+// Compares a range with a lower case literal, ignoring the case of the range
+static bool equals_lower(const char* text, size_t length, const char* lower)
+{
+	for (size_t i = 0; i < length; ++i)
+	{
+		char character = text[i];
+		if (character >= 'A' && character <= 'Z') character += 'a' - 'A';
+		if (lower[i] == '\0' || character != lower[i]) return false;
+	}
+	return lower[length] == '\0';
+}
+
+// Reads an identifier and returns its length, 0 if there is none
+static size_t read_identifier(cursor& input)
+{
+	const char* start = input.position;
+	while (!input.at_end() && is_identifier_char(*input.position)) ++input.position;
+	return (size_t)(input.position - start);
+}
+
+// Consumes the given lower case identifier if it follows directly
+static bool consume_identifier(cursor& input, const char* lower)
+{
+	cursor copy = input;
+	const char* start = copy.position;
+	size_t length = read_identifier(copy);
+	if (length == 0 || !equals_lower(start, length, lower)) return false;
+	input = copy;
+	return true;
+}
+
+// Reads a number like 12, -0.5, .25 or 1e3 without the locale dependent and null terminated strtof
+static bool read_number(cursor& input, float& value)
+{
+	const char* p = input.position;
+	const char* end = input.end;
+	bool negative = false;
+	if (p < end && (*p == '+' || *p == '-'))
+	{
+		negative = *p == '-';
+		++p;
+	}
+
+	double mantissa = 0.0;
+	int exponent = 0;
+	int digits = 0;
+	for (; p < end && is_digit(*p); ++p, ++digits) mantissa = mantissa * 10.0 + (*p - '0');
+	if (p < end && *p == '.')
+	{
+		for (++p; p < end && is_digit(*p); ++p, ++digits, --exponent) mantissa = mantissa * 10.0 + (*p - '0');
+	}
+	if (digits == 0) return false;
+
+	// An exponent needs digits, otherwise the e belongs to a unit
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		const char* q = p + 1;
+		bool negative_exponent = false;
+		if (q < end && (*q == '+' || *q == '-'))
+		{
+			negative_exponent = *q == '-';
+			++q;
+		}
+		if (q < end && is_digit(*q))
+		{
+			int value_exponent = 0;
+			for (; q < end && is_digit(*q); ++q) value_exponent = std::min(value_exponent * 10 + (*q - '0'), 1000);
+			exponent += negative_exponent ? -value_exponent : value_exponent;
+			p = q;
+		}
+	}
+
+	double result = exponent == 0 ? mantissa : mantissa * std::pow(10.0, exponent);
+	value = (float)(negative ? -result : result);
+	input.position = p;
+	return true;
+}
+
+// Reads a number with an optional unit or the keyword none
+static bool read_argument(cursor& input, argument& result)
+{
+	input.skip_space();
+	if (consume_identifier(input, "none"))
+	{
+		result = { 0.f, NONE_ARGUMENT };
+		return true;
+	}
+	if (!read_number(input, result.value)) return false;
+
+	result.kind = NUMBER_ARGUMENT;
+	if (input.peek() == '%')
+	{
+		++input.position;
+		result.kind = PERCENT_ARGUMENT;
+	}
+	else if (consume_identifier(input, "deg"))
+	{
+		result.kind = ANGLE_ARGUMENT;
+	}
+	else if (consume_identifier(input, "rad"))
+	{
+		result.kind = ANGLE_ARGUMENT;
+		result.value *= (float)(180.0 / M_PI);
+	}
+	else if (consume_identifier(input, "grad"))
+	{
+		result.kind = ANGLE_ARGUMENT;
+		result.value *= 0.9f;
+	}
+	else if (consume_identifier(input, "turn"))
+	{
+		result.kind = ANGLE_ARGUMENT;
+		result.value *= 360.f;
+	}
+
+	// Other units (e.g. 10px) are invalid
+	return !is_identifier_char(input.peek());
+}
+
+// Reads the arguments after the opening parenthesis up to and including the closing one.
+// Accepts "a b c / alpha" and, if allowed, the legacy syntax "a, b, c, alpha".
+static bool read_arguments(cursor& input, argument* arguments, bool allow_legacy, argument& alpha)
+{
+	if (!read_argument(input, arguments[0])) return false;
+
+	input.skip_space();
+	bool legacy = allow_legacy && input.peek() == ',';
+	for (int i = 1; i < 3; ++i)
+	{
+		if (legacy && !input.consume(',')) return false;
+		if (!read_argument(input, arguments[i])) return false;
+	}
+
+	alpha = { 1.f, NUMBER_ARGUMENT };
+	if (legacy ? input.consume(',') : input.consume('/'))
+	{
+		if (!read_argument(input, alpha) || alpha.kind == ANGLE_ARGUMENT) return false;
+	}
+	return input.consume(')');
+}
+
+#pragma endregion
+
+#pragma region VALUES
+
+// Returns the value of a non-hue argument, percentages are relative to the given reference
+static bool resolve(const argument& value, float percent_reference, float& result)
+{
+	if (value.kind == ANGLE_ARGUMENT) return false;
+	result = value.kind == PERCENT_ARGUMENT ? value.value / 100.f * percent_reference : value.value;
+	return true;
+}
+
+// Returns the hue of an argument in degrees in the range [0, 360)
+static bool resolve_hue(const argument& value, float& result)
+{
+	if (value.kind == PERCENT_ARGUMENT) return false;
+	result = std::fmod(value.value, 360.f);
+	if (result < 0.f) result += 360.f;
+	return true;
+}
+
+static float clamp(float value, float min, float max)
+{
+	return std::min(std::max(value, min), max);
+}
+
+static css_color make_color(color_type type, float c1, float c2, float c3, const argument& alpha, color_space::rgb_color_space_definition* color_space)
+{
+	float alpha_value = alpha.kind == PERCENT_ARGUMENT ? alpha.value / 100.f : alpha.value;
+	return { type, { c1, c2, c3, 0.f }, clamp(alpha_value, 0.f, 1.f), color_space };
+}
+
+static css_color make_color(uint32_t argb)
+{
+	argument alpha = { ((argb >> 24) & 0xFF) / 255.f, NUMBER_ARGUMENT };
+	return make_color(color_type::RGB_DEEP, ((argb >> 16) & 0xFF) / 255.f, ((argb >> 8) & 0xFF) / 255.f, (argb & 0xFF) / 255.f, alpha, css_color_parser::srgb());
+}
+
+// The hsl to rgb conversion of the CSS specification
+static void hsl_to_rgb(float hue, float saturation, float lightness, float* rgb)
+{
+	float a = saturation * std::min(lightness, 1.f - lightness);
+	const float offsets[3] = { 0.f, 8.f, 4.f };
+	for (int i = 0; i < 3; ++i)
+	{
+		float k = std::fmod(offsets[i] + hue / 30.f, 12.f);
+		rgb[i] = lightness - a * std::max(-1.f, std::min(std::min(k - 3.f, 9.f - k), 1.f));
+	}
+}
+
+// Reads a hex code after the '#'. CSS puts alpha last (#RGBA, #RRGGBBAA).
+static bool read_hex(cursor& input, css_color& color)
+{
+	const char* start = input.position;
+	size_t length = read_identifier(input);
+
+	uint32_t argb;
+	if (length == 3 || length == 6)
+	{
+		if (!hex_color::try_parse(start, length, argb)) return false;
+	}
+	else if (length == 4 || length == 8)
+	{
+		char expanded[8];
+		for (size_t i = 0; i < 8; ++i) expanded[i] = length == 8 ? start[i] : start[i / 2];
+
+		// Parsed as AARRGGBB the value is 0xRRGGBBAA, move alpha to the top
+		uint32_t rgba;
+		if (!hex_color::try_parse(expanded, 8, rgba)) return false;
+		argb = (rgba >> 8) | (rgba << 24);
+	}
+	else
+	{
+		return false;
+	}
+
+	color = make_color(argb);
+	return true;
+}
+
+// Reads the arguments of a color function
+static bool read_function(cursor& input, const char* name, size_t name_length, css_color& color)
+{
+	argument arguments[3];
+	argument alpha;
+	bool legacy_name = equals_lower(name, name_length, "rgb") || equals_lower(name, name_length, "rgba") || equals_lower(name, name_length, "hsl") || equals_lower(name, name_length, "hsla");
+	if (equals_lower(name, name_length, "color"))
+	{
+		input.skip_space();
+		const char* space_name = input.position;
+		size_t space_length = read_identifier(input);
+		color_space::rgb_color_space_definition* color_space = nullptr;
+		if (equals_lower(space_name, space_length, "srgb")) color_space = css_color_parser::srgb();
+		else if (equals_lower(space_name, space_length, "display-p3")) color_space = css_color_parser::display_p3();
+		else return false;
+
+		float rgb[3];
+		if (!read_arguments(input, arguments, false, alpha)) return false;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (!resolve(arguments[i], 1.f, rgb[i])) return false;
+		}
+		color = make_color(color_type::RGB_DEEP, rgb[0], rgb[1], rgb[2], alpha, color_space);
+		return true;
+	}
+
+	if (!read_arguments(input, arguments, legacy_name, alpha)) return false;
+
+	if (equals_lower(name, name_length, "rgb") || equals_lower(name, name_length, "rgba"))
+	{
+		float rgb[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			if (!resolve(arguments[i], 255.f, rgb[i])) return false;
+			rgb[i] = clamp(rgb[i], 0.f, 255.f) / 255.f;
+		}
+		color = make_color(color_type::RGB_DEEP, rgb[0], rgb[1], rgb[2], alpha, css_color_parser::srgb());
+		return true;
+	}
+
+	if (equals_lower(name, name_length, "hsl") || equals_lower(name, name_length, "hsla") || equals_lower(name, name_length, "hwb"))
+	{
+		// Saturation, lightness, whiteness and blackness may be given as percentages or plain numbers (0-100)
+		float hue, first, second;
+		if (!resolve_hue(arguments[0], hue) || !resolve(arguments[1], 100.f, first) || !resolve(arguments[2], 100.f, second)) return false;
+		first = clamp(first / 100.f, 0.f, 1.f);
+		second = clamp(second / 100.f, 0.f, 1.f);
+
+		float rgb[3];
+		if (equals_lower(name, name_length, "hwb"))
+		{
+			if (first + second >= 1.f)
+			{
+				float grey = first / (first + second);
+				rgb[0] = rgb[1] = rgb[2] = grey;
+			}
+			else
+			{
+				hsl_to_rgb(hue, 1.f, 0.5f, rgb);
+				for (int i = 0; i < 3; ++i) rgb[i] = rgb[i] * (1.f - first - second) + first;
+			}
+		}
+		else
+		{
+			hsl_to_rgb(hue, first, second, rgb);
+		}
+		color = make_color(color_type::RGB_DEEP, rgb[0], rgb[1], rgb[2], alpha, css_color_parser::srgb());
+		return true;
+	}
+
+	if (equals_lower(name, name_length, "lab") || equals_lower(name, name_length, "lch"))
+	{
+		bool polar = equals_lower(name, name_length, "lch");
+		float lightness, second, third;
+		if (!resolve(arguments[0], 100.f, lightness)) return false;
+		lightness = clamp(lightness, 0.f, 100.f);
+		if (polar)
+		{
+			// lch(L C H), 100% chroma is 150
+			float chroma, hue;
+			if (!resolve(arguments[1], 150.f, chroma) || !resolve_hue(arguments[2], hue)) return false;
+			chroma = std::max(chroma, 0.f);
+			second = chroma * std::cos(hue * (float)(M_PI / 180.0));
+			third = chroma * std::sin(hue * (float)(M_PI / 180.0));
+		}
+		else
+		{
+			// lab(L a b), 100% of a and b is 125
+			if (!resolve(arguments[1], 125.f, second) || !resolve(arguments[2], 125.f, third)) return false;
+		}
+		color = make_color(color_type::LAB, lightness, second, third, alpha, css_color_parser::lab_d50());
+		return true;
+	}
+
+	return false;
+}
+
+// Reads a hex code, a named color or a color function
+static bool read_color(cursor& input, css_color& color)
+{
+	input.skip_space();
+	if (input.peek() == '#')
+	{
+		++input.position;
+		return read_hex(input, color);
+	}
+
+	const char* name = input.position;
+	size_t length = read_identifier(input);
+	if (length == 0) return false;
+
+	// No white space is allowed between the function name and the parenthesis
+	if (input.peek() == '(')
+	{
+		++input.position;
+		return read_function(input, name, length, color);
+	}
+
+	uint32_t argb;
+	if (!css_color_parser::find_named_color(name, length, argb)) return false;
+	color = make_color(argb);
+	return true;
+}
+
+// Calls the function with the space tag of the given color type
+template <typename Function> static css_color dispatch(color_type type, Function function)
+{
+	switch (type)
+	{
+	case color_type::RGB_TRUE: return function(color_space::rgb_true_space());
+	case color_type::RGB_DEEP: return function(color_space::rgb_deep_space());
+	case color_type::GREY_TRUE: return function(color_space::grey_true_space());
+	case color_type::GREY_DEEP: return function(color_space::grey_deep_space());
+	case color_type::CMYK: return function(color_space::cmyk_space());
+	case color_type::HSI: return function(color_space::hsi_space());
+	case color_type::HSV: return function(color_space::hsv_space());
+	case color_type::HSL: return function(color_space::hsl_space());
+	case color_type::HCY: return function(color_space::hcy_space());
+	case color_type::XYZ: return function(color_space::xyz_space());
+	case color_type::XYY: return function(color_space::xyy_space());
+	case color_type::CIELUV: return function(color_space::cieluv_space());
+	case color_type::LAB: return function(color_space::lab_space());
+	case color_type::LCH_AB: return function(color_space::lch_ab_space());
+	case color_type::LCH_UV: return function(color_space::lch_uv_space());
+	default: throw new std::invalid_argument("Unsupported color type.");
+	}
+}
+
+// Copies a basic_color into a css_color
+template <typename Space> static css_color to_css_color(const color_space::basic_color<Space>& value)
+{
+	css_color result = { Space::type(), { 0.f, 0.f, 0.f, 0.f }, value.alpha(), value.get_rgb_color_space() };
+	for (size_t i = 0; i < value.component_count(); ++i) result.components[i] = value[i];
+	return result;
+}
+
+// Alpha of a fully opaque color of the given type
+static float alpha_max(color_type type)
+{
+	return type == color_type::RGB_TRUE || type == color_type::GREY_TRUE ? 255.f : 1.f;
+}
+
+#pragma endregion
+
+color_space::color_base* css_color::to_color() const
+{
+	size_t count = type == color_type::CMYK ? 4 : type == color_type::GREY_TRUE || type == color_type::GREY_DEEP ? 1 : 3;
+	float record[5];
+	std::copy(components.begin(), components.begin() + count, record);
+	record[count] = alpha;
+	return color_manipulation::stream_converter::create_color(type, record, color_space);
+}
+
+bool css_color_parser::try_parse(const char* text, size_t length, css_color& color)
+{
+	if (text == nullptr) return false;
+
+	cursor input = { text, text + length };
+	css_color result;
+	if (!read_color(input, result)) return false;
+	input.skip_space();
+	if (!input.at_end()) return false;
+
+	color = result;
+	return true;
+}
+
+bool css_color_parser::try_parse(const char* text, size_t length, color_type out_type, color_space::rgb_color_space_definition* out_space, css_color& color)
+{
+	css_color result;
+	if (!try_parse(text, length, result)) return false;
+	color = convert(result, out_type, out_space);
+	return true;
+}
+
+css_color css_color_parser::parse(const std::string& text)
+{
+	css_color result;
+	if (!try_parse(text.data(), text.size(), result)) throw new std::invalid_argument("Invalid css color.");
+	return result;
+}
+
+css_color css_color_parser::parse(const std::string& text, color_type out_type, color_space::rgb_color_space_definition* out_space)
+{
+	return convert(parse(text), out_type, out_space);
+}
+
+size_t css_color_parser::parse_list(const char* text, size_t length, color_type out_type, color_space::rgb_color_space_definition* out_space, std::vector<css_color>& out)
+{
+	if (text == nullptr && length > 0) throw new std::invalid_argument("text is null.");
+
+	size_t count = 0;
+	size_t start = 0;
+	int depth = 0;
+	for (size_t position = 0; position <= length; ++position)
+	{
+		char character = position < length ? text[position] : ';';
+		if (character == '(') ++depth;
+		if (character == ')') depth = std::max(depth - 1, 0);
+		bool separator = character == ';' || character == '\n' || character == '\r' || (character == ',' && depth == 0);
+		if (!separator) continue;
+
+		// Skip empty entries and the property names of declarations like "color: red"
+		cursor entry = { text + start, text + position };
+		for (const char* p = entry.position; p < entry.end && *p != '('; ++p)
+		{
+			if (*p == ':') entry.position = p + 1;
+		}
+		entry.skip_space();
+		if (!entry.at_end())
+		{
+			css_color color;
+			if (!try_parse(entry.position, (size_t)(entry.end - entry.position), out_type, out_space, color))
+			{
+				throw new std::invalid_argument("Invalid css color at position " + std::to_string(entry.position - text) + ".");
+			}
+			out.push_back(color);
+			++count;
+		}
+		start = position + 1;
+		depth = 0;
+	}
+	return count;
+}
+
+css_color css_color_parser::convert(const css_color& color, color_type out_type, color_space::rgb_color_space_definition* out_space)
+{
+	if (out_space == nullptr || color.color_space == nullptr) throw new std::invalid_argument("rgb color space definition is null.");
+	if (!color_manipulation::conversion_plan::is_supported(color.type)) throw new std::invalid_argument("Unsupported color type.");
+
+	// The plan does the colorimetric part including the chromatic adaptation, the other types are derived from rgb deep
+	bool direct = color_manipulation::conversion_plan::is_supported(out_type);
+	auto plan = color_manipulation::conversion_plan::get(color.type, color.color_space, direct ? out_type : color_type::RGB_DEEP, out_space);
+	float components[3] = { color.components[0], color.components[1], color.components[2] };
+	plan->execute(components);
+	float alpha = color.alpha / alpha_max(color.type);
+
+	return dispatch(out_type, [&](auto tag)
+	{
+		typedef decltype(tag) space;
+		if (direct)
+		{
+			typename color_space::basic_color<space>::component_array values = {};
+			for (size_t i = 0; i < std::min<size_t>(values.size(), 3); ++i) values[i] = components[i];
+			return to_css_color(color_space::basic_color<space>(values, alpha * color_space::basic_color<space>::alpha_max(), out_space));
+		}
+
+		color_space::basic_color<color_space::rgb_deep_space> rgb({ components[0], components[1], components[2] }, alpha, out_space);
+		return to_css_color(color_space::convert<space>(rgb));
+	});
+}
+
+bool css_color_parser::find_named_color(const char* name, size_t length, uint32_t& argb)
+{
+	if (name == nullptr || length == 0) return false;
+
+	uint8_t slot = name_slots.slots[hash_name(name, length)];
+	if (slot == 0 || !equals_lower(name, length, named_colors[slot - 1].name)) return false;
+	argb = named_colors[slot - 1].argb;
+	return true;
+}
+
+// The definitions do not own their white point and gamma curve, so both are function local objects as well
+
+color_space::rgb_color_space_definition* css_color_parser::srgb()
+{
+	static const std::unique_ptr<color_space::white_point> white(color_space::white_point_presets().D65_2Degree());
+	static const std::unique_ptr<color_space::gamma> curve(color_space::gamma_presets().sRGB());
+	static color_space::rgb_color_space_definition definition(0.64f, 0.33f, 0.3f, 0.6f, 0.15f, 0.06f, white.get(), curve.get());
+	return &definition;
+}
+
+color_space::rgb_color_space_definition* css_color_parser::display_p3()
+{
+	static const std::unique_ptr<color_space::white_point> white(color_space::white_point_presets().D65_2Degree());
+	static const std::unique_ptr<color_space::gamma> curve(color_space::gamma_presets().sRGB());
+	static color_space::rgb_color_space_definition definition(0.68f, 0.32f, 0.265f, 0.69f, 0.15f, 0.06f, white.get(), curve.get());
+	return &definition;
+}
+
+color_space::rgb_color_space_definition* css_color_parser::lab_d50()
+{
+	// Lab colors only use the D50 white point. The primaries and the gamma curve are the ones of the D50 based
+	// ProPhoto RGB, so a parsed lab color that is converted to rgb gives ProPhoto RGB values.
+	static const std::unique_ptr<color_space::white_point> white(color_space::white_point_presets().D50_2Degree());
+	static const std::unique_ptr<color_space::gamma> curve(color_space::gamma_presets().gamma1_8());
+	static color_space::rgb_color_space_definition definition(0.7347f, 0.2653f, 0.1596f, 0.8404f, 0.0366f, 0.0001f, white.get(), curve.get());
+	return &definition;
+}
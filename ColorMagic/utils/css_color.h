@@ -0,0 +1,120 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "color_type.h"
+#include "../spaces/color_base.h"
+#include "../spaces/rgb_color_space_definition.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! Color value produced by the css_color_parser.
+/*!
+* Plain value type without allocations. The components and alpha use the ranges of the dynamic color class of the
+* color type, e.g. 0-255 for rgb truecolors and 0-1 for rgb deep colors. Unused components are 0.
+*/
+struct css_color
+{
+	color_type type; /*!< The color type of the components */
+	std::array<float, 4> components; /*!< The components in the order of the dynamic color class */
+	float alpha; /*!< The alpha value */
+	color_space::rgb_color_space_definition* color_space; /*!< The rgb color space definition the components refer to */
+
+	//! Creates a dynamic color with the components of this value. The caller owns the returned color.
+	color_space::color_base* to_color() const;
+};
+
+//! Parser for CSS Color Module Level 4 color values.
+/*!
+* Supported values are hex codes (#RGB, #RGBA, #RRGGBB, #RRGGBBAA), the named colors including transparent, and
+* the functions rgb(), rgba(), hsl(), hsla(), hwb(), lab(), lch() and color() with the srgb and display-p3 color
+* spaces. Functions accept the space separated syntax with an optional "/ alpha" as well as the legacy comma
+* separated syntax, numbers, percentages, angles (deg, rad, grad, turn) and the keyword none. Names and functions
+* are case insensitive.
+*
+* Following CSS, hex codes, named colors, rgb(), hsl() and hwb() are sRGB colors, lab() and lch() are CIE Lab
+* colors relative to D50. Without an output type the parser returns rgb deep colors in srgb() or display_p3() and
+* lab colors in lab_d50(). With an output type the value is converted in the same step by a conversion_plan
+* (with chromatic adaptation if the white points differ) and clamped to the ranges of the output type.
+*
+* The input is read once from left to right without copying it or allocating memory.
+*/
+class css_color_parser
+{
+public:
+	//! Parses a single color value.
+	/*!
+	* Leading and trailing white space is ignored.
+	* \param text The first character of the value.
+	* \param length The number of characters of the value.
+	* \param color The parsed color. Unchanged if the value is invalid.
+	* \return True if the value was valid.
+	*/
+	static bool try_parse(const char* text, size_t length, css_color& color);
+
+	//! Parses a single color value and converts it to the given color type.
+	/*!
+	* \param text The first character of the value.
+	* \param length The number of characters of the value.
+	* \param out_type The color type of the result.
+	* \param out_space The rgb color space definition of the result.
+	* \param color The parsed and converted color. Unchanged if the value is invalid.
+	* \return True if the value was valid.
+	*/
+	static bool try_parse(const char* text, size_t length, color_type out_type, color_space::rgb_color_space_definition* out_space, css_color& color);
+
+	//! Parses a single color value. Throws std::invalid_argument* if the value is invalid.
+	static css_color parse(const std::string& text);
+
+	//! Parses a single color value and converts it. Throws std::invalid_argument* if the value is invalid.
+	static css_color parse(const std::string& text, color_type out_type, color_space::rgb_color_space_definition* out_space);
+
+	//! Parses a list of color values, e.g. the values of a stylesheet.
+	/*!
+	* Values are separated by semicolons, line breaks or commas outside of parentheses, empty values are skipped.
+	* Throws std::invalid_argument* with the position of the first invalid value, the colors before it have been
+	* appended in that case.
+	* \param text The first character of the list.
+	* \param length The number of characters of the list.
+	* \param out_type The color type of the results.
+	* \param out_space The rgb color space definition of the results.
+	* \param out The container the colors are appended to. Reserve space in advance to avoid allocations.
+	* \return The number of parsed colors.
+	*/
+	static size_t parse_list(const char* text, size_t length, color_type out_type, color_space::rgb_color_space_definition* out_space, std::vector<css_color>& out);
+
+	//! Converts a parsed color to another color type and rgb color space.
+	/*!
+	* \param color The color to convert. Its color type has to be one of the types returned by the parser.
+	* \param out_type The color type of the result.
+	* \param out_space The rgb color space definition of the result.
+	* \return The converted color, clamped to the ranges of the output type.
+	*/
+	static css_color convert(const css_color& color, color_type out_type, color_space::rgb_color_space_definition* out_space);
+
+	//! Looks up a named color.
+	/*!
+	* The names are resolved with a perfect hash, so a lookup costs one hash calculation and one string compare.
+	* \param name The first character of the name.
+	* \param length The number of characters of the name.
+	* \param argb The color in the format 0xAARRGGBB. Unchanged if the name is unknown.
+	* \return True if the name is known.
+	*/
+	static bool find_named_color(const char* name, size_t length, uint32_t& argb);
+
+	//! Returns the sRGB definition of the parsed sRGB colors.
+	static color_space::rgb_color_space_definition* srgb();
+
+	//! Returns the Display P3 definition of the parsed color(display-p3 ...) colors.
+	static color_space::rgb_color_space_definition* display_p3();
+
+	//! Returns the D50 based definition of the parsed lab() and lch() colors.
+	static color_space::rgb_color_space_definition* lab_d50();
+};
@@ -0,0 +1,65 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+#include <functional>
+#include <algorithm>
+
+//! Interface for objects that run loops over index ranges.
+/*!
+* The batch functions of the library do not start threads on their own. Instead they hand their work
+* to an executor. This way callers can plug in their own scheduler (e.g. the one of their application
+* server) by implementing parallel_for(). The library ships a sequential_executor and a work-stealing
+* thread_pool.
+*/
+class executor
+{
+public:
+	//! Default deconstructor.
+	virtual ~executor() {}
+
+	//! Returns the number of threads that work on a parallel_for() call at the same time.
+	virtual size_t get_thread_count() const = 0;
+
+	//! Calls the given body for all indices in [begin, end).
+	/*!
+	* The range is split into chunks of at least grain_size indices and each chunk is handed to the body as a
+	* half open range [chunk_begin, chunk_end). Chunks may run concurrently and in any order. The function
+	* returns after all chunks are done. If the body throws, the first exception is rethrown on the calling thread.
+	* \param begin The first index.
+	* \param end The index after the last one.
+	* \param body The function to call for each chunk.
+	* \param grain_size The minimal number of indices per chunk. If 0 the executor chooses a size on its own.
+	*/
+	virtual void parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain_size = 0) = 0;
+
+	//! Calculates a chunk size for the given range.
+	/*!
+	* Aims for about four chunks per thread so that threads which finish early can take over work of slower
+	* ones without creating too much scheduling overhead for cheap bodies.
+	* \param count The number of indices in the range.
+	* \param thread_count The number of threads working on the range.
+	* \return The number of indices per chunk (at least 1).
+	*/
+	static size_t automatic_grain_size(size_t count, size_t thread_count)
+	{
+		return std::max<size_t>(1, count / (std::max<size_t>(1, thread_count) * 4));
+	}
+};
+
+//! Executor that runs everything on the calling thread.
+/*!
+* Useful for debugging and for callers that already parallelize on a higher level.
+*/
+class sequential_executor : public executor
+{
+public:
+	size_t get_thread_count() const override { return 1; }
+
+	void parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t /*grain_size*/ = 0) override
+	{
+		if (begin < end) body(begin, end);
+	}
+};
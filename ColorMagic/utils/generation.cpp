@@ -0,0 +1,11 @@
+#include "stdafx.h"
+#include "generation.h"
+
+#include <atomic>
+
+uint64_t generation::next()
+{
+	// Defined here instead of inline, so the library and all modules that use it share the same counter
+	static std::atomic<uint64_t> counter(0);
+	return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
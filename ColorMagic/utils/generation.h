@@ -0,0 +1,21 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include <cstdint>
+
+//! Static class that hands out process wide unique generation numbers.
+/*!
+* Objects that are used as cache keys (e.g. the rgb color space definitions) stamp every state they are in with a new
+* number. Unlike addresses the numbers are never reused, so a cache entry can neither match a changed object nor an
+* object that was created at the address of a deleted one.
+*/
+class generation
+{
+public:
+	//! Returns a number that has not been returned before. Never 0, so 0 can mark "no generation".
+	static uint64_t next();
+};
@@ -0,0 +1,125 @@
+#include "stdafx.h"
+#include "half.h"
+
+#include <cstring>
+
+#if defined(__F16C__) || defined(__AVX2__)
+#define COLOR_MAGIC_F16C
+#include <immintrin.h>
+#endif
+
+uint16_t half::from_float(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(float));
+
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t exponent = (bits >> 23) & 0xFF;
+	uint32_t mantissa = bits & 0x7FFFFF;
+
+	// Infinity and NaN (NaN stays quiet and keeps the highest payload bits)
+	if (exponent == 0xFF) return (uint16_t)(sign | 0x7C00 | (mantissa != 0 ? 0x200 | (mantissa >> 13) : 0));
+
+	int32_t half_exponent = (int32_t)exponent - 127 + 15;
+
+	// Overflow rounds to infinity
+	if (half_exponent >= 31) return (uint16_t)(sign | 0x7C00);
+
+	uint32_t shift;
+	uint32_t result;
+	if (half_exponent <= 0)
+	{
+		// Subnormal half or zero
+		if (half_exponent < -10) return (uint16_t)sign;
+		mantissa |= 0x800000;
+		shift = (uint32_t)(14 - half_exponent);
+		result = sign;
+	}
+	else
+	{
+		shift = 13;
+		result = sign | ((uint32_t)half_exponent << 10);
+	}
+
+	// Round to nearest, ties to even. A carry into the exponent is correct, also from subnormal to normal.
+	uint32_t truncated = mantissa >> shift;
+	uint32_t remainder = mantissa & ((1u << shift) - 1);
+	uint32_t halfway = 1u << (shift - 1);
+	result += truncated;
+	if (remainder > halfway || (remainder == halfway && (truncated & 1))) ++result;
+	return (uint16_t)result;
+}
+
+float half::to_float(uint16_t bits)
+{
+	uint32_t sign = (uint32_t)(bits & 0x8000) << 16;
+	uint32_t exponent = (bits >> 10) & 0x1F;
+	uint32_t mantissa = bits & 0x3FF;
+
+	uint32_t result;
+	if (exponent == 0)
+	{
+		if (mantissa == 0)
+		{
+			result = sign;
+		}
+		else
+		{
+			// Normalize the subnormal value
+			exponent = 127 - 15 + 1;
+			while ((mantissa & 0x400) == 0)
+			{
+				mantissa <<= 1;
+				--exponent;
+			}
+			result = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+		}
+	}
+	else if (exponent == 31)
+	{
+		result = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else
+	{
+		result = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	}
+
+	float value;
+	std::memcpy(&value, &result, sizeof(float));
+	return value;
+}
+
+void half::pack(const float* in, half* out, size_t count)
+{
+	size_t i = 0;
+#ifdef COLOR_MAGIC_F16C
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128((__m128i*)(out + i), packed);
+	}
+#endif
+	for (; i < count; ++i) out[i] = half(in[i]);
+}
+
+void half::unpack(const half* in, float* out, size_t count)
+{
+	size_t i = 0;
+#ifdef COLOR_MAGIC_F16C
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i packed = _mm_loadu_si128((const __m128i*)(in + i));
+		_mm256_storeu_ps(out + i, _mm256_cvtph_ps(packed));
+	}
+#endif
+	for (; i < count; ++i) out[i] = (float)in[i];
+}
+
+bool half::has_hardware_conversion()
+{
+#ifdef COLOR_MAGIC_F16C
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,75 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//! IEEE 754 half precision storage type.
+/*!
+* Halves are meant for storage only: they convert implicitly to and from float and all arithmetic happens in float.
+* Conversions from float round to the nearest representable value (ties to even) like the F16C instructions do.
+* pack() and unpack() convert whole buffers and use the F16C instructions if the library is compiled with them
+* (e.g. /arch:AVX2 or -mf16c).
+*/
+class half
+{
+public:
+	//! Default constructor. Creates +0.
+	constexpr half() : m_bits(0) {}
+
+	//! Creates the half that is nearest to the given value.
+	half(float value) : m_bits(from_float(value)) {}
+
+	//! Converts to float. Every half is exactly representable as float.
+	operator float() const { return to_float(m_bits); }
+
+	//! Returns the raw bits.
+	uint16_t get_bits() const { return m_bits; }
+
+	//! Creates a half from its raw bits.
+	static half from_bits(uint16_t bits)
+	{
+		half result;
+		result.m_bits = bits;
+		return result;
+	}
+
+	//! Converts a float to the bits of the nearest half.
+	static uint16_t from_float(float value);
+
+	//! Converts the bits of a half to float.
+	static float to_float(uint16_t bits);
+
+	//! Converts a buffer of floats to halves.
+	/*!
+	* \param in The input buffer.
+	* \param out The output buffer.
+	* \param count The number of values.
+	*/
+	static void pack(const float* in, half* out, size_t count);
+
+	//! Converts a buffer of halves to floats.
+	/*!
+	* \param in The input buffer.
+	* \param out The output buffer.
+	* \param count The number of values.
+	*/
+	static void unpack(const half* in, float* out, size_t count);
+
+	//! Whether pack() and unpack() use the F16C instructions.
+	static bool has_hardware_conversion();
+
+	//! Equality of the bits. Note that +0 and -0 are different and NaN equals itself.
+	friend bool operator==(const half& lhs, const half& rhs) { return lhs.m_bits == rhs.m_bits; }
+
+	//! Inequality of the bits.
+	friend bool operator!=(const half& lhs, const half& rhs) { return lhs.m_bits != rhs.m_bits; }
+
+private:
+	//! The raw bits: 1 sign bit, 5 exponent bits and 10 mantissa bits.
+	uint16_t m_bits;
+};
@@ -0,0 +1,139 @@
+#include "stdafx.h"
+#include "hex_color.h"
+
+#include <stdexcept>
+
+// Value of each hex digit, 0x10 for all other characters. Built at compile time, so it can be used during static initialization.
+struct digit_table
+{
+	uint8_t values[256];
+
+	constexpr digit_table() : values()
+	{
+		for (int i = 0; i < 256; ++i) values[i] = 0x10;
+		for (int i = 0; i < 10; ++i) values['0' + i] = (uint8_t)i;
+		for (int i = 0; i < 6; ++i)
+		{
+			values['a' + i] = (uint8_t)(10 + i);
+			values['A' + i] = (uint8_t)(10 + i);
+		}
+	}
+};
+static constexpr digit_table digits;
+
+static const char upper_digits[] = "0123456789ABCDEF";
+static const char lower_digits[] = "0123456789abcdef";
+
+bool hex_color::try_parse(const char* text, size_t length, uint32_t& argb)
+{
+	if (text == nullptr) return false;
+	if (length > 0 && text[0] == '#')
+	{
+		++text;
+		--length;
+	}
+	if (length != 3 && length != 6 && length != 8) return false;
+
+	// Collect all digits first and check the invalid flag (0x10) of all of them at once
+	uint32_t value = 0;
+	uint32_t invalid = 0;
+	for (size_t i = 0; i < length; ++i)
+	{
+		uint32_t digit = digits.values[(uint8_t)text[i]];
+		invalid |= digit;
+		value = (value << 4) | (digit & 0xF);
+	}
+	if (invalid & 0x10) return false;
+
+	if (length == 3)
+	{
+		// 0x00000RGB -> 0xFFRRGGBB
+		uint32_t r = (value >> 8) & 0xF;
+		uint32_t g = (value >> 4) & 0xF;
+		uint32_t b = value & 0xF;
+		value = (r << 20) | (r << 16) | (g << 12) | (g << 8) | (b << 4) | b;
+	}
+	argb = length == 8 ? value : value | 0xFF000000;
+	return true;
+}
+
+uint32_t hex_color::parse(const char* text, size_t length)
+{
+	uint32_t argb;
+	if (!try_parse(text, length, argb))
+	{
+		throw new std::invalid_argument("Invalid hex code. Use one of the following formats: #RGB, #RRGGBB, #AARRGGBB, RGB, RRGGBB, AARRGGBB");
+	}
+	return argb;
+}
+
+size_t hex_color::format(uint32_t argb, char* out, bool with_alpha, bool uppercase)
+{
+	const char* table = uppercase ? upper_digits : lower_digits;
+	int first_shift = with_alpha ? 28 : 20;
+	size_t length = 1;
+	out[0] = '#';
+	for (int shift = first_shift; shift >= 0; shift -= 4)
+	{
+		out[length++] = table[(argb >> shift) & 0xF];
+	}
+	return length;
+}
+
+std::string hex_color::to_string(uint32_t argb, bool with_alpha, bool uppercase)
+{
+	char buffer[max_length];
+	return std::string(buffer, format(argb, buffer, with_alpha, uppercase));
+}
+
+size_t hex_color::parse_list(const char* text, size_t length, std::vector<uint32_t>& out)
+{
+	if (text == nullptr && length > 0) throw new std::invalid_argument("text is null.");
+
+	size_t count = 0;
+	size_t position = 0;
+	while (position < length)
+	{
+		if (is_separator(text[position]))
+		{
+			++position;
+			continue;
+		}
+
+		size_t end = position;
+		while (end < length && !is_separator(text[end])) ++end;
+
+		uint32_t argb;
+		if (!try_parse(text + position, end - position, argb))
+		{
+			throw new std::invalid_argument("Invalid hex code at position " + std::to_string(position) + ".");
+		}
+		out.push_back(argb);
+		++count;
+		position = end;
+	}
+	return count;
+}
+
+void hex_color::format_list(const uint32_t* colors, size_t count, std::string& out, char separator, bool with_alpha, bool uppercase)
+{
+	if (count == 0) return;
+	if (colors == nullptr) throw new std::invalid_argument("colors is null.");
+
+	// Every code has the same length, so the final size is known in advance
+	size_t code_length = with_alpha ? 9 : 7;
+	size_t offset = out.size();
+	out.resize(offset + count * code_length + count - 1);
+
+	char* target = &out[offset];
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (i > 0) *target++ = separator;
+		target += format(colors[i], target, with_alpha, uppercase);
+	}
+}
+
+bool hex_color::is_separator(char character)
+{
+	return character == ',' || character == ';' || character == '\n' || character == '\r' || character == ' ' || character == '\t';
+}
@@ -0,0 +1,87 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! Parser and formatter for hex color codes.
+/*!
+* Hex codes are converted from and to 32 bit values in the format 0xAARRGGBB, the format of the integer
+* constructor of rgb_truecolor and of the HexcodeColors enum. Supported codes are RGB, RRGGBB and AARRGGBB,
+* each with an optional leading '#'. Codes without alpha are opaque, RGB is expanded to RRGGBB.
+*
+* The functions work on character ranges and never allocate, except for the list functions that append to a
+* container the caller passed in. Digits are decoded with a lookup table and checked once per code, so a
+* valid code does not branch per character.
+*/
+class hex_color
+{
+public:
+	//! Maximal number of characters of a formatted code (#AARRGGBB).
+	static const size_t max_length = 9;
+
+	//! Parses a single hex code.
+	/*!
+	* \param text The first character of the code.
+	* \param length The number of characters of the code.
+	* \param argb The parsed color in the format 0xAARRGGBB. Unchanged if the code is invalid.
+	* \return True if the code was valid.
+	*/
+	static bool try_parse(const char* text, size_t length, uint32_t& argb);
+
+	//! Parses a single hex code. Throws std::invalid_argument* if the code is invalid.
+	static uint32_t parse(const char* text, size_t length);
+
+	//! Parses a single hex code. Throws std::invalid_argument* if the code is invalid.
+	static uint32_t parse(const std::string& text) { return parse(text.data(), text.size()); }
+
+	//! Writes the hex code of a color.
+	/*!
+	* No terminating null character is written.
+	* \param argb The color in the format 0xAARRGGBB.
+	* \param out The output buffer. Must have space for max_length characters.
+	* \param with_alpha If true the code is written as #AARRGGBB, otherwise as #RRGGBB.
+	* \param uppercase If true the digits a-f are written as upper case letters.
+	* \return The number of written characters (7 or 9).
+	*/
+	static size_t format(uint32_t argb, char* out, bool with_alpha = false, bool uppercase = true);
+
+	//! Returns the hex code of a color. See format().
+	static std::string to_string(uint32_t argb, bool with_alpha = false, bool uppercase = true);
+
+	//! Parses a list of hex codes.
+	/*!
+	* Codes are separated by commas, semicolons, line breaks or white space, several separators in a row are
+	* treated like one. Throws std::invalid_argument* with the position of the first invalid code, the colors
+	* before it have been appended in that case.
+	* \param text The first character of the list.
+	* \param length The number of characters of the list.
+	* \param out The container the parsed colors are appended to. Reserve space in advance to avoid allocations.
+	* \return The number of parsed colors.
+	*/
+	static size_t parse_list(const char* text, size_t length, std::vector<uint32_t>& out);
+
+	//! Parses a list of hex codes. See the other overload.
+	static size_t parse_list(const std::string& text, std::vector<uint32_t>& out) { return parse_list(text.data(), text.size(), out); }
+
+	//! Formats a list of colors.
+	/*!
+	* \param colors The colors in the format 0xAARRGGBB.
+	* \param count The number of colors.
+	* \param out The string the codes are appended to. Grows once to the final size.
+	* \param separator The character between two codes.
+	* \param with_alpha If true the codes are written as #AARRGGBB, otherwise as #RRGGBB.
+	* \param uppercase If true the digits a-f are written as upper case letters.
+	*/
+	static void format_list(const uint32_t* colors, size_t count, std::string& out, char separator = ',', bool with_alpha = false, bool uppercase = true);
+
+protected:
+	//! Returns whether the character separates two codes of a list.
+	static bool is_separator(char character);
+};
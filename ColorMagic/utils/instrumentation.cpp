@@ -0,0 +1,187 @@
+#include "stdafx.h"
+#include "instrumentation.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+std::atomic<uint64_t> instrumentation::s_conversions[color_type_count][color_type_count] = {};
+std::atomic<uint64_t> instrumentation::s_colors_created(0);
+std::atomic<uint64_t> instrumentation::s_colors_destroyed(0);
+std::atomic<bool> instrumentation::s_has_timer_callback(false);
+
+namespace
+{
+	struct named_counter
+	{
+		named_counter(const char* group, const char* name) : group(group), name(name), value(0) {}
+
+		std::string group;
+		std::string name;
+		instrumentation::counter value;
+	};
+
+	// Deques never move their elements, so the references handed out stay valid
+	struct registry
+	{
+		std::mutex mutex;
+		std::deque<named_counter> counters;
+		std::deque<instrumentation::timer_entry> timers;
+		std::shared_ptr<instrumentation::timer_callback> callback;
+	};
+
+	registry& get_registry()
+	{
+		// Never destroyed, so counters can still be used by static objects that are destroyed after it
+		static registry* instance = new registry();
+		return *instance;
+	}
+
+	const char* type_name(color_type type)
+	{
+		static const char* names[] = { "RGB_TRUE", "RGB_DEEP", "GREY_TRUE", "GREY_DEEP", "CMYK", "HSI", "HSV", "HSL", "HCY", "XYZ", "XYY", "CIELUV", "LAB", "LCH_AB", "LCH_UV", "UNDEFINED" };
+		return names[(size_t)type <= (size_t)color_type::UNDEFINED ? (size_t)type : (size_t)color_type::UNDEFINED];
+	}
+}
+
+uint64_t instrumentation_snapshot::conversions_of(color_type from, color_type to) const
+{
+	for (const auto& entry : conversions)
+	{
+		if (entry.from == from && entry.to == to) return entry.count;
+	}
+	return 0;
+}
+
+uint64_t instrumentation_snapshot::operations_of(const std::string& group, const std::string& name) const
+{
+	for (const auto& entry : operations)
+	{
+		if (entry.group == group && entry.name == name) return entry.count;
+	}
+	return 0;
+}
+
+instrumentation::scoped_timer::~scoped_timer()
+{
+	uint64_t nanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+	m_entry.calls.fetch_add(1, std::memory_order_relaxed);
+	m_entry.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+	if (!s_has_timer_callback.load(std::memory_order_acquire)) return;
+	std::shared_ptr<timer_callback> callback;
+	{
+		auto& instance = get_registry();
+		std::lock_guard<std::mutex> lock(instance.mutex);
+		callback = instance.callback;
+	}
+	if (callback) (*callback)(m_entry.name.c_str(), nanoseconds);
+}
+
+instrumentation::counter& instrumentation::get_counter(const char* group, const char* name)
+{
+	if (group == nullptr || name == nullptr) throw new std::invalid_argument("Counter group and name must not be null.");
+
+	auto& instance = get_registry();
+	std::lock_guard<std::mutex> lock(instance.mutex);
+	for (auto& entry : instance.counters)
+	{
+		if (entry.group == group && entry.name == name) return entry.value;
+	}
+	instance.counters.emplace_back(group, name);
+	return instance.counters.back().value;
+}
+
+instrumentation::timer_entry& instrumentation::get_timer(const char* name)
+{
+	if (name == nullptr) throw new std::invalid_argument("Timer name must not be null.");
+
+	auto& instance = get_registry();
+	std::lock_guard<std::mutex> lock(instance.mutex);
+	for (auto& entry : instance.timers)
+	{
+		if (entry.name == name) return entry;
+	}
+	instance.timers.emplace_back();
+	auto& entry = instance.timers.back();
+	entry.name = name;
+	entry.calls = 0;
+	entry.nanoseconds = 0;
+	return entry;
+}
+
+void instrumentation::set_timer_callback(timer_callback callback)
+{
+	auto& instance = get_registry();
+	std::lock_guard<std::mutex> lock(instance.mutex);
+	instance.callback = callback ? std::make_shared<timer_callback>(callback) : nullptr;
+	s_has_timer_callback.store(callback != nullptr, std::memory_order_release);
+}
+
+instrumentation_snapshot instrumentation::snapshot()
+{
+	instrumentation_snapshot result;
+	for (size_t from = 0; from < color_type_count; ++from)
+	{
+		for (size_t to = 0; to < color_type_count; ++to)
+		{
+			uint64_t count = s_conversions[from][to].load(std::memory_order_relaxed);
+			if (count > 0) result.conversions.push_back({ (color_type)from, (color_type)to, count });
+		}
+	}
+	result.colors_created = s_colors_created.load(std::memory_order_relaxed);
+	result.colors_destroyed = s_colors_destroyed.load(std::memory_order_relaxed);
+
+	auto& instance = get_registry();
+	std::lock_guard<std::mutex> lock(instance.mutex);
+	for (const auto& entry : instance.counters)
+	{
+		uint64_t count = entry.value.load(std::memory_order_relaxed);
+		if (count > 0) result.operations.push_back({ entry.group, entry.name, count });
+	}
+	for (const auto& entry : instance.timers)
+	{
+		uint64_t calls = entry.calls.load(std::memory_order_relaxed);
+		if (calls > 0) result.timers.push_back({ entry.name, calls, entry.nanoseconds.load(std::memory_order_relaxed) });
+	}
+	return result;
+}
+
+void instrumentation::reset()
+{
+	for (auto& row : s_conversions)
+	{
+		for (auto& count : row) count.store(0, std::memory_order_relaxed);
+	}
+	s_colors_created.store(0, std::memory_order_relaxed);
+	s_colors_destroyed.store(0, std::memory_order_relaxed);
+
+	auto& instance = get_registry();
+	std::lock_guard<std::mutex> lock(instance.mutex);
+	for (auto& entry : instance.counters) entry.value.store(0, std::memory_order_relaxed);
+	for (auto& entry : instance.timers)
+	{
+		entry.calls.store(0, std::memory_order_relaxed);
+		entry.nanoseconds.store(0, std::memory_order_relaxed);
+	}
+}
+
+void instrumentation::write(const instrumentation_snapshot& snapshot, std::ostream& out)
+{
+	for (const auto& entry : snapshot.conversions)
+	{
+		out << "color_magic_conversions_total{from=\"" << type_name(entry.from) << "\",to=\"" << type_name(entry.to) << "\"} " << entry.count << "\n";
+	}
+	for (const auto& entry : snapshot.operations)
+	{
+		out << "color_magic_operations_total{group=\"" << entry.group << "\",name=\"" << entry.name << "\"} " << entry.count << "\n";
+	}
+	for (const auto& entry : snapshot.timers)
+	{
+		out << "color_magic_timer_calls_total{name=\"" << entry.name << "\"} " << entry.calls << "\n";
+		out << "color_magic_timer_seconds_total{name=\"" << entry.name << "\"} " << entry.nanoseconds / 1e9 << "\n";
+	}
+	out << "color_magic_colors_created_total " << snapshot.colors_created << "\n";
+	out << "color_magic_colors_destroyed_total " << snapshot.colors_destroyed << "\n";
+	out << "color_magic_colors_alive " << snapshot.colors_alive() << "\n";
+}
@@ -0,0 +1,189 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+#include "color_type.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! Number of conversions between two color types.
+struct conversion_count
+{
+	color_type from; /*!< The color type of the input colors */
+	color_type to; /*!< The color type of the output colors */
+	uint64_t count; /*!< The number of converted colors */
+};
+
+//! Number of calls of a named operation, e.g. a blend mode.
+struct operation_count
+{
+	std::string group; /*!< The class the operation belongs to, e.g. "color_blend" */
+	std::string name; /*!< The name of the operation, e.g. "multiply" */
+	uint64_t count; /*!< The number of calls */
+};
+
+//! Accumulated run time of a named scope.
+struct timer_total
+{
+	std::string name; /*!< The name of the timed scope */
+	uint64_t calls; /*!< The number of times the scope was left */
+	uint64_t nanoseconds; /*!< The total time spent in the scope */
+};
+
+//! Copy of all instrumentation values at one point in time.
+/*!
+* Only entries with a count above zero are part of the snapshot.
+*/
+struct instrumentation_snapshot
+{
+	std::vector<conversion_count> conversions; /*!< Conversions of the color_converter per pair of color types */
+	std::vector<operation_count> operations; /*!< Calls per blend and porter duff mode */
+	std::vector<timer_total> timers; /*!< Time spent in the timed scopes */
+	uint64_t colors_created = 0; /*!< The number of constructed color objects (color_base and derived classes) */
+	uint64_t colors_destroyed = 0; /*!< The number of destroyed color objects */
+
+	//! Returns the number of color objects that are alive. Negative if colors created before the last reset were destroyed.
+	int64_t colors_alive() const { return (int64_t)(colors_created - colors_destroyed); }
+
+	//! Returns the number of conversions from one color type to another.
+	uint64_t conversions_of(color_type from, color_type to) const;
+
+	//! Returns the number of calls of an operation.
+	uint64_t operations_of(const std::string& group, const std::string& name) const;
+};
+
+//! Static class that collects counters and timings of the library.
+/*!
+* The instrumentation is compiled in only if COLOR_MAGIC_INSTRUMENTATION is defined when the library is built. The
+* library calls all of its hooks from its own translation units, so its counters do not depend on whether client code
+* defines COLOR_MAGIC_INSTRUMENTATION. instrumentation::enabled and the hook macros that are expanded in client code
+* follow the client's own COLOR_MAGIC_INSTRUMENTATION setting. Without the definition all hooks are empty, the
+* functions of this class still exist and snapshot() returns an empty snapshot, so code that exports the values
+* compiles in both configurations.
+*
+* All counters are relaxed atomics. Batch functions add their counts once per chunk of work instead of once per color,
+* so the counters do not become a point of contention between threads.
+*/
+class instrumentation
+{
+public:
+#ifdef COLOR_MAGIC_INSTRUMENTATION
+	static const bool enabled = true;
+#else
+	static const bool enabled = false;
+#endif
+
+	//! Counter of a single operation. Returned by get_counter() and valid until the end of the program.
+	typedef std::atomic<uint64_t> counter;
+
+	//! Called with the name of a timed scope and its duration in nanoseconds every time the scope is left.
+	typedef std::function<void(const char* name, uint64_t nanoseconds)> timer_callback;
+
+	//! Accumulated values of a timed scope. Returned by get_timer() and valid until the end of the program.
+	struct timer_entry
+	{
+		std::string name;
+		std::atomic<uint64_t> calls;
+		std::atomic<uint64_t> nanoseconds;
+	};
+
+	//! Measures the time until the end of the enclosing scope.
+	/*!
+	* The duration is added to the timer entry and passed to the callback set by set_timer_callback().
+	*/
+	class scoped_timer
+	{
+	public:
+		//! Starts a timer of the given entry, see get_timer().
+		explicit scoped_timer(timer_entry& entry) : m_entry(entry), m_start(std::chrono::steady_clock::now()) {}
+
+		//! Starts a timer of the given name. Looks up the entry by name, so prefer the other constructor in hot code.
+		explicit scoped_timer(const char* name) : scoped_timer(get_timer(name)) {}
+
+		//! Stops the timer.
+		~scoped_timer();
+
+		scoped_timer(const scoped_timer&) = delete;
+		scoped_timer& operator=(const scoped_timer&) = delete;
+
+	private:
+		timer_entry& m_entry;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	//! Adds conversions from one color type to another.
+	static void add_conversions(color_type from, color_type to, uint64_t count)
+	{
+		if ((size_t)from < color_type_count && (size_t)to < color_type_count) s_conversions[from][to].fetch_add(count, std::memory_order_relaxed);
+	}
+
+	//! Counts a constructed color object.
+	static void color_created() { s_colors_created.fetch_add(1, std::memory_order_relaxed); }
+
+	//! Counts a destroyed color object.
+	static void color_destroyed() { s_colors_destroyed.fetch_add(1, std::memory_order_relaxed); }
+
+	//! Returns the counter of an operation and creates it on first use.
+	/*!
+	* The lookup locks a mutex, so call sites keep the reference in a static variable (see COLOR_MAGIC_COUNT).
+	* \param group The class the operation belongs to, e.g. "porter_duff".
+	* \param name The name of the operation, e.g. "over".
+	* \return The counter.
+	*/
+	static counter& get_counter(const char* group, const char* name);
+
+	//! Returns the entry of a timed scope and creates it on first use.
+	static timer_entry& get_timer(const char* name);
+
+	//! Sets the function that is called every time a timed scope is left. Null removes the callback.
+	/*!
+	* The callback is called on the thread that leaves the scope, so it must be thread safe.
+	* \param callback The new callback.
+	*/
+	static void set_timer_callback(timer_callback callback);
+
+	//! Returns a copy of all values.
+	static instrumentation_snapshot snapshot();
+
+	//! Sets all values to zero. Counters and timers stay registered.
+	static void reset();
+
+	//! Writes a snapshot in the text format of Prometheus, one line per value.
+	/*!
+	* E.g. color_magic_conversions_total{from="RGB_TRUE",to="LAB"} 42
+	* \param snapshot The values to write.
+	* \param out The stream to write to.
+	*/
+	static void write(const instrumentation_snapshot& snapshot, std::ostream& out);
+
+private:
+	static const size_t color_type_count = (size_t)color_type::UNDEFINED;
+
+	static std::atomic<uint64_t> s_conversions[color_type_count][color_type_count];
+	static std::atomic<uint64_t> s_colors_created;
+	static std::atomic<uint64_t> s_colors_destroyed;
+	static std::atomic<bool> s_has_timer_callback;
+};
+
+// Hooks used inside the library. They compile to nothing without COLOR_MAGIC_INSTRUMENTATION.
+#ifdef COLOR_MAGIC_INSTRUMENTATION
+#define COLOR_MAGIC_COUNT_CONVERSIONS(from, to, count) instrumentation::add_conversions(from, to, count)
+#define COLOR_MAGIC_COUNT_COLOR_CREATED() instrumentation::color_created()
+#define COLOR_MAGIC_COUNT_COLOR_DESTROYED() instrumentation::color_destroyed()
+#define COLOR_MAGIC_COUNT(group, name) do { static instrumentation::counter& color_magic_counter = instrumentation::get_counter(group, name); color_magic_counter.fetch_add(1, std::memory_order_relaxed); } while (false)
+#define COLOR_MAGIC_SCOPED_TIMER(name) static instrumentation::timer_entry& color_magic_timer_entry = instrumentation::get_timer(name); instrumentation::scoped_timer color_magic_timer(color_magic_timer_entry)
+#else
+#define COLOR_MAGIC_COUNT_CONVERSIONS(from, to, count) ((void)0)
+#define COLOR_MAGIC_COUNT_COLOR_CREATED() ((void)0)
+#define COLOR_MAGIC_COUNT_COLOR_DESTROYED() ((void)0)
+#define COLOR_MAGIC_COUNT(group, name) ((void)0)
+#define COLOR_MAGIC_SCOPED_TIMER(name) ((void)0)
+#endif
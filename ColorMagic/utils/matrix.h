@@ -505,7 +505,7 @@ public:
 	* /param values A vector containing the values to insert.
 	* /return This modified matrix.
 	*/
-	matrix<T>& insert(std::vector<T>& values)
+	matrix<T>& insert(const std::vector<T>& values)
 	{
 		if (values.size() == this->size())
 		{
@@ -0,0 +1,310 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+//! Enum that defines the memory layouts of 8 bit pixels a pixel view can read and write.
+enum pixel_layout
+{
+	ARGB32 = 0, /*!< ARGB32 - one 32 bit word per pixel with the value 0xAARRGGBB in native byte order, like the hex code of rgb_truecolor */
+	RGBA32, /*!< RGBA32 - four bytes per pixel in the order red, green, blue, alpha */
+	BGRA32, /*!< BGRA32 - four bytes per pixel in the order blue, green, red, alpha (e.g. Windows DIBs and most framebuffers) */
+	RGB24, /*!< RGB24 - three bytes per pixel in the order red, green, blue without alpha */
+	PLANAR /*!< PLANAR - separate planes of red, green, blue and optional alpha bytes */
+};
+
+//! Non-owning view of 8 bit rgb pixels in caller memory.
+/*!
+* A view describes an image of width x height pixels without copying it: a pointer to the first row (or to the
+* first row of each plane), the pixel layout and the stride, i.e. the distance between two rows in bytes. This
+* makes it possible to run the batch functions directly on framebuffers, decoded images or sub rectangles of them.
+* Pixels are numbered row by row, so pixel i lies in row i / width at column i % width.
+*
+* pixel_view only reads, mutable_pixel_view reads and writes. A mutable_pixel_view converts implicitly to a
+* pixel_view. The caller has to keep the memory alive while the view is used.
+*/
+template <typename Byte> class basic_pixel_view
+{
+public:
+	//! Pointer type of the viewed memory (void* or const void*).
+	typedef typename std::conditional<std::is_const<Byte>::value, const void*, void*>::type pointer;
+
+	//! Default constructor. Creates an empty view.
+	basic_pixel_view() : m_planes({ nullptr, nullptr, nullptr, nullptr }), m_layout(RGBA32), m_width(0), m_height(0), m_stride(0) {}
+
+	//! Creates a view of packed pixels.
+	/*!
+	* \param data The first byte of the first row.
+	* \param layout The pixel layout. Must not be PLANAR.
+	* \param width The number of pixels per row.
+	* \param height The number of rows.
+	* \param stride The number of bytes between the starts of two rows. If 0 the rows are tightly packed.
+	*/
+	basic_pixel_view(pointer data, pixel_layout layout, size_t width, size_t height = 1, size_t stride = 0)
+		: m_planes({ static_cast<Byte*>(data), nullptr, nullptr, nullptr }), m_layout(layout), m_width(width), m_height(height), m_stride(stride)
+	{
+		if (layout == PLANAR) throw new std::invalid_argument("Planar views need one pointer per plane.");
+		if (data == nullptr && width * height > 0) throw new std::invalid_argument("data is null.");
+		if (m_stride == 0) m_stride = width * bytes_per_pixel();
+		if (m_stride < width * bytes_per_pixel()) throw new std::invalid_argument("The stride is smaller than a row.");
+	}
+
+	//! Creates a view of planar pixels.
+	/*!
+	* \param red The first byte of the first row of the red plane.
+	* \param green The first byte of the first row of the green plane.
+	* \param blue The first byte of the first row of the blue plane.
+	* \param alpha The first byte of the first row of the alpha plane or null if the pixels have no alpha.
+	* \param width The number of pixels per row.
+	* \param height The number of rows.
+	* \param stride The number of bytes between the starts of two rows of a plane. If 0 the rows are tightly packed.
+	*/
+	basic_pixel_view(pointer red, pointer green, pointer blue, pointer alpha, size_t width, size_t height = 1, size_t stride = 0)
+		: m_planes({ static_cast<Byte*>(red), static_cast<Byte*>(green), static_cast<Byte*>(blue), static_cast<Byte*>(alpha) }), m_layout(PLANAR), m_width(width), m_height(height), m_stride(stride == 0 ? width : stride)
+	{
+		if ((red == nullptr || green == nullptr || blue == nullptr) && width * height > 0) throw new std::invalid_argument("Color planes must not be null.");
+		if (m_stride < width) throw new std::invalid_argument("The stride is smaller than a row.");
+	}
+
+	//! Creates a read only view of a mutable view.
+	template <typename Other, typename = typename std::enable_if<std::is_same<const Other, Byte>::value>::type>
+	basic_pixel_view(const basic_pixel_view<Other>& other)
+		: m_planes({ other.plane(0), other.plane(1), other.plane(2), other.plane(3) }), m_layout(other.layout()), m_width(other.width()), m_height(other.height()), m_stride(other.stride()) {}
+
+	//! Returns the pixel layout.
+	pixel_layout layout() const { return m_layout; }
+
+	//! Returns the number of pixels per row.
+	size_t width() const { return m_width; }
+
+	//! Returns the number of rows.
+	size_t height() const { return m_height; }
+
+	//! Returns the number of bytes between the starts of two rows (of a plane).
+	size_t stride() const { return m_stride; }
+
+	//! Returns the number of pixels.
+	size_t size() const { return m_width * m_height; }
+
+	//! Returns whether the view contains no pixels.
+	bool empty() const { return size() == 0; }
+
+	//! Returns whether the pixels store alpha. Pixels without alpha are read as opaque.
+	bool has_alpha() const { return m_layout == PLANAR ? m_planes[3] != nullptr : m_layout != RGB24; }
+
+	//! Returns the number of bytes of one pixel (of one plane for planar views).
+	size_t bytes_per_pixel() const { return m_layout == PLANAR ? 1 : m_layout == RGB24 ? 3 : 4; }
+
+	//! Returns the first byte of the first row of the given plane. Packed views only have plane 0.
+	Byte* plane(size_t index) const { return index < 4 ? m_planes[index] : nullptr; }
+
+	//! Returns a view of a rectangle within this view. No pixels are copied.
+	/*!
+	* \param x The first column of the rectangle.
+	* \param y The first row of the rectangle.
+	* \param width The number of columns of the rectangle.
+	* \param height The number of rows of the rectangle.
+	* \return The view of the rectangle with the stride of this view.
+	*/
+	basic_pixel_view subview(size_t x, size_t y, size_t width, size_t height) const
+	{
+		if (x + width > m_width || y + height > m_height) throw new std::out_of_range("The rectangle is outside the view.");
+
+		basic_pixel_view result(*this);
+		for (auto& plane : result.m_planes)
+		{
+			if (plane != nullptr) plane += y * m_stride + x * bytes_per_pixel();
+		}
+		result.m_width = width;
+		result.m_height = height;
+		return result;
+	}
+
+	//! Returns red, green, blue and alpha of the given pixel.
+	std::array<uint8_t, 4> get(size_t x, size_t y) const
+	{
+		if (x >= m_width || y >= m_height) throw new std::out_of_range("The pixel is outside the view.");
+		return read(x, y);
+	}
+
+	//! Sets red, green, blue and alpha of the given pixel. Alpha is ignored if the pixels have no alpha.
+	void set(size_t x, size_t y, const std::array<uint8_t, 4>& rgba) const
+	{
+		if (x >= m_width || y >= m_height) throw new std::out_of_range("The pixel is outside the view.");
+		write(x, y, rgba);
+	}
+
+	//! Reads consecutive pixels into color records.
+	/*!
+	* Each record consists of 4 floats: red, green, blue and alpha scaled from [0,255] to [0,max], so a max of 255
+	* gives records of rgb truecolors and a max of 1 records of rgb deep colors. The pixels may span several rows.
+	* \param first The index of the first pixel.
+	* \param count The number of pixels.
+	* \param records The output records.
+	* \param max The value of a component of 255.
+	*/
+	void unpack(size_t first, size_t count, float* records, float max = 255.f) const
+	{
+		if (first + count > size()) throw new std::out_of_range("The pixels are outside the view.");
+
+		float scale = max / 255.f;
+		for_each_row(first, count, [&](size_t x, size_t y, size_t length, size_t offset)
+		{
+			float* out = records + offset * 4;
+			for (size_t i = 0; i < length; ++i)
+			{
+				auto rgba = read(x + i, y);
+				out[i * 4] = rgba[0] * scale;
+				out[i * 4 + 1] = rgba[1] * scale;
+				out[i * 4 + 2] = rgba[2] * scale;
+				out[i * 4 + 3] = rgba[3] * scale;
+			}
+		});
+	}
+
+	//! Writes color records to consecutive pixels.
+	/*!
+	* The counterpart of unpack(). Components are clamped to [0,max] and rounded to the nearest byte value.
+	* \param first The index of the first pixel.
+	* \param count The number of pixels.
+	* \param records The input records.
+	* \param max The value of a component of 255.
+	*/
+	void pack(size_t first, size_t count, const float* records, float max = 255.f) const
+	{
+		if (first + count > size()) throw new std::out_of_range("The pixels are outside the view.");
+
+		float scale = 255.f / max;
+		auto quantize = [scale](float value) { return (uint8_t)std::lround(std::min(std::max(value * scale, 0.f), 255.f)); };
+		for_each_row(first, count, [&](size_t x, size_t y, size_t length, size_t offset)
+		{
+			const float* in = records + offset * 4;
+			for (size_t i = 0; i < length; ++i)
+			{
+				write(x + i, y, { quantize(in[i * 4]), quantize(in[i * 4 + 1]), quantize(in[i * 4 + 2]), quantize(in[i * 4 + 3]) });
+			}
+		});
+	}
+
+	//! Calls the function for each row part of the pixels [first, first + count).
+	/*!
+	* \param first The index of the first pixel.
+	* \param count The number of pixels.
+	* \param function Called with the column, the row, the number of pixels and their offset relative to first.
+	*/
+	template <typename Function> void for_each_row(size_t first, size_t count, Function function) const
+	{
+		size_t offset = 0;
+		while (offset < count)
+		{
+			size_t index = first + offset;
+			size_t x = index % m_width;
+			size_t length = std::min(m_width - x, count - offset);
+			function(x, index / m_width, length, offset);
+			offset += length;
+		}
+	}
+
+private:
+	//! Reads a pixel without range check.
+	std::array<uint8_t, 4> read(size_t x, size_t y) const
+	{
+		if (m_layout == PLANAR)
+		{
+			size_t offset = y * m_stride + x;
+			return { m_planes[0][offset], m_planes[1][offset], m_planes[2][offset], m_planes[3] != nullptr ? m_planes[3][offset] : (uint8_t)255 };
+		}
+
+		Byte* pixel = m_planes[0] + y * m_stride + x * bytes_per_pixel();
+		switch (m_layout)
+		{
+		case ARGB32:
+		{
+			uint32_t word;
+			std::memcpy(&word, pixel, sizeof(word));
+			return { (uint8_t)(word >> 16), (uint8_t)(word >> 8), (uint8_t)word, (uint8_t)(word >> 24) };
+		}
+		case BGRA32:
+			return { pixel[2], pixel[1], pixel[0], pixel[3] };
+		case RGB24:
+			return { pixel[0], pixel[1], pixel[2], (uint8_t)255 };
+		default:
+			return { pixel[0], pixel[1], pixel[2], pixel[3] };
+		}
+	}
+
+	//! Writes a pixel without range check.
+	void write(size_t x, size_t y, const std::array<uint8_t, 4>& rgba) const
+	{
+		if (m_layout == PLANAR)
+		{
+			size_t offset = y * m_stride + x;
+			for (size_t i = 0; i < 4; ++i)
+			{
+				if (m_planes[i] != nullptr) m_planes[i][offset] = rgba[i];
+			}
+			return;
+		}
+
+		Byte* pixel = m_planes[0] + y * m_stride + x * bytes_per_pixel();
+		switch (m_layout)
+		{
+		case ARGB32:
+		{
+			uint32_t word = ((uint32_t)rgba[3] << 24) | ((uint32_t)rgba[0] << 16) | ((uint32_t)rgba[1] << 8) | rgba[2];
+			std::memcpy(pixel, &word, sizeof(word));
+			break;
+		}
+		case BGRA32:
+			pixel[0] = rgba[2];
+			pixel[1] = rgba[1];
+			pixel[2] = rgba[0];
+			pixel[3] = rgba[3];
+			break;
+		case RGB24:
+			pixel[0] = rgba[0];
+			pixel[1] = rgba[1];
+			pixel[2] = rgba[2];
+			break;
+		default:
+			pixel[0] = rgba[0];
+			pixel[1] = rgba[1];
+			pixel[2] = rgba[2];
+			pixel[3] = rgba[3];
+			break;
+		}
+	}
+
+	template <typename Other> friend class basic_pixel_view;
+
+	//! First byte of the first row of each plane. Packed views only use the first entry.
+	std::array<Byte*, 4> m_planes;
+
+	//! Layout of the pixels.
+	pixel_layout m_layout;
+
+	//! Number of pixels per row.
+	size_t m_width;
+
+	//! Number of rows.
+	size_t m_height;
+
+	//! Number of bytes between the starts of two rows.
+	size_t m_stride;
+};
+
+//! Read only view of 8 bit rgb pixels.
+typedef basic_pixel_view<const uint8_t> pixel_view;
+
+//! View of 8 bit rgb pixels that can be read and written.
+typedef basic_pixel_view<uint8_t> mutable_pixel_view;
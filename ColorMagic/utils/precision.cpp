@@ -0,0 +1,4 @@
+#include "stdafx.h"
+#include "precision.h"
+
+std::atomic<int> precision::s_default((int)EXACT);
@@ -0,0 +1,253 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+#define _USE_MATH_DEFINES
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+//! Enum that defines how exact the math of the conversion kernels is.
+/*!
+* The maximum errors of the single functions are listed at precision_math. The resulting errors of whole conversions
+* can be measured with the accuracy_harness.
+*/
+enum precision_policy
+{
+	EXACT = 0, /*!< EXACT - the functions of the standard library, results are the same like before the policy existed */
+	FAST, /*!< FAST - polynomial approximations that are about as exact as the float versions of the standard library */
+	FASTEST, /*!< FASTEST - low degree polynomials and lookup tables for the gamma curves, errors far below one truecolor step */
+};
+
+//! Static class that holds the precision policy used by functions that do not take one as parameter.
+class precision
+{
+public:
+	//! Returns the policy used by the color_converter and the color_distance if no policy is passed. EXACT by default.
+	static precision_policy get_default() { return (precision_policy)s_default.load(std::memory_order_relaxed); }
+
+	//! Sets the policy used by the color_converter and the color_distance if no policy is passed.
+	/*!
+	* The policy is global, so it should be set once at the start of the program and not while other threads convert.
+	* Code that needs a certain policy independent of the rest of the program should pass it to the overloads that take one.
+	* \param policy The new default policy.
+	*/
+	static void set_default(precision_policy policy) { s_default.store((int)policy, std::memory_order_relaxed); }
+
+	//! Calls a generic function with the policy as compile time constant.
+	/*!
+	* Used to select the instantiation of a kernel once per call instead of once per math function, e.g.
+	* precision::dispatch(policy, [&](auto p) { return kernel<decltype(p)::value>(data); });
+	* \param policy The runtime policy.
+	* \param function Generic function that takes a std::integral_constant<precision_policy, P>.
+	* \return The result of the function.
+	*/
+	template <typename Function> static auto dispatch(precision_policy policy, Function&& function) -> decltype(function(std::integral_constant<precision_policy, EXACT>()))
+	{
+		switch (policy)
+		{
+		case FAST:
+			return function(std::integral_constant<precision_policy, FAST>());
+		case FASTEST:
+			return function(std::integral_constant<precision_policy, FASTEST>());
+		default:
+			return function(std::integral_constant<precision_policy, EXACT>());
+		}
+	}
+
+private:
+	static std::atomic<int> s_default;
+};
+
+//! Math functions of a precision policy.
+/*!
+* All functions are templates of the floating point type, so the same kernels can run in float and double. The
+* approximations evaluate their polynomials in the precision of T, but the coefficients are fitted for float, so
+* double results are not more exact than the float ones. Maximum errors over the whole input range (measured in float):
+*
+* | function | FAST                     | FASTEST                  |
+* |----------|--------------------------|--------------------------|
+* | cbrt     | 1.2e-7 relative (1 ulp)  | 1.2e-6 relative          |
+* | exp      | 6e-7 relative            | 1.1e-4 relative          |
+* | pow      | see below                | see below                |
+* | atan2    | 9e-7 rad                 | 2e-4 rad                 |
+* | sin, cos | 3e-7 absolute            | 1.3e-6 absolute          |
+* | acos     | 5e-7 rad                 | 7e-5 rad                 |
+* | gamma    | exact curve              | 16384 entry table        |
+*
+* pow(x, y) is exp2(y * log2(x)), so the absolute error of log2 (1.3e-7 FAST, 2.5e-4 FASTEST) is multiplied with |y|,
+* e.g. pow(x, 2.4) on (0, 20] stays below 3e-6 (FAST) and 6e-4 (FASTEST) relative error.
+* FAST keeps the exact gamma curves because they are arbitrary functions of the rgb color space definition.
+*/
+template <precision_policy Policy> struct precision_math;
+
+//! Exact math, forwards to the standard library.
+template <> struct precision_math<EXACT>
+{
+	static const bool gamma_tables = false;
+
+	template <typename T> static T cbrt(T x) { return std::cbrt(x); }
+	template <typename T> static T pow(T x, T y) { return std::pow(x, y); }
+	template <typename T> static T exp(T x) { return std::exp(x); }
+	template <typename T> static T atan2(T y, T x) { return std::atan2(y, x); }
+	template <typename T> static T sin(T x) { return std::sin(x); }
+	template <typename T> static T cos(T x) { return std::cos(x); }
+	template <typename T> static T acos(T x) { return std::acos(x); }
+};
+
+//! Polynomial approximations shared by FAST and FASTEST, parameterized by the polynomials of the policy.
+/*!
+* Coefficients provides the minimax polynomials exp2_poly on [0, 1], log2_poly (log2(1 + t) / t on [-0.25, 0.5]),
+* atan_poly (atan(z) / z as polynomial of z^2 on [0, 1]), sin_poly (sin(x) / x as polynomial of x^2 on [0, pi/2]),
+* acos_poly (acos(x) / sqrt(1 - x) on [0, 1]) and the number of newton steps of cbrt. The polynomials are templates
+* of the value type, so the vectorized functions of simd_math evaluate exactly the same polynomials.
+*/
+template <typename Coefficients> struct approximate_math
+{
+	static const bool gamma_tables = Coefficients::gamma_tables;
+
+	template <typename T> static T cbrt(T x)
+	{
+		if (x == T(0) || !std::isfinite(x)) return x;
+		float magnitude = (float)std::fabs(x);
+		if (magnitude < 1e-30f || magnitude > 1e30f) return std::cbrt(x);
+
+		// Dividing the exponent bits by 3 gives a first guess with an error below 4%, every newton step squares it
+		uint32_t bits;
+		std::memcpy(&bits, &magnitude, sizeof(bits));
+		bits = bits / 3 + 0x2a514067u;
+		float guess;
+		std::memcpy(&guess, &bits, sizeof(guess));
+
+		T a = std::fabs(x);
+		T y = T(guess);
+		for (int i = 0; i < Coefficients::cbrt_steps; ++i) y = (T(2) * y + a / (y * y)) / T(3);
+		return x < T(0) ? -y : y;
+	}
+
+	template <typename T> static T exp2(T x)
+	{
+		if (std::isnan(x)) return x;
+		if (x < T(-126)) return T(0);
+		if (x > T(127)) return T(HUGE_VALF);
+
+		T whole = std::floor(x);
+		int32_t exponent = (int32_t)whole + 127;
+		uint32_t bits = (uint32_t)exponent << 23;
+		float scale;
+		std::memcpy(&scale, &bits, sizeof(scale));
+		return Coefficients::exp2_poly(x - whole) * T(scale);
+	}
+
+	template <typename T> static T log2(T x)
+	{
+		// Split x into 2^exponent * mantissa with mantissa in [0.75, 1.5), so the polynomial only sees small arguments
+		float value = (float)x;
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		int exponent = (int)((bits >> 23) & 0xff) - 127;
+		bits = (bits & 0x007fffffu) | 0x3f800000u;
+		float mantissa;
+		std::memcpy(&mantissa, &bits, sizeof(mantissa));
+		if (mantissa >= 1.5f)
+		{
+			mantissa *= 0.5f;
+			++exponent;
+		}
+		T t = T(mantissa) - T(1);
+		return T(exponent) + t * Coefficients::log2_poly(t);
+	}
+
+	template <typename T> static T pow(T x, T y)
+	{
+		if (x <= T(0) || std::fabs((float)x) < 1e-37f || !std::isfinite(x)) return std::pow(x, y);
+		return exp2(y * log2(x));
+	}
+
+	template <typename T> static T exp(T x) { return exp2(x * T(1.4426950408889634)); }
+
+	template <typename T> static T atan2(T y, T x)
+	{
+		T ax = std::fabs(x);
+		T ay = std::fabs(y);
+		if ((ax == T(0) && ay == T(0)) || !std::isfinite(ax) || !std::isfinite(ay)) return std::atan2(y, x);
+
+		// Reduce to an angle in [0, pi/4] and mirror the result back into its octant
+		bool swap = ay > ax;
+		T z = swap ? ax / ay : ay / ax;
+		T result = z * Coefficients::atan_poly(z * z);
+		if (swap) result = T(M_PI / 2) - result;
+		if (x < T(0)) result = T(M_PI) - result;
+		return std::copysign(result, y);
+	}
+
+	template <typename T> static T sin(T x) { return sin_quadrant(x, 0); }
+
+	template <typename T> static T cos(T x) { return sin_quadrant(x, 1); }
+
+	template <typename T> static T acos(T x)
+	{
+		// acos(-x) = pi - acos(x), inputs outside [-1, 1] give NaN from the square root
+		T a = std::fabs(x);
+		T result = std::sqrt(T(1) - a) * Coefficients::acos_poly(a);
+		return x < T(0) ? T(M_PI) - result : result;
+	}
+
+protected:
+	//! Returns sin(x + quadrant_offset * pi/2).
+	template <typename T> static T sin_quadrant(T x, int quadrant_offset)
+	{
+		if (!std::isfinite(x) || std::fabs(x) > T(200)) return quadrant_offset == 0 ? std::sin(x) : std::cos(x);
+
+		// x = quadrant * pi/2 + r with r in [-pi/4, pi/4]. The first part of pi/2 has 17 significant bits, so its
+		// product with quadrants up to 128 is exact and r does not lose precision.
+		T quadrant = std::round(x * T(M_2_PI));
+		T r = (x - quadrant * T(1.57078552246093750)) - quadrant * T(1.0804333959057999e-05);
+		int index = ((int)quadrant + quadrant_offset) & 3;
+
+		// cos(r) = sin(pi/2 - |r|), which stays inside the fitted range
+		T value = (index & 1) == 0 ? r * Coefficients::sin_poly(r * r) : sin_poly_at(T(M_PI / 2) - std::fabs(r));
+		return (index & 2) == 0 ? value : -value;
+	}
+
+	template <typename T> static T sin_poly_at(T x) { return x * Coefficients::sin_poly(x * x); }
+};
+
+//! Minimax polynomials of the FAST policy.
+struct fast_coefficients
+{
+	static const bool gamma_tables = false;
+	static const int cbrt_steps = 3;
+
+	template <typename V> static V exp2_poly(V f) { return V(0.999999893f) + f * (V(0.693154752f) + f * (V(0.240139714f) + f * (V(0.0558662391f) + f * (V(0.00894283717f) + f * V(0.00189645789f))))); }
+	template <typename V> static V log2_poly(V t) { return V(1.44269522f) + t * (V(-0.721351235f) + t * (V(0.480852893f) + t * (V(-0.360306005f) + t * (V(0.2898754f) + t * (V(-0.250843098f) + t * (V(0.206157678f) + t * V(-0.0984834182f))))))); }
+	template <typename V> static V atan_poly(V u) { return V(0.999999416f) + u * (V(-0.333270121f) + u * (V(0.198873062f) + u * (V(-0.135121104f) + u * (V(0.0843528102f) + u * (V(-0.0374418297f) + u * V(0.00800651336f)))))); }
+	template <typename V> static V sin_poly(V u) { return V(0.999999996f) + u * (V(-0.16666658f) + u * (V(0.00833305107f) + u * (V(-0.00019809076f) + u * V(2.60522627e-06f)))); }
+	// Abramowitz and Stegun 4.4.46
+	template <typename V> static V acos_poly(V x) { return V(1.5707963050f) + x * (V(-0.2145988016f) + x * (V(0.0889789874f) + x * (V(-0.0501743046f) + x * (V(0.0308918810f) + x * (V(-0.0170881256f) + x * (V(0.0066700901f) + x * V(-0.0012624911f))))))); }
+};
+
+//! Minimax polynomials of the FASTEST policy.
+struct fastest_coefficients
+{
+	static const bool gamma_tables = true;
+	static const int cbrt_steps = 2;
+
+	template <typename V> static V exp2_poly(V f) { return V(0.999892974f) + f * (V(0.696457249f) + f * (V(0.22433875f) + f * V(0.0792039853f))); }
+	template <typename V> static V log2_poly(V t) { return V(1.44245589f) + t * (V(-0.726447376f) + t * (V(0.499743067f) + t * V(-0.277980261f))); }
+	template <typename V> static V atan_poly(V u) { return V(0.999810424f) + u * (V(-0.326216258f) + u * (V(0.156668017f) + u * V(-0.0450534788f))); }
+	template <typename V> static V sin_poly(V u) { return V(0.999999246f) + u * (V(-0.166656827f) + u * (V(0.00831325864f) + u * V(-0.000185243554f))); }
+	// Abramowitz and Stegun 4.4.45
+	template <typename V> static V acos_poly(V x) { return V(1.5707288f) + x * (V(-0.2121144f) + x * (V(0.0742610f) + x * V(-0.0187293f))); }
+};
+
+//! Polynomial approximations with errors close to the float versions of the standard library.
+template <> struct precision_math<FAST> : approximate_math<fast_coefficients> {};
+
+//! Low degree polynomials and gamma lookup tables.
+template <> struct precision_math<FASTEST> : approximate_math<fastest_coefficients> {};
@@ -0,0 +1,457 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+#include "precision.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define COLOR_MAGIC_SSE2
+#include <emmintrin.h>
+#endif
+
+//! Four floats that are processed together.
+/*!
+* Maps to an SSE2 register if the target supports it and to an array of four floats otherwise. Comparisons return
+* masks with all bits of a lane set, select() uses them to blend two vectors.
+*/
+struct float4
+{
+#ifdef COLOR_MAGIC_SSE2
+	__m128 v;
+
+	float4() {}
+	float4(__m128 value) : v(value) {}
+	float4(float value) : v(_mm_set1_ps(value)) {}
+	float4(float x, float y, float z, float w) : v(_mm_setr_ps(x, y, z, w)) {}
+
+	//! Loads four floats, the memory does not have to be aligned.
+	static float4 load(const float* values) { return _mm_loadu_ps(values); }
+
+	//! Stores four floats, the memory does not have to be aligned.
+	void store(float* values) const { _mm_storeu_ps(values, v); }
+#else
+	float v[4];
+
+	float4() {}
+	float4(float value) : v{ value, value, value, value } {}
+	float4(float x, float y, float z, float w) : v{ x, y, z, w } {}
+
+	//! Loads four floats.
+	static float4 load(const float* values) { return float4(values[0], values[1], values[2], values[3]); }
+
+	//! Stores four floats.
+	void store(float* values) const { std::memcpy(values, v, sizeof(v)); }
+#endif
+
+	//! Loads count (at most four) floats, the remaining lanes are 1.
+	static float4 load(const float* values, size_t count)
+	{
+		if (count == 4) return load(values);
+		float lanes[4] = { 1.f, 1.f, 1.f, 1.f };
+		std::memcpy(lanes, values, count * sizeof(float));
+		return load(lanes);
+	}
+
+	//! Stores the first count (at most four) lanes.
+	void store(float* values, size_t count) const
+	{
+		if (count == 4) return store(values);
+		float lanes[4];
+		store(lanes);
+		std::memcpy(values, lanes, count * sizeof(float));
+	}
+};
+
+//! Calls a scalar function on every lane.
+template <typename Function> inline float4 map_lanes(const float4& x, Function function)
+{
+	float lanes[4];
+	x.store(lanes);
+	for (auto& lane : lanes) lane = function(lane);
+	return float4::load(lanes);
+}
+
+//! Calls a scalar function with two arguments on every lane.
+template <typename Function> inline float4 map_lanes(const float4& x, const float4& y, Function function)
+{
+	float x_lanes[4];
+	float y_lanes[4];
+	x.store(x_lanes);
+	y.store(y_lanes);
+	for (int i = 0; i < 4; ++i) x_lanes[i] = function(x_lanes[i], y_lanes[i]);
+	return float4::load(x_lanes);
+}
+
+#ifdef COLOR_MAGIC_SSE2
+inline float4 operator+(const float4& a, const float4& b) { return _mm_add_ps(a.v, b.v); }
+inline float4 operator-(const float4& a, const float4& b) { return _mm_sub_ps(a.v, b.v); }
+inline float4 operator*(const float4& a, const float4& b) { return _mm_mul_ps(a.v, b.v); }
+inline float4 operator/(const float4& a, const float4& b) { return _mm_div_ps(a.v, b.v); }
+inline float4 operator-(const float4& a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.f)); }
+inline float4 operator<(const float4& a, const float4& b) { return _mm_cmplt_ps(a.v, b.v); }
+inline float4 operator<=(const float4& a, const float4& b) { return _mm_cmple_ps(a.v, b.v); }
+inline float4 operator>(const float4& a, const float4& b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline float4 operator>=(const float4& a, const float4& b) { return _mm_cmpge_ps(a.v, b.v); }
+inline float4 operator==(const float4& a, const float4& b) { return _mm_cmpeq_ps(a.v, b.v); }
+inline float4 operator!=(const float4& a, const float4& b) { return _mm_cmpneq_ps(a.v, b.v); }
+inline float4 operator&(const float4& a, const float4& b) { return _mm_and_ps(a.v, b.v); }
+inline float4 operator|(const float4& a, const float4& b) { return _mm_or_ps(a.v, b.v); }
+inline float4 operator^(const float4& a, const float4& b) { return _mm_xor_ps(a.v, b.v); }
+
+//! Returns the lanes of a where the mask is set and the lanes of b elsewhere.
+inline float4 select(const float4& mask, const float4& a, const float4& b) { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); }
+
+//! Whether the mask is set in any lane.
+inline bool any(const float4& mask) { return _mm_movemask_ps(mask.v) != 0; }
+
+//! Whether the mask is set in all lanes.
+inline bool all(const float4& mask) { return _mm_movemask_ps(mask.v) == 0xf; }
+
+inline float4 min(const float4& a, const float4& b) { return _mm_min_ps(a.v, b.v); }
+inline float4 max(const float4& a, const float4& b) { return _mm_max_ps(a.v, b.v); }
+inline float4 abs(const float4& a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a.v); }
+inline float4 sqrt(const float4& a) { return _mm_sqrt_ps(a.v); }
+#else
+inline float4 operator+(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return x + y; }); }
+inline float4 operator-(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return x - y; }); }
+inline float4 operator*(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return x * y; }); }
+inline float4 operator/(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return x / y; }); }
+inline float4 operator-(const float4& a) { return map_lanes(a, [](float x) { return -x; }); }
+
+//! Returns a float with all bits set if the condition is true and zero otherwise.
+inline float lane_mask(bool condition)
+{
+	uint32_t bits = condition ? 0xffffffffu : 0u;
+	float mask;
+	std::memcpy(&mask, &bits, sizeof(mask));
+	return mask;
+}
+
+//! Combines the bits of two floats.
+template <typename Function> inline float lane_bits(float x, float y, Function function)
+{
+	uint32_t x_bits, y_bits;
+	std::memcpy(&x_bits, &x, sizeof(x));
+	std::memcpy(&y_bits, &y, sizeof(y));
+	x_bits = function(x_bits, y_bits);
+	std::memcpy(&x, &x_bits, sizeof(x));
+	return x;
+}
+
+inline float4 operator<(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_mask(x < y); }); }
+inline float4 operator<=(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_mask(x <= y); }); }
+inline float4 operator>(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_mask(x > y); }); }
+inline float4 operator>=(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_mask(x >= y); }); }
+inline float4 operator==(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_mask(x == y); }); }
+inline float4 operator!=(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_mask(x != y); }); }
+inline float4 operator&(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_bits(x, y, [](uint32_t p, uint32_t q) { return p & q; }); }); }
+inline float4 operator|(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_bits(x, y, [](uint32_t p, uint32_t q) { return p | q; }); }); }
+inline float4 operator^(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return lane_bits(x, y, [](uint32_t p, uint32_t q) { return p ^ q; }); }); }
+
+//! Returns the lanes of a where the mask is set and the lanes of b elsewhere.
+inline float4 select(const float4& mask, const float4& a, const float4& b) { return (mask & a) | map_lanes(mask, b, [](float m, float y) { return lane_bits(m, y, [](uint32_t p, uint32_t q) { return ~p & q; }); }); }
+
+//! Whether the mask is set in any lane.
+inline bool any(const float4& mask)
+{
+	float lanes[4];
+	mask.store(lanes);
+	for (float lane : lanes)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &lane, sizeof(bits));
+		if (bits != 0) return true;
+	}
+	return false;
+}
+
+//! Whether the mask is set in all lanes.
+inline bool all(const float4& mask)
+{
+	float lanes[4];
+	mask.store(lanes);
+	for (float lane : lanes)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &lane, sizeof(bits));
+		if (bits == 0) return false;
+	}
+	return true;
+}
+
+inline float4 min(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return x < y ? x : y; }); }
+inline float4 max(const float4& a, const float4& b) { return map_lanes(a, b, [](float x, float y) { return x > y ? x : y; }); }
+inline float4 abs(const float4& a) { return map_lanes(a, [](float x) { return std::fabs(x); }); }
+inline float4 sqrt(const float4& a) { return map_lanes(a, [](float x) { return std::sqrt(x); }); }
+#endif
+
+//! Rounds half away from zero like std::round.
+inline float4 round(const float4& a)
+{
+#ifdef COLOR_MAGIC_SSE2
+	// Floats of 2^23 and above are integers already and may not fit into an int
+	float4 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+	float4 sign = a & float4(-0.f);
+	float4 rounded = select(abs(a - truncated) >= float4(0.5f), truncated + (sign | float4(1.f)), truncated);
+	return select(abs(a) < float4(8388608.f), rounded, a);
+#else
+	return map_lanes(a, [](float x) { return std::round(x); });
+#endif
+}
+
+//! Rounds towards negative infinity like std::floor.
+inline float4 floor(const float4& a)
+{
+#ifdef COLOR_MAGIC_SSE2
+	// Floats of 2^23 and above are integers already and may not fit into an int
+	float4 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+	float4 floored = truncated - (float4(1.f) & (truncated > a));
+	return select(abs(a) < float4(8388608.f), floored, a);
+#else
+	return map_lanes(a, [](float x) { return std::floor(x); });
+#endif
+}
+
+//! Returns a with the sign of b.
+inline float4 copysign(const float4& a, const float4& b) { return abs(a) | (b & float4(-0.f)); }
+
+//! Transposes the 4x4 matrix whose rows are the four vectors, e.g. four rgba records into r, g, b and a.
+inline void transpose(float4& row0, float4& row1, float4& row2, float4& row3)
+{
+#ifdef COLOR_MAGIC_SSE2
+	_MM_TRANSPOSE4_PS(row0.v, row1.v, row2.v, row3.v);
+#else
+	float matrix[4][4];
+	row0.store(matrix[0]);
+	row1.store(matrix[1]);
+	row2.store(matrix[2]);
+	row3.store(matrix[3]);
+	row0 = float4(matrix[0][0], matrix[1][0], matrix[2][0], matrix[3][0]);
+	row1 = float4(matrix[0][1], matrix[1][1], matrix[2][1], matrix[3][1]);
+	row2 = float4(matrix[0][2], matrix[1][2], matrix[2][2], matrix[3][2]);
+	row3 = float4(matrix[0][3], matrix[1][3], matrix[2][3], matrix[3][3]);
+#endif
+}
+
+//! Vectorized math functions of a precision policy.
+/*!
+* The functions evaluate the same polynomials like precision_math, so a lane gives the result of the scalar function
+* of the same policy up to rounding and the error bounds listed at precision_math apply. Lanes the polynomials do not
+* cover (zero, denormal, infinite or NaN inputs, sin and cos of more than 200) are passed to the scalar functions.
+* EXACT calls the standard library for each lane. Without SSE2 all policies work lane by lane.
+*/
+template <precision_policy Policy> struct simd_math;
+
+//! Exact math, calls the standard library for each lane.
+template <> struct simd_math<EXACT>
+{
+	static float4 cbrt(const float4& x) { return map_lanes(x, [](float v) { return std::cbrt(v); }); }
+	static float4 pow(const float4& x, const float4& y) { return map_lanes(x, y, [](float v, float w) { return std::pow(v, w); }); }
+	static float4 exp(const float4& x) { return map_lanes(x, [](float v) { return std::exp(v); }); }
+	static float4 atan2(const float4& y, const float4& x) { return map_lanes(y, x, [](float v, float w) { return std::atan2(v, w); }); }
+	static float4 acos(const float4& x) { return map_lanes(x, [](float v) { return std::acos(v); }); }
+
+	static void sincos(const float4& x, float4& sin, float4& cos)
+	{
+		sin = map_lanes(x, [](float v) { return std::sin(v); });
+		cos = map_lanes(x, [](float v) { return std::cos(v); });
+	}
+};
+
+//! Vectorized polynomial approximations shared by FAST and FASTEST, see approximate_math.
+template <typename Coefficients> struct simd_approximate_math
+{
+	typedef approximate_math<Coefficients> scalar;
+
+	static float4 cbrt(const float4& x)
+	{
+#ifdef COLOR_MAGIC_SSE2
+		float4 a = abs(x);
+		float4 special = (a < float4(1e-30f)) | (a > float4(1e30f)) | (a != a);
+
+		// Same guess like the scalar version. bits / 3 is (bits * 0xaaaaaaab) >> 33, SSE2 only multiplies the even lanes.
+		__m128i bits = _mm_castps_si128(a.v);
+		__m128i magic = _mm_set1_epi32((int)0xaaaaaaabu);
+		__m128i even = _mm_srli_epi64(_mm_mul_epu32(bits, magic), 33);
+		__m128i odd = _mm_slli_epi64(_mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(bits, 32), magic), 33), 32);
+		__m128i guess = _mm_add_epi32(_mm_or_si128(even, odd), _mm_set1_epi32(0x2a514067));
+		float4 y = _mm_castsi128_ps(guess);
+		for (int i = 0; i < Coefficients::cbrt_steps; ++i) y = (float4(2.f) * y + a / (y * y)) / float4(3.f);
+
+		float4 result = copysign(y, x);
+		if (any(special)) result = select(special, map_lanes(x, [](float v) { return scalar::cbrt(v); }), result);
+		return result;
+#else
+		return map_lanes(x, [](float v) { return scalar::cbrt(v); });
+#endif
+	}
+
+	static float4 exp2(const float4& x)
+	{
+#ifdef COLOR_MAGIC_SSE2
+		float4 clamped = min(max(x, float4(-126.f)), float4(127.f));
+		float4 whole = floor(clamped);
+		__m128i scale = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(whole.v), _mm_set1_epi32(127)), 23);
+
+		float4 result = Coefficients::exp2_poly(clamped - whole) * float4(_mm_castsi128_ps(scale));
+		result = select(x < float4(-126.f), float4(0.f), result);
+		result = select(x > float4(127.f), float4(HUGE_VALF), result);
+		return select(x != x, x, result);
+#else
+		return map_lanes(x, [](float v) { return scalar::exp2(v); });
+#endif
+	}
+
+	static float4 log2(const float4& x)
+	{
+#ifdef COLOR_MAGIC_SSE2
+		__m128i bits = _mm_castps_si128(x.v);
+		__m128i exponent_bits = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff)), _mm_set1_epi32(127));
+		float4 exponent = _mm_cvtepi32_ps(exponent_bits);
+		float4 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+
+		float4 upper = mantissa >= float4(1.5f);
+		mantissa = select(upper, mantissa * float4(0.5f), mantissa);
+		exponent = select(upper, exponent + float4(1.f), exponent);
+		float4 t = mantissa - float4(1.f);
+		return exponent + t * Coefficients::log2_poly(t);
+#else
+		return map_lanes(x, [](float v) { return scalar::log2(v); });
+#endif
+	}
+
+	static float4 pow(const float4& x, const float4& y)
+	{
+		float4 valid = (x >= float4(1e-37f)) & (x < float4(HUGE_VALF));
+		float4 result = exp2(y * log2(x));
+		if (!all(valid)) result = select(valid, result, map_lanes(x, y, [](float v, float w) { return std::pow(v, w); }));
+		return result;
+	}
+
+	static float4 exp(const float4& x) { return exp2(x * float4(1.4426950408889634f)); }
+
+	static float4 atan2(const float4& y, const float4& x)
+	{
+		float4 ax = abs(x);
+		float4 ay = abs(y);
+		float4 special = ((ax == float4(0.f)) & (ay == float4(0.f))) | (ax != ax) | (ay != ay) | (ax == float4(HUGE_VALF)) | (ay == float4(HUGE_VALF));
+
+		// Reduce to an angle in [0, pi/4] and mirror the result back into its octant
+		float4 swap = ay > ax;
+		float4 z = select(swap, ax, ay) / select(swap, ay, ax);
+		float4 result = z * Coefficients::atan_poly(z * z);
+		result = select(swap, float4((float)(M_PI / 2)) - result, result);
+		result = select(x < float4(0.f), float4((float)M_PI) - result, result);
+		result = copysign(result, y);
+
+		if (any(special)) result = select(special, map_lanes(y, x, [](float v, float w) { return std::atan2(v, w); }), result);
+		return result;
+	}
+
+	static void sincos(const float4& x, float4& sin, float4& cos)
+	{
+#ifdef COLOR_MAGIC_SSE2
+		// Same reduction like the scalar version: x = quadrant * pi/2 + r with r in [-pi/4, pi/4]
+		float4 special = (abs(x) > float4(200.f)) | (x != x);
+		float4 quadrant = round(x * float4((float)M_2_PI));
+		quadrant = select(special, float4(0.f), quadrant);
+		float4 r = (x - quadrant * float4(1.57078552246093750f)) - quadrant * float4(1.0804333959057999e-05f);
+
+		float4 sin_r = r * Coefficients::sin_poly(r * r);
+		float4 half_pi_minus_r = float4((float)(M_PI / 2)) - abs(r);
+		float4 cos_r = half_pi_minus_r * Coefficients::sin_poly(half_pi_minus_r * half_pi_minus_r);
+
+		// Quadrant 1 and 3 swap sin and cos, quadrant 2 and 3 negate the sin, cos is sin of the next quadrant
+		__m128i index = _mm_cvttps_epi32(quadrant.v);
+		__m128i next = _mm_add_epi32(index, _mm_set1_epi32(1));
+		float4 sin_odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(index, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+		float4 sin_negative = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(index, _mm_set1_epi32(2)), 30));
+		float4 cos_negative = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(next, _mm_set1_epi32(2)), 30));
+
+		sin = select(sin_odd, cos_r, sin_r) ^ sin_negative;
+		cos = select(sin_odd, sin_r, cos_r) ^ cos_negative;
+
+		if (any(special))
+		{
+			sin = select(special, map_lanes(x, [](float v) { return std::sin(v); }), sin);
+			cos = select(special, map_lanes(x, [](float v) { return std::cos(v); }), cos);
+		}
+#else
+		sin = map_lanes(x, [](float v) { return scalar::sin(v); });
+		cos = map_lanes(x, [](float v) { return scalar::cos(v); });
+#endif
+	}
+
+	static float4 acos(const float4& x)
+	{
+		// acos(-x) = pi - acos(x), inputs outside [-1, 1] give NaN from the square root
+		float4 a = abs(x);
+		float4 result = sqrt(float4(1.f) - a) * Coefficients::acos_poly(a);
+		return select(x < float4(0.f), float4((float)M_PI) - result, result);
+	}
+};
+
+//! Vectorized polynomial approximations of the FAST policy.
+template <> struct simd_math<FAST> : simd_approximate_math<fast_coefficients> {};
+
+//! Vectorized polynomial approximations of the FASTEST policy.
+template <> struct simd_math<FASTEST> : simd_approximate_math<fastest_coefficients> {};
+
+//! Applies the functions of simd_math to arrays.
+/*!
+* The arrays are processed in blocks of four, the last block is padded. Input and output arrays may be the same.
+*/
+template <precision_policy Policy> struct simd_batch
+{
+	typedef simd_math<Policy> math;
+
+	static void cbrt(const float* in, float* out, size_t count)
+	{
+		for_blocks(count, [&](size_t i, size_t n) { math::cbrt(float4::load(in + i, n)).store(out + i, n); });
+	}
+
+	static void pow(const float* in, float exponent, float* out, size_t count)
+	{
+		for_blocks(count, [&](size_t i, size_t n) { math::pow(float4::load(in + i, n), float4(exponent)).store(out + i, n); });
+	}
+
+	static void exp(const float* in, float* out, size_t count)
+	{
+		for_blocks(count, [&](size_t i, size_t n) { math::exp(float4::load(in + i, n)).store(out + i, n); });
+	}
+
+	static void atan2(const float* y, const float* x, float* out, size_t count)
+	{
+		for_blocks(count, [&](size_t i, size_t n) { math::atan2(float4::load(y + i, n), float4::load(x + i, n)).store(out + i, n); });
+	}
+
+	static void sincos(const float* in, float* sin_out, float* cos_out, size_t count)
+	{
+		for_blocks(count, [&](size_t i, size_t n)
+		{
+			float4 sin, cos;
+			math::sincos(float4::load(in + i, n), sin, cos);
+			sin.store(sin_out + i, n);
+			cos.store(cos_out + i, n);
+		});
+	}
+
+	static void acos(const float* in, float* out, size_t count)
+	{
+		for_blocks(count, [&](size_t i, size_t n) { math::acos(float4::load(in + i, n)).store(out + i, n); });
+	}
+
+private:
+	//! Calls function(first, count) for every block of at most four values.
+	template <typename Function> static void for_blocks(size_t count, Function function)
+	{
+		for (size_t i = 0; i < count; i += 4) function(i, count - i < 4 ? count - i : 4);
+	}
+};
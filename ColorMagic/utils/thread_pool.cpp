@@ -0,0 +1,210 @@
+#include "stdafx.h"
+#include "thread_pool.h"
+
+#include <exception>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+// Identifies the pool and queue the current thread works for (if it is a worker at all)
+static thread_local const thread_pool* current_pool = nullptr;
+static thread_local size_t current_worker_index = 0;
+
+thread_pool::thread_pool(size_t thread_count, std::vector<size_t> cpu_affinity) : m_pending(0), m_next_queue(0), m_stop(false)
+{
+	if (thread_count == 0) thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+	for (size_t i = 0; i < thread_count; ++i)
+	{
+		m_queues.push_back(std::unique_ptr<worker_queue>(new worker_queue()));
+	}
+
+	// Start the workers after all queues exist, since they steal from each other
+	for (size_t i = 0; i < thread_count; ++i)
+	{
+		m_threads.push_back(std::thread(&thread_pool::worker_loop, this, i));
+		if (!cpu_affinity.empty()) set_affinity(m_threads.back(), cpu_affinity[i % cpu_affinity.size()]);
+	}
+}
+
+thread_pool::~thread_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for (auto& thread : m_threads)
+	{
+		if (thread.joinable()) thread.join();
+	}
+}
+
+void thread_pool::parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain_size)
+{
+	if (begin >= end) return;
+
+	size_t count = end - begin;
+	if (grain_size == 0) grain_size = automatic_grain_size(count, get_thread_count());
+	size_t chunk_count = (count + grain_size - 1) / grain_size;
+
+	// Not worth scheduling anything
+	if (chunk_count <= 1)
+	{
+		body(begin, end);
+		return;
+	}
+
+	// The state is shared by reference since this function does not return before all chunks are done
+	std::atomic<size_t> remaining(chunk_count);
+	std::exception_ptr error;
+	std::mutex error_mutex;
+
+	auto run_chunk = [&](size_t chunk)
+	{
+		size_t chunk_begin = begin + chunk * grain_size;
+		size_t chunk_end = std::min(end, chunk_begin + grain_size);
+		try
+		{
+			body(chunk_begin, chunk_end);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(error_mutex);
+			if (!error) error = std::current_exception();
+		}
+
+		// The waiting thread may return as soon as it sees zero, so only the pool is touched after the decrement
+		thread_pool* pool = this;
+		if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			std::lock_guard<std::mutex> lock(pool->m_wake_mutex);
+			pool->m_wake.notify_all();
+		}
+	};
+
+	// Spread the chunks over all queues and process the first one right away
+	size_t queue_index = current_queue_index();
+	for (size_t chunk = 1; chunk < chunk_count; ++chunk)
+	{
+		push_task((queue_index + chunk) % m_queues.size(), [&run_chunk, chunk]() { run_chunk(chunk); });
+	}
+	run_chunk(0);
+
+	// Help processing tasks while there are any, so nested calls cannot starve the pool. Otherwise sleep until
+	// the last chunk is done or new tasks arrive.
+	std::function<void()> task;
+	while (remaining.load(std::memory_order_acquire) > 0)
+	{
+		if (try_get_task(queue_index, task))
+		{
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wake_mutex);
+		m_wake.wait(lock, [&]() { return remaining.load(std::memory_order_acquire) == 0 || m_pending.load() > 0; });
+	}
+
+	if (error) std::rethrow_exception(error);
+}
+
+void thread_pool::submit(std::function<void()> task)
+{
+	push_task(current_queue_index(), std::move(task));
+}
+
+thread_pool& thread_pool::get_default()
+{
+	// Never destroyed on purpose: joining threads while the library gets unloaded may dead lock
+	static thread_pool* default_pool = new thread_pool();
+	return *default_pool;
+}
+
+void thread_pool::worker_loop(size_t index)
+{
+	current_pool = this;
+	current_worker_index = index;
+
+	std::function<void()> task;
+	while (true)
+	{
+		if (try_get_task(index, task))
+		{
+			// Exceptions of submitted tasks have no receiver, parallel_for() catches its own ones
+			try { task(); }
+			catch (...) {}
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wake_mutex);
+		m_wake.wait(lock, [this]() { return m_stop || m_pending.load() > 0; });
+		if (m_stop && m_pending.load() == 0) return;
+	}
+}
+
+void thread_pool::push_task(size_t queue_index, std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_pending.fetch_add(1);
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_queues[queue_index]->mutex);
+		m_queues[queue_index]->tasks.push_back(std::move(task));
+	}
+	m_wake.notify_one();
+}
+
+bool thread_pool::try_get_task(size_t index, std::function<void()>& task)
+{
+	// Newest task of the own queue first, it is most likely still in the cache
+	{
+		std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+		if (!m_queues[index]->tasks.empty())
+		{
+			task = std::move(m_queues[index]->tasks.back());
+			m_queues[index]->tasks.pop_back();
+			m_pending.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// Steal the oldest task of another queue
+	for (size_t i = 1; i < m_queues.size(); ++i)
+	{
+		auto& queue = m_queues[(index + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		if (!queue->tasks.empty())
+		{
+			task = std::move(queue->tasks.front());
+			queue->tasks.pop_front();
+			m_pending.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t thread_pool::current_queue_index()
+{
+	if (current_pool == this) return current_worker_index;
+	return m_next_queue.fetch_add(1) % m_queues.size();
+}
+
+void thread_pool::set_affinity(std::thread& thread, size_t cpu)
+{
+#if defined(_WIN32)
+	// Affinity masks only cover the processor group of the process (up to 64 logical processors)
+	SetThreadAffinityMask(thread.native_handle(), (DWORD_PTR)1 << (cpu % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	CPU_SET(cpu, &cpu_set);
+	pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpu_set);
+#endif
+}
@@ -0,0 +1,108 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+#include "executor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Work-stealing thread pool.
+/*!
+* Every worker owns a task queue. Workers take new tasks from the back of their own queue and steal from the
+* front of the other queues if their own one is empty. Threads that wait for a parallel_for() to finish help
+* processing tasks, so nested parallel_for() calls do not block the pool. If there is nothing to help with they
+* sleep until their last chunk is done.
+*/
+class thread_pool : public executor
+{
+public:
+	//! Default constructor.
+	/*!
+	* \param thread_count The number of worker threads. If 0 std::thread::hardware_concurrency() is used.
+	* \param cpu_affinity Optional list of logical processor indices. Worker i is pinned to
+	* cpu_affinity[i % cpu_affinity.size()]. An empty list leaves the scheduling to the operating system.
+	*/
+	explicit thread_pool(size_t thread_count = 0, std::vector<size_t> cpu_affinity = std::vector<size_t>());
+
+	//! Default deconstructor.
+	/*!
+	* Waits for the running tasks and stops all workers.
+	*/
+	~thread_pool();
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	size_t get_thread_count() const override { return m_threads.size(); }
+
+	void parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain_size = 0) override;
+
+	//! Queues a task that is run by one of the workers.
+	/*!
+	* \param task The function to call.
+	*/
+	void submit(std::function<void()> task);
+
+	//! Returns the pool used by the batch functions if no executor is given.
+	/*!
+	* The pool is created on first use with one worker per hardware thread.
+	*/
+	static thread_pool& get_default();
+
+protected:
+	//! A task queue of a single worker.
+	struct worker_queue
+	{
+		std::deque<std::function<void()>> tasks;
+		std::mutex mutex;
+	};
+
+	//! Main loop of the worker with the given index.
+	void worker_loop(size_t index);
+
+	//! Pushes a task to the queue with the given index and wakes up a worker.
+	void push_task(size_t queue_index, std::function<void()> task);
+
+	//! Takes a task from the own queue or steals one from another queue.
+	/*!
+	* \param index The index of the queue to look at first.
+	* \param task Receives the task.
+	* \return Whether a task was found.
+	*/
+	bool try_get_task(size_t index, std::function<void()>& task);
+
+	//! Returns the queue index of the calling thread or the next queue in round robin order for foreign threads.
+	size_t current_queue_index();
+
+	//! Pins the given thread to the given logical processor.
+	static void set_affinity(std::thread& thread, size_t cpu);
+
+	//! One queue per worker.
+	std::vector<std::unique_ptr<worker_queue>> m_queues;
+
+	//! The worker threads.
+	std::vector<std::thread> m_threads;
+
+	//! Number of tasks that are queued but not started yet.
+	std::atomic<size_t> m_pending;
+
+	//! Counter used to spread tasks of foreign threads across the queues.
+	std::atomic<size_t> m_next_queue;
+
+	//! Set by the deconstructor to stop the workers.
+	bool m_stop;
+
+	//! Protects m_stop and is used to put idle workers and waiting parallel_for() calls to sleep.
+	std::mutex m_wake_mutex;
+
+	//! Wakes up idle workers if tasks are queued and waiting parallel_for() calls if their last chunk is done.
+	std::condition_variable m_wake;
+};
@@ -0,0 +1,145 @@
+#include "benchmark.h"
+#include "benchmark_data.h"
+#include "../ColorMagic/manipulation/accuracy_harness.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/manipulation/conversion_plan.h"
+#include "../ColorMagic/manipulation/lab_table.h"
+#include "../ColorMagic/manipulation/rgb_16_converter.h"
+#include "../ColorMagic/utils/half.h"
+
+#include <cmath>
+#include <memory>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+// Grid points per rgb axis, 33^3 = 35937 colors per conversion
+static const size_t grid_steps = 33;
+
+static void add_plan_reports(std::vector<accuracy_report>& reports, rgb_color_space_definition* srgb)
+{
+	std::vector<color_type> types;
+	for (size_t type = 0; type < color_converter::color_type_count; ++type)
+	{
+		if (conversion_plan::is_supported((color_type)type)) types.push_back((color_type)type);
+	}
+
+	for (auto in_type : types)
+	{
+		auto records = accuracy_harness::sample_grid(in_type, grid_steps, srgb);
+		for (auto out_type : types)
+		{
+			if (in_type == out_type) continue;
+			auto plan = conversion_plan::get(in_type, srgb, out_type, srgb);
+
+			std::vector<double> doubles(records.size());
+			std::vector<half> halves(records.size());
+			reports.push_back(accuracy_harness::compare("plan_float", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				plan->apply(in, out, count);
+			}, srgb, true));
+			reports.push_back(accuracy_harness::compare("plan_double", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				std::copy(in, in + count * 4, doubles.begin());
+				plan->apply(doubles.data(), doubles.data(), count);
+				std::copy(doubles.begin(), doubles.begin() + count * 4, out);
+			}, srgb, true));
+			reports.push_back(accuracy_harness::compare("plan_half", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				half::pack(in, halves.data(), count * 4);
+				plan->apply(halves.data(), halves.data(), count);
+				half::unpack(halves.data(), out, count * 4);
+			}, srgb, true));
+
+			auto fast_plan = conversion_plan::get(in_type, srgb, out_type, srgb, BRADFORD, FAST);
+			auto fastest_plan = conversion_plan::get(in_type, srgb, out_type, srgb, BRADFORD, FASTEST);
+			reports.push_back(accuracy_harness::compare("plan_float_fast", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				fast_plan->apply(in, out, count);
+			}, srgb, true));
+			reports.push_back(accuracy_harness::compare("plan_float_fastest", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				fastest_plan->apply(in, out, count);
+			}, srgb, true));
+		}
+	}
+}
+
+static void add_rgb_16_reports(std::vector<accuracy_report>& reports, rgb_color_space_definition* srgb)
+{
+	auto converter = rgb_16_converter::get(srgb);
+
+	// The inputs are converted to pixels once, so only the kernels are measured. 52 steps hit exact 16 bit values
+	// (65535 = 51 * 1285), so the quantization of the input adds no error.
+	auto rgb = accuracy_harness::sample_grid(color_type::RGB_DEEP, 52, srgb);
+	size_t count = rgb.size() / 4;
+	std::vector<rgb_16> pixels(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		pixels[i] = { (uint16_t)std::lround(rgb[i * 4] * 65535.f), (uint16_t)std::lround(rgb[i * 4 + 1] * 65535.f), (uint16_t)std::lround(rgb[i * 4 + 2] * 65535.f), 65535 };
+	}
+	reports.push_back(accuracy_harness::compare("rgb_16_to_xyz", color_type::RGB_DEEP, color_type::XYZ, rgb, [&](const float*, float* out, size_t count)
+	{
+		converter->to_xyz(pixels.data(), out, count);
+	}, srgb, true));
+	reports.push_back(accuracy_harness::compare("rgb_16_to_lab", color_type::RGB_DEEP, color_type::LAB, rgb, [&](const float*, float* out, size_t count)
+	{
+		converter->to_lab(pixels.data(), out, count);
+	}, srgb, true));
+
+	auto lab = accuracy_harness::sample_grid(color_type::LAB, grid_steps, srgb);
+	pixels.resize(lab.size() / 4);
+	reports.push_back(accuracy_harness::compare("rgb_16_from_lab", color_type::LAB, color_type::RGB_DEEP, lab, [&](const float* in, float* out, size_t count)
+	{
+		converter->from_lab(in, pixels.data(), count);
+		converter->to_rgb_deep(pixels.data(), out, count);
+	}, srgb, true));
+}
+
+static void add_lab_table_reports(std::vector<accuracy_report>& reports, rgb_color_space_definition* srgb)
+{
+	// 256 steps would be all truecolors, every 8th value keeps the reference conversion fast
+	std::vector<float> records;
+	for (int red = 0; red < 256; red += 8)
+	{
+		for (int green = 0; green < 256; green += 8)
+		{
+			for (int blue = 0; blue < 256; blue += 8)
+			{
+				records.insert(records.end(), { (float)red, (float)green, (float)blue, 1.f });
+			}
+		}
+	}
+
+	const char* names[] = { "lab_table_int16", "lab_table_float16" };
+	for (int format = INT16; format <= FLOAT16; ++format)
+	{
+		std::unique_ptr<lab_table> table(lab_table::generate(srgb, (lab_table_format)format));
+		reports.push_back(accuracy_harness::compare(names[format], color_type::RGB_TRUE, color_type::LAB, records, [&](const float* in, float* out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				auto value = table->lookup((uint8_t)in[i * 4], (uint8_t)in[i * 4 + 1], (uint8_t)in[i * 4 + 2]);
+				std::copy(value.begin(), value.end(), out + i * 4);
+				out[i * 4 + 3] = in[i * 4 + 3];
+			}
+		}, srgb, true));
+	}
+}
+
+void write_accuracy_table(const benchmark_options& options, std::ostream& out)
+{
+	auto srgb = benchmark_color_space();
+
+	std::vector<accuracy_report> reports;
+	add_plan_reports(reports, srgb);
+	add_rgb_16_reports(reports, srgb);
+	add_lab_table_reports(reports, srgb);
+
+	std::vector<accuracy_report> selected;
+	for (const auto& report : reports)
+	{
+		if (options.filter.empty() || report.name.find(options.filter) != std::string::npos) selected.push_back(report);
+	}
+	accuracy_harness::write_table(selected, out);
+}
@@ -0,0 +1,81 @@
+#include "benchmark.h"
+#include "benchmark_data.h"
+#include "../ColorMagic/manipulation/color_blend.h"
+#include "../ColorMagic/manipulation/porter_duff.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <utility>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+typedef std::function<color_base*(color_base*, color_base*)> blend_function;
+
+// Sources and destinations of the case that runs right now, see converter_inputs.
+struct blend_inputs
+{
+	size_t count = 0;
+	std::vector<color_base*> sources;
+	std::vector<color_base*> destinations;
+
+	void prepare(size_t new_count)
+	{
+		if (count == new_count) return;
+		delete_colors(sources);
+		delete_colors(destinations);
+		sources = create_colors(color_type::RGB_TRUE, new_count, 3);
+		destinations = create_colors(color_type::RGB_TRUE, new_count, 4);
+		count = new_count;
+	}
+};
+
+#define BLEND_MODE(name) { #name, [](color_base* s, color_base* d) { return color_blend::name(s, d); } }
+#define PORTER_DUFF_MODE(name) { "porter_duff_" #name, [](color_base* s, color_base* d) { return porter_duff::name(s, d); } }
+
+void register_blend_benchmarks(benchmark_registry& registry, const benchmark_options& options)
+{
+	static blend_inputs inputs;
+	static sequential_executor sequential;
+	executor* exec = options.parallel ? nullptr : &sequential;
+
+	const std::vector<std::pair<std::string, blend_function>> modes =
+	{
+		BLEND_MODE(normal), BLEND_MODE(dissolve), BLEND_MODE(multiply), BLEND_MODE(screen), BLEND_MODE(overlay),
+		BLEND_MODE(darken), BLEND_MODE(lighten), BLEND_MODE(color_dodge), BLEND_MODE(linear_dodge), BLEND_MODE(color_burn),
+		BLEND_MODE(linear_burn), BLEND_MODE(hard_light), BLEND_MODE(soft_light), BLEND_MODE(vivid_light), BLEND_MODE(linear_light),
+		BLEND_MODE(pin_light), BLEND_MODE(hard_mix), BLEND_MODE(difference), BLEND_MODE(subtract), BLEND_MODE(divide),
+		BLEND_MODE(plus_lighter), BLEND_MODE(plus_darker), BLEND_MODE(exclusion), BLEND_MODE(hue), BLEND_MODE(saturation),
+		BLEND_MODE(color), BLEND_MODE(luminosity),
+		{ "normal_linear", [](color_base* s, color_base* d) { return color_blend::normal(s, d, true, true, true); } },
+		PORTER_DUFF_MODE(src), PORTER_DUFF_MODE(dest), PORTER_DUFF_MODE(atop), PORTER_DUFF_MODE(dest_atop),
+		PORTER_DUFF_MODE(over), PORTER_DUFF_MODE(dest_over), PORTER_DUFF_MODE(in), PORTER_DUFF_MODE(dest_in),
+		PORTER_DUFF_MODE(out), PORTER_DUFF_MODE(dest_out), PORTER_DUFF_MODE(x_or), PORTER_DUFF_MODE(clear)
+	};
+
+	size_t bytes_per_color = 3 * color_bytes(color_type::RGB_TRUE);
+	for (size_t count : benchmark_registry::buffer_sizes(bytes_per_color))
+	{
+		auto prepare = [count]() { inputs.prepare(count); };
+		for (const auto& mode : modes)
+		{
+			auto function = mode.second;
+			registry.add("blend", mode.first + "/" + benchmark_registry::size_name(count), count, count * bytes_per_color,
+				[function]()
+				{
+					for (size_t i = 0; i < inputs.count; ++i) delete function(inputs.sources[i], inputs.destinations[i]);
+				},
+				prepare);
+
+			registry.add("blend_batch", mode.first + "/" + benchmark_registry::size_name(count), count, count * bytes_per_color,
+				[function, exec]()
+				{
+					auto blended = color_blend::batch_blend(inputs.sources, inputs.destinations, function, exec);
+					delete_colors(blended);
+				},
+				prepare);
+		}
+	}
+}
+
+#undef BLEND_MODE
+#undef PORTER_DUFF_MODE
@@ -0,0 +1,148 @@
+#include "benchmark.h"
+#include "benchmark_data.h"
+#include "../ColorMagic/spaces/gamma.h"
+#include "../ColorMagic/spaces/white_point.h"
+#include "../ColorMagic/manipulation/chromatic_adaptation.h"
+
+#include <random>
+#include <utility>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+typedef std::function<color_base*(color_base*, white_point*)> adaptation_function;
+
+// Gamma input values and results of the case that runs right now.
+static std::vector<float> gamma_inputs;
+static std::vector<float> gamma_outputs;
+
+// Xyz colors of the adaptation case that runs right now, see converter_inputs.
+struct adaptation_inputs
+{
+	size_t count = 0;
+	std::vector<color_base*> colors;
+
+	void prepare(size_t new_count)
+	{
+		if (count == new_count) return;
+		delete_colors(colors);
+		colors = create_colors(color_type::XYZ, new_count);
+		count = new_count;
+	}
+};
+
+static void register_gamma_benchmarks(benchmark_registry& registry)
+{
+	gamma_presets presets;
+	const std::vector<std::pair<std::string, color_space::gamma*>> curves =
+	{
+		{ "gamma1_8", presets.gamma1_8() }, { "gamma2_2", presets.gamma2_2() }, { "gamma2_6", presets.gamma2_6() },
+		{ "gamma2_8", presets.gamma2_8() }, { "sRGB", presets.sRGB() }, { "adobe", presets.gammaAdobe() },
+		{ "romm", presets.gammaRomm() }, { "uhdtv", presets.gammaUHDTV() }
+	};
+
+	// One value per color, read from one buffer and written to another
+	for (size_t count : benchmark_registry::buffer_sizes(2 * sizeof(float)))
+	{
+		auto prepare = [count]()
+		{
+			if (gamma_inputs.size() == count) return;
+			std::mt19937 random(5);
+			std::uniform_real_distribution<float> value(0.f, 1.f);
+			gamma_inputs.resize(count);
+			gamma_outputs.resize(count);
+			for (auto& input : gamma_inputs) input = value(random);
+		};
+
+		for (const auto& entry : curves)
+		{
+			const color_space::gamma* curve = entry.second;
+			std::string suffix = "/" + benchmark_registry::size_name(count);
+			size_t bytes = count * 2 * sizeof(float);
+
+			registry.add("gamma", entry.first + "/forward" + suffix, count, bytes, [curve]()
+			{
+				for (size_t i = 0; i < gamma_inputs.size(); ++i) gamma_outputs[i] = curve->gamma_correction(gamma_inputs[i]);
+				consume(gamma_outputs.back());
+			}, prepare);
+
+			registry.add("gamma", entry.first + "/inverse" + suffix, count, bytes, [curve]()
+			{
+				for (size_t i = 0; i < gamma_inputs.size(); ++i) gamma_outputs[i] = curve->inverse_gamma_correction(gamma_inputs[i]);
+				consume(gamma_outputs.back());
+			}, prepare);
+
+			registry.add("gamma", entry.first + "/table_forward" + suffix, count, bytes, [curve]()
+			{
+				for (size_t i = 0; i < gamma_inputs.size(); ++i) gamma_outputs[i] = curve->table_gamma_correction(gamma_inputs[i]);
+				consume(gamma_outputs.back());
+			}, [prepare, curve]() { prepare(); const_cast<color_space::gamma*>(curve)->compile_once(); });
+
+			registry.add("gamma", entry.first + "/table_inverse" + suffix, count, bytes, [curve]()
+			{
+				for (size_t i = 0; i < gamma_inputs.size(); ++i) gamma_outputs[i] = curve->table_inverse_gamma_correction(gamma_inputs[i]);
+				consume(gamma_outputs.back());
+			}, [prepare, curve]() { prepare(); const_cast<color_space::gamma*>(curve)->compile_once(); });
+		}
+	}
+}
+
+static void register_adaptation_benchmarks(benchmark_registry& registry)
+{
+	static adaptation_inputs inputs;
+	static white_point* target = white_point_presets().D50_2Degree();
+
+	const std::vector<std::pair<std::string, adaptation_function>> methods =
+	{
+		{ "von_kries", &chromatic_adaptation::von_kries_adaptation },
+		{ "bradford", &chromatic_adaptation::bradford_adaptation },
+		{ "bradford_simplified", &chromatic_adaptation::bradford_adaptation_simplified },
+		{ "xyz_scale", &chromatic_adaptation::xyz_scale_adaptation },
+		{ "sharp", &chromatic_adaptation::sharp_adaptation },
+		{ "cmccat97_simplified", &chromatic_adaptation::cmccat97_adaptation_simplified },
+		{ "cmccat97", [](color_base* color, white_point* white) { return chromatic_adaptation::cmccat97_adaptation(color, white, 1.f); } },
+		{ "cmccat2000_simplified", &chromatic_adaptation::cmccat2000_adaptation_simplified },
+		{ "cmccat2000", [](color_base* color, white_point* white) { return chromatic_adaptation::cmccat2000_adaptation(color, white, 1.f); } },
+		{ "cat02_simplified", &chromatic_adaptation::cat02_adaptation_simplified },
+		{ "cat02", [](color_base* color, white_point* white) { return chromatic_adaptation::cat02_adaptation(color, white, 1.f); } }
+	};
+
+	// The adaptation functions build their matrices per color, so the larger buffers would take minutes per case
+	size_t bytes_per_color = 2 * color_bytes(color_type::XYZ);
+	for (size_t count : benchmark_registry::buffer_sizes(bytes_per_color, 4096))
+	{
+		auto prepare = [count]() { inputs.prepare(count); };
+		for (const auto& method : methods)
+		{
+			auto function = method.second;
+			registry.add("adaptation", method.first + "/" + benchmark_registry::size_name(count), count, count * bytes_per_color,
+				[function]()
+				{
+					for (auto color : inputs.colors) delete function(color, target);
+				},
+				prepare);
+		}
+	}
+
+	// Building the matrices is a per-conversion cost, so it is reported per call instead of per color
+	static white_point* source = white_point_presets().D65_2Degree();
+	const std::vector<std::pair<std::string, adaptation_method>> matrices =
+	{
+		{ "bradford", BRADFORD }, { "von_kries", VON_KRIES }, { "xyz_scaling", XYZ_SCALING }, { "sharp", SHARP },
+		{ "cmccat97", CMCCAT97 }, { "cmccat2000", CMCCAT2000 }, { "cat02", CAT02 }, { "no_adaptation", NO_ADAPTATION }
+	};
+	for (const auto& entry : matrices)
+	{
+		auto method = entry.second;
+		registry.add("adaptation_matrix", entry.first, 1, 9 * sizeof(float), [method]()
+		{
+			consume(chromatic_adaptation::get_adaptation_matrix(source, target, method)(0, 0));
+		});
+	}
+}
+
+void register_color_theory_benchmarks(benchmark_registry& registry, const benchmark_options&)
+{
+	register_gamma_benchmarks(registry);
+	register_adaptation_benchmarks(registry);
+}
@@ -0,0 +1,210 @@
+#include "benchmark.h"
+#include "benchmark_data.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/manipulation/color_histogram.h"
+#include "../ColorMagic/manipulation/color_statistics.h"
+#include "../ColorMagic/manipulation/conversion_plan.h"
+#include "../ColorMagic/manipulation/palette_extractor.h"
+#include "../ColorMagic/manipulation/polar_converter.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <memory>
+#include <random>
+#include <utility>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+// Input colors of the case that runs right now. The cases are registered grouped by input type and size, so
+// consecutive cases share their inputs and only one set of large buffers is alive at a time.
+struct converter_inputs
+{
+	color_type type = color_type::UNDEFINED;
+	size_t count = 0;
+	std::vector<color_base*> colors;
+
+	void prepare(color_type new_type, size_t new_count)
+	{
+		if (type == new_type && count == new_count) return;
+		delete_colors(colors);
+		colors = create_colors(new_type, new_count);
+		type = new_type;
+		count = new_count;
+	}
+};
+
+void register_converter_benchmarks(benchmark_registry& registry, const benchmark_options& options)
+{
+	static converter_inputs inputs;
+	static sequential_executor sequential;
+	executor* exec = options.parallel ? nullptr : &sequential;
+
+	const size_t type_count = color_converter::color_type_count;
+
+	// Single colors: one virtual dispatch, one allocation and one deallocation per conversion
+	for (size_t in = 0; in < type_count; ++in)
+	{
+		auto in_type = (color_type)in;
+		size_t count = benchmark_registry::buffer_sizes(2 * color_bytes(in_type)).front();
+		for (size_t out = 0; out < type_count; ++out)
+		{
+			auto out_type = (color_type)out;
+			registry.add("convert", color_type_name(in_type) + "->" + color_type_name(out_type), count, count * (color_bytes(in_type) + color_bytes(out_type)),
+				[out_type]()
+				{
+					for (auto color : inputs.colors) delete color_converter::convertTo(color, out_type);
+				},
+				[in_type, count]() { inputs.prepare(in_type, count); });
+		}
+	}
+
+	// Batches over all buffer sizes
+	for (size_t in = 0; in < type_count; ++in)
+	{
+		auto in_type = (color_type)in;
+		for (size_t count : benchmark_registry::buffer_sizes(2 * color_bytes(in_type)))
+		{
+			for (size_t out = 0; out < type_count; ++out)
+			{
+				auto out_type = (color_type)out;
+				registry.add("convert_batch", color_type_name(in_type) + "->" + color_type_name(out_type) + "/" + benchmark_registry::size_name(count), count, count * (color_bytes(in_type) + color_bytes(out_type)),
+					[out_type, exec]()
+					{
+						auto converted = color_converter::convertTo(inputs.colors, out_type, exec);
+						delete_colors(converted);
+					},
+					[in_type, count]() { inputs.prepare(in_type, count); });
+			}
+		}
+	}
+
+	// Conversion plans on color records for comparison with the dynamic colors, once per precision policy
+	const std::vector<std::pair<std::string, precision_policy>> policies = { { "plan", EXACT }, { "plan_fast", FAST }, { "plan_fastest", FASTEST } };
+	static std::vector<float> in_records;
+	static std::vector<float> out_records;
+	for (size_t in = 0; in < type_count; ++in)
+	{
+		auto in_type = (color_type)in;
+		if (!conversion_plan::is_supported(in_type)) continue;
+
+		for (size_t count : benchmark_registry::buffer_sizes(8 * sizeof(float)))
+		{
+			auto prepare = [in_type, count]()
+			{
+				std::mt19937 random(1);
+				std::uniform_real_distribution<float> component(0.f, 1.f);
+				std::vector<float> rgb(count * 4);
+				for (auto& value : rgb) value = component(random);
+
+				in_records.resize(count * 4);
+				out_records.resize(count * 4);
+				conversion_plan::get(color_type::RGB_DEEP, benchmark_color_space(), in_type, benchmark_color_space())->apply(rgb.data(), in_records.data(), count);
+			};
+
+			for (size_t out = 0; out < type_count; ++out)
+			{
+				auto out_type = (color_type)out;
+				if (!conversion_plan::is_supported(out_type)) continue;
+
+				for (const auto& policy : policies)
+				{
+					auto plan = conversion_plan::get(in_type, benchmark_color_space(), out_type, benchmark_color_space(), BRADFORD, policy.second);
+					registry.add(policy.first, color_type_name(in_type) + "->" + color_type_name(out_type) + "/" + benchmark_registry::size_name(count), count, count * 8 * sizeof(float),
+						[plan, count, exec]() { plan->apply(in_records.data(), out_records.data(), count, exec); },
+						prepare);
+				}
+			}
+		}
+	}
+
+	// Polar conversions in place on the a and b planes, there and back per run
+	static std::vector<float> a_plane;
+	static std::vector<float> b_plane;
+	for (size_t count : benchmark_registry::buffer_sizes(2 * sizeof(float)))
+	{
+		auto prepare = [count]()
+		{
+			std::mt19937 random(1);
+			std::uniform_real_distribution<float> component(-128.f, 128.f);
+			a_plane.resize(count);
+			b_plane.resize(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				a_plane[i] = component(random);
+				b_plane[i] = component(random);
+			}
+		};
+
+		for (const auto& policy : policies)
+		{
+			std::string name = policy.first == "plan" ? "lab<->lch_ab" : "lab<->lch_ab_" + policy.first.substr(5);
+			registry.add("polar", name + "/" + benchmark_registry::size_name(count), count, count * 4 * sizeof(float),
+				[policy, count, exec]()
+				{
+					polar_converter::lab_to_lch_ab(a_plane.data(), b_plane.data(), a_plane.data(), b_plane.data(), count, policy.second, exec);
+					polar_converter::lch_ab_to_lab(a_plane.data(), b_plane.data(), a_plane.data(), b_plane.data(), count, policy.second, exec);
+				},
+				prepare);
+		}
+	}
+
+	// Statistics and histograms of rgba pixels, directly and on the way to lab
+	static std::vector<uint8_t> pixels;
+	for (size_t count : benchmark_registry::buffer_sizes(4))
+	{
+		auto prepare = [count]()
+		{
+			std::mt19937 random(1);
+			std::uniform_int_distribution<int> component(0, 255);
+			pixels.resize(count * 4);
+			for (auto& value : pixels) value = (uint8_t)component(random);
+		};
+
+		registry.add("statistics", "rgb/" + benchmark_registry::size_name(count), count, count * 4,
+			[count, exec]() { color_statistics::compute(pixel_view(pixels.data(), RGBA32, count), true, nullptr, exec); },
+			prepare);
+
+		auto plan = conversion_plan::get(color_type::RGB_TRUE, benchmark_color_space(), color_type::LAB, benchmark_color_space(), BRADFORD, FAST);
+		registry.add("statistics", "lab/" + benchmark_registry::size_name(count), count, count * 4,
+			[plan, count, exec]() { color_statistics::compute(pixel_view(pixels.data(), RGBA32, count), true, plan.get(), exec); },
+			prepare);
+
+		for (size_t bins : { 32, 64 })
+		{
+			registry.add("histogram", "rgb_" + std::to_string(bins) + "/" + benchmark_registry::size_name(count), count, count * 4,
+				[bins, count, exec]() { color_histogram::compute(pixel_view(pixels.data(), RGBA32, count), bins, exec); },
+				prepare);
+		}
+		registry.add("histogram", "lab_32/" + benchmark_registry::size_name(count), count, count * 4,
+			[plan, count, exec]() { color_histogram::compute(pixel_view(pixels.data(), RGBA32, count), *plan, 32, exec); },
+			prepare);
+		registry.add("histogram", "unique/" + benchmark_registry::size_name(count), count, count * 4,
+			[count, exec]() { unique_color_table::compute(pixel_view(pixels.data(), RGBA32, count), exec); },
+			prepare);
+	}
+
+	// Palettes of 16 colors of images with 4096 distinct colors, over the distinct colors and over all pixels
+	static std::vector<uint8_t> palette_pixels;
+	for (size_t count : benchmark_registry::buffer_sizes(4))
+	{
+		if (count > 1048576) continue;
+
+		auto prepare = [count]()
+		{
+			std::mt19937 random(1);
+			std::uniform_int_distribution<int> component(0, 255);
+			palette_pixels.resize(count * 4);
+			for (auto& value : palette_pixels) value = (uint8_t)(component(random) & 0xF0);
+		};
+
+		for (auto use_unique_colors : { true, false })
+		{
+			palette_options palette;
+			palette.color_count = 16;
+			palette.use_unique_colors = use_unique_colors;
+			registry.add("palette", std::string(use_unique_colors ? "unique" : "pixels") + "/" + benchmark_registry::size_name(count), count, count * 4,
+				[palette, count, exec]() { palette_extractor::extract(pixel_view(palette_pixels.data(), RGBA32, count), benchmark_color_space(), palette, exec); },
+				prepare);
+		}
+	}
+}
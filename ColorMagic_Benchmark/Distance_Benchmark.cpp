@@ -0,0 +1,77 @@
+#include "benchmark.h"
+#include "benchmark_data.h"
+#include "../ColorMagic/manipulation/color_distance.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <utility>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+typedef std::function<float(color_base*, color_base*)> distance_function;
+
+// Color pairs of the case that runs right now, see converter_inputs.
+struct distance_inputs
+{
+	size_t count = 0;
+	std::vector<color_base*> colors1;
+	std::vector<color_base*> colors2;
+
+	void prepare(size_t new_count)
+	{
+		if (count == new_count) return;
+		delete_colors(colors1);
+		delete_colors(colors2);
+		colors1 = create_colors(color_type::RGB_TRUE, new_count, 1);
+		colors2 = create_colors(color_type::RGB_TRUE, new_count, 2);
+		count = new_count;
+	}
+};
+
+void register_distance_benchmarks(benchmark_registry& registry, const benchmark_options& options)
+{
+	static distance_inputs inputs;
+	static sequential_executor sequential;
+	executor* exec = options.parallel ? nullptr : &sequential;
+
+	const std::vector<std::pair<std::string, distance_function>> metrics =
+	{
+		{ "euclidean_squared", [](color_base* c1, color_base* c2) { return color_distance::euclidean_distance_squared(c1, c2); } },
+		{ "euclidean", [](color_base* c1, color_base* c2) { return color_distance::euclidean_distance(c1, c2); } },
+		{ "euclidean_lab", [](color_base* c1, color_base* c2) { return color_distance::euclidean_distance(c1, c2, color_type::LAB); } },
+		{ "euclidean_weighted", [](color_base* c1, color_base* c2) { return color_distance::euclidean_distance_weighted(c1, c2); } },
+		{ "cie76", [](color_base* c1, color_base* c2) { return color_distance::cielab_delta_e_cie76(c1, c2); } },
+		{ "cie94", [](color_base* c1, color_base* c2) { return color_distance::cielab_delta_e_cie94(c1, c2); } },
+		{ "cie00", [](color_base* c1, color_base* c2) { return color_distance::cielab_delta_e_cie00(c1, c2); } },
+		{ "cie00_fast", [](color_base* c1, color_base* c2) { return color_distance::cielab_delta_e_cie00<FAST>(c1, c2); } },
+		{ "cie00_fastest", [](color_base* c1, color_base* c2) { return color_distance::cielab_delta_e_cie00<FASTEST>(c1, c2); } },
+		{ "cmc_lc84", [](color_base* c1, color_base* c2) { return color_distance::cmc_delta_e_lc84(c1, c2); } },
+		{ "cmc_lc84_fast", [](color_base* c1, color_base* c2) { return color_distance::cmc_delta_e_lc84<FAST>(c1, c2); } }
+	};
+
+	size_t bytes_per_pair = 2 * color_bytes(color_type::RGB_TRUE);
+	for (size_t count : benchmark_registry::buffer_sizes(bytes_per_pair))
+	{
+		auto prepare = [count]() { inputs.prepare(count); };
+		for (const auto& metric : metrics)
+		{
+			auto function = metric.second;
+			registry.add("distance", metric.first + "/" + benchmark_registry::size_name(count), count, count * bytes_per_pair,
+				[function]()
+				{
+					float sum = 0.f;
+					for (size_t i = 0; i < inputs.count; ++i) sum += function(inputs.colors1[i], inputs.colors2[i]);
+					consume(sum);
+				},
+				prepare);
+
+			registry.add("distance_batch", metric.first + "/" + benchmark_registry::size_name(count), count, count * (bytes_per_pair + sizeof(float)),
+				[function, exec]()
+				{
+					auto distances = color_distance::batch_distance(inputs.colors1, inputs.colors2, function, exec);
+					consume(distances.back());
+				},
+				prepare);
+		}
+	}
+}
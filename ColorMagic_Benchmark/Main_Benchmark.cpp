@@ -0,0 +1,55 @@
+#include "benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+static void print_usage()
+{
+	std::cout << "Usage: ColorMagic_Benchmark [options]\n"
+		<< "  --filter=TEXT    Only run cases whose group/name contains TEXT, e.g. --filter=convert/rgb_true\n"
+		<< "  --min-time=SEC   Minimal measured time per case in seconds (default 0.1)\n"
+		<< "  --parallel       Run the batch functions on the default thread pool instead of the calling thread\n"
+		<< "  --csv            Print comma separated values\n"
+		<< "  --accuracy       Print error and throughput of the fast conversion paths (plans, rgb_16, lab_table)\n"
+		<< "Groups: convert, convert_batch, plan, distance, distance_batch, blend, blend_batch, gamma, adaptation, adaptation_matrix, math, polar, statistics, histogram, palette\n";
+}
+
+int main(int argc, char** argv)
+{
+	benchmark_options options;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* argument = argv[i];
+		if (strncmp(argument, "--filter=", 9) == 0) options.filter = argument + 9;
+		else if (strncmp(argument, "--min-time=", 11) == 0) options.min_seconds = atof(argument + 11);
+		else if (strcmp(argument, "--parallel") == 0) options.parallel = true;
+		else if (strcmp(argument, "--csv") == 0) options.csv = true;
+		else if (strcmp(argument, "--accuracy") == 0) options.accuracy = true;
+		else
+		{
+			print_usage();
+			return strcmp(argument, "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	if (options.accuracy)
+	{
+		write_accuracy_table(options, std::cout);
+		return 0;
+	}
+
+	benchmark_registry registry;
+	register_converter_benchmarks(registry, options);
+	register_distance_benchmarks(registry, options);
+	register_blend_benchmarks(registry, options);
+	register_color_theory_benchmarks(registry, options);
+	register_math_benchmarks(registry, options);
+
+	if (registry.run(options, std::cout) == 0)
+	{
+		std::cerr << "No benchmark matches the filter.\n";
+		return 1;
+	}
+	return 0;
+}
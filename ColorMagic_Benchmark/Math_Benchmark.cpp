@@ -0,0 +1,89 @@
+#include "benchmark.h"
+#include "../ColorMagic/utils/simd_math.h"
+
+#include <cmath>
+#include <utility>
+
+// Arguments of the case that runs right now, see converter_inputs. values are in (0, 1], so every function gets
+// arguments from its usual range in the color conversions.
+struct math_inputs
+{
+	size_t count = 0;
+	std::vector<float> values;
+	std::vector<float> angles;
+	std::vector<float> out1;
+	std::vector<float> out2;
+
+	void prepare(size_t new_count)
+	{
+		if (count == new_count) return;
+		values.resize(new_count);
+		angles.resize(new_count);
+		out1.resize(new_count);
+		out2.resize(new_count);
+		for (size_t i = 0; i < new_count; ++i)
+		{
+			values[i] = (float)((i * 7919) % 65536 + 1) / 65536.f;
+			angles[i] = (values[i] - 0.5f) * 12.f;
+		}
+		count = new_count;
+	}
+};
+
+// Functions with the standard library on each value and the vectorized functions of a policy.
+template <precision_policy Policy> static std::vector<std::pair<std::string, std::function<void(math_inputs&)>>> simd_functions(const std::string& suffix)
+{
+	typedef simd_batch<Policy> batch;
+	return
+	{
+		{ "cbrt_" + suffix, [](math_inputs& in) { batch::cbrt(in.values.data(), in.out1.data(), in.count); } },
+		{ "pow_" + suffix, [](math_inputs& in) { batch::pow(in.values.data(), 2.4f, in.out1.data(), in.count); } },
+		{ "exp_" + suffix, [](math_inputs& in) { batch::exp(in.angles.data(), in.out1.data(), in.count); } },
+		{ "atan2_" + suffix, [](math_inputs& in) { batch::atan2(in.angles.data(), in.values.data(), in.out1.data(), in.count); } },
+		{ "sincos_" + suffix, [](math_inputs& in) { batch::sincos(in.angles.data(), in.out1.data(), in.out2.data(), in.count); } },
+		{ "acos_" + suffix, [](math_inputs& in) { batch::acos(in.values.data(), in.out1.data(), in.count); } }
+	};
+}
+
+void register_math_benchmarks(benchmark_registry& registry, const benchmark_options&)
+{
+	static math_inputs inputs;
+
+	std::vector<std::pair<std::string, std::function<void(math_inputs&)>>> functions =
+	{
+		{ "cbrt_std", [](math_inputs& in) { for (size_t i = 0; i < in.count; ++i) in.out1[i] = std::cbrt(in.values[i]); } },
+		{ "pow_std", [](math_inputs& in) { for (size_t i = 0; i < in.count; ++i) in.out1[i] = std::pow(in.values[i], 2.4f); } },
+		{ "exp_std", [](math_inputs& in) { for (size_t i = 0; i < in.count; ++i) in.out1[i] = std::exp(in.angles[i]); } },
+		{ "atan2_std", [](math_inputs& in) { for (size_t i = 0; i < in.count; ++i) in.out1[i] = std::atan2(in.angles[i], in.values[i]); } },
+		{ "sincos_std", [](math_inputs& in)
+		{
+			for (size_t i = 0; i < in.count; ++i)
+			{
+				in.out1[i] = std::sin(in.angles[i]);
+				in.out2[i] = std::cos(in.angles[i]);
+			}
+		} },
+		{ "acos_std", [](math_inputs& in) { for (size_t i = 0; i < in.count; ++i) in.out1[i] = std::acos(in.values[i]); } }
+	};
+	for (const auto& functions_of_policy : { simd_functions<FAST>("fast"), simd_functions<FASTEST>("fastest") })
+	{
+		functions.insert(functions.end(), functions_of_policy.begin(), functions_of_policy.end());
+	}
+
+	size_t bytes_per_value = 2 * sizeof(float);
+	for (size_t count : benchmark_registry::buffer_sizes(bytes_per_value))
+	{
+		auto prepare = [count]() { inputs.prepare(count); };
+		for (const auto& function : functions)
+		{
+			auto body = function.second;
+			registry.add("math", function.first + "/" + benchmark_registry::size_name(count), count, count * bytes_per_value,
+				[body]()
+				{
+					body(inputs);
+					consume(inputs.out1.back());
+				},
+				prepare);
+		}
+	}
+}
@@ -0,0 +1,166 @@
+#include "benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Allocations of the whole program. Replacing the global operator new is the only portable way to see the
+// allocations made inside the library.
+static std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+size_t allocation_count()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+static volatile float sink;
+
+void consume(float value)
+{
+	sink = value;
+}
+
+void benchmark_registry::add(const std::string& group, const std::string& name, size_t colors, size_t bytes, std::function<void()> body, std::function<void()> setup, std::function<void()> teardown)
+{
+	benchmark_case entry;
+	entry.group = group;
+	entry.name = name;
+	entry.colors = colors;
+	entry.bytes = bytes;
+	entry.setup = setup;
+	entry.body = body;
+	entry.teardown = teardown;
+	m_cases.push_back(entry);
+}
+
+size_t benchmark_registry::run(const benchmark_options& options, std::ostream& out) const
+{
+	char line[256];
+	if (options.csv)
+	{
+		out << "group,name,colors,ns_per_color,mb_per_second,allocations_per_color,iterations\n";
+	}
+	else
+	{
+		snprintf(line, sizeof(line), "%-56s %10s %12s %10s %14s\n", "benchmark", "colors", "ns/color", "MB/s", "allocs/color");
+		out << line;
+	}
+
+	size_t count = 0;
+	for (const auto& entry : m_cases)
+	{
+		std::string full_name = entry.group + "/" + entry.name;
+		if (!options.filter.empty() && full_name.find(options.filter) == std::string::npos) continue;
+
+		if (entry.setup) entry.setup();
+		auto result = measure(entry, options.min_seconds);
+		if (entry.teardown) entry.teardown();
+
+		if (options.csv)
+		{
+			snprintf(line, sizeof(line), "%s,%s,%zu,%.3f,%.1f,%.4f,%zu\n", entry.group.c_str(), entry.name.c_str(), entry.colors, result.ns_per_color, result.mb_per_second, result.allocations_per_color, result.iterations);
+		}
+		else
+		{
+			snprintf(line, sizeof(line), "%-56s %10zu %12.3f %10.1f %14.4f\n", full_name.c_str(), entry.colors, result.ns_per_color, result.mb_per_second, result.allocations_per_color);
+		}
+		out << line << std::flush;
+		++count;
+	}
+	return count;
+}
+
+benchmark_result benchmark_registry::measure(const benchmark_case& entry, double min_seconds)
+{
+	// Warm up caches, branch predictors and lazily built tables
+	entry.body();
+
+	size_t iterations = 1;
+	while (true)
+	{
+		size_t allocations_before = allocation_count();
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i) entry.body();
+		auto end = std::chrono::steady_clock::now();
+		size_t allocations_after = allocation_count();
+
+		double seconds = std::chrono::duration<double>(end - start).count();
+		if (seconds >= min_seconds || iterations >= ((size_t)1 << 40))
+		{
+			double colors = (double)entry.colors * (double)iterations;
+			benchmark_result result;
+			result.ns_per_color = seconds * 1e9 / colors;
+			result.mb_per_second = seconds > 0. ? (double)entry.bytes * (double)iterations / seconds / 1e6 : 0.;
+			result.allocations_per_color = (double)(allocations_after - allocations_before) / colors;
+			result.iterations = iterations;
+			return result;
+		}
+
+		// Jump close to the target time instead of doubling blindly if the round was long enough to be meaningful
+		if (seconds > min_seconds / 100.)
+		{
+			iterations = (size_t)(iterations * (min_seconds * 1.2 / seconds)) + 1;
+		}
+		else
+		{
+			iterations *= 2;
+		}
+	}
+}
+
+std::vector<size_t> benchmark_registry::buffer_sizes(size_t bytes_per_color, size_t max_colors)
+{
+	static const size_t working_sets[] = { (size_t)16 << 10, (size_t)256 << 10, (size_t)4 << 20, (size_t)64 << 20 };
+
+	std::vector<size_t> sizes;
+	for (size_t bytes : working_sets)
+	{
+		size_t colors = bytes / (bytes_per_color > 0 ? bytes_per_color : 1);
+		if (colors == 0) colors = 1;
+		if (colors > max_colors) break;
+		sizes.push_back(colors);
+	}
+	if (sizes.empty()) sizes.push_back(max_colors);
+	return sizes;
+}
+
+std::string benchmark_registry::size_name(size_t colors)
+{
+	if (colors >= ((size_t)1 << 20) && colors % ((size_t)1 << 20) == 0) return std::to_string(colors >> 20) + "M";
+	if (colors >= ((size_t)1 << 10) && colors % ((size_t)1 << 10) == 0) return std::to_string(colors >> 10) + "k";
+	return std::to_string(colors);
+}
@@ -0,0 +1,111 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! Returns the number of heap allocations since the start of the program.
+/*!
+* Counted by the global operator new of the benchmark executable, so every allocation of the library is included.
+*/
+size_t allocation_count();
+
+//! Stores a result so that the compiler cannot remove the calculation of it.
+void consume(float value);
+
+//! A single benchmark case.
+struct benchmark_case
+{
+	std::string group; /*!< The group used for filtering, e.g. "convert" */
+	std::string name; /*!< The name of the case inside the group */
+	size_t colors; /*!< The number of colors processed by a single call of body */
+	size_t bytes; /*!< The number of bytes read and written by a single call of body */
+	std::function<void()> setup; /*!< Called once before the measurement, e.g. to create the input buffers. May be empty */
+	std::function<void()> body; /*!< The measured operation */
+	std::function<void()> teardown; /*!< Called once after the measurement. May be empty */
+};
+
+//! The measured values of a benchmark case.
+struct benchmark_result
+{
+	double ns_per_color; /*!< Nanoseconds per processed color */
+	double mb_per_second; /*!< Processed megabytes (10^6 bytes) per second */
+	double allocations_per_color; /*!< Heap allocations per processed color */
+	size_t iterations; /*!< The number of measured calls of the body */
+};
+
+//! Options of a benchmark run, set by the command line of the benchmark executable.
+struct benchmark_options
+{
+	std::string filter; /*!< Only cases whose "group/name" contains this text are run. Empty runs all cases */
+	double min_seconds = 0.1; /*!< Minimal measured time per case */
+	bool csv = false; /*!< Print comma separated values instead of a table */
+	bool parallel = false; /*!< Run the batch functions on the default thread pool instead of the calling thread */
+	bool accuracy = false; /*!< Print the error and speed of the fast conversion paths instead of running the cases */
+};
+
+//! Collection of benchmark cases.
+/*!
+* Each case is run once to warm up caches and lazily created tables. Afterwards the body is called in rounds with
+* a doubling number of calls until a round takes at least min_seconds. Time and allocations of the last round are
+* reported per processed color.
+*/
+class benchmark_registry
+{
+public:
+	//! Adds a case. Setup and teardown are run right before and after the measurement of the case.
+	void add(const std::string& group, const std::string& name, size_t colors, size_t bytes, std::function<void()> body, std::function<void()> setup = nullptr, std::function<void()> teardown = nullptr);
+
+	//! Runs all cases that match the filter of the options and prints one line per case.
+	/*!
+	* \return The number of cases that were run.
+	*/
+	size_t run(const benchmark_options& options, std::ostream& out) const;
+
+	//! Measures a single case.
+	static benchmark_result measure(const benchmark_case& entry, double min_seconds);
+
+	//! Returns the buffer sizes (in colors) used by the cases of a group.
+	/*!
+	* The sizes are chosen so that the working set fits into the L1 cache (16 KB), the L2 cache (256 KB), the L3
+	* cache (4 MB) and main memory (64 MB) of a typical desktop processor.
+	* \param bytes_per_color The number of bytes a single color occupies in the input and output buffers.
+	* \param max_colors Upper limit for the sizes, e.g. for cases that are too slow for large buffers.
+	* \return The sizes in ascending order.
+	*/
+	static std::vector<size_t> buffer_sizes(size_t bytes_per_color, size_t max_colors = (size_t)-1);
+
+	//! Returns a name suffix like "4k" or "1M" for a buffer size.
+	static std::string size_name(size_t colors);
+
+private:
+	std::vector<benchmark_case> m_cases;
+};
+
+//! Registers single and batch conversions between all pairs of color types.
+void register_converter_benchmarks(benchmark_registry& registry, const benchmark_options& options);
+
+//! Registers all color distance metrics.
+void register_distance_benchmarks(benchmark_registry& registry, const benchmark_options& options);
+
+//! Registers all color_blend and porter_duff modes.
+void register_blend_benchmarks(benchmark_registry& registry, const benchmark_options& options);
+
+//! Registers the gamma presets and the chromatic adaptation methods.
+void register_color_theory_benchmarks(benchmark_registry& registry, const benchmark_options& options);
+
+//! Registers the functions of simd_math against the standard library.
+void register_math_benchmarks(benchmark_registry& registry, const benchmark_options& options);
+
+//! Compares the fast conversion paths with the reference conversion and prints error and throughput of each.
+/*!
+* The filter of the options selects the fast paths by name, e.g. "plan_half" or "lab_table".
+*/
+void write_accuracy_table(const benchmark_options& options, std::ostream& out);
@@ -0,0 +1,44 @@
+#include "benchmark_data.h"
+#include "../ColorMagic/spaces/rgb_deepcolor.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+
+#include <random>
+
+color_space::rgb_color_space_definition* benchmark_color_space()
+{
+	static auto srgb = color_space::rgb_color_space_definition_presets().sRGB();
+	return srgb;
+}
+
+std::string color_type_name(color_type type)
+{
+	static const char* names[] = { "rgb_true", "rgb_deep", "grey_true", "grey_deep", "cmyk", "hsi", "hsv", "hsl", "hcy", "xyz", "xyy", "cieluv", "lab", "lch_ab", "lch_uv" };
+	return (size_t)type < sizeof(names) / sizeof(names[0]) ? names[type] : "undefined";
+}
+
+std::vector<color_space::color_base*> create_colors(color_type type, size_t count, unsigned seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> component(0.f, 1.f);
+
+	std::vector<color_space::color_base*> colors;
+	colors.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		color_space::rgb_deepcolor rgb(component(random), component(random), component(random), component(random), benchmark_color_space());
+		colors.push_back(color_manipulation::color_converter::convertTo(&rgb, type));
+	}
+	return colors;
+}
+
+void delete_colors(std::vector<color_space::color_base*>& colors)
+{
+	for (auto color : colors) delete color;
+	colors.clear();
+}
+
+size_t color_bytes(color_type type)
+{
+	size_t components = type == color_type::GREY_TRUE || type == color_type::GREY_DEEP ? 1 : type == color_type::CMYK ? 4 : 3;
+	return sizeof(color_space::color_base) + components * sizeof(float);
+}
@@ -0,0 +1,36 @@
+/// Copyright Martin Ruehlicke, 2019
+/// Use, modification and distribution are subject to the
+/// MIT Software License, Version 1.0.
+/// See accompanying file LICENSE.txt
+
+#pragma once
+
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/rgb_color_space_definition.h"
+#include "../ColorMagic/utils/color_type.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//! Returns the sRGB definition used by all benchmark colors.
+color_space::rgb_color_space_definition* benchmark_color_space();
+
+//! Returns a short name of a color type, e.g. "rgb_true" or "lch_ab".
+std::string color_type_name(color_type type);
+
+//! Creates reproducible random colors of the given type. The caller owns the colors, see delete_colors().
+/*!
+* The colors are random sRGB colors converted to the given type, so all of them are valid colors of the type.
+* \param type The color type of the colors.
+* \param count The number of colors.
+* \param seed The seed of the random number generator.
+* \return The colors.
+*/
+std::vector<color_space::color_base*> create_colors(color_type type, size_t count, unsigned seed = 1);
+
+//! Deletes all colors of the list and clears it.
+void delete_colors(std::vector<color_space::color_base*>& colors);
+
+//! Returns the approximate number of bytes a dynamic color of the given type occupies, including its component vector.
+size_t color_bytes(color_type type);
@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/accuracy_harness.h"
+#include "../ColorMagic/manipulation/conversion_plan.h"
+#include "../ColorMagic/manipulation/rgb_16_converter.h"
+#include "../ColorMagic/utils/half.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+class AccuracyHarness_Test : public ::testing::Test {
+protected:
+	rgb_color_space_definition* srgb;
+
+	// Types the conversion plans support
+	std::vector<color_type> plan_types;
+
+	virtual void SetUp()
+	{
+		srgb = rgb_color_space_definition_presets().sRGB();
+		for (size_t type = 0; type < color_converter::color_type_count; ++type)
+		{
+			if (conversion_plan::is_supported((color_type)type)) plan_types.push_back((color_type)type);
+		}
+	}
+
+	virtual void TearDown()
+	{
+	}
+
+	// Fails with the report if the bounds are exceeded
+	void expect_bounds(const accuracy_report& report, const accuracy_bounds& bounds)
+	{
+		std::ostringstream table;
+		accuracy_harness::write_table({ report }, table);
+		EXPECT_TRUE(bounds.is_met_by(report)) << table.str();
+	}
+
+	// Bounds of the conversion plans. Rgb true outputs may be one quantization step off. The hue of lch outputs is
+	// undefined for achromatic colors and the fast path may pick another angle than the reference, which lch_ab turns
+	// into a visible difference because of its chroma offset. Half records only keep 11 significant bits.
+	accuracy_bounds plan_bounds(color_type out_type, bool half_records)
+	{
+		if (out_type == color_type::RGB_TRUE) return half_records ? accuracy_bounds{ 1.5f, 0.05f, 0 } : accuracy_bounds{ 1.f, 0.02f, 0 };
+		if (out_type == color_type::LCH_AB) return half_records ? accuracy_bounds{ 3.f, 0.03f, 0 } : accuracy_bounds{ 3.f, 0.01f, 0 };
+		return half_records ? accuracy_bounds{ 0.25f, 0.03f, 0 } : accuracy_bounds{ 0.001f, 0.0001f, 4096 };
+	}
+};
+
+TEST_F(AccuracyHarness_Test, Ulp_Tests)
+{
+	EXPECT_EQ(0u, accuracy_harness::ulp_distance(1.f, 1.f));
+	EXPECT_EQ(0u, accuracy_harness::ulp_distance(0.f, -0.f));
+	EXPECT_EQ(1u, accuracy_harness::ulp_distance(1.f, std::nextafter(1.f, 2.f)));
+	EXPECT_EQ(1u, accuracy_harness::ulp_distance(-1.f, std::nextafter(-1.f, -2.f)));
+	EXPECT_EQ(2u, accuracy_harness::ulp_distance(std::nextafter(0.f, 1.f), std::nextafter(0.f, -1.f)));
+	EXPECT_EQ(UINT32_MAX, accuracy_harness::ulp_distance(NAN, 1.f));
+
+	EXPECT_EQ(1u, accuracy_harness::ulp_error(std::nextafter(100.f, 200.f), 100.f));
+	EXPECT_EQ(2u, accuracy_harness::ulp_error(2.f, std::nextafter(std::nextafter(2.f, 4.f), 4.f)));
+	EXPECT_EQ(0u, accuracy_harness::ulp_error(1e-12f, 0.f));
+	EXPECT_EQ(1u, accuracy_harness::ulp_error(std::ldexp(1.f, -23), 0.f));
+	EXPECT_EQ(1u, accuracy_harness::ulp_error(0.25f + std::ldexp(1.f, -23), 0.25f));
+	EXPECT_EQ(UINT32_MAX, accuracy_harness::ulp_error(1.f, NAN));
+}
+
+TEST_F(AccuracyHarness_Test, Grid_Tests)
+{
+	auto rgb = accuracy_harness::sample_grid(color_type::RGB_DEEP, 3, srgb);
+	ASSERT_EQ((size_t)(27 * 4), rgb.size());
+	EXPECT_EQ(0.f, rgb[0]);
+	EXPECT_EQ(0.5f, rgb[4 * 4 + 1]);
+	EXPECT_EQ(1.f, rgb[26 * 4 + 2]);
+
+	// Other types are the same colors after the reference conversion, cmyk records have 5 values
+	auto cmyk = accuracy_harness::sample_grid(color_type::CMYK, 3, srgb);
+	EXPECT_EQ((size_t)(27 * 5), cmyk.size());
+	EXPECT_EQ(accuracy_harness::reference(color_type::RGB_DEEP, color_type::CMYK, rgb, srgb), cmyk);
+
+	EXPECT_THROW(accuracy_harness::sample_grid(color_type::LAB, 1, srgb), std::invalid_argument*);
+}
+
+TEST_F(AccuracyHarness_Test, Detection_Tests)
+{
+	auto records = accuracy_harness::sample_grid(color_type::RGB_DEEP, 9, srgb);
+	accuracy_bounds bounds = { 0.01f, 0.001f, 64 };
+
+	// The reference itself passes
+	auto exact = accuracy_harness::compare("reference", color_type::RGB_DEEP, color_type::LAB, records, [&](const float* in, float* out, size_t count)
+	{
+		auto converted = accuracy_harness::reference(color_type::RGB_DEEP, color_type::LAB, std::vector<float>(in, in + count * 4), srgb);
+		std::copy(converted.begin(), converted.end(), out);
+	}, srgb);
+	EXPECT_EQ(729u, exact.sample_count);
+	EXPECT_EQ(0.f, exact.max_delta_e);
+	EXPECT_EQ(0u, exact.max_ulp);
+	EXPECT_TRUE(bounds.is_met_by(exact));
+
+	// A path that is one unit off in lightness is caught and the worst input is reported
+	auto shifted = accuracy_harness::compare("shifted", color_type::RGB_DEEP, color_type::LAB, records, [&](const float* in, float* out, size_t count)
+	{
+		auto converted = accuracy_harness::reference(color_type::RGB_DEEP, color_type::LAB, std::vector<float>(in, in + count * 4), srgb);
+		std::copy(converted.begin(), converted.end(), out);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (in[i * 4] == 1.f && in[i * 4 + 1] == 0.f && in[i * 4 + 2] == 0.f) out[i * 4] += 1.f;
+		}
+	}, srgb, true);
+	EXPECT_FALSE(bounds.is_met_by(shifted));
+	EXPECT_NEAR(1.f, shifted.max_delta_e, 0.1f);
+	EXPECT_EQ(1.f, shifted.worst_input[0]);
+	EXPECT_EQ(0.f, shifted.worst_input[1]);
+	EXPECT_GT(shifted.ns_per_color, 0.);
+}
+
+TEST_F(AccuracyHarness_Test, ConversionPlan_Tests)
+{
+	for (auto in_type : plan_types)
+	{
+		auto records = accuracy_harness::sample_grid(in_type, 17, srgb);
+		for (auto out_type : plan_types)
+		{
+			auto plan = conversion_plan::get(in_type, srgb, out_type, srgb);
+			auto single = accuracy_harness::compare("plan_float", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				plan->apply(in, out, count);
+			}, srgb);
+
+			auto precise = accuracy_harness::compare("plan_double", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				std::vector<double> buffer(in, in + count * 4);
+				plan->apply(buffer.data(), buffer.data(), count);
+				std::copy(buffer.begin(), buffer.end(), out);
+			}, srgb);
+
+			auto reduced = accuracy_harness::compare("plan_half", in_type, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				std::vector<half> buffer(count * 4);
+				half::pack(in, buffer.data(), buffer.size());
+				plan->apply(buffer.data(), buffer.data(), count);
+				half::unpack(buffer.data(), out, buffer.size());
+			}, srgb);
+
+			expect_bounds(single, plan_bounds(out_type, false));
+			expect_bounds(precise, plan_bounds(out_type, false));
+			expect_bounds(reduced, plan_bounds(out_type, true));
+		}
+	}
+}
+
+TEST_F(AccuracyHarness_Test, Rgb16_Tests)
+{
+	auto converter = rgb_16_converter::get(srgb);
+
+	// 52 steps hit exact 16 bit values (65535 = 51 * 1285), so the quantization of the input adds no error
+	auto rgb = accuracy_harness::sample_grid(color_type::RGB_DEEP, 52, srgb);
+	auto to_pixels = [](const float* in, size_t count)
+	{
+		std::vector<rgb_16> pixels(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			pixels[i] = { (uint16_t)std::lround(in[i * 4] * 65535.f), (uint16_t)std::lround(in[i * 4 + 1] * 65535.f), (uint16_t)std::lround(in[i * 4 + 2] * 65535.f), 65535 };
+		}
+		return pixels;
+	};
+
+	expect_bounds(accuracy_harness::compare("rgb_16_to_xyz", color_type::RGB_DEEP, color_type::XYZ, rgb, [&](const float* in, float* out, size_t count)
+	{
+		converter->to_xyz(to_pixels(in, count).data(), out, count);
+	}, srgb), { 0.001f, 0.0001f, 1024 });
+	expect_bounds(accuracy_harness::compare("rgb_16_to_lab", color_type::RGB_DEEP, color_type::LAB, rgb, [&](const float* in, float* out, size_t count)
+	{
+		converter->to_lab(to_pixels(in, count).data(), out, count);
+	}, srgb), { 0.001f, 0.0001f, 1024 });
+
+	auto lab = accuracy_harness::sample_grid(color_type::LAB, 17, srgb);
+
+	// The output is quantized to 16 bit
+	expect_bounds(accuracy_harness::compare("rgb_16_from_lab", color_type::LAB, color_type::RGB_DEEP, lab, [&](const float* in, float* out, size_t count)
+	{
+		std::vector<rgb_16> pixels(count);
+		converter->from_lab(in, pixels.data(), count);
+		converter->to_rgb_deep(pixels.data(), out, count);
+	}, srgb), { 0.01f, 0.001f, 0 });
+}
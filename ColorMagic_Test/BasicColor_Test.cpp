@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/spaces/basic_color.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+
+using namespace color_space;
+
+class BasicColor_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	rgb_color_space_definition* srgb;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+	}
+
+	virtual void TearDown()
+	{
+	}
+
+	template <typename To, typename From> void expect_same_like_converter(const basic_color<From>& color, float tolerance)
+	{
+		auto dynamic_color = color.to_dynamic();
+		auto expected = color_manipulation::color_converter::convertTo(dynamic_color, To::type());
+		auto result = convert<To>(color);
+
+		ASSERT_EQ(expected->get_component_vector().size(), result.component_count());
+		for (size_t i = 0; i < result.component_count(); ++i) EXPECT_NEAR(expected->get_component((int)i), result[i], tolerance) << To::component_name(i);
+		EXPECT_NEAR(expected->alpha(), result.alpha(), tolerance);
+		EXPECT_EQ(srgb, result.get_rgb_color_space());
+
+		delete expected;
+		delete dynamic_color;
+	}
+
+	template <typename From> void expect_all_same_like_converter(const basic_color<From>& color)
+	{
+		expect_same_like_converter<rgb_true_space>(color, 1.f);
+		expect_same_like_converter<rgb_deep_space>(color, avg_error);
+		expect_same_like_converter<grey_true_space>(color, 1.f);
+		expect_same_like_converter<grey_deep_space>(color, avg_error);
+		expect_same_like_converter<cmyk_space>(color, avg_error);
+		expect_same_like_converter<hsi_space>(color, avg_error);
+		expect_same_like_converter<hsv_space>(color, avg_error);
+		expect_same_like_converter<hsl_space>(color, avg_error);
+		expect_same_like_converter<hcy_space>(color, avg_error);
+		expect_same_like_converter<xyz_space>(color, avg_error);
+		expect_same_like_converter<xyy_space>(color, avg_error);
+		expect_same_like_converter<cieluv_space>(color, avg_error);
+		expect_same_like_converter<lab_space>(color, avg_error);
+		expect_same_like_converter<lch_ab_space>(color, avg_error);
+		expect_same_like_converter<lch_uv_space>(color, avg_error);
+	}
+};
+
+TEST_F(BasicColor_Test, Traits_Tests)
+{
+	static_assert(basic_color<rgb_true_space>::component_count() == 3, "rgb has three components");
+	static_assert(basic_color<cmyk_space>::component_count() == 4, "cmyk has four components");
+	static_assert(basic_color<grey_deep_space>::component_count() == 1, "grey has one component");
+	static_assert(basic_color<lab_space>::component_min(1) == -128.f, "lab a starts at -128");
+	static_assert(basic_color<lab_space>::component_max(0) == 100.f, "lab L ends at 100");
+	static_assert(basic_color<hsv_space>::component_max(0) == 359.f, "hue is in degrees");
+	static_assert(basic_color<rgb_true_space>::alpha_max() == 255.f, "true color alpha ends at 255");
+	static_assert(basic_color<xyz_space, double>::type() == color_type::XYZ, "tags know their color type");
+
+	EXPECT_STREQ("L", basic_color<lab_space>::component_name(0));
+	EXPECT_STREQ("K", basic_color<cmyk_space>::component_name(3));
+	EXPECT_STREQ("Y", basic_color<xyy_space>::component_name(2));
+
+	// Components and alpha are clamped like the dynamic classes do
+	basic_color<rgb_true_space> color({ 300.f, -5.f, 128.f }, 400.f, srgb);
+	EXPECT_EQ(255.f, color[0]);
+	EXPECT_EQ(0.f, color[1]);
+	EXPECT_EQ(128.f, color.get_component(2));
+	EXPECT_EQ(255.f, color.alpha());
+	color.set_component(1000.f, 0);
+	EXPECT_EQ(255.f, color[0]);
+	EXPECT_THROW(color.get_component(3), std::out_of_range*);
+}
+
+TEST_F(BasicColor_Test, Interop_Tests)
+{
+	auto dynamic_color = new lab(53.2f, 80.1f, 67.2f, 0.25f, srgb);
+	basic_color<lab_space> color(dynamic_color);
+	EXPECT_FLOAT_EQ(53.2f, color[0]);
+	EXPECT_FLOAT_EQ(80.1f, color[1]);
+	EXPECT_FLOAT_EQ(67.2f, color[2]);
+	EXPECT_FLOAT_EQ(0.25f, color.alpha());
+	EXPECT_EQ(srgb, color.get_rgb_color_space());
+
+	auto copy = color.to_dynamic();
+	EXPECT_TRUE(*dynamic_color == *copy);
+	EXPECT_FLOAT_EQ(0.25f, copy->alpha());
+
+	EXPECT_THROW(basic_color<xyz_space> wrong(dynamic_color), std::invalid_argument*);
+
+	// True color alpha keeps the range of the dynamic class
+	auto true_color = new rgb_truecolor(10.f, 20.f, 30.f, 128.f, srgb);
+	basic_color<rgb_true_space> from_true(true_color);
+	EXPECT_FLOAT_EQ(128.f, from_true.alpha());
+	auto back = from_true.to_dynamic();
+	EXPECT_FLOAT_EQ(128.f, back->alpha());
+
+	delete back;
+	delete true_color;
+	delete copy;
+	delete dynamic_color;
+}
+
+TEST_F(BasicColor_Test, Convert_Tests)
+{
+	for (int r = 0; r < 256; r += 51)
+	{
+		for (int g = 0; g < 256; g += 85)
+		{
+			for (int b = 0; b < 256; b += 64)
+			{
+				basic_color<rgb_true_space> color({ (float)r, (float)g, (float)b }, 200.f, srgb);
+				expect_all_same_like_converter(color);
+			}
+		}
+	}
+
+	expect_all_same_like_converter(basic_color<lab_space>({ 60.f, -20.f, 35.f }, 0.5f, srgb));
+	expect_all_same_like_converter(basic_color<hsi_space>({ 200.f, 0.4f, 0.6f }, 1.f, srgb));
+	expect_all_same_like_converter(basic_color<cmyk_space>({ 0.1f, 0.5f, 0.3f, 0.2f }, 1.f, srgb));
+	expect_all_same_like_converter(basic_color<grey_true_space>({ 77.f }, 255.f, srgb));
+	expect_all_same_like_converter(basic_color<xyy_space>({ 0.3f, 0.35f, 40.f }, 1.f, srgb));
+}
+
+TEST_F(BasicColor_Test, Double_Tests)
+{
+	basic_color<rgb_deep_space, double> color({ 0.8, 0.3, 0.1 }, 1.0, srgb);
+	auto lab_color = convert<lab_space>(color);
+	auto back = convert<rgb_deep_space>(lab_color);
+	for (size_t i = 0; i < 3; ++i) EXPECT_NEAR(color[i], back[i], 0.001);
+
+	// Converting to the same space is a copy
+	EXPECT_TRUE(color == convert<rgb_deep_space>(color));
+}
+
+TEST_F(BasicColor_Test, Half_Tests)
+{
+	basic_color<rgb_true_space, half> color({ half(200.f), half(30.f), half(90.f) }, half(255.f), srgb);
+	basic_color<rgb_true_space> reference({ 200.f, 30.f, 90.f }, 255.f, srgb);
+	auto result = convert<lab_space>(color);
+	auto expected = convert<lab_space>(reference);
+
+	// Calculated in float, only the result is rounded
+	for (size_t i = 0; i < 3; ++i) EXPECT_EQ(half(expected[i]), result[i]);
+	EXPECT_EQ(1.f, (float)result.alpha());
+	EXPECT_EQ(100.f, (basic_color<lab_space, half>::component_max(0)));
+}
@@ -1,9 +1,9 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\spaces\rgb_truecolor.h"
-#include "..\ColorMagic\manipulation\chromatic_adaptation.h"
-#include "..\ColorMagic\manipulation\color_converter.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/rgb_truecolor.h"
+#include "../ColorMagic/manipulation/chromatic_adaptation.h"
+#include "../ColorMagic/manipulation/color_converter.h"
 
 using namespace color_space;
 using namespace color_manipulation;
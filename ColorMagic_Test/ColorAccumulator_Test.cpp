@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/color_accumulator.h"
+#include "../ColorMagic/manipulation/color_calculation.h"
+#include "../ColorMagic/spaces/cmyk.h"
+#include "../ColorMagic/spaces/hsv.h"
+#include "../ColorMagic/spaces/lab.h"
+#include "../ColorMagic/spaces/lch_ab.h"
+
+#include <vector>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+class ColorAccumulator_Test : public ::testing::Test {
+protected:
+	rgb_color_space_definition* srgb;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(ColorAccumulator_Test, Mean_Tests)
+{
+	// Non-hue channels give the same means like the average functions
+	auto colors = std::vector<lab*>();
+	colors.push_back(new lab(53.2f, 80.1f, 67.2f, 1.f, srgb));
+	colors.push_back(new lab(32.3f, 79.2f, -107.9f, 0.5f, srgb));
+	colors.push_back(new lab(87.7f, -86.2f, 83.2f, 0.25f, srgb));
+	colors.push_back(new lab(60.3f, 98.3f, -60.8f, 1.f, srgb));
+
+	for (auto include_alpha : { false, true })
+	{
+		color_accumulator accumulator(LAB, include_alpha);
+		accumulator.push(colors);
+		auto avg = color_calculation::average_lab(colors, include_alpha);
+		auto mean = static_cast<lab*>(accumulator.mean_color());
+		EXPECT_EQ(4u, accumulator.count());
+		EXPECT_NEAR(avg->luminance(), mean->luminance(), 1e-4f);
+		EXPECT_NEAR(avg->a(), mean->a(), 1e-4f);
+		EXPECT_NEAR(avg->b(), mean->b(), 1e-4f);
+		EXPECT_NEAR(avg->alpha(), mean->alpha(), 1e-6f);
+		delete avg;
+		delete mean;
+	}
+	for (auto color : colors) delete color;
+
+	// Five channels, alpha is averaged
+	color_accumulator cmyk_accumulator(CMYK, true);
+	cmyk first(1.f, 0.f, 0.5f, 0.f, 1.f, srgb);
+	cmyk second(0.f, 0.5f, 1.f, 0.f, 0.5f, srgb);
+	cmyk_accumulator.push(&first);
+	cmyk_accumulator.push(&second);
+	float record[5];
+	cmyk_accumulator.mean_record(record);
+	EXPECT_FLOAT_EQ(0.5f, record[0]);
+	EXPECT_FLOAT_EQ(0.25f, record[1]);
+	EXPECT_FLOAT_EQ(0.75f, record[2]);
+	EXPECT_FLOAT_EQ(0.f, record[3]);
+	EXPECT_FLOAT_EQ(0.75f, record[4]);
+	EXPECT_FLOAT_EQ(0.0625f, cmyk_accumulator.variance(1));
+}
+
+TEST_F(ColorAccumulator_Test, Hue_Tests)
+{
+	color_accumulator accumulator(HSV);
+	EXPECT_TRUE(accumulator.is_hue_channel(0));
+	EXPECT_FALSE(accumulator.is_hue_channel(1));
+	hsv first(350.f, 1.f, 0.5f, 1.f, srgb);
+	hsv second(10.f, 0.5f, 1.f, 1.f, srgb);
+	accumulator.push(&first);
+	accumulator.push(&second);
+	EXPECT_NEAR(0.f, accumulator.mean(0), 1e-4f);
+	EXPECT_FLOAT_EQ(0.75f, accumulator.mean(1));
+	EXPECT_FLOAT_EQ(0.0625f, accumulator.variance(1));
+
+	// Same hues give no spread, opposite hues cancel each other out
+	color_accumulator lch_accumulator(LCH_AB);
+	EXPECT_TRUE(lch_accumulator.is_hue_channel(2));
+	float records[8] = { 50.f, 20.f, 90.f, 1.f, 50.f, 20.f, 270.f, 1.f };
+	lch_accumulator.push(records, 1);
+	EXPECT_NEAR(90.f, lch_accumulator.mean(2), 1e-4f);
+	EXPECT_NEAR(0.f, lch_accumulator.variance(2), 1e-6f);
+	lch_accumulator.push(records + 4, 1);
+	EXPECT_EQ(0.f, lch_accumulator.mean(2));
+	EXPECT_NEAR(1.f, lch_accumulator.variance(2), 1e-6f);
+
+	lch_accumulator.reset();
+	float more_records[8] = { 50.f, 20.f, 300.f, 1.f, 50.f, 20.f, 330.f, 1.f };
+	lch_accumulator.push(more_records, 2);
+	EXPECT_NEAR(315.f, lch_accumulator.mean(2), 1e-3f);
+	EXPECT_EQ(2u, lch_accumulator.count());
+}
+
+TEST_F(ColorAccumulator_Test, Merge_Tests)
+{
+	std::vector<float> records;
+	for (int i = 0; i < 1000; ++i)
+	{
+		records.push_back(i * 0.37f);
+		records.push_back((i % 17) * 0.05f);
+		records.push_back(i % 2 == 0 ? 5.f : 355.f);
+		records.push_back(i * 0.001f);
+	}
+
+	color_accumulator all(LCH_AB, true), first(LCH_AB, true), second(LCH_AB, true), empty(LCH_AB, true);
+	all.push(records.data(), 1000);
+	first.push(records.data(), 300);
+	second.push(records.data() + 300 * 4, 700);
+	first.merge(second);
+	first.merge(empty);
+	empty.merge(first);
+
+	for (auto merged : { &first, &empty })
+	{
+		EXPECT_EQ(all.count(), merged->count());
+		for (size_t i = 0; i < 4; ++i)
+		{
+			EXPECT_NEAR(all.mean(i), merged->mean(i), 1e-4f);
+			EXPECT_NEAR(all.variance(i), merged->variance(i), 1e-3f);
+		}
+	}
+	EXPECT_NEAR(0.f, first.mean(2) > 180.f ? first.mean(2) - 360.f : first.mean(2), 1e-3f);
+
+	color_accumulator other_type(LAB, true), other_alpha(LCH_AB, false);
+	EXPECT_THROW(first.merge(other_type), std::invalid_argument*);
+	EXPECT_THROW(first.merge(other_alpha), std::invalid_argument*);
+}
+
+TEST_F(ColorAccumulator_Test, Stability_Tests)
+{
+	// A float sum of ten million values stops growing long before the end, the running mean does not drift
+	color_accumulator accumulator(GREY_DEEP, true);
+	float records[2] = { 0.1f, 0.7f };
+	for (int i = 0; i < 10000000; ++i) accumulator.push(records, 1);
+	EXPECT_EQ(10000000u, accumulator.count());
+	EXPECT_FLOAT_EQ(0.1f, accumulator.mean(0));
+	EXPECT_FLOAT_EQ(0.7f, accumulator.mean(1));
+	EXPECT_NEAR(0.f, accumulator.variance(0), 1e-12f);
+
+	// A large offset does not hide a small spread
+	color_accumulator offset(GREY_DEEP, true);
+	float shifted[4] = { 1e6f + 1.f, 1.f, 1e6f - 1.f, 1.f };
+	for (int i = 0; i < 1000; ++i) offset.push(shifted, 2);
+	EXPECT_FLOAT_EQ(1e6f, offset.mean(0));
+	EXPECT_FLOAT_EQ(1.f, offset.variance(0));
+}
+
+TEST_F(ColorAccumulator_Test, Exception_Tests)
+{
+	EXPECT_THROW(color_accumulator accumulator(UNDEFINED), std::invalid_argument*);
+
+	color_accumulator accumulator(LAB);
+	float record[4];
+	EXPECT_THROW(accumulator.mean_record(record), std::invalid_argument*);
+	EXPECT_THROW(accumulator.mean_color(), std::invalid_argument*);
+	EXPECT_THROW(accumulator.push(static_cast<color_base*>(nullptr)), std::invalid_argument*);
+	hsv wrong_type(0.f, 0.f, 0.f, 1.f, srgb);
+	EXPECT_THROW(accumulator.push(&wrong_type), std::invalid_argument*);
+	EXPECT_THROW(accumulator.push(nullptr, 1), std::invalid_argument*);
+	EXPECT_THROW(accumulator.mean(4), std::out_of_range*);
+	EXPECT_EQ(0.f, accumulator.variance(0));
+
+	// Records need no rgb color space definition, the mean color does
+	float lab_record[4] = { 50.f, 0.f, 0.f, 1.f };
+	accumulator.push(lab_record, 1);
+	EXPECT_THROW(accumulator.mean_color(), std::invalid_argument*);
+	accumulator.mean_record(record);
+	EXPECT_EQ(50.f, record[0]);
+}
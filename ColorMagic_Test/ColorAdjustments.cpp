@@ -1,8 +1,8 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\spaces\rgb_truecolor.h"
-#include "..\ColorMagic\manipulation\color_adjustments.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/rgb_truecolor.h"
+#include "../ColorMagic/manipulation/color_adjustments.h"
 
 using namespace color_space;
 
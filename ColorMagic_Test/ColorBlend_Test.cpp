@@ -1,7 +1,7 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\rgb_deepcolor.h"
-#include "..\ColorMagic\manipulation\color_blend.h"
+#include "../ColorMagic/spaces/rgb_deepcolor.h"
+#include "../ColorMagic/manipulation/color_blend.h"
 
 using namespace color_space;
 
@@ -665,4 +665,39 @@ TEST_F(ColorBlend_Test, LuminosityTests)
 	ASSERT_NEAR(1.f, result->blue(), avg_error);
 	ASSERT_NEAR(1.f, result->alpha(), avg_error);
 	delete result;
-}
\ No newline at end of file
+}
+
+TEST_F(ColorBlend_Test, LinearBlendingTests)
+{
+	auto red_50 = new rgb_deepcolor(1.f, 0.f, 0.f, 0.5f, srgb);
+
+	// Gamma encoded blending mixes the encoded values
+	auto result = color_manipulation::color_converter::to_rgb_deep(color_manipulation::color_blend::normal(red_50, blue_100));
+	ASSERT_NEAR(0.5f, result->red(), avg_error);
+	ASSERT_NEAR(0.f, result->green(), avg_error);
+	ASSERT_NEAR(0.5f, result->blue(), avg_error);
+	ASSERT_NEAR(1.f, result->alpha(), avg_error);
+	delete result;
+
+	// Linear blending mixes the light intensities and encodes the result again
+	result = color_manipulation::color_converter::to_rgb_deep(color_manipulation::color_blend::normal(red_50, blue_100, true, true, true));
+	ASSERT_NEAR(0.735f, result->red(), avg_error);
+	ASSERT_NEAR(0.f, result->green(), avg_error);
+	ASSERT_NEAR(0.735f, result->blue(), avg_error);
+	ASSERT_NEAR(1.f, result->alpha(), avg_error);
+	delete result;
+
+	result = color_manipulation::color_converter::to_rgb_deep(color_manipulation::color_blend::multiply(red_100, blue_0, true, true, true));
+	ASSERT_NEAR(1.f, result->red(), avg_error);
+	ASSERT_NEAR(0.f, result->green(), avg_error);
+	ASSERT_NEAR(0.f, result->blue(), avg_error);
+	ASSERT_NEAR(1.f, result->alpha(), avg_error);
+	delete result;
+
+	// Inputs stay untouched
+	ASSERT_FLOAT_EQ(1.f, red_50->red());
+	ASSERT_FLOAT_EQ(0.5f, red_50->alpha());
+	ASSERT_FLOAT_EQ(1.f, blue_100->blue());
+
+	delete red_50;
+}
@@ -1,8 +1,8 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\spaces\rgb_truecolor.h"
-#include "..\ColorMagic\manipulation\color_calculation.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/rgb_truecolor.h"
+#include "../ColorMagic/manipulation/color_calculation.h"
 
 using namespace color_space;
 
@@ -665,6 +665,28 @@ TEST_F(ColorCalculator_Test, CMYK_Average)
 	ASSERT_NEAR(0.f, avg->magenta(), avg_error);
 	ASSERT_NEAR(0.7f, avg->yellow(), avg_error);
 	ASSERT_NEAR(0.f, avg->black(), avg_error);
+	delete avg;
+	for (auto color : colors) delete color;
+
+	// Alpha is the fifth value, it must neither replace nor change the black average
+	colors.clear();
+	colors.push_back(new cmyk(1.f, 0.f, 0.f, 0.2f, 1.f, srgb));
+	colors.push_back(new cmyk(0.f, 0.f, 1.f, 0.4f, 0.5f, srgb));
+	colors.push_back(new cmyk(1.f, 0.f, 1.f, 0.6f, 0.25f, srgb));
+	colors.push_back(new cmyk(0.5f, 0.f, 0.5f, 0.8f, 0.75f, srgb));
+
+	avg = color_manipulation::color_calculation::average_cmyk(colors, true);
+	ASSERT_NEAR(0.625f, avg->cyan(), avg_error);
+	ASSERT_NEAR(0.625f, avg->yellow(), avg_error);
+	ASSERT_NEAR(0.5f, avg->black(), avg_error);
+	ASSERT_NEAR(0.625f, avg->alpha(), avg_error);
+	delete avg;
+
+	avg = color_manipulation::color_calculation::average_cmyk(colors, false);
+	ASSERT_NEAR(0.5f, avg->black(), avg_error);
+	ASSERT_NEAR(1.f, avg->alpha(), avg_error);
+	delete avg;
+	for (auto color : colors) delete color;
 }
 
 TEST_F(ColorCalculator_Test, HSI_Average)
@@ -1,20 +1,22 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\spaces\cmyk.h"
-#include "..\ColorMagic\spaces\grey_deepcolor.h"
-#include "..\ColorMagic\spaces\grey_truecolor.h"
-#include "..\ColorMagic\spaces\hsl.h"
-#include "..\ColorMagic\spaces\hsv.h"
-#include "..\ColorMagic\spaces\lab.h"
-#include "..\ColorMagic\spaces\rgb_deepcolor.h"
-#include "..\ColorMagic\spaces\rgb_truecolor.h"
-#include "..\ColorMagic\spaces\xyz.h"
-#include "..\ColorMagic\spaces\xyy.h"
-#include "..\ColorMagic\spaces\lch_uv.h"
-#include "..\ColorMagic\spaces\lch_ab.h"
-#include "..\ColorMagic\spaces\cieluv.h"
-#include "..\ColorMagic\manipulation\color_converter.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/cmyk.h"
+#include "../ColorMagic/spaces/grey_deepcolor.h"
+#include "../ColorMagic/spaces/grey_truecolor.h"
+#include "../ColorMagic/spaces/hsl.h"
+#include "../ColorMagic/spaces/hsv.h"
+#include "../ColorMagic/spaces/lab.h"
+#include "../ColorMagic/spaces/rgb_deepcolor.h"
+#include "../ColorMagic/spaces/rgb_truecolor.h"
+#include "../ColorMagic/spaces/xyz.h"
+#include "../ColorMagic/spaces/xyy.h"
+#include "../ColorMagic/spaces/lch_uv.h"
+#include "../ColorMagic/spaces/lch_ab.h"
+#include "../ColorMagic/spaces/cieluv.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+
+#include <thread>
 
 using namespace color_space;
 
@@ -550,4 +552,100 @@ TEST_F(ColorConverter_Test, To_LAB)
 	EXPECT_NEAR(lab_yellow->luminance(), color_manipulation::color_converter::to_lab(lab_yellow)->luminance(), avg_error);
 	EXPECT_NEAR(lab_yellow->a(), color_manipulation::color_converter::to_lab(lab_yellow)->a(), avg_error);
 	EXPECT_NEAR(lab_yellow->b(), color_manipulation::color_converter::to_lab(lab_yellow)->b(), avg_error);
-}
\ No newline at end of file
+}
+
+TEST_F(ColorConverter_Test, Input_Not_Modified)
+{
+	const rgb_deepcolor* const_rgb_d = new rgb_deepcolor(0.5f, 0.25f, 0.75f, 1.f, srgb);
+
+	auto result_lab = color_manipulation::color_converter::to_lab(const_rgb_d);
+	EXPECT_FLOAT_EQ(0.5f, const_rgb_d->red());
+	EXPECT_FLOAT_EQ(0.25f, const_rgb_d->green());
+	EXPECT_FLOAT_EQ(0.75f, const_rgb_d->blue());
+
+	// A second conversion of the same color has to give the same result
+	auto second_lab = color_manipulation::color_converter::to_lab(const_rgb_d);
+	EXPECT_FLOAT_EQ(result_lab->luminance(), second_lab->luminance());
+	EXPECT_FLOAT_EQ(result_lab->a(), second_lab->a());
+	EXPECT_FLOAT_EQ(result_lab->b(), second_lab->b());
+
+	// Converting to the same color space returns a copy
+	auto same_space = color_manipulation::color_converter::to_rgb_deep(const_rgb_d);
+	EXPECT_NE(const_rgb_d, same_space);
+	same_space->red(0.f);
+	EXPECT_FLOAT_EQ(0.5f, const_rgb_d->red());
+
+	delete result_lab;
+	delete second_lab;
+	delete same_space;
+	delete const_rgb_d;
+}
+
+TEST_F(ColorConverter_Test, Concurrent_Conversion)
+{
+	auto expected = color_manipulation::color_converter::to_lab(rgb_d_yellow);
+
+	std::vector<std::thread> threads;
+	std::vector<int> mismatches(4, 0);
+	for (size_t t = 0; t < mismatches.size(); ++t)
+	{
+		threads.push_back(std::thread([this, expected, &mismatches, t]()
+		{
+			for (int i = 0; i < 200; ++i)
+			{
+				auto result = color_manipulation::color_converter::to_lab(rgb_d_yellow);
+				if (result->luminance() != expected->luminance() || result->a() != expected->a() || result->b() != expected->b()) mismatches[t]++;
+				delete result;
+			}
+		}));
+	}
+	for (auto& thread : threads) thread.join();
+
+	for (int count : mismatches) EXPECT_EQ(0, count);
+	EXPECT_FLOAT_EQ(1.f, rgb_d_yellow->red());
+	EXPECT_FLOAT_EQ(1.f, rgb_d_yellow->green());
+	EXPECT_FLOAT_EQ(0.f, rgb_d_yellow->blue());
+	delete expected;
+}
+
+TEST_F(ColorConverter_Test, Dispatch_Table)
+{
+	std::vector<color_base*> inputs;
+	for (size_t type = 0; type < color_manipulation::color_converter::color_type_count; ++type)
+	{
+		inputs.push_back(color_manipulation::color_converter::convertTo(rgb_d_yellow, (color_type)type));
+		ASSERT_NE(nullptr, inputs.back());
+		EXPECT_EQ((color_type)type, inputs.back()->get_color_type());
+	}
+
+	// Every pair of color types has a converter function and returns the desired type
+	for (size_t from = 0; from < color_manipulation::color_converter::color_type_count; ++from)
+	{
+		for (size_t to = 0; to < color_manipulation::color_converter::color_type_count; ++to)
+		{
+			auto function = color_manipulation::color_converter::get_conversion_function((color_type)from, (color_type)to);
+			ASSERT_NE(nullptr, function);
+			auto result = function(inputs[from]);
+			EXPECT_EQ((color_type)to, result->get_color_type());
+			delete result;
+		}
+	}
+	EXPECT_EQ(nullptr, color_manipulation::color_converter::get_conversion_function(color_type::UNDEFINED, color_type::LAB));
+	EXPECT_EQ(nullptr, color_manipulation::color_converter::get_conversion_function(color_type::LAB, color_type::UNDEFINED));
+	EXPECT_EQ(nullptr, color_manipulation::color_converter::convertTo(rgb_d_yellow, color_type::UNDEFINED));
+
+	// The batch conversion handles mixed input types
+	auto batch = color_manipulation::color_converter::convertTo(inputs, color_type::LCH_AB, nullptr);
+	ASSERT_EQ(inputs.size(), batch.size());
+	auto expected = color_manipulation::color_converter::to_lch_ab(rgb_d_yellow);
+	EXPECT_FLOAT_EQ(expected->luminance(), static_cast<lch_ab*>(batch[color_type::RGB_DEEP])->luminance());
+	EXPECT_FLOAT_EQ(expected->hue(), static_cast<lch_ab*>(batch[color_type::RGB_DEEP])->hue());
+	for (auto result : batch)
+	{
+		EXPECT_EQ(color_type::LCH_AB, result->get_color_type());
+		delete result;
+	}
+
+	delete expected;
+	for (auto input : inputs) delete input;
+}
@@ -1,16 +1,18 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\spaces\cmyk.h"
-#include "..\ColorMagic\spaces\grey_deepcolor.h"
-#include "..\ColorMagic\spaces\grey_truecolor.h"
-#include "..\ColorMagic\spaces\hsl.h"
-#include "..\ColorMagic\spaces\hsv.h"
-#include "..\ColorMagic\spaces\lab.h"
-#include "..\ColorMagic\spaces\rgb_deepcolor.h"
-#include "..\ColorMagic\spaces\rgb_truecolor.h"
-#include "..\ColorMagic\spaces\xyz.h"
-#include "..\ColorMagic\manipulation\color_distance.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/cmyk.h"
+#include "../ColorMagic/spaces/grey_deepcolor.h"
+#include "../ColorMagic/spaces/grey_truecolor.h"
+#include "../ColorMagic/spaces/hsl.h"
+#include "../ColorMagic/spaces/hsv.h"
+#include "../ColorMagic/spaces/lab.h"
+#include "../ColorMagic/spaces/rgb_deepcolor.h"
+#include "../ColorMagic/spaces/rgb_truecolor.h"
+#include "../ColorMagic/spaces/xyz.h"
+#include "../ColorMagic/manipulation/color_distance.h"
+
+#include <cmath>
 
 using namespace color_space;
 
@@ -188,36 +190,89 @@ TEST_F(ColorDistance_Test, CIELAB_DeltaE_CIE94)
 TEST_F(ColorDistance_Test, CIELAB_DeltaE_CIE00)
 {
 	// Graphic Art kL = 1, K1 = 0.045, K2 = 0.015 (default)
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, cmyk_red), avg_error);
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(hsv_yellow, hsv_red), avg_error);
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(hsl_yellow, hsl_red), avg_error);
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(xyz_yellow, xyz_red), avg_error);
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(lab_yellow, lab_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, cmyk_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(hsv_yellow, hsv_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(hsl_yellow, hsl_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(xyz_yellow, xyz_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(lab_yellow, lab_red), avg_error);
 	EXPECT_NEAR(32.7f, color_manipulation::color_distance::cielab_delta_e_cie00(grey1_d, grey2_d), avg_error);
 	EXPECT_NEAR(32.7f, color_manipulation::color_distance::cielab_delta_e_cie00(grey1_t, grey2_t), avg_error);
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_d_yellow, rgb_d_red), avg_error);
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_t_yellow, rgb_t_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_d_yellow, rgb_d_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_t_yellow, rgb_t_red), avg_error);
 
-	EXPECT_NEAR(63.6f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, rgb_t_red), avg_error);
+	EXPECT_NEAR(64.3f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, rgb_t_red), avg_error);
 
 	EXPECT_NEAR(0.f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, cmyk_yellow), avg_error);
 
 	// Textiles kL = 2, K1 = 0.048, K2 = 0.014
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, cmyk_red, 2.f, 0.048f, 0.014f), avg_error);
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(hsv_yellow, hsv_red, 2.f, 0.048f, 0.014f), avg_error);
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(hsl_yellow, hsl_red, 2.f, 0.048f, 0.014f), avg_error);
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(xyz_yellow, xyz_red, 2.f, 0.048f, 0.014f), avg_error);
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(lab_yellow, lab_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, cmyk_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(hsv_yellow, hsv_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(hsl_yellow, hsl_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(xyz_yellow, xyz_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(lab_yellow, lab_red, 2.f, 0.048f, 0.014f), avg_error);
 	EXPECT_NEAR(16.4f, color_manipulation::color_distance::cielab_delta_e_cie00(grey1_d, grey2_d, 2.f, 0.048f, 0.014f), avg_error);
 	EXPECT_NEAR(16.4f, color_manipulation::color_distance::cielab_delta_e_cie00(grey1_t, grey2_t, 2.f, 0.048f, 0.014f), avg_error);
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_d_yellow, rgb_d_red, 2.f, 0.048f, 0.014f), avg_error);
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_t_yellow, rgb_t_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_d_yellow, rgb_d_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(rgb_t_yellow, rgb_t_red, 2.f, 0.048f, 0.014f), avg_error);
 
-	EXPECT_NEAR(59.1f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, rgb_t_red, 2.f, 0.048f, 0.014f), avg_error);
+	EXPECT_NEAR(59.84f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, rgb_t_red, 2.f, 0.048f, 0.014f), avg_error);
 
 	EXPECT_NEAR(0.f, color_manipulation::color_distance::cielab_delta_e_cie00(cmyk_yellow, cmyk_yellow, 2.f, 0.048f, 0.014f), avg_error);
 }
 
+TEST_F(ColorDistance_Test, CIELAB_DeltaE_CIE00_Sharma)
+{
+	// Test data of Sharma, Wu and Dalal (2005), including achromatic colors and hues around 0
+	float pairs[][6] =
+	{
+		{ 50.f, 2.6772f, -79.7751f, 50.f, 0.f, -82.7485f },
+		{ 50.f, 0.f, 0.f, 50.f, -1.f, 2.f },
+		{ 50.f, -1.f, 2.f, 50.f, 0.f, 0.f },
+		{ 50.f, 2.5f, 0.f, 73.f, 25.f, -18.f },
+		{ 50.f, 2.5f, 0.f, 50.f, 0.f, -2.5f },
+		{ 50.f, 2.49f, -0.001f, 50.f, -2.49f, 0.0011f },
+		{ 90.8027f, -2.0831f, 1.441f, 91.1528f, -1.6435f, 0.0447f },
+		{ 2.0776f, 0.0795f, -1.135f, 0.9033f, -0.0636f, -0.5514f }
+	};
+	float expected[] = { 2.0425f, 2.3669f, 2.3669f, 27.1492f, 4.3065f, 7.2195f, 1.4441f, 0.9082f };
+	for (int i = 0; i < 8; ++i)
+	{
+		lab first(pairs[i][0], pairs[i][1], pairs[i][2], 1.f, srgb);
+		lab second(pairs[i][3], pairs[i][4], pairs[i][5], 1.f, srgb);
+		EXPECT_NEAR(expected[i], color_manipulation::color_distance::cielab_delta_e_cie00(&first, &second), 1e-3f);
+		EXPECT_NEAR(expected[i], color_manipulation::color_distance::cielab_delta_e_cie00(&second, &first), 1e-3f);
+
+		// Nearly equal colors must not produce not a number
+		lab copy(pairs[i][0], pairs[i][1], std::nextafter(pairs[i][2], 0.f), 1.f, srgb);
+		EXPECT_NEAR(0.f, color_manipulation::color_distance::cielab_delta_e_cie00(&first, &copy), 1e-3f);
+		EXPECT_NEAR(0.f, color_manipulation::color_distance::cmc_delta_e_lc84(&first, &copy), 1e-3f);
+	}
+}
+
+TEST_F(ColorDistance_Test, CIELAB_DeltaE_CIE00_Double)
+{
+	// Test data of Sharma, Wu and Dalal (2005), the published distances are rounded to 4 decimals
+	double pairs[][6] =
+	{
+		{ 50., 2.6772, -79.7751, 50., 0., -82.7485 },
+		{ 50., 0., 0., 50., -1., 2. },
+		{ 50., 2.5, 0., 73., 25., -18. },
+		{ 50., 2.5, 0., 50., 0., -2.5 },
+		{ 50., 2.49, -0.001, 50., -2.49, 0.0011 },
+		{ 60.2574, -34.0099, 36.2677, 60.4626, -34.1751, 39.4387 },
+		{ 22.7233, 20.0904, -46.694, 23.0331, 14.973, -42.5619 },
+		{ 90.8027, -2.0831, 1.441, 91.1528, -1.6435, 0.0447 },
+		{ 2.0776, 0.0795, -1.135, 0.9033, -0.0636, -0.5514 }
+	};
+	double expected[] = { 2.0425, 2.3669, 27.1492, 4.3065, 7.2195, 1.2644, 2.0373, 1.4441, 0.9082 };
+	for (int i = 0; i < 9; ++i)
+	{
+		EXPECT_NEAR(expected[i], color_manipulation::color_distance::cielab_delta_e_cie00(pairs[i], pairs[i] + 3), 5e-5);
+		EXPECT_NEAR(expected[i], color_manipulation::color_distance::cielab_delta_e_cie00(pairs[i] + 3, pairs[i]), 5e-5);
+		EXPECT_EQ(0., color_manipulation::color_distance::cielab_delta_e_cie00(pairs[i], pairs[i]));
+	}
+}
+
 TEST_F(ColorDistance_Test, CMC_DeltaE_LC84)
 {
 	// Lightness = 2 (default)
@@ -0,0 +1,204 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/color_histogram.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+class ColorHistogram_Test : public ::testing::Test {
+protected:
+	rgb_color_space_definition* srgb;
+	std::vector<uint8_t> pixels;
+	std::vector<float> records;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+
+		// 300000 rgba pixels, the colors are drawn from 4096 values so that many of them repeat
+		uint32_t state = 4711;
+		for (int i = 0; i < 300000; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			uint32_t color = (state >> 20) * 4099u;
+			pixels.push_back((uint8_t)(color >> 16));
+			pixels.push_back((uint8_t)(color >> 8));
+			pixels.push_back((uint8_t)color);
+			pixels.push_back(255);
+			for (size_t c = 0; c < 4; ++c) records.push_back(pixels[pixels.size() - 4 + c]);
+		}
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(ColorHistogram_Test, Bin_Tests)
+{
+	uint8_t data[16] = { 0, 0, 0, 255, 7, 7, 7, 255, 8, 0, 255, 255, 255, 255, 255, 255 };
+	auto histogram = color_histogram::compute(pixel_view(data, RGBA32, 4), 32);
+	EXPECT_EQ(4u, histogram.total());
+	EXPECT_EQ(3u, histogram.occupied());
+	EXPECT_EQ(2u, histogram.count(0, 0, 0));
+	EXPECT_EQ(1u, histogram.count(1, 0, 31));
+	EXPECT_EQ(1u, histogram.count(31, 31, 31));
+
+	auto top = histogram.top(2);
+	ASSERT_EQ(2u, top.size());
+	EXPECT_EQ(2u, top[0].count);
+	EXPECT_EQ(4.f, top[0].components[0]);
+	EXPECT_EQ(12.f, top[1].components[0]);
+	EXPECT_EQ(252.f, top[1].components[2]);
+	EXPECT_EQ(3u, histogram.top(10).size());
+
+	// Lab axes, values outside the axes go to the outer bins
+	color_histogram lab(LAB, 4);
+	float lab_records[12] = { 0.f, -128.f, 127.f, 1.f, 100.f, 0.f, -300.f, 1.f, 60.f, 10.f, 10.f, 1.f };
+	lab.add(lab_records, 3);
+	EXPECT_EQ(1u, lab.count(0, 0, 3));
+	EXPECT_EQ(1u, lab.count(3, 2, 0));
+	EXPECT_EQ(1u, lab.count(2, 2, 2));
+	float center[3];
+	lab.cell_center(lab.cell_index(lab_records + 8), center);
+	EXPECT_FLOAT_EQ(62.5f, center[0]);
+	EXPECT_FLOAT_EQ(32.f, center[1]);
+}
+
+TEST_F(ColorHistogram_Test, Buffer_Tests)
+{
+	// The byte lookup tables bin like the records, for any number of threads
+	sequential_executor sequential;
+	thread_pool pool(4);
+	pixel_view view(pixels.data(), RGBA32, 600, 500);
+	for (size_t bins : { 32, 64, 7 })
+	{
+		auto expected = color_histogram::compute(records.data(), 300000, RGB_TRUE, bins, &sequential);
+		EXPECT_EQ(300000u, expected.total());
+		EXPECT_EQ(expected.get_counts(), color_histogram::compute(view, bins, &sequential).get_counts());
+		EXPECT_EQ(expected.get_counts(), color_histogram::compute(view, bins, &pool).get_counts());
+		EXPECT_EQ(expected.get_counts(), color_histogram::compute(records.data(), 300000, RGB_TRUE, bins, &pool).get_counts());
+	}
+
+	// Other layouts give the same histogram
+	std::vector<uint8_t> bgr(300000 * 3), red(300000), green(300000), blue(300000);
+	for (size_t i = 0; i < 300000; ++i)
+	{
+		bgr[i * 3] = pixels[i * 4];
+		bgr[i * 3 + 1] = pixels[i * 4 + 1];
+		bgr[i * 3 + 2] = pixels[i * 4 + 2];
+		red[i] = pixels[i * 4];
+		green[i] = pixels[i * 4 + 1];
+		blue[i] = pixels[i * 4 + 2];
+	}
+	auto expected = color_histogram::compute(view, 16);
+	EXPECT_EQ(expected.get_counts(), color_histogram::compute(pixel_view(bgr.data(), RGB24, 300000), 16).get_counts());
+	EXPECT_EQ(expected.get_counts(), color_histogram::compute(pixel_view(red.data(), green.data(), blue.data(), nullptr, 1000, 300), 16).get_counts());
+
+	// Lab histogram of converted pixels
+	conversion_plan to_lab(RGB_TRUE, srgb, LAB, srgb);
+	std::vector<float> lab_records(records.size());
+	to_lab.apply(records.data(), lab_records.data(), 300000);
+	auto lab = color_histogram::compute(view, to_lab, 32, &pool);
+	EXPECT_EQ(LAB, lab.get_color_type());
+	EXPECT_EQ(color_histogram::compute(lab_records.data(), 300000, LAB, 32).get_counts(), lab.get_counts());
+
+	auto merged = color_histogram::compute(records.data(), 1000, RGB_TRUE, 32);
+	merged.merge(color_histogram::compute(records.data() + 4000, 299000, RGB_TRUE, 32));
+	EXPECT_EQ(color_histogram::compute(view, 32).get_counts(), merged.get_counts());
+	EXPECT_EQ(300000u, merged.total());
+}
+
+// Reports many threads but runs the parts on the calling thread and remembers into how many parts the work was split
+class part_counting_executor : public executor
+{
+public:
+	size_t parts = 1;
+
+	size_t get_thread_count() const override { return 16; }
+
+	void parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t /*grain_size*/ = 0) override
+	{
+		parts = end - begin;
+		for (size_t i = begin; i < end; ++i) body(i, i + 1);
+	}
+};
+
+TEST_F(ColorHistogram_Test, Memory_Tests)
+{
+	// Small grids are counted in one part per 65536 pixels, large grids are not copied for every thread
+	pixel_view view(pixels.data(), RGBA32, 600, 500);
+	sequential_executor sequential;
+	for (size_t bins : { 32, 128, 256 })
+	{
+		part_counting_executor counting;
+		auto histogram = color_histogram::compute(view, bins, &counting);
+		EXPECT_EQ(bins == 256 ? 1u : 4u, counting.parts);
+		EXPECT_EQ(300000u, histogram.total());
+		EXPECT_EQ(color_histogram::compute(view, bins, &sequential).get_counts(), histogram.get_counts());
+	}
+}
+
+TEST_F(ColorHistogram_Test, Unique_Tests)
+{
+	std::map<uint32_t, uint32_t> expected;
+	for (size_t i = 0; i < 300000; ++i) ++expected[((uint32_t)pixels[i * 4] << 16) | ((uint32_t)pixels[i * 4 + 1] << 8) | pixels[i * 4 + 2]];
+
+	thread_pool pool(4);
+	pixel_view view(pixels.data(), RGBA32, 600, 500);
+	for (executor* exec : { (executor*)&pool, (executor*)nullptr })
+	{
+		auto table = unique_color_table::compute(view, exec);
+		EXPECT_EQ(expected.size(), table.size());
+		EXPECT_EQ(300000u, table.total());
+		for (const auto& color : expected) EXPECT_EQ(color.second, table.count(color.first));
+		EXPECT_EQ(0u, table.count(0x123456));
+
+		// The most frequent colors in descending order, ties by value
+		auto top = table.top(5);
+		ASSERT_EQ(5u, top.size());
+		for (size_t i = 1; i < top.size(); ++i) EXPECT_GE(top[i - 1].count, top[i].count);
+		uint32_t first = ((uint32_t)top[0].components[0] << 16) | ((uint32_t)top[0].components[1] << 8) | (uint32_t)top[0].components[2];
+		EXPECT_EQ(expected[first], top[0].count);
+	}
+
+	// Many distinct colors let the table grow, alpha and higher bits are ignored
+	unique_color_table table;
+	for (uint32_t i = 0; i < 200000; ++i) table.add(i * 83 + 0xFF000000);
+	table.add(83, 2);
+	EXPECT_EQ(200000u, table.size());
+	EXPECT_EQ(200002u, table.total());
+	EXPECT_EQ(3u, table.count(83));
+	EXPECT_EQ(1u, table.count(199999 * 83));
+	auto top = table.top(2);
+	EXPECT_EQ(3u, top[0].count);
+	EXPECT_EQ(0.f, top[1].components[2]);
+
+	uint32_t argb[3] = { 0xFF102030, 0x00102030, 0xFF405060 };
+	auto argb_table = unique_color_table::compute(pixel_view(argb, ARGB32, 3));
+	EXPECT_EQ(2u, argb_table.size());
+	EXPECT_EQ(2u, argb_table.count(0x102030));
+}
+
+TEST_F(ColorHistogram_Test, Exception_Tests)
+{
+	EXPECT_THROW(color_histogram(HSV, 32), std::invalid_argument*);
+	EXPECT_THROW(color_histogram(RGB_TRUE, 0), std::invalid_argument*);
+	EXPECT_THROW(color_histogram(RGB_TRUE, 257), std::invalid_argument*);
+	EXPECT_THROW(color_histogram::compute(nullptr, 1, RGB_TRUE), std::invalid_argument*);
+
+	conversion_plan from_lab(LAB, srgb, RGB_TRUE, srgb);
+	EXPECT_THROW(color_histogram::compute(pixel_view(pixels.data(), RGBA32, 10), from_lab), std::invalid_argument*);
+
+	color_histogram histogram(RGB_TRUE, 32);
+	EXPECT_THROW(histogram.count(0, 32, 0), std::out_of_range*);
+	EXPECT_THROW(histogram.merge(color_histogram(RGB_TRUE, 64)), std::invalid_argument*);
+	EXPECT_THROW(histogram.merge(color_histogram(LAB, 32)), std::invalid_argument*);
+	EXPECT_EQ(0u, histogram.top(3).size());
+	EXPECT_EQ(0u, unique_color_table().top(3).size());
+}
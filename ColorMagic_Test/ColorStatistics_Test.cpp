@@ -0,0 +1,200 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/color_statistics.h"
+#include "../ColorMagic/manipulation/color_calculation.h"
+#include "../ColorMagic/spaces/rgb_truecolor.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+class ColorStatistics_Test : public ::testing::Test {
+protected:
+	rgb_color_space_definition* srgb;
+	std::vector<uint8_t> pixels;
+	std::vector<float> records;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+
+		// 100000 pseudo random rgba pixels, more than a few blocks and not a multiple of the block size
+		uint32_t state = 12345;
+		for (int i = 0; i < 100000 * 4; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			pixels.push_back((uint8_t)(state >> 24));
+			records.push_back((float)pixels.back());
+		}
+	}
+
+	virtual void TearDown()
+	{
+	}
+
+	// Covariance of two channels of records in double precision.
+	static double covariance(const std::vector<float>& values, size_t record_size, size_t channel1, size_t channel2)
+	{
+		size_t count = values.size() / record_size;
+		double mean1 = 0.0, mean2 = 0.0, sum = 0.0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			mean1 += values[i * record_size + channel1];
+			mean2 += values[i * record_size + channel2];
+		}
+		mean1 /= count;
+		mean2 /= count;
+		for (size_t i = 0; i < count; ++i) sum += (values[i * record_size + channel1] - mean1) * (values[i * record_size + channel2] - mean2);
+		return sum / count;
+	}
+};
+
+TEST_F(ColorStatistics_Test, Records_Tests)
+{
+	auto statistics = color_statistics::compute(records.data(), 100000, RGB_TRUE, true);
+	EXPECT_EQ(100000u, statistics.count());
+	EXPECT_EQ(4u, statistics.get_channel_count());
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_NEAR(covariance(records, 4, i, i), statistics.variance(i), 1e-2);
+		EXPECT_EQ(0.f, statistics.minimum(i));
+		EXPECT_EQ(255.f, statistics.maximum(i));
+		for (size_t j = 0; j < 4; ++j)
+		{
+			EXPECT_NEAR(covariance(records, 4, i, j), statistics.covariance(i, j), 1e-2);
+			EXPECT_EQ(statistics.covariance(i, j), statistics.covariance(j, i));
+		}
+	}
+
+	// Means and alpha handling like the average functions
+	auto colors = std::vector<rgb_truecolor*>();
+	for (size_t i = 0; i < 1000; ++i) colors.push_back(new rgb_truecolor(records[i * 4], records[i * 4 + 1], records[i * 4 + 2], records[i * 4 + 3] / 255.f, srgb));
+	std::vector<float> first_records(records.begin(), records.begin() + 4000);
+	for (size_t i = 0; i < 1000; ++i) first_records[i * 4 + 3] /= 255.f;
+	for (auto include_alpha : { false, true })
+	{
+		auto avg = color_calculation::average_rgb_true(colors, include_alpha);
+		auto partial = color_statistics::compute(first_records.data(), 1000, RGB_TRUE, include_alpha);
+		EXPECT_NEAR(avg->red(), partial.mean(0), 1e-2f);
+		EXPECT_NEAR(avg->green(), partial.mean(1), 1e-2f);
+		EXPECT_NEAR(avg->blue(), partial.mean(2), 1e-2f);
+		EXPECT_NEAR(avg->alpha(), partial.mean(3), 1e-4f);
+		delete avg;
+	}
+	auto without_alpha = color_statistics::compute(first_records.data(), 1000, RGB_TRUE);
+	EXPECT_EQ(first_records[3], without_alpha.minimum(3));
+	EXPECT_EQ(first_records[3], without_alpha.maximum(3));
+	EXPECT_EQ(0.f, without_alpha.variance(3));
+	EXPECT_EQ(0.f, without_alpha.covariance(0, 3));
+
+	auto mean = static_cast<rgb_truecolor*>(without_alpha.mean_color(srgb));
+	EXPECT_NEAR(without_alpha.mean(0), mean->red(), 0.5f);
+	delete mean;
+
+	// Grey and cmyk records
+	float grey[6] = { 0.2f, 1.f, 0.4f, 0.5f, 0.9f, 0.f };
+	auto grey_statistics = color_statistics::compute(grey, 3, GREY_DEEP, true);
+	EXPECT_FLOAT_EQ(0.5f, grey_statistics.mean(0));
+	EXPECT_FLOAT_EQ(0.5f, grey_statistics.mean(1));
+	EXPECT_FLOAT_EQ(0.2f, grey_statistics.minimum(0));
+	EXPECT_FLOAT_EQ(0.9f, grey_statistics.maximum(0));
+	EXPECT_NEAR(0.0866667f, grey_statistics.variance(0), 1e-6f);
+	EXPECT_NEAR(-0.1166667f, grey_statistics.covariance(0, 1), 1e-6f);
+
+	float cmyk[10] = { 1.f, 0.f, 0.5f, 0.f, 1.f, 0.f, 0.5f, 1.f, 0.f, 0.5f };
+	auto cmyk_statistics = color_statistics::compute(cmyk, 2, CMYK);
+	EXPECT_FLOAT_EQ(0.5f, cmyk_statistics.mean(0));
+	EXPECT_FLOAT_EQ(0.75f, cmyk_statistics.mean(2));
+	EXPECT_FLOAT_EQ(1.f, cmyk_statistics.mean(4));
+	EXPECT_FLOAT_EQ(-0.125f, cmyk_statistics.covariance(0, 1));
+}
+
+TEST_F(ColorStatistics_Test, Determinism_Tests)
+{
+	// The results do not depend on the number of threads
+	sequential_executor sequential;
+	thread_pool two(2), eight(8);
+	auto expected = color_statistics::compute(records.data(), 100000, RGB_TRUE, true, &sequential);
+	for (executor* exec : { (executor*)&two, (executor*)&eight, (executor*)nullptr })
+	{
+		auto statistics = color_statistics::compute(records.data(), 100000, RGB_TRUE, true, exec);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			EXPECT_EQ(expected.mean(i), statistics.mean(i));
+			for (size_t j = 0; j < 4; ++j) EXPECT_EQ(expected.covariance(i, j), statistics.covariance(i, j));
+		}
+	}
+
+	// Merging parts gives the statistics of the whole buffer
+	auto merged = color_statistics::compute(records.data(), 30000, RGB_TRUE, true);
+	merged.merge(color_statistics::compute(records.data() + 30000 * 4, 70000, RGB_TRUE, true));
+	EXPECT_EQ(expected.count(), merged.count());
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_NEAR(expected.mean(i), merged.mean(i), 1e-4f);
+		EXPECT_NEAR(expected.variance(i), merged.variance(i), 1e-2f);
+		EXPECT_EQ(expected.minimum(i), merged.minimum(i));
+	}
+
+	// A large offset does not hide a small spread
+	std::vector<float> offset;
+	for (int i = 0; i < 100000; ++i)
+	{
+		offset.push_back(i % 2 == 0 ? 1e6f + 1.f : 1e6f - 1.f);
+		offset.push_back(1.f);
+	}
+	auto offset_statistics = color_statistics::compute(offset.data(), 100000, GREY_DEEP, true);
+	EXPECT_FLOAT_EQ(1e6f, offset_statistics.mean(0));
+	EXPECT_FLOAT_EQ(1.f, offset_statistics.variance(0));
+}
+
+TEST_F(ColorStatistics_Test, Pixel_Tests)
+{
+	pixel_view view(pixels.data(), RGBA32, 400, 250);
+	auto rgb = color_statistics::compute(view, true);
+	auto expected = color_statistics::compute(records.data(), 100000, RGB_TRUE, true);
+	EXPECT_EQ(RGB_TRUE, rgb.get_color_type());
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_NEAR(expected.mean(i), rgb.mean(i), 1e-3f);
+		EXPECT_NEAR(expected.variance(i), rgb.variance(i), 1e-2f);
+	}
+
+	// Lab statistics of the converted pixels
+	conversion_plan to_lab(RGB_TRUE, srgb, LAB, srgb);
+	std::vector<float> lab_records(records.size());
+	to_lab.apply(records.data(), lab_records.data(), 100000);
+	auto lab = color_statistics::compute(view, false, &to_lab);
+	auto lab_expected = color_statistics::compute(lab_records.data(), 100000, LAB);
+	EXPECT_EQ(LAB, lab.get_color_type());
+	for (size_t i = 0; i < 3; ++i)
+	{
+		EXPECT_NEAR(lab_expected.mean(i), lab.mean(i), 1e-3f);
+		EXPECT_NEAR(lab_expected.minimum(i), lab.minimum(i), 1e-4f);
+		EXPECT_NEAR(lab_expected.maximum(i), lab.maximum(i), 1e-4f);
+		EXPECT_NEAR(lab_expected.covariance(i, 1), lab.covariance(i, 1), 1e-2f);
+	}
+	EXPECT_EQ(lab_records[3], lab.mean(3));
+}
+
+TEST_F(ColorStatistics_Test, Exception_Tests)
+{
+	EXPECT_THROW(color_statistics::compute(nullptr, 1, RGB_TRUE), std::invalid_argument*);
+	EXPECT_THROW(color_statistics::compute(records.data(), 1, UNDEFINED), std::invalid_argument*);
+
+	conversion_plan from_lab(LAB, srgb, RGB_TRUE, srgb);
+	pixel_view view(pixels.data(), RGBA32, 400, 250);
+	EXPECT_THROW(color_statistics::compute(view, false, &from_lab), std::invalid_argument*);
+
+	auto empty = color_statistics::compute(records.data(), 0, RGB_TRUE);
+	EXPECT_EQ(0u, empty.count());
+	EXPECT_EQ(0.f, empty.variance(0));
+	EXPECT_THROW(empty.mean_color(srgb), std::invalid_argument*);
+	EXPECT_THROW(empty.mean(4), std::out_of_range*);
+	EXPECT_THROW(empty.covariance(0, 4), std::out_of_range*);
+	EXPECT_THROW(empty.merge(color_statistics(LAB)), std::invalid_argument*);
+	EXPECT_THROW(empty.merge(color_statistics(RGB_TRUE, true)), std::invalid_argument*);
+}
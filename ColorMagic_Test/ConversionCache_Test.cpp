@@ -0,0 +1,179 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/conversion_cache.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/utils/colors.h"
+
+#include <thread>
+
+using namespace color_space;
+
+class ConversionCache_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	rgb_color_space_definition* srgb;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(ConversionCache_Test, HitMiss_Tests)
+{
+	color_manipulation::conversion_cache cache(64, 4);
+	auto color = new rgb_truecolor(200.f, 30.f, 90.f, 128.f, srgb);
+	auto expected = color_manipulation::color_converter::to_lab(color);
+
+	for (int i = 0; i < 3; ++i)
+	{
+		auto result = cache.convert_as<lab>(color, color_type::LAB);
+		EXPECT_EQ(color_type::LAB, result->get_color_type());
+		EXPECT_FLOAT_EQ(expected->luminance(), result->luminance());
+		EXPECT_FLOAT_EQ(expected->a(), result->a());
+		EXPECT_FLOAT_EQ(expected->b(), result->b());
+		EXPECT_FLOAT_EQ(expected->alpha(), result->alpha());
+		delete result;
+	}
+
+	auto statistics = cache.get_statistics();
+	EXPECT_EQ(1, statistics.misses);
+	EXPECT_EQ(2, statistics.hits);
+	EXPECT_EQ(1, statistics.size);
+	EXPECT_EQ(64, statistics.capacity);
+
+	// Another target type or color space is a different entry
+	delete cache.convert(color, color_type::HSV);
+	auto adobe = new rgb_truecolor(200.f, 30.f, 90.f, 128.f, color_space::rgb_color_space_definition_presets().adobeRGB());
+	delete cache.convert(adobe, color_type::LAB);
+	EXPECT_EQ(3, cache.get_statistics().misses);
+
+	// So is another precision policy
+	auto fast = cache.convert_as<lab>(color, color_type::LAB, FASTEST);
+	auto fast_expected = static_cast<lab*>(color_manipulation::color_converter::convertTo(color, color_type::LAB, FASTEST));
+	EXPECT_EQ(4, cache.get_statistics().misses);
+	EXPECT_FLOAT_EQ(fast_expected->a(), fast->a());
+	delete fast;
+	fast = cache.convert_as<lab>(color, color_type::LAB, FASTEST);
+	EXPECT_EQ(4, cache.get_statistics().misses);
+	EXPECT_FLOAT_EQ(fast_expected->a(), fast->a());
+	delete fast;
+	delete fast_expected;
+
+	cache.clear();
+	cache.reset_statistics();
+	delete cache.convert(color, color_type::LAB);
+	statistics = cache.get_statistics();
+	EXPECT_EQ(1, statistics.misses);
+	EXPECT_EQ(0, statistics.hits);
+
+	// A disabled cache only forwards
+	cache.set_enabled(false);
+	delete cache.convert(color, color_type::LAB);
+	EXPECT_EQ(0, cache.get_statistics().hits);
+
+	delete adobe;
+	delete expected;
+	delete color;
+}
+
+TEST_F(ConversionCache_Test, ChangedDefinition_Tests)
+{
+	color_manipulation::conversion_cache cache(64, 4);
+	auto definition = color_space::rgb_color_space_definition_presets().sRGB();
+	auto color = new rgb_truecolor(200.f, 30.f, 90.f, 255.f, definition);
+	delete cache.convert(color, color_type::LAB);
+
+	// Entries of a definition that changed afterwards are not returned
+	definition->set_gamma_curve(color_space::gamma_presets().gamma2_2());
+	auto expected = color_manipulation::color_converter::to_lab(color);
+	auto result = cache.convert_as<lab>(color, color_type::LAB);
+	EXPECT_EQ(0, cache.get_statistics().hits);
+	EXPECT_FLOAT_EQ(expected->luminance(), result->luminance());
+	EXPECT_FLOAT_EQ(expected->a(), result->a());
+	EXPECT_FLOAT_EQ(expected->b(), result->b());
+	delete result;
+	delete expected;
+	delete color;
+	delete definition;
+
+	// Neither are entries of a deleted definition for a new one, even if it is created at the same address
+	auto replacement = color_space::rgb_color_space_definition_presets().adobeRGB();
+	color = new rgb_truecolor(200.f, 30.f, 90.f, 255.f, replacement);
+	delete cache.convert(color, color_type::LAB);
+	EXPECT_EQ(0, cache.get_statistics().hits);
+	delete color;
+	delete replacement;
+}
+
+TEST_F(ConversionCache_Test, Bounded_Tests)
+{
+	color_manipulation::conversion_cache cache(32, 2);
+	for (int i = 0; i < 200; ++i)
+	{
+		rgb_truecolor color((float)i, 0.f, 0.f, 255.f, srgb);
+		delete cache.convert(&color, color_type::XYZ);
+	}
+
+	auto statistics = cache.get_statistics();
+	EXPECT_EQ(32, statistics.size);
+	EXPECT_EQ(200 - 32, statistics.evictions);
+
+	// Recently used entries survive
+	rgb_truecolor recent(199.f, 0.f, 0.f, 255.f, srgb);
+	delete cache.convert(&recent, color_type::XYZ);
+	EXPECT_EQ(1, cache.get_statistics().hits);
+
+	EXPECT_THROW(color_manipulation::conversion_cache(0), std::invalid_argument*);
+}
+
+TEST_F(ConversionCache_Test, Concurrent_Tests)
+{
+	color_manipulation::conversion_cache cache(256);
+	std::vector<std::thread> threads;
+	std::vector<int> failures(4, 0);
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&, t]()
+		{
+			for (int i = 0; i < 500; ++i)
+			{
+				rgb_truecolor color((float)(i % 50), 100.f, 200.f, 255.f, srgb);
+				auto expected = color_manipulation::color_converter::to_hsl(&color);
+				auto result = cache.convert_as<hsl>(&color, color_type::HSL);
+				if (expected->get_component_vector() != result->get_component_vector()) ++failures[t];
+				delete result;
+				delete expected;
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	for (int failure : failures) EXPECT_EQ(0, failure);
+	auto statistics = cache.get_statistics();
+	EXPECT_EQ(2000, statistics.hits + statistics.misses);
+	EXPECT_GE(statistics.hits, 2000 - 4 * 50);
+}
+
+TEST_F(ConversionCache_Test, PredefinedColor_Tests)
+{
+	color_manipulation::conversion_cache cache;
+	predefined_color tomato(HexcodeColors::Tomato, srgb);
+
+	auto direct = tomato.get_lab();
+	auto cached = tomato.get_lab(&cache);
+	auto cached_again = tomato.get_lab(&cache);
+	EXPECT_NEAR(direct->luminance(), cached_again->luminance(), avg_error);
+	EXPECT_NEAR(direct->a(), cached_again->a(), avg_error);
+	EXPECT_NEAR(direct->b(), cached_again->b(), avg_error);
+	EXPECT_EQ(1, cache.get_statistics().hits);
+
+	delete cached_again;
+	delete cached;
+	delete direct;
+}
@@ -0,0 +1,220 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/conversion_plan.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+using namespace color_space;
+
+class ConversionPlan_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	rgb_color_space_definition* srgb;
+	rgb_color_space_definition* adobe;
+	rgb_color_space_definition* best;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+		adobe = color_space::rgb_color_space_definition_presets().adobeRGB();
+		best = color_space::rgb_color_space_definition_presets().bestRGB();
+	}
+
+	virtual void TearDown()
+	{
+	}
+
+	void expect_components_near(color_base* expected, color_base* result, float tolerance)
+	{
+		ASSERT_EQ(expected->get_color_type(), result->get_color_type());
+		auto expected_components = expected->get_component_vector();
+		auto result_components = result->get_component_vector();
+		for (size_t i = 0; i < expected_components.size(); ++i) EXPECT_NEAR(expected_components[i], result_components[i], tolerance);
+		EXPECT_NEAR(expected->alpha(), result->alpha(), tolerance);
+	}
+};
+
+TEST_F(ConversionPlan_Test, SameSpace_Tests)
+{
+	std::vector<color_type> types{ color_type::RGB_TRUE, color_type::RGB_DEEP, color_type::XYZ, color_type::XYY, color_type::LAB, color_type::LCH_AB };
+	auto source = new rgb_deepcolor(0.8f, 0.4f, 0.2f, 0.5f, srgb);
+
+	for (auto from : types)
+	{
+		auto input = color_manipulation::color_converter::convertTo(source, from);
+		for (auto to : types)
+		{
+			// The LCh conversion of the converter is not invertible, skip the pairs that rely on it
+			if (from == color_type::LCH_AB && to != color_type::LCH_AB) continue;
+
+			auto plan = color_manipulation::conversion_plan::get(from, srgb, to, srgb);
+			auto expected = color_manipulation::color_converter::convertTo(input, to);
+			auto result = plan->apply(input);
+			expect_components_near(expected, result, to == color_type::RGB_TRUE ? 1.f : avg_error);
+			delete result;
+			delete expected;
+		}
+		delete input;
+	}
+	delete source;
+}
+
+TEST_F(ConversionPlan_Test, Collapse_Tests)
+{
+	// rgb -> linear rgb -> xyz -> lab: the rgb matrix and the white point scaling become one step
+	color_manipulation::conversion_plan to_lab(color_type::RGB_DEEP, srgb, color_type::LAB, srgb);
+	ASSERT_EQ(4, to_lab.get_steps().size());
+	EXPECT_EQ(color_manipulation::DECODE_GAMMA, to_lab.get_steps()[0].type);
+	EXPECT_EQ(color_manipulation::AFFINE, to_lab.get_steps()[1].type);
+	EXPECT_EQ(color_manipulation::LAB_COMPAND, to_lab.get_steps()[2].type);
+	EXPECT_EQ(color_manipulation::AFFINE, to_lab.get_steps()[3].type);
+
+	// rgb -> xyz -> adapted xyz -> rgb of another space: decode, one matrix, encode
+	color_manipulation::conversion_plan to_best(color_type::RGB_DEEP, srgb, color_type::RGB_DEEP, best);
+	ASSERT_EQ(3, to_best.get_steps().size());
+	EXPECT_EQ(color_manipulation::AFFINE, to_best.get_steps()[1].type);
+
+	// Plans are reused
+	auto first = color_manipulation::conversion_plan::get(color_type::RGB_TRUE, srgb, color_type::LAB, adobe);
+	auto second = color_manipulation::conversion_plan::get(color_type::RGB_TRUE, srgb, color_type::LAB, adobe);
+	EXPECT_EQ(first.get(), second.get());
+	color_manipulation::conversion_plan::clear_cache();
+	auto third = color_manipulation::conversion_plan::get(color_type::RGB_TRUE, srgb, color_type::LAB, adobe);
+	EXPECT_NE(first.get(), third.get());
+
+	EXPECT_THROW(color_manipulation::conversion_plan(color_type::HSV, srgb, color_type::LAB, srgb), std::invalid_argument*);
+	EXPECT_FALSE(color_manipulation::conversion_plan::is_supported(color_type::CMYK));
+}
+
+TEST_F(ConversionPlan_Test, ChangedDefinition_Tests)
+{
+	auto definition = color_space::rgb_color_space_definition_presets().sRGB();
+	auto first = color_manipulation::conversion_plan::get(color_type::RGB_DEEP, definition, color_type::LAB, definition);
+	EXPECT_EQ(first.get(), color_manipulation::conversion_plan::get(color_type::RGB_DEEP, definition, color_type::LAB, definition).get());
+
+	// A changed definition gets a new plan and the plan of the old generation leaves the cache
+	definition->set_gamma_curve(color_space::gamma_presets().gamma2_2());
+	auto second = color_manipulation::conversion_plan::get(color_type::RGB_DEEP, definition, color_type::LAB, definition);
+	EXPECT_NE(first.get(), second.get());
+	EXPECT_EQ(1, first.use_count());
+
+	float record[4] = { 0.8f, 0.4f, 0.2f, 1.f };
+	float expected[4], result[4];
+	color_manipulation::conversion_plan(color_type::RGB_DEEP, definition, color_type::LAB, definition).apply(record, expected, 1);
+	second->apply(record, result, 1);
+	for (size_t c = 0; c < 4; ++c) EXPECT_EQ(expected[c], result[c]);
+	first.reset();
+	second.reset();
+	delete definition;
+
+	// A new definition at the same address does not get the plan of the deleted one
+	auto replacement = color_space::rgb_color_space_definition_presets().adobeRGB();
+	auto third = color_manipulation::conversion_plan::get(color_type::RGB_DEEP, replacement, color_type::LAB, replacement);
+	color_manipulation::conversion_plan(color_type::RGB_DEEP, replacement, color_type::LAB, replacement).apply(record, expected, 1);
+	third->apply(record, result, 1);
+	for (size_t c = 0; c < 4; ++c) EXPECT_EQ(expected[c], result[c]);
+	third.reset();
+	delete replacement;
+}
+
+TEST_F(ConversionPlan_Test, CrossSpace_Tests)
+{
+	auto color = new rgb_deepcolor(0.3f, 0.6f, 0.4f, 1.f, srgb);
+	auto xyz_color = color_manipulation::color_converter::to_xyz(color);
+
+	// Same white point: xyz values stay the same
+	auto adobe_xyz = new color_space::xyz(xyz_color->x(), xyz_color->y(), xyz_color->z(), 1.f, adobe);
+	color_base* expected = color_manipulation::color_converter::to_rgb_deep(adobe_xyz);
+	color_base* result = color_manipulation::conversion_plan(color_type::RGB_DEEP, srgb, color_type::RGB_DEEP, adobe).apply(color);
+	expect_components_near(expected, result, 0.001f);
+	EXPECT_EQ(adobe, result->get_rgb_color_space());
+	delete result;
+	delete expected;
+
+	// Different white points: xyz values are adapted with the chosen method
+	auto adapted = color_manipulation::chromatic_adaptation::get_adaptation_matrix(srgb->get_white_point(), best->get_white_point(), color_manipulation::BRADFORD) * xyz_color->get_component_vector();
+	auto best_xyz = new color_space::xyz(adapted[0], adapted[1], adapted[2], 1.f, best);
+	expected = color_manipulation::color_converter::to_lab(best_xyz);
+	result = color_manipulation::conversion_plan(color_type::RGB_DEEP, srgb, color_type::LAB, best).apply(color);
+	expect_components_near(expected, result, 0.01f);
+	delete result;
+	delete expected;
+
+	// Converting there and back returns the input
+	color_manipulation::conversion_plan there(color_type::RGB_DEEP, srgb, color_type::RGB_DEEP, best, color_manipulation::CAT02);
+	color_manipulation::conversion_plan back(color_type::RGB_DEEP, best, color_type::RGB_DEEP, srgb, color_manipulation::CAT02);
+	auto intermediate = there.apply(color);
+	result = back.apply(intermediate);
+	expect_components_near(color, result, 0.001f);
+	delete result;
+	delete intermediate;
+
+	delete best_xyz;
+	delete adobe_xyz;
+	delete xyz_color;
+	delete color;
+}
+
+TEST_F(ConversionPlan_Test, Buffer_Tests)
+{
+	thread_pool pool(2);
+	auto plan = color_manipulation::conversion_plan::get(color_type::RGB_TRUE, srgb, color_type::LAB, srgb);
+
+	std::vector<float> records;
+	for (int i = 0; i < 300; ++i)
+	{
+		records.push_back((float)(i % 256));
+		records.push_back((float)((i * 7) % 256));
+		records.push_back((float)((i * 13) % 256));
+		records.push_back(255.f);
+	}
+
+	std::vector<float> output(records.size());
+	plan->apply(records.data(), output.data(), 300, &pool);
+	for (size_t i = 0; i < 300; i += 17)
+	{
+		rgb_truecolor color(records[i * 4], records[i * 4 + 1], records[i * 4 + 2], records[i * 4 + 3], srgb);
+		auto expected = color_manipulation::color_converter::to_lab(&color);
+		EXPECT_NEAR(expected->luminance(), output[i * 4], avg_error);
+		EXPECT_NEAR(expected->a(), output[i * 4 + 1], avg_error);
+		EXPECT_NEAR(expected->b(), output[i * 4 + 2], avg_error);
+		EXPECT_NEAR(1.f, output[i * 4 + 3], avg_error);
+		delete expected;
+	}
+
+	// In place
+	plan->apply(records.data(), records.data(), 300, &pool);
+	EXPECT_EQ(output, records);
+}
+
+TEST_F(ConversionPlan_Test, Precision_Tests)
+{
+	auto plan = color_manipulation::conversion_plan::get(color_type::RGB_DEEP, srgb, color_type::LAB, srgb);
+
+	std::vector<float> records;
+	for (int i = 0; i < 1000; ++i)
+	{
+		records.push_back((i % 10) / 9.f);
+		records.push_back(((i / 10) % 10) / 9.f);
+		records.push_back((i / 100) / 9.f);
+		records.push_back(0.5f);
+	}
+	std::vector<float> expected(records.size());
+	plan->apply(records.data(), expected.data(), 1000);
+
+	// Double records
+	std::vector<double> double_records(records.begin(), records.end());
+	plan->apply(double_records.data(), double_records.data(), 1000);
+	for (size_t i = 0; i < records.size(); ++i) EXPECT_NEAR(expected[i], double_records[i], 0.01);
+
+	// Half records, the output is the float result rounded to half precision
+	std::vector<half> half_records(records.size());
+	half::pack(records.data(), half_records.data(), records.size());
+	std::vector<float> rounded_input(records.size());
+	half::unpack(half_records.data(), rounded_input.data(), records.size());
+	plan->apply(rounded_input.data(), rounded_input.data(), 1000);
+	plan->apply(half_records.data(), half_records.data(), 1000);
+	for (size_t i = 0; i < records.size(); ++i) EXPECT_EQ(half(rounded_input[i]), half_records[i]);
+	for (size_t i = 0; i < records.size(); ++i) EXPECT_NEAR(expected[i], half_records[i], 0.1f);
+}
@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/css_color.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+
+#include <string>
+#include <vector>
+
+using namespace color_space;
+
+class CssColor_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	rgb_color_space_definition* srgb;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+	}
+
+	virtual void TearDown()
+	{
+	}
+
+	void expect_color(const std::string& text, color_type type, std::array<float, 3> components, float alpha, float tolerance = 0.001f)
+	{
+		css_color color;
+		ASSERT_TRUE(css_color_parser::try_parse(text.data(), text.size(), color)) << text;
+		EXPECT_EQ(type, color.type) << text;
+		for (size_t i = 0; i < 3; ++i) EXPECT_NEAR(components[i], color.components[i], tolerance) << text;
+		EXPECT_NEAR(alpha, color.alpha, 0.001f) << text;
+	}
+};
+
+TEST_F(CssColor_Test, Syntax_Tests)
+{
+	expect_color("red", color_type::RGB_DEEP, { 1.f, 0.f, 0.f }, 1.f);
+	expect_color("  DarkSlateGrey ", color_type::RGB_DEEP, { 0x2F / 255.f, 0x4F / 255.f, 0x4F / 255.f }, 1.f);
+	expect_color("transparent", color_type::RGB_DEEP, { 0.f, 0.f, 0.f }, 0.f);
+	expect_color("#0f0", color_type::RGB_DEEP, { 0.f, 1.f, 0.f }, 1.f);
+	expect_color("#FF000080", color_type::RGB_DEEP, { 1.f, 0.f, 0.f }, 128.f / 255.f);
+	expect_color("#f008", color_type::RGB_DEEP, { 1.f, 0.f, 0.f }, 0x88 / 255.f);
+	expect_color("rgb(255 0 0 / 50%)", color_type::RGB_DEEP, { 1.f, 0.f, 0.f }, 0.5f);
+	expect_color("RGBA(255, 128, 0, .25)", color_type::RGB_DEEP, { 1.f, 128.f / 255.f, 0.f }, 0.25f);
+	expect_color("rgb(100% 50% 300 / none)", color_type::RGB_DEEP, { 1.f, 0.5f, 1.f }, 0.f);
+	expect_color("rgb(2.55e2 -10 0)", color_type::RGB_DEEP, { 1.f, 0.f, 0.f }, 1.f);
+	expect_color("hsl(120 100% 50%)", color_type::RGB_DEEP, { 0.f, 1.f, 0.f }, 1.f);
+	expect_color("hsla(120deg, 100%, 25%, 0.5)", color_type::RGB_DEEP, { 0.f, 0.5f, 0.f }, 0.5f);
+	expect_color("hsl(0.5turn 100% 50%)", color_type::RGB_DEEP, { 0.f, 1.f, 1.f }, 1.f);
+	expect_color("hsl(-120 100 50)", color_type::RGB_DEEP, { 0.f, 0.f, 1.f }, 1.f);
+	expect_color("hwb(0 0% 0%)", color_type::RGB_DEEP, { 1.f, 0.f, 0.f }, 1.f);
+	expect_color("hwb(90 60% 60%)", color_type::RGB_DEEP, { 0.5f, 0.5f, 0.5f }, 1.f);
+	expect_color("lab(50% 40 -59.5)", color_type::LAB, { 50.f, 40.f, -59.5f }, 1.f);
+	expect_color("lab(100 100% -50%)", color_type::LAB, { 100.f, 125.f, -62.5f }, 1.f);
+	expect_color("lch(50 50 90deg / 0.3)", color_type::LAB, { 50.f, 0.f, 50.f }, 0.3f);
+	expect_color("lch(70 100% 3.14159265rad)", color_type::LAB, { 70.f, -150.f, 0.f }, 1.f);
+	expect_color("color(display-p3 1 50% 0)", color_type::RGB_DEEP, { 1.f, 0.5f, 0.f }, 1.f);
+
+	css_color color;
+	EXPECT_EQ(css_color_parser::display_p3(), css_color_parser::parse("color(display-p3 1 0 0)").color_space);
+	EXPECT_EQ(css_color_parser::srgb(), css_color_parser::parse("color(srgb 1 0 0)").color_space);
+	EXPECT_EQ(css_color_parser::lab_d50(), css_color_parser::parse("lch(50 0 0)").color_space);
+
+	const char* invalid[] = { "", "  ", "reddish", "red blue", "#12345", "#ggg", "rgb(1 2)", "rgb(1, 2 3)", "rgb (1 2 3)", "rgb(1px 2 3)",
+		"rgb(1 2 3", "rgb(1 2 3) x", "hsl(10% 50% 50%)", "rgb(10deg 0 0)", "color(foo 1 2 3)", "color(srgb 1, 2, 3)", "lab(50 0 0 / 10deg)", "unknown(1 2 3)" };
+	for (auto text : invalid)
+	{
+		EXPECT_FALSE(css_color_parser::try_parse(text, std::string(text).size(), color)) << text;
+	}
+	EXPECT_THROW(css_color_parser::parse("rgb(1 2)"), std::invalid_argument*);
+}
+
+TEST_F(CssColor_Test, NamedColor_Tests)
+{
+	uint32_t argb = 0;
+	EXPECT_TRUE(css_color_parser::find_named_color("rebeccapurple", 13, argb));
+	EXPECT_EQ(0xFF663399, argb);
+	EXPECT_TRUE(css_color_parser::find_named_color("CornflowerBlue", 14, argb));
+	EXPECT_EQ(0xFF6495ED, argb);
+	EXPECT_TRUE(css_color_parser::find_named_color("grey", 4, argb));
+	EXPECT_EQ(0xFF808080, argb);
+	EXPECT_FALSE(css_color_parser::find_named_color("gre", 3, argb));
+	EXPECT_FALSE(css_color_parser::find_named_color("greyy", 5, argb));
+	EXPECT_FALSE(css_color_parser::find_named_color("currentcolor", 12, argb));
+	EXPECT_FALSE(css_color_parser::find_named_color(nullptr, 0, argb));
+
+	// Every name of the enum is found
+	const char* names[] = { "aliceblue", "antiquewhite", "aqua", "darkgoldenrod", "lightgoldenrodyellow", "mediumspringgreen", "navajowhite", "papayawhip", "whitesmoke", "yellowgreen" };
+	for (auto name : names)
+	{
+		EXPECT_TRUE(css_color_parser::find_named_color(name, std::string(name).size(), argb)) << name;
+	}
+}
+
+TEST_F(CssColor_Test, Convert_Tests)
+{
+	const char* values[] = { "rgb(200 30 90)", "#3366cc", "hsl(200 40% 60%)", "tomato" };
+	for (auto value : values)
+	{
+		auto rgb = css_color_parser::parse(value, color_type::RGB_TRUE, srgb);
+		EXPECT_EQ(color_type::RGB_TRUE, rgb.type);
+		EXPECT_EQ(255.f, rgb.alpha);
+
+		// Same results like the color_converter, with and without conversion_plan
+		auto deep = css_color_parser::parse(value, color_type::RGB_DEEP, srgb);
+		rgb_deepcolor reference(deep.components[0], deep.components[1], deep.components[2], 1.f, srgb);
+		color_type types[] = { color_type::LAB, color_type::XYZ, color_type::HSV, color_type::CMYK, color_type::LCH_UV };
+		for (auto type : types)
+		{
+			auto result = css_color_parser::parse(value, type, srgb);
+			auto expected = color_manipulation::color_converter::convertTo(&reference, type);
+			EXPECT_EQ(type, result.type);
+			EXPECT_EQ(srgb, result.color_space);
+			for (size_t i = 0; i < expected->get_component_vector().size(); ++i) EXPECT_NEAR(expected->get_component((int)i), result.components[i], avg_error) << value;
+			delete expected;
+		}
+	}
+
+	// D50 lab white is adapted to the D65 white of sRGB
+	auto white = css_color_parser::parse("lab(100 0 0)", color_type::RGB_TRUE, srgb);
+	for (size_t i = 0; i < 3; ++i) EXPECT_NEAR(255.f, white.components[i], 1.f);
+
+	// Same white point and gamma curve, only the primaries differ
+	auto grey = css_color_parser::parse("color(display-p3 0.5 0.5 0.5)", color_type::RGB_DEEP, srgb);
+	for (size_t i = 0; i < 3; ++i) EXPECT_NEAR(0.5f, grey.components[i], 0.001f);
+
+	// Colors outside the gamut are clamped
+	auto p3_red = css_color_parser::parse("color(display-p3 1 0 0 / 0.5)", color_type::RGB_DEEP, srgb);
+	EXPECT_NEAR(1.f, p3_red.components[0], 1e-5f);
+	EXPECT_EQ(0.f, p3_red.components[1]);
+	EXPECT_EQ(0.5f, p3_red.alpha);
+
+	auto dynamic_color = css_color_parser::parse("hsl(0 100% 50%)", color_type::HSL, srgb).to_color();
+	EXPECT_EQ(color_type::HSL, dynamic_color->get_color_type());
+	EXPECT_NEAR(1.f, dynamic_color->get_component(1), avg_error);
+	delete dynamic_color;
+}
+
+TEST_F(CssColor_Test, List_Tests)
+{
+	std::string stylesheet = "color: red; background: rgb(0, 0, 255), #00ff00\n\n  border-color: hsl(0 0% 50% / 0.5);";
+	std::vector<css_color> colors;
+	EXPECT_EQ(4, css_color_parser::parse_list(stylesheet.data(), stylesheet.size(), color_type::RGB_TRUE, srgb, colors));
+	ASSERT_EQ(4, colors.size());
+	EXPECT_EQ(255.f, colors[0].components[0]);
+	EXPECT_EQ(255.f, colors[1].components[2]);
+	EXPECT_EQ(255.f, colors[2].components[1]);
+	EXPECT_EQ(128.f, colors[3].components[0]);
+	EXPECT_NEAR(127.5f, colors[3].alpha, 0.001f);
+
+	std::string broken = "red, rgb(1 2), blue";
+	colors.clear();
+	EXPECT_THROW(css_color_parser::parse_list(broken.data(), broken.size(), color_type::RGB_DEEP, srgb, colors), std::invalid_argument*);
+	EXPECT_EQ(1, colors.size());
+}
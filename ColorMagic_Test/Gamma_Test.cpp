@@ -1,6 +1,6 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\gamma.h"
+#include "../ColorMagic/spaces/gamma.h"
 
 using namespace color_space;
 
@@ -10,9 +10,9 @@ protected:
 	gamma_part* part2;
 	gamma_part* part3;
 
-	gamma* g1;
-	gamma* g2;
-	gamma* g3;
+	color_space::gamma* g1;
+	color_space::gamma* g2;
+	color_space::gamma* g3;
 
 	virtual void SetUp()
 	{
@@ -24,9 +24,9 @@ protected:
 		parts.push_back(part2);
 		parts.push_back(part3);
 
-		g1 = new gamma();
-		g2 = new gamma(parts, parts);
-		g3 = new gamma(std::vector<gamma_part*> { new gamma_part() }, std::vector<gamma_part*>{ nullptr });
+		g1 = new color_space::gamma();
+		g2 = new color_space::gamma(parts, parts);
+		g3 = new color_space::gamma(std::vector<gamma_part*> { new gamma_part() }, std::vector<gamma_part*>{ nullptr });
 	}
 };
 
@@ -76,4 +76,33 @@ TEST_F(Gamma_Test, GammaCorrection_Tests)
 	EXPECT_EQ(0.5f, g3->inverse_gamma_correction(0.5f));
 	EXPECT_EQ(0.75f, g2->gamma_correction(0.25f));
 	EXPECT_EQ(1.2f, g2->gamma_correction(0.6f));
-}
\ No newline at end of file
+}
+
+TEST_F(Gamma_Test, GammaCompiledTable_Tests)
+{
+	auto srgb = gamma_presets().sRGB();
+	EXPECT_FALSE(srgb->is_compiled());
+
+	// Without a table the exact functions are used
+	EXPECT_EQ(srgb->gamma_correction(0.5f), srgb->table_gamma_correction(0.5f));
+
+	srgb->compile();
+	EXPECT_TRUE(srgb->is_compiled());
+	for (int i = 0; i <= 100; i++)
+	{
+		float value = i / 100.f;
+		EXPECT_NEAR(srgb->gamma_correction(value), srgb->table_gamma_correction(value), 0.001f);
+		EXPECT_NEAR(srgb->inverse_gamma_correction(value), srgb->table_inverse_gamma_correction(value), 0.001f);
+	}
+
+	// Values outside of the valid range are clamped
+	EXPECT_NEAR(1.f, srgb->table_gamma_correction(2.f), 0.001f);
+	EXPECT_NEAR(0.f, srgb->table_inverse_gamma_correction(-1.f), 0.001f);
+
+	// Changing the curve invalidates the table
+	srgb->add_gamma_curve_part(new gamma_part());
+	EXPECT_FALSE(srgb->is_compiled());
+
+	EXPECT_THROW(srgb->compile(1), std::invalid_argument*);
+	delete srgb;
+}
@@ -1,7 +1,7 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\spaces\hcy.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/hcy.h"
 
 using namespace color_space;
 
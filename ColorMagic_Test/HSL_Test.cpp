@@ -1,7 +1,7 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\spaces\hsl.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/spaces/hsl.h"
 
 using namespace color_space;
 
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/half.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+class Half_Test : public ::testing::Test {
+protected:
+	virtual void SetUp()
+	{
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(Half_Test, Conversion_Tests)
+{
+	EXPECT_EQ(0x0000, half(0.f).get_bits());
+	EXPECT_EQ(0x8000, half(-0.f).get_bits());
+	EXPECT_EQ(0x3C00, half(1.f).get_bits());
+	EXPECT_EQ(0xC000, half(-2.f).get_bits());
+	EXPECT_EQ(0x7BFF, half(65504.f).get_bits());
+	EXPECT_EQ(0x7C00, half(65520.f).get_bits());
+	EXPECT_EQ(0x7C00, half(std::numeric_limits<float>::infinity()).get_bits());
+	EXPECT_EQ(0x0001, half(std::ldexp(1.f, -24)).get_bits());
+	EXPECT_EQ(0x0000, half(std::ldexp(1.f, -26)).get_bits());
+	EXPECT_TRUE(std::isnan((float)half(std::numeric_limits<float>::quiet_NaN())));
+
+	// Ties round to even
+	EXPECT_EQ(0x3C00, half(1.f + std::ldexp(1.f, -11)).get_bits());
+	EXPECT_EQ(0x3C02, half(1.f + 3.f * std::ldexp(1.f, -11)).get_bits());
+	EXPECT_EQ(0x0000, half(std::ldexp(1.f, -25)).get_bits());
+	EXPECT_EQ(0x0002, half(3.f * std::ldexp(1.f, -25)).get_bits());
+
+	// Every half survives the round trip through float
+	for (uint32_t bits = 0; bits < 0x10000; ++bits)
+	{
+		if ((bits & 0x7C00) == 0x7C00 && (bits & 0x3FF) != 0) continue;
+		half value = half::from_bits((uint16_t)bits);
+		ASSERT_EQ(bits, half((float)value).get_bits());
+	}
+}
+
+TEST_F(Half_Test, Buffer_Tests)
+{
+	std::vector<float> values;
+	for (int i = 0; i < 1003; ++i) values.push_back(std::sin((float)i) * 300.f);
+
+	std::vector<half> packed(values.size());
+	half::pack(values.data(), packed.data(), values.size());
+	for (size_t i = 0; i < values.size(); ++i) EXPECT_EQ(half(values[i]), packed[i]);
+
+	std::vector<float> unpacked(values.size());
+	half::unpack(packed.data(), unpacked.data(), packed.size());
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		EXPECT_EQ((float)packed[i], unpacked[i]);
+		EXPECT_NEAR(values[i], unpacked[i], std::fabs(values[i]) / 1024.f);
+	}
+}
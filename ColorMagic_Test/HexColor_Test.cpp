@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/hex_color.h"
+#include "../ColorMagic/utils/colors.h"
+
+#include <string>
+#include <vector>
+
+class HexColor_Test : public ::testing::Test {
+protected:
+	virtual void SetUp()
+	{
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(HexColor_Test, Parse_Tests)
+{
+	EXPECT_EQ(0xFFFF0000, hex_color::parse("#FF0000"));
+	EXPECT_EQ(0xFF1A2B3C, hex_color::parse("1a2B3c"));
+	EXPECT_EQ(0x80FF0000, hex_color::parse("#80FF0000"));
+	EXPECT_EQ(0xFFAABBCC, hex_color::parse("#abc"));
+	EXPECT_EQ(0xFF000000, hex_color::parse("000"));
+	EXPECT_EQ((uint32_t)HexcodeColors::Gray | 0xFF000000, hex_color::parse("#808080"));
+
+	// Only the given range is read
+	const char* list = "#123456,#654321";
+	EXPECT_EQ(0xFF654321, hex_color::parse(list + 8, 7));
+
+	uint32_t argb = 42;
+	const char* invalid[] = { "", "#", "#12", "#1234", "#12345", "#1234567", "#123456789", "#GGFF0000", "##123", "12 456", "#12345g" };
+	for (auto code : invalid)
+	{
+		EXPECT_FALSE(hex_color::try_parse(code, std::string(code).size(), argb)) << code;
+	}
+	EXPECT_EQ(42, argb);
+	EXPECT_FALSE(hex_color::try_parse(nullptr, 0, argb));
+	EXPECT_THROW(hex_color::parse("#xyz"), std::invalid_argument*);
+
+	// Every byte value survives the round trip in both cases
+	for (uint32_t value = 0; value < 256; ++value)
+	{
+		uint32_t color = value << 24 | (255 - value) << 16 | value << 8 | (value ^ 0x5A);
+		EXPECT_EQ(color, hex_color::parse(hex_color::to_string(color, true)));
+		EXPECT_EQ(color, hex_color::parse(hex_color::to_string(color, true, false)));
+		EXPECT_EQ(color | 0xFF000000, hex_color::parse(hex_color::to_string(color)));
+	}
+}
+
+TEST_F(HexColor_Test, Format_Tests)
+{
+	EXPECT_EQ("#FF8000", hex_color::to_string(0x12FF8000));
+	EXPECT_EQ("#12FF8000", hex_color::to_string(0x12FF8000, true));
+	EXPECT_EQ("#0aff80", hex_color::to_string(0xFF0AFF80, false, false));
+
+	char buffer[hex_color::max_length] = {};
+	EXPECT_EQ(9, hex_color::format(0xDEADBEEF, buffer, true));
+	EXPECT_EQ("#DEADBEEF", std::string(buffer, 9));
+	EXPECT_EQ(7, hex_color::format(0xDEADBEEF, buffer));
+	EXPECT_EQ("#ADBEEF", std::string(buffer, 7));
+}
+
+TEST_F(HexColor_Test, List_Tests)
+{
+	std::vector<uint32_t> colors;
+	EXPECT_EQ(5, hex_color::parse_list("#FF0000, #00ff00\n#00F;\r\n  80FFFFFF,\t123456\n", colors));
+	EXPECT_EQ((std::vector<uint32_t>{ 0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0x80FFFFFF, 0xFF123456 }), colors);
+	EXPECT_EQ(0, hex_color::parse_list(" ,\n", colors));
+	EXPECT_EQ(5, colors.size());
+
+	std::string text;
+	hex_color::format_list(colors.data(), colors.size(), text);
+	EXPECT_EQ("#FF0000,#00FF00,#0000FF,#FFFFFF,#123456", text);
+
+	std::string with_alpha = "colors: ";
+	hex_color::format_list(colors.data(), 2, with_alpha, '\n', true, false);
+	EXPECT_EQ("colors: #ffff0000\n#ff00ff00", with_alpha);
+
+	std::vector<uint32_t> parsed;
+	hex_color::format_list(colors.data(), colors.size(), text.erase(), ';', true);
+	hex_color::parse_list(text, parsed);
+	EXPECT_EQ(colors, parsed);
+
+	// Colors before an invalid code are kept
+	parsed.clear();
+	EXPECT_THROW(hex_color::parse_list("#FFFFFF,#12345,#000000", parsed), std::invalid_argument*);
+	EXPECT_EQ(1, parsed.size());
+}
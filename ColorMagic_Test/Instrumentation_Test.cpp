@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/instrumentation.h"
+#include "../ColorMagic/manipulation/color_blend.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/manipulation/color_distance.h"
+#include "../ColorMagic/manipulation/porter_duff.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+// Disabled_Tests is compiled without COLOR_MAGIC_INSTRUMENTATION, all other tests with it (the debug configurations)
+class Instrumentation_Test : public ::testing::Test {
+protected:
+	rgb_color_space_definition* srgb;
+	rgb_truecolor* red;
+	rgb_truecolor* blue;
+
+	virtual void SetUp()
+	{
+		srgb = rgb_color_space_definition_presets().sRGB();
+		red = new rgb_truecolor(255.f, 0.f, 0.f, 1.f, srgb);
+		blue = new rgb_truecolor(0.f, 0.f, 255.f, 1.f, srgb);
+		instrumentation::reset();
+	}
+
+	virtual void TearDown()
+	{
+		instrumentation::set_timer_callback(nullptr);
+		delete red;
+		delete blue;
+	}
+};
+
+#ifndef COLOR_MAGIC_INSTRUMENTATION
+TEST_F(Instrumentation_Test, Disabled_Tests)
+{
+	delete color_converter::convertTo(red, color_type::LAB);
+	auto snapshot = instrumentation::snapshot();
+	EXPECT_TRUE(snapshot.conversions.empty());
+	EXPECT_TRUE(snapshot.operations.empty());
+	EXPECT_EQ(0u, snapshot.colors_created);
+}
+#else
+TEST_F(Instrumentation_Test, Conversion_Tests)
+{
+	delete color_converter::convertTo(red, color_type::LAB);
+	delete color_converter::to_hsv(blue);
+
+	// Batches count every converted color, independent of the number of threads
+	std::vector<color_base*> colors(100, red);
+	sequential_executor sequential;
+	for (auto color : color_converter::convertTo(colors, color_type::XYZ, &sequential)) delete color;
+	for (auto color : color_converter::convertTo(colors, color_type::XYZ)) delete color;
+
+	auto snapshot = instrumentation::snapshot();
+	EXPECT_EQ(1u, snapshot.conversions_of(color_type::RGB_TRUE, color_type::LAB));
+	EXPECT_EQ(1u, snapshot.conversions_of(color_type::RGB_TRUE, color_type::HSV));
+	EXPECT_EQ(200u, snapshot.conversions_of(color_type::RGB_TRUE, color_type::XYZ));
+	EXPECT_EQ(0u, snapshot.conversions_of(color_type::LAB, color_type::RGB_TRUE));
+
+	instrumentation::reset();
+	EXPECT_TRUE(instrumentation::snapshot().conversions.empty());
+}
+
+TEST_F(Instrumentation_Test, Operation_Tests)
+{
+	delete color_blend::multiply(red, blue);
+	delete color_blend::multiply(red, blue);
+	delete color_blend::screen(red, blue);
+	delete porter_duff::over(red, blue);
+
+	auto snapshot = instrumentation::snapshot();
+	EXPECT_EQ(2u, snapshot.operations_of("color_blend", "multiply"));
+	EXPECT_EQ(1u, snapshot.operations_of("color_blend", "screen"));
+	EXPECT_EQ(1u, snapshot.operations_of("porter_duff", "over"));
+	EXPECT_EQ(0u, snapshot.operations_of("porter_duff", "atop"));
+
+	// The counter of a name is created once
+	EXPECT_EQ(&instrumentation::get_counter("color_blend", "multiply"), &instrumentation::get_counter("color_blend", "multiply"));
+}
+
+TEST_F(Instrumentation_Test, Color_Tests)
+{
+	{
+		rgb_deepcolor color(0.5f, 0.5f, 0.5f, 1.f, srgb);
+		rgb_deepcolor copy(color);
+		auto snapshot = instrumentation::snapshot();
+		EXPECT_EQ(2u, snapshot.colors_created);
+		EXPECT_EQ(0u, snapshot.colors_destroyed);
+		EXPECT_EQ(2, snapshot.colors_alive());
+	}
+	auto snapshot = instrumentation::snapshot();
+	EXPECT_EQ(2u, snapshot.colors_destroyed);
+	EXPECT_EQ(0, snapshot.colors_alive());
+
+	// A conversion without intermediate colors creates exactly its result
+	instrumentation::reset();
+	auto converted = color_converter::convertTo(red, color_type::RGB_DEEP);
+	EXPECT_EQ(1, instrumentation::snapshot().colors_alive());
+	delete converted;
+	EXPECT_EQ(0, instrumentation::snapshot().colors_alive());
+}
+
+TEST_F(Instrumentation_Test, Distance_Tests)
+{
+	// The distance functions free the colors they convert to their calculation space
+	color_distance::euclidean_distance(red, blue, color_type::CIELUV);
+	color_distance::euclidean_distance_weighted(red, blue);
+	color_distance::cielab_delta_e_cie76(red, blue);
+	color_distance::cielab_delta_e_cie94(red, blue);
+	color_distance::cielab_delta_e_cie00(red, blue);
+	color_distance::cielab_delta_e_cie00(red, blue, FAST);
+	color_distance::cmc_delta_e_lc84(red, blue);
+	EXPECT_EQ(0, instrumentation::snapshot().colors_alive());
+
+	std::vector<color_base*> colors = { red, blue, red, blue };
+	color_distance::batch_distance(colors, blue, [](color_base* color1, color_base* color2) { return color_distance::cielab_delta_e_cie00(color1, color2); });
+	EXPECT_EQ(0, instrumentation::snapshot().colors_alive());
+}
+
+TEST_F(Instrumentation_Test, Timer_Tests)
+{
+	std::vector<std::string> names;
+	instrumentation::set_timer_callback([&](const char* name, uint64_t) { names.push_back(name); });
+
+	sequential_executor sequential;
+	std::vector<color_base*> colors(10, red);
+	for (auto color : color_converter::convertTo(colors, color_type::LAB, &sequential)) delete color;
+	{
+		instrumentation::scoped_timer timer("user scope");
+	}
+	ASSERT_EQ(2u, names.size());
+	EXPECT_EQ("color_converter::convertTo(batch)", names[0]);
+	EXPECT_EQ("user scope", names[1]);
+
+	// Without callback the totals are still collected
+	instrumentation::set_timer_callback(nullptr);
+	{
+		instrumentation::scoped_timer timer("user scope");
+	}
+	EXPECT_EQ(2u, names.size());
+
+	auto snapshot = instrumentation::snapshot();
+	ASSERT_EQ(2u, snapshot.timers.size());
+	EXPECT_EQ("user scope", snapshot.timers[1].name);
+	EXPECT_EQ(2u, snapshot.timers[1].calls);
+}
+
+TEST_F(Instrumentation_Test, Write_Tests)
+{
+	delete color_converter::convertTo(red, color_type::LAB);
+	delete porter_duff::over(red, blue);
+
+	std::ostringstream out;
+	instrumentation::write(instrumentation::snapshot(), out);
+	std::string text = out.str();
+	EXPECT_NE(std::string::npos, text.find("color_magic_conversions_total{from=\"RGB_TRUE\",to=\"LAB\"} 1\n"));
+	EXPECT_NE(std::string::npos, text.find("color_magic_operations_total{group=\"porter_duff\",name=\"over\"} 1\n"));
+	EXPECT_NE(std::string::npos, text.find("color_magic_colors_alive "));
+}
+#endif
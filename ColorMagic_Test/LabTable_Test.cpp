@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/lab_table.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+
+#include <cstdio>
+#include <memory>
+
+using namespace color_space;
+
+class LabTable_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	static rgb_color_space_definition* srgb;
+	static std::shared_ptr<color_manipulation::lab_table> table;
+
+	// Generating a table takes a while, so all tests share one
+	static void SetUpTestCase()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+		table.reset(color_manipulation::lab_table::generate(srgb));
+	}
+
+	static void TearDownTestCase()
+	{
+		color_manipulation::lab_table::set_active(nullptr);
+		table.reset();
+	}
+
+	virtual void TearDown()
+	{
+		color_manipulation::lab_table::set_active(nullptr);
+	}
+
+	lab* exact_lab(float red, float green, float blue)
+	{
+		rgb_deepcolor color(red / 255.f, green / 255.f, blue / 255.f, 1.f, srgb);
+		return color_manipulation::color_converter::to_lab(&color);
+	}
+};
+
+rgb_color_space_definition* LabTable_Test::srgb = nullptr;
+std::shared_ptr<color_manipulation::lab_table> LabTable_Test::table;
+
+TEST_F(LabTable_Test, Lookup_Tests)
+{
+	for (int red = 0; red < 256; red += 15)
+	{
+		for (int green = 0; green < 256; green += 17)
+		{
+			for (int blue = 0; blue < 256; blue += 51)
+			{
+				auto expected = exact_lab((float)red, (float)green, (float)blue);
+				auto result = table->lookup((uint8_t)red, (uint8_t)green, (uint8_t)blue);
+				ASSERT_NEAR(expected->luminance(), result[0], 0.01f);
+				ASSERT_NEAR(expected->a(), result[1], 0.01f);
+				ASSERT_NEAR(expected->b(), result[2], 0.01f);
+				delete expected;
+			}
+		}
+	}
+
+	// Only integral components can be looked up
+	rgb_truecolor fractional(10.5f, 20.f, 30.f, 255.f, srgb);
+	EXPECT_EQ(nullptr, table->lookup(&fractional));
+}
+
+TEST_F(LabTable_Test, Match_Tests)
+{
+	EXPECT_TRUE(table->matches(srgb));
+	EXPECT_TRUE(table->matches(color_space::rgb_color_space_definition_presets().sRGB()));
+	EXPECT_FALSE(table->matches(color_space::rgb_color_space_definition_presets().adobeRGB()));
+	EXPECT_FALSE(table->matches(nullptr));
+
+	// A definition that changes after it matched is compared again
+	auto changed = color_space::rgb_color_space_definition_presets().sRGB();
+	EXPECT_TRUE(table->matches(changed));
+	changed->get_gamma_curve()->set_inverse_gamma_curve_parts(color_space::gamma_presets().gamma2_2()->get_inverse_gamma_curve_parts());
+	EXPECT_FALSE(table->matches(changed));
+	changed->set_gamma_curve(color_space::gamma_presets().sRGB());
+	EXPECT_TRUE(table->matches(changed));
+	delete changed;
+
+	// A new definition (possibly at the address of a deleted one) does not inherit the result of the old one
+	auto adobe = color_space::rgb_color_space_definition_presets().adobeRGB();
+	EXPECT_FALSE(table->matches(adobe));
+	delete adobe;
+	auto srgb_copy = color_space::rgb_color_space_definition_presets().sRGB();
+	EXPECT_TRUE(table->matches(srgb_copy));
+	delete srgb_copy;
+}
+
+TEST_F(LabTable_Test, ActiveLifetime_Tests)
+{
+	// A conversion that holds the active table keeps it alive while another table is set. A mapped copy of the
+	// shared table is enough for that and avoids generating another one.
+	std::string path = "lab_table_lifetime_test.bin";
+	table->save(path);
+	std::shared_ptr<color_manipulation::lab_table> replaced(color_manipulation::lab_table::load(path));
+	color_manipulation::lab_table::set_active(replaced);
+	auto in_use = color_manipulation::lab_table::get_active();
+	std::weak_ptr<color_manipulation::lab_table> observer(replaced);
+	replaced.reset();
+
+	color_manipulation::lab_table::set_active(table);
+	EXPECT_FALSE(observer.expired());
+	EXPECT_NE(table, in_use);
+	EXPECT_TRUE(in_use->matches(srgb));
+
+	in_use.reset();
+	EXPECT_TRUE(observer.expired());
+	std::remove(path.c_str());
+}
+
+TEST_F(LabTable_Test, Converter_Tests)
+{
+	color_manipulation::lab_table::set_active(table);
+	EXPECT_EQ(table, color_manipulation::lab_table::get_active());
+
+	auto color = new rgb_truecolor(200.f, 30.f, 90.f, 51.f, srgb);
+	auto expected = exact_lab(200.f, 30.f, 90.f);
+	auto result = color_manipulation::color_converter::to_lab(color);
+	EXPECT_NEAR(expected->luminance(), result->luminance(), avg_error);
+	EXPECT_NEAR(expected->a(), result->a(), avg_error);
+	EXPECT_NEAR(expected->b(), result->b(), avg_error);
+	EXPECT_NEAR(0.2f, result->alpha(), avg_error);
+	delete result;
+
+	auto lch = color_manipulation::color_converter::to_lch_ab(color);
+	color_manipulation::lab_table::set_active(nullptr);
+	auto exact_lch = color_manipulation::color_converter::to_lch_ab(color);
+	EXPECT_NEAR(exact_lch->luminance(), lch->luminance(), avg_error);
+	EXPECT_NEAR(exact_lch->chroma(), lch->chroma(), avg_error);
+	EXPECT_NEAR(exact_lch->hue(), lch->hue(), avg_error);
+	delete exact_lch;
+	delete lch;
+
+	// Colors of other color spaces are converted exactly
+	color_manipulation::lab_table::set_active(table);
+	auto adobe = new rgb_truecolor(200.f, 30.f, 90.f, 255.f, color_space::rgb_color_space_definition_presets().adobeRGB());
+	color_manipulation::lab_table::set_active(nullptr);
+	auto adobe_expected = color_manipulation::color_converter::to_lab(adobe);
+	color_manipulation::lab_table::set_active(table);
+	result = color_manipulation::color_converter::to_lab(adobe);
+	EXPECT_FLOAT_EQ(adobe_expected->luminance(), result->luminance());
+	EXPECT_FLOAT_EQ(adobe_expected->a(), result->a());
+	EXPECT_FLOAT_EQ(adobe_expected->b(), result->b());
+
+	delete result;
+	delete adobe_expected;
+	delete adobe;
+	delete expected;
+	delete color;
+}
+
+TEST_F(LabTable_Test, SaveLoad_Tests)
+{
+	std::string path = "lab_table_test.bin";
+	table->save(path);
+
+	auto mapped = color_manipulation::lab_table::load(path);
+	EXPECT_EQ(color_manipulation::INT16, mapped->get_format());
+	EXPECT_TRUE(mapped->matches(srgb));
+	for (int value : { 0, 1, 77, 128, 254, 255 })
+	{
+		auto expected = table->lookup((uint8_t)value, (uint8_t)(255 - value), 60);
+		auto result = mapped->lookup((uint8_t)value, (uint8_t)(255 - value), 60);
+		EXPECT_EQ(expected[0], result[0]);
+		EXPECT_EQ(expected[1], result[1]);
+		EXPECT_EQ(expected[2], result[2]);
+	}
+	delete mapped;
+	std::remove(path.c_str());
+
+	EXPECT_THROW(color_manipulation::lab_table::load("missing_lab_table.bin"), std::invalid_argument*);
+}
+
+TEST_F(LabTable_Test, HalfFormat_Tests)
+{
+	auto half_table = color_manipulation::lab_table::generate(srgb, color_manipulation::FLOAT16);
+	EXPECT_EQ(color_manipulation::FLOAT16, half_table->get_format());
+
+	for (int value : { 0, 3, 64, 200, 255 })
+	{
+		auto expected = exact_lab((float)value, 40.f, (float)(255 - value));
+		auto result = half_table->lookup((uint8_t)value, 40, (uint8_t)(255 - value));
+		EXPECT_NEAR(expected->luminance(), result[0], 0.05f);
+		EXPECT_NEAR(expected->a(), result[1], 0.1f);
+		EXPECT_NEAR(expected->b(), result[2], 0.1f);
+		delete expected;
+	}
+	delete half_table;
+}
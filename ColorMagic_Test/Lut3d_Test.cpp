@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/lut3d.h"
+#include "../ColorMagic/manipulation/color_adjustments.h"
+#include "../ColorMagic/utils/instrumentation.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+using namespace color_space;
+
+class Lut3d_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	thread_pool* pool;
+	rgb_color_space_definition* srgb;
+
+	virtual void SetUp()
+	{
+		pool = new thread_pool(2);
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+	}
+
+	virtual void TearDown()
+	{
+		delete pool;
+	}
+};
+
+TEST_F(Lut3d_Test, Identity_Tests)
+{
+	color_manipulation::lut3d identity(17, srgb);
+	EXPECT_EQ(17, identity.get_grid_size());
+
+	for (float value : { 0.f, 0.13f, 0.5f, 0.77f, 1.f })
+	{
+		auto trilinear = identity.lookup(value, 1.f - value, 0.3f, color_manipulation::TRILINEAR);
+		auto tetrahedral = identity.lookup(value, 1.f - value, 0.3f, color_manipulation::TETRAHEDRAL);
+		EXPECT_NEAR(value, trilinear[0], 0.0001f);
+		EXPECT_NEAR(1.f - value, trilinear[1], 0.0001f);
+		EXPECT_NEAR(0.3f, trilinear[2], 0.0001f);
+		EXPECT_NEAR(value, tetrahedral[0], 0.0001f);
+		EXPECT_NEAR(1.f - value, tetrahedral[1], 0.0001f);
+		EXPECT_NEAR(0.3f, tetrahedral[2], 0.0001f);
+	}
+
+	// Values outside the domain are clamped
+	auto clamped = identity.lookup(-1.f, 2.f, 0.5f);
+	EXPECT_NEAR(0.f, clamped[0], 0.0001f);
+	EXPECT_NEAR(1.f, clamped[1], 0.0001f);
+
+	EXPECT_THROW(color_manipulation::lut3d(1, srgb), std::invalid_argument*);
+	EXPECT_THROW(identity.get_node(17, 0, 0), std::out_of_range*);
+}
+
+TEST_F(Lut3d_Test, Bake_Tests)
+{
+	// Lab round trip plus a desaturation
+	std::vector<color_manipulation::lut3d::operation> pipeline{
+		[](color_base* color) { return color_manipulation::color_converter::convertTo(color, color_type::LAB); },
+		[](color_base* color) { return color_manipulation::color_adjustments::saturate_in_hsl_space(color, -0.5f); },
+		[](color_base* color) { return color_manipulation::color_converter::convertTo(color, color_type::RGB_DEEP); }
+	};
+
+	auto table = color_manipulation::lut3d::bake(pipeline, srgb, 17, true, pool);
+	EXPECT_EQ(17, table->get_grid_size());
+	EXPECT_GT(table->get_max_delta_e(), 0.f);
+	EXPECT_LT(table->get_max_delta_e(), 5.f);
+
+	// Compare the table with the direct calculation
+	auto red = new rgb_deepcolor(0.8f, 0.2f, 0.1f, 0.5f, srgb);
+	auto expected = color_manipulation::color_converter::to_rgb_deep(color_manipulation::color_adjustments::saturate_in_hsl_space(red, -0.5f));
+	auto result = table->apply(red, color_manipulation::TETRAHEDRAL);
+	EXPECT_NEAR(expected->red(), result->red(), avg_error);
+	EXPECT_NEAR(expected->green(), result->green(), avg_error);
+	EXPECT_NEAR(expected->blue(), result->blue(), avg_error);
+	EXPECT_NEAR(0.5f, result->alpha(), avg_error);
+	delete result;
+
+	result = table->apply(red, color_manipulation::TRILINEAR);
+	EXPECT_NEAR(expected->red(), result->red(), avg_error);
+	EXPECT_NEAR(expected->green(), result->green(), avg_error);
+	EXPECT_NEAR(expected->blue(), result->blue(), avg_error);
+	delete result;
+
+	auto fine_table = color_manipulation::lut3d::bake(pipeline, srgb, 33, false, pool);
+	EXPECT_EQ(0.f, fine_table->get_max_delta_e());
+	result = fine_table->apply(red);
+	EXPECT_NEAR(expected->red(), result->red(), avg_error);
+	EXPECT_NEAR(expected->green(), result->green(), avg_error);
+	EXPECT_NEAR(expected->blue(), result->blue(), avg_error);
+	delete result;
+
+	delete fine_table;
+	delete table;
+	delete expected;
+	delete red;
+}
+
+TEST_F(Lut3d_Test, Failure_Tests)
+{
+	// An operation that throws or returns null stops the bake without leaking the colors of the pipeline
+	std::vector<color_manipulation::lut3d::operation> throwing{
+		[](color_base* color) { return color_manipulation::color_converter::convertTo(color, color_type::LAB); },
+		[](color_base* color) -> color_base* { if (color->get_component_vector()[0] > 50.f) throw new std::domain_error("too bright"); return color; }
+	};
+	std::vector<color_manipulation::lut3d::operation> returning_null{
+		[](color_base* color) { return color_manipulation::color_converter::convertTo(color, color_type::LAB); },
+		[](color_base*) -> color_base* { return nullptr; }
+	};
+
+	instrumentation::reset();
+	EXPECT_THROW(color_manipulation::lut3d::bake(throwing, srgb, 5, false, pool), std::domain_error*);
+	EXPECT_THROW(color_manipulation::lut3d::bake(returning_null, srgb, 5, false, pool), std::invalid_argument*);
+#ifdef COLOR_MAGIC_INSTRUMENTATION
+	EXPECT_EQ(0, instrumentation::snapshot().colors_alive());
+#endif
+}
+
+TEST_F(Lut3d_Test, ApplyBuffer_Tests)
+{
+	std::vector<color_manipulation::lut3d::operation> invert{
+		[](color_base* color)
+		{
+			auto rgb = static_cast<rgb_deepcolor*>(color);
+			return new rgb_deepcolor(1.f - rgb->red(), 1.f - rgb->green(), 1.f - rgb->blue(), rgb->alpha(), rgb->get_rgb_color_space());
+		}
+	};
+	auto table = color_manipulation::lut3d::bake(invert, srgb, 9, true, pool);
+
+	// Linear transformations are reproduced exactly
+	EXPECT_NEAR(0.f, table->get_max_delta_e(), 0.01f);
+
+	std::vector<float> pixels;
+	for (int i = 0; i < 1000; ++i)
+	{
+		pixels.push_back(i / 1000.f);
+		pixels.push_back(0.5f);
+		pixels.push_back(1.f - i / 1000.f);
+	}
+
+	std::vector<float> output(pixels.size());
+	table->apply(pixels.data(), output.data(), 1000, color_manipulation::TETRAHEDRAL, pool);
+	for (size_t i = 0; i < pixels.size(); ++i) ASSERT_NEAR(1.f - pixels[i], output[i], 0.0001f);
+
+	// In place
+	table->apply(pixels.data(), pixels.data(), 1000, color_manipulation::TRILINEAR, pool);
+	for (size_t i = 0; i < pixels.size(); ++i) ASSERT_NEAR(output[i], pixels[i], 0.0001f);
+
+	delete table;
+}
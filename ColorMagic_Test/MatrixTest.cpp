@@ -1,6 +1,6 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\utils\matrix.h"
+#include "../ColorMagic/utils/matrix.h"
 
 class Matrix_Test : public ::testing::Test {
 protected:
@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/palette_extractor.h"
+#include "../ColorMagic/manipulation/conversion_plan.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+class PaletteExtractor_Test : public ::testing::Test {
+protected:
+	rgb_color_space_definition* srgb;
+	std::vector<uint8_t> flat;
+	std::vector<uint8_t> noisy;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+
+		// 50% red, 30% green and 20% blue
+		for (int i = 0; i < 1000; ++i)
+		{
+			uint8_t rgb[3] = { 200, 30, 30 };
+			if (i >= 500) rgb[0] = 30, rgb[1] = i < 800 ? 180 : 30, rgb[2] = i < 800 ? 40 : 220;
+			flat.insert(flat.end(), { rgb[0], rgb[1], rgb[2], 255 });
+		}
+
+		// 100000 pixels scattered around four colors
+		const uint8_t centers[4][3] = { { 220, 40, 40 }, { 40, 200, 60 }, { 30, 40, 210 }, { 240, 230, 80 } };
+		uint32_t state = 99;
+		for (int i = 0; i < 100000; ++i)
+		{
+			const uint8_t* center = centers[i % 4];
+			for (int c = 0; c < 3; ++c)
+			{
+				state = state * 1664525u + 1013904223u;
+				noisy.push_back((uint8_t)(center[c] + (int)(state >> 28) - 8));
+			}
+			noisy.push_back(255);
+		}
+	}
+
+	virtual void TearDown()
+	{
+	}
+
+	// Lab components of an rgb true color.
+	std::array<float, 3> to_lab(float red, float green, float blue)
+	{
+		float record[4] = { red, green, blue, 1.f };
+		conversion_plan(RGB_TRUE, srgb, LAB, srgb).execute(record);
+		return { record[0], record[1], record[2] };
+	}
+};
+
+TEST_F(PaletteExtractor_Test, Flat_Tests)
+{
+	pixel_view view(flat.data(), RGBA32, 40, 25);
+	for (auto use_unique_colors : { true, false })
+	{
+		palette_options options;
+		options.color_count = 3;
+		options.use_unique_colors = use_unique_colors;
+		options.precision = EXACT;
+		auto palette = palette_extractor::extract(view, srgb, options);
+		ASSERT_EQ(3u, palette.size());
+		EXPECT_FLOAT_EQ(0.5f, palette[0].weight);
+		EXPECT_FLOAT_EQ(0.3f, palette[1].weight);
+		EXPECT_FLOAT_EQ(0.2f, palette[2].weight);
+
+		auto red = to_lab(200.f, 30.f, 30.f), blue = to_lab(30.f, 30.f, 220.f);
+		for (size_t c = 0; c < 3; ++c)
+		{
+			EXPECT_NEAR(red[c], palette[0].lab[c], 1e-3f);
+			EXPECT_NEAR(blue[c], palette[2].lab[c], 1e-3f);
+		}
+	}
+
+	// Fewer distinct colors than requested
+	palette_options options;
+	options.color_count = 16;
+	EXPECT_EQ(3u, palette_extractor::extract(view, srgb, options).size());
+
+	auto colors = palette_extractor::create_colors(palette_extractor::extract(view, srgb, options), srgb);
+	ASSERT_EQ(3u, colors.size());
+	EXPECT_EQ(LAB, colors[0]->get_color_type());
+	for (auto color : colors) delete color;
+}
+
+TEST_F(PaletteExtractor_Test, Cluster_Tests)
+{
+	pixel_view view(noisy.data(), RGBA32, 400, 250);
+	palette_options options;
+	options.color_count = 4;
+	auto palette = palette_extractor::extract(view, srgb, options);
+	ASSERT_EQ(4u, palette.size());
+
+	// Each cluster finds one of the colors the pixels are scattered around
+	float weights = 0.f;
+	for (const auto& entry : palette)
+	{
+		EXPECT_NEAR(0.25f, entry.weight, 0.01f);
+		weights += entry.weight;
+	}
+	EXPECT_NEAR(1.f, weights, 1e-5f);
+	auto yellow = to_lab(240.f, 230.f, 80.f);
+	float nearest = 1e9f;
+	for (const auto& entry : palette)
+	{
+		float dl = entry.lab[0] - yellow[0], da = entry.lab[1] - yellow[1], db = entry.lab[2] - yellow[2];
+		nearest = std::min(nearest, dl * dl + da * da + db * db);
+	}
+	EXPECT_LT(nearest, 2.f);
+
+	// The palette does not depend on the number of threads
+	sequential_executor sequential;
+	thread_pool pool(4);
+	for (auto use_unique_colors : { true, false })
+	{
+		options.use_unique_colors = use_unique_colors;
+		auto expected = palette_extractor::extract(view, srgb, options, &sequential);
+		auto parallel = palette_extractor::extract(view, srgb, options, &pool);
+		ASSERT_EQ(expected.size(), parallel.size());
+		for (size_t i = 0; i < expected.size(); ++i)
+		{
+			EXPECT_EQ(expected[i].lab, parallel[i].lab);
+			EXPECT_EQ(expected[i].weight, parallel[i].weight);
+		}
+	}
+}
+
+TEST_F(PaletteExtractor_Test, Record_Tests)
+{
+	// Weighted records, the heavy record pulls its cluster
+	float records[16] = { 50.f, 0.f, 0.f, 1.f, 52.f, 0.f, 0.f, 1.f, 90.f, 10.f, 10.f, 1.f, 91.f, 10.f, 10.f, 1.f };
+	float weights[4] = { 1.f, 3.f, 1.f, 1.f };
+	palette_options options;
+	options.color_count = 2;
+	auto palette = palette_extractor::extract(records, weights, 4, options);
+	ASSERT_EQ(2u, palette.size());
+	EXPECT_FLOAT_EQ(4.f / 6.f, palette[0].weight);
+	EXPECT_FLOAT_EQ(51.5f, palette[0].lab[0]);
+	EXPECT_FLOAT_EQ(90.5f, palette[1].lab[0]);
+
+	options.color_count = 1;
+	palette = palette_extractor::extract(records, nullptr, 4, options);
+	ASSERT_EQ(1u, palette.size());
+	EXPECT_FLOAT_EQ(70.75f, palette[0].lab[0]);
+	EXPECT_FLOAT_EQ(1.f, palette[0].weight);
+
+	float zero_weights[4] = { 0.f, 0.f, 0.f, 0.f };
+	EXPECT_EQ(0u, palette_extractor::extract(records, zero_weights, 4, options).size());
+	EXPECT_EQ(0u, palette_extractor::extract(records, nullptr, 0, options).size());
+}
+
+TEST_F(PaletteExtractor_Test, Exception_Tests)
+{
+	pixel_view view(flat.data(), RGBA32, 40, 25);
+	palette_options options;
+	options.color_count = 0;
+	EXPECT_THROW(palette_extractor::extract(view, srgb, options), std::invalid_argument*);
+	EXPECT_THROW(palette_extractor::extract(view, nullptr), std::invalid_argument*);
+	EXPECT_THROW(palette_extractor::extract(nullptr, nullptr, 1), std::invalid_argument*);
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/pixel_view.h"
+#include "../ColorMagic/manipulation/conversion_plan.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/manipulation/lut3d.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace color_space;
+
+class PixelView_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	rgb_color_space_definition* srgb;
+	rgb_color_space_definition* adobe;
+
+	// 3 x 2 image, stored with a stride of 4 pixels
+	std::vector<uint32_t> argb;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+		adobe = color_space::rgb_color_space_definition_presets().adobeRGB();
+		argb = { 0xFF102030, 0x80FF0000, 0x0000FF00, 0xDEADBEEF, 0xFF0000FF, 0x40C0C0C0, 0xFFFFFFFF, 0xDEADBEEF };
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(PixelView_Test, Layout_Tests)
+{
+	pixel_view view(argb.data(), ARGB32, 3, 2, 16);
+	EXPECT_EQ(6, view.size());
+	EXPECT_TRUE(view.has_alpha());
+	EXPECT_EQ((std::array<uint8_t, 4>{ 0x10, 0x20, 0x30, 0xFF }), view.get(0, 0));
+	EXPECT_EQ((std::array<uint8_t, 4>{ 0x00, 0x00, 0xFF, 0xFF }), view.get(0, 1));
+	EXPECT_THROW(view.get(3, 0), std::out_of_range*);
+	EXPECT_THROW(pixel_view(argb.data(), ARGB32, 5, 1, 16), std::invalid_argument*);
+	EXPECT_THROW(pixel_view(argb.data(), PLANAR, 3), std::invalid_argument*);
+
+	// Every layout reads the same pixels after a copy through the records
+	std::vector<float> records(view.size() * 4);
+	view.unpack(0, view.size(), records.data());
+
+	std::vector<uint8_t> rgba(24), bgra(24), rgb(18), red(6), green(6), blue(6), alpha(6);
+	std::vector<mutable_pixel_view> targets = {
+		mutable_pixel_view(rgba.data(), RGBA32, 3, 2),
+		mutable_pixel_view(bgra.data(), BGRA32, 3, 2),
+		mutable_pixel_view(red.data(), green.data(), blue.data(), alpha.data(), 3, 2) };
+	for (auto& target : targets)
+	{
+		target.pack(0, target.size(), records.data());
+		for (size_t y = 0; y < 2; ++y)
+		{
+			for (size_t x = 0; x < 3; ++x) EXPECT_EQ(view.get(x, y), target.get(x, y));
+		}
+	}
+	EXPECT_EQ(0x80, rgba[7]);
+	EXPECT_EQ(0xFF, bgra[6]);
+	EXPECT_EQ(0x40, alpha[4]);
+
+	// Pixels without alpha are opaque
+	mutable_pixel_view rgb_view(rgb.data(), RGB24, 3, 2);
+	rgb_view.pack(0, 6, records.data());
+	EXPECT_FALSE(rgb_view.has_alpha());
+	EXPECT_EQ((std::array<uint8_t, 4>{ 0xFF, 0x00, 0x00, 0xFF }), rgb_view.get(1, 0));
+
+	// Sub views share the memory
+	auto part = view.subview(1, 0, 2, 2);
+	EXPECT_EQ(view.get(2, 1), part.get(1, 1));
+	mutable_pixel_view writable(argb.data(), ARGB32, 3, 2, 16);
+	writable.subview(2, 1, 1, 1).set(0, 0, { 1, 2, 3, 4 });
+	EXPECT_EQ(0x04010203u, argb[6]);
+	EXPECT_THROW(view.subview(2, 0, 2, 1), std::out_of_range*);
+}
+
+TEST_F(PixelView_Test, BatchApi_Tests)
+{
+	pixel_view view(argb.data(), ARGB32, 3, 2, 16);
+	auto plan = color_manipulation::conversion_plan::get(color_type::RGB_TRUE, srgb, color_type::LAB, srgb);
+	std::vector<float> lab_records(view.size() * 4);
+	plan->apply(view, lab_records.data());
+
+	auto colors = color_manipulation::color_converter::convertTo(view, srgb, color_type::LAB);
+	ASSERT_EQ(view.size(), colors.size());
+	for (size_t i = 0; i < view.size(); ++i)
+	{
+		auto pixel = view.get(i % 3, i / 3);
+		rgb_truecolor color(pixel[0], pixel[1], pixel[2], pixel[3], srgb);
+		auto expected = color_manipulation::color_converter::convertTo(&color, color_type::LAB);
+		for (int c = 0; c < 3; ++c)
+		{
+			EXPECT_NEAR(expected->get_component(c), lab_records[i * 4 + c], avg_error);
+			EXPECT_NEAR(expected->get_component(c), colors[i]->get_component(c), avg_error);
+		}
+		EXPECT_NEAR(pixel[3] / 255.f, lab_records[i * 4 + 3], 1e-6f);
+		delete expected;
+		delete colors[i];
+	}
+
+	// Back from the records to another layout
+	std::vector<uint8_t> bgra(24);
+	mutable_pixel_view bgra_view(bgra.data(), BGRA32, 3, 2);
+	color_manipulation::conversion_plan::get(color_type::LAB, srgb, color_type::RGB_TRUE, srgb)->apply(lab_records.data(), bgra_view);
+	for (size_t i = 0; i < view.size(); ++i) EXPECT_EQ(view.get(i % 3, i / 3), bgra_view.get(i % 3, i / 3));
+
+	// View to view, in place
+	std::vector<uint32_t> copy = argb;
+	mutable_pixel_view in_place(copy.data(), ARGB32, 3, 2, 16);
+	color_manipulation::conversion_plan::get(color_type::RGB_DEEP, srgb, color_type::RGB_DEEP, adobe)->apply(in_place, in_place);
+	rgb_deepcolor red(1.f, 0.f, 0.f, 1.f, srgb);
+	auto adobe_red = color_manipulation::conversion_plan::get(color_type::RGB_DEEP, srgb, color_type::RGB_DEEP, adobe)->apply(&red);
+	EXPECT_NEAR(adobe_red->get_component(0) * 255.f, (float)in_place.get(1, 0)[0], 1.f);
+	EXPECT_NEAR(adobe_red->get_component(1) * 255.f, (float)in_place.get(1, 0)[1], 1.f);
+	EXPECT_EQ(0x80, in_place.get(1, 0)[3]);
+	EXPECT_EQ(0xDEADBEEF, copy[3]);
+	delete adobe_red;
+
+	EXPECT_THROW(plan->apply(lab_records.data(), bgra_view), std::invalid_argument*);
+	EXPECT_THROW(plan->apply(view, mutable_pixel_view(bgra.data(), BGRA32, 2, 1)), std::invalid_argument*);
+
+	// Identity table keeps the pixels
+	auto table = color_manipulation::lut3d::bake({}, srgb, 17, false);
+	std::vector<uint8_t> rgba(24);
+	mutable_pixel_view rgba_view(rgba.data(), RGBA32, 3, 2);
+	table->apply(view, rgba_view);
+	for (size_t i = 0; i < view.size(); ++i) EXPECT_EQ(view.get(i % 3, i / 3), rgba_view.get(i % 3, i / 3));
+	delete table;
+}
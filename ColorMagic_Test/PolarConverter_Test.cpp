@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/polar_converter.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace color_manipulation;
+
+class PolarConverter_Test : public ::testing::Test {
+protected:
+	std::vector<float> a;
+	std::vector<float> b;
+
+	virtual void SetUp()
+	{
+		// A grid over the lab chroma plane including the axes, the origin and values close to them
+		for (int i = -20; i <= 20; ++i)
+		{
+			for (int j = -20; j <= 20; ++j)
+			{
+				a.push_back(i * 6.4f);
+				b.push_back(j == 1 ? 1e-6f : j * 6.4f);
+			}
+		}
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(PolarConverter_Test, ToPolar_Tests)
+{
+	for (auto policy : { EXACT, FAST, FASTEST })
+	{
+		std::vector<float> chroma(a.size()), hue(a.size());
+		polar_converter::lab_to_lch_ab(a.data(), b.data(), chroma.data(), hue.data(), a.size(), policy);
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			double expected_hue = std::atan2((double)b[i], (double)a[i]) * 180.0 / M_PI;
+			if (expected_hue < 0.0) expected_hue += 360.0;
+			EXPECT_NEAR(std::hypot((double)a[i], (double)b[i]), chroma[i], 1e-4);
+			EXPECT_GE(hue[i], 0.f);
+			EXPECT_LT(hue[i], 360.f);
+
+			// Hues close to 360 may wrap to 0
+			double difference = std::fabs(expected_hue - hue[i]);
+			EXPECT_NEAR(0.0, std::fmin(difference, 360.0 - difference), policy == FASTEST ? 0.02 : 1e-4);
+		}
+	}
+
+	// Luv uses the same conversion
+	float u[3] = { 0.f, -10.f, 3.f };
+	float v[3] = { 0.f, 0.f, -3.f };
+	polar_converter::cieluv_to_lch_uv(u, v, u, v, 3, EXACT);
+	EXPECT_EQ(0.f, u[0]);
+	EXPECT_EQ(0.f, v[0]);
+	EXPECT_FLOAT_EQ(10.f, u[1]);
+	EXPECT_FLOAT_EQ(180.f, v[1]);
+	EXPECT_FLOAT_EQ(std::sqrt(18.f), u[2]);
+	EXPECT_FLOAT_EQ(315.f, v[2]);
+
+	// A hue just below 0 rounds up to 360 and wraps to 0
+	float tiny_a = 1.f, tiny_b = -1e-8f, chroma = 0.f, hue = 0.f;
+	polar_converter::lab_to_lch_ab(&tiny_a, &tiny_b, &chroma, &hue, 1);
+	EXPECT_EQ(0.f, hue);
+}
+
+TEST_F(PolarConverter_Test, FromPolar_Tests)
+{
+	// Hues outside [0, 360) are wrapped
+	float chroma[5] = { 10.f, 10.f, 10.f, 10.f, 0.f };
+	float hue[5] = { 90.f, -90.f, 405.f, 1080.f, 123.f };
+	float a[5], b[5];
+	polar_converter::lch_ab_to_lab(chroma, hue, a, b, 5);
+	EXPECT_NEAR(0.f, a[0], 1e-5f);
+	EXPECT_NEAR(10.f, b[0], 1e-5f);
+	EXPECT_NEAR(-10.f, b[1], 1e-5f);
+	EXPECT_NEAR(std::sqrt(50.f), a[2], 1e-5f);
+	EXPECT_NEAR(std::sqrt(50.f), b[2], 1e-5f);
+	EXPECT_NEAR(10.f, a[3], 1e-5f);
+	EXPECT_NEAR(0.f, b[3], 1e-5f);
+	EXPECT_EQ(0.f, a[4]);
+
+	float u[1], v[1];
+	polar_converter::lch_uv_to_cieluv(chroma, hue, u, v, 1, EXACT);
+	EXPECT_NEAR(0.f, u[0], 1e-5f);
+	EXPECT_FLOAT_EQ(10.f, v[0]);
+}
+
+TEST_F(PolarConverter_Test, RoundTrip_Tests)
+{
+	// In place on a batch that the thread pool splits into several chunks
+	std::vector<float> x, y;
+	for (int repeat = 0; repeat < 10; ++repeat)
+	{
+		x.insert(x.end(), a.begin(), a.end());
+		y.insert(y.end(), b.begin(), b.end());
+	}
+	std::vector<float> original_x = x, original_y = y;
+
+	polar_converter::lab_to_lch_ab(x.data(), y.data(), x.data(), y.data(), x.size());
+	std::vector<float> chroma = x, hue = y;
+	polar_converter::lch_ab_to_lab(x.data(), y.data(), x.data(), y.data(), x.size());
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		EXPECT_NEAR(original_x[i], x[i], 3e-4f);
+		EXPECT_NEAR(original_y[i], y[i], 3e-4f);
+	}
+
+	// The executor does not change the results
+	sequential_executor sequential;
+	std::vector<float> sequential_chroma(x.size()), sequential_hue(x.size());
+	polar_converter::lab_to_lch_ab(original_x.data(), original_y.data(), sequential_chroma.data(), sequential_hue.data(), x.size(), FAST, &sequential);
+	EXPECT_EQ(chroma, sequential_chroma);
+	EXPECT_EQ(hue, sequential_hue);
+}
+
+TEST_F(PolarConverter_Test, Argument_Tests)
+{
+	float value = 1.f;
+	polar_converter::lab_to_lch_ab(nullptr, nullptr, nullptr, nullptr, 0);
+	EXPECT_THROW(polar_converter::lab_to_lch_ab(&value, nullptr, &value, &value, 1), std::invalid_argument*);
+	EXPECT_THROW(polar_converter::lch_ab_to_lab(&value, &value, &value, &value, 1), std::invalid_argument*);
+	EXPECT_THROW(polar_converter::lch_uv_to_cieluv(&value, &value, &value, &value, 0, (precision_policy)3), std::invalid_argument*);
+}
@@ -1,7 +1,7 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\rgb_deepcolor.h"
-#include "..\ColorMagic\manipulation\porter_duff.h"
+#include "../ColorMagic/spaces/rgb_deepcolor.h"
+#include "../ColorMagic/manipulation/porter_duff.h"
 
 using namespace color_space;
 
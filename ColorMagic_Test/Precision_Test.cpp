@@ -0,0 +1,233 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/precision.h"
+#include "../ColorMagic/manipulation/accuracy_harness.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/manipulation/color_distance.h"
+#include "../ColorMagic/manipulation/conversion_plan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace color_space;
+using namespace color_manipulation;
+
+class Precision_Test : public ::testing::Test {
+protected:
+	rgb_color_space_definition* srgb;
+
+	virtual void SetUp()
+	{
+		srgb = rgb_color_space_definition_presets().sRGB();
+	}
+
+	virtual void TearDown()
+	{
+		precision::set_default(EXACT);
+	}
+
+	// Maximum errors of the math functions of a policy, compared with double precision
+	template <precision_policy Policy> void expect_math_errors(double cbrt_error, double exp_error, double atan2_error, double sin_error)
+	{
+		typedef precision_math<Policy> math;
+		double max_cbrt = 0.0, max_exp = 0.0, max_atan2 = 0.0, max_sin = 0.0;
+		for (int i = -2000; i <= 2000; ++i)
+		{
+			float x = i * 0.01f;
+			if (x != 0.f) max_cbrt = std::max(max_cbrt, std::fabs(math::cbrt(x) - std::cbrt((double)x)) / std::cbrt(std::fabs((double)x)));
+			max_exp = std::max(max_exp, std::fabs(math::exp(x * 0.5f) - std::exp(x * 0.5)) / std::exp(x * 0.5));
+			max_sin = std::max(max_sin, std::fabs(math::sin(x) - std::sin((double)x)));
+			max_sin = std::max(max_sin, std::fabs(math::cos(x) - std::cos((double)x)));
+
+			float y = (i % 63) * 0.37f - 11.f;
+			max_atan2 = std::max(max_atan2, std::fabs(math::atan2(y, x) - std::atan2((double)y, (double)x)));
+		}
+		EXPECT_LT(max_cbrt, cbrt_error);
+		EXPECT_LT(max_exp, exp_error);
+		EXPECT_LT(max_atan2, atan2_error);
+		EXPECT_LT(max_sin, sin_error);
+	}
+};
+
+TEST_F(Precision_Test, Math_Tests)
+{
+	expect_math_errors<FAST>(2e-7, 1e-6, 1e-6, 5e-7);
+	expect_math_errors<FASTEST>(2e-6, 2e-4, 3e-4, 2e-6);
+
+	// pow is exp2(y * log2(x)), its error grows with the exponent
+	for (float x = 0.001f; x < 1.f; x += 0.001f)
+	{
+		double exact = std::pow((double)x, 2.4);
+		EXPECT_NEAR(exact, precision_math<FAST>::pow(x, 2.4f), exact * 3e-6);
+		EXPECT_NEAR(exact, precision_math<FASTEST>::pow(x, 2.4f), exact * 6e-4);
+	}
+
+	// Special values keep the results of the standard library
+	EXPECT_EQ(0.f, precision_math<FAST>::cbrt(0.f));
+	EXPECT_FLOAT_EQ(-2.f, precision_math<FAST>::cbrt(-8.f));
+	EXPECT_EQ(0.f, precision_math<FASTEST>::pow(0.f, 3.f));
+	EXPECT_EQ(0.f, precision_math<FAST>::atan2(0.f, 0.f));
+	EXPECT_FLOAT_EQ((float)M_PI, precision_math<FAST>::atan2(0.f, -1.f));
+	EXPECT_FLOAT_EQ((float)-M_PI / 2.f, precision_math<FAST>::atan2(-1.f, 0.f));
+
+	// Double precision uses the same polynomials
+	EXPECT_NEAR(std::cbrt(5.0), precision_math<FAST>::cbrt(5.0), 1e-7);
+	EXPECT_NEAR(std::sin(1.0), precision_math<FASTEST>::sin(1.0), 2e-6);
+}
+
+TEST_F(Precision_Test, Default_Tests)
+{
+	EXPECT_EQ(EXACT, precision::get_default());
+	auto exact = std::unique_ptr<lch_ab>(color_converter::to_lch_ab(std::unique_ptr<rgb_truecolor>(new rgb_truecolor(200.f, 100.f, 50.f, 1.f, srgb)).get()));
+
+	precision::set_default(FAST);
+	EXPECT_EQ(FAST, precision::get_default());
+	EXPECT_EQ(FAST, precision::dispatch(precision::get_default(), [](auto policy) { return decltype(policy)::value; }));
+
+	std::unique_ptr<rgb_truecolor> color(new rgb_truecolor(200.f, 100.f, 50.f, 1.f, srgb));
+	auto fast = std::unique_ptr<lch_ab>(color_converter::to_lch_ab(color.get()));
+	EXPECT_NEAR(exact->luminance(), fast->luminance(), 1e-4f);
+	EXPECT_NEAR(exact->chroma(), fast->chroma(), 1e-4f);
+	EXPECT_NEAR(exact->hue(), fast->hue(), 1e-5f);
+
+	// The round trip stays on the same truecolor
+	precision::set_default(FASTEST);
+	auto lab = std::unique_ptr<color_space::lab>(color_converter::to_lab(color.get()));
+	auto back = std::unique_ptr<rgb_truecolor>(color_converter::to_rgb_true(lab.get()));
+	EXPECT_EQ(200.f, back->red());
+	EXPECT_EQ(100.f, back->green());
+	EXPECT_EQ(50.f, back->blue());
+	EXPECT_TRUE(srgb->get_gamma_curve()->is_compiled());
+}
+
+TEST_F(Precision_Test, PerCall_Tests)
+{
+	std::unique_ptr<rgb_truecolor> color(new rgb_truecolor(200.f, 100.f, 50.f, 1.f, srgb));
+	precision::set_default(FAST);
+	auto by_default = std::unique_ptr<lch_ab>(color_converter::to_lch_ab(color.get()));
+	precision::set_default(EXACT);
+	auto exact = std::unique_ptr<lch_ab>(color_converter::to_lch_ab(color.get()));
+
+	// A passed policy replaces the default for this call only
+	auto fast = std::unique_ptr<lch_ab>(static_cast<lch_ab*>(color_converter::convertTo(color.get(), color_type::LCH_AB, FAST)));
+	EXPECT_EQ(by_default->luminance(), fast->luminance());
+	EXPECT_EQ(by_default->chroma(), fast->chroma());
+	EXPECT_EQ(by_default->hue(), fast->hue());
+	EXPECT_EQ(EXACT, precision::get_default());
+	auto again = std::unique_ptr<lch_ab>(color_converter::to_lch_ab(color.get()));
+	EXPECT_EQ(exact->chroma(), again->chroma());
+	EXPECT_EQ(exact->hue(), again->hue());
+
+	// The batch overloads pass the policy to the threads of the executor
+	std::vector<color_base*> inputs(64, color.get());
+	auto batch = color_converter::convertTo(inputs, color_type::LCH_AB, FAST);
+	for (auto result : batch)
+	{
+		EXPECT_EQ(fast->chroma(), static_cast<lch_ab*>(result)->chroma());
+		EXPECT_EQ(fast->hue(), static_cast<lch_ab*>(result)->hue());
+		delete result;
+	}
+
+	// Threads with different policies do not influence each other
+	float results[2][256];
+	std::thread fast_thread([&]()
+	{
+		for (int i = 0; i < 256; ++i) results[0][i] = std::unique_ptr<lch_ab>(static_cast<lch_ab*>(color_converter::convertTo(color.get(), color_type::LCH_AB, FAST)))->hue();
+	});
+	std::thread exact_thread([&]()
+	{
+		for (int i = 0; i < 256; ++i) results[1][i] = std::unique_ptr<lch_ab>(static_cast<lch_ab*>(color_converter::convertTo(color.get(), color_type::LCH_AB, EXACT)))->hue();
+	});
+	fast_thread.join();
+	exact_thread.join();
+	for (int i = 0; i < 256; ++i)
+	{
+		EXPECT_EQ(fast->hue(), results[0][i]);
+		EXPECT_EQ(exact->hue(), results[1][i]);
+	}
+}
+
+TEST_F(Precision_Test, Plan_Tests)
+{
+	auto exact = conversion_plan::get(color_type::RGB_DEEP, srgb, color_type::LCH_AB, srgb);
+	auto fast = conversion_plan::get(color_type::RGB_DEEP, srgb, color_type::LCH_AB, srgb, BRADFORD, FAST);
+	EXPECT_EQ(EXACT, exact->get_precision());
+	EXPECT_EQ(FAST, fast->get_precision());
+	EXPECT_NE(exact, fast);
+	EXPECT_EQ(fast, conversion_plan::get(color_type::RGB_DEEP, srgb, color_type::LCH_AB, srgb, BRADFORD, FAST));
+	EXPECT_THROW(conversion_plan(color_type::RGB_DEEP, srgb, color_type::LAB, srgb, BRADFORD, (precision_policy)3), std::invalid_argument*);
+
+	// Whole conversions stay far below a visible difference
+	accuracy_bounds fast_bounds{ 0.001f, 0.0001f, 0 };
+	accuracy_bounds fastest_bounds{ 0.05f, 0.01f, 0 };
+	for (auto out_type : { color_type::XYZ, color_type::LAB, color_type::RGB_DEEP })
+	{
+		auto records = accuracy_harness::sample_grid(color_type::RGB_DEEP, 17, srgb);
+		for (auto policy : { FAST, FASTEST })
+		{
+			auto plan = conversion_plan::get(color_type::RGB_DEEP, srgb, out_type == color_type::RGB_DEEP ? color_type::LAB : out_type, srgb, BRADFORD, policy);
+			auto back = conversion_plan::get(color_type::LAB, srgb, color_type::RGB_DEEP, srgb, BRADFORD, policy);
+			auto report = accuracy_harness::compare("plan", color_type::RGB_DEEP, out_type, records, [&](const float* in, float* out, size_t count)
+			{
+				plan->apply(in, out, count);
+				if (out_type == color_type::RGB_DEEP) back->apply(out, out, count);
+			}, srgb, true);
+
+			std::ostringstream table;
+			accuracy_harness::write_table({ report }, table);
+			EXPECT_TRUE((policy == FAST ? fast_bounds : fastest_bounds).is_met_by(report)) << table.str();
+		}
+	}
+}
+
+TEST_F(Precision_Test, Distance_Tests)
+{
+	std::unique_ptr<rgb_truecolor> yellow(new rgb_truecolor(255.f, 255.f, 0.f, 1.f, srgb));
+	std::unique_ptr<rgb_truecolor> red(new rgb_truecolor(255.f, 0.f, 0.f, 1.f, srgb));
+	std::unique_ptr<rgb_truecolor> blue(new rgb_truecolor(20.f, 40.f, 200.f, 1.f, srgb));
+
+	// The default policy gives exactly the results of the explicit exact version
+	EXPECT_EQ(color_distance::cielab_delta_e_cie00<EXACT>(yellow.get(), red.get()), color_distance::cielab_delta_e_cie00(yellow.get(), red.get()));
+	EXPECT_EQ(color_distance::cmc_delta_e_lc84<EXACT>(yellow.get(), blue.get()), color_distance::cmc_delta_e_lc84(yellow.get(), blue.get()));
+
+	for (auto pair : { std::make_pair(yellow.get(), red.get()), std::make_pair(red.get(), blue.get()), std::make_pair(blue.get(), yellow.get()) })
+	{
+		float exact = color_distance::cielab_delta_e_cie00<EXACT>(pair.first, pair.second);
+		EXPECT_NEAR(exact, color_distance::cielab_delta_e_cie00<FAST>(pair.first, pair.second), 1e-3f);
+		EXPECT_NEAR(exact, color_distance::cielab_delta_e_cie00<FASTEST>(pair.first, pair.second), 0.05f);
+
+		exact = color_distance::cmc_delta_e_lc84<EXACT>(pair.first, pair.second);
+		EXPECT_NEAR(exact, color_distance::cmc_delta_e_lc84<FAST>(pair.first, pair.second), 1e-3f);
+		EXPECT_NEAR(exact, color_distance::cmc_delta_e_lc84<FASTEST>(pair.first, pair.second), 0.05f);
+	}
+
+	// A passed policy is used for the conversion to lab too, so it matches the results of the default policy
+	float passed = color_distance::cielab_delta_e_cie00(yellow.get(), blue.get(), FASTEST);
+	float passed_cmc = color_distance::cmc_delta_e_lc84(yellow.get(), blue.get(), FASTEST);
+	EXPECT_EQ(passed, color_distance::cielab_delta_e_cie00<FASTEST>(yellow.get(), blue.get()));
+
+	precision::set_default(FASTEST);
+	EXPECT_EQ(passed, color_distance::cielab_delta_e_cie00(yellow.get(), blue.get()));
+	EXPECT_EQ(passed_cmc, color_distance::cmc_delta_e_lc84(yellow.get(), blue.get()));
+
+	precision::set_default(FAST);
+	EXPECT_EQ(color_distance::cielab_delta_e_cie00<FAST>(yellow.get(), red.get()), color_distance::cielab_delta_e_cie00(yellow.get(), red.get()));
+}
+
+TEST_F(Precision_Test, Gamma_Tests)
+{
+	std::unique_ptr<color_space::gamma> curve(gamma_presets().sRGB());
+	EXPECT_FALSE(curve->is_compiled());
+	EXPECT_EQ(curve->gamma_correction(0.5f), curve->gamma_correction(0.5f, FAST));
+	EXPECT_FALSE(curve->is_compiled());
+
+	for (float value = 0.f; value <= 1.f; value += 0.01f)
+	{
+		EXPECT_NEAR(curve->gamma_correction(value), curve->gamma_correction(value, FASTEST), 1e-4f);
+		EXPECT_NEAR(curve->inverse_gamma_correction(value), curve->inverse_gamma_correction(value, FASTEST), 1e-4f);
+	}
+	EXPECT_TRUE(curve->is_compiled());
+}
@@ -1,6 +1,6 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\rgb_color_space_definition.h"
+#include "../ColorMagic/spaces/rgb_color_space_definition.h"
 
 using namespace color_space;
 
@@ -50,3 +50,33 @@ TEST_F(RGBColorSpaceDefinition_Test, Constructor_Tests)
 	EXPECT_NEAR(resulting_invers_transform(2, 1), d65_2.get_inverse_transform_matrix()(2, 1), avg_error);
 	EXPECT_NEAR(resulting_invers_transform(2, 2), d65_2.get_inverse_transform_matrix()(2, 2), avg_error);
 }
+
+TEST_F(RGBColorSpaceDefinition_Test, Generation_Tests)
+{
+	white_point_presets w_presets;
+	gamma_presets g_presets;
+	rgb_color_space_definition first(0.64f, 0.33f, 0.3f, 0.6f, 0.15f, 0.06f, w_presets.D65_2Degree(), g_presets.sRGB());
+	rgb_color_space_definition second(first);
+
+	// Every definition has its own generation that stays the same while nothing changes
+	auto generation = first.get_generation();
+	EXPECT_NE(0u, generation);
+	EXPECT_NE(generation, second.get_generation());
+	EXPECT_EQ(generation, first.get_generation());
+
+	first.set_white_point(w_presets.D50_2Degree());
+	EXPECT_NE(generation, first.get_generation());
+
+	generation = first.get_generation();
+	first.set_gamma_curve(g_presets.gamma2_2());
+	EXPECT_NE(generation, first.get_generation());
+
+	// Changes of the gamma parts are detected, definitions with other curves keep their generation
+	generation = first.get_generation();
+	auto second_generation = second.get_generation();
+	second.get_gamma_curve()->add_gamma_curve_part(new gamma_part());
+	EXPECT_EQ(generation, first.get_generation());
+	EXPECT_NE(second_generation, second.get_generation());
+	first.get_gamma_curve()->set_gamma_curve_parts(g_presets.sRGB()->get_gamma_curve_parts());
+	EXPECT_NE(generation, first.get_generation());
+}
@@ -1,8 +1,8 @@
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 #include "pch.h"
-#include "..\ColorMagic\spaces\color_base.h"
-#include "..\ColorMagic\utils\colors.h"
-#include "..\ColorMagic\spaces\rgb_truecolor.h"
+#include "../ColorMagic/spaces/color_base.h"
+#include "../ColorMagic/utils/colors.h"
+#include "../ColorMagic/spaces/rgb_truecolor.h"
 
 using namespace color_space;
 
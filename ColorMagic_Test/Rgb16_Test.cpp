@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/rgb_16_converter.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <vector>
+
+using namespace color_space;
+
+class Rgb16_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.01f;
+
+	rgb_color_space_definition* srgb;
+	rgb_16_buffer pixels;
+
+	virtual void SetUp()
+	{
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+		for (uint32_t r = 0; r < 65536; r += 4369)
+		{
+			for (uint32_t g = 0; g < 65536; g += 13107)
+			{
+				for (uint32_t b = 0; b < 65536; b += 9362)
+				{
+					pixels.push_back({ (uint16_t)r, (uint16_t)g, (uint16_t)b, (uint16_t)(r ^ b) });
+				}
+			}
+		}
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(Rgb16_Test, Table_Tests)
+{
+	auto converter = color_manipulation::rgb_16_converter::get(srgb);
+	EXPECT_EQ(converter, color_manipulation::rgb_16_converter::get(srgb));
+	EXPECT_EQ(srgb, converter->get_rgb_color_space());
+	EXPECT_THROW(color_manipulation::rgb_16_converter(nullptr), std::invalid_argument*);
+
+	// Every code decodes to the exact gamma function value and encodes back to itself
+	for (uint32_t code = 0; code < 65536; ++code)
+	{
+		float linear = srgb->get_gamma_curve()->inverse_gamma_correction(code / 65535.f);
+		ASSERT_NEAR(linear, converter->decode((uint16_t)code), 1e-6f);
+		ASSERT_EQ(code, converter->encode(converter->decode((uint16_t)code)));
+	}
+	EXPECT_EQ(0, converter->encode(-1.f));
+	EXPECT_EQ(65535, converter->encode(2.f));
+}
+
+TEST_F(Rgb16_Test, ChangedDefinition_Tests)
+{
+	// A changed definition gets a converter with the tables of its new gamma curve
+	auto definition = color_space::rgb_color_space_definition_presets().sRGB();
+	auto first = color_manipulation::rgb_16_converter::get(definition);
+	definition->set_gamma_curve(color_space::gamma_presets().gamma2_2());
+	auto second = color_manipulation::rgb_16_converter::get(definition);
+	EXPECT_NE(first, second);
+	EXPECT_EQ(second, color_manipulation::rgb_16_converter::get(definition));
+	EXPECT_NEAR(definition->get_gamma_curve()->inverse_gamma_correction(0.5f), second->decode(32768), 1e-4f);
+	first.reset();
+	second.reset();
+	delete definition;
+
+	// A new definition at the same address does not get the converter of the deleted one
+	auto replacement = color_space::rgb_color_space_definition_presets().adobeRGB();
+	auto third = color_manipulation::rgb_16_converter::get(replacement);
+	EXPECT_EQ(replacement, third->get_rgb_color_space());
+	EXPECT_NEAR(replacement->get_gamma_curve()->inverse_gamma_correction(0.5f), third->decode(32768), 1e-4f);
+	third.reset();
+	delete replacement;
+}
+
+TEST_F(Rgb16_Test, Converter_Tests)
+{
+	auto converter = color_manipulation::rgb_16_converter::get(srgb);
+	std::vector<float> xyz_records(pixels.size() * 4);
+	std::vector<float> lab_records(pixels.size() * 4);
+	converter->to_xyz(pixels.data(), xyz_records.data(), pixels.size());
+	converter->to_lab(pixels.data(), lab_records.data(), pixels.size());
+
+	for (size_t i = 0; i < pixels.size(); ++i)
+	{
+		auto color = converter->to_rgb_deep(pixels[i]);
+		auto xyz_color = color_manipulation::color_converter::convertTo(color, color_type::XYZ);
+		auto lab_color = color_manipulation::color_converter::convertTo(color, color_type::LAB);
+		for (int c = 0; c < 3; ++c)
+		{
+			EXPECT_NEAR(xyz_color->get_component(c), xyz_records[i * 4 + c], avg_error);
+			EXPECT_NEAR(lab_color->get_component(c), lab_records[i * 4 + c], avg_error);
+		}
+		EXPECT_FLOAT_EQ(pixels[i].alpha / 65535.f, lab_records[i * 4 + 3]);
+		EXPECT_EQ(pixels[i], color_manipulation::rgb_16_converter::from_rgb_deep(color));
+
+		delete lab_color;
+		delete xyz_color;
+		delete color;
+	}
+}
+
+TEST_F(Rgb16_Test, RoundTrip_Tests)
+{
+	auto converter = color_manipulation::rgb_16_converter::get(srgb);
+	sequential_executor sequential;
+	std::vector<float> records(pixels.size() * 4);
+	rgb_16_buffer result(pixels.size());
+
+	converter->to_rgb_deep(pixels.data(), records.data(), pixels.size());
+	converter->from_rgb_deep(records.data(), result.data(), pixels.size());
+	EXPECT_EQ(pixels, result);
+
+	converter->to_linear(pixels.data(), records.data(), pixels.size(), &sequential);
+	converter->from_linear(records.data(), result.data(), pixels.size(), &sequential);
+	EXPECT_EQ(pixels, result);
+
+	// Float rounding in the matrices may move a component by one code
+	converter->to_lab(pixels.data(), records.data(), pixels.size());
+	converter->from_lab(records.data(), result.data(), pixels.size());
+	for (size_t i = 0; i < pixels.size(); ++i)
+	{
+		EXPECT_NEAR(pixels[i].red, result[i].red, 2);
+		EXPECT_NEAR(pixels[i].green, result[i].green, 2);
+		EXPECT_NEAR(pixels[i].blue, result[i].blue, 2);
+		EXPECT_EQ(pixels[i].alpha, result[i].alpha);
+	}
+
+	converter->to_xyz(pixels.data(), records.data(), pixels.size());
+	converter->from_xyz(records.data(), result.data(), pixels.size());
+	for (size_t i = 0; i < pixels.size(); ++i)
+	{
+		EXPECT_NEAR(pixels[i].red, result[i].red, 2);
+		EXPECT_NEAR(pixels[i].green, result[i].green, 2);
+		EXPECT_NEAR(pixels[i].blue, result[i].blue, 2);
+	}
+
+	EXPECT_THROW(converter->to_lab(nullptr, records.data(), 2), std::invalid_argument*);
+}
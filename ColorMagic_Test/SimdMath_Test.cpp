@@ -0,0 +1,192 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/simd_math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+class SimdMath_Test : public ::testing::Test {
+protected:
+	std::vector<float> x_values;
+	std::vector<float> y_values;
+
+	virtual void SetUp()
+	{
+		// 4001 values, so the batch functions also run a partial block
+		for (int i = -2000; i <= 2000; ++i)
+		{
+			x_values.push_back(i * 0.01f);
+			y_values.push_back((i % 63) * 0.37f - 11.f);
+		}
+	}
+
+	virtual void TearDown()
+	{
+	}
+
+	// Maximum errors of the vectorized functions of a policy compared with double precision. The lanes have to agree
+	// with the scalar functions of the same policy.
+	template <precision_policy Policy> void expect_errors(double cbrt_error, double exp_error, double atan2_error, double sin_error, double acos_error)
+	{
+		typedef simd_batch<Policy> batch;
+		typedef precision_math<Policy> scalar;
+		size_t count = x_values.size();
+		std::vector<float> half_x(count), small_x(count), cbrt(count), exp(count), atan2(count), sin(count), cos(count), acos(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			half_x[i] = x_values[i] * 0.5f;
+			small_x[i] = x_values[i] * 0.05f;
+		}
+		batch::cbrt(x_values.data(), cbrt.data(), count);
+		batch::exp(half_x.data(), exp.data(), count);
+		batch::atan2(y_values.data(), x_values.data(), atan2.data(), count);
+		batch::sincos(x_values.data(), sin.data(), cos.data(), count);
+		batch::acos(small_x.data(), acos.data(), count);
+
+		double max_cbrt = 0.0, max_exp = 0.0, max_atan2 = 0.0, max_sin = 0.0, max_acos = 0.0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			double x = x_values[i];
+			if (x != 0.0) max_cbrt = std::max(max_cbrt, std::fabs(cbrt[i] - std::cbrt(x)) / std::cbrt(std::fabs(x)));
+			max_exp = std::max(max_exp, std::fabs(exp[i] - std::exp((double)half_x[i])) / std::exp((double)half_x[i]));
+			max_atan2 = std::max(max_atan2, std::fabs(atan2[i] - std::atan2((double)y_values[i], x)));
+			max_sin = std::max(max_sin, std::max(std::fabs(sin[i] - std::sin(x)), std::fabs(cos[i] - std::cos(x))));
+			max_acos = std::max(max_acos, std::fabs(acos[i] - std::acos((double)small_x[i])));
+
+			EXPECT_FLOAT_EQ(scalar::cbrt(x_values[i]), cbrt[i]);
+			EXPECT_FLOAT_EQ(scalar::exp(half_x[i]), exp[i]);
+			EXPECT_FLOAT_EQ(scalar::atan2(y_values[i], x_values[i]), atan2[i]);
+			EXPECT_FLOAT_EQ(scalar::sin(x_values[i]), sin[i]);
+			EXPECT_FLOAT_EQ(scalar::cos(x_values[i]), cos[i]);
+			EXPECT_FLOAT_EQ(scalar::acos(small_x[i]), acos[i]);
+		}
+		EXPECT_LT(max_cbrt, cbrt_error);
+		EXPECT_LT(max_exp, exp_error);
+		EXPECT_LT(max_atan2, atan2_error);
+		EXPECT_LT(max_sin, sin_error);
+		EXPECT_LT(max_acos, acos_error);
+	}
+
+	// Returns the lanes of a vector.
+	static std::vector<float> lanes(const float4& value)
+	{
+		std::vector<float> result(4);
+		value.store(result.data());
+		return result;
+	}
+};
+
+TEST_F(SimdMath_Test, Vector_Tests)
+{
+	float values[6] = { 1.f, -2.f, 3.5f, -4.5f, 7.f, 8.f };
+	auto a = float4::load(values);
+	EXPECT_EQ(std::vector<float>({ 1.f, -2.f, 3.5f, -4.5f }), lanes(a));
+	EXPECT_EQ(std::vector<float>({ 3.5f, -4.5f, 7.f, 8.f }), lanes(float4::load(values + 2)));
+	EXPECT_EQ(std::vector<float>({ 7.f, 8.f, 1.f, 1.f }), lanes(float4::load(values + 4, 2)));
+
+	EXPECT_EQ(std::vector<float>({ 2.f, -4.f, 7.f, -9.f }), lanes(a + a));
+	EXPECT_EQ(std::vector<float>({ 1.f, 2.f, 3.5f, 4.5f }), lanes(abs(a)));
+	EXPECT_EQ(std::vector<float>({ 1.f, -2.f, 3.f, -4.5f }), lanes(min(a, float4(3.f))));
+	EXPECT_EQ(std::vector<float>({ 1.f, -2.f, 4.f, -5.f }), lanes(round(a)));
+	EXPECT_EQ(std::vector<float>({ 1.f, 0.f, 3.5f, 0.f }), lanes(select(a > float4(0.f), a, float4(0.f))));
+	EXPECT_TRUE(any(a < float4(0.f)));
+	EXPECT_FALSE(all(a < float4(0.f)));
+	EXPECT_TRUE(all(a < float4(10.f)));
+
+	// Rounds half away from zero like std::round, large values are already integers
+	EXPECT_EQ(std::vector<float>({ 0.f, -3.f, 1e9f, 3.f }), lanes(round(float4(0.49999997f, -2.5f, 1e9f, 2.5f))));
+
+	float store[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+	a.store(store + 1, 3);
+	EXPECT_EQ(0.f, store[0]);
+	EXPECT_EQ(3.5f, store[3]);
+	EXPECT_EQ(0.f, store[4]);
+
+	// Four rgba records become one vector per component and back
+	float records[16] = { 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f, 13.f, 14.f, 15.f, 16.f };
+	float4 r = float4::load(records), g = float4::load(records + 4), b = float4::load(records + 8), alpha = float4::load(records + 12);
+	transpose(r, g, b, alpha);
+	EXPECT_EQ(std::vector<float>({ 1.f, 5.f, 9.f, 13.f }), lanes(r));
+	EXPECT_EQ(std::vector<float>({ 4.f, 8.f, 12.f, 16.f }), lanes(alpha));
+	transpose(r, g, b, alpha);
+	EXPECT_EQ(std::vector<float>({ 9.f, 10.f, 11.f, 12.f }), lanes(b));
+}
+
+TEST_F(SimdMath_Test, Error_Tests)
+{
+	expect_errors<EXACT>(1e-7, 1e-7, 5e-7, 1e-7, 5e-7);
+	expect_errors<FAST>(2e-7, 1e-6, 1e-6, 5e-7, 6e-7);
+	expect_errors<FASTEST>(2e-6, 2e-4, 3e-4, 2e-6, 1e-4);
+
+	// pow is exp2(y * log2(x)), its error grows with the exponent
+	std::vector<float> bases;
+	for (float x = 0.001f; x < 1.f; x += 0.001f) bases.push_back(x);
+	std::vector<float> fast(bases.size()), fastest(bases.size());
+	simd_batch<FAST>::pow(bases.data(), 2.4f, fast.data(), bases.size());
+	simd_batch<FASTEST>::pow(bases.data(), 2.4f, fastest.data(), bases.size());
+	for (size_t i = 0; i < bases.size(); ++i)
+	{
+		double exact = std::pow((double)bases[i], 2.4);
+		EXPECT_NEAR(exact, fast[i], exact * 3e-6);
+		EXPECT_NEAR(exact, fastest[i], exact * 6e-4);
+	}
+}
+
+TEST_F(SimdMath_Test, SpecialValue_Tests)
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+
+	auto cbrt = lanes(simd_math<FAST>::cbrt(float4(0.f, -8.f, infinity, 1e-40f)));
+	EXPECT_EQ(0.f, cbrt[0]);
+	EXPECT_FLOAT_EQ(-2.f, cbrt[1]);
+	EXPECT_EQ(infinity, cbrt[2]);
+	EXPECT_FLOAT_EQ(std::cbrt(1e-40f), cbrt[3]);
+	EXPECT_TRUE(std::isnan(lanes(simd_math<FASTEST>::cbrt(float4(nan)))[0]));
+
+	auto exp = lanes(simd_math<FAST>::exp(float4(-200.f, 200.f, 0.f, nan)));
+	EXPECT_EQ(0.f, exp[0]);
+	EXPECT_EQ(infinity, exp[1]);
+	EXPECT_FLOAT_EQ(1.f, exp[2]);
+	EXPECT_TRUE(std::isnan(exp[3]));
+
+	auto pow = lanes(simd_math<FASTEST>::pow(float4(0.f, -2.f, 4.f, infinity), float4(3.f, 2.f, 0.5f, 1.f)));
+	EXPECT_EQ(0.f, pow[0]);
+	EXPECT_EQ(4.f, pow[1]);
+	EXPECT_NEAR(2.f, pow[2], 1e-3f);
+	EXPECT_EQ(infinity, pow[3]);
+
+	auto atan2 = lanes(simd_math<FAST>::atan2(float4(0.f, 0.f, -1.f, 1.f), float4(0.f, -1.f, 0.f, infinity)));
+	EXPECT_EQ(0.f, atan2[0]);
+	EXPECT_FLOAT_EQ((float)M_PI, atan2[1]);
+	EXPECT_FLOAT_EQ((float)-M_PI / 2.f, atan2[2]);
+	EXPECT_EQ(0.f, atan2[3]);
+
+	// Large arguments use the standard library like the scalar functions
+	float4 sin, cos;
+	simd_math<FAST>::sincos(float4(1000.f, -500.f, nan, 3.f), sin, cos);
+	EXPECT_FLOAT_EQ(std::sin(1000.f), lanes(sin)[0]);
+	EXPECT_FLOAT_EQ(std::cos(-500.f), lanes(cos)[1]);
+	EXPECT_TRUE(std::isnan(lanes(sin)[2]));
+	EXPECT_NEAR(std::cos(3.f), lanes(cos)[3], 5e-7f);
+
+	auto acos = lanes(simd_math<FAST>::acos(float4(1.f, -1.f, 0.f, 2.f)));
+	EXPECT_NEAR(0.f, acos[0], 1e-6f);
+	EXPECT_NEAR((float)M_PI, acos[1], 1e-6f);
+	EXPECT_NEAR((float)M_PI / 2.f, acos[2], 1e-6f);
+	EXPECT_TRUE(std::isnan(acos[3]));
+}
+
+TEST_F(SimdMath_Test, Batch_Tests)
+{
+	// Input and output may be the same array, counts that are no multiple of four only write their values
+	float values[8] = { 1.f, 8.f, 27.f, 64.f, 125.f, 216.f, 343.f, -1.f };
+	simd_batch<FAST>::cbrt(values, values, 7);
+	for (int i = 0; i < 7; ++i) EXPECT_NEAR(i + 1.f, values[i], 1e-5f);
+	EXPECT_EQ(-1.f, values[7]);
+
+	simd_batch<FAST>::cbrt(values, values, 0);
+	EXPECT_NEAR(1.f, values[0], 1e-5f);
+}
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/manipulation/stream_converter.h"
+#include "../ColorMagic/utils/thread_pool.h"
+
+#include <sstream>
+
+using namespace color_space;
+
+class StreamConverter_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	thread_pool* pool;
+	rgb_color_space_definition* srgb;
+	std::vector<float> rgb_records;
+
+	virtual void SetUp()
+	{
+		pool = new thread_pool(2);
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+		for (int i = 0; i < 50; ++i)
+		{
+			rgb_records.push_back((float)(i * 5));
+			rgb_records.push_back((float)(255 - i * 5));
+			rgb_records.push_back(128.f);
+			rgb_records.push_back(255.f);
+		}
+	}
+
+	virtual void TearDown()
+	{
+		delete pool;
+	}
+
+	std::string to_bytes(const std::vector<float>& records)
+	{
+		return std::string(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(float));
+	}
+
+	std::vector<float> from_bytes(const std::string& bytes)
+	{
+		std::vector<float> records(bytes.size() / sizeof(float));
+		std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(records.data()));
+		return records;
+	}
+};
+
+TEST_F(StreamConverter_Test, RecordSize_Tests)
+{
+	EXPECT_EQ(4, color_manipulation::stream_converter::get_record_size(color_type::RGB_TRUE));
+	EXPECT_EQ(2, color_manipulation::stream_converter::get_record_size(color_type::GREY_DEEP));
+	EXPECT_EQ(5, color_manipulation::stream_converter::get_record_size(color_type::CMYK));
+	EXPECT_EQ(4, color_manipulation::stream_converter::get_record_size(color_type::LCH_UV));
+	EXPECT_THROW(color_manipulation::stream_converter::get_record_size(color_type::UNDEFINED), std::invalid_argument*);
+}
+
+TEST_F(StreamConverter_Test, Convert_Tests)
+{
+	std::istringstream input(to_bytes(rgb_records));
+	std::ostringstream output;
+
+	// Use a chunk size that does not divide the number of colors
+	size_t count = color_manipulation::stream_converter::convert(input, output, color_type::RGB_TRUE, color_type::LAB, srgb, 7, pool);
+	EXPECT_EQ(50, count);
+
+	auto lab_records = from_bytes(output.str());
+	ASSERT_EQ(50 * 4, lab_records.size());
+	for (size_t i = 0; i < 50; ++i)
+	{
+		auto rgb = color_manipulation::stream_converter::create_color(color_type::RGB_TRUE, &rgb_records[i * 4], srgb);
+		auto expected = color_manipulation::color_converter::to_lab(rgb);
+		EXPECT_NEAR(expected->luminance(), lab_records[i * 4], avg_error);
+		EXPECT_NEAR(expected->a(), lab_records[i * 4 + 1], avg_error);
+		EXPECT_NEAR(expected->b(), lab_records[i * 4 + 2], avg_error);
+		EXPECT_NEAR(1.f, lab_records[i * 4 + 3], avg_error);
+		delete expected;
+		delete rgb;
+	}
+
+	// Convert back to check the round trip
+	std::istringstream lab_input(output.str());
+	std::ostringstream rgb_output;
+	count = color_manipulation::stream_converter::convert(lab_input, rgb_output, color_type::LAB, color_type::RGB_TRUE, srgb, 16, pool);
+	EXPECT_EQ(50, count);
+
+	auto round_trip = from_bytes(rgb_output.str());
+	ASSERT_EQ(rgb_records.size(), round_trip.size());
+	for (size_t i = 0; i < rgb_records.size(); ++i)
+	{
+		EXPECT_NEAR(rgb_records[i], round_trip[i], 1.f);
+	}
+}
+
+TEST_F(StreamConverter_Test, ConvertAnyPair_Tests)
+{
+	std::istringstream input(to_bytes(rgb_records));
+	std::ostringstream output;
+	EXPECT_EQ(50, color_manipulation::stream_converter::convert(input, output, color_type::RGB_TRUE, color_type::LCH_AB, srgb, 64, pool));
+	EXPECT_EQ(50 * 4 * sizeof(float), output.str().size());
+
+	std::istringstream grey_input(to_bytes(std::vector<float>{ 0.5f, 1.f, 0.25f, 1.f }));
+	std::ostringstream cmyk_output;
+	EXPECT_EQ(2, color_manipulation::stream_converter::convert(grey_input, cmyk_output, color_type::GREY_DEEP, color_type::CMYK, srgb, 64, pool));
+	EXPECT_EQ(2 * 5 * sizeof(float), cmyk_output.str().size());
+
+	// Empty input produces empty output
+	std::istringstream empty_input("");
+	std::ostringstream empty_output;
+	EXPECT_EQ(0, color_manipulation::stream_converter::convert(empty_input, empty_output, color_type::RGB_TRUE, color_type::LAB, srgb));
+	EXPECT_TRUE(empty_output.str().empty());
+}
+
+TEST_F(StreamConverter_Test, TruncatedInput_Tests)
+{
+	auto bytes = to_bytes(rgb_records);
+	std::istringstream input(bytes.substr(0, bytes.size() - 2));
+	std::ostringstream output;
+	EXPECT_THROW(color_manipulation::stream_converter::convert(input, output, color_type::RGB_TRUE, color_type::LAB, srgb, 7, pool), std::invalid_argument*);
+	EXPECT_THROW(color_manipulation::stream_converter::convert(input, output, color_type::RGB_TRUE, color_type::LAB, srgb, 0, pool), std::invalid_argument*);
+}
@@ -0,0 +1,243 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "../ColorMagic/utils/thread_pool.h"
+#include "../ColorMagic/spaces/rgb_deepcolor.h"
+#include "../ColorMagic/manipulation/color_converter.h"
+#include "../ColorMagic/manipulation/color_distance.h"
+#include "../ColorMagic/manipulation/color_blend.h"
+#include "../ColorMagic/manipulation/color_adjustments.h"
+
+using namespace color_space;
+
+class ThreadPool_Test : public ::testing::Test {
+protected:
+	float avg_error = 0.05f;
+
+	thread_pool* pool;
+	rgb_color_space_definition* srgb;
+	std::vector<color_base*> colors;
+
+	virtual void SetUp()
+	{
+		pool = new thread_pool(4);
+		srgb = color_space::rgb_color_space_definition_presets().sRGB();
+		for (int i = 0; i < 100; ++i)
+		{
+			colors.push_back(new rgb_deepcolor(i / 100.f, 1.f - i / 100.f, 0.5f, 1.f, srgb));
+		}
+	}
+
+	virtual void TearDown()
+	{
+		delete pool;
+		for (auto color : colors) delete color;
+		colors.clear();
+	}
+};
+
+TEST_F(ThreadPool_Test, ParallelFor_Tests)
+{
+	EXPECT_EQ(4, pool->get_thread_count());
+
+	// Every index has to be visited exactly once
+	std::vector<int> visits(10000, 0);
+	pool->parallel_for(0, visits.size(), [&visits](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i) visits[i]++;
+	});
+	for (int count : visits) ASSERT_EQ(1, count);
+
+	// Explicit grain size and offset ranges
+	std::atomic<int> chunks(0);
+	pool->parallel_for(10, 110, [&chunks](size_t begin, size_t end)
+	{
+		EXPECT_LE(end - begin, 10);
+		chunks++;
+	}, 10);
+	EXPECT_EQ(10, chunks.load());
+
+	// Empty ranges do not call the body
+	pool->parallel_for(5, 5, [](size_t, size_t) { FAIL(); });
+}
+
+TEST_F(ThreadPool_Test, NestedParallelFor_Tests)
+{
+	std::atomic<int> sum(0);
+	pool->parallel_for(0, 16, [this, &sum](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			pool->parallel_for(0, 100, [&sum](size_t inner_begin, size_t inner_end) { sum += (int)(inner_end - inner_begin); }, 1);
+		}
+	}, 1);
+	EXPECT_EQ(1600, sum.load());
+}
+
+TEST_F(ThreadPool_Test, Exception_Tests)
+{
+	EXPECT_THROW(pool->parallel_for(0, 1000, [](size_t begin, size_t end)
+	{
+		if (begin <= 500 && 500 < end) throw std::runtime_error("failure");
+	}, 10), std::runtime_error);
+
+	// The pool is still usable afterwards
+	std::atomic<int> count(0);
+	pool->parallel_for(0, 100, [&count](size_t begin, size_t end) { count += (int)(end - begin); });
+	EXPECT_EQ(100, count.load());
+}
+
+TEST_F(ThreadPool_Test, Submit_Tests)
+{
+	std::atomic<int> count(0);
+	for (int i = 0; i < 100; ++i) pool->submit([&count]() { count++; });
+
+	// The deconstructor waits for all queued tasks
+	delete pool;
+	pool = nullptr;
+	EXPECT_EQ(100, count.load());
+}
+
+TEST_F(ThreadPool_Test, BatchConverter_Tests)
+{
+	auto converted = color_manipulation::color_converter::convertTo(colors, color_type::LAB, pool);
+	ASSERT_EQ(colors.size(), converted.size());
+	for (size_t i = 0; i < colors.size(); ++i)
+	{
+		auto expected = color_manipulation::color_converter::to_lab(colors[i]);
+		EXPECT_EQ(color_type::LAB, converted[i]->get_color_type());
+		EXPECT_NEAR(expected->luminance(), static_cast<lab*>(converted[i])->luminance(), avg_error);
+		EXPECT_NEAR(expected->a(), static_cast<lab*>(converted[i])->a(), avg_error);
+		EXPECT_NEAR(expected->b(), static_cast<lab*>(converted[i])->b(), avg_error);
+		delete expected;
+		delete converted[i];
+	}
+
+	// Same results with the sequential executor
+	sequential_executor sequential;
+	converted = color_manipulation::color_converter::convertTo(colors, color_type::HSV, &sequential);
+	ASSERT_EQ(colors.size(), converted.size());
+	for (auto color : converted)
+	{
+		EXPECT_EQ(color_type::HSV, color->get_color_type());
+		delete color;
+	}
+
+	std::vector<color_base*> with_null{ colors[0], nullptr };
+	EXPECT_THROW(color_manipulation::color_converter::convertTo(with_null, color_type::LAB, pool), std::invalid_argument*);
+}
+
+TEST_F(ThreadPool_Test, BatchDistance_Tests)
+{
+	auto distances = color_manipulation::color_distance::batch_distance(colors, colors[0], [](color_base* c1, color_base* c2)
+	{
+		return color_manipulation::color_distance::cielab_delta_e_cie76(c1, c2);
+	}, pool);
+	ASSERT_EQ(colors.size(), distances.size());
+	EXPECT_NEAR(0.f, distances[0], avg_error);
+	for (size_t i = 0; i < colors.size(); ++i)
+	{
+		EXPECT_NEAR(color_manipulation::color_distance::cielab_delta_e_cie76(colors[i], colors[0]), distances[i], avg_error);
+	}
+
+	distances = color_manipulation::color_distance::batch_distance(colors, colors, [](color_base* c1, color_base* c2)
+	{
+		return color_manipulation::color_distance::euclidean_distance(c1, c2);
+	}, pool);
+	for (float distance : distances) EXPECT_NEAR(0.f, distance, avg_error);
+
+	std::vector<color_base*> shorter(colors.begin(), colors.begin() + 10);
+	EXPECT_THROW(color_manipulation::color_distance::batch_distance(colors, shorter, [](color_base*, color_base*) { return 0.f; }, pool), std::invalid_argument*);
+}
+
+TEST_F(ThreadPool_Test, BatchBlendAndAdjust_Tests)
+{
+	std::vector<color_base*> blacks;
+	for (size_t i = 0; i < colors.size(); ++i) blacks.push_back(new rgb_deepcolor(0.f, 0.f, 0.f, 1.f, srgb));
+
+	auto blended = color_manipulation::color_blend::batch_blend(colors, blacks, [](color_base* s, color_base* d)
+	{
+		return color_manipulation::color_blend::multiply(s, d);
+	}, pool);
+	ASSERT_EQ(colors.size(), blended.size());
+	for (auto color : blended)
+	{
+		auto rgb = static_cast<rgb_deepcolor*>(color);
+		EXPECT_NEAR(0.f, rgb->red(), avg_error);
+		EXPECT_NEAR(0.f, rgb->green(), avg_error);
+		EXPECT_NEAR(0.f, rgb->blue(), avg_error);
+		delete color;
+	}
+
+	auto adjusted = color_manipulation::color_adjustments::batch_adjust(colors, [](color_base* color)
+	{
+		return color_manipulation::color_adjustments::saturate_in_hsl_space(color, -1.f);
+	}, pool);
+	ASSERT_EQ(colors.size(), adjusted.size());
+	for (auto color : adjusted)
+	{
+		auto rgb = static_cast<rgb_deepcolor*>(color);
+		EXPECT_NEAR(rgb->red(), rgb->green(), avg_error);
+		EXPECT_NEAR(rgb->green(), rgb->blue(), avg_error);
+		delete color;
+	}
+
+	for (auto color : blacks) delete color;
+}
+
+TEST_F(ThreadPool_Test, BatchPixels_Tests)
+{
+	std::vector<uint8_t> rgba;
+	for (int i = 0; i < 100; ++i)
+	{
+		rgba.insert(rgba.end(), { (uint8_t)(i * 2), (uint8_t)(255 - i * 2), 128, 255 });
+	}
+	std::vector<uint8_t> blacks(rgba.size(), 0);
+	for (size_t i = 3; i < blacks.size(); i += 4) blacks[i] = 255;
+	pixel_view pixels(rgba.data(), RGBA32, 10, 10);
+
+	rgb_truecolor reference(0.f, 255.f, 128.f, 255.f, srgb);
+	auto distances = color_manipulation::color_distance::batch_distance(pixels, srgb, &reference, [](color_base* c1, color_base* c2)
+	{
+		return color_manipulation::color_distance::cielab_delta_e_cie76(c1, c2);
+	}, pool);
+	ASSERT_EQ(pixels.size(), distances.size());
+	EXPECT_NEAR(0.f, distances[0], avg_error);
+	for (size_t i = 0; i < pixels.size(); ++i)
+	{
+		auto rgba_i = pixels.get(i % 10, i / 10);
+		rgb_truecolor color(rgba_i[0], rgba_i[1], rgba_i[2], rgba_i[3], srgb);
+		EXPECT_NEAR(color_manipulation::color_distance::cielab_delta_e_cie76(&color, &reference), distances[i], avg_error);
+	}
+
+	distances = color_manipulation::color_distance::batch_distance(pixels, pixels, srgb, [](color_base* c1, color_base* c2)
+	{
+		return color_manipulation::color_distance::euclidean_distance(c1, c2);
+	}, pool);
+	for (float distance : distances) EXPECT_NEAR(0.f, distance, avg_error);
+	EXPECT_THROW(color_manipulation::color_distance::batch_distance(pixels, pixels.subview(0, 0, 10, 5), srgb, [](color_base*, color_base*) { return 0.f; }, pool), std::invalid_argument*);
+
+	std::vector<uint8_t> blended(rgba.size(), 7);
+	color_manipulation::color_blend::batch_blend(pixels, pixel_view(blacks.data(), RGBA32, 10, 10), mutable_pixel_view(blended.data(), RGBA32, 10, 10), srgb, [](color_base* s, color_base* d)
+	{
+		return color_manipulation::color_blend::multiply(s, d);
+	}, pool);
+	for (size_t i = 0; i < blended.size(); i += 4)
+	{
+		EXPECT_EQ(0, blended[i]);
+		EXPECT_EQ(0, blended[i + 1]);
+		EXPECT_EQ(0, blended[i + 2]);
+	}
+
+	// Adjust the pixels in place
+	mutable_pixel_view in_place(rgba.data(), RGBA32, 10, 10);
+	color_manipulation::color_adjustments::batch_adjust(in_place, in_place, srgb, [](color_base* color)
+	{
+		return color_manipulation::color_adjustments::saturate_in_hsl_space(color, -1.f);
+	}, pool);
+	for (size_t i = 0; i < rgba.size(); i += 4)
+	{
+		EXPECT_NEAR(rgba[i], rgba[i + 1], 1);
+		EXPECT_NEAR(rgba[i + 1], rgba[i + 2], 1);
+	}
+	EXPECT_THROW(color_manipulation::color_adjustments::batch_adjust(pixels, mutable_pixel_view(blended.data(), RGBA32, 5), srgb, [](color_base*) { return (color_base*)nullptr; }, pool), std::invalid_argument*);
+}